@@ -1,7 +1,8 @@
 macro(neuroh5_add_gtest exe)
     # add build target
-    add_executable(${exe} EXCLUDE_FROM_ALL ${ARGN})
-    target_link_libraries(${exe} ${GTEST_LIBRARIES})
+    add_executable(${exe} ${ARGN})
+    target_include_directories(${exe} PRIVATE ${GTEST_INCLUDE_DIRS})
+    target_link_libraries(${exe} ${GTEST_BOTH_LIBRARIES} Threads::Threads)
     # add dependency to 'tests' target
     add_dependencies(neuroh5_gtests ${exe})
 
@@ -11,15 +12,29 @@ macro(neuroh5_add_gtest exe)
                     COMMAND ${exe}
                     ARGS --gtest_print_time
                     DEPENDS ${exe}
-                    WORKING_DIRECTORY ${PROJECT_SOURCE_DIR}/test
+                    WORKING_DIRECTORY ${PROJECT_SOURCE_DIR}
                     VERBATIM
                     COMMENT "Runnint gtest test(s) ${exe}")
                   
     # add dependency to 'test' target
     add_dependencies(neuroh5_gtest test_${_testname})
+
+    # register with ctest
+    add_test(NAME ${_testname} COMMAND ${exe}
+             WORKING_DIRECTORY ${PROJECT_SOURCE_DIR})
     
 endmacro(neuroh5_add_gtest)
 
+# register a gtest executable added with neuroh5_add_gtest to also run
+# under mpiexec with the given number of processes
+macro(neuroh5_add_mpi_gtest exe nprocs)
+    string(REPLACE "/" "_" _testname ${exe})
+    add_test(NAME ${_testname}_np${nprocs}
+             COMMAND ${MPIEXEC_EXECUTABLE} ${MPIEXEC_NUMPROC_FLAG} ${nprocs}
+                     ${MPIEXEC_PREFLAGS} $<TARGET_FILE:${exe}> ${MPIEXEC_POSTFLAGS}
+             WORKING_DIRECTORY ${PROJECT_SOURCE_DIR})
+endmacro(neuroh5_add_mpi_gtest)
+
 macro(neuroh5_add_pyunit file)
     # find test file
     set(_file_name _file_name-NOTFOUND)
@@ -60,7 +60,9 @@ namespace neuroh5
 
     
     /*****************************************************************************
-     * Save tree data structures to HDF5
+     * Save tree data structures to HDF5. With TreeQuantized encoding, the
+     * point attributes are written in the encoded form, which the tree
+     * readers decode; a population cannot mix encoded and plain trees.
      *****************************************************************************/
     int append_trees
     (
@@ -73,7 +75,8 @@ namespace neuroh5
      const set<size_t>              &io_rank_set,
      CellPtr ptr_type = CellPtr(PtrOwner),
      const size_t chunk_size = 4000,
-     const size_t value_chunk_size = 4000
+     const size_t value_chunk_size = 4000,
+     const TreeEncoding& encoding = TreeEncoding()
      );
 
     int append_trees
@@ -85,7 +88,8 @@ namespace neuroh5
      std::forward_list<neurotree_t> &tree_list,
      size_t io_size,
      const size_t chunk_size = 4000,
-     const size_t value_chunk_size = 4000
+     const size_t value_chunk_size = 4000,
+     const TreeEncoding& encoding = TreeEncoding()
      );
 
   }
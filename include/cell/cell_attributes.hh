@@ -20,10 +20,14 @@
 #include "exists_dataset.hh"
 #include "file_access.hh"
 #include "attr_map.hh"
+#include "columnar_attr_map.hh"
+#include "rank_map.hh"
 #include "compact_optional.hh"
 #include "optional_value.hh"
 #include "range_sample.hh"
 #include "throw_assert.hh"
+#include "neuroh5_file.hh"
+#include "dataset_filters.hh"
 
 namespace neuroh5
 {
@@ -41,7 +45,8 @@ namespace neuroh5
      const CellIndex& index_type,
      const CellPtr&   ptr_type,
      const size_t     chunk_size,
-     const size_t     value_chunk_size
+     const size_t     value_chunk_size,
+     const FilterConfig& filters = hdf5::default_filter_config()
      );
 
     
@@ -61,6 +66,17 @@ namespace neuroh5
      vector< pair<string,AttrKind> >& out_attributes
      );
 
+    /// @brief Variant of get_cell_attributes that reads through a file
+    ///        session; rank 0 reads and broadcasts the attribute
+    ///        information, which is then cached in the session.
+    herr_t get_cell_attributes
+    (
+     File&                         file,
+     const string&                 name_space,
+     const string&                 pop_name,
+     vector< pair<string,AttrKind> >& out_attributes
+     );
+
 
     herr_t get_cell_attribute_index
     (
@@ -95,6 +111,26 @@ namespace neuroh5
      size_t numitems = 0
      );
 
+    /// @brief Variant of read_cell_attributes that stores the values of
+    ///        each attribute in one contiguous column.
+    void read_cell_attributes
+    (
+     MPI_Comm         comm,
+     const string&    file_name,
+     const string&    name_space,
+     const set<string>& attr_mask,
+     const string&    pop_name,
+     const CELL_IDX_T& pop_start,
+     data::NamedColumnarAttrMap&    attr_values,
+     size_t offset = 0,
+     size_t numitems = 0
+     );
+
+    /// @brief Reads the attributes of the selected cells. The cell
+    ///        indexes are partitioned over the ranks of comm, and the
+    ///        value ranges of the selected cells are looked up on their
+    ///        owner ranks; attributes that share their index and pointer
+    ///        share the partition and the lookup.
     void read_cell_attribute_selection
     (
      MPI_Comm         comm,
@@ -107,6 +143,21 @@ namespace neuroh5
      data::NamedAttrMap& attr_values
      );
 
+    /// @brief Variant of read_cell_attribute_selection that reads through
+    ///        a file session on its communicator; the partitioned cell
+    ///        indexes are cached in the session and reused by later
+    ///        selection reads of the same name space.
+    void read_cell_attribute_selection
+    (
+     File&         file,
+     const string& name_space,
+     const set<string>& attr_mask,
+     const string& pop_name,
+     const CELL_IDX_T& pop_start,
+     const std::vector<CELL_IDX_T>&  selection,
+     data::NamedAttrMap& attr_values
+     );
+
     void scatter_read_cell_attribute_selection
     (
      MPI_Comm         comm,
@@ -128,7 +179,7 @@ namespace neuroh5
      const string                 &attr_name_space,
      const set<string>            &attr_mask,
      // A vector that maps nodes to compute ranks
-     const node_rank_map_t        &node_rank_map,
+     const data::NodeRankMap    &node_rank_map,
      const string                 &pop_name,
      const CELL_IDX_T             &pop_start,
      data::NamedAttrMap           &attr_map,
@@ -138,6 +189,25 @@ namespace neuroh5
      size_t numitems = 0
      );
 
+    /// @brief Variant of scatter_read_cell_attributes that stores the
+    ///        values of each attribute in one contiguous column; the
+    ///        columns are split by destination rank on the I/O ranks and
+    ///        merged on the receiving ranks.
+    int scatter_read_cell_attributes
+    (
+     MPI_Comm                      all_comm,
+     const string                 &file_name,
+     const int                     io_size,
+     const string                 &attr_name_space,
+     const set<string>            &attr_mask,
+     const data::NodeRankMap    &node_rank_map,
+     const string                 &pop_name,
+     const CELL_IDX_T             &pop_start,
+     data::NamedColumnarAttrMap   &attr_map,
+     size_t offset   = 0,
+     size_t numitems = 0
+     );
+
     
     void bcast_cell_attributes
     (
@@ -173,7 +243,9 @@ namespace neuroh5
                                      const CellPtr                   ptr_type = CellPtr(PtrOwner),
                                      const size_t chunk_size = 4000,
                                      const size_t value_chunk_size = 4000,
-                                     const size_t cache_size = 1*1024*1024
+                                     const size_t cache_size = 1*1024*1024,
+                                     const FilterConfig& filters = hdf5::default_filter_config(),
+                                     const WriteMode write_mode = WriteShared
                                      );
 
   
@@ -193,7 +265,8 @@ namespace neuroh5
      const CellPtr                         ptr_type,
      const size_t chunk_size = 4000,
      const size_t value_chunk_size = 4000,
-     const size_t cache_size = 1*1024*1024
+     const size_t cache_size = 1*1024*1024,
+     const FilterConfig& filters = hdf5::default_filter_config()
      )
     {
       int status;
@@ -239,7 +312,7 @@ namespace neuroh5
         {
           create_cell_attribute_datasets(file, attr_namespace, pop_name, attr_name,
                                          ftype, index_type, ptr_type,
-                                         chunk_size, value_chunk_size
+                                         chunk_size, value_chunk_size, filters
                                          );
         }
 
@@ -281,7 +354,8 @@ namespace neuroh5
      const CellPtr                         ptr_type,
      const size_t chunk_size = 4000,
      const size_t value_chunk_size = 4000,
-     const size_t cache_size = 1*1024*1024
+     const size_t cache_size = 1*1024*1024,
+     const FilterConfig& filters = hdf5::default_filter_config()
      )
     {
       int status;
@@ -296,7 +370,7 @@ namespace neuroh5
 
       hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
 
-      throw_assert(H5Pset_fapl_mpio(fapl, comm, MPI_INFO_NULL) >= 0,
+      throw_assert(hdf5::set_parallel_file_access(fapl, comm) >= 0,
                    "append_cell_attribute: HDF5 mpio error");
 
       /* Cache parameters: */
@@ -338,7 +412,7 @@ namespace neuroh5
             {
               create_cell_attribute_datasets(file, attr_namespace, pop_name, attr_name,
                                              ftype, index_type, ptr_type,
-                                             chunk_size, value_chunk_size
+                                             chunk_size, value_chunk_size, filters
                                              );
             }
           status = H5Fclose(file);
@@ -354,7 +428,7 @@ namespace neuroh5
       append_cell_attribute<T> (file, attr_namespace, pop_name, pop_start,
                                 attr_name, index, attr_ptr, values,
                                 data_type, index_type, ptr_type,
-                                chunk_size, value_chunk_size, cache_size);
+                                chunk_size, value_chunk_size, cache_size, filters);
          
       status = H5Fclose(file);
       throw_assert(status == 0, "append_cell_attribute: unable to close HDF5 file");
@@ -383,7 +457,8 @@ namespace neuroh5
      const CellPtr                   ptr_type = CellPtr(PtrOwner),
      const size_t chunk_size = 4000,
      const size_t value_chunk_size = 4000,
-     const size_t cache_size = 1*1024*1024
+     const size_t cache_size = 1*1024*1024,
+     const FilterConfig& filters = hdf5::default_filter_config()
      )
     {
 
@@ -419,7 +494,8 @@ namespace neuroh5
                        "append_cell_attribute_map: error in H5Pget_fapl_mpio");
           
           throw_assert(MPI_Comm_size(io_comm, &io_size_value) == MPI_SUCCESS, "error in MPI_Comm_size");
-          throw_assert(io_size_value == io_size, "io_size mismatch");
+          // a subfile is accessed by its I/O rank alone
+          throw_assert((io_size_value == io_size) || (io_size_value == 1), "io_size mismatch");
           
           throw_assert(H5Pclose(fapl) == 0,
                        "append_cell_attribute_map: error in H5Pclose");
@@ -543,7 +619,7 @@ namespace neuroh5
                                    attr_namespace, pop_name, pop_start, attr_name,
                                    gid_recvbuf, attr_ptr, value_recvbuf,
                                    data_type, index_type, ptr_type, 
-                                   chunk_size, value_chunk_size, cache_size);
+                                   chunk_size, value_chunk_size, cache_size, filters);
         }
 
       if (is_io_rank)
@@ -584,7 +660,8 @@ namespace neuroh5
      const CellPtr                   ptr_type = CellPtr(PtrOwner),
      const size_t chunk_size = 4000,
      const size_t value_chunk_size = 4000,
-     const size_t cache_size = 1*1024*1024
+     const size_t cache_size = 1*1024*1024,
+     const FilterConfig& filters = hdf5::default_filter_config()
      )
     {
       herr_t status;
@@ -616,7 +693,7 @@ namespace neuroh5
       MPI_Comm_split(comm,color,rank,&io_comm);
       MPI_Comm_set_errhandler(io_comm, MPI_ERRORS_RETURN);
 
-      throw_assert(H5Pset_fapl_mpio(fapl, io_comm, MPI_INFO_NULL) >= 0,
+      throw_assert(hdf5::set_parallel_file_access(fapl, io_comm) >= 0,
                    "append_cell_attribute_map: HDF5 mpio error");
 
       /* Cache parameters: */
@@ -657,7 +734,7 @@ namespace neuroh5
             {
               create_cell_attribute_datasets(file, attr_namespace, pop_name, attr_name,
                                              ftype, index_type, ptr_type,
-                                             chunk_size, value_chunk_size
+                                             chunk_size, value_chunk_size, filters
                                              );
             }
           status = H5Fclose(file);
@@ -672,7 +749,7 @@ namespace neuroh5
 
       append_cell_attribute_map<T>(comm, file, attr_namespace, pop_name, pop_start, attr_name, value_map,
                                    io_size, data_type, IndexOwner, CellPtr(PtrOwner),
-                                   chunk_size, value_chunk_size, cache_size);
+                                   chunk_size, value_chunk_size, cache_size, filters);
 
       throw_assert(MPI_Barrier(comm) == MPI_SUCCESS, "error in MPI_Barrier");
       throw_assert(MPI_Comm_free(&io_comm) == MPI_SUCCESS,
@@ -694,12 +771,13 @@ namespace neuroh5
      const data::optional_hid        data_type,
      const size_t chunk_size = 4000,
      const size_t value_chunk_size = 4000,
-     const size_t cache_size = 1*1024*1024
+     const size_t cache_size = 1*1024*1024,
+     const FilterConfig& filters = hdf5::default_filter_config()
      )
     {
       append_cell_attribute_map<T>(comm, file_name, attr_namespace, pop_name, pop_start, attr_name, value_map,
                                    io_size, data_type, IndexOwner, CellPtr(PtrOwner),
-                                   chunk_size, value_chunk_size, cache_size);
+                                   chunk_size, value_chunk_size, cache_size, filters);
     }
 
     template <typename T>
@@ -719,7 +797,8 @@ namespace neuroh5
      const CellPtr                   ptr_type,
      const size_t chunk_size = 4000,
      const size_t value_chunk_size = 4000,
-     const size_t cache_size = 1*1024*1024
+     const size_t cache_size = 1*1024*1024,
+     const FilterConfig& filters = hdf5::default_filter_config()
      )
     {
       int status;
@@ -734,7 +813,7 @@ namespace neuroh5
       // get a file handle and retrieve the MPI info
       hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
 
-      throw_assert(H5Pset_fapl_mpio(fapl, comm, MPI_INFO_NULL) >= 0,
+      throw_assert(hdf5::set_parallel_file_access(fapl, comm) >= 0,
 		   "write_cell_attribute: unable to set fapl mpio property");
 
       /* Cache parameters: */
@@ -785,7 +864,7 @@ namespace neuroh5
             {
               create_cell_attribute_datasets(file, attr_namespace, pop_name, attr_name,
                                              ftype, index_type, ptr_type,
-                                             chunk_size, value_chunk_size
+                                             chunk_size, value_chunk_size, filters
                                              );
             }
           status = H5Fclose(file);
@@ -832,7 +911,8 @@ namespace neuroh5
      const CellPtr                   ptr_type = CellPtr(PtrOwner),
      const size_t chunk_size = 4000,
      const size_t value_chunk_size = 4000,
-     const size_t cache_size = 1*1024*1024
+     const size_t cache_size = 1*1024*1024,
+     const FilterConfig& filters = hdf5::default_filter_config()
      )
     {
       vector<CELL_IDX_T>  index_vector;
@@ -994,7 +1074,7 @@ namespace neuroh5
                                   attr_namespace, pop_name, pop_start, attr_name,
                                   gid_recvbuf, attr_ptr, value_recvbuf,
                                   data_type, index_type, ptr_type, 
-                                  chunk_size, value_chunk_size, cache_size);
+                                  chunk_size, value_chunk_size, cache_size, filters);
         }
       
       throw_assert(MPI_Barrier(io_comm) == MPI_SUCCESS,
@@ -1020,12 +1100,13 @@ namespace neuroh5
      const data::optional_hid        data_type,
      const size_t chunk_size = 4000,
      const size_t value_chunk_size = 4000,
-     const size_t cache_size = 1*1024*1024
+     const size_t cache_size = 1*1024*1024,
+     const FilterConfig& filters = hdf5::default_filter_config()
      )
     {
       write_cell_attribute_map<T>(comm, file_name, attr_namespace, pop_name, pop_start, attr_name,
                                   value_map, io_size, data_type, IndexOwner, CellPtr(PtrOwner),
-                                  chunk_size, value_chunk_size, cache_size);
+                                  chunk_size, value_chunk_size, cache_size, filters);
     }
   }
   
@@ -13,6 +13,7 @@
 #include <mpi.h>
 #include <vector>
 #include "neuroh5_types.hh"
+#include "neuroh5_file.hh"
 
 namespace neuroh5
 {
@@ -36,6 +37,15 @@ namespace neuroh5
      std::set< std::pair<pop_t,pop_t> >&  pop_pairs
      );
 
+    /// @brief Reads the valid combinations of source/destination
+    ///        populations through a file session; the result is cached in
+    ///        the session.
+    extern herr_t read_population_combos
+    (
+     File&                                              file,
+     std::set< std::pair<pop_t,pop_t> >&  pop_pairs
+     );
+
     extern herr_t read_population_combos_serial
     (
      const std::string&                                 file_name,
@@ -67,6 +77,15 @@ namespace neuroh5
      size_t&                          total_num_nodes
      );
 
+    /// @brief Reads the id ranges of each population through a file
+    ///        session; the result is cached in the session.
+    extern herr_t read_population_ranges
+    (
+     File&                            file,
+     pop_range_map_t&                 pop_ranges,
+     size_t&                          total_num_nodes
+     );
+
     extern herr_t read_population_labels
     (
      MPI_Comm                         comm,
@@ -74,6 +93,12 @@ namespace neuroh5
      pop_label_map_t&                 pop_labels
      );
 
+    extern herr_t read_population_labels
+    (
+     File&                            file,
+     pop_label_map_t&                 pop_labels
+     );
+
     
     herr_t read_population_names
     (
@@ -81,6 +106,12 @@ namespace neuroh5
      const std::string&   file_name,
      vector<string>&      pop_names
      );
+
+    herr_t read_population_names
+    (
+     File&                file,
+     vector<string>&      pop_names
+     );
   }
 }
 
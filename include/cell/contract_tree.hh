@@ -4,43 +4,32 @@
 ///
 ///  Definition for tree contraction routine.
 ///
-///  Copyright (C) 2016-2021 Project NeuroH5.
+///  Copyright (C) 2016-2025 Project NeuroH5.
 //==============================================================================
 #ifndef CONTRACT_TREE_HH
 #define CONTRACT_TREE_HH
 
-#include <vector>
 #include <deque>
 
 #include "neuroh5_types.hh"
-#include "ngraph.hh"
+#include "tree_topology.hh"
 
 namespace neuroh5
 {
   namespace cell
   {
-    void contract_tree_bfs (const NGraph::Graph &A,
-                            const std::deque<SWC_TYPE_T>& types,
-                            NGraph::Graph::vertex_set& roots,
-                            NGraph::Graph &S, contraction_map_t& contraction_map,
-                            NGraph::Graph::vertex sp, NGraph::Graph::vertex spp);
-    void contract_tree_dfs (const NGraph::Graph &A, 
-                            const std::deque<SWC_TYPE_T>& types,
-                            NGraph::Graph::vertex_set& roots,
-                            NGraph::Graph &S, contraction_map_t& contraction_map,
-                            NGraph::Graph::vertex sp, NGraph::Graph::vertex spp);
-    void contract_tree_regions_bfs (const NGraph::Graph &A,
-                                    const std::deque<LAYER_IDX_T>& regions,
-                                    const std::deque<SWC_TYPE_T>& types,
-                                    NGraph::Graph::vertex_set& roots,
-                                    NGraph::Graph &S, contraction_map_t& contraction_map,
-                                    NGraph::Graph::vertex sp, NGraph::Graph::vertex spp);
-    void contract_tree_regions_dfs (const NGraph::Graph &A,
-                                    const std::deque<LAYER_IDX_T>& regions,
-                                    const std::deque<SWC_TYPE_T>& types,
-                                    NGraph::Graph::vertex_set& roots,
-                                    NGraph::Graph &S, contraction_map_t& contraction_map,
-                                    NGraph::Graph::vertex sp, NGraph::Graph::vertex spp);
+    /// @brief Contracts the points of tree t into sections of unbranched
+    ///        points of equal SWC type, and of equal region if
+    ///        split_regions is set. Types and regions are indexed by
+    ///        point position; output is in the layout of the
+    ///        src/dst/sections columns of neurotree_t, with point ids.
+    void contract_tree_sections (const TreeTopology& topology, size_t t,
+                                 const std::deque<LAYER_IDX_T>& regions,
+                                 const std::deque<SWC_TYPE_T>& types,
+                                 const bool split_regions,
+                                 std::deque<SECTION_IDX_T>& src_vector,
+                                 std::deque<SECTION_IDX_T>& dst_vector,
+                                 std::deque<SECTION_IDX_T>& sec_vector);
   }
 }
 
@@ -7,6 +7,8 @@
 #include <vector>
 #include <forward_list>
 
+#include "tree_arena.hh"
+
 namespace neuroh5
 {
 
@@ -28,6 +30,19 @@ namespace neuroh5
      bool collective = true
      );
 
+    /// @brief Variant of read_trees that copies the trees into one
+    ///        contiguous arena.
+    int read_trees
+    (
+     MPI_Comm comm,
+     const std::string& file_name,
+     const std::string& pop_name,
+     const CELL_IDX_T& pop_start,
+     data::TreeArena &trees,
+     size_t offset = 0,
+     size_t numitems = 0
+     );
+
     int read_tree_selection
     (
      MPI_Comm comm,
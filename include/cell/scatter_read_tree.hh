@@ -8,7 +8,9 @@
 #include <map>
 
 #include "neuroh5_types.hh"
+#include "rank_map.hh"
 #include "attr_map.hh"
+#include "tree_arena.hh"
 
 namespace neuroh5
 {
@@ -27,7 +29,7 @@ namespace neuroh5
      const int                             io_size,
      const std::vector<std::string>       &attr_name_spaces,
      // A vector that maps nodes to compute ranks
-     const node_rank_map_t                &node_rank_map,
+     const data::NodeRankMap            &node_rank_map,
      const string                         &pop_name,
      const CELL_IDX_T                      pop_start,
      std::map<CELL_IDX_T, neurotree_t>    &tree_map,
@@ -36,6 +38,24 @@ namespace neuroh5
      size_t numitems = 0
      );
 
+    /// @brief Variant of scatter_read_trees that delivers the trees of
+    ///        each rank in one contiguous arena; the I/O ranks build one
+    ///        arena per destination rank.
+    int scatter_read_trees
+    (
+     MPI_Comm                              all_comm,
+     const std::string&                    file_name,
+     const int                             io_size,
+     const std::vector<std::string>       &attr_name_spaces,
+     const data::NodeRankMap            &node_rank_map,
+     const string                         &pop_name,
+     const CELL_IDX_T                      pop_start,
+     data::TreeArena                      &trees,
+     std::map<string, data::NamedAttrMap> &attr_maps,
+     size_t offset = 0,
+     size_t numitems = 0
+     );
+
     int scatter_read_tree_selection
     (
      MPI_Comm                        all_comm,
@@ -0,0 +1,48 @@
+// -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+//==============================================================================
+///  @file stitch_cell_attributes.hh
+///
+///  Merges cell attributes written in subfile mode into the output file.
+///
+///  Copyright (C) 2016-2025 Project NeuroH5.
+//==============================================================================
+
+#ifndef STITCH_CELL_ATTRIBUTES_HH
+#define STITCH_CELL_ATTRIBUTES_HH
+
+#include "neuroh5_types.hh"
+#include "dataset_filters.hh"
+
+#include <mpi.h>
+
+#include <string>
+
+namespace neuroh5
+{
+  namespace cell
+  {
+
+    /// @brief Appends the cell attributes found in the subfiles of the
+    ///        given output file to the output file, one namespace of one
+    ///        population at a time. The subfiles are assigned to the ranks
+    ///        of comm in round-robin order. Trees are not merged, and the
+    ///        subfiles are not removed.
+    ///
+    /// @param comm          MPI communicator
+    ///
+    /// @param file_name     Output file name; it must contain the
+    ///                      population definitions used by the subfiles
+    void stitch_cell_attribute_subfiles
+    (
+     MPI_Comm            comm,
+     const std::string&  file_name,
+     const size_t        chunk_size = 4000,
+     const size_t        value_chunk_size = 4000,
+     const size_t        cache_size = 1*1024*1024,
+     const FilterConfig& filters = hdf5::default_filter_config()
+     );
+
+  }
+}
+
+#endif
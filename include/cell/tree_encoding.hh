@@ -0,0 +1,69 @@
+// -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+//==============================================================================
+///  @file tree_encoding.hh
+///
+///  Quantized encoding of the point attributes of trees.
+///
+///  Copyright (C) 2016-2025 Project NeuroH5.
+//==============================================================================
+#ifndef TREE_ENCODING_HH
+#define TREE_ENCODING_HH
+
+#include <vector>
+
+#include "neuroh5_types.hh"
+#include "attr_map.hh"
+#include "columnar_attr_map.hh"
+
+namespace neuroh5
+{
+  namespace cell
+  {
+
+    // Point attributes of a set of trees in TreeQuantized form; the
+    // values of tree i are delimited by point_ptr, origin_ptr,
+    // layer_run_ptr and swc_type_run_ptr
+    struct EncodedTreePoints
+    {
+      std::vector<ATTR_PTR_T>        origin_ptr;
+      std::vector<COORD_T>           origins;
+      std::vector<int16_t>           x_offsets, y_offsets, z_offsets;
+      std::vector<uint16_t>          radiuses;
+      std::vector<PARENT_NODE_IDX_T> parent_deltas;
+      std::vector<ATTR_PTR_T>        layer_run_ptr;
+      std::vector<LAYER_IDX_T>       layer_runs;
+      std::vector<uint32_t>          layer_run_lengths;
+      std::vector<ATTR_PTR_T>        swc_type_run_ptr;
+      std::vector<SWC_TYPE_T>        swc_type_runs;
+      std::vector<uint32_t>          swc_type_run_lengths;
+    };
+
+    /// @brief Encodes the points of the trees delimited by point_ptr
+    ///        with the given precision bound. Throws if an offset or
+    ///        radius does not fit the fixed-point range at that
+    ///        precision.
+    void encode_tree_points
+    (
+     const double                          precision,
+     const std::vector<CELL_IDX_T>&        index,
+     const std::vector<ATTR_PTR_T>&        point_ptr,
+     const std::vector<COORD_T>&           xcoords,
+     const std::vector<COORD_T>&           ycoords,
+     const std::vector<COORD_T>&           zcoords,
+     const std::vector<REALVAL_T>&         radiuses,
+     const std::vector<LAYER_IDX_T>&       layers,
+     const std::vector<PARENT_NODE_IDX_T>& parents,
+     const std::vector<SWC_TYPE_T>&        swc_types,
+     EncodedTreePoints&                    encoded
+     );
+
+    /// @brief If the trees attributes were stored with TreeQuantized
+    ///        encoding, decodes them and inserts the plain point
+    ///        attributes, so that trees can be built from the map as
+    ///        from a plain Trees namespace. Does nothing otherwise.
+    void decode_tree_points (data::NamedAttrMap& attr_values);
+    void decode_tree_points (data::NamedColumnarAttrMap& attr_values);
+  }
+}
+
+#endif
@@ -0,0 +1,131 @@
+// -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+//==============================================================================
+///  @file tree_topology.hh
+///
+///  Point and section topology of trees in flat arrays.
+///
+///  Copyright (C) 2016-2025 Project NeuroH5.
+//==============================================================================
+#ifndef TREE_TOPOLOGY_HH
+#define TREE_TOPOLOGY_HH
+
+#include <deque>
+#include <vector>
+
+#include "neuroh5_types.hh"
+#include "columnar_attr_map.hh"
+#include "throw_assert.hh"
+
+namespace neuroh5
+{
+  namespace cell
+  {
+
+    // Point topology of a batch of trees. The points of tree t are
+    // point_ptr[t] .. point_ptr[t+1]-1 and are numbered from 0 within
+    // the tree; the children of point p of tree t are
+    // children[child_ptr[point_ptr[t]+p] .. child_ptr[point_ptr[t]+p+1]-1]
+    // and its roots are roots[root_ptr[t] .. root_ptr[t+1]-1], both in
+    // ascending order. Outside the topology, point p of tree t is
+    // identified as id_base[t]+p.
+    struct TreeTopology
+    {
+      std::vector<size_t>     point_ptr {0};
+      std::vector<size_t>     child_ptr {0};
+      std::vector<NODE_IDX_T> children;
+      std::vector<size_t>     root_ptr {0};
+      std::vector<NODE_IDX_T> roots;
+      std::vector<NODE_IDX_T> id_base;
+
+      size_t size () const
+      {
+        return point_ptr.size() - 1;
+      }
+
+      size_t num_points (size_t t) const
+      {
+        return point_ptr[t+1] - point_ptr[t];
+      }
+
+      data::AttrSpan<NODE_IDX_T> point_children (size_t t, NODE_IDX_T p) const
+      {
+        const size_t i = point_ptr[t] + p;
+        return data::AttrSpan<NODE_IDX_T> { children.data() + child_ptr[i], child_ptr[i+1] - child_ptr[i] };
+      }
+
+      data::AttrSpan<NODE_IDX_T> tree_roots (size_t t) const
+      {
+        return data::AttrSpan<NODE_IDX_T> { roots.data() + root_ptr[t], root_ptr[t+1] - root_ptr[t] };
+      }
+
+      /// @brief Appends a tree given the parent id of each point, -1 for
+      ///        a root, with one counting pass over the parents. Point
+      ///        ids are numbered from base.
+      template<class Iterator>
+      void append (Iterator first, Iterator last, const NODE_IDX_T base = 0)
+      {
+        const size_t num_tree_points = last - first;
+        const size_t offset = child_ptr.size() - 1;
+
+        child_ptr.resize(offset + num_tree_points + 1, 0);
+        for (Iterator it = first; it != last; ++it)
+          {
+            if (*it < 0)
+              {
+                roots.push_back(it - first);
+              }
+            else
+              {
+                const int64_t parent = (int64_t)*it - (int64_t)base;
+                throw_assert((parent >= 0) && ((size_t)parent < num_tree_points),
+                             "TreeTopology::append: parent " << *it << " of point " << (it - first) <<
+                             " is out of range");
+                child_ptr[offset + parent + 1]++;
+              }
+          }
+        for (size_t p = 0; p < num_tree_points; p++)
+          {
+            child_ptr[offset + p + 1] += child_ptr[offset + p];
+          }
+
+        std::vector<size_t> pos(child_ptr.begin() + offset, child_ptr.end() - 1);
+        children.resize(child_ptr.back());
+        for (Iterator it = first; it != last; ++it)
+          {
+            if (*it >= 0)
+              {
+                children[pos[*it - base]++] = it - first;
+              }
+          }
+
+        point_ptr.push_back(point_ptr.back() + num_tree_points);
+        root_ptr.push_back(roots.size());
+        id_base.push_back(base);
+      }
+
+      void clear ()
+      {
+        point_ptr.assign(1, 0);
+        child_ptr.assign(1, 0);
+        children.clear();
+        root_ptr.assign(1, 0);
+        roots.clear();
+        id_base.clear();
+      }
+    };
+
+
+    /// @brief Number of distinct points listed in a sections column;
+    ///        throws if a point index exceeds num_points.
+    size_t count_section_points (const CELL_IDX_T tree_id,
+                                 const std::deque<SECTION_IDX_T>& sections,
+                                 const size_t num_points);
+
+    /// @brief Number of sections without a parent section.
+    size_t count_section_roots (const size_t num_sections,
+                                const std::deque<SECTION_IDX_T>& src_vector,
+                                const std::deque<SECTION_IDX_T>& dst_vector);
+  }
+}
+
+#endif
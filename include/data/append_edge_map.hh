@@ -32,6 +32,24 @@ namespace neuroh5
      edge_map_t &                            edge_map,
      EdgeMapType                             edge_map_type
      );
+
+    /// @brief Variant of append_edge_map that builds a CSR edge
+    ///        container, keyed by destination (EdgeMapDst) or source
+    ///        (EdgeMapSrc).
+    int append_edge_map
+    (
+     const NODE_IDX_T&                       dst_start,
+     const NODE_IDX_T&                       src_start,
+     const std::vector<DST_BLK_PTR_T>&       dst_blk_ptr,
+     const std::vector<NODE_IDX_T>&          dst_idx,
+     const std::vector<DST_PTR_T>&           dst_ptr,
+     const std::vector<NODE_IDX_T>&          src_idx,
+     const vector<string>&                   attr_namespaces,
+     const map<string, data::NamedAttrVal>&  edge_attr_map,
+     size_t&                                 num_edges,
+     edge_csr_t &                            edge_csr,
+     EdgeMapType                             edge_map_type
+     );
   }
 }
 
@@ -17,7 +17,9 @@
 
 #include "neuroh5_types.hh"
 #include "attr_map.hh"
+#include "columnar_attr_map.hh"
 #include "attr_val.hh"
+#include "rank_map.hh"
 
 namespace neuroh5
 {
@@ -28,8 +30,16 @@ namespace neuroh5
     void append_rank_attr_map
     (
      const data::NamedAttrMap   &attr_values,
-     const node_rank_map_t &node_rank_map,
+     const data::NodeRankMap &node_rank_map,
      map <rank_t, data::AttrMap> &rank_attr_map);
+
+    /// @brief Splits the columns of attr_values by destination rank; the
+    ///        cells of each rank remain in ascending order.
+    void append_rank_attr_map
+    (
+     const data::NamedColumnarAttrMap &attr_values,
+     const data::NodeRankMap &node_rank_map,
+     map <rank_t, data::ColumnarAttrMap> &rank_attr_map);
     
   }
   
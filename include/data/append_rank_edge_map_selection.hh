@@ -15,6 +15,7 @@
 #include <map>
 
 #include "neuroh5_types.hh"
+#include "rank_map.hh"
 
 namespace neuroh5
 {
@@ -31,7 +32,7 @@ namespace neuroh5
      const std::vector<NODE_IDX_T>&          src_idx,
      const vector<string>&                   attr_namespaces,
      const map<string, data::NamedAttrVal>&  edge_attr_map,
-     const node_rank_map_t&                  node_rank_map,
+     const data::NodeRankMap&                node_rank_map,
      size_t&                                 num_edges,
      rank_edge_map_t &                       rank_edge_map,
      EdgeMapType                             edge_map_type
@@ -15,6 +15,7 @@
 #include <map>
 
 #include "neuroh5_types.hh"
+#include "rank_map.hh"
 
 namespace neuroh5
 {
@@ -23,7 +24,7 @@ namespace neuroh5
   {
     void append_rank_tree_map
     (NamedAttrMap&       attr_values,
-     const node_rank_map_t& node_rank_map,
+     const data::NodeRankMap& node_rank_map,
      map <rank_t, map<CELL_IDX_T, neurotree_t> > &rank_tree_map);
     
   }
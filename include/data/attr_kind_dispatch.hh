@@ -0,0 +1,69 @@
+// -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+//==============================================================================
+///  @file attr_kind_dispatch.hh
+///
+///  Selection of the C++ value type of an attribute kind.
+///
+///  Copyright (C) 2016-2025 Project NeuroH5.
+//==============================================================================
+#ifndef ATTR_KIND_DISPATCH_HH
+#define ATTR_KIND_DISPATCH_HH
+
+#include <cstdint>
+#include <stdexcept>
+
+#include "neuroh5_types.hh"
+
+namespace neuroh5
+{
+  namespace data
+  {
+    /// Calls f with a null pointer to the C++ type that holds the values
+    /// of the given attribute kind; throws if the kind has no such type
+    template <class F>
+    void attr_kind_dispatch
+    (
+     const AttrKind& attr_kind,
+     F&&             f
+     )
+    {
+      switch (attr_kind.type)
+        {
+        case UIntVal:
+          if (attr_kind.size == 4)
+            f((uint32_t*)nullptr);
+          else if (attr_kind.size == 2)
+            f((uint16_t*)nullptr);
+          else if (attr_kind.size == 1)
+            f((uint8_t*)nullptr);
+          else
+            throw std::runtime_error("Unsupported integer attribute size");
+          break;
+        case SIntVal:
+          if (attr_kind.size == 4)
+            f((int32_t*)nullptr);
+          else if (attr_kind.size == 2)
+            f((int16_t*)nullptr);
+          else if (attr_kind.size == 1)
+            f((int8_t*)nullptr);
+          else
+            throw std::runtime_error("Unsupported integer attribute size");
+          break;
+        case FloatVal:
+          f((float*)nullptr);
+          break;
+        case EnumVal:
+          if (attr_kind.size == 1)
+            f((uint8_t*)nullptr);
+          else
+            throw std::runtime_error("Unsupported enumerated attribute size");
+          break;
+        default:
+          throw std::runtime_error("Unsupported attribute type");
+          break;
+        }
+    }
+  }
+}
+
+#endif
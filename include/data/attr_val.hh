@@ -422,6 +422,36 @@ namespace neuroh5
     }
 
 
+    template <class T>
+    void gather_attr_vec (const std::map< std::string, NamedAttrVal>& attr_map,
+                          const std::vector<std::string>& attr_namespaces,
+                          std::vector<AttrVal>& attr_vec,
+                          const std::vector<size_t>& index)
+    {
+      size_t i=0;
+      for (const std::string& ns : attr_namespaces)
+        {
+          const auto& iter = attr_map.find(ns);
+          throw_assert(iter != attr_map.cend(),
+                       "gather_attr_vec: unable to find namespace");
+          const NamedAttrVal& attr_values = iter->second;
+          attr_vec[i].resize<T>(attr_values.size_attr_vec<T>());
+          for (size_t k = 0;
+               k < attr_vec[i].size_attr_vec<T>(); k++)
+            {
+              const std::vector<T>& src_values = attr_values.const_attr_vec<T>(k);
+              std::vector<T>& dst_values = attr_vec[i].attr_vec<T>(k);
+              dst_values.reserve(dst_values.size() + index.size());
+              for (const size_t j : index)
+                {
+                  dst_values.push_back(src_values[j]);
+                }
+            }
+          i++;
+        }
+    }
+
+
   }
 }
 
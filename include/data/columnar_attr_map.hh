@@ -0,0 +1,385 @@
+// -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+//==============================================================================
+///  @file columnar_attr_map.hh
+///
+///  Cell attributes stored in compressed sparse row form.
+///
+///  Copyright (C) 2016-2025 Project NeuroH5.
+//==============================================================================
+
+#ifndef COLUMNAR_ATTR_MAP_HH
+#define COLUMNAR_ATTR_MAP_HH
+
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <string>
+#include <vector>
+#include <typeindex>
+
+#include "cereal/types/vector.hpp"
+
+#include "throw_assert.hh"
+#include "neuroh5_types.hh"
+#include "attr_map.hh"
+
+namespace neuroh5
+{
+  namespace data
+  {
+
+    // Read-only view of the values of one cell
+    template<class T>
+    struct AttrSpan
+    {
+      const T* first;
+      size_t   count;
+
+      const T* begin () const { return first; }
+      const T* end () const { return first + count; }
+      size_t size () const { return count; }
+      const T& operator[] (size_t i) const { return first[i]; }
+    };
+
+    // Values of one attribute: the values of cell index[i] are
+    // values[ptr[i]] .. values[ptr[i+1]-1]; index is sorted and has no
+    // duplicates
+    template<class T>
+    struct AttrColumn
+    {
+      std::vector<CELL_IDX_T> index;
+      std::vector<ATTR_PTR_T> ptr {0};
+      std::vector<T>          values;
+
+      template<class Archive>
+      void serialize(Archive & archive)
+      {
+        archive(index, ptr, values);
+      }
+
+      size_t size () const
+      {
+        return index.size();
+      }
+
+      /// @brief Position of the cell in index, or size() if the cell has
+      ///        no values in this column.
+      size_t find (CELL_IDX_T cell) const
+      {
+        auto it = std::lower_bound(index.cbegin(), index.cend(), cell);
+        if ((it != index.cend()) && (*it == cell))
+          return it - index.cbegin();
+        return index.size();
+      }
+
+      AttrSpan<T> values_at (size_t pos) const
+      {
+        return AttrSpan<T> { values.data() + ptr[pos], (size_t)(ptr[pos+1] - ptr[pos]) };
+      }
+
+      /// @brief Appends the values of a cell that is not less than the
+      ///        last cell of the column; the values of a repeated cell are
+      ///        concatenated.
+      template<class Iterator>
+      void push_back (CELL_IDX_T cell, Iterator first, Iterator last)
+      {
+        throw_assert((index.size() == 0) || (index.back() <= cell),
+                     "AttrColumn::push_back: cells are not in ascending order");
+        if ((index.size() == 0) || (index.back() < cell))
+          {
+            index.push_back(cell);
+            ptr.push_back(ptr.back());
+          }
+        values.insert(values.end(), first, last);
+        ptr.back() = values.size();
+      }
+
+      /// @brief Merges cells in the layout of the cell attribute datasets.
+      ///        When ptr has at most one element, all values belong to
+      ///        each cell. Values of cells already in the column come
+      ///        first. Only the cells of the column after the first new
+      ///        cell are moved, so that inserting cells in ascending order
+      ///        appends to the column.
+      void insert (const std::vector<CELL_IDX_T> &cell_index,
+                   const std::vector<ATTR_PTR_T> &cell_ptr,
+                   const std::vector<T> &value)
+      {
+        if (cell_index.empty())
+          return;
+
+        std::vector<size_t> order(cell_index.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(),
+                         [&cell_index] (size_t a, size_t b) { return cell_index[a] < cell_index[b]; });
+
+        auto value_first = [&] (size_t p) { return value.cbegin() + ((cell_ptr.size() > 1) ? cell_ptr[p] : 0); };
+        auto value_last  = [&] (size_t p) { return (cell_ptr.size() > 1) ? (value.cbegin() + cell_ptr[p+1]) : value.cend(); };
+
+        // move the cells that follow the first new cell out of the column
+        const size_t first = std::upper_bound(index.cbegin(), index.cend(), cell_index[order[0]]) - index.cbegin();
+        AttrColumn<T> rest;
+        if (first < index.size())
+          {
+            rest.index.assign(index.cbegin() + first, index.cend());
+            rest.ptr.resize(rest.index.size() + 1);
+            for (size_t i = 0; i < rest.ptr.size(); i++)
+              {
+                rest.ptr[i] = ptr[first + i] - ptr[first];
+              }
+            rest.values.assign(values.cbegin() + ptr[first], values.cend());
+            index.resize(first);
+            values.resize(ptr[first]);
+            ptr.resize(first + 1);
+          }
+
+        // no reserve here: an exact reservation on every insert would
+        // defeat the geometric growth of the vectors
+        size_t i = 0, j = 0;
+        while ((i < rest.size()) || (j < order.size()))
+          {
+            if ((j == order.size()) || ((i < rest.size()) && (rest.index[i] <= cell_index[order[j]])))
+              {
+                push_back(rest.index[i], rest.values.cbegin() + rest.ptr[i], rest.values.cbegin() + rest.ptr[i+1]);
+                i++;
+              }
+            else
+              {
+                push_back(cell_index[order[j]], value_first(order[j]), value_last(order[j]));
+                j++;
+              }
+          }
+      }
+
+      void insert (const AttrColumn<T>& column)
+      {
+        insert(column.index, column.ptr, column.values);
+      }
+
+      void clear ()
+      {
+        index.clear();
+        ptr.assign(1, 0);
+        values.clear();
+      }
+    };
+
+
+    // Columnar counterpart of AttrMap: each attribute is one AttrColumn,
+    // and index is the sorted union of the cells of all attributes
+    struct ColumnarAttrMap
+    {
+      std::vector<CELL_IDX_T> index;
+
+      std::vector <AttrColumn <float> >    float_values;
+      std::vector <AttrColumn <uint8_t> >  uint8_values;
+      std::vector <AttrColumn <int8_t> >   int8_values;
+      std::vector <AttrColumn <uint16_t> > uint16_values;
+      std::vector <AttrColumn <int16_t> >  int16_values;
+      std::vector <AttrColumn <uint32_t> > uint32_values;
+      std::vector <AttrColumn <int32_t> >  int32_values;
+
+      template<class Archive>
+      void serialize(Archive & archive)
+      {
+        archive(index,
+                float_values,
+                uint8_values,
+                int8_values,
+                uint16_values,
+                int16_values,
+                uint32_values,
+                int32_values);
+      }
+
+      template<class T>
+      const std::vector< AttrColumn<T> >& attr_columns () const;
+      template<class T>
+      std::vector< AttrColumn<T> >& attr_columns ();
+
+      void num_attrs (std::vector<size_t> &v) const;
+
+      template<class T>
+      size_t num_attr () const
+      {
+        return attr_columns<T>().size();
+      }
+
+      /// @brief Adds sorted cells to the index; only the part of the
+      ///        index after the first new cell is rebuilt.
+      void merge_index (const std::vector<CELL_IDX_T>& cells)
+      {
+        if (cells.empty())
+          return;
+        auto first = std::lower_bound(index.begin(), index.end(), cells.front());
+        std::vector<CELL_IDX_T> merged;
+        merged.reserve((index.end() - first) + cells.size());
+        std::set_union(first, index.end(), cells.cbegin(), cells.cend(),
+                       std::back_inserter(merged));
+        index.erase(first, index.end());
+        index.insert(index.end(), merged.cbegin(), merged.cend());
+      }
+
+      template<class T>
+      size_t insert (const size_t attr_index,
+                     const std::vector<CELL_IDX_T> &cell_index,
+                     const std::vector<ATTR_PTR_T> &ptr,
+                     const std::vector<T> &value)
+      {
+        std::vector< AttrColumn<T> >& columns = attr_columns<T>();
+        columns.resize(std::max(columns.size(), attr_index+1));
+        columns[attr_index].insert(cell_index, ptr, value);
+        std::vector<CELL_IDX_T> cells(cell_index);
+        std::sort(cells.begin(), cells.end());
+        cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+        merge_index(cells);
+        return attr_index;
+      }
+
+      /// @brief Values of the cell in each attribute of type T that has
+      ///        the cell, in attribute order. The views are invalidated
+      ///        by any change to the map.
+      template<class T>
+      std::vector< AttrSpan<T> > find (CELL_IDX_T cell) const
+      {
+        const std::vector< AttrColumn<T> >& columns = attr_columns<T>();
+        std::vector< AttrSpan<T> > result;
+        for (size_t i=0; i<columns.size(); i++)
+          {
+            size_t pos = columns[i].find(cell);
+            if (pos < columns[i].size())
+              {
+                result.push_back(columns[i].values_at(pos));
+              }
+          }
+        return result;
+      }
+
+      template<class T>
+      void insert_columns (std::vector< AttrColumn<T> >& a,
+                           const std::vector< AttrColumn<T> >& b)
+      {
+        a.resize(std::max(a.size(), b.size()));
+        for (size_t i=0; i<b.size(); i++)
+          {
+            a[i].insert(b[i]);
+          }
+      }
+
+      /// @brief Merges the columns of another map. Unlike
+      ///        AttrMap::insert_map, which keeps the values of a cell
+      ///        present in both maps, the values of such a cell are
+      ///        concatenated, those of this map first.
+      void insert_map (const ColumnarAttrMap& a)
+      {
+        merge_index(a.index);
+        insert_columns(float_values, a.float_values);
+        insert_columns(uint8_values, a.uint8_values);
+        insert_columns(int8_values, a.int8_values);
+        insert_columns(uint16_values, a.uint16_values);
+        insert_columns(int16_values, a.int16_values);
+        insert_columns(uint32_values, a.uint32_values);
+        insert_columns(int32_values, a.int32_values);
+      }
+
+      void clear ()
+      {
+        float_values.clear();
+        uint8_values.clear();
+        int8_values.clear();
+        uint16_values.clear();
+        int16_values.clear();
+        uint32_values.clear();
+        int32_values.clear();
+        index.clear();
+      }
+
+    };
+
+
+    struct NamedColumnarAttrMap : ColumnarAttrMap
+    {
+
+      std::map<std::type_index, std::map <std::string, size_t> > attr_name_map;
+
+      template<class T>
+      void attr_names_type (std::vector<std::string> &output) const
+      {
+        auto type_it = attr_name_map.find(std::type_index(typeid(T)));
+        if (type_it != attr_name_map.cend())
+          {
+            const std::map<std::string, size_t> &attr_names = type_it->second;
+            output.resize(attr_names.size());
+            for (auto element : attr_names)
+              {
+                output[element.second] = element.first;
+              }
+          }
+      }
+
+      void attr_names (std::vector<std::vector<std::string> > &) const;
+
+      template<class T>
+      size_t insert_name (std::string name)
+      {
+        std::map <std::string, size_t>& name_map = this->attr_name_map[std::type_index(typeid(T))];
+        std::vector< AttrColumn<T> >& columns = attr_columns<T>();
+        size_t index = 0;
+        auto it = name_map.find(name);
+        if (it == name_map.end())
+          {
+            index = name_map.size();
+            name_map.insert(make_pair(name, index));
+            columns.resize(std::max(columns.size(), index+1));
+          }
+        else
+          {
+            index = it->second;
+          }
+
+        return index;
+      }
+
+      template<class T>
+      size_t insert (std::string name,
+                     const std::vector<CELL_IDX_T> &cell_index,
+                     const std::vector<ATTR_PTR_T> &ptr,
+                     const std::vector<T> &value)
+      {
+        size_t attr_index = insert_name<T>(name);
+        ColumnarAttrMap::insert(attr_index, cell_index, ptr, value);
+        return attr_index;
+      }
+
+      template<class T>
+      AttrSpan<T> find_name (const std::string& name, CELL_IDX_T cell) const
+      {
+        AttrSpan<T> result { nullptr, 0 };
+        auto type_it = attr_name_map.find(std::type_index(typeid(T)));
+        if (type_it != attr_name_map.cend())
+          {
+            const std::map <std::string, size_t>& name_map = type_it->second;
+
+            auto attr_it = name_map.find(name);
+            throw_assert(attr_it != name_map.end(),
+                         "NamedColumnarAttrMap::find_name: attribute " << name << " not found");
+            const AttrColumn<T>& column = attr_columns<T>()[attr_it->second];
+            size_t pos = column.find(cell);
+            if (pos < column.size())
+              {
+                result = column.values_at(pos);
+              }
+          }
+        return result;
+      }
+
+      void clear()
+      {
+        attr_name_map.clear();
+        ColumnarAttrMap::clear();
+      }
+
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,59 @@
+// -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+//==============================================================================
+///  @file edge_csr.hh
+///
+///  Functions for building and converting compressed sparse row
+///  projection containers.
+///
+///  Copyright (C) 2016-2025 Project NeuroH5.
+//==============================================================================
+
+#ifndef EDGE_CSR_HH
+#define EDGE_CSR_HH
+
+#include <vector>
+
+#include "neuroh5_types.hh"
+
+namespace neuroh5
+{
+
+  namespace data
+  {
+    /// @brief Merges the edges of one CSR container into another. Nodes
+    ///        present in both containers get the adjacency list of
+    ///        edge_csr followed by that of other. Both containers must
+    ///        have the same edge attribute namespaces and types unless
+    ///        one of them has no edges; otherwise an exception is thrown.
+    void append_edge_csr
+    (
+     const edge_csr_t&               other,
+     edge_csr_t&                     edge_csr
+     );
+
+    /// @brief Appends the contents of a set of edge maps to a CSR
+    ///        container. Adjacency lists of nodes that occur in more than
+    ///        one map are concatenated in the order of the maps.
+    void edge_map_to_csr
+    (
+     const std::vector<edge_map_t>&  edge_maps,
+     edge_csr_t&                     edge_csr
+     );
+
+    void edge_map_to_csr
+    (
+     const edge_map_t&               edge_map,
+     edge_csr_t&                     edge_csr
+     );
+
+    /// @brief Appends the contents of a CSR container to an edge map,
+    ///        for callers that operate on edge_map_t.
+    void csr_to_edge_map
+    (
+     const edge_csr_t&               edge_csr,
+     edge_map_t&                     edge_map
+     );
+  }
+}
+
+#endif
@@ -0,0 +1,104 @@
+// -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+//==============================================================================
+///  @file rank_map.hh
+///
+///  Compact mapping of graph nodes and cells to the MPI ranks that own
+///  them.
+///
+///  Copyright (C) 2016-2025 Project NeuroH5.
+//==============================================================================
+
+#ifndef RANK_MAP_HH
+#define RANK_MAP_HH
+
+#include <algorithm>
+#include <vector>
+#include <limits>
+
+#include "neuroh5_types.hh"
+
+namespace neuroh5
+{
+  namespace data
+  {
+
+    /// @brief Node-to-rank ownership map. Round-robin and block
+    ///        assignments of a node range are computed on lookup and
+    ///        need no storage; explicit assignments are stored as a flat
+    ///        array of owners when each node has a single owner, and as
+    ///        CSR lists of owners otherwise. A default-constructed map
+    ///        assigns no nodes.
+    class NodeRankMap
+    {
+    public:
+
+      /// Owner ranks of one node
+      class Ranks
+      {
+      public:
+        Ranks () : first(NULL), count(0), single(0) {}
+        Ranks (rank_t r) : first(NULL), count(1), single(r) {}
+        Ranks (const rank_t* p_first, size_t p_count) : first(p_first), count(p_count), single(0) {}
+
+        const rank_t* begin () const { return (first == NULL) ? &single : first; }
+        const rank_t* end () const { return begin() + count; }
+        size_t size () const { return count; }
+        bool empty () const { return count == 0; }
+        bool contains (rank_t r) const { return std::find(begin(), end(), r) != end(); }
+
+      private:
+        // a single owner computed on lookup is stored in single
+        const rank_t *first;
+        size_t count;
+        rank_t single;
+      };
+
+      static const rank_t no_rank = std::numeric_limits<rank_t>::max();
+
+      NodeRankMap () {}
+
+      /// Converts an explicit map of node owner sets to a flat or CSR map
+      NodeRankMap (const node_rank_map_t& node_rank_map);
+
+      /// Assigns node start + i to rank i % num_ranks, for i < num_nodes
+      static NodeRankMap round_robin (size_t num_ranks, NODE_IDX_T start, size_t num_nodes);
+
+      /// Assigns contiguous blocks of the range [start, start +
+      /// num_nodes) to ranks 0 .. num_ranks-1; the blocks differ in size
+      /// by at most one node, with the larger blocks on the higher ranks
+      static NodeRankMap block (size_t num_ranks, NODE_IDX_T start, size_t num_nodes);
+
+      /// Assigns node start + i to owners[i]; entries equal to no_rank
+      /// are unassigned
+      static NodeRankMap flat (NODE_IDX_T start, std::vector<rank_t>&& owners);
+
+      /// Assigns node node_index[i] to owners[offsets[i] .. offsets[i+1]);
+      /// node_index must be sorted
+      static NodeRankMap csr (std::vector<NODE_IDX_T>&& node_index,
+                              std::vector<size_t>&& offsets,
+                              std::vector<rank_t>&& owners);
+
+      /// Returns the owners of a node; empty if the node is not assigned
+      Ranks find (NODE_IDX_T node) const;
+
+      bool contains (NODE_IDX_T node) const { return !find(node).empty(); }
+
+      /// Returns the sorted nodes owned by the given rank
+      void local_nodes (rank_t rank, std::vector<NODE_IDX_T>& nodes) const;
+
+      NodeRankMapType type () const { return map_type; }
+      bool empty () const { return map_type == RankMapNone; }
+
+    private:
+      NodeRankMapType map_type = RankMapNone;
+      NODE_IDX_T start = 0;
+      size_t num_nodes = 0, num_ranks = 0;
+      std::vector<NODE_IDX_T> node_index;
+      std::vector<size_t> offsets;
+      std::vector<rank_t> owners;
+    };
+
+  }
+}
+
+#endif
@@ -18,6 +18,7 @@
 
 #include "neuroh5_types.hh"
 #include "attr_map.hh"
+#include "columnar_attr_map.hh"
 
 namespace neuroh5
 {
@@ -37,6 +38,19 @@ namespace neuroh5
                                     const std::vector<size_t>& rdispls,
                                     AttrMap& all_attr_map);
 
+    void serialize_rank_attr_map (const size_t num_ranks,
+                                  const size_t start_rank,
+                                  const map <rank_t, ColumnarAttrMap>& rank_attr_map,
+                                  std::vector<size_t>& sendcounts,
+                                  std::vector<char> &sendbuf,
+                                  std::vector<size_t> &sdispls);
+
+    void deserialize_rank_attr_map (const size_t num_ranks,
+                                    const std::vector<char> &recvbuf,
+                                    const std::vector<size_t>& recvcounts,
+                                    const std::vector<size_t>& rdispls,
+                                    ColumnarAttrMap& all_attr_map);
+
     
   }
 }
@@ -27,6 +27,10 @@ namespace neuroh5
                              vector<char> &sendbuf);
     
     
+    void serialize_edge_map (const edge_csr_t& edge_csr, 
+                             size_t &num_packed_edges,
+                             vector<char> &sendbuf);
+    
     void serialize_rank_edge_map (const size_t num_ranks,
                                   const size_t start_rank,
                                   const rank_edge_map_t& prj_rank_edge_map, 
@@ -50,6 +54,21 @@ namespace neuroh5
                                size_t& num_unpacked_edges
                                );
 
+    void deserialize_rank_edge_map (const size_t num_ranks,
+                                    const vector<char> &recvbuf,
+                                    const vector<size_t>& recvcounts,
+                                    const vector<size_t>& rdispls,
+                                    edge_csr_t& prj_edge_csr,
+                                    size_t& num_unpacked_nodes,
+                                    size_t& num_unpacked_edges
+                                    );
+    
+    void deserialize_edge_map (const vector<char> &recvbuf,
+                               edge_csr_t& prj_edge_csr,
+                               size_t& num_unpacked_nodes,
+                               size_t& num_unpacked_edges
+                               );
+
   }
 }
 #endif
@@ -18,6 +18,7 @@
 #include <forward_list>
 
 #include "neuroh5_types.hh"
+#include "tree_arena.hh"
 
 namespace neuroh5
 {
@@ -42,6 +43,21 @@ namespace neuroh5
                                      const vector<size_t>& recvcounts,
                                      const vector<size_t>& rdispls,
                                      forward_list<neurotree_t> &all_tree_list);
+
+    void serialize_rank_tree_arena (const size_t num_ranks,
+                                    const size_t start_rank,
+                                    const std::map <rank_t, TreeArena>& rank_tree_arena,
+                                    std::vector<size_t>& sendcounts,
+                                    std::vector<char> &sendbuf,
+                                    std::vector<size_t> &sdispls);
+
+    /// @brief Appends the received arenas to all_trees in the order of
+    ///        the sending ranks.
+    void deserialize_rank_tree_arena (const size_t num_ranks,
+                                      const std::vector<char> &recvbuf,
+                                      const std::vector<size_t>& recvcounts,
+                                      const std::vector<size_t>& rdispls,
+                                      TreeArena &all_trees);
   }
 }
 #endif
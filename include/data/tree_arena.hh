@@ -0,0 +1,106 @@
+// -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+//==============================================================================
+///  @file tree_arena.hh
+///
+///  Tree morphologies stored in one contiguous buffer.
+///
+///  Copyright (C) 2016-2025 Project NeuroH5.
+//==============================================================================
+
+#ifndef TREE_ARENA_HH
+#define TREE_ARENA_HH
+
+#include <array>
+#include <vector>
+
+#include "cereal/types/array.hpp"
+#include "cereal/types/vector.hpp"
+
+#include "neuroh5_types.hh"
+#include "columnar_attr_map.hh"
+
+namespace neuroh5
+{
+  namespace data
+  {
+
+    // Columns of a batch of trees in one buffer. The columns are those of
+    // neurotree_t, and each column is one block of the buffer; the values
+    // of tree i in column c are elements ptr[c][i] .. ptr[c][i+1]-1 of
+    // the block of c, which starts at byte offsets[c].
+    struct TreeArena
+    {
+      static const size_t num_columns  = 10;
+      static const size_t col_src_sec  = 0;
+      static const size_t col_dst_sec  = 1;
+      static const size_t col_sections = 2;
+      static const size_t col_x        = 3;
+      static const size_t col_y        = 4;
+      static const size_t col_z        = 5;
+      static const size_t col_radius   = 6;
+      static const size_t col_layer    = 7;
+      static const size_t col_parent   = 8;
+      static const size_t col_swc_type = 9;
+
+      std::vector<CELL_IDX_T> index;
+      std::array<std::vector<ATTR_PTR_T>, num_columns> ptr;
+      std::array<size_t, num_columns> offsets {};
+      std::vector<char> storage;
+
+      template<class Archive>
+      void serialize(Archive & archive)
+      {
+        archive(index, ptr, offsets, storage);
+      }
+
+      // Calls f with the number of each column and a null pointer to its
+      // value type
+      template <class F>
+      static void for_each_column (F&& f)
+      {
+        f(col_src_sec,  (SECTION_IDX_T*)nullptr);
+        f(col_dst_sec,  (SECTION_IDX_T*)nullptr);
+        f(col_sections, (SECTION_IDX_T*)nullptr);
+        f(col_x,        (COORD_T*)nullptr);
+        f(col_y,        (COORD_T*)nullptr);
+        f(col_z,        (COORD_T*)nullptr);
+        f(col_radius,   (REALVAL_T*)nullptr);
+        f(col_layer,    (LAYER_IDX_T*)nullptr);
+        f(col_parent,   (PARENT_NODE_IDX_T*)nullptr);
+        f(col_swc_type, (SWC_TYPE_T*)nullptr);
+      }
+
+      size_t size () const
+      {
+        return index.size();
+      }
+
+      template<class T>
+      const T* column (size_t c) const
+      {
+        return reinterpret_cast<const T*>(storage.data() + offsets[c]);
+      }
+
+      template<class T>
+      AttrSpan<T> values (size_t c, size_t i) const
+      {
+        return AttrSpan<T> { column<T>(c) + ptr[c][i], (size_t)(ptr[c][i+1] - ptr[c][i]) };
+      }
+
+      /// @brief Copies the trees of the given cells from the attributes
+      ///        of the trees name space; the buffer is allocated once.
+      void assign (const NamedColumnarAttrMap& attr_values,
+                   const std::vector<CELL_IDX_T>& cells);
+
+      /// @brief Appends the trees of another arena, reallocating the
+      ///        buffer once.
+      void append (const TreeArena& other);
+
+      neurotree_t tree (size_t i) const;
+
+      void clear ();
+    };
+  }
+}
+
+#endif
@@ -63,6 +63,23 @@ namespace neuroh5
      size_t                            &local_num_edges,
      size_t                            &total_num_edges
      );
+
+
+    /// @brief Variant of bcast_graph that returns each projection as a
+    ///        CSR edge container.
+    int bcast_graph
+    (
+     MPI_Comm                           all_comm,
+     const EdgeMapType                  edge_map_type,
+     const std::string&                 file_name,
+     const std::vector< std::string > & attr_namespaces,
+     const std::vector< std::pair<std::string,std::string> >& prj_names,
+     std::vector < edge_csr_t >& prj_vector,
+     std::vector < std::map < std::string, std::vector <std::vector <std::string> > > >& edge_attr_names_vector,
+     size_t                            &total_num_nodes,
+     size_t                            &local_num_edges,
+     size_t                            &total_num_edges
+     );
   }
 }
 
@@ -7,10 +7,12 @@
 #include "attr_kind_datatype.hh"
 #include "hdf5_edge_attributes.hh"
 #include "exists_dataset.hh"
+#include "neuroh5_file.hh"
 
 #include <hdf5.h>
 #include <mpi.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -68,6 +70,17 @@ namespace neuroh5
      std::vector< std::pair<std::string,AttrKind> >& out_attributes
      );
 
+    /// @brief Variant of get_edge_attributes that reads through a file
+    ///        session and caches the result in the session.
+    herr_t get_edge_attributes
+    (
+     File&                                        file,
+     const std::string&                           src_pop_name,
+     const std::string&                           dst_pop_name,
+     const string&                                name_space,
+     std::vector< std::pair<std::string,AttrKind> >& out_attributes
+     );
+
     /// @brief Determines the number of edge attributes for each supported
     //         type.
     ///
@@ -175,7 +188,9 @@ namespace neuroh5
      hid_t                    loc,
      const std::string&       path,
      const std::vector<T>&    value,
-     const bool collective = true
+     const bool collective = true,
+     const size_t chunk_size = 4000,
+     const DatasetFilter& filter = DatasetFilter()
      )
     {
       // get a file handle and retrieve the MPI info
@@ -239,8 +254,18 @@ namespace neuroh5
       throw_assert(H5Pset_create_intermediate_group(lcpl, 1) >= 0, 
                    "error in H5Pset_create_intermediate_group");
 
+      // filters require a chunked layout
+      hid_t dcpl = H5Pcreate(H5P_DATASET_CREATE);
+      throw_assert(dcpl >= 0, "error in H5Pcreate");
+      if (!filter.empty() && (total > 0))
+        {
+          hsize_t chunk = std::min((hsize_t)chunk_size, total);
+          throw_assert(H5Pset_chunk(dcpl, 1, &chunk) >= 0, "error in H5Pset_chunk");
+          hdf5::set_dataset_filters(dcpl, filter, ftype);
+        }
+
       hid_t dset = H5Dcreate(loc, path.c_str(), ftype, fspace,
-                             lcpl, H5P_DEFAULT, H5P_DEFAULT);
+                             lcpl, dcpl, H5P_DEFAULT);
       throw_assert(dset >= 0, "error in H5Dcreate");
       throw_assert(H5Dwrite(dset, mtype, mspace, fspace, wapl, &value[0])
                    >= 0, "error in H5Dwrite");
@@ -249,6 +274,7 @@ namespace neuroh5
       throw_assert(H5Tclose(mtype) >= 0, "error in H5Tclose");
       throw_assert(H5Sclose(fspace) >= 0, "error in H5Sclose");
       throw_assert(H5Sclose(mspace) >= 0, "error in H5Sclose");
+      throw_assert(H5Pclose(dcpl) >= 0, "error in H5Pclose");
       throw_assert(H5Pclose(lcpl) >= 0, "error in H5Pclose");
       throw_assert(H5Pclose(wapl) >= 0, "error in H5Pclose");
 
@@ -264,7 +290,9 @@ namespace neuroh5
                                    const string &src_pop_name,
                                    const string &dst_pop_name,
                                    const map <string, data::NamedAttrVal>& edge_attr_map,
-                                   const std::map <std::string, std::pair <size_t, data::AttrIndex > >& edge_attr_index)
+                                   const std::map <std::string, std::pair <size_t, data::AttrIndex > >& edge_attr_index,
+                                   const size_t chunk_size = 4000,
+                                   const DatasetFilter& filter = DatasetFilter())
 
 
     {
@@ -283,7 +311,8 @@ namespace neuroh5
                 {
                   size_t i = attr_index.attr_index<T>(attr_name);
                   string path = hdf5::edge_attribute_path(src_pop_name, dst_pop_name, attr_namespace, attr_name);
-                  graph::write_edge_attribute<T>(comm, file, path, edge_attr_values.const_attr_vec<T>(i));
+                  graph::write_edge_attribute<T>(comm, file, path, edge_attr_values.const_attr_vec<T>(i),
+                                                 true, chunk_size, filter);
                 }
             }
           else
@@ -304,7 +333,8 @@ namespace neuroh5
      const std::string&       attr_name,
      const std::vector<T>&    value,
      const size_t chunk_size = 4000,
-     const bool collective = true
+     const bool collective = true,
+     const DatasetFilter& filter = hdf5::default_filter_config().value
      )
     {
       // get a file handle and retrieve the MPI info
@@ -327,7 +357,7 @@ namespace neuroh5
         {
           hdf5::create_edge_attribute_datasets(file, src_pop_name, dst_pop_name,
                                                attr_namespace, attr_name,
-                                               ftype, chunk_size);
+                                               ftype, chunk_size, filter);
 	  throw_assert(MPI_Barrier(comm) == MPI_SUCCESS, "error in MPI_Barrier");
         }
 
@@ -349,7 +379,8 @@ namespace neuroh5
                                     const string &dst_pop_name,
                                     const map <string, data::NamedAttrVal>& edge_attr_map,
                                     const std::map <std::string, std::pair <size_t, data::AttrIndex > >& edge_attr_index,
-				    const size_t chunk_size = 4000)
+				    const size_t chunk_size = 4000,
+                                    const DatasetFilter& filter = hdf5::default_filter_config().value)
 
     {
       for (auto const& iter : edge_attr_map)
@@ -369,7 +400,7 @@ namespace neuroh5
                   graph::append_edge_attribute<T>(comm, file, src_pop_name, dst_pop_name,
                                                   attr_namespace, attr_name,
                                                   edge_attr_values.const_attr_vec<T>(i),
-						  chunk_size);
+						  chunk_size, true, filter);
                 }
             }
           else
@@ -11,12 +11,14 @@
 #include <mpi.h>
 
 #include "neuroh5_types.hh"
+#include "rank_map.hh"
 #include "infer_datatype.hh"
 #include "infer_mpi_datatype.hh"
 #include "path_names.hh"
 #include "hdf5_node_attributes.hh"
 #include "exists_dataset.hh"
 #include "attr_map.hh"
+#include "file_access.hh"
 #include "throw_assert.hh"
 
 namespace neuroh5
@@ -50,7 +52,7 @@ namespace neuroh5
      const int                     io_size,
      const string                 &attr_name_space,
      // A vector that maps nodes to compute ranks
-     const node_rank_map_t &node_rank_map,
+     const data::NodeRankMap &node_rank_map,
      data::NamedAttrMap                 &attr_map,
      // if positive, these arguments specify offset and number of entries to read
      // from the entries available to the current rank
@@ -84,7 +86,7 @@ namespace neuroh5
       throw_assert(MPI_Comm_rank(comm, &rank) == MPI_SUCCESS, "error in MPI_Comm_rank");
 
       hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
-      throw_assert(H5Pset_fapl_mpio(fapl, comm, MPI_INFO_NULL) >= 0, "error in H5Pset_fapl_mpio");
+      throw_assert(hdf5::set_parallel_file_access(fapl, comm) >= 0, "error in H5Pset_fapl_mpio");
       
       /* Cache parameters: */
       int nelemts;    /* Dummy parameter in API, no longer used */ 
@@ -388,7 +390,7 @@ namespace neuroh5
     
       // get a file handle and retrieve the MPI info
       hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
-      throw_assert(H5Pset_fapl_mpio(fapl, comm, MPI_INFO_NULL) >= 0, "error in H5Pset_fapl_mpio");
+      throw_assert(hdf5::set_parallel_file_access(fapl, comm) >= 0, "error in H5Pset_fapl_mpio");
       
       /* Cache parameters: */
       int nelemts;    /* Dummy parameter in API, no longer used */ 
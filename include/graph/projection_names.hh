@@ -16,6 +16,8 @@
 #include <string>
 #include <vector>
 
+#include "neuroh5_file.hh"
+
 namespace neuroh5
 {
   namespace graph
@@ -36,6 +38,14 @@ namespace neuroh5
      std::vector< std::pair<std::string,std::string> >& proj_names
      );
 
+    /// @brief Reads the names of projections through a file session; the
+    ///        result is cached in the session.
+    extern herr_t read_projection_names
+    (
+     File&                     file,
+     std::vector< std::pair<std::string,std::string> >& proj_names
+     );
+
   }
 }
 
@@ -47,6 +47,12 @@ namespace neuroh5
     /// @param total_prj_num_edges  Updated with the total number of edges in
     ///                             the graph
     ///
+    /// @param ptr_read_mode  Whether the DBS pointer datasets are read by
+    ///                       rank 0 or collectively by all ranks
+    ///
+    /// @param block_assignment  Divide destination blocks among ranks
+    ///                          evenly or by the volume of edge data
+    ///
     /// @return              HDF5 error code
 
     extern int read_graph
@@ -59,7 +65,9 @@ namespace neuroh5
      vector < map <string, vector < vector<string> > > > & edge_attr_names_vector,
      size_t&                          total_num_nodes,
      size_t&                          local_prj_num_edges,
-     size_t&                          total_prj_num_edges
+     size_t&                          total_prj_num_edges,
+     ProjectionPtrReadMode            ptr_read_mode = PtrReadRoot,
+     ProjectionBlockAssignment        block_assignment = BlockAssignEven
      );
   }
 }
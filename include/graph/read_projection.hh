@@ -58,6 +58,13 @@ namespace neuroh5
     ///
     /// @param src_idx       Source Index (source indices of edges)
     ///
+    /// @param ptr_read_mode Whether the pointer datasets are read by rank 0
+    ///                      or collectively by all ranks
+    ///
+    /// @param block_assignment  Whether destination blocks are divided
+    ///                      evenly among ranks or by edge and edge attribute
+    ///                      data volume
+    ///
     /// @return              HDF5 error code
     extern herr_t read_projection
     (
@@ -79,7 +86,36 @@ namespace neuroh5
      hsize_t&                        total_read_blocks,
      size_t                          offset = 0,
      size_t                          numitems = 0,
-     bool collective = true
+     bool collective = true,
+     ProjectionPtrReadMode           ptr_read_mode = PtrReadRoot,
+     ProjectionBlockAssignment       block_assignment = BlockAssignEven
+     );
+
+    /// @brief Variant of read_projection that returns each projection as
+    ///        a CSR edge container keyed by destination.
+    extern herr_t read_projection
+    (
+     MPI_Comm                        comm,
+     const std::string&              file_name,
+     const pop_search_range_map_t&          pop_search_ranges,
+     const std::set< std::pair<pop_t, pop_t> >& pop_pairs,
+     const std::string&              src_pop_name,
+     const std::string&              dst_pop_name,
+     const NODE_IDX_T&               src_start,
+     const NODE_IDX_T&               dst_start,
+     const vector<string>&           edge_attr_name_spaces,
+     std::vector<edge_csr_t>&        prj_vector,
+     vector < map <string, vector < vector<string> > > > & edge_attr_names_vector,
+     size_t&                         local_num_nodes,
+     size_t&                         local_num_edges,
+     size_t&                         total_num_edges,
+     hsize_t&                        local_read_blocks,
+     hsize_t&                        total_read_blocks,
+     size_t                          offset = 0,
+     size_t                          numitems = 0,
+     bool collective = true,
+     ProjectionPtrReadMode           ptr_read_mode = PtrReadRoot,
+     ProjectionBlockAssignment       block_assignment = BlockAssignEven
      );
   }
 }
@@ -13,6 +13,7 @@
 #define SCATTER_READ_GRAPH_HH
 
 #include "neuroh5_types.hh"
+#include "rank_map.hh"
 #include "read_graph.hh"
 
 #include <mpi.h>
@@ -49,6 +50,17 @@ namespace neuroh5
     /// @param total_num_nodes  Updated with the total number of nodes
     ///                         (vertices) in the graph
     ///
+    /// @param ptr_read_mode  Whether the DBS pointer datasets are read by
+    ///                       rank 0 or collectively by the I/O ranks
+    ///
+    /// @param block_assignment  Divide destination blocks among I/O ranks
+    ///                          evenly or by the volume of edge data
+    ///
+    /// @param pipeline_depth  Maximum number of projection exchanges left
+    ///                        in flight while the I/O ranks read the next
+    ///                        projection; 0 reads and exchanges each
+    ///                        projection in turn
+    ///
     /// @return              HDF5 error code
     int scatter_read_graph
     (
@@ -59,11 +71,14 @@ namespace neuroh5
      const std::vector< std::string >&  attr_namespaces,
      const std::vector< std::pair<std::string,std::string> >&    prj_names,
      // A vector that maps nodes to compute ranks
-     const node_rank_map_t&  node_rank_map,
+     const data::NodeRankMap& node_rank_map,
      std::vector < edge_map_t >& prj_vector,
      vector < map <string, vector < vector<string> > > > & edge_attr_names_vector,
      size_t &local_num_nodes, size_t &total_num_nodes,
-     size_t &local_num_edges, size_t &total_num_edges
+     size_t &local_num_edges, size_t &total_num_edges,
+     ProjectionPtrReadMode ptr_read_mode = PtrReadRoot,
+     ProjectionBlockAssignment block_assignment = BlockAssignEven,
+     size_t pipeline_depth = 0
      );
   }
 }
@@ -13,6 +13,7 @@
 #define SCATTER_READ_PROJECTION_HH
 
 #include "neuroh5_types.hh"
+#include "rank_map.hh"
 
 #include <mpi.h>
 
@@ -33,14 +34,64 @@ namespace neuroh5
                                  const NODE_IDX_T& src_start,
                                  const NODE_IDX_T& dst_start,
                                  const std::vector< std::string >&  attr_namespaces,
-                                 const node_rank_map_t&  node_rank_map,
+                                 const data::NodeRankMap& node_rank_map,
                                  const pop_search_range_map_t& pop_search_ranges,
                                  const std::set< std::pair<pop_t, pop_t> >& pop_pairs,
                                  std::vector < edge_map_t >& prj_vector,
                                  std::vector < map <string, std::vector < std::vector<string> > > > & edge_attr_names_vector,
                                  size_t &local_num_nodes, size_t &local_num_edges, size_t &total_num_edges,
                                  hsize_t &total_read_blocks,
-                                 size_t offset = 0, size_t numitems = 0);
+                                 size_t offset = 0, size_t numitems = 0,
+                                 ProjectionPtrReadMode ptr_read_mode = PtrReadRoot,
+                                 ProjectionBlockAssignment block_assignment = BlockAssignEven);
+
+    /// @brief Variant of scatter_read_projection that returns each
+    ///        projection as a CSR edge container, keyed by destination or
+    ///        source according to edge_map_type.
+    int scatter_read_projection (MPI_Comm all_comm,
+                                 const int io_size,
+                                 const EdgeMapType edge_map_type, 
+                                 const string& file_name,
+                                 const string& src_pop_name,
+                                 const string& dst_pop_name,
+                                 const NODE_IDX_T& src_start,
+                                 const NODE_IDX_T& dst_start,
+                                 const std::vector< std::string >&  attr_namespaces,
+                                 const data::NodeRankMap& node_rank_map,
+                                 const pop_search_range_map_t& pop_search_ranges,
+                                 const std::set< std::pair<pop_t, pop_t> >& pop_pairs,
+                                 std::vector < edge_csr_t >& prj_vector,
+                                 std::vector < map <string, std::vector < std::vector<string> > > > & edge_attr_names_vector,
+                                 size_t &local_num_nodes, size_t &local_num_edges, size_t &total_num_edges,
+                                 hsize_t &total_read_blocks,
+                                 size_t offset = 0, size_t numitems = 0,
+                                 ProjectionPtrReadMode ptr_read_mode = PtrReadRoot,
+                                 ProjectionBlockAssignment block_assignment = BlockAssignEven);
+
+    /// @brief Reads and scatters the given projections in order. The I/O
+    ///        ranks read and pack each projection while the exchanges of
+    ///        up to max_in_flight preceding projections are in flight;
+    ///        the received projections are appended to prj_vector in the
+    ///        same order as by successive calls to scatter_read_projection.
+    ///
+    /// @param prj_starts  Start indices of the source and destination
+    ///                    populations of each projection
+    int scatter_read_projections (MPI_Comm all_comm,
+                                  const int io_size,
+                                  const EdgeMapType edge_map_type, 
+                                  const string& file_name,
+                                  const std::vector< std::pair<std::string, std::string> >& prj_names,
+                                  const std::vector< std::pair<NODE_IDX_T, NODE_IDX_T> >& prj_starts,
+                                  const std::vector< std::string >&  attr_namespaces,
+                                  const data::NodeRankMap& node_rank_map,
+                                  const pop_search_range_map_t& pop_search_ranges,
+                                  const std::set< std::pair<pop_t, pop_t> >& pop_pairs,
+                                  std::vector < edge_map_t >& prj_vector,
+                                  std::vector < map <string, std::vector < std::vector<string> > > > & edge_attr_names_vector,
+                                  size_t &local_num_nodes, size_t &local_num_edges, size_t &total_num_edges,
+                                  const size_t max_in_flight = 1,
+                                  ProjectionPtrReadMode ptr_read_mode = PtrReadRoot,
+                                  ProjectionBlockAssignment block_assignment = BlockAssignEven);
   }
 }
 
@@ -0,0 +1,48 @@
+// -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+//==============================================================================
+///  @file stitch_graph.hh
+///
+///  Merges projections written in subfile mode into the output file.
+///
+///  Copyright (C) 2016-2025 Project NeuroH5.
+//==============================================================================
+
+#ifndef STITCH_GRAPH_HH
+#define STITCH_GRAPH_HH
+
+#include "neuroh5_types.hh"
+#include "dataset_filters.hh"
+
+#include <mpi.h>
+
+#include <string>
+
+namespace neuroh5
+{
+  namespace graph
+  {
+
+    /// @brief Appends the projections found in the subfiles of the given
+    ///        output file to the output file. The subfiles are assigned to
+    ///        the ranks of comm in round-robin order, and each round of
+    ///        subfiles is appended with one collective call to
+    ///        append_graph. The subfiles are not removed.
+    ///
+    /// @param comm          MPI communicator
+    ///
+    /// @param file_name     Output file name; it must contain the
+    ///                      population definitions used by the subfiles
+    ///
+    /// @return              HDF5 error code
+    int stitch_graph_subfiles
+    (
+     MPI_Comm            comm,
+     const std::string&  file_name,
+     const hsize_t       chunk_size = 4096,
+     const FilterConfig& filters = hdf5::default_filter_config()
+     );
+
+  }
+}
+
+#endif
@@ -13,6 +13,7 @@
 
 #include "neuroh5_types.hh"
 #include "attr_map.hh"
+#include "dataset_filters.hh"
 
 #include <mpi.h>
 #include <vector>
@@ -31,7 +32,9 @@ namespace neuroh5
      const std::string&    dst_pop_name,
      const std::map <std::string, std::pair <size_t, data::AttrIndex > >& edge_attr_index,
      const edge_map_t&  input_edge_map,
-     const hsize_t      chunk_size = 4096
+     const hsize_t      chunk_size = 4096,
+     const bool         build_index = false,
+     const FilterConfig& filters = hdf5::default_filter_config()
      );
 
   }
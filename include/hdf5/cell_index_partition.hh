@@ -0,0 +1,55 @@
+#ifndef CELL_INDEX_PARTITION_HH
+#define CELL_INDEX_PARTITION_HH
+
+#include <hdf5.h>
+#include <mpi.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "neuroh5_types.hh"
+
+namespace neuroh5
+{
+  namespace hdf5
+  {
+    /// @brief Reads the cell index and attribute pointer of the cell
+    ///        attribute at path and partitions them by cell id over the
+    ///        ranks of comm. Each rank reads a contiguous block of both
+    ///        datasets, and the entries are exchanged with their owner
+    ///        ranks, which sort them once. Collective on comm; the file
+    ///        must be open on all ranks of comm.
+    ///
+    /// @param pop_start   Offset added to the cell ids of the index
+    ///
+    /// @return            HDF5 error code
+    herr_t read_cell_index_partition
+    (
+     MPI_Comm                        comm,
+     const hid_t&                    loc,
+     const std::string&              path,
+     const CELL_IDX_T                pop_start,
+     CellIndexPartition&             partition
+     );
+
+    /// @brief Looks up the value ranges of the selected cells in a
+    ///        partitioned index: the selected ids are sent to their
+    ///        owner ranks, which return the ranges of the matching
+    ///        entries. The result replaces the contents of
+    ///        selection_index and ranges and is ordered by the start of
+    ///        the ranges. Selected ids below pop_start are ignored. Collective on the
+    ///        communicator used to build the partition.
+    void query_cell_index_partition
+    (
+     MPI_Comm                                   comm,
+     const CellIndexPartition&                  partition,
+     const CELL_IDX_T                           pop_start,
+     const std::vector<CELL_IDX_T>&             selection,
+     std::vector<CELL_IDX_T>&                   selection_index,
+     std::vector< std::pair<hsize_t,hsize_t> >& ranges
+     );
+  }
+}
+
+#endif
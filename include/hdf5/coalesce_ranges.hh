@@ -0,0 +1,43 @@
+// -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+//==============================================================================
+///  @file coalesce_ranges.hh
+///
+///  Merging of the ranges of a dataset selection into contiguous spans.
+///
+///  Copyright (C) 2016-2025 Project NeuroH5.
+//==============================================================================
+#ifndef COALESCE_RANGES_HH
+#define COALESCE_RANGES_HH
+
+#include <hdf5.h>
+
+#include <utility>
+#include <vector>
+
+namespace neuroh5
+{
+  namespace hdf5
+  {
+    /// @brief Merges (start, count) ranges of a dataset into spans, joining
+    ///        ranges that overlap or are separated by at most max_gap
+    ///        elements.
+    ///
+    /// @param ranges      Ranges in any order; empty ranges are ignored
+    ///
+    /// @param spans       Filled with the merged spans in ascending order
+    ///
+    /// @param offsets     Filled with the position of the first element of
+    ///                    each range in the concatenated spans
+    ///
+    /// @return            Total number of elements in the spans
+    hsize_t coalesce_ranges
+    (
+     const std::vector< std::pair<hsize_t,hsize_t> >& ranges,
+     const hsize_t                                    max_gap,
+     std::vector< std::pair<hsize_t,hsize_t> >&       spans,
+     std::vector<hsize_t>&                            offsets
+     );
+  }
+}
+
+#endif
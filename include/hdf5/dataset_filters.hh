@@ -0,0 +1,82 @@
+// -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+//==============================================================================
+///  @file dataset_filters.hh
+///
+///  Filter pipelines for chunked NeuroH5 datasets.
+///
+///  Copyright (C) 2016-2025 Project NeuroH5.
+//==============================================================================
+#ifndef DATASET_FILTERS_HH
+#define DATASET_FILTERS_HH
+
+#include <hdf5.h>
+
+#include <cstdint>
+#include <string>
+
+#include "neuroh5_types.hh"
+
+namespace neuroh5
+{
+  namespace hdf5
+  {
+
+    /// Identifier of the NeuroH5 delta filter. It lies in the range
+    /// 256-511 that HDF5 sets aside for testing and is not assigned to
+    /// any registered filter (305 and 307, in the same range, are the
+    /// LZO and BZIP2 filters).
+    const H5Z_filter_t H5Z_FILTER_NEUROH5_DELTA = 434;
+
+    /// Registers the NeuroH5 filters with the HDF5 library. Called by
+    /// open_file, the read templates and set_dataset_filters, so that
+    /// filtered datasets are decoded transparently; may be called any
+    /// number of times. Throws if another filter, e.g. a plugin, is
+    /// registered with the identifier of a NeuroH5 filter.
+    herr_t register_filters ();
+
+    /// Encodes n elements of the given size with the delta filter codec
+    /// into out, which must hold delta_max_encoded_size(n) bytes, and
+    /// returns the encoded size.
+    size_t delta_max_encoded_size (size_t n);
+    size_t delta_encode (size_t size, bool is_signed, bool big_endian,
+                         const uint8_t *in, size_t n, uint8_t *out);
+
+    /// Reads the number of elements of an encoded chunk of nbytes
+    /// bytes, and decodes the chunk into out, which must hold that many
+    /// elements of the given size. Both return false if the chunk is
+    /// malformed.
+    bool delta_decoded_count (const uint8_t *in, size_t nbytes, uint64_t& n);
+    bool delta_decode (size_t size, bool big_endian,
+                       const uint8_t *in, size_t nbytes, uint8_t *out);
+
+    /// Filters used when the caller does not provide a configuration:
+    /// shuffle and deflate level 4 if H5_HAS_PARALLEL_DEFLATE is
+    /// defined, no filters otherwise
+    FilterConfig default_filter_config ();
+
+    /// Parses a specification of the form ROLE=FILTER[,FILTER...], where
+    /// ROLE is index, pointer, value or all, and FILTER is none, shuffle,
+    /// delta or deflate:LEVEL, and sets the filters of the given role in
+    /// config. Shuffle and delta are alternative byte reorderings and
+    /// cannot be combined.
+    void parse_filter_spec
+    (
+     const std::string& spec,
+     FilterConfig&      config
+     );
+
+    /// Replaces the filter pipeline of a dataset creation property list
+    /// (which must have a chunked layout) with the given filters. The
+    /// delta filter is added only if ftype is an integer type; shuffle
+    /// and delta cannot both be set.
+    herr_t set_dataset_filters
+    (
+     hid_t                dcpl,
+     const DatasetFilter& filter,
+     hid_t                ftype
+     );
+
+  }
+}
+
+#endif
@@ -3,8 +3,12 @@
 
 #include "hdf5.h"
 
+#include <mpi.h>
+#include <string>
 #include <vector>
 
+#include "neuroh5_types.hh"
+
 namespace neuroh5
 {
   namespace hdf5
@@ -29,6 +33,41 @@ namespace neuroh5
 
     int what_is_open(hid_t fid, int mask=H5F_OBJ_ALL) ;
 
+    /*****************************************************************************
+     * File access configuration. The initial configuration is read from
+     * the environment:
+     *
+     *   NEUROH5_MPI_HINTS       MPI-IO hints as KEY=VALUE[;KEY=VALUE...]
+     *   NEUROH5_COLL_METADATA   0 disables collective metadata operations
+     *                           in the reads that request them
+     *   NEUROH5_ALIGNMENT       ALIGNMENT[:THRESHOLD] in bytes
+     *   NEUROH5_META_BLOCK_SIZE metadata block size in bytes
+     *   NEUROH5_SELECTION_GAP   largest gap in bytes between selected
+     *                           ranges that are read as one span
+     *****************************************************************************/
+
+    const FileAccessConfig& file_access_config ();
+
+    void set_file_access_config (const FileAccessConfig& config);
+
+    /// Sets the alignment and metadata block size of a file access
+    /// property list according to the file access configuration
+    herr_t set_file_access_properties (hid_t fapl);
+
+    /// Selects the MPI-IO driver with the configured hints for the given
+    /// communicator. Collective metadata operations are enabled only if
+    /// coll_metadata is true and they are not disabled in the
+    /// configuration. Collective metadata reads require all ranks of comm
+    /// to open the same objects in the same order, so callers pass true
+    /// only where no metadata access is made by a subset of the ranks
+    /// (e.g. an existence check on rank 0).
+    herr_t set_parallel_file_access
+    (
+     hid_t    fapl,
+     MPI_Comm comm,
+     const bool coll_metadata = false
+     );
+
     
   }
 }
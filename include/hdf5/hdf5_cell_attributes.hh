@@ -56,6 +56,27 @@ namespace neuroh5
      );
 
 
+    /// @brief Determines the cells and the contiguous block of attribute
+    ///        values read by this rank when the first numitems cells
+    ///        starting at offset (or all cells if numitems is 0) are
+    ///        distributed over the ranks of comm.
+    ///
+    /// @return            false if there are no cells to read on any rank
+    bool cell_attribute_block
+    (
+     MPI_Comm                        comm,
+     const hid_t&                    loc,
+     const std::string&              path,
+     const std::vector<CELL_IDX_T>&  index,
+     const std::vector<ATTR_PTR_T>&  ptr,
+     std::vector<CELL_IDX_T>&        value_index,
+     std::vector<ATTR_PTR_T>&        value_ptr,
+     hsize_t&                        value_start,
+     hsize_t&                        value_block,
+     size_t offset = 0,
+     size_t numitems = 0
+     );
+
     
     template <typename T>
     herr_t read_cell_attribute
@@ -85,30 +106,10 @@ namespace neuroh5
 	  throw_assert(status > 0, "group " << path << " does not exist");
 	}
       
-      hsize_t dset_size = index.size();
-      size_t read_size = 0;
-      if (numitems > 0) 
-        {
-          if (offset < dset_size)
-            {
-              read_size = min((hsize_t)numitems, dset_size-offset);
-            }
-        }
-      else
-        {
-          read_size = dset_size;
-        }
-      
-      if (read_size > 0)
+      hsize_t value_start = 0, value_block = 0;
+      if (cell_attribute_block(comm, loc, path, index, ptr, value_index, value_ptr,
+                               value_start, value_block, offset, numitems))
         {
-          // determine which blocks of block_ptr are read by which rank
-          vector< pair<hsize_t,hsize_t> > ranges;
-          mpi::rank_ranges(read_size, size, ranges);
-        
-          hsize_t start = ranges[rank].first + offset;
-          hsize_t end   = start + ranges[rank].second;
-          hsize_t block = end - start;
-    
           /* Create property list for collective dataset operations. */
           hid_t rapl = H5Pcreate (H5P_DATASET_XFER);
           
@@ -118,28 +119,6 @@ namespace neuroh5
           
           string value_path = path + "/" + ATTR_VAL;
 
-          hsize_t value_start, value_block;
-          if (ptr.size() > 0)
-            {
-              value_start = ptr[start];
-              value_block = ptr[end]-value_start;
-              value_ptr.resize(block+1, 0);
-              for (size_t i=start, j=0; i<end+1; i++, j++)
-                {
-                  value_ptr[j] = ptr[i] - value_start;
-                }
-            }
-          else
-            {
-              value_start = 0;
-              value_block = block > 0 ? dataset_num_elements (loc, value_path) : 0;
-            }
-          value_index.resize(block, 0);
-          for (size_t i=start, j=0; i<end; i++, j++)
-            {
-              value_index[j] = index[i];
-            }
-
           // read values
           hid_t dset = H5Dopen(loc, value_path.c_str(), H5P_DEFAULT);
           throw_assert(dset >= 0, "error in H5Dopen");
@@ -163,103 +142,56 @@ namespace neuroh5
     }
 
     
+    /// @brief Reads the values of a cell attribute in the given
+    ///        (start, count) ranges, as obtained from
+    ///        query_cell_index_partition. selection_ptr receives the
+    ///        offset of the values of each range in values.
     template <typename T>
     herr_t read_cell_attribute_selection
     (
      MPI_Comm                  comm,
      const hid_t&              loc,
      const std::string&        path,
-     const CELL_IDX_T          pop_start,
-     const std::vector<CELL_IDX_T>&  selection,
-     const std::vector<CELL_IDX_T>&  index,
-     const std::vector<ATTR_PTR_T>&  ptr,
-     std::vector<CELL_IDX_T> & selection_index,
+     const std::vector< std::pair<hsize_t,hsize_t> >& ranges,
      std::vector<ATTR_PTR_T> & selection_ptr,
      std::vector<T> &          values
      )
     {
       herr_t status = 0;
 
-      int size, rank;
-      throw_assert(MPI_Comm_size(comm, &size) == MPI_SUCCESS, "error in MPI_Comm_size");
-      throw_assert(MPI_Comm_rank(comm, &rank) == MPI_SUCCESS, "error in MPI_Comm_size");
-
       status = exists_group (loc, path.c_str());
       throw_assert(status > 0, "group " << path << " does not exist");
       
-      hsize_t dset_size = index.size();
-      vector< pair<hsize_t,hsize_t> > ranges;
+      string value_path = path + "/" + ATTR_VAL;
 
-      auto compare_idx = [](const CELL_IDX_T& a, const CELL_IDX_T& b) { return (a < b); };
-      
-      if (dset_size > 0)
+      ATTR_PTR_T selection_ptr_pos = 0;
+      for (const auto& range: ranges)
         {
+          selection_ptr.push_back(selection_ptr_pos);
+          selection_ptr_pos += range.second;
+        }
+      selection_ptr.push_back(selection_ptr_pos);
 
-          string value_path = path + "/" + ATTR_VAL;
-
-          ATTR_PTR_T selection_ptr_pos = 0;
-          if (ptr.size() > 0)
-            {
-	      vector<size_t> p = data::sort_permutation(index, compare_idx);
-	      std::vector<CELL_IDX_T> sorted_index = data::apply_permutation(index, p);
-
-              for (const CELL_IDX_T& s : selection) 
-                {
-                  if (s < pop_start) continue;
-		  auto rp = std::equal_range(sorted_index.begin(), sorted_index.end(), s);
-		  for ( auto it = rp.first; it != rp.second; ++it )
-                    {
-                      ptrdiff_t spos = it - sorted_index.begin();
-		      ptrdiff_t pos = p[spos];
-                      hsize_t value_start=ptr[pos];
-                      hsize_t value_block=ptr[pos+1]-value_start;
-
-                      ranges.push_back(make_pair(value_start, value_block));
-                      selection_index.push_back(s);
-                    }
-                }
-          
-
-	      auto compare_range_idx = [](const std::pair<hsize_t, hsize_t>& a, const std::pair<hsize_t, hsize_t>& b) 
-		{ return (a.first < b.first); };
-	  
-	      vector<size_t> range_sort_p = data::sort_permutation(ranges, compare_range_idx);
-	      
-	      data::apply_permutation_in_place(selection_index, range_sort_p);
-	      data::apply_permutation_in_place(ranges, range_sort_p);
-
-	      for (const auto& range: ranges)
-		{
-		  hsize_t value_start=range.first;
-		  hsize_t value_block=range.second;
-
-		  selection_ptr.push_back(selection_ptr_pos);
-		  selection_ptr_pos += value_block;
-		}
-	      selection_ptr.push_back(selection_ptr_pos);
-            }
-
-          hid_t dset = H5Dopen(loc, value_path.c_str(), H5P_DEFAULT);
-          throw_assert(dset >= 0, "error in H5Dopen");
-          hid_t ftype = H5Dget_type(dset);
-          throw_assert(ftype >= 0, "error in H5Dget_type");
-          hid_t ntype = H5Tget_native_type(ftype, H5T_DIR_ASCEND);
-          throw_assert(H5Tclose(ftype)  >= 0, "error in H5Tclose");
-          throw_assert(H5Dclose(dset)   >= 0, "error in H5Dclose");
+      hid_t dset = H5Dopen(loc, value_path.c_str(), H5P_DEFAULT);
+      throw_assert(dset >= 0, "error in H5Dopen");
+      hid_t ftype = H5Dget_type(dset);
+      throw_assert(ftype >= 0, "error in H5Dget_type");
+      hid_t ntype = H5Tget_native_type(ftype, H5T_DIR_ASCEND);
+      throw_assert(H5Tclose(ftype)  >= 0, "error in H5Tclose");
+      throw_assert(H5Dclose(dset)   >= 0, "error in H5Dclose");
 
-          /* Create property list for collective dataset operations. */
-          hid_t rapl = H5Pcreate (H5P_DATASET_XFER);
+      /* Create property list for collective dataset operations. */
+      hid_t rapl = H5Pcreate (H5P_DATASET_XFER);
 
-          status = H5Pset_dxpl_mpio (rapl, H5FD_MPIO_COLLECTIVE);
-          throw_assert(status >= 0,
-                       "read_cell_attribute_selection: error in H5Pset_dxpl_mpio");
+      status = H5Pset_dxpl_mpio (rapl, H5FD_MPIO_COLLECTIVE);
+      throw_assert(status >= 0,
+                   "read_cell_attribute_selection: error in H5Pset_dxpl_mpio");
               
-          values.resize(selection_ptr_pos, 0);
+      values.resize(selection_ptr_pos, 0);
 
-          status = read_selection<T> (loc, value_path, ntype, ranges, values, rapl);
-          throw_assert(H5Pclose(rapl)   >= 0, "error in H5Pclose");
-          throw_assert(H5Tclose(ntype)  >= 0, "error in H5Tclose");
-        }
+      status = read_selection<T> (loc, value_path, ntype, ranges, values, rapl);
+      throw_assert(H5Pclose(rapl)   >= 0, "error in H5Pclose");
+      throw_assert(H5Tclose(ntype)  >= 0, "error in H5Tclose");
 
       return status;
     }
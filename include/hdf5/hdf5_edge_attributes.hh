@@ -13,6 +13,7 @@
 #include "read_template.hh"
 #include "write_template.hh"
 #include "file_access.hh"
+#include "dataset_filters.hh"
 #include "throw_assert.hh"
 #include "mpe_seq.hh"
 #include "debug.hh"
@@ -50,7 +51,8 @@ namespace neuroh5
      const string&  attr_namespace,
      const string&  attr_name,
      const hid_t&   ftype,
-     const size_t   chunk_size
+     const size_t   chunk_size,
+     const DatasetFilter& filter = default_filter_config().value
      );
 
     
@@ -0,0 +1,100 @@
+// -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+//==============================================================================
+///  @file neuroh5_file.hh
+///
+///  Session handle that keeps a NeuroH5 file open and caches its
+///  metadata.
+///
+///  Copyright (C) 2016-2025 Project NeuroH5.
+//==============================================================================
+#ifndef NEUROH5_FILE_HH
+#define NEUROH5_FILE_HH
+
+#include <mpi.h>
+#include <hdf5.h>
+
+#include <map>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "neuroh5_types.hh"
+
+namespace neuroh5
+{
+
+  /// @brief Session handle for a NeuroH5 file. The file stays open on
+  ///        rank 0 of the communicator (or on all ranks if opened
+  ///        collectively) until the handle is closed or destroyed.
+  ///
+  ///        The metadata read functions that take a File argument
+  ///        (population ranges, labels and combinations, population and
+  ///        projection names, cell and edge attribute information) read
+  ///        from the open file on rank 0 and broadcast the result the
+  ///        first time they are called, and return the cached result
+  ///        afterwards. The first call is therefore collective on the
+  ///        communicator of the handle, and later calls are local.
+  class File
+  {
+  public:
+
+    /// Metadata cached by the read functions; a field is valid only if
+    /// its has_ flag is set
+    struct Metadata
+    {
+      bool has_pop_ranges = false, has_pop_labels = false, has_pop_pairs = false,
+        has_pop_names = false, has_prj_names = false;
+      pop_range_map_t pop_ranges;
+      size_t total_num_nodes = 0;
+      pop_label_map_t pop_labels;
+      std::set< std::pair<pop_t, pop_t> > pop_pairs;
+      std::vector<std::string> pop_names;
+      std::vector< std::pair<std::string, std::string> > prj_names;
+      // keyed by (name space, population)
+      std::map< std::pair<std::string, std::string>,
+                std::vector< std::pair<std::string, AttrKind> > > cell_attributes;
+      // keyed by (source population, destination population, name space)
+      std::map< std::tuple<std::string, std::string, std::string>,
+                std::vector< std::pair<std::string, AttrKind> > > edge_attributes;
+      // keyed by (name space, population); used by the cell attribute
+      // selection reads, which partition the cell indexes over the ranks
+      // of the communicator of the handle
+      std::map< std::pair<std::string, std::string>, CellIndexService > cell_index_services;
+    };
+
+    /// Opens file_name read-only; the communicator is duplicated
+    File (MPI_Comm comm, const std::string& file_name, bool collective = false);
+    ~File ();
+
+    File (const File&) = delete;
+    File& operator= (const File&) = delete;
+
+    MPI_Comm comm () const { return m_comm; }
+    const std::string& file_name () const { return m_file_name; }
+    bool collective () const { return m_collective; }
+    bool is_open () const { return m_open; }
+
+    /// HDF5 file identifier. Valid on rank 0, and on all ranks if the file
+    /// was opened collectively; negative elsewhere.
+    hid_t id () const { return m_file; }
+
+    /// Closes the file and frees the communicator; collective
+    void close ();
+
+    /// Discards the cached metadata, e.g. after the file has been
+    /// modified through another handle
+    void invalidate () { metadata = Metadata(); }
+
+    Metadata metadata;
+
+  private:
+    MPI_Comm m_comm = MPI_COMM_NULL;
+    std::string m_file_name;
+    hid_t m_file = -1;
+    bool m_collective = false, m_open = false;
+  };
+
+}
+
+#endif
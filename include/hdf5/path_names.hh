@@ -27,6 +27,21 @@ namespace neuroh5
     const std::string DSTSEC     = "Destination Section";
     const std::string PARENT     = "Parent Point";
     const std::string SWCTYPE    = "SWC Type";
+
+    // Point attributes of trees stored with TreeQuantized encoding; the
+    // origin of each tree holds the coordinates of its first point and
+    // the quantization step
+    const std::string QUANT_ORIGIN   = "Quantization Origin";
+    const std::string X_OFFSET       = "X Offset";
+    const std::string Y_OFFSET       = "Y Offset";
+    const std::string Z_OFFSET       = "Z Offset";
+    const std::string RADIUS_QUANT   = "Quantized Radius";
+    const std::string PARENT_DELTA   = "Parent Point Delta";
+    const std::string LAYER_RUNS     = "Point Layer Runs";
+    const std::string LAYER_RUN_LEN  = "Point Layer Run Length";
+    const std::string SWCTYPE_RUNS   = "SWC Type Runs";
+    const std::string SWCTYPE_RUN_LEN = "SWC Type Run Length";
+
     const std::string CELL_INDEX = "Cell Index";
     const std::string NODE_INDEX = "Node Index";
 
@@ -40,6 +55,16 @@ namespace neuroh5
     const std::string DST_PTR     = "Destination Pointer";
     const std::string SRC_IDX     = "Source Index";
 
+    // Optional destination lookup index: one row per destination
+    // block, sorted by the first destination index of the block
+    const std::string DST_LOOKUP_IDX = "Destination Lookup Index";
+    const std::string DST_LOOKUP_CNT = "Destination Lookup Count";
+    const std::string DST_LOOKUP_BLK = "Destination Lookup Block";
+    const std::string DST_LOOKUP_PTR = "Destination Lookup Pointer";
+    // Number of edges and of destination pointers of the projection
+    // when the lookup index was written
+    const std::string DST_LOOKUP_EXT = "Destination Lookup Extent";
+
     std::string h5types_path_join(const std::string& name);
 
     /// @brief Returns the path to a population group
@@ -0,0 +1,94 @@
+// -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+//==============================================================================
+///  @file projection_index.hh
+///
+///  Functions for building and querying the destination lookup index of
+///  projections in DBS (Destination Block Sparse) format.
+///
+///  Copyright (C) 2016-2021 Project NeuroH5.
+//==============================================================================
+
+#ifndef PROJECTION_INDEX_HH
+#define PROJECTION_INDEX_HH
+
+#include "neuroh5_types.hh"
+
+#include <mpi.h>
+#include <hdf5.h>
+
+#include <string>
+#include <vector>
+#include <utility>
+
+namespace neuroh5
+{
+  namespace hdf5
+  {
+
+    /// @brief Builds (or rebuilds) the destination lookup index of a
+    ///        projection. The index has one row per destination block,
+    ///        sorted by the first destination index of the block, with the
+    ///        number of destinations in the block, the block number and
+    ///        the position of its first destination in the Destination
+    ///        Pointer dataset. The number of edges and of destination
+    ///        pointers is stored with the index; appending to or
+    ///        rewriting the projection leaves the index stale, and stale
+    ///        indices are ignored by readers.
+    ///
+    /// @param comm          MPI communicator
+    ///
+    /// @param file_name     Input/output file name
+    ///
+    /// @param src_pop_name  Source population name
+    ///
+    /// @param dst_pop_name  Destination population name
+    ///
+    /// @return              HDF5 error code
+    herr_t write_projection_index
+    (
+     MPI_Comm                   comm,
+     const std::string&         file_name,
+     const std::string&         src_pop_name,
+     const std::string&         dst_pop_name
+     );
+
+    /// @brief Returns true if the projection has a destination lookup
+    ///        index that matches its current number of blocks, edges and
+    ///        destination pointers.
+    bool has_projection_index
+    (
+     hid_t                      file,
+     const std::string&         src_pop_name,
+     const std::string&         dst_pop_name
+     );
+
+    /// @brief Finds the Destination Pointer positions of the given
+    ///        destination indices (relative to the destination population
+    ///        start) with the destination lookup index of a projection.
+    ///        All destinations are binary searched together, with one
+    ///        point read of the index per search step, so that
+    ///        O(log(number of blocks)) reads are made. Must be called by
+    ///        all ranks if rapl is collective.
+    ///
+    /// @param dst_indices   Destination indices to look up
+    ///
+    /// @param dst_ptr_pos   Updated with pairs of destination index and
+    ///                      Destination Pointer position, sorted by
+    ///                      destination index; destinations that are not
+    ///                      in the projection are omitted
+    ///
+    /// @return              HDF5 error code
+    herr_t lookup_projection_index
+    (
+     hid_t                      file,
+     hid_t                      rapl,
+     const std::string&         src_pop_name,
+     const std::string&         dst_pop_name,
+     const std::vector<NODE_IDX_T>& dst_indices,
+     std::vector< std::pair<NODE_IDX_T, hsize_t> >& dst_ptr_pos
+     );
+
+  }
+}
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef READ_MULTI_HH
+#define READ_MULTI_HH
+
+#include <hdf5.h>
+
+#include <string>
+#include <vector>
+
+namespace neuroh5
+{
+  namespace hdf5
+  {
+    /// @brief Reads one contiguous block of each of several one-dimensional
+    ///        datasets in a single I/O phase. The values are converted to
+    ///        the native type of each dataset. With HDF5 1.14 and later,
+    ///        the blocks are read with one call to H5Dread_multi;
+    ///        otherwise, the datasets are opened and selected up front and
+    ///        read back to back with the same transfer property list.
+    ///
+    /// @param names       Dataset paths relative to loc
+    ///
+    /// @param starts      First element of the block of each dataset
+    ///
+    /// @param blocks      Number of elements of the block of each dataset
+    ///
+    /// @param bufs        Destination buffer of each dataset, large enough
+    ///                    for its block
+    ///
+    /// @param rapl        Dataset transfer property list; when it is
+    ///                    collective, all ranks must pass the same datasets
+    ///                    in the same order
+    ///
+    /// @return            HDF5 error code
+    herr_t read_multi
+    (
+     hid_t                           loc,
+     const std::vector<std::string>& names,
+     const std::vector<hsize_t>&     starts,
+     const std::vector<hsize_t>&     blocks,
+     const std::vector<void*>&       bufs,
+     hid_t                           rapl
+     );
+  }
+}
+
+#endif
@@ -38,7 +38,10 @@ namespace neuroh5
      hsize_t&                   local_read_blocks,
      size_t                     offset = 0,
      size_t                     numitems = 0,
-     bool collective = true
+     bool collective = true,
+     ProjectionPtrReadMode      ptr_read_mode = PtrReadRoot,
+     ProjectionBlockAssignment  block_assignment = BlockAssignEven,
+     size_t                     edge_attr_bytes = 0
      );
 
     herr_t read_projection_node_datasets
@@ -6,8 +6,12 @@
 #include <vector>
 #include <utility>
 #include <cstdio>
+#include <algorithm>
 
 #include "exists_dataset.hh"
+#include "dataset_filters.hh"
+#include "file_access.hh"
+#include "coalesce_ranges.hh"
 #include "throw_assert.hh"
 
 
@@ -30,6 +34,7 @@ namespace neuroh5
     {
       herr_t ierr = 0;
 
+      register_filters();
       ierr = exists_dataset (loc, name.c_str());
       if (ierr > 0)
 	{
@@ -75,6 +80,10 @@ namespace neuroh5
     }
 
     
+    /// Reads the values of the given (start, count) ranges of a dataset,
+    /// concatenated in the order of the ranges. Ranges separated by at
+    /// most the configured selection gap are read as a single span, and
+    /// the requested values are then copied out of the spans.
     template<class T>
     herr_t read_selection
     (
@@ -90,17 +99,40 @@ namespace neuroh5
 
       for (const auto& range : ranges)
         {
-          hsize_t start = range.first;
           hsize_t count = range.second;
           
           len += count;
         }
       herr_t ierr = 0;
 
+      size_t type_size = H5Tget_size(ntype);
+      throw_assert(type_size > 0,
+                   "hdf5::read_selection: error in H5Tget_size");
+      const hsize_t max_gap = file_access_config().selection_gap / type_size;
+
+      vector< pair<hsize_t,hsize_t> > spans;
+      vector<hsize_t> offsets;
+      const hsize_t span_len = coalesce_ranges(ranges, max_gap, spans, offsets);
+
+      // the spans can be read directly into the output when they contain
+      // exactly the requested values in the requested order
+      bool direct = (span_len == len);
+      {
+        hsize_t pos = 0;
+        for (size_t i = 0; direct && (i < ranges.size()); i++)
+          {
+            if (ranges[i].second == 0)
+              continue;
+            direct = (offsets[i] == pos);
+            pos += ranges[i].second;
+          }
+      }
+
+      register_filters();
       ierr = exists_dataset (loc, name.c_str());
       if (ierr > 0)
 	{
-	  hid_t mspace = H5Screate_simple(1, &len, NULL);
+	  hid_t mspace = H5Screate_simple(1, &span_len, NULL);
 	  throw_assert(mspace >= 0,
                        "hdf5::read_selection: error in H5Screate_simple");
 
@@ -113,16 +145,16 @@ namespace neuroh5
 	  throw_assert(fspace >= 0,
                        "hdf5::read_selection: error in H5Dget_space");
 	  
-	  if (len > 0)
+	  if (span_len > 0)
 	    {
-	      bool use_hyperslab = (len > 1000);
+	      bool use_hyperslab = (span_len > 1000);
 	      if (use_hyperslab)
 		{
 		  bool first_iter = true;
-		  for (const auto& range : ranges)
+		  for (const auto& span : spans)
 		    {
-		      hsize_t start = range.first;
-		      hsize_t count = range.second;
+		      hsize_t start = span.first;
+		      hsize_t count = span.second;
 		      
 		      hsize_t one = 1;
 		      ierr = H5Sselect_hyperslab(fspace, first_iter ? H5S_SELECT_SET : H5S_SELECT_OR, &start, NULL, &one, &count);
@@ -135,17 +167,17 @@ namespace neuroh5
 	      else
 		{
 		  vector <hsize_t> coords;
-		  for (const auto& range : ranges)
+		  for (const auto& span : spans)
 		    {
-		      hsize_t start = range.first;
-		      hsize_t count = range.second;
+		      hsize_t start = span.first;
+		      hsize_t count = span.second;
 		      for (hsize_t i = start; i<start+count; ++i)
 			{
 			  coords.push_back(i);
 			}
 		    }
 		  ierr = H5Sselect_elements (fspace, H5S_SELECT_SET,
-					     len, (const hsize_t *)coords.data());
+					     span_len, (const hsize_t *)coords.data());
 		  throw_assert(ierr >= 0,
 			       "hdf5::read_selection: error in H5Sselect_elements");
 		}
@@ -157,10 +189,30 @@ namespace neuroh5
 			   "hdf5::read_selection: error in H5Sselect_none");
 	    }
 
-          v.resize(len);
-	  ierr = H5Dread(dset, ntype, mspace, fspace, rapl, v.data());
-	  throw_assert(ierr >= 0,
-                       "hdf5::read_selection: error in H5Dread");
+          if (direct)
+            {
+              v.resize(len);
+              ierr = H5Dread(dset, ntype, mspace, fspace, rapl, v.data());
+              throw_assert(ierr >= 0,
+                           "hdf5::read_selection: error in H5Dread");
+            }
+          else
+            {
+              vector<T> span_values(span_len);
+              ierr = H5Dread(dset, ntype, mspace, fspace, rapl, span_values.data());
+              throw_assert(ierr >= 0,
+                           "hdf5::read_selection: error in H5Dread");
+              v.resize(len);
+              hsize_t pos = 0;
+              for (size_t i = 0; i < ranges.size(); i++)
+                {
+                  const hsize_t count = ranges[i].second;
+                  std::copy(span_values.begin() + offsets[i],
+                            span_values.begin() + offsets[i] + count,
+                            v.begin() + pos);
+                  pos += count;
+                }
+            }
 	  
 	  throw_assert(H5Sclose(mspace) >= 0,
                        "hdf5::read_selection: error in H5Sclose");
@@ -0,0 +1,62 @@
+// -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+//==============================================================================
+///  @file subfiles.hh
+///
+///  Per-I/O-rank subfiles used by the subfile write mode.
+///
+///  Copyright (C) 2016-2025 Project NeuroH5.
+//==============================================================================
+#ifndef SUBFILES_HH
+#define SUBFILES_HH
+
+#include <hdf5.h>
+#include <mpi.h>
+
+#include <string>
+
+namespace neuroh5
+{
+  namespace hdf5
+  {
+
+    /// @brief Returns the name of subfile index of the given output file
+    std::string subfile_name
+    (
+     const std::string& file_name,
+     const size_t       index
+     );
+
+    /// @brief Opens subfile index of the given output file for writing
+    ///        by the calling rank alone, creating it if necessary. A new
+    ///        subfile receives a copy of the H5Types group of the output
+    ///        file, so that it can be read as a NeuroH5 file.
+    ///
+    /// @return              HDF5 file handle
+    hid_t open_subfile
+    (
+     const std::string& file_name,
+     const size_t       index,
+     const size_t       cache_size = 1*1024*1024
+     );
+
+    /// @brief Determines the number of subfiles of the given output file;
+    ///        rank 0 checks for the subfiles and broadcasts the result.
+    herr_t num_subfiles
+    (
+     MPI_Comm           comm,
+     const std::string& file_name,
+     size_t&            count
+     );
+
+    /// @brief Removes the subfiles of the given output file, once all
+    ///        ranks of comm have reached this call.
+    herr_t remove_subfiles
+    (
+     MPI_Comm           comm,
+     const std::string& file_name
+     );
+
+  }
+}
+
+#endif
@@ -0,0 +1,95 @@
+// -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+//==============================================================================
+///  @file mapped_text.hh
+///
+///  Memory-mapped text input split into line ranges.
+///
+///  Copyright (C) 2016-2025 Project NeuroH5.
+//==============================================================================
+#ifndef MAPPED_TEXT_HH
+#define MAPPED_TEXT_HH
+
+#include <charconv>
+#include <cstring>
+#include <string>
+#include <utility>
+
+namespace neuroh5
+{
+  namespace io
+  {
+
+    // Read-only mapping of a whole text file
+    class MappedTextFile
+    {
+    public:
+      MappedTextFile (const std::string& file_name);
+      ~MappedTextFile ();
+
+      MappedTextFile (const MappedTextFile&) = delete;
+      MappedTextFile& operator= (const MappedTextFile&) = delete;
+
+      const char* begin () const { return m_data; }
+      const char* end () const { return m_data + m_size; }
+      size_t size () const { return m_size; }
+
+      /// @brief Lines of the i-th of n byte ranges of equal size; a line
+      ///        belongs to the range that holds its first byte, so the
+      ///        ranges of 0 .. n-1 cover each line exactly once.
+      std::pair<const char*, const char*> line_range (size_t i, size_t n) const;
+
+    private:
+      const char* m_data;
+      size_t      m_size;
+    };
+
+
+    // Whitespace-separated fields of one line
+    struct TextFields
+    {
+      const char* p;
+      const char* end;
+
+      /// @brief Parses the next field as a number; returns false and
+      ///        leaves value unchanged if there is no such field.
+      template<class T>
+      bool next (T& value)
+      {
+        while ((p < end) && ((*p == ' ') || (*p == '\t') || (*p == '\r')))
+          p++;
+        // from_chars does not accept a leading plus sign
+        if ((p < end) && (*p == '+'))
+          p++;
+        std::from_chars_result result = std::from_chars(p, end, value);
+        if (result.ec != std::errc())
+          return false;
+        p = result.ptr;
+        return true;
+      }
+    };
+
+
+    // Lines of a range of text
+    struct TextLines
+    {
+      const char* p;
+      const char* end;
+
+      /// @brief Sets fields to the next line; returns false at the end
+      ///        of the range.
+      bool next (TextFields& fields)
+      {
+        if (p >= end)
+          return false;
+        const char* line_end = static_cast<const char*>(memchr(p, '\n', end - p));
+        if (line_end == nullptr)
+          line_end = end;
+        fields = TextFields { p, line_end };
+        p = line_end + 1;
+        return true;
+      }
+    };
+  }
+}
+
+#endif
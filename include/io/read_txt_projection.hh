@@ -4,7 +4,7 @@
 ///
 ///  Read projection in text format.
 ///
-///  Copyright (C) 2016-2017 Project NeuroH5.
+///  Copyright (C) 2016-2025 Project NeuroH5.
 //==============================================================================
 
 #include <string>
@@ -24,6 +24,18 @@ namespace neuroh5
                              vector<DST_PTR_T>&     src_idx_ptr,
                              vector<NODE_IDX_T>&    src_idx,
                              map <string, neuroh5::data::AttrVal>& attrs_map);
+
+    /// @brief Reads the lines of the file in the byte range of this rank
+    ///        of comm; the ranges of all ranks cover each line once. Does
+    ///        not communicate, and appends to the output columns like the
+    ///        serial reader.
+    int read_txt_projection (MPI_Comm               comm,
+                             const string&          file_name,
+                             const map < string, vector <size_t> >& num_attrs,
+                             vector<NODE_IDX_T>&    dst_idx,
+                             vector<DST_PTR_T>&     src_idx_ptr,
+                             vector<NODE_IDX_T>&    src_idx,
+                             map <string, neuroh5::data::AttrVal>& attrs_map);
     
   }
 }
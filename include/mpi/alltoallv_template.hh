@@ -12,6 +12,7 @@
 
 #include <mpi.h>
 
+#include <climits>
 #include <vector>
 #include <map>
 
@@ -30,6 +31,277 @@ namespace neuroh5
   namespace mpi
   {
     
+    /***************************************************************************
+     * Exchanges one chunk round with MPI_Alltoallw. The displacement of
+     * each peer is encoded in a derived datatype with an MPI_Aint byte
+     * offset, so that displacements are not limited to the range of int.
+     **************************************************************************/
+    template<class T>
+    int alltoallw_chunk (MPI_Comm comm,
+                         const MPI_Datatype datatype,
+                         const vector<size_t>& sendcounts,
+                         const vector<size_t>& sdispls,
+                         const vector<T>& sendbuf,
+                         const vector<size_t>& recvcounts,
+                         const vector<size_t>& rdispls,
+                         vector<T>& recvbuf,
+                         const size_t chunk_start,
+                         const size_t chunk_size)
+    {
+      const size_t size = sendcounts.size();
+      int status;
+      MPI_Aint lb, extent;
+      status = MPI_Type_get_extent(datatype, &lb, &extent);
+      throw_assert(status == MPI_SUCCESS,
+                   "alltoallv: error in MPI_Type_get_extent: status: " << status);
+
+      vector<int> w_sendcounts(size, 0), w_recvcounts(size, 0);
+      vector<int> w_sdispls(size, 0), w_rdispls(size, 0);
+      vector<MPI_Datatype> w_sendtypes(size, datatype), w_recvtypes(size, datatype);
+      vector<MPI_Datatype> committed_types;
+
+      auto chunk_type = [&] (size_t full_count, size_t full_displ,
+                             int& w_count, MPI_Datatype& w_type)
+        {
+          size_t remaining = (chunk_start < full_count) ? full_count - chunk_start : 0;
+          size_t count = std::min(remaining, chunk_size);
+          if (count > 0)
+            {
+              MPI_Datatype contig_type, displ_type;
+              MPI_Aint displ = (MPI_Aint)(full_displ + chunk_start) * extent;
+              throw_assert(MPI_Type_contiguous((int)count, datatype, &contig_type) == MPI_SUCCESS,
+                           "alltoallv: error in MPI_Type_contiguous");
+              throw_assert(MPI_Type_create_hindexed_block(1, 1, &displ, contig_type,
+                                                          &displ_type) == MPI_SUCCESS,
+                           "alltoallv: error in MPI_Type_create_hindexed_block");
+              throw_assert(MPI_Type_commit(&displ_type) == MPI_SUCCESS,
+                           "alltoallv: error in MPI_Type_commit");
+              throw_assert(MPI_Type_free(&contig_type) == MPI_SUCCESS,
+                           "alltoallv: error in MPI_Type_free");
+              w_count = 1;
+              w_type = displ_type;
+              committed_types.push_back(displ_type);
+            }
+        };
+
+      for (size_t p = 0; p < size; ++p)
+        {
+          chunk_type(sendcounts[p], sdispls[p], w_sendcounts[p], w_sendtypes[p]);
+          chunk_type(recvcounts[p], rdispls[p], w_recvcounts[p], w_recvtypes[p]);
+        }
+
+      status = MPI_Alltoallw(sendbuf.data(), &w_sendcounts[0], &w_sdispls[0], &w_sendtypes[0],
+                             recvbuf.data(), &w_recvcounts[0], &w_rdispls[0], &w_recvtypes[0],
+                             comm);
+      throw_assert(status == MPI_SUCCESS,
+                   "alltoallv: error in MPI_Alltoallw: status: " << status);
+
+      for (MPI_Datatype& t : committed_types)
+        {
+          throw_assert(MPI_Type_free(&t) == MPI_SUCCESS,
+                       "alltoallv: error in MPI_Type_free");
+        }
+
+      return MPI_SUCCESS;
+    }
+
+    // The sparse exchange pays off when at most 1/SPARSE_EXCHANGE_SENDER_RATIO
+    // of the ranks of a communicator of at least SPARSE_EXCHANGE_MIN_SIZE
+    // ranks have data to send (e.g. the I/O ranks of a scatter read)
+    constexpr size_t SPARSE_EXCHANGE_SENDER_RATIO = 4;
+    constexpr size_t SPARSE_EXCHANGE_MIN_SIZE = 8;
+
+    /***************************************************************************
+     * Returns true if an exchange over size ranks in which at most
+     * max_senders ranks have data to send should use the sparse
+     * exchange. Both arguments must be the same on all ranks, e.g. the
+     * communicator size and the number of I/O ranks of a scatter read,
+     * so that all ranks pick the same exchange without communicating.
+     **************************************************************************/
+    inline bool use_sparse_exchange (const size_t size, const size_t max_senders)
+    {
+      return (size >= SPARSE_EXCHANGE_MIN_SIZE) &&
+        (max_senders * SPARSE_EXCHANGE_SENDER_RATIO <= size);
+    }
+
+    // Message tags of the sparse exchange
+    constexpr int SPARSE_EXCHANGE_COUNT_TAG = 0x5A01;
+    constexpr int SPARSE_EXCHANGE_DATA_TAG  = 0x5A02;
+
+    // Default message tag of nonblocking exchanges
+    constexpr int IALLTOALLV_DATA_TAG = 0x5A03;
+
+    /***************************************************************************
+     * Posts the receives and sends of an exchange with known counts as
+     * point-to-point messages of at most CHUNK_SIZE elements, and appends
+     * their requests to requests. Pieces between the same pair of ranks
+     * are matched in the order they are posted.
+     **************************************************************************/
+    template<class T>
+    void post_alltoallv_messages (MPI_Comm comm,
+                                  const MPI_Datatype datatype,
+                                  const vector<size_t>& sendcounts,
+                                  const vector<size_t>& sdispls,
+                                  const vector<T>& sendbuf,
+                                  const vector<size_t>& recvcounts,
+                                  const vector<size_t>& rdispls,
+                                  vector<T>& recvbuf,
+                                  const int tag,
+                                  vector<MPI_Request>& requests)
+    {
+      const size_t size = sendcounts.size();
+      int status;
+      MPI_Aint lb, extent;
+      status = MPI_Type_get_extent(datatype, &lb, &extent);
+      throw_assert(status == MPI_SUCCESS,
+                   "alltoallv: error in MPI_Type_get_extent: status: " << status);
+
+      char* recv_base = reinterpret_cast<char*>(recvbuf.data());
+      const char* send_base = reinterpret_cast<const char*>(sendbuf.data());
+      for (size_t p = 0; p < size; ++p)
+        {
+          for (size_t offset = 0; offset < recvcounts[p]; offset += data::CHUNK_SIZE)
+            {
+              int count = (int)std::min(data::CHUNK_SIZE, recvcounts[p] - offset);
+              MPI_Request request;
+              status = MPI_Irecv(recv_base + (MPI_Aint)(rdispls[p] + offset) * extent,
+                                 count, datatype, p, tag, comm, &request);
+              throw_assert(status == MPI_SUCCESS,
+                           "alltoallv: error in MPI_Irecv: status: " << status);
+              requests.push_back(request);
+            }
+        }
+      for (size_t p = 0; p < size; ++p)
+        {
+          for (size_t offset = 0; offset < sendcounts[p]; offset += data::CHUNK_SIZE)
+            {
+              int count = (int)std::min(data::CHUNK_SIZE, sendcounts[p] - offset);
+              MPI_Request request;
+              status = MPI_Isend(send_base + (MPI_Aint)(sdispls[p] + offset) * extent,
+                                 count, datatype, p, tag, comm, &request);
+              throw_assert(status == MPI_SUCCESS,
+                           "alltoallv: error in MPI_Isend: status: " << status);
+              requests.push_back(request);
+            }
+        }
+    }
+
+    /***************************************************************************
+     * Exchanges data when only a few ranks have non-empty send buffers.
+     *
+     * The receive counts are determined with a non-blocking consensus
+     * handshake: each sender posts a synchronous send of its count to
+     * each rank that it has data for, and every rank receives counts
+     * until the MPI_Ibarrier entered after its own count messages have
+     * been matched completes. The data are then exchanged point-to-point
+     * in pieces of at most CHUNK_SIZE elements. No rank exchanges
+     * anything with ranks that it has nothing to send to or receive
+     * from.
+     **************************************************************************/
+    template<class T>
+    int sparse_alltoallv_vector (MPI_Comm comm,
+                                 const MPI_Datatype datatype,
+                                 const vector<size_t>& sendcounts,
+                                 const vector<size_t>& sdispls,
+                                 const vector<T>& sendbuf,
+                                 vector<size_t>& recvcounts,
+                                 vector<size_t>& rdispls,
+                                 vector<T>& recvbuf)
+    {
+      const size_t size = sendcounts.size();
+      int status;
+
+      recvcounts.assign(size, 0);
+      rdispls.assign(size, 0);
+
+      // 1. Send counts to non-empty destinations and receive counts
+      //    until all ranks have reached the barrier
+      vector<MPI_Request> count_requests;
+      for (size_t p = 0; p < size; ++p)
+        {
+          if (sendcounts[p] > 0)
+            {
+              MPI_Request request;
+              status = MPI_Issend(&sendcounts[p], 1, MPI_SIZE_T, p,
+                                  SPARSE_EXCHANGE_COUNT_TAG, comm, &request);
+              throw_assert(status == MPI_SUCCESS,
+                           "alltoallv: error in MPI_Issend: status: " << status);
+              count_requests.push_back(request);
+            }
+        }
+
+      MPI_Request barrier_request = MPI_REQUEST_NULL;
+      bool barrier_active = false;
+      while (true)
+        {
+          int flag = 0;
+          MPI_Status probe_status;
+          status = MPI_Iprobe(MPI_ANY_SOURCE, SPARSE_EXCHANGE_COUNT_TAG, comm,
+                              &flag, &probe_status);
+          throw_assert(status == MPI_SUCCESS,
+                       "alltoallv: error in MPI_Iprobe: status: " << status);
+          if (flag)
+            {
+              const int source = probe_status.MPI_SOURCE;
+              status = MPI_Recv(&recvcounts[source], 1, MPI_SIZE_T, source,
+                                SPARSE_EXCHANGE_COUNT_TAG, comm, MPI_STATUS_IGNORE);
+              throw_assert(status == MPI_SUCCESS,
+                           "alltoallv: error in MPI_Recv: status: " << status);
+            }
+
+          int done = 0;
+          if (barrier_active)
+            {
+              status = MPI_Test(&barrier_request, &done, MPI_STATUS_IGNORE);
+              throw_assert(status == MPI_SUCCESS,
+                           "alltoallv: error in MPI_Test: status: " << status);
+              if (done)
+                break;
+            }
+          else
+            {
+              status = MPI_Testall(count_requests.size(), count_requests.data(),
+                                   &done, MPI_STATUSES_IGNORE);
+              throw_assert(status == MPI_SUCCESS,
+                           "alltoallv: error in MPI_Testall: status: " << status);
+              if (done)
+                {
+                  status = MPI_Ibarrier(comm, &barrier_request);
+                  throw_assert(status == MPI_SUCCESS,
+                               "alltoallv: error in MPI_Ibarrier: status: " << status);
+                  barrier_active = true;
+                }
+            }
+        }
+
+      // 2. Allocate the receive buffer
+      size_t recvbuf_size = recvcounts[0];
+      for (size_t p = 1; p < size; ++p)
+        {
+          rdispls[p] = rdispls[p-1] + recvcounts[p-1];
+          recvbuf_size += recvcounts[p];
+        }
+      recvbuf.resize(recvbuf_size, 0);
+
+      // 3. Exchange the data point-to-point
+      vector<MPI_Request> data_requests;
+      post_alltoallv_messages<T>(comm, datatype, sendcounts, sdispls, sendbuf,
+                                 recvcounts, rdispls, recvbuf,
+                                 SPARSE_EXCHANGE_DATA_TAG, data_requests);
+      status = MPI_Waitall(data_requests.size(), data_requests.data(), MPI_STATUSES_IGNORE);
+      throw_assert(status == MPI_SUCCESS,
+                   "alltoallv: error in MPI_Waitall: status: " << status);
+
+      return MPI_SUCCESS;
+    }
+
+    /***************************************************************************
+     * Sends data with Alltoallv. If sparse is true, the sparse
+     * point-to-point exchange is used instead of the dense collectives;
+     * the caller decides this from information that is the same on all
+     * ranks (see use_sparse_exchange), so that no extra collective is
+     * needed to agree on it.
+     **************************************************************************/
     template<class T>
     int alltoallv_vector (MPI_Comm comm,
                           const MPI_Datatype datatype,
@@ -38,7 +310,8 @@ namespace neuroh5
                           const vector<T>& sendbuf,
                           vector<size_t>& recvcounts,
                           vector<size_t>& rdispls,
-                          vector<T>& recvbuf)
+                          vector<T>& recvbuf,
+                          const bool sparse = false)
     {
       int ssize; size_t size;
       throw_assert(MPI_Comm_size(comm, &ssize) == MPI_SUCCESS,
@@ -46,7 +319,13 @@ namespace neuroh5
       throw_assert_nomsg(ssize > 0);
       size = ssize;
 
-      
+      if (sparse)
+        {
+          return sparse_alltoallv_vector<T>(comm, datatype,
+                                            sendcounts, sdispls, sendbuf,
+                                            recvcounts, rdispls, recvbuf);
+        }
+
     /***************************************************************************
      * Send MPI data with Alltoallv 
      **************************************************************************/
@@ -83,50 +362,78 @@ namespace neuroh5
       //assert(recvbuf_size > 0);
       recvbuf.resize(recvbuf_size, 0);
 
+#if MPI_VERSION >= 4
+      // 3. Perform the actual data exchange with large-count
+      //    (MPI_Count/MPI_Aint) counts and displacements
+      {
+        int status;
+        vector<MPI_Count> c_sendcounts(size), c_recvcounts(size);
+        vector<MPI_Aint> c_sdispls(size), c_rdispls(size);
+        for (size_t p = 0; p < size; ++p)
+          {
+            c_sendcounts[p] = sendcounts[p];
+            c_sdispls[p]    = sdispls[p];
+            c_recvcounts[p] = recvcounts[p];
+            c_rdispls[p]    = rdispls[p];
+          }
+        status = MPI_Alltoallv_c(sendbuf.data(), &c_sendcounts[0], &c_sdispls[0], datatype,
+                                 recvbuf.data(), &c_recvcounts[0], &c_rdispls[0], datatype,
+                                 comm);
+        throw_assert (status == MPI_SUCCESS, "error in MPI_Alltoallv_c: status = " << status);
+      }
+#else
       {
         int status;
         MPI_Request request;
 
-        // 3. Perform the actual data exchange in chunks
-        size_t chunk_start = 0;
-        while (true)
+        // 3. Determine the number of chunk rounds and whether any
+        //    displacement exceeds the range of int, with a single
+        //    reduction for both
+        size_t round_info[2] = {0, 0}, global_round_info[2] = {0, 0};
+        for (size_t p = 0; p < size; ++p)
           {
-            size_t global_send_size=0;
-            size_t global_recv_size=0;
+            size_t max_count = std::max(sendcounts[p], recvcounts[p]);
+            size_t rounds = (max_count + data::CHUNK_SIZE - 1) / data::CHUNK_SIZE;
+            round_info[0] = std::max(round_info[0], rounds);
+            if ((sendcounts[p] > 0 && sdispls[p] + sendcounts[p] > (size_t)INT_MAX) ||
+                (recvcounts[p] > 0 && rdispls[p] + recvcounts[p] > (size_t)INT_MAX))
+              {
+                round_info[1] = 1;
+              }
+          }
+        status = MPI_Iallreduce(round_info, global_round_info, 2, MPI_SIZE_T, MPI_MAX,
+                                comm, &request);
+        throw_assert (status == MPI_SUCCESS, "error in MPI_Iallreduce: status = " << status);
+        status = MPI_Wait(&request, MPI_STATUS_IGNORE);
+        throw_assert(status == MPI_SUCCESS,
+                     "alltoallv: error in MPI_Wait: status: " << status);
+
+        const size_t num_rounds = global_round_info[0];
+        const bool large_displs = global_round_info[1] > 0;
+        
+        // 4. Perform the actual data exchange in chunks
+        for (size_t round = 0; round < num_rounds; round++)
+          {
+            size_t chunk_start = round * data::CHUNK_SIZE;
+
+            if (large_displs)
+              {
+                alltoallw_chunk<T>(comm, datatype,
+                                   sendcounts, sdispls, sendbuf,
+                                   recvcounts, rdispls, recvbuf,
+                                   chunk_start, data::CHUNK_SIZE);
+                continue;
+              }
             
             auto chunk = data::calculate_chunk_sizes<T>(
                 sendcounts, sdispls, recvcounts, rdispls,
                 chunk_start, data::CHUNK_SIZE);
 
-            status = MPI_Iallreduce(&chunk.total_recv_size,
-                                    &global_recv_size,
-                                    1, MPI_SIZE_T, MPI_SUM,
-                                    comm, &request);
-            
-            throw_assert (status == MPI_SUCCESS, "error in MPI_Iallreduce: status = " << status);
-            status = MPI_Wait(&request, MPI_STATUS_IGNORE);
-            throw_assert(status == MPI_SUCCESS,
-                         "alltoallv: error in MPI_Wait: status: " << status);
-
-            status = MPI_Iallreduce(&chunk.total_send_size,
-                                    &global_send_size,
-                                    1, MPI_SIZE_T, MPI_SUM,
-                                    comm, &request);
-            
-            throw_assert (status == MPI_SUCCESS, "error in MPI_Iallreduce: status = " << status);
-            status = MPI_Wait(&request, MPI_STATUS_IGNORE);
-            throw_assert(status == MPI_SUCCESS,
-                         "alltoallv: error in MPI_Wait: status: " << status);
-
-            if (global_send_size == 0 &&
-                global_recv_size == 0)
-              break;
-            
-            status = MPI_Ialltoallv(&sendbuf[0],
+            status = MPI_Ialltoallv(sendbuf.data(),
                                     &chunk.sendcounts[0],
                                     &chunk.sdispls[0],
                                     datatype,
-                                    &recvbuf[0],
+                                    recvbuf.data(),
                                     &chunk.recvcounts[0],
                                     &chunk.rdispls[0],
                                     datatype,
@@ -135,12 +442,78 @@ namespace neuroh5
             status = MPI_Wait(&request, MPI_STATUS_IGNORE);
             throw_assert(status == MPI_SUCCESS,
                            "alltoallv: error in MPI_Wait: status: " << status);
-
-            chunk_start += data::CHUNK_SIZE;
-
           }
       }
+#endif
+
+      return MPI_SUCCESS;
+    }
+
+    /***************************************************************************
+     * Starts a nonblocking exchange with the semantics of
+     * alltoallv_vector: the counts are exchanged collectively, then the
+     * receive buffer is allocated and the data transfers are posted as
+     * point-to-point messages. The send and receive buffers must not be
+     * modified or reallocated until ialltoallv_vector_wait has returned.
+     * Exchanges started on the same communicator with the same tag are
+     * matched in the order in which they are started, so several may be
+     * in flight at once.
+     **************************************************************************/
+    template<class T>
+    int ialltoallv_vector_start (MPI_Comm comm,
+                                 const MPI_Datatype datatype,
+                                 const vector<size_t>& sendcounts,
+                                 const vector<size_t>& sdispls,
+                                 const vector<T>& sendbuf,
+                                 vector<size_t>& recvcounts,
+                                 vector<size_t>& rdispls,
+                                 vector<T>& recvbuf,
+                                 vector<MPI_Request>& requests,
+                                 const int tag = IALLTOALLV_DATA_TAG)
+    {
+      int ssize; size_t size;
+      throw_assert(MPI_Comm_size(comm, &ssize) == MPI_SUCCESS,
+                   "alltoallv: unable to obtain size of MPI communicator");
+      throw_assert_nomsg(ssize > 0);
+      size = ssize;
+
+      recvcounts.assign(size, 0);
+      rdispls.assign(size, 0);
+
+      int status;
+      MPI_Request request;
+      status = MPI_Ialltoall(&sendcounts[0], 1, MPI_SIZE_T,
+                             &recvcounts[0], 1, MPI_SIZE_T,
+                             comm, &request);
+      throw_assert(status == MPI_SUCCESS,
+                   "alltoallv: error in MPI_Ialltoall: status: " << status);
+      status = MPI_Wait(&request, MPI_STATUS_IGNORE);
+      throw_assert(status == MPI_SUCCESS,
+                   "alltoallv: error in MPI_Wait: status: " << status);
 
+      size_t recvbuf_size = recvcounts[0];
+      for (size_t p = 1; p < size; ++p)
+        {
+          rdispls[p] = rdispls[p-1] + recvcounts[p-1];
+          recvbuf_size += recvcounts[p];
+        }
+      recvbuf.resize(recvbuf_size, 0);
+
+      post_alltoallv_messages<T>(comm, datatype, sendcounts, sdispls, sendbuf,
+                                 recvcounts, rdispls, recvbuf, tag, requests);
+
+      return MPI_SUCCESS;
+    }
+
+    /***************************************************************************
+     * Completes an exchange started with ialltoallv_vector_start
+     **************************************************************************/
+    inline int ialltoallv_vector_wait (vector<MPI_Request>& requests)
+    {
+      int status = MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+      throw_assert(status == MPI_SUCCESS,
+                   "alltoallv: error in MPI_Waitall: status: " << status);
+      requests.clear();
       return MPI_SUCCESS;
     }
   }
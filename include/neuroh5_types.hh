@@ -106,6 +106,45 @@ namespace neuroh5
       EdgeMapSrc
     };
 
+  // How the DBS pointer datasets of a projection are read: either
+  // rank 0 reads them in full and distributes the per-rank slices, or
+  // each I/O rank collectively reads only the slice it is assigned
+  enum ProjectionPtrReadMode
+    {
+      PtrReadRoot,
+      PtrReadDistributed
+    };
+
+  // How the destination blocks of a projection are divided among the
+  // I/O ranks: in equal numbers of blocks, or in equal shares of the
+  // cumulative edge count (optionally weighted by edge attribute bytes)
+  enum ProjectionBlockAssignment
+    {
+      BlockAssignEven,
+      BlockAssignEdgeWeighted
+    };
+
+  // Where the append functions write: to the shared output file with
+  // collective I/O, or each I/O rank to a subfile of its own, which is
+  // later merged into the output file by the stitch functions
+  enum WriteMode
+    {
+      WriteShared,
+      WriteSubfile
+    };
+
+  // Storage backend of a node-to-rank map: no assignment, functional
+  // round-robin or contiguous-block assignment of a node range, a flat
+  // array of owner ranks, or CSR lists of owner ranks
+  enum NodeRankMapType
+    {
+      RankMapNone,
+      RankMapRoundRobin,
+      RankMapBlock,
+      RankMapFlat,
+      RankMapCSR
+    };
+
   enum CellIndex
     {
       IndexOwner,
@@ -120,6 +159,74 @@ namespace neuroh5
       PtrNone
     };
 
+  // Storage of the point attributes of the Trees namespace. With
+  // TreeQuantized, coordinates and radii are fixed-point integers whose
+  // absolute error is at most precision: coordinates are offsets from
+  // the parent point, or from the first point of the tree for points
+  // whose parent does not precede them. Parents are stored as the
+  // difference to the point index, and layers and SWC types as runs.
+  enum TreeEncodingType
+    {
+      TreePlain,
+      TreeQuantized
+    };
+
+  struct TreeEncoding
+  {
+    TreeEncodingType type = TreePlain;
+    double precision = 0.005;
+
+    TreeEncoding () {}
+    TreeEncoding (TreeEncodingType p_type, double p_precision = 0.005)
+      : type(p_type), precision(p_precision) {}
+  };
+
+  // Filters applied to a chunked dataset when it is created. The delta
+  // filter stores integer data as bit-packed differences of successive
+  // elements; it is specific to NeuroH5 and only applies to integer
+  // datasets. Shuffle is not applied together with delta.
+  struct DatasetFilter
+  {
+    bool shuffle = false;
+    unsigned deflate_level = 0; // 0 disables deflate
+    bool delta = false;
+
+    DatasetFilter () {}
+    DatasetFilter (bool p_shuffle, unsigned p_deflate_level, bool p_delta = false)
+      : shuffle(p_shuffle), deflate_level(p_deflate_level), delta(p_delta) {}
+
+    bool empty () const { return !(shuffle || delta || (deflate_level > 0)); }
+  };
+
+  // Filters for the datasets written by the graph and attribute
+  // writers: index datasets (Destination Block Index, Source Index,
+  // Cell Index), pointer datasets (Destination Block Pointer,
+  // Destination Pointer, Attribute Pointer) and attribute values
+  struct FilterConfig
+  {
+    DatasetFilter index;
+    DatasetFilter pointer;
+    DatasetFilter value;
+  };
+
+  // File access settings applied to parallel opens: whether collective
+  // metadata reads and writes may be used by the reads that request
+  // them (see set_parallel_file_access), MPI-IO hints passed to the
+  // MPI-IO driver (e.g. cb_nodes, cb_buffer_size, romio_ds_read), the
+  // allocation alignment and metadata block size (0 keeps the HDF5
+  // default), and the largest gap between the ranges of a selection
+  // read that is read through rather than skipped
+  struct FileAccessConfig
+  {
+    bool coll_metadata_ops = true;
+    bool coll_metadata_write = true;
+    std::map<std::string, std::string> mpi_hints;
+    hsize_t alignment_threshold = 0;
+    hsize_t alignment = 0;
+    hsize_t meta_block_size = 0;
+    hsize_t selection_gap = 64*1024;
+  };
+
   struct CellPtr
   {
     const CellPtrType type;
@@ -177,8 +284,6 @@ namespace neuroh5
                       std::deque<SWC_TYPE_T>  // SWC type
                       > neurotree_t;
 
-  typedef std::map<Graph::vertex, std::deque<Graph::vertex> > contraction_map_t;
-
   // population combination type
   typedef struct
   {
@@ -215,7 +320,51 @@ namespace neuroh5
 
   typedef rank_edge_map_t::iterator rank_edge_map_iter_t;
 
+  // Compressed sparse row representation of the edges of a
+  // projection. node_index is sorted; the adjacency list of
+  // node_index[i] is adj_index[adj_offsets[i] .. adj_offsets[i+1]),
+  // and each attribute vector in edge_attrs (one AttrVal per attribute
+  // namespace) is a flat column aligned with adj_index.
+  struct edge_csr_t
+  {
+    std::vector<NODE_IDX_T>     node_index;
+    std::vector<size_t>         adj_offsets;
+    std::vector<NODE_IDX_T>     adj_index;
+    std::vector<data::AttrVal>  edge_attrs;
+
+    size_t size() const { return node_index.size(); }
+    size_t num_edges() const { return adj_index.size(); }
+    bool empty() const { return node_index.empty(); }
+
+    template<class Archive>
+    void serialize(Archive & archive)
+    {
+      archive(node_index, adj_offsets, adj_index, edge_attrs);
+    }
+  };
+
   typedef map<CELL_IDX_T, set<rank_t> > node_rank_map_t;
+
+  // Cell index and attribute pointer of a cell attribute, partitioned
+  // over the ranks of a communicator by cell id: rank r holds the cells
+  // whose id modulo the communicator size is r, sorted by id, and the
+  // (start, count) range of the attribute values of each cell
+  struct CellIndexPartition
+  {
+    std::vector<CELL_IDX_T> index;
+    std::vector< std::pair<hsize_t, hsize_t> > ranges;
+  };
+
+  // Index lookup state of the attributes of a name space: the names and
+  // kinds of the attributes, for each attribute the position of the
+  // attribute whose index and pointer it shares (its own position if it
+  // has its own), and the partitions of those indexes, built on first use
+  struct CellIndexService
+  {
+    std::vector< std::pair<std::string, AttrKind> > attributes;
+    std::vector<size_t> owners;
+    std::map<size_t, CellIndexPartition> partitions;
+  };
   
 // In-memory HDF5 datatype of attribute pointers
 #define ATTR_PTR_H5_NATIVE_T H5T_NATIVE_UINT64
@@ -31,11 +31,18 @@
 #include <vector>
 #include <deque>
 #include <forward_list>
+#include <future>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
 
 #include <hdf5.h>
 #include <mpi.h>
 #include <algorithm>
 #include <iterator>
+#include <memory>
+#include <numeric>
 
 #include "throw_assert.hh"
 
@@ -52,6 +59,9 @@
 #include "dataset_num_elements.hh"
 #include "num_projection_blocks.hh"
 #include "attr_map.hh"
+#include "columnar_attr_map.hh"
+#include "tree_arena.hh"
+#include "rank_map.hh"
 #include "mpe_seq.hh"
 #include "read_projection.hh"
 #include "read_graph.hh"
@@ -64,7 +74,13 @@
 #include "write_graph.hh"
 #include "append_graph.hh"
 #include "projection_names.hh"
+#include "neuroh5_file.hh"
 #include "edge_attributes.hh"
+#include "dataset_filters.hh"
+#include "file_access.hh"
+#include "subfiles.hh"
+#include "stitch_graph.hh"
+#include "stitch_cell_attributes.hh"
 #include "serialize_data.hh"
 #include "split_intervals.hh"
 #include "shared_array.hh"
@@ -154,6 +170,8 @@ void build_node_rank_map (MPI_Comm comm,
   throw_assert(status == MPI_SUCCESS,
                "build_node_rank_map: unable to obtain rank of MPI communicator");
 
+  throw_assert (!PyUnicode_Check(py_node_allocation),
+                "build_node_rank_map: named node allocations are only supported by scatter reads");
   PyObject *seq = PyObject_GetIter(py_node_allocation);
   throw_assert (seq != NULL,
                 "build_node_rank_map: unable to obtain iterator for node allocation sequence");
@@ -223,7 +241,72 @@ void build_node_rank_map (MPI_Comm comm,
                  "build_node_rank_map: barrier error");
 
   }
-  
+
+}
+
+
+/*
+ * Round-robin assignment of the nodes in a sorted index to ranks. Each
+ * node has one owner, so the flat backend is used over the range of
+ * the index; cell indices are normally contiguous population ranges.
+ */
+data::NodeRankMap round_robin_index_rank_map (vector<NODE_IDX_T>&& node_index,
+                                              size_t num_ranks)
+{
+  if (node_index.empty())
+    {
+      return data::NodeRankMap();
+    }
+  const NODE_IDX_T start = node_index.front();
+  vector<rank_t> owners((size_t)(node_index.back() - start) + 1, data::NodeRankMap::no_rank);
+  for (size_t i = 0; i < node_index.size(); i++)
+    {
+      owners[node_index[i] - start] = i%num_ranks;
+    }
+  node_index.clear();
+  node_index.shrink_to_fit();
+  return data::NodeRankMap::flat(start, std::move(owners));
+}
+
+
+/*
+ * Node rank map of a scatter read, built from a node_allocation
+ * argument that is either the name of a functional assignment of the
+ * node range [start, start+count) ("round_robin" or "block"), or an
+ * iterable of the gids assigned to the calling rank.
+ */
+void build_scatter_node_rank_map (MPI_Comm comm,
+                                  PyObject *py_node_allocation,
+                                  NODE_IDX_T start, size_t count,
+                                  data::NodeRankMap& node_rank_map)
+{
+  int comm_size;
+  throw_assert(MPI_Comm_size(comm, &comm_size) == MPI_SUCCESS,
+               "build_scatter_node_rank_map: unable to obtain size of MPI communicator");
+
+  if (PyUnicode_Check(py_node_allocation))
+    {
+      const string allocation_name = string(PyUnicode_AsUTF8(py_node_allocation));
+      if (allocation_name == "round_robin")
+        {
+          node_rank_map = data::NodeRankMap::round_robin(comm_size, start, count);
+        }
+      else if (allocation_name == "block")
+        {
+          node_rank_map = data::NodeRankMap::block(comm_size, start, count);
+        }
+      else
+        {
+          throw_assert(false,
+                       "build_scatter_node_rank_map: unknown node allocation " << allocation_name);
+        }
+    }
+  else
+    {
+      node_rank_map_t explicit_node_rank_map;
+      build_node_rank_map(comm, py_node_allocation, explicit_node_rank_map);
+      node_rank_map = data::NodeRankMap(explicit_node_rank_map);
+    }
 }
 
 
@@ -234,7 +317,7 @@ void ldbal_cell_attr (MPI_Comm comm,
                       const pop_t& pop_idx,    
                       const vector<string>& attr_name_spaces,
                       PyObject *py_node_allocation,
-                      node_rank_map_t& node_rank_map)
+                      data::NodeRankMap& node_rank_map)
 {
   int status;
   int rank, size;
@@ -247,25 +330,28 @@ void ldbal_cell_attr (MPI_Comm comm,
   throw_assert(status == MPI_SUCCESS,
                "ldbal_cell_attr: unable to obtain rank of MPI communicator");
 
+  CELL_IDX_T pop_start = 0;
+  size_t pop_count = 0;
+  {
+    auto it = pop_ranges.find(pop_idx);
+    throw_assert(it != pop_ranges.end(),
+                 "ldbal_cell_attr: invalid population index");
+    pop_start = it->second.start;
+    pop_count = it->second.count;
+  }
+
   if ((py_node_allocation != NULL) && (py_node_allocation != Py_None))
     {
-      build_node_rank_map(comm, py_node_allocation, node_rank_map);
+      build_scatter_node_rank_map(comm, py_node_allocation, pop_start, pop_count,
+                                  node_rank_map);
     }
   else
     {
+      // round-robin node to rank assignment of the cells with
+      // attributes; only the sorted index is broadcast
+      vector<CELL_IDX_T> attr_index_vector;
       if (rank == root)
         {
-          CELL_IDX_T pop_start = 0;
-          size_t pop_count = 0;
-          {
-            auto it = pop_ranges.find(pop_idx);
-            throw_assert(it != pop_ranges.end(),
-                           "ldbal_cell_attr: invalid population index");
-            pop_start = it->second.start;
-            pop_count = it->second.count;
-          }
-          
-          // round-robin node to rank assignment from file
           set<CELL_IDX_T> attr_index;
           for (const auto& attr_name_space : attr_name_spaces)
             {
@@ -290,38 +376,20 @@ void ldbal_cell_attr (MPI_Comm comm,
                     }
                 }
             }
-          
-          size_t i = 0;
-          for (const auto& gid : attr_index)
-            {
-              node_rank_map[gid].insert(i%size);
-              i++;
-            }
-          throw_assert(node_rank_map.size() == attr_index.size(),
-                       "ldbal_cell_attr: node_rank_map is not the same size as attr_index");
+          attr_index_vector.assign(attr_index.begin(), attr_index.end());
         }
 
-      vector<char> sendbuf;
-      size_t sendbuf_size=0;
-      if ((rank == root) && (node_rank_map.size() > 0) )
-        {
-          data::serialize_data(node_rank_map, sendbuf);
-          sendbuf_size = sendbuf.size();
-        }
-      
-      status = MPI_Bcast(&sendbuf_size, 1, MPI_SIZE_T, root, comm);
+      size_t attr_index_size = attr_index_vector.size();
+      status = MPI_Bcast(&attr_index_size, 1, MPI_SIZE_T, root, comm);
       throw_assert(status == MPI_SUCCESS,
                    "ldbal_cell_attr: broadcast error");
       
-      sendbuf.resize(sendbuf_size);
-      status = MPI_Bcast(&sendbuf[0], sendbuf_size, MPI_CHAR, root, comm);
+      attr_index_vector.resize(attr_index_size);
+      status = MPI_Bcast(attr_index_vector.data(), attr_index_size, MPI_CELL_IDX_T, root, comm);
       throw_assert(status == MPI_SUCCESS,
                    "ldbal_cell_attr: broadcast error");
-      
-      if ((rank != root) && (sendbuf_size > 0))
-        {
-          data::deserialize_data(sendbuf, node_rank_map);
-        }
+
+      node_rank_map = round_robin_index_rank_map(std::move(attr_index_vector), size);
     }
 
 }
@@ -337,13 +405,14 @@ void ldbal_cell_attr_gen (MPI_Comm comm,
                           const string& attr_name_space,
                           const size_t& numitems,
                           PyObject *py_node_allocation,
-                          node_rank_map_t& node_rank_map,
+                          data::NodeRankMap& node_rank_map,
                           size_t& count, size_t& local_count,
                           size_t& max_local_count)
 {
   int status;
   int rank, size;
   int root = 0;
+  node_rank_map_t gid_rank_map;
 
   status = MPI_Comm_size(comm, &size);
   throw_assert(status == MPI_SUCCESS,
@@ -355,7 +424,7 @@ void ldbal_cell_attr_gen (MPI_Comm comm,
 
   if ((py_node_allocation != NULL) && (py_node_allocation != Py_None))
     {
-      build_node_rank_map(comm, py_node_allocation, node_rank_map);
+      build_node_rank_map(comm, py_node_allocation, gid_rank_map);
     }
 
   if (rank == root)
@@ -410,10 +479,10 @@ void ldbal_cell_attr_gen (MPI_Comm comm,
         {
           for (const auto& gid : attr_index_set)
             {
-              auto it = node_rank_map.find(gid);
-              if (it == node_rank_map.end())
+              auto it = gid_rank_map.find(gid);
+              if (it == gid_rank_map.end())
                 {
-                  node_rank_map[gid].insert(r);
+                  gid_rank_map[gid].insert(r);
                   r += 1;
                 }
               if ((unsigned int)size <= r) r=0;
@@ -424,9 +493,9 @@ void ldbal_cell_attr_gen (MPI_Comm comm,
   {
     vector<char> sendbuf;
     size_t sendbuf_size=0;
-    if ((rank == root) && (node_rank_map.size() > 0) )
+    if ((rank == root) && (gid_rank_map.size() > 0) )
       {
-        data::serialize_data(node_rank_map, sendbuf);
+        data::serialize_data(gid_rank_map, sendbuf);
         sendbuf_size = sendbuf.size();
       }
     
@@ -441,10 +510,10 @@ void ldbal_cell_attr_gen (MPI_Comm comm,
     
     if ((rank != root) && (sendbuf_size > 0))
       {
-        data::deserialize_data(sendbuf, node_rank_map);
+        data::deserialize_data(sendbuf, gid_rank_map);
       }
 
-    for (auto it = node_rank_map.begin(); it != node_rank_map.end(); it++)
+    for (auto it = gid_rank_map.begin(); it != gid_rank_map.end(); it++)
       {
         if (it->second.count((rank_t)rank) > 0) 
           local_count++;
@@ -461,6 +530,8 @@ void ldbal_cell_attr_gen (MPI_Comm comm,
 
     
   }
+
+  node_rank_map = data::NodeRankMap(gid_rank_map);
 }
 
 PyObject* PyStr_FromCString(const char *string)
@@ -650,6 +721,44 @@ void build_cell_attr_value_maps (PyObject *idx_values,
 }
 
 
+// Parses the name of a projection pointer read mode; returns false
+// if the name is not recognized
+bool py_get_ptr_read_mode (const char *name, ProjectionPtrReadMode& ptr_read_mode)
+{
+  string mode_name(name);
+  if (mode_name == "root")
+    {
+      ptr_read_mode = PtrReadRoot;
+      return true;
+    }
+  if (mode_name == "distributed")
+    {
+      ptr_read_mode = PtrReadDistributed;
+      return true;
+    }
+  return false;
+}
+
+
+// Parses the name of a projection block assignment strategy; returns
+// false if the name is not recognized
+bool py_get_block_assignment (const char *name, ProjectionBlockAssignment& block_assignment)
+{
+  string assignment_name(name);
+  if (assignment_name == "even")
+    {
+      block_assignment = BlockAssignEven;
+      return true;
+    }
+  if (assignment_name == "edges")
+    {
+      block_assignment = BlockAssignEdgeWeighted;
+      return true;
+    }
+  return false;
+}
+
+
 PyObject *py_build_edge_attribute_info (const vector< pair<string,string> >& prj_names,
                                         const vector <string>& edge_attr_name_spaces,
                                         const vector < map <string, vector < vector <string> > > >& edge_attr_name_vector)
@@ -1036,29 +1145,64 @@ void build_edge_maps (int rank, PyObject *py_edge_dict,
 }
 
 
-PyObject* py_build_tree_value(const CELL_IDX_T key, const neurotree_t &tree,
-                              const map <string, NamedAttrMap>& attr_maps,
-                              const bool topology, const bool validate)
+// Columns of a tree by neurotree_t element number; the arrays are
+// copies of the deques
+struct neurotree_columns
 {
-  const CELL_IDX_T idx = get<0>(tree);
-  throw_assert(idx == key,
-               "py_build_tree_value: tree index mismatch");
+  const neurotree_t &tree;
+
+  template <size_t N>
+  using value_type = typename tuple_element<N, neurotree_t>::type::value_type;
+
+  template <size_t N>
+  const deque< value_type<N> >& column() const
+  {
+    return get<N>(tree);
+  }
+
+  template <size_t N>
+  PyObject* array() const
+  {
+    return create_shared_array_from_deque< value_type<N> >(get<N>(tree));
+  }
+};
+
+// Columns of a tree in an arena; the arrays are views of the arena
+// buffer, which they keep alive
+struct tree_arena_columns
+{
+  shared_ptr<data::TreeArena> arena;
+  size_t pos;
+
+  template <size_t N>
+  using value_type = typename tuple_element<N, neurotree_t>::type::value_type;
+
+  template <size_t N>
+  AttrSpan< value_type<N> > column() const
+  {
+    return arena->values< value_type<N> >(N-1, pos);
+  }
+
+  template <size_t N>
+  PyObject* array() const
+  {
+    AttrSpan< value_type<N> > values = column<N>();
+    return create_shared_array_view< value_type<N> >(arena, const_cast< value_type<N>* >(values.begin()),
+                                                     values.size());
+  }
+};
 
-  if (validate)
-    {
-      cell::validate_tree(tree);
-    }
 
-  const deque<SECTION_IDX_T> & src_vector=get<1>(tree);
-  const deque<SECTION_IDX_T> & dst_vector=get<2>(tree);
-  const deque<SECTION_IDX_T> & sections=get<3>(tree);
-  const deque<COORD_T> & xcoords=get<4>(tree);
-  const deque<COORD_T> & ycoords=get<5>(tree);
-  const deque<COORD_T> & zcoords=get<6>(tree);
-  const deque<REALVAL_T> & radiuses=get<7>(tree);
-  const deque<LAYER_IDX_T> & layers=get<8>(tree);
-  const deque<PARENT_NODE_IDX_T> & parents=get<9>(tree);
-  const deque<SWC_TYPE_T> & swc_types=get<10>(tree);
+template <class TreeColumns>
+static PyObject* py_build_tree_columns(const CELL_IDX_T idx, const TreeColumns &tree,
+                                       const map <string, NamedAttrMap>& attr_maps,
+                                       const bool topology)
+{
+  const auto & src_vector=tree.template column<1>();
+  const auto & dst_vector=tree.template column<2>();
+  const auto & sections=tree.template column<3>();
+  const auto & xcoords=tree.template column<4>();
+  const auto & parents=tree.template column<9>();
                            
   size_t num_nodes = xcoords.size();
   npy_intp ind = 0;
@@ -1122,8 +1266,8 @@ PyObject* py_build_tree_value(const CELL_IDX_T key, const neurotree_t &tree,
       npy_intp topology_dims[1];
       topology_dims[0] = src_vector.size();
 
-      py_section_src = create_shared_array_from_deque<SECTION_IDX_T>(std::move(src_vector));
-      py_section_dst = create_shared_array_from_deque<SECTION_IDX_T>(std::move(dst_vector));
+      py_section_src = tree.template array<1>();
+      py_section_dst = tree.template array<2>();
       
       py_section_loc = create_typed_shared_array<uint32_t>(topology_dims[0]);
       NODE_IDX_T *section_loc_ptr = (NODE_IDX_T *)PyArray_GetPtr((PyArrayObject *)py_section_loc, &ind);
@@ -1186,13 +1330,13 @@ PyObject* py_build_tree_value(const CELL_IDX_T key, const neurotree_t &tree,
       npy_intp topology_dims[1];
       topology_dims[0] = src_vector.size();
       
-      py_section_src = create_shared_array_from_deque<SECTION_IDX_T>(std::move(src_vector));
-      py_section_dst = create_shared_array_from_deque<SECTION_IDX_T>(std::move(dst_vector));
+      py_section_src = tree.template array<1>();
+      py_section_dst = tree.template array<2>();
 
       npy_intp sections_dims[1];
       sections_dims[0] = sections.size();
       
-      py_sections = create_shared_array_from_deque<SECTION_IDX_T>(std::move(sections));
+      py_sections = tree.template array<3>();
     }
   
                            
@@ -1200,13 +1344,13 @@ PyObject* py_build_tree_value(const CELL_IDX_T key, const neurotree_t &tree,
   npy_intp dims[1];
   dims[0] = num_nodes;
 
-  PyObject *py_xcoords = create_shared_array_from_deque<COORD_T>(std::move(xcoords));
-  PyObject *py_ycoords = create_shared_array_from_deque<COORD_T>(std::move(ycoords));
-  PyObject *py_zcoords = create_shared_array_from_deque<COORD_T>(std::move(zcoords));
-  PyObject *py_radiuses = create_shared_array_from_deque<REALVAL_T>(std::move(radiuses));
-  PyObject *py_layers = create_shared_array_from_deque<LAYER_IDX_T>(std::move(layers));
-  PyObject *py_parents = create_shared_array_from_deque<PARENT_NODE_IDX_T>(std::move(parents));
-  PyObject *py_swc_types = create_shared_array_from_deque<SWC_TYPE_T>(std::move(swc_types));
+  PyObject *py_xcoords = tree.template array<4>();
+  PyObject *py_ycoords = tree.template array<5>();
+  PyObject *py_zcoords = tree.template array<6>();
+  PyObject *py_radiuses = tree.template array<7>();
+  PyObject *py_layers = tree.template array<8>();
+  PyObject *py_parents = tree.template array<9>();
+  PyObject *py_swc_types = tree.template array<10>();
   
   PyObject *py_treeval = PyDict_New();
   PyDict_SetItemString(py_treeval, "x", py_xcoords);
@@ -1263,7 +1407,7 @@ PyObject* py_build_tree_value(const CELL_IDX_T key, const neurotree_t &tree,
   for (auto const& attr_map_entry : attr_maps)
     {
       const string& attr_namespace  = attr_map_entry.first;
-      data::NamedAttrMap attr_map  = attr_map_entry.second;
+      const data::NamedAttrMap& attr_map  = attr_map_entry.second;
       vector <vector<string> > attr_names;
 
       attr_map.attr_names(attr_names);
@@ -1355,15 +1499,52 @@ PyObject* py_build_tree_value(const CELL_IDX_T key, const neurotree_t &tree,
   return py_treeval;
 }
 
+
+PyObject* py_build_tree_value(const CELL_IDX_T key, const neurotree_t &tree,
+                              const map <string, NamedAttrMap>& attr_maps,
+                              const bool topology, const bool validate)
+{
+  const CELL_IDX_T idx = get<0>(tree);
+  throw_assert(idx == key,
+               "py_build_tree_value: tree index mismatch");
+
+  if (validate)
+    {
+      cell::validate_tree(tree);
+    }
+
+  return py_build_tree_columns(idx, neurotree_columns { tree }, attr_maps, topology);
+}
+
+
+PyObject* py_build_tree_value(const CELL_IDX_T key, const shared_ptr<data::TreeArena> &arena, const size_t pos,
+                              const map <string, NamedAttrMap>& attr_maps,
+                              const bool topology, const bool validate)
+{
+  const CELL_IDX_T idx = arena->index[pos];
+  throw_assert(idx == key,
+               "py_build_tree_value: tree index mismatch");
+
+  if (validate)
+    {
+      cell::validate_tree(arena->tree(pos));
+    }
+
+  return py_build_tree_columns(idx, tree_arena_columns { arena, pos }, attr_maps, topology);
+}
+
 /* NeuroH5TreeIterState - in-memory tree iterator instance.
  *
  * seq_index: index of the next id in the sequence to yield
+ * tree_arena: if set, the trees are yielded from the arena instead
+ * of tree_list
  *
  */
 typedef struct {
   Py_ssize_t seq_index, count;
                            
   forward_list <neurotree_t> tree_list;
+  shared_ptr<data::TreeArena> tree_arena;
   vector<string> attr_name_spaces;
   map <string, NamedAttrMap> attr_maps;
   forward_list<neurotree_t>::const_iterator it_tree;
@@ -1394,7 +1575,27 @@ static void NeuroH5TreeIter_dealloc(PyNeuroH5TreeIterState *py_state)
 PyObject* NeuroH5TreeIter_iternext(PyObject *self)
 {
   PyNeuroH5TreeIterState *py_state = (PyNeuroH5TreeIterState *)self;
-  if (py_state->state->it_tree != py_state->state->tree_list.cend())
+  if (py_state->state->tree_arena)
+    {
+      if (py_state->state->seq_index < py_state->state->count)
+        {
+          const size_t pos = py_state->state->seq_index;
+          const CELL_IDX_T key = py_state->state->tree_arena->index[pos];
+          PyObject *treeval = py_build_tree_value(key, py_state->state->tree_arena, pos,
+                                                  py_state->state->attr_maps,
+                                                  py_state->state->topology_flag,
+                                                  py_state->state->validate_flag);
+          throw_assert(treeval != NULL,
+                       "NeuroH5TreeIter: invalid tree value");
+
+          py_state->state->seq_index++;
+
+          return Py_BuildValue("lN", key, treeval);
+        }
+      PyErr_SetNone(PyExc_StopIteration);
+      return NULL;
+    }
+  else if (py_state->state->it_tree != py_state->state->tree_list.cend())
     {
       const neurotree_t &tree = *(py_state->state->it_tree);
       const CELL_IDX_T key = get<0>(tree);
@@ -1489,6 +1690,38 @@ NeuroH5TreeIter_FromList(const forward_list <neurotree_t>& tree_list,
 
 
 
+static PyObject *
+NeuroH5TreeIter_FromArena(data::TreeArena&& tree_arena,
+                          const vector<string>& attr_name_spaces,
+                          const map <string, NamedAttrMap>& attr_maps,
+                          const bool topology_flag, const bool validate_flag)
+{
+
+  PyNeuroH5TreeIterState *p = PyObject_New(PyNeuroH5TreeIterState, &PyNeuroH5TreeIter_Type);
+  if (!p) return NULL;
+
+  if (!PyObject_Init((PyObject *)p, &PyNeuroH5TreeIter_Type))
+    {
+      Py_DECREF(p);
+      return NULL;
+    }
+
+  p->state = new NeuroH5TreeIterState();
+
+  p->state->seq_index     = 0;
+  p->state->count         = tree_arena.size();
+  p->state->tree_arena    = make_shared<data::TreeArena>(std::move(tree_arena));
+  p->state->attr_name_spaces = attr_name_spaces;
+  p->state->attr_maps  = attr_maps;
+  p->state->it_tree    = p->state->tree_list.cbegin();
+  p->state->topology_flag = topology_flag;
+  p->state->validate_flag = validate_flag;
+
+  return (PyObject *)p;
+}
+
+
+
 static PyObject *
 NeuroH5TreeIter_FromMap(const map<CELL_IDX_T, neurotree_t>& tree_map,
                         const vector<string>& attr_name_spaces,
@@ -1514,28 +1747,100 @@ NeuroH5TreeIter_FromMap(const map<CELL_IDX_T, neurotree_t>& tree_map,
 
 
 
+// The cell attribute builders below accept both the map and the
+// columnar attribute layouts
+static const set<CELL_IDX_T>& cell_attr_index(const NamedAttrMap& attr_map)
+{
+  return attr_map.index_set;
+}
+
+static const vector<CELL_IDX_T>& cell_attr_index(const NamedColumnarAttrMap& attr_map)
+{
+  return attr_map.index;
+}
+
+template <class T>
+static PyObject* py_cell_attr_value_array(const deque<T>& attr_value)
+{
+  return create_shared_array_from_deque<T>(attr_value);
+}
+
+template <class T>
+static PyObject* py_cell_attr_value_array(const AttrSpan<T>& attr_value)
+{
+  return create_shared_array_from_range<T>(attr_value.begin(), attr_value.size());
+}
+
+
+// Adds a (gid, ptr, value) tuple of arrays for each attribute of type T;
+// the arrays are views of the column, which is moved out of the map
+template <class T>
+static void py_build_cell_attr_columns_type(NamedColumnarAttrMap& attr_map,
+                                            const vector<string>& attr_names,
+                                            PyObject *py_attr_dict)
+{
+  vector< AttrColumn<T> >& columns = attr_map.attr_columns<T>();
+  for (size_t i=0; i<columns.size(); i++)
+    {
+      auto column = make_shared< AttrColumn<T> >(std::move(columns[i]));
+      PyObject *py_index = create_shared_array_view<CELL_IDX_T>(column, column->index.data(),
+                                                                column->index.size());
+      PyObject *py_ptr = create_shared_array_view<ATTR_PTR_T>(column, column->ptr.data(),
+                                                              column->ptr.size());
+      PyObject *py_value = create_shared_array_view<T>(column, column->values.data(),
+                                                       column->values.size());
+      PyObject *py_columns = PyTuple_Pack(3, py_index, py_ptr, py_value);
+      Py_DECREF(py_index);
+      Py_DECREF(py_ptr);
+      Py_DECREF(py_value);
+      
+      PyDict_SetItemString(py_attr_dict, attr_names[i].c_str(), py_columns);
+      Py_DECREF(py_columns);
+    }
+}
+
+static PyObject* py_build_cell_attr_columns(NamedColumnarAttrMap&& attr_map)
+{
+  vector<vector<string>> attr_names;
+  attr_map.attr_names(attr_names);
+
+  PyObject *py_attr_dict = PyDict_New();
+  py_build_cell_attr_columns_type<float>(attr_map, attr_names[AttrMap::attr_index_float], py_attr_dict);
+  py_build_cell_attr_columns_type<uint8_t>(attr_map, attr_names[AttrMap::attr_index_uint8], py_attr_dict);
+  py_build_cell_attr_columns_type<int8_t>(attr_map, attr_names[AttrMap::attr_index_int8], py_attr_dict);
+  py_build_cell_attr_columns_type<uint16_t>(attr_map, attr_names[AttrMap::attr_index_uint16], py_attr_dict);
+  py_build_cell_attr_columns_type<int16_t>(attr_map, attr_names[AttrMap::attr_index_int16], py_attr_dict);
+  py_build_cell_attr_columns_type<uint32_t>(attr_map, attr_names[AttrMap::attr_index_uint32], py_attr_dict);
+  py_build_cell_attr_columns_type<int32_t>(attr_map, attr_names[AttrMap::attr_index_int32], py_attr_dict);
+  attr_map.clear();
+
+  return py_attr_dict;
+}
+
+
+template <class NamedAttrMapT>
 PyObject* py_build_cell_attr_values_dict(const CELL_IDX_T key, 
-                                         const NamedAttrMap& attr_map,
+                                         const NamedAttrMapT& attr_map,
                                          const vector <vector<string> >& attr_names)
 {
   PyObject *py_attrval = PyDict_New();
   npy_intp dims[1];
   npy_intp ind = 0;
                            
-  const vector < deque <float>> &float_attrs      = attr_map.find<float>(key);
-  const vector < deque <uint8_t> > &uint8_attrs   = attr_map.find<uint8_t>(key);
-  const vector < deque <int8_t> > &int8_attrs     = attr_map.find<int8_t>(key);
-  const vector < deque <uint16_t> > &uint16_attrs = attr_map.find<uint16_t>(key);
-  const vector < deque <int16_t> > &int16_attrs   = attr_map.find<int16_t>(key);
-  const vector < deque <uint32_t> > &uint32_attrs = attr_map.find<uint32_t>(key);
-  const vector < deque <int32_t> > &int32_attrs   = attr_map.find<int32_t>(key);
+  const auto &float_attrs = attr_map.template find<float>(key);
+  const auto &uint8_attrs = attr_map.template find<uint8_t>(key);
+  const auto &int8_attrs = attr_map.template find<int8_t>(key);
+  const auto &uint16_attrs = attr_map.template find<uint16_t>(key);
+  const auto &int16_attrs = attr_map.template find<int16_t>(key);
+  const auto &uint32_attrs = attr_map.template find<uint32_t>(key);
+  const auto &int32_attrs = attr_map.template find<int32_t>(key);
                            
   for (size_t i=0; i<float_attrs.size(); i++)
     {
-      const deque<float> &attr_value = float_attrs[i];
+      const auto &attr_value = float_attrs[i];
       dims[0] = attr_value.size();
 
-      PyObject *py_value = create_shared_array_from_deque<float>(std::move(attr_value));                                   
+      PyObject *py_value = py_cell_attr_value_array(attr_value);                                   
                                    
       PyDict_SetItemString(py_attrval,
                            (attr_names[AttrMap::attr_index_float][i]).c_str(),
@@ -1545,10 +1850,10 @@ PyObject* py_build_cell_attr_values_dict(const CELL_IDX_T key,
 
   for (size_t i=0; i<uint8_attrs.size(); i++)
     {
-      const deque<uint8_t> &attr_value = uint8_attrs[i];
+      const auto &attr_value = uint8_attrs[i];
       dims[0] = attr_value.size();
 
-      PyObject *py_value = create_shared_array_from_deque<uint8_t>(std::move(attr_value));                                   
+      PyObject *py_value = py_cell_attr_value_array(attr_value);                                   
                                
       PyDict_SetItemString(py_attrval,
                            (attr_names[AttrMap::attr_index_uint8][i]).c_str(),
@@ -1558,10 +1863,10 @@ PyObject* py_build_cell_attr_values_dict(const CELL_IDX_T key,
                            
   for (size_t i=0; i<int8_attrs.size(); i++)
     {
-      const deque<int8_t> &attr_value = int8_attrs[i];
+      const auto &attr_value = int8_attrs[i];
       dims[0] = attr_value.size();
 
-      PyObject *py_value = create_shared_array_from_deque<int8_t>(std::move(attr_value));                                   
+      PyObject *py_value = py_cell_attr_value_array(attr_value);                                   
                                
       PyDict_SetItemString(py_attrval,
                            (attr_names[AttrMap::attr_index_int8][i]).c_str(),
@@ -1572,10 +1877,10 @@ PyObject* py_build_cell_attr_values_dict(const CELL_IDX_T key,
                            
   for (size_t i=0; i<uint16_attrs.size(); i++)
     {
-      const deque<uint16_t> &attr_value = uint16_attrs[i];
+      const auto &attr_value = uint16_attrs[i];
       dims[0] = attr_value.size();
 
-      PyObject *py_value = create_shared_array_from_deque<uint16_t>(std::move(attr_value));                                   
+      PyObject *py_value = py_cell_attr_value_array(attr_value);                                   
       
       PyDict_SetItemString(py_attrval,
                            (attr_names[AttrMap::attr_index_uint16][i]).c_str(),
@@ -1587,10 +1892,10 @@ PyObject* py_build_cell_attr_values_dict(const CELL_IDX_T key,
                            
   for (size_t i=0; i<int16_attrs.size(); i++)
     {
-      const deque<int16_t> &attr_value = int16_attrs[i];
+      const auto &attr_value = int16_attrs[i];
       dims[0] = attr_value.size();
 
-      PyObject *py_value = create_shared_array_from_deque<int16_t>(std::move(attr_value));                                   
+      PyObject *py_value = py_cell_attr_value_array(attr_value);                                   
                                
       PyDict_SetItemString(py_attrval,
                            (attr_names[AttrMap::attr_index_int16][i]).c_str(),
@@ -1601,10 +1906,10 @@ PyObject* py_build_cell_attr_values_dict(const CELL_IDX_T key,
 
   for (size_t i=0; i<uint32_attrs.size(); i++)
     {
-      const deque<uint32_t> &attr_value = uint32_attrs[i];
+      const auto &attr_value = uint32_attrs[i];
       dims[0] = attr_value.size();
 
-      PyObject *py_value = create_shared_array_from_deque<uint32_t>(std::move(attr_value));                                   
+      PyObject *py_value = py_cell_attr_value_array(attr_value);                                   
                                
       PyDict_SetItemString(py_attrval,
                            (attr_names[AttrMap::attr_index_uint32][i]).c_str(),
@@ -1615,10 +1920,10 @@ PyObject* py_build_cell_attr_values_dict(const CELL_IDX_T key,
                            
   for (size_t i=0; i<int32_attrs.size(); i++)
     {
-      const deque<int32_t> &attr_value = int32_attrs[i];
+      const auto &attr_value = int32_attrs[i];
       dims[0] = attr_value.size();
 
-      PyObject *py_value = create_shared_array_from_deque<int32_t>(std::move(attr_value));                                   
+      PyObject *py_value = py_cell_attr_value_array(attr_value);                                   
                                
       PyDict_SetItemString(py_attrval,
                            (attr_names[AttrMap::attr_index_int32][i]).c_str(),
@@ -1633,22 +1938,23 @@ PyObject* py_build_cell_attr_values_dict(const CELL_IDX_T key,
 
 
 
-PyObject* py_build_cell_attr_tuple_info(const NamedAttrMap& attr_map,
+template <class NamedAttrMapT>
+PyObject* py_build_cell_attr_tuple_info(const NamedAttrMapT& attr_map,
                                         const vector <vector<string> >& attr_names)
 {
     PyObject* py_tuple_fields_dict = PyDict_New();
     
-    if (attr_map.index_set.size() > 0)
+    if (cell_attr_index(attr_map).size() > 0)
       {
-        CELL_IDX_T key = *attr_map.index_set.begin();
+        CELL_IDX_T key = *cell_attr_index(attr_map).begin();
         
-        const vector < deque <float>> &float_attrs      = attr_map.find<float>(key);
-        const vector < deque <uint8_t> > &uint8_attrs   = attr_map.find<uint8_t>(key);
-        const vector < deque <int8_t> > &int8_attrs     = attr_map.find<int8_t>(key);
-        const vector < deque <uint16_t> > &uint16_attrs = attr_map.find<uint16_t>(key);
-        const vector < deque <int16_t> > &int16_attrs   = attr_map.find<int16_t>(key);
-        const vector < deque <uint32_t> > &uint32_attrs = attr_map.find<uint32_t>(key);
-        const vector < deque <int32_t> > &int32_attrs   = attr_map.find<int32_t>(key);
+        const auto &float_attrs = attr_map.template find<float>(key);
+        const auto &uint8_attrs = attr_map.template find<uint8_t>(key);
+        const auto &int8_attrs = attr_map.template find<int8_t>(key);
+        const auto &uint16_attrs = attr_map.template find<uint16_t>(key);
+        const auto &int16_attrs = attr_map.template find<int16_t>(key);
+        const auto &uint32_attrs = attr_map.template find<uint32_t>(key);
+        const auto &int32_attrs = attr_map.template find<int32_t>(key);
 
         size_t attr_pos = 0;
         for (size_t i=0; i<float_attrs.size(); i++)
@@ -1703,20 +2009,21 @@ PyObject* py_build_cell_attr_tuple_info(const NamedAttrMap& attr_map,
     return py_tuple_fields_dict;
 }
 
+template <class NamedAttrMapT>
 PyObject* py_build_cell_attr_values_tuple(const CELL_IDX_T key, 
-                                          const NamedAttrMap& attr_map,
+                                          const NamedAttrMapT& attr_map,
                                           const vector <vector<string> >& attr_names)
 {
   npy_intp dims[1];
   npy_intp ind = 0;
   
-  const vector < deque <float>> &float_attrs      = attr_map.find<float>(key);
-  const vector < deque <uint8_t> > &uint8_attrs   = attr_map.find<uint8_t>(key);
-  const vector < deque <int8_t> > &int8_attrs     = attr_map.find<int8_t>(key);
-  const vector < deque <uint16_t> > &uint16_attrs = attr_map.find<uint16_t>(key);
-  const vector < deque <int16_t> > &int16_attrs   = attr_map.find<int16_t>(key);
-  const vector < deque <uint32_t> > &uint32_attrs = attr_map.find<uint32_t>(key);
-  const vector < deque <int32_t> > &int32_attrs   = attr_map.find<int32_t>(key);
+  const auto &float_attrs = attr_map.template find<float>(key);
+  const auto &uint8_attrs = attr_map.template find<uint8_t>(key);
+  const auto &int8_attrs = attr_map.template find<int8_t>(key);
+  const auto &uint16_attrs = attr_map.template find<uint16_t>(key);
+  const auto &int16_attrs = attr_map.template find<int16_t>(key);
+  const auto &uint32_attrs = attr_map.template find<uint32_t>(key);
+  const auto &int32_attrs = attr_map.template find<int32_t>(key);
 
   size_t n_elements = 0;
   for (size_t i=0; i<attr_names.size(); i++)
@@ -1730,69 +2037,69 @@ PyObject* py_build_cell_attr_values_tuple(const CELL_IDX_T key,
   size_t attr_pos = 0;
   for (size_t i=0; i<float_attrs.size(); i++)
     {
-      const deque<float> &attr_value = float_attrs[i];
+      const auto &attr_value = float_attrs[i];
       dims[0] = attr_value.size();
 
-      PyObject *py_value = create_shared_array_from_deque<float>(std::move(attr_value));                                   
+      PyObject *py_value = py_cell_attr_value_array(attr_value);                                   
 
       PyTuple_SetItem(py_attrval, attr_pos++, py_value);
     }
 
   for (size_t i=0; i<uint8_attrs.size(); i++)
     {
-      const deque<uint8_t> &attr_value = uint8_attrs[i];
+      const auto &attr_value = uint8_attrs[i];
       dims[0] = attr_value.size();
 
-      PyObject *py_value = create_shared_array_from_deque<uint8_t>(std::move(attr_value));                                   
+      PyObject *py_value = py_cell_attr_value_array(attr_value);                                   
                                
       PyTuple_SetItem(py_attrval, attr_pos++, py_value);
     }
                            
   for (size_t i=0; i<int8_attrs.size(); i++)
     {
-      const deque<int8_t> &attr_value = int8_attrs[i];
+      const auto &attr_value = int8_attrs[i];
 
-      PyObject *py_value = create_shared_array_from_deque<int8_t>(std::move(attr_value));                                   
+      PyObject *py_value = py_cell_attr_value_array(attr_value);                                   
                                
       PyTuple_SetItem(py_attrval, attr_pos++, py_value);
     }
                            
   for (size_t i=0; i<uint16_attrs.size(); i++)
     {
-      const deque<uint16_t> &attr_value = uint16_attrs[i];
+      const auto &attr_value = uint16_attrs[i];
       dims[0] = attr_value.size();
 
-      PyObject *py_value = create_shared_array_from_deque<uint16_t>(std::move(attr_value));                                   
+      PyObject *py_value = py_cell_attr_value_array(attr_value);                                   
                                
       PyTuple_SetItem(py_attrval, attr_pos++, py_value);
     }
 
   for (size_t i=0; i<int16_attrs.size(); i++)
     {
-      const deque<int16_t> &attr_value = int16_attrs[i];
+      const auto &attr_value = int16_attrs[i];
       dims[0] = attr_value.size();
       
-      PyObject *py_value = create_shared_array_from_deque<int16_t>(std::move(attr_value));                                   
+      PyObject *py_value = py_cell_attr_value_array(attr_value);                                   
                                
       PyTuple_SetItem(py_attrval, attr_pos++, py_value);
     }
 
   for (size_t i=0; i<uint32_attrs.size(); i++)
     {
-      const deque<uint32_t> &attr_value = uint32_attrs[i];
+      const auto &attr_value = uint32_attrs[i];
       dims[0] = attr_value.size();
 
-      PyObject *py_value = create_shared_array_from_deque<uint32_t>(std::move(attr_value));                                   
+      PyObject *py_value = py_cell_attr_value_array(attr_value);                                   
                                
       PyTuple_SetItem(py_attrval, attr_pos++, py_value);
     }
                            
   for (size_t i=0; i<int32_attrs.size(); i++)
     {
-      const deque<int32_t> &attr_value = int32_attrs[i];
+      const auto &attr_value = int32_attrs[i];
       dims[0] = attr_value.size();
                                
-      PyObject *py_value = create_shared_array_from_deque<int32_t>(std::move(attr_value));
+      PyObject *py_value = py_cell_attr_value_array(attr_value);
       
       PyTuple_SetItem(py_attrval, attr_pos++, py_value);
     }
@@ -1801,7 +2108,8 @@ PyObject* py_build_cell_attr_values_tuple(const CELL_IDX_T key,
 }
 
 
-PyTypeObject* py_build_cell_attr_struct_type(const NamedAttrMap& attr_map,
+template <class NamedAttrMapT>
+PyTypeObject* py_build_cell_attr_struct_type(const NamedAttrMapT& attr_map,
                                              const vector <vector<string> >& attr_names,
                                              vector<PyStructSequence_Field> struct_descr_fields)
 {
@@ -1809,17 +2117,17 @@ PyTypeObject* py_build_cell_attr_struct_type(const NamedAttrMap& attr_map,
     
     PyTypeObject* structseq_type = NULL;
 
-    if (attr_map.index_set.size() > 0)
+    if (cell_attr_index(attr_map).size() > 0)
       {
-        CELL_IDX_T key = *attr_map.index_set.begin();
+        CELL_IDX_T key = *cell_attr_index(attr_map).begin();
         
-        const vector < deque <float>> &float_attrs      = attr_map.find<float>(key);
-        const vector < deque <uint8_t> > &uint8_attrs   = attr_map.find<uint8_t>(key);
-        const vector < deque <int8_t> > &int8_attrs     = attr_map.find<int8_t>(key);
-        const vector < deque <uint16_t> > &uint16_attrs = attr_map.find<uint16_t>(key);
-        const vector < deque <int16_t> > &int16_attrs   = attr_map.find<int16_t>(key);
-        const vector < deque <uint32_t> > &uint32_attrs = attr_map.find<uint32_t>(key);
-        const vector < deque <int32_t> > &int32_attrs   = attr_map.find<int32_t>(key);
+        const auto &float_attrs = attr_map.template find<float>(key);
+        const auto &uint8_attrs = attr_map.template find<uint8_t>(key);
+        const auto &int8_attrs = attr_map.template find<int8_t>(key);
+        const auto &uint16_attrs = attr_map.template find<uint16_t>(key);
+        const auto &int16_attrs = attr_map.template find<int16_t>(key);
+        const auto &uint32_attrs = attr_map.template find<uint32_t>(key);
+        const auto &int32_attrs = attr_map.template find<int32_t>(key);
 
         for (size_t i=0; i<float_attrs.size(); i++)
           {
@@ -1883,8 +2191,9 @@ PyTypeObject* py_build_cell_attr_struct_type(const NamedAttrMap& attr_map,
 }
 
 
+template <class NamedAttrMapT>
 PyObject* py_build_cell_attr_values_struct(const CELL_IDX_T key, 
-                                           const NamedAttrMap& attr_map,
+                                           const NamedAttrMapT& attr_map,
                                            const vector <vector<string> >& attr_names,
                                            PyTypeObject* struct_type)
 {
@@ -1896,81 +2205,81 @@ PyObject* py_build_cell_attr_values_struct(const CELL_IDX_T key,
   PyObject* py_attrval = PyStructSequence_New(struct_type);
   throw_assert_nomsg(py_attrval != NULL);
   
-  const vector < deque <float>> &float_attrs      = attr_map.find<float>(key);
-  const vector < deque <uint8_t> > &uint8_attrs   = attr_map.find<uint8_t>(key);
-  const vector < deque <int8_t> > &int8_attrs     = attr_map.find<int8_t>(key);
-  const vector < deque <uint16_t> > &uint16_attrs = attr_map.find<uint16_t>(key);
-  const vector < deque <int16_t> > &int16_attrs   = attr_map.find<int16_t>(key);
-  const vector < deque <uint32_t> > &uint32_attrs = attr_map.find<uint32_t>(key);
-  const vector < deque <int32_t> > &int32_attrs   = attr_map.find<int32_t>(key);
+  const auto &float_attrs = attr_map.template find<float>(key);
+  const auto &uint8_attrs = attr_map.template find<uint8_t>(key);
+  const auto &int8_attrs = attr_map.template find<int8_t>(key);
+  const auto &uint16_attrs = attr_map.template find<uint16_t>(key);
+  const auto &int16_attrs = attr_map.template find<int16_t>(key);
+  const auto &uint32_attrs = attr_map.template find<uint32_t>(key);
+  const auto &int32_attrs = attr_map.template find<int32_t>(key);
 
   size_t attr_pos = 0;
   for (size_t i=0; i<float_attrs.size(); i++)
     {
-      const deque<float> &attr_value = float_attrs[i];
+      const auto &attr_value = float_attrs[i];
       dims[0] = attr_value.size();
 
-      PyObject *py_value = create_shared_array_from_deque<float>(std::move(attr_value));                                   
+      PyObject *py_value = py_cell_attr_value_array(attr_value);                                   
 
       PyStructSequence_SetItem(py_attrval, attr_pos++, py_value);
     }
 
   for (size_t i=0; i<uint8_attrs.size(); i++)
     {
-      const deque<uint8_t> &attr_value = uint8_attrs[i];
+      const auto &attr_value = uint8_attrs[i];
       dims[0] = attr_value.size();
       
-      PyObject *py_value = create_shared_array_from_deque<uint8_t>(std::move(attr_value));                                   
+      PyObject *py_value = py_cell_attr_value_array(attr_value);                                   
                                
       PyStructSequence_SetItem(py_attrval, attr_pos++, py_value);
     }
                            
   for (size_t i=0; i<int8_attrs.size(); i++)
     {
-      const deque<int8_t> &attr_value = int8_attrs[i];
+      const auto &attr_value = int8_attrs[i];
       dims[0] = attr_value.size();
 
-      PyObject *py_value = create_shared_array_from_deque<int8_t>(std::move(attr_value));                                   
+      PyObject *py_value = py_cell_attr_value_array(attr_value);                                   
                                
       PyStructSequence_SetItem(py_attrval, attr_pos++, py_value);
     }
                            
   for (size_t i=0; i<uint16_attrs.size(); i++)
     {
-      const deque<uint16_t> &attr_value = uint16_attrs[i];
+      const auto &attr_value = uint16_attrs[i];
       dims[0] = attr_value.size();
 
-      PyObject *py_value = create_shared_array_from_deque<uint16_t>(std::move(attr_value));                                   
+      PyObject *py_value = py_cell_attr_value_array(attr_value);                                   
                                
       PyStructSequence_SetItem(py_attrval, attr_pos++, py_value);
     }
 
   for (size_t i=0; i<int16_attrs.size(); i++)
     {
-      const deque<int16_t> &attr_value = int16_attrs[i];
+      const auto &attr_value = int16_attrs[i];
       dims[0] = attr_value.size();
 
-      PyObject *py_value = create_shared_array_from_deque<int16_t>(std::move(attr_value));                                   
+      PyObject *py_value = py_cell_attr_value_array(attr_value);                                   
                                
       PyStructSequence_SetItem(py_attrval, attr_pos++, py_value);
     }
 
   for (size_t i=0; i<uint32_attrs.size(); i++)
     {
-      const deque<uint32_t> &attr_value = uint32_attrs[i];
+      const auto &attr_value = uint32_attrs[i];
       dims[0] = attr_value.size();
 
-      PyObject *py_value = create_shared_array_from_deque<uint32_t>(std::move(attr_value));                                   
+      PyObject *py_value = py_cell_attr_value_array(attr_value);                                   
                                
       PyStructSequence_SetItem(py_attrval, attr_pos++, py_value);
     }
                            
   for (size_t i=0; i<int32_attrs.size(); i++)
     {
-      const deque<int32_t> &attr_value = int32_attrs[i];
+      const auto &attr_value = int32_attrs[i];
       dims[0] = attr_value.size();
 
-      PyObject *py_value = create_shared_array_from_deque<int32_t>(std::move(attr_value));                                   
+      PyObject *py_value = py_cell_attr_value_array(attr_value);                                   
                                
       PyStructSequence_SetItem(py_attrval, attr_pos++, py_value);
     }
@@ -2625,66 +2934,431 @@ NeuroH5EdgeIter_FromMap(const edge_map_t& prj_edge_map,
 }
 
 
-
-extern "C"
+/* Background HDF5 work: the blocks prefetched by the read generators
+   and the appends submitted with asynchronous=True are executed in
+   submission order by a single worker thread, each on its own duplicate
+   communicator. Since all ranks submit collective work in the same
+   order, the collective calls made by the worker threads match each
+   other. The HDF5 library does not need to be thread-safe: every other
+   function of this module that calls HDF5 first waits until the queue
+   is empty (background_io_drain), so that HDF5 is only ever called by
+   one thread of the process at a time. HDF5 calls made outside of this
+   module, e.g. through h5py, are not serialized with the worker. */
+class BackgroundQueue
 {
+public:
+  /* A task is passed true if an earlier task has returned an error
+     that has not been cleared, in which case appends release their
+     resources without running; it returns its own error, if any */
+  typedef std::function<std::exception_ptr(bool)> Task;
 
-  
-  static PyObject *py_read_graph (PyObject *self, PyObject *args, PyObject *kwds)
+  ~BackgroundQueue()
   {
-    int status;
-    vector < map <string, vector < vector <string> > > > edge_attr_name_vector;
-    vector<edge_map_t> prj_vector;
-    vector< pair<string,string> > prj_names;
-    char *input_file_name;
-    PyObject *py_attr_name_spaces=NULL;
-    PyObject *py_comm = NULL;
-    MPI_Comm *comm_ptr  = NULL;
-    size_t total_num_nodes, total_num_edges = 0, local_num_edges = 0;
-
-    static const char *kwlist[] = {
-                                   "file_name",
-                                   "namespaces",
-                                   "comm",
-                                   NULL};
+    if (worker.joinable())
+      {
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          stop = true;
+        }
+        cond.notify_all();
+        worker.join();
+      }
+  }
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "s|OO", (char **)kwlist,
-                                     &input_file_name,
-                                     &py_attr_name_spaces,
-                                     &py_comm))
-      return NULL;
+  /* Blocks until at most max_pending tasks are queued or running */
+  void wait(size_t max_pending)
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    cond.wait(lock, [this, max_pending] ()
+              { return (tasks.size() + (busy ? 1 : 0)) <= max_pending; });
+  }
 
-    PyObject *py_prj_dict = PyDict_New();
-    MPI_Comm comm;
+  void submit(Task task)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      tasks.push_back(std::move(task));
+      if (!worker.joinable())
+        {
+          worker = std::thread(&BackgroundQueue::run, this);
+        }
+    }
+    cond.notify_all();
+  }
 
-    if ((py_comm != NULL) && (py_comm != Py_None))
-      {
-        comm_ptr = PyMPIComm_Get(py_comm);
-        throw_assert(comm_ptr != NULL,
-                     "py_read_graph: invalid MPI communicator");
-        throw_assert(*comm_ptr != MPI_COMM_NULL,
-                     "py_read_graph: invalid MPI communicator");
-        status = MPI_Comm_dup(*comm_ptr, &comm);
-        throw_assert(status == MPI_SUCCESS,
-                     "py_read_graph: unable to duplicate MPI communicator");
-      }
-    else
-      {
-        status = MPI_Comm_dup(MPI_COMM_WORLD, &comm);
-        throw_assert(status == MPI_SUCCESS,
-                     "py_read_graph: unable to duplicate MPI communicator");
+  /* Returns the first error returned by a task */
+  std::exception_ptr pending_error()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return error;
+  }
 
-      }
+  /* Returns and clears the error; only called when no tasks are
+   * pending, so that all ranks clear the same error */
+  std::exception_ptr take_error()
+  {
+    std::exception_ptr e;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      std::swap(e, error);
+    }
+    return e;
+  }
 
-    vector <string> edge_attr_name_spaces;
-    // Create C++ vector of namespace strings:
-    if (py_attr_name_spaces != NULL)
+private:
+  void run()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
       {
-        for (size_t i = 0; (Py_ssize_t)i < PyList_Size(py_attr_name_spaces); i++)
+        cond.wait(lock, [this] () { return stop || !tasks.empty(); });
+        if (tasks.empty())
+          break;
+        Task task = std::move(tasks.front());
+        tasks.pop_front();
+        busy = true;
+        const bool discard = (bool)error;
+        lock.unlock();
+        std::exception_ptr e = task(discard);
+        lock.lock();
+        if (e && !error)
           {
-            PyObject *pyval = PyList_GetItem(py_attr_name_spaces, (Py_ssize_t)i);
-            const char *str = PyStr_ToCString (pyval);
-            edge_attr_name_spaces.push_back(string(str));
+            error = e;
+          }
+        busy = false;
+        cond.notify_all();
+      }
+  }
+
+  std::mutex mutex;
+  std::condition_variable cond;
+  std::deque<Task> tasks;
+  bool busy = false, stop = false;
+  std::exception_ptr error;
+  std::thread worker;
+};
+
+static BackgroundQueue background_queue;
+
+
+/* Waits with the GIL released until all background work submitted on
+   this rank has completed */
+static void background_io_drain()
+{
+  Py_BEGIN_ALLOW_THREADS
+  background_queue.wait(0);
+  Py_END_ALLOW_THREADS
+}
+
+
+/* Module functions that call HDF5 are entered through this wrapper,
+   which waits for the background work of this rank first */
+template<PyObject *(*F)(PyObject *, PyObject *, PyObject *)>
+static PyObject *
+py_after_background_io(PyObject *self, PyObject *args, PyObject *kwds)
+{
+  background_io_drain();
+  return F(self, args, kwds);
+}
+
+
+/* NeuroH5 file session */
+
+typedef struct {
+  PyObject_HEAD
+  neuroh5::File *file;
+} PyNeuroH5FileState;
+
+
+static void
+NeuroH5File_dealloc(PyNeuroH5FileState *self)
+{
+  background_io_drain();
+  delete self->file;
+  Py_TYPE(self)->tp_free(self);
+}
+
+
+static PyObject *
+NeuroH5File_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+  char *file_name;
+  PyObject *py_comm = NULL;
+  int collective = 0;
+  MPI_Comm comm = MPI_COMM_WORLD;
+
+  static const char *kwlist[] = {
+                                 "file_name",
+                                 "comm",
+                                 "collective",
+                                 NULL};
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "s|Oi", (char **)kwlist,
+                                   &file_name, &py_comm, &collective))
+    return NULL;
+
+  if ((py_comm != NULL) && (py_comm != Py_None))
+    {
+      MPI_Comm *comm_ptr = PyMPIComm_Get(py_comm);
+      throw_assert(comm_ptr != NULL,
+                   "NeuroH5File: invalid MPI communicator");
+      throw_assert(*comm_ptr != MPI_COMM_NULL,
+                   "NeuroH5File: invalid MPI communicator");
+      comm = *comm_ptr;
+    }
+
+  PyNeuroH5FileState *self = (PyNeuroH5FileState *)type->tp_alloc(type, 0);
+  if (!self) return NULL;
+
+  background_io_drain();
+  self->file = new neuroh5::File(comm, string(file_name), collective > 0);
+
+  return (PyObject *)self;
+}
+
+
+static PyObject *
+NeuroH5File_close(PyNeuroH5FileState *self, PyObject *args)
+{
+  background_io_drain();
+  if (self->file != NULL)
+    {
+      self->file->close();
+    }
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+
+
+static PyObject *
+NeuroH5File_invalidate(PyNeuroH5FileState *self, PyObject *args)
+{
+  background_io_drain();
+  if (self->file != NULL)
+    {
+      self->file->invalidate();
+    }
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+
+
+static PyObject *
+NeuroH5File_enter(PyNeuroH5FileState *self, PyObject *args)
+{
+  Py_INCREF(self);
+  return (PyObject *)self;
+}
+
+
+static PyObject *
+NeuroH5File_exit(PyNeuroH5FileState *self, PyObject *args)
+{
+  return NeuroH5File_close(self, NULL);
+}
+
+
+static PyMethodDef NeuroH5File_methods[] = {
+  { "close", (PyCFunction)NeuroH5File_close, METH_NOARGS,
+    "Closes the file; collective on the communicator of the session." },
+  { "invalidate", (PyCFunction)NeuroH5File_invalidate, METH_NOARGS,
+    "Discards the cached metadata of the session." },
+  { "__enter__", (PyCFunction)NeuroH5File_enter, METH_NOARGS, NULL },
+  { "__exit__", (PyCFunction)NeuroH5File_exit, METH_VARARGS, NULL },
+  { NULL, NULL, 0, NULL }
+};
+
+
+static PyTypeObject PyNeuroH5File_Type = {
+  PyVarObject_HEAD_INIT(&PyType_Type, 0)
+  "File",                    /*tp_name*/
+  sizeof(PyNeuroH5FileState), /*tp_basicsize*/
+  0,                         /*tp_itemsize*/
+  (destructor)NeuroH5File_dealloc, /* tp_dealloc */
+  0,                         /*tp_print*/
+  0,                         /*tp_getattr*/
+  0,                         /*tp_setattr*/
+  0,                         /*tp_compare*/
+  0,                         /*tp_repr*/
+  0,                         /*tp_as_number*/
+  0,                         /*tp_as_sequence*/
+  0,                         /*tp_as_mapping*/
+  0,                         /*tp_hash */
+  0,                         /*tp_call*/
+  0,                         /*tp_str*/
+  0,                         /*tp_getattro*/
+  0,                         /*tp_setattro*/
+  0,                         /*tp_as_buffer*/
+  Py_TPFLAGS_DEFAULT,
+  "File(file_name, comm=None, collective=False)\n"
+  "NeuroH5 file session. The file is kept open and the metadata read\n"
+  "through the session is cached; may be passed in place of a file name\n"
+  "to read_population_names, read_population_ranges and\n"
+  "read_projection_names.", /* tp_doc */
+  0,                         /* tp_traverse */
+  0,                         /* tp_clear */
+  0,                         /* tp_richcompare */
+  0,                         /* tp_weaklistoffset */
+  0,                         /* tp_iter */
+  0,                         /* tp_iternext */
+  NeuroH5File_methods,       /* tp_methods */
+  0,                         /* tp_members */
+  0,                         /* tp_getset */
+  0,                         /* tp_base */
+  0,                         /* tp_dict */
+  0,                         /* tp_descr_get */
+  0,                         /* tp_descr_set */
+  0,                         /* tp_dictoffset */
+  0,                         /* tp_init */
+  PyType_GenericAlloc,       /* tp_alloc */
+  NeuroH5File_new,           /* tp_new */
+};
+
+
+/* Returns the session if the argument is a File object, and NULL
+   otherwise, in which case the argument must be a file name string */
+static neuroh5::File *
+py_get_file(PyObject *py_file, string& file_name)
+{
+  if (PyObject_TypeCheck(py_file, &PyNeuroH5File_Type))
+    {
+      neuroh5::File *file = ((PyNeuroH5FileState *)py_file)->file;
+      throw_assert(file != NULL && file->is_open(),
+                   "NeuroH5File: file session is closed");
+      file_name = file->file_name();
+      return file;
+    }
+  throw_assert(PyStr_Check(py_file),
+               "file name must be a string or File object");
+  file_name = string(PyStr_ToCString(py_file));
+  return NULL;
+}
+
+
+
+/* Builds a filter configuration from the filters argument of the
+   write functions: either a specification string such as
+   "value=delta,deflate:4", a sequence of such strings, or a dict that
+   maps a role (index, pointer, value or all) to a filter list such as
+   "shuffle,deflate:4". None selects the default configuration. */
+static FilterConfig
+py_get_filter_config(PyObject *py_filters)
+{
+  FilterConfig config = neuroh5::hdf5::default_filter_config();
+  if ((py_filters == NULL) || (py_filters == Py_None))
+    {
+      return config;
+    }
+  if (PyStr_Check(py_filters))
+    {
+      neuroh5::hdf5::parse_filter_spec(string(PyStr_ToCString(py_filters)), config);
+    }
+  else if (PyDict_Check(py_filters))
+    {
+      PyObject *py_role, *py_spec;
+      Py_ssize_t pos = 0;
+      while (PyDict_Next(py_filters, &pos, &py_role, &py_spec))
+        {
+          throw_assert(PyStr_Check(py_role) && PyStr_Check(py_spec),
+                       "filters: dictionary keys and values must be strings");
+          neuroh5::hdf5::parse_filter_spec(string(PyStr_ToCString(py_role)) + "=" +
+                                           string(PyStr_ToCString(py_spec)), config);
+        }
+    }
+  else
+    {
+      PyObject *py_seq = PySequence_Fast(py_filters, "filters: invalid filter specification");
+      throw_assert(py_seq != NULL, "filters: invalid filter specification");
+      for (Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(py_seq); i++)
+        {
+          PyObject *py_spec = PySequence_Fast_GET_ITEM(py_seq, i);
+          throw_assert(PyStr_Check(py_spec),
+                       "filters: filter specification must be a string");
+          neuroh5::hdf5::parse_filter_spec(string(PyStr_ToCString(py_spec)), config);
+        }
+      Py_DECREF(py_seq);
+    }
+  return config;
+}
+
+
+
+extern "C"
+{
+
+  
+  static PyObject *py_read_graph (PyObject *self, PyObject *args, PyObject *kwds)
+  {
+    int status;
+    vector < map <string, vector < vector <string> > > > edge_attr_name_vector;
+    vector<edge_map_t> prj_vector;
+    vector< pair<string,string> > prj_names;
+    char *input_file_name;
+    PyObject *py_attr_name_spaces=NULL;
+    PyObject *py_comm = NULL;
+    MPI_Comm *comm_ptr  = NULL;
+    size_t total_num_nodes, total_num_edges = 0, local_num_edges = 0;
+    char *ptr_read_mode_name = NULL, *block_assignment_name = NULL;
+    ProjectionPtrReadMode ptr_read_mode = PtrReadRoot;
+    ProjectionBlockAssignment block_assignment = BlockAssignEven;
+
+    static const char *kwlist[] = {
+                                   "file_name",
+                                   "namespaces",
+                                   "comm",
+                                   "ptr_read_mode",
+                                   "block_assignment",
+                                   NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "s|OOss", (char **)kwlist,
+                                     &input_file_name,
+                                     &py_attr_name_spaces,
+                                     &py_comm, &ptr_read_mode_name,
+                                     &block_assignment_name))
+      return NULL;
+
+    if (ptr_read_mode_name != NULL)
+      {
+        throw_assert(py_get_ptr_read_mode(ptr_read_mode_name, ptr_read_mode),
+                     "py_read_graph: invalid ptr_read_mode " << ptr_read_mode_name);
+      }
+    if (block_assignment_name != NULL)
+      {
+        throw_assert(py_get_block_assignment(block_assignment_name, block_assignment),
+                     "py_read_graph: invalid block_assignment " << block_assignment_name);
+      }
+
+    PyObject *py_prj_dict = PyDict_New();
+    MPI_Comm comm;
+
+    if ((py_comm != NULL) && (py_comm != Py_None))
+      {
+        comm_ptr = PyMPIComm_Get(py_comm);
+        throw_assert(comm_ptr != NULL,
+                     "py_read_graph: invalid MPI communicator");
+        throw_assert(*comm_ptr != MPI_COMM_NULL,
+                     "py_read_graph: invalid MPI communicator");
+        status = MPI_Comm_dup(*comm_ptr, &comm);
+        throw_assert(status == MPI_SUCCESS,
+                     "py_read_graph: unable to duplicate MPI communicator");
+      }
+    else
+      {
+        status = MPI_Comm_dup(MPI_COMM_WORLD, &comm);
+        throw_assert(status == MPI_SUCCESS,
+                     "py_read_graph: unable to duplicate MPI communicator");
+
+      }
+
+    vector <string> edge_attr_name_spaces;
+    // Create C++ vector of namespace strings:
+    if (py_attr_name_spaces != NULL)
+      {
+        for (size_t i = 0; (Py_ssize_t)i < PyList_Size(py_attr_name_spaces); i++)
+          {
+            PyObject *pyval = PyList_GetItem(py_attr_name_spaces, (Py_ssize_t)i);
+            const char *str = PyStr_ToCString (pyval);
+            edge_attr_name_spaces.push_back(string(str));
           }
       }
 
@@ -2694,7 +3368,8 @@ extern "C"
 
     graph::read_graph(comm, std::string(input_file_name), edge_attr_name_spaces,
                       prj_names, prj_vector, edge_attr_name_vector,
-                      total_num_nodes, local_num_edges, total_num_edges);
+                      total_num_nodes, local_num_edges, total_num_edges,
+                      ptr_read_mode, block_assignment);
     status = MPI_Comm_free(&comm);
     throw_assert(status == MPI_SUCCESS,
                  "py_read_graph: unable to free MPI communicator");
@@ -2745,7 +3420,7 @@ extern "C"
     PyObject *py_node_allocation=NULL;
     PyObject *py_attr_name_spaces=NULL;
     PyObject *py_prj_names=NULL;
-    node_rank_map_t node_rank_map;
+    data::NodeRankMap node_rank_map;
     vector < edge_map_t > prj_vector;
     vector < map <string, vector < vector<string> > > > edge_attr_name_vector;
     pop_range_map_t pop_ranges;
@@ -2757,6 +3432,10 @@ extern "C"
     
     char *input_file_name;
     size_t local_num_nodes = 0, total_num_nodes = 0, total_num_edges = 0, local_num_edges = 0;
+    char *ptr_read_mode_name = NULL, *block_assignment_name = NULL;
+    ProjectionPtrReadMode ptr_read_mode = PtrReadRoot;
+    ProjectionBlockAssignment block_assignment = BlockAssignEven;
+    unsigned long pipeline_depth = 0;
     
     static const char *kwlist[] = {
                                    "file_name",
@@ -2766,15 +3445,31 @@ extern "C"
                                    "namespaces",
                                    "map_type",
                                    "io_size",
+                                   "ptr_read_mode",
+                                   "block_assignment",
+                                   "pipeline_depth",
                                    NULL};
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "s|OOOOik", (char **)kwlist,
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "s|OOOOikssk", (char **)kwlist,
                                      &input_file_name, &py_comm, 
                                      &py_node_allocation, &py_prj_names,
                                      &py_attr_name_spaces,
-                                     &opt_edge_map_type, &io_size))
+                                     &opt_edge_map_type, &io_size,
+                                     &ptr_read_mode_name, &block_assignment_name,
+                                     &pipeline_depth))
       return NULL;
 
+    if (ptr_read_mode_name != NULL)
+      {
+        throw_assert(py_get_ptr_read_mode(ptr_read_mode_name, ptr_read_mode),
+                     "py_scatter_read_graph: invalid ptr_read_mode " << ptr_read_mode_name);
+      }
+    if (block_assignment_name != NULL)
+      {
+        throw_assert(py_get_block_assignment(block_assignment_name, block_assignment),
+                     "py_scatter_read_graph: invalid block_assignment " << block_assignment_name);
+      }
+
     MPI_Comm comm;
 
     if ((py_comm != NULL) && (py_comm != Py_None))
@@ -2850,22 +3545,21 @@ extern "C"
     // Create C++ map for node_rank_map:
     if ((py_node_allocation != NULL) && (py_node_allocation != Py_None))
       {
-        build_node_rank_map(comm, py_node_allocation, node_rank_map);
+        build_scatter_node_rank_map(comm, py_node_allocation, 0, total_num_nodes,
+                                    node_rank_map);
       }
     else
       {
-        // round-robin node to rank assignment from file
-        for (size_t i = 0; i < total_num_nodes; i++)
-          {
-            node_rank_map[i].insert(i%size);
-          }
+        // round-robin node to rank assignment
+        node_rank_map = data::NodeRankMap::round_robin(size, 0, total_num_nodes);
       }
 
     graph::scatter_read_graph(comm, edge_map_type, std::string(input_file_name),
                               io_size, edge_attr_name_spaces, prj_names, node_rank_map,
                               prj_vector, edge_attr_name_vector,
                               local_num_nodes, total_num_nodes,
-                              local_num_edges, total_num_edges);
+                              local_num_edges, total_num_edges,
+                              ptr_read_mode, block_assignment, pipeline_depth);
     status = MPI_Comm_free(&comm);
     throw_assert(status == MPI_SUCCESS,
                  "py_read_graph: unable to free MPI communicator");
@@ -3352,6 +4046,8 @@ extern "C"
     unsigned long io_size = 0;
     const unsigned long default_chunk_size = 4000;
     unsigned long chunk_size = default_chunk_size;
+    int opt_build_index = 0;
+    PyObject *py_filters = NULL;
     
     static const char *kwlist[] = {
                                    "file_name",
@@ -3361,12 +4057,17 @@ extern "C"
                                    "comm",
                                    "io_size",
                                    "chunk_size",
+                                   "build_index",
+                                   "filters",
                                    NULL};
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "sssO|Okk", (char **)kwlist,
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "sssO|OkkiO", (char **)kwlist,
                                      &file_name_arg, &src_pop_name_arg, &dst_pop_name_arg,
-                                     &edge_values, &py_comm, &io_size, &chunk_size))
+                                     &edge_values, &py_comm, &io_size, &chunk_size,
+                                     &opt_build_index, &py_filters))
       return NULL;
+
+    const FilterConfig filters = py_get_filter_config(py_filters);
     MPI_Comm comm;
 
     if ((py_comm != NULL) && (py_comm != Py_None))
@@ -3432,7 +4133,8 @@ extern "C"
         build_edge_map(edge_values, edge_attr_index, edge_map);
         
         status = graph::write_graph(data_comm, io_size, file_name, src_pop_name, dst_pop_name,
-                                    edge_attr_index, edge_map, chunk_size);
+                                    edge_attr_index, edge_map, chunk_size,
+                                    opt_build_index > 0, filters);
         throw_assert(status >= 0,
                      "py_write_graph: unable to write graph");
       }
@@ -3465,6 +4167,8 @@ extern "C"
     unsigned long io_size = 0;
     const unsigned long default_chunk_size = 4000;
     unsigned long chunk_size = default_chunk_size;
+    PyObject *py_filters = NULL;
+    int subfile = 0;
         
     static const char *kwlist[] = {
                                    "file_name",
@@ -3472,13 +4176,19 @@ extern "C"
                                    "comm",
                                    "io_size",
                                    "chunk_size",
+                                   "filters",
+                                   "subfile",
                                    NULL};
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "sO|Okk", (char **)kwlist,
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "sO|OkkOi", (char **)kwlist,
                                      &file_name_arg, &py_edge_dict,
-                                     &py_comm, &io_size, &chunk_size))
+                                     &py_comm, &io_size, &chunk_size, &py_filters,
+                                     &subfile))
       return NULL;
 
+    const FilterConfig filters = py_get_filter_config(py_filters);
+    const WriteMode write_mode = (subfile > 0) ? WriteSubfile : WriteShared;
+
     MPI_Comm comm;
 
     if ((py_comm != NULL) && (py_comm != Py_None))
@@ -3548,7 +4258,8 @@ extern "C"
                 const edge_map_t & edge_map = edge_map_item.second.second; 
 
                 status = graph::append_graph(data_comm, io_size, file_name, src_pop_name, dst_pop_name,
-                                             edge_attr_index, edge_map, chunk_size);
+                                             edge_attr_index, edge_map, chunk_size, filters,
+                                             write_mode);
                 throw_assert(status >= 0,
                              "py_append_graph: unable to append projection");
                 
@@ -3582,8 +4293,9 @@ extern "C"
     "Returns the names of all populations for which attributes exist in the given file.\n"
     "Parameters\n"
     "----------\n"
-    "file_name : string\n"
+    "file_name : string or File\n"
     "    The NeuroH5 file to read.\n"
+    "    If a File session is given, the result is cached in the session.\n"
     "    \n"
     "    .. warning::\n"
     "       The given file must be a valid HDF5 file that contains /H5Types and /Populations groups.\n"
@@ -3602,7 +4314,7 @@ extern "C"
   static PyObject *py_read_population_names (PyObject *self, PyObject *args, PyObject *kwds)
   {
     int status; 
-    char *input_file_name;
+    PyObject *py_file = NULL;
     PyObject *py_comm = NULL;
     MPI_Comm *comm_ptr  = NULL;
 
@@ -3611,10 +4323,13 @@ extern "C"
                                    "comm",
                                    NULL};
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "s|O", (char **)kwlist,
-                                     &input_file_name, &py_comm))
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", (char **)kwlist,
+                                     &py_file, &py_comm))
       return NULL;
 
+    string input_file_name;
+    File *file = py_get_file(py_file, input_file_name);
+
     MPI_Comm comm;
 
     if ((py_comm != NULL) && (py_comm != Py_None))
@@ -3644,7 +4359,14 @@ extern "C"
                  "py_read_population_names: unable to obtain rank of MPI communicator");
 
     vector <string> pop_names;
-    status = cell::read_population_names(comm, input_file_name, pop_names);
+    if (file != NULL)
+      {
+        status = cell::read_population_names(*file, pop_names);
+      }
+    else
+      {
+        status = cell::read_population_names(comm, input_file_name, pop_names);
+      }
     throw_assert(status == MPI_SUCCESS,
                  "py_read_population_names: unable to read population names");
 
@@ -3664,90 +4386,322 @@ extern "C"
     
     return py_population_names;
   }
-  
+
+
   PyDoc_STRVAR(
-    read_cell_attribute_info_doc,
-    "read_cell_attribute_info(file_name, populations, read_cell_index=False, comm=None)\n"
+    file_access_config_doc,
+    "file_access_config(mpi_hints=None, collective_metadata=None, alignment=None, alignment_threshold=None, meta_block_size=None, selection_gap=None)\n"
     "--\n"
     "\n"
-    "Returns information about the attributes which are defined for the given populations in the given file.\n"
+    "Updates the file access settings used by all subsequent parallel file opens,\n"
+    "and returns the current settings as a dictionary. Arguments that are None\n"
+    "are left unchanged. The initial settings are read from the environment\n"
+    "variables NEUROH5_MPI_HINTS, NEUROH5_COLL_METADATA, NEUROH5_ALIGNMENT,\n"
+    "NEUROH5_META_BLOCK_SIZE and NEUROH5_SELECTION_GAP.\n"
+    "\n"
     "Parameters\n"
     "----------\n"
-    "file_name : string\n"
-    "    The NeuroH5 file to read.\n"
-    "    \n"
-    "    .. warning::\n"
-    "       The given file must be a valid HDF5 file that contains /H5Types and /Populations groups.\n"
-    "populations : string list\n"
-    "     The populations for which attribute information should be returned\n"
-    "\n"
-    "read_cell_index : bool\n"
-    "     Optional flag that specifies whether to return the cell ids for which attributes are defined in the given file.\n"
-    "\n"
-    "comm : MPI communicator\n"
-    "    Optional MPI communicator. If None, the world communicator will be used.\n"
+    "mpi_hints : dict\n"
+    "    MPI-IO hints, e.g. {'cb_nodes': 8, 'romio_ds_read': 'disable'}; replaces the current hints.\n"
+    "collective_metadata : bool\n"
+    "    Whether metadata reads and writes are performed collectively in the reads\n"
+    "    where all ranks access the same objects (currently the projection pointer\n"
+    "    and source index reads); other opens always use independent metadata access.\n"
+    "alignment : int\n"
+    "    Alignment in bytes of file objects; 0 keeps the HDF5 default.\n"
+    "alignment_threshold : int\n"
+    "    Objects smaller than this size in bytes are not aligned.\n"
+    "meta_block_size : int\n"
+    "    Minimum size in bytes of metadata block allocations; 0 keeps the HDF5 default.\n"
+    "selection_gap : int\n"
+    "    Selection reads fetch neighbouring ranges separated by at most this many bytes\n"
+    "    as a single span; 0 merges only adjacent ranges.\n"
     "\n"
     "Returns\n"
     "-------\n"
-    "{ population : { namespace : [ \"attribute name\", ... ] } }\n"
-    "    A dictionary that maps population names to dictionaries that map attribute name spaces to lists of attribute names.\n"
-    "\n");
+    "A dictionary with the current file access settings.\n");
 
-  
-  static PyObject *py_read_cell_attribute_info (PyObject *self, PyObject *args, PyObject *kwds)
+  static PyObject *py_file_access_config (PyObject *self, PyObject *args, PyObject *kwds)
   {
-    int status; 
-    char *input_file_name;
-    bool read_cell_index = false;
-    int read_cell_index_flag = 0;
-    PyObject *py_comm = NULL, *py_pop_names = NULL;
-    MPI_Comm *comm_ptr  = NULL;
+    PyObject *py_mpi_hints = Py_None, *py_coll_metadata = Py_None,
+      *py_alignment = Py_None, *py_alignment_threshold = Py_None,
+      *py_meta_block_size = Py_None, *py_selection_gap = Py_None;
 
     static const char *kwlist[] = {
-                                   "file_name",
-                                   "populations",
-                                   "read_cell_index",
-                                   "comm",
+                                   "mpi_hints",
+                                   "collective_metadata",
+                                   "alignment",
+                                   "alignment_threshold",
+                                   "meta_block_size",
+                                   "selection_gap",
                                    NULL};
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "sO|iO", (char **)kwlist,
-                                     &input_file_name, &py_pop_names, &read_cell_index_flag, &py_comm))
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OOOOOO", (char **)kwlist,
+                                     &py_mpi_hints, &py_coll_metadata, &py_alignment,
+                                     &py_alignment_threshold, &py_meta_block_size,
+                                     &py_selection_gap))
       return NULL;
 
-    status = PyList_Check(py_pop_names);
-    throw_assert(status > 0,
-                 "py_read_cell_attribute_info: invalid pop_names list");
-
-    read_cell_index = read_cell_index_flag>0;
-
-    MPI_Comm comm;
+    FileAccessConfig config = hdf5::file_access_config();
 
-    if ((py_comm != NULL) && (py_comm != Py_None))
+    if (py_mpi_hints != Py_None)
       {
-        comm_ptr = PyMPIComm_Get(py_comm);
-        throw_assert(comm_ptr != NULL,
-                     "py_read_cell_attribute_info: invalid MPI communicator");
-        throw_assert(*comm_ptr != MPI_COMM_NULL,
-                     "py_read_cell_attribute_info: invalid MPI communicator");
-        status = MPI_Comm_dup(*comm_ptr, &comm);
-        throw_assert(status == MPI_SUCCESS,
-                     "py_read_cell_attribute_info: unable to duplicate MPI communicator");
+        throw_assert(PyDict_Check(py_mpi_hints),
+                     "py_file_access_config: mpi_hints must be a dictionary");
+        config.mpi_hints.clear();
+        PyObject *py_key, *py_value;
+        Py_ssize_t pos = 0;
+        while (PyDict_Next(py_mpi_hints, &pos, &py_key, &py_value))
+          {
+            throw_assert(PyStr_Check(py_key),
+                         "py_file_access_config: MPI-IO hint names must be strings");
+            PyObject *py_str = PyObject_Str(py_value);
+            throw_assert(py_str != NULL,
+                         "py_file_access_config: invalid MPI-IO hint value");
+            config.mpi_hints[string(PyStr_ToCString(py_key))] = string(PyStr_ToCString(py_str));
+            Py_DECREF(py_str);
+          }
       }
-    else
+    if (py_coll_metadata != Py_None)
       {
-        status = MPI_Comm_dup(MPI_COMM_WORLD, &comm);
-        throw_assert(status == MPI_SUCCESS,
-                     "py_read_cell_attribute_info: unable to duplicate MPI communicator");
+        config.coll_metadata_ops = config.coll_metadata_write =
+          PyObject_IsTrue(py_coll_metadata);
       }
+    if (py_alignment != Py_None)
+      {
+        config.alignment = PyLong_AsUnsignedLongLong(py_alignment);
+      }
+    if (py_alignment_threshold != Py_None)
+      {
+        config.alignment_threshold = PyLong_AsUnsignedLongLong(py_alignment_threshold);
+      }
+    if (py_meta_block_size != Py_None)
+      {
+        config.meta_block_size = PyLong_AsUnsignedLongLong(py_meta_block_size);
+      }
+    if (py_selection_gap != Py_None)
+      {
+        config.selection_gap = PyLong_AsUnsignedLongLong(py_selection_gap);
+      }
+    if (PyErr_Occurred())
+      return NULL;
+
+    hdf5::set_file_access_config(config);
+
+    PyObject *py_hints = PyDict_New();
+    for (auto const& hint : config.mpi_hints)
+      {
+        PyObject *py_value = PyStr_FromCString(hint.second.c_str());
+        PyDict_SetItemString(py_hints, hint.first.c_str(), py_value);
+        Py_DECREF(py_value);
+      }
+    PyObject *py_config = PyDict_New();
+    PyDict_SetItemString(py_config, "mpi_hints", py_hints);
+    Py_DECREF(py_hints);
+    PyObject *py_item = PyBool_FromLong(config.coll_metadata_ops);
+    PyDict_SetItemString(py_config, "collective_metadata", py_item);
+    Py_DECREF(py_item);
+    py_item = PyLong_FromUnsignedLongLong(config.alignment);
+    PyDict_SetItemString(py_config, "alignment", py_item);
+    Py_DECREF(py_item);
+    py_item = PyLong_FromUnsignedLongLong(config.alignment_threshold);
+    PyDict_SetItemString(py_config, "alignment_threshold", py_item);
+    Py_DECREF(py_item);
+    py_item = PyLong_FromUnsignedLongLong(config.meta_block_size);
+    PyDict_SetItemString(py_config, "meta_block_size", py_item);
+    Py_DECREF(py_item);
+    py_item = PyLong_FromUnsignedLongLong(config.selection_gap);
+    PyDict_SetItemString(py_config, "selection_gap", py_item);
+    Py_DECREF(py_item);
+
+    return py_config;
+  }
+
+
+  PyDoc_STRVAR(
+    stitch_subfiles_doc,
+    "stitch_subfiles(file_name, comm=None, remove=False, chunk_size=4000, value_chunk_size=4000, cache_size=4194304, filters=None)\n"
+    "--\n"
+    "\n"
+    "Merges the subfiles written by append_graph and append_cell_attributes\n"
+    "with subfile=True into the given file. The subfiles are divided among\n"
+    "the ranks of the communicator, which append their contents collectively.\n"
+    "\n"
+    "Parameters\n"
+    "----------\n"
+    "file_name : string\n"
+    "    The NeuroH5 file to which the subfiles belong.\n"
+    "comm : MPIComm\n"
+    "    Optional MPI communicator. If None, the world communicator will be used.\n"
+    "remove : bool\n"
+    "    Whether to remove the subfiles after merging.\n"
+    "chunk_size, value_chunk_size, cache_size, filters :\n"
+    "    As for append_cell_attributes.\n"
+    "\n"
+    "Returns\n"
+    "-------\n"
+    "The number of merged subfiles.\n");
+
+  static PyObject *py_stitch_subfiles (PyObject *self, PyObject *args, PyObject *kwds)
+  {
+    int status;
+    PyObject *py_comm = NULL;
+    MPI_Comm *comm_ptr = NULL;
+    char *file_name_arg;
+    int remove = 0;
+    const unsigned long default_cache_size = 4*1024*1024;
+    const unsigned long default_chunk_size = 4000;
+    const unsigned long default_value_chunk_size = 4000;
+    unsigned long chunk_size = default_chunk_size;
+    unsigned long value_chunk_size = default_value_chunk_size;
+    unsigned long cache_size = default_cache_size;
+    PyObject *py_filters = NULL;
+
+    static const char *kwlist[] = {
+                                   "file_name",
+                                   "comm",
+                                   "remove",
+                                   "chunk_size",
+                                   "value_chunk_size",
+                                   "cache_size",
+                                   "filters",
+                                   NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "s|OikkkO", (char **)kwlist,
+                                     &file_name_arg, &py_comm, &remove,
+                                     &chunk_size, &value_chunk_size, &cache_size,
+                                     &py_filters))
+      return NULL;
+
+    const FilterConfig filters = py_get_filter_config(py_filters);
+
+    MPI_Comm comm;
+
+    if ((py_comm != NULL) && (py_comm != Py_None))
+      {
+        comm_ptr = PyMPIComm_Get(py_comm);
+        throw_assert(comm_ptr != NULL,
+                     "py_stitch_subfiles: invalid MPI communicator");
+        throw_assert(*comm_ptr != MPI_COMM_NULL,
+                     "py_stitch_subfiles: invalid MPI communicator");
+        status = MPI_Comm_dup(*comm_ptr, &comm);
+        throw_assert(status == MPI_SUCCESS,
+                     "py_stitch_subfiles: unable to duplicate MPI communicator");
+      }
+    else
+      {
+        status = MPI_Comm_dup(MPI_COMM_WORLD, &comm);
+        throw_assert(status == MPI_SUCCESS,
+                     "py_stitch_subfiles: unable to duplicate MPI communicator");
+      }
+
+    string file_name = string(file_name_arg);
+
+    size_t num_subfiles = 0;
+    throw_assert(hdf5::num_subfiles(comm, file_name, num_subfiles) >= 0,
+                 "py_stitch_subfiles: unable to determine number of subfiles");
+
+    throw_assert(graph::stitch_graph_subfiles(comm, file_name, chunk_size, filters) >= 0,
+                 "py_stitch_subfiles: unable to merge projections");
+    cell::stitch_cell_attribute_subfiles(comm, file_name, chunk_size, value_chunk_size,
+                                         cache_size, filters);
+
+    if (remove)
+      {
+        throw_assert(hdf5::remove_subfiles(comm, file_name) >= 0,
+                     "py_stitch_subfiles: unable to remove subfiles");
+      }
+
+    status = MPI_Comm_free(&comm);
+    throw_assert(status == MPI_SUCCESS,
+                 "py_stitch_subfiles: unable to free MPI communicator");
+
+    return PyLong_FromSize_t(num_subfiles);
+  }
+  
+  PyDoc_STRVAR(
+    read_cell_attribute_info_doc,
+    "read_cell_attribute_info(file_name, populations, read_cell_index=False, comm=None)\n"
+    "--\n"
+    "\n"
+    "Returns information about the attributes which are defined for the given populations in the given file.\n"
+    "Parameters\n"
+    "----------\n"
+    "file_name : string\n"
+    "    The NeuroH5 file to read.\n"
+    "    \n"
+    "    .. warning::\n"
+    "       The given file must be a valid HDF5 file that contains /H5Types and /Populations groups.\n"
+    "populations : string list\n"
+    "     The populations for which attribute information should be returned\n"
+    "\n"
+    "read_cell_index : bool\n"
+    "     Optional flag that specifies whether to return the cell ids for which attributes are defined in the given file.\n"
+    "\n"
+    "comm : MPI communicator\n"
+    "    Optional MPI communicator. If None, the world communicator will be used.\n"
+    "\n"
+    "Returns\n"
+    "-------\n"
+    "{ population : { namespace : [ \"attribute name\", ... ] } }\n"
+    "    A dictionary that maps population names to dictionaries that map attribute name spaces to lists of attribute names.\n"
+    "\n");
+
+  
+  static PyObject *py_read_cell_attribute_info (PyObject *self, PyObject *args, PyObject *kwds)
+  {
+    int status; 
+    char *input_file_name;
+    bool read_cell_index = false;
+    int read_cell_index_flag = 0;
+    PyObject *py_comm = NULL, *py_pop_names = NULL;
+    MPI_Comm *comm_ptr  = NULL;
+
+    static const char *kwlist[] = {
+                                   "file_name",
+                                   "populations",
+                                   "read_cell_index",
+                                   "comm",
+                                   NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "sO|iO", (char **)kwlist,
+                                     &input_file_name, &py_pop_names, &read_cell_index_flag, &py_comm))
+      return NULL;
+
+    status = PyList_Check(py_pop_names);
+    throw_assert(status > 0,
+                 "py_read_cell_attribute_info: invalid pop_names list");
+
+    read_cell_index = read_cell_index_flag>0;
+
+    MPI_Comm comm;
+
+    if ((py_comm != NULL) && (py_comm != Py_None))
+      {
+        comm_ptr = PyMPIComm_Get(py_comm);
+        throw_assert(comm_ptr != NULL,
+                     "py_read_cell_attribute_info: invalid MPI communicator");
+        throw_assert(*comm_ptr != MPI_COMM_NULL,
+                     "py_read_cell_attribute_info: invalid MPI communicator");
+        status = MPI_Comm_dup(*comm_ptr, &comm);
+        throw_assert(status == MPI_SUCCESS,
+                     "py_read_cell_attribute_info: unable to duplicate MPI communicator");
+      }
+    else
+      {
+        status = MPI_Comm_dup(MPI_COMM_WORLD, &comm);
+        throw_assert(status == MPI_SUCCESS,
+                     "py_read_cell_attribute_info: unable to duplicate MPI communicator");
+      }
+
+    int srank, ssize; size_t rank, size;
+    status = MPI_Comm_size(comm, &ssize);
+    throw_assert(status == MPI_SUCCESS,
+                 "py_read_cell_attribute_info: unable to obtain size of MPI communicator");
+    status = MPI_Comm_rank(comm, &srank);
+    throw_assert(status == MPI_SUCCESS,
+                 "py_read_cell_attribute_info: unable to obtain rank of MPI communicator");
 
-    int srank, ssize; size_t rank, size;
-    status = MPI_Comm_size(comm, &ssize);
-    throw_assert(status == MPI_SUCCESS,
-                 "py_read_cell_attribute_info: unable to obtain size of MPI communicator");
-    status = MPI_Comm_rank(comm, &srank);
-    throw_assert(status == MPI_SUCCESS,
-                 "py_read_cell_attribute_info: unable to obtain rank of MPI communicator");
-
     size = ssize;
     rank = srank;
     
@@ -3970,8 +4924,9 @@ extern "C"
     "Returns population size and range for each population defined in the input file.\n"
     "Parameters\n"
     "----------\n"
-    "file_name : string\n"
+    "file_name : string or File\n"
     "    The NeuroH5 file to read.\n"
+    "    If a File session is given, the result is cached in the session.\n"
     "    \n"
     "    .. warning::\n"
     "       The given file must be a valid HDF5 file that contains an /H5Types group.\n"
@@ -3997,17 +4952,20 @@ extern "C"
     PyObject *py_comm = NULL;
     MPI_Comm *comm_ptr  = NULL;
     
-    char *input_file_name;
+    PyObject *py_file = NULL;
 
     static const char *kwlist[] = {
                                    "file_name",
                                    "comm",
                                    NULL};
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "s|O", (char **)kwlist,
-                                     &input_file_name, &py_comm))
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", (char **)kwlist,
+                                     &py_file, &py_comm))
       return NULL;
 
+    string input_file_name;
+    File *file = py_get_file(py_file, input_file_name);
+
     MPI_Comm comm;
 
     if ((py_comm != NULL) && (py_comm != Py_None))
@@ -4028,15 +4986,26 @@ extern "C"
                      "py_read_population_ranges: unable to duplicate MPI communicator");
       }
 
-    status = cell::read_population_labels(comm, input_file_name, pop_labels);
-    throw_assert (status >= 0,
-                  "py_read_population_ranges: unable to read population labels");
-
     size_t n_nodes;
     pop_range_map_t pop_ranges;
-    status = cell::read_population_ranges(comm, string(input_file_name), pop_ranges, n_nodes);
-    throw_assert(status >= 0,
-                 "py_read_population_ranges: unable to read population labels");
+    if (file != NULL)
+      {
+        status = cell::read_population_labels(*file, pop_labels);
+        throw_assert (status >= 0,
+                      "py_read_population_ranges: unable to read population labels");
+        status = cell::read_population_ranges(*file, pop_ranges, n_nodes);
+        throw_assert(status >= 0,
+                     "py_read_population_ranges: unable to read population ranges");
+      }
+    else
+      {
+        status = cell::read_population_labels(comm, input_file_name, pop_labels);
+        throw_assert (status >= 0,
+                      "py_read_population_ranges: unable to read population labels");
+        status = cell::read_population_ranges(comm, input_file_name, pop_ranges, n_nodes);
+        throw_assert(status >= 0,
+                     "py_read_population_ranges: unable to read population ranges");
+      }
     status = MPI_Comm_free(&comm);
     throw_assert(status == MPI_SUCCESS,
                  "py_read_population_ranges: unable to free MPI communicator");
@@ -4077,8 +5046,9 @@ extern "C"
     "Returns the names of the projections contained in the given file.\n"
     "Parameters\n"
     "----------\n"
-    "file_name : string\n"
+    "file_name : string or File\n"
     "    The NeuroH5 file to read.\n"
+    "    If a File session is given, the result is cached in the session.\n"
     "    \n"
     "    .. warning::\n"
     "       The given file must be a valid HDF5 file that contains /H5Types and /Populations groups.\n"
@@ -4096,7 +5066,7 @@ extern "C"
   {
     int status;
     vector< pair<string,string> > prj_names;
-    char *input_file_name;
+    PyObject *py_file = NULL;
     PyObject *py_comm = NULL;
     MPI_Comm *comm_ptr  = NULL;
 
@@ -4105,10 +5075,13 @@ extern "C"
                                    "comm",
                                    NULL};
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "s|O", (char **)kwlist,
-                                     &input_file_name, &py_comm))
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", (char **)kwlist,
+                                     &py_file, &py_comm))
       return NULL;
 
+    string input_file_name;
+    File *file = py_get_file(py_file, input_file_name);
+
     MPI_Comm comm;
 
     if ((py_comm != NULL) && (py_comm != Py_None))
@@ -4132,7 +5105,10 @@ extern "C"
 
     PyObject *py_result  = PyList_New(0);
 
-    if (graph::read_projection_names(comm, string(input_file_name), prj_names) >= 0)
+    status = (file != NULL) ?
+      graph::read_projection_names(*file, prj_names) :
+      graph::read_projection_names(comm, input_file_name, prj_names);
+    if (status >= 0)
       {
 
         for (auto name_pair: prj_names)
@@ -4590,11 +5566,11 @@ extern "C"
     }
 
     
-    forward_list<neurotree_t> tree_list;
+    data::TreeArena tree_arena;
 
     status = cell::read_trees (comm, string(file_name),
                                string(pop_name), pop_start,
-                               tree_list);
+                               tree_arena);
     throw_assert (status >= 0,
                  "py_read_trees: unable to read trees");
 
@@ -4614,11 +5590,11 @@ extern "C"
                  "py_read_trees: unable to free MPI communicator");
 
 
-    PyObject* py_tree_iter = NeuroH5TreeIter_FromList(tree_list,
-                                                      attr_name_spaces,
-                                                      attr_maps,
-                                                      topology_flag>0,
-                                                      validate_flag>0);
+    PyObject* py_tree_iter = NeuroH5TreeIter_FromArena(std::move(tree_arena),
+                                                       attr_name_spaces,
+                                                       attr_maps,
+                                                       topology_flag>0,
+                                                       validate_flag>0);
 
     PyObject *py_result_tuple = PyTuple_New(2);
     PyTuple_SetItem(py_result_tuple, 0, py_tree_iter);
@@ -4651,8 +5627,9 @@ extern "C"
     "namespaces : string list\n"
     "    An optional list of namespaces from which additional attributes for the trees will be read.\n"
     "\n"
-    "node_allocation : iterable\n"
-    "    An optional iterable that specifies the assignment of cell gids to the current MPI rank.\n"
+    "node_allocation : iterable or string\n"
+    "    An optional iterable that specifies the assignment of cell gids to the current MPI rank, \n"
+    "    or one of 'round_robin' and 'block' to assign the cells of the population to ranks without storing the assignment.\n"
     "\n"
     "topology : boolean\n"
     "    An optional flag that specifies whether section topology dictionary should be returned.\n"
@@ -4705,7 +5682,7 @@ extern "C"
     char *file_name, *pop_name;
     PyObject *py_node_allocation=NULL;
     PyObject *py_attr_name_spaces=NULL;
-    node_rank_map_t node_rank_map;
+    data::NodeRankMap node_rank_map;
     static const char *kwlist[] = {
                                    "file_name",
                                    "population_name",
@@ -4809,7 +5786,8 @@ extern "C"
     // Create C++ map for node_rank_map:
     if ((py_node_allocation != NULL) && (py_node_allocation != Py_None))
       {
-        build_node_rank_map(comm, py_node_allocation, node_rank_map);
+        build_scatter_node_rank_map(comm, py_node_allocation, pop_start, pop_count,
+                                    node_rank_map);
       }
     else
       {
@@ -4833,32 +5811,27 @@ extern "C"
           }
 
         std::sort(cell_index.begin(), cell_index.end());
-        size_t i = 0;
-        for (const auto& gid : cell_index)
-          {
-            node_rank_map[gid].insert(i%size);
-            i++;
-          }
+        node_rank_map = round_robin_index_rank_map(std::move(cell_index), size);
       }
     
 
-    map<CELL_IDX_T, neurotree_t> tree_map;
+    data::TreeArena tree_arena;
     map<string, NamedAttrMap> attr_maps;
     
     status = cell::scatter_read_trees (comm, string(file_name),
                                        io_size, attr_name_spaces,
                                        node_rank_map, string(pop_name),
                                        pop_start,
-                                       tree_map, attr_maps);
+                                       tree_arena, attr_maps);
     throw_assert (status >= 0,
                  "py_scatter_read_trees: unable to read trees");
 
 
-    PyObject* py_tree_iter = NeuroH5TreeIter_FromMap(tree_map,
-                                                     attr_name_spaces,
-                                                     attr_maps,
-                                                     topology_flag>0,
-                                                     validate_flag>0);
+    PyObject* py_tree_iter = NeuroH5TreeIter_FromArena(std::move(tree_arena),
+                                                       attr_name_spaces,
+                                                       attr_maps,
+                                                       topology_flag>0,
+                                                       validate_flag>0);
 
     PyObject *py_result_tuple = PyTuple_New(2);
     PyTuple_SetItem(py_result_tuple, 0, py_tree_iter);
@@ -5307,8 +6280,9 @@ extern "C"
     "io_size : \n"
     "    Optional number of ranks performing I/O operations. If 0, this number will be equal to the size of the MPI communicator.\n"
     "\n"
-    "node_allocation : \n"
-    "    Optional iterable that with gids assigned to rank. If None, round-robin assignment will be used.\n"
+    "node_allocation : iterable or string\n"
+    "    Optional iterable that with gids assigned to rank, or one of 'round_robin' and 'block' to assign \n"
+    "    the cells of the population to ranks without storing the assignment. If None, round-robin assignment will be used.\n"
     "\n"
     "mask : set of string\n"
     "    Optional set of attributes to be read. If not set, all attributes in the namespace will be read.\n"
@@ -5330,7 +6304,7 @@ extern "C"
     char *file_name, *pop_name;
     PyObject *py_node_allocation=NULL;
     PyObject *py_attr_name_spaces=NULL;
-    node_rank_map_t node_rank_map;
+    data::NodeRankMap node_rank_map;
     vector <string> attr_name_spaces;
     char *return_type_arg = NULL;
     return_type return_tp = return_dict;
@@ -5718,11 +6692,12 @@ extern "C"
 
   
   PyDoc_STRVAR(
-    read_cell_attribute_selection_doc,
-    "read_cell_attribute_selection(file_name, population_name, selection, namespace, comm=None)\n"
+    read_cell_attribute_columns_doc,
+    "read_cell_attribute_columns(file_name, population_name, namespace, comm=None, mask=None)\n"
     "--\n"
     "\n"
-    "Reads cell attributes for the given cell gids from the given file and namespace. \n"
+    "Reads cell attributes for all cell gids contained in the given file and namespace, in columnar form. "
+    "Each rank will be assigned an equal number of cell gids, with the exception of the last rank if the number of cells is not evenly divisible by the number of ranks. \n"
     "\n"
     "Parameters\n"
     "----------\n"
@@ -5735,69 +6710,55 @@ extern "C"
     "population_name : string\n"
     "    Name of population from which to read.\n"
     "\n"
-    "selection : int list\n"
-    "    A list of gids to read.\n"
-    "\n"
     "namespace : string\n"
     "    The namespace for which cell attributes will be read.\n"
     "\n"
     "comm : MPI communicator\n"
     "    Optional MPI communicator. If None, the world communicator will be used.\n"
     "\n"
+    "mask : set of string\n"
+    "    Optional set of attributes to be read. If not set, all attributes in the namespace will be read.\n"
+    "\n"
     "Returns\n"
     "-------\n"
-    "cell_iter : iterator\n"
-    "   An iterator that returns pairs (gid, attr_dict) where gid is the cell id and attr_dict is a dictionary with attribute key-value pairs. \n"
+    "Dictionary of the form { attr_name: (gid, ptr, value) }, where: \n"
+    "gid : uint32 ndarray\n"
+    "   Sorted ids of the cells that have the attribute. \n"
+    "ptr : uint64 ndarray\n"
+    "   Offsets of the values of each cell: the values of cell gid[i] are value[ptr[i]:ptr[i+1]]. \n"
+    "value : ndarray\n"
+    "   Values of the attribute for all cells. \n"
     "\n");
 
-  static PyObject *py_read_cell_attribute_selection (PyObject *self, PyObject *args, PyObject *kwds)
+  
+  static PyObject *py_read_cell_attribute_columns (PyObject *self, PyObject *args, PyObject *kwds)
   {
     herr_t status;
     PyObject *py_comm = NULL;
-    PyObject *py_mask = NULL;
     MPI_Comm *comm_ptr  = NULL;
+    PyObject *py_mask = NULL;
     const string default_namespace = "Attributes";
     char *file_name, *pop_name, *attr_namespace = (char *)default_namespace.c_str();
-    PyObject *py_selection = NULL;
-    vector <CELL_IDX_T> selection;
-    return_type return_tp = return_dict;
-    char *return_type_arg = NULL;
     
     static const char *kwlist[] = {
                                    "file_name",
                                    "pop_name",
-                                   "selection",
                                    "namespace",
                                    "comm",
                                    "mask",
-                                   "return_type",
                                    NULL};
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "ssO|sOOs", (char **)kwlist,
-                                     &file_name, &pop_name, &py_selection,
-                                     &attr_namespace, &py_comm, &py_mask,
-                                     &return_type_arg))
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "ss|sOO", (char **)kwlist,
+                                     &file_name, &pop_name, &attr_namespace,
+                                     &py_comm, &py_mask))
       return NULL;
 
-    if (return_type_arg != NULL)
-      {
-        string return_type_str = string(return_type_arg);
-        if (return_type_str == "dict")
-          return_tp = return_dict;
-        if (return_type_str == "tuple")
-          return_tp = return_tuple;
-#if HAS_STRUCT_SEQUENCE
-        if (return_type_str == "struct")
-          return_tp = return_struct;
-#endif
-      }
-    
     set<string> attr_mask;
-
+    
     if (py_mask != NULL)
       {
         throw_assert(PySet_Check(py_mask),
-                     "py_read_trees: argument mask must be a set of strings");
+                     "py_read_cell_attribute_columns: argument mask must be a set of strings");
         
         PyObject *py_iter = PyObject_GetIter(py_mask);
         if (py_iter != NULL)
@@ -5814,33 +6775,30 @@ extern "C"
         Py_DECREF(py_iter);
       }
 
-    
     MPI_Comm comm;
 
     if ((py_comm != NULL) && (py_comm != Py_None))
       {
         comm_ptr = PyMPIComm_Get(py_comm);
-        throw_assert(comm_ptr != NULL, 
-                     "py_read_cell_attribute_selection: pointer to MPI communicator is null");
+        throw_assert(comm_ptr != NULL,
+                     "py_read_cell_attribute_columns: unable to obtain MPI communicator");
         throw_assert(*comm_ptr != MPI_COMM_NULL,
-                     "py_read_cell_attribute_selection: MPI communicator is null");
+                     "py_read_cell_attribute_columns: MPI communicator is null");
         status = MPI_Comm_dup(*comm_ptr, &comm);
         throw_assert(status == MPI_SUCCESS,
-                     "py_read_cell_attribute_selection: unable to duplicate MPI communicator");
+                     "py_read_cell_attribute_columns: unable to duplicate MPI communicator");
       }
     else
       {
         status = MPI_Comm_dup(MPI_COMM_WORLD, &comm);
-                     
         throw_assert(status == MPI_SUCCESS,
-                     "py_read_cell_attribute_selection: unable to duplicate MPI communicator");
+                     "py_read_cell_attribute_columns: unable to duplicate MPI communicator");
       }
-    
+
     pop_label_map_t pop_labels;
     status = cell::read_population_labels(comm, string(file_name), pop_labels);
     throw_assert (status >= 0,
-                  "py_read_cell_attribute_selection: unable to read population labels");
-
+                  "py_read_cell_attribute_columns: unable to read population labels");
     
     // Determine index of population to be read
     pop_t pop_idx=0; bool pop_idx_set=false;
@@ -5854,28 +6812,411 @@ extern "C"
       }
     if (!pop_idx_set)
       {
-        throw_err(std::string("py_read_cell_attribute_selection: ") + "Population " + pop_name + " not found");
+        throw_err(std::string("py_read_cell_attribute_columns: ") + "Population " + pop_name + " not found");
       }
 
     size_t n_nodes;
     pop_range_map_t pop_ranges;
     throw_assert(cell::read_population_ranges(comm, string(file_name), pop_ranges, n_nodes) >= 0,
-                 "py_read_cell_attribute_selection: unable to read population ranges");
+                 "py_read_cell_attribute_columns: unable to read population ranges");
     CELL_IDX_T pop_start = 0;
-    size_t pop_count = 0;
     {
         auto it = pop_ranges.find(pop_idx);
         throw_assert(it != pop_ranges.end(),
-                     "py_read_cell_attribute_selection: invalid population index");
+                     "py_read_cell_attribute_columns: invalid population index");
         pop_start = it->second.start;
-        pop_count = it->second.count;
     }
 
-
-    // Create C++ vector of selection indices:
-    if (py_selection != NULL)
-      {
-        build_selection(py_selection, selection);
+    NamedColumnarAttrMap attr_values;
+    cell::read_cell_attributes (comm,
+                                (file_name), string(attr_namespace), attr_mask,
+                                string(pop_name), pop_start,
+                                attr_values);
+    
+    throw_assert(MPI_Comm_free(&comm) == MPI_SUCCESS,
+                 "py_read_cell_attribute_columns: unable to free MPI communicator");
+
+    return py_build_cell_attr_columns(std::move(attr_values));
+  }
+
+  
+  PyDoc_STRVAR(
+    scatter_read_cell_attribute_columns_doc,
+    "scatter_read_cell_attribute_columns(file_name, population_name, namespaces, node_allocation=None, comm=None, mask=None, io_size=0)\n"
+    "--\n"
+    "\n"
+    "Reads cell attributes for all cell gids contained in the given file and namespaces, in columnar form, using scalable parallel read/scatter. "
+    "Each rank will be assigned an equal number of cell gids, with the exception of the last rank if the number of cells is not evenly divisible by the number of ranks. \n"
+    "\n"
+    "Parameters\n"
+    "----------\n"
+    "file_name : string\n"
+    "    The NeuroH5 file to read.\n"
+    "    \n"
+    "    .. warning::\n"
+    "       The given file must be a valid HDF5 file that contains /H5Types and /Populations groups.\n"
+    "\n"
+    "population_name : string\n"
+    "    Name of population from which to read.\n"
+    "\n"
+    "namespaces : string list\n"
+    "    The namespaces for which cell attributes will be read.\n"
+    "\n"
+    "comm : MPI communicator\n"
+    "    Optional MPI communicator. If None, the world communicator will be used.\n"
+    "\n"
+    "io_size : \n"
+    "    Optional number of ranks performing I/O operations. If 0, this number will be equal to the size of the MPI communicator.\n"
+    "\n"
+    "node_allocation : iterable or string\n"
+    "    Optional iterable that with gids assigned to rank, or one of 'round_robin' and 'block' to assign \n"
+    "    the cells of the population to ranks without storing the assignment. If None, round-robin assignment will be used.\n"
+    "\n"
+    "mask : set of string\n"
+    "    Optional set of attributes to be read. If not set, all attributes in the namespace will be read.\n"
+    "\n"
+    "Returns\n"
+    "-------\n"
+    "Dictionary of the form { namespace: { attr_name: (gid, ptr, value) } }, where gid holds the sorted ids of \n"
+    "the local cells that have the attribute, and the values of cell gid[i] are value[ptr[i]:ptr[i+1]]. \n"
+    "\n");
+
+  static PyObject *py_scatter_read_cell_attribute_columns (PyObject *self, PyObject *args, PyObject *kwds)
+  {
+    int status;
+    PyObject *py_comm = NULL;
+    PyObject *py_mask = NULL;
+    MPI_Comm *comm_ptr  = NULL;
+    unsigned long io_size = 0;
+    char *file_name, *pop_name;
+    PyObject *py_node_allocation=NULL;
+    PyObject *py_attr_name_spaces=NULL;
+    data::NodeRankMap node_rank_map;
+    vector <string> attr_name_spaces;
+    
+    static const char *kwlist[] = {
+                                   "file_name",
+                                   "pop_name",
+                                   "comm",
+                                   "mask",
+                                   "node_allocation",
+                                   "namespaces",
+                                   "io_size",
+                                   NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "ss|OOOOk", (char **)kwlist,
+                                     &file_name, &pop_name, &py_comm, &py_mask, 
+                                     &py_node_allocation, &py_attr_name_spaces,
+                                     &io_size))
+      return NULL;
+
+    set<string> attr_mask;
+    
+    if (py_mask != NULL)
+      {
+        throw_assert(PySet_Check(py_mask),
+                     "py_scatter_read_cell_attribute_columns: argument mask must be a set of strings");
+        
+        PyObject *py_iter = PyObject_GetIter(py_mask);
+        if (py_iter != NULL)
+          {
+            PyObject *pyval;
+            while((pyval = PyIter_Next(py_iter)))
+              {
+                const char* str = PyStr_ToCString (pyval);
+                attr_mask.insert(string(str));
+                Py_DECREF(pyval);
+              }
+          }
+
+        Py_DECREF(py_iter);
+      }
+
+    MPI_Comm comm;
+
+    if ((py_comm != NULL) && (py_comm != Py_None))
+      {
+        comm_ptr = PyMPIComm_Get(py_comm);
+        throw_assert(comm_ptr != NULL,
+                     "py_scatter_read_cell_attribute_columns: invalid MPI communicator");
+        throw_assert(*comm_ptr != MPI_COMM_NULL,
+                     "py_scatter_read_cell_attribute_columns: invalid MPI communicator");
+        status = MPI_Comm_dup(*comm_ptr, &comm);
+        throw_assert(status == MPI_SUCCESS,
+                     "py_scatter_read_cell_attribute_columns: unable to duplicate MPI communicator");
+      }
+    else
+      {
+        status = MPI_Comm_dup(MPI_COMM_WORLD, &comm);
+        throw_assert(status == MPI_SUCCESS,
+                     "py_scatter_read_cell_attribute_columns: unable to duplicate MPI communicator");
+      }
+
+    int size;
+    status = MPI_Comm_size(comm, &size);
+    throw_assert(status == MPI_SUCCESS,
+                 "py_scatter_read_cell_attribute_columns: unable to obtain size of MPI communicator");
+
+    if (io_size == 0)
+      {
+        io_size = size > 0 ? size : 1;
+      }
+
+    // Create C++ vector of namespace strings:
+    if (py_attr_name_spaces != NULL)
+      {
+        for (size_t i = 0; (Py_ssize_t)i < PyList_Size(py_attr_name_spaces); i++)
+          {
+            PyObject *pyval = PyList_GetItem(py_attr_name_spaces, (Py_ssize_t)i);
+            const char *str = PyStr_ToCString (pyval);
+            if (str != NULL)
+              {
+                attr_name_spaces.push_back(string(str));
+              }
+          }
+      }
+
+    pop_label_map_t pop_labels;
+    status = cell::read_population_labels(comm, string(file_name), pop_labels);
+    throw_assert (status >= 0,
+                  "py_scatter_read_cell_attribute_columns: unable to read population labels");
+
+    // Determine index of population to be read
+    pop_t pop_idx=0; bool pop_idx_set=false;
+    for (auto& x: pop_labels) 
+      {
+        if (get<1>(x) == pop_name)
+          {
+            pop_idx = get<0>(x);
+            pop_idx_set = true;
+          }
+      }
+    if (!pop_idx_set)
+      {
+        throw_err(std::string("py_scatter_read_cell_attribute_columns: ") + "Population " + pop_name + " not found");
+      }
+
+    size_t n_nodes;
+    pop_range_map_t pop_ranges;
+
+    status = cell::read_population_ranges(comm, string(file_name), pop_ranges, n_nodes);
+    throw_assert(status >= 0,
+                 "py_scatter_read_cell_attribute_columns: unable to read population ranges");
+    CELL_IDX_T pop_start = 0;
+    {
+        auto it = pop_ranges.find(pop_idx);
+        throw_assert(it != pop_ranges.end(),
+                     "py_scatter_read_cell_attribute_columns: invalid population index");
+        pop_start = it->second.start;
+    }
+
+    ldbal_cell_attr (comm, string(file_name),
+                     pop_ranges, pop_name, pop_idx, 
+                     attr_name_spaces, py_node_allocation,
+                     node_rank_map);
+
+    PyObject *py_namespace_dict = PyDict_New();
+    for (string attr_name_space : attr_name_spaces)
+      {
+        NamedColumnarAttrMap attr_map;
+        
+        status = cell::scatter_read_cell_attributes (comm,
+                                                     string(file_name),
+                                                     io_size,
+                                                     attr_name_space,
+                                                     attr_mask,
+                                                     node_rank_map,
+                                                     string(pop_name),
+                                                     pop_start,
+                                                     attr_map);
+        throw_assert (status >= 0,
+                      "py_scatter_read_cell_attribute_columns: unable to read cell attributes");
+
+        PyObject *py_attr_dict = py_build_cell_attr_columns(std::move(attr_map));
+        PyDict_SetItemString(py_namespace_dict, attr_name_space.c_str(), py_attr_dict);
+        Py_DECREF(py_attr_dict);
+      }
+    status = MPI_Comm_free(&comm);
+    throw_assert(status == MPI_SUCCESS,
+                 "py_scatter_read_cell_attribute_columns: unable to free MPI communicator");
+
+    return py_namespace_dict;
+  }
+
+  
+  PyDoc_STRVAR(
+    read_cell_attribute_selection_doc,
+    "read_cell_attribute_selection(file_name, population_name, selection, namespace, comm=None)\n"
+    "--\n"
+    "\n"
+    "Reads cell attributes for the given cell gids from the given file and namespace. \n"
+    "\n"
+    "Parameters\n"
+    "----------\n"
+    "file_name : string or File\n"
+    "    The NeuroH5 file to read, or a File session. With a session, the\n"
+    "    cell indexes of the namespace are partitioned over the ranks of the\n"
+    "    session communicator once and reused by later selection reads;\n"
+    "    comm is then ignored.\n"
+    "    \n"
+    "    .. warning::\n"
+    "       The given file must be a valid HDF5 file that contains /H5Types and /Populations groups.\n"
+    "\n"
+    "population_name : string\n"
+    "    Name of population from which to read.\n"
+    "\n"
+    "selection : int list\n"
+    "    A list of gids to read.\n"
+    "\n"
+    "namespace : string\n"
+    "    The namespace for which cell attributes will be read.\n"
+    "\n"
+    "comm : MPI communicator\n"
+    "    Optional MPI communicator. If None, the world communicator will be used.\n"
+    "\n"
+    "Returns\n"
+    "-------\n"
+    "cell_iter : iterator\n"
+    "   An iterator that returns pairs (gid, attr_dict) where gid is the cell id and attr_dict is a dictionary with attribute key-value pairs. \n"
+    "\n");
+
+  static PyObject *py_read_cell_attribute_selection (PyObject *self, PyObject *args, PyObject *kwds)
+  {
+    herr_t status;
+    PyObject *py_comm = NULL;
+    PyObject *py_mask = NULL;
+    MPI_Comm *comm_ptr  = NULL;
+    const string default_namespace = "Attributes";
+    PyObject *py_file = NULL;
+    char *pop_name, *attr_namespace = (char *)default_namespace.c_str();
+    PyObject *py_selection = NULL;
+    vector <CELL_IDX_T> selection;
+    return_type return_tp = return_dict;
+    char *return_type_arg = NULL;
+    
+    static const char *kwlist[] = {
+                                   "file_name",
+                                   "pop_name",
+                                   "selection",
+                                   "namespace",
+                                   "comm",
+                                   "mask",
+                                   "return_type",
+                                   NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OsO|sOOs", (char **)kwlist,
+                                     &py_file, &pop_name, &py_selection,
+                                     &attr_namespace, &py_comm, &py_mask,
+                                     &return_type_arg))
+      return NULL;
+
+    if (return_type_arg != NULL)
+      {
+        string return_type_str = string(return_type_arg);
+        if (return_type_str == "dict")
+          return_tp = return_dict;
+        if (return_type_str == "tuple")
+          return_tp = return_tuple;
+#if HAS_STRUCT_SEQUENCE
+        if (return_type_str == "struct")
+          return_tp = return_struct;
+#endif
+      }
+    
+    string file_name;
+    File *file = py_get_file(py_file, file_name);
+
+    set<string> attr_mask;
+
+    if (py_mask != NULL)
+      {
+        throw_assert(PySet_Check(py_mask),
+                     "py_read_trees: argument mask must be a set of strings");
+        
+        PyObject *py_iter = PyObject_GetIter(py_mask);
+        if (py_iter != NULL)
+          {
+            PyObject *pyval;
+            while((pyval = PyIter_Next(py_iter)))
+              {
+                const char* str = PyStr_ToCString (pyval);
+                attr_mask.insert(string(str));
+                Py_DECREF(pyval);
+              }
+          }
+
+        Py_DECREF(py_iter);
+      }
+
+    
+    MPI_Comm comm;
+
+    if ((py_comm != NULL) && (py_comm != Py_None))
+      {
+        comm_ptr = PyMPIComm_Get(py_comm);
+        throw_assert(comm_ptr != NULL, 
+                     "py_read_cell_attribute_selection: pointer to MPI communicator is null");
+        throw_assert(*comm_ptr != MPI_COMM_NULL,
+                     "py_read_cell_attribute_selection: MPI communicator is null");
+        status = MPI_Comm_dup(*comm_ptr, &comm);
+        throw_assert(status == MPI_SUCCESS,
+                     "py_read_cell_attribute_selection: unable to duplicate MPI communicator");
+      }
+    else
+      {
+        status = MPI_Comm_dup(MPI_COMM_WORLD, &comm);
+                     
+        throw_assert(status == MPI_SUCCESS,
+                     "py_read_cell_attribute_selection: unable to duplicate MPI communicator");
+      }
+    
+    pop_label_map_t pop_labels;
+    if (file != NULL)
+      status = cell::read_population_labels(*file, pop_labels);
+    else
+      status = cell::read_population_labels(comm, file_name, pop_labels);
+    throw_assert (status >= 0,
+                  "py_read_cell_attribute_selection: unable to read population labels");
+
+    
+    // Determine index of population to be read
+    pop_t pop_idx=0; bool pop_idx_set=false;
+    for (auto& x: pop_labels) 
+      {
+        if (get<1>(x) == pop_name)
+          {
+            pop_idx = get<0>(x);
+            pop_idx_set = true;
+          }
+      }
+    if (!pop_idx_set)
+      {
+        throw_err(std::string("py_read_cell_attribute_selection: ") + "Population " + pop_name + " not found");
+      }
+
+    size_t n_nodes;
+    pop_range_map_t pop_ranges;
+    if (file != NULL)
+      status = cell::read_population_ranges(*file, pop_ranges, n_nodes);
+    else
+      status = cell::read_population_ranges(comm, file_name, pop_ranges, n_nodes);
+    throw_assert(status >= 0,
+                 "py_read_cell_attribute_selection: unable to read population ranges");
+    CELL_IDX_T pop_start = 0;
+    size_t pop_count = 0;
+    {
+        auto it = pop_ranges.find(pop_idx);
+        throw_assert(it != pop_ranges.end(),
+                     "py_read_cell_attribute_selection: invalid population index");
+        pop_start = it->second.start;
+        pop_count = it->second.count;
+    }
+
+
+    // Create C++ vector of selection indices:
+    if (py_selection != NULL)
+      {
+        build_selection(py_selection, selection);
       }
     else
       {
@@ -5888,9 +7229,18 @@ extern "C"
       }
 
     NamedAttrMap attr_values;
-    cell::read_cell_attribute_selection (comm, string(file_name), string(attr_namespace), attr_mask,
-                                         string(pop_name), pop_start,
-                                         selection, attr_values);
+    if (file != NULL)
+      {
+        cell::read_cell_attribute_selection (*file, string(attr_namespace), attr_mask,
+                                             string(pop_name), pop_start,
+                                             selection, attr_values);
+      }
+    else
+      {
+        cell::read_cell_attribute_selection (comm, file_name, string(attr_namespace), attr_mask,
+                                             string(pop_name), pop_start,
+                                             selection, attr_values);
+      }
     vector<vector<string>> attr_names;
     attr_values.attr_names(attr_names);
     throw_assert(MPI_Comm_free(&comm) == MPI_SUCCESS,
@@ -6321,6 +7671,7 @@ extern "C"
     unsigned long chunk_size = default_chunk_size;
     unsigned long value_chunk_size = default_value_chunk_size;
     unsigned long cache_size = default_cache_size;
+    PyObject *py_filters = NULL;
     herr_t status;
     
     static const char *kwlist[] = {
@@ -6333,15 +7684,19 @@ extern "C"
                                    "chunk_size",
                                    "value_chunk_size",
                                    "cache_size",
+                                   "filters",
                                    NULL};
 
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "ssO|sOkkkk", (char **)kwlist,
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "ssO|sOkkkkO", (char **)kwlist,
                                      &file_name_arg, &pop_name_arg, &idx_values,
                                      &namespace_arg, &py_comm, 
-                                     &io_size, &chunk_size, &value_chunk_size, &cache_size))
+                                     &io_size, &chunk_size, &value_chunk_size, &cache_size,
+                                     &py_filters))
       return NULL;
 
+    const FilterConfig filters = py_get_filter_config(py_filters);
+
     string file_name = string(file_name_arg);
     string pop_name = string(pop_name_arg);
     string attr_namespace = string(namespace_arg);
@@ -6466,49 +7821,49 @@ extern "C"
             const string& attr_name = it->first;
             cell::write_cell_attribute_map<float> (data_comm, file_name, attr_namespace, pop_name, pop_start,
                                                    attr_name, it->second, io_size, dflt_data_type,
-                                                   chunk_size, value_chunk_size, cache_size);
+                                                   chunk_size, value_chunk_size, cache_size, filters);
           }
         for(auto it = all_attr_values_uint32.cbegin(); it != all_attr_values_uint32.cend(); ++it)
           {
             const string& attr_name = it->first;
             cell::write_cell_attribute_map<uint32_t> (data_comm, file_name, attr_namespace, pop_name, pop_start,
                                                       attr_name, it->second, io_size, dflt_data_type,
-                                                      chunk_size, value_chunk_size, cache_size);
+                                                      chunk_size, value_chunk_size, cache_size, filters);
           }
         for(auto it = all_attr_values_uint16.cbegin(); it != all_attr_values_uint16.cend(); ++it)
           {
             const string& attr_name = it->first;
             cell::write_cell_attribute_map<uint16_t> (data_comm, file_name, attr_namespace, pop_name, pop_start,
                                                       attr_name, it->second, io_size, dflt_data_type,
-                                                      chunk_size, value_chunk_size, cache_size);
+                                                      chunk_size, value_chunk_size, cache_size, filters);
           }
         for(auto it = all_attr_values_uint8.cbegin(); it != all_attr_values_uint8.cend(); ++it)
           {
             const string& attr_name = it->first;
             cell::write_cell_attribute_map<uint8_t> (data_comm, file_name, attr_namespace, pop_name, pop_start,
                                                      attr_name, it->second, io_size, dflt_data_type,
-                                                     chunk_size, value_chunk_size, cache_size);
+                                                     chunk_size, value_chunk_size, cache_size, filters);
           }
         for(auto it = all_attr_values_int32.cbegin(); it != all_attr_values_int32.cend(); ++it)
           {
             const string& attr_name = it->first;
             cell::write_cell_attribute_map<int32_t> (data_comm, file_name, attr_namespace, pop_name, pop_start,
                                                      attr_name, it->second, io_size, dflt_data_type,
-                                                     chunk_size, value_chunk_size, cache_size);
+                                                     chunk_size, value_chunk_size, cache_size, filters);
           }
         for(auto it = all_attr_values_int16.cbegin(); it != all_attr_values_int16.cend(); ++it)
           {
             const string& attr_name = it->first;
             cell::write_cell_attribute_map<int16_t> (data_comm, file_name, attr_namespace, pop_name, pop_start,
                                                      attr_name, it->second, io_size, dflt_data_type,
-                                                     chunk_size, value_chunk_size, cache_size);
+                                                     chunk_size, value_chunk_size, cache_size, filters);
           }
         for(auto it = all_attr_values_int8.cbegin(); it != all_attr_values_int8.cend(); ++it)
           {
             const string& attr_name = it->first;
             cell::write_cell_attribute_map<int8_t> (data_comm, file_name, attr_namespace, pop_name, pop_start,
                                                     attr_name, it->second, io_size, dflt_data_type,
-                                                    chunk_size, value_chunk_size, cache_size);
+                                                    chunk_size, value_chunk_size, cache_size, filters);
           }
 
         
@@ -6527,6 +7882,174 @@ extern "C"
     Py_INCREF(Py_None);
     return Py_None;
   }
+
+
+  /* Appends requested with asynchronous=True are staged in C++
+   * containers and executed on the background queue, so that the
+   * collective write path overlaps with the caller's computation. Each
+   * append runs on its own duplicate communicator, concurrently with
+   * the caller's MPI calls, which requires MPI_THREAD_MULTIPLE; appends
+   * are executed synchronously on all ranks otherwise. HDF5 does not
+   * need to be thread-safe, since the other HDF5 calls of this module
+   * wait for the queue. At most append_queue_capacity appends are
+   * pending at a time. */
+  static const size_t append_queue_capacity = 4;
+
+  /* An append that is collective over comm. The ranks agree after each
+   * append whether it has failed on any of them, so that all ranks
+   * report the error and discard the same subsequent appends instead of
+   * waiting for each other. An error raised within a collective HDF5
+   * call still blocks the other ranks, as it does without the queue. */
+  struct CollectiveAppend
+  {
+    MPI_Comm comm;
+    MPI_Comm data_comm;
+    std::function<void()> append;
+
+    /* Returns the error to be raised on this rank, if any */
+    std::exception_ptr run()
+    {
+      std::exception_ptr e;
+      try
+        {
+          append();
+        }
+      catch (...)
+        {
+          e = std::current_exception();
+        }
+
+      int local_error = e ? 1 : 0, any_error = 0;
+      if (MPI_Allreduce(&local_error, &any_error, 1, MPI_INT, MPI_MAX, comm) != MPI_SUCCESS)
+        {
+          if (!e)
+            {
+              e = std::make_exception_ptr(std::runtime_error("append: MPI_Allreduce error"));
+            }
+        }
+      else if (any_error && !e)
+        {
+          e = std::make_exception_ptr(std::runtime_error("append: append failed on another rank"));
+        }
+      release();
+      return e;
+    }
+
+    void release()
+    {
+      if (data_comm != MPI_COMM_NULL)
+        {
+          MPI_Comm_free(&data_comm);
+        }
+      if (comm != MPI_COMM_NULL)
+        {
+          MPI_Comm_free(&comm);
+        }
+    }
+  };
+
+  /* Sets a Python RuntimeError from an error raised by an append */
+  static void append_queue_set_error(std::exception_ptr e)
+  {
+    try
+      {
+        std::rethrow_exception(e);
+      }
+    catch (const std::exception& ex)
+      {
+        PyErr_SetString(PyExc_RuntimeError, ex.what());
+      }
+    catch (...)
+      {
+        PyErr_SetString(PyExc_RuntimeError, "append: unknown error");
+      }
+  }
+
+  /* Determines on all ranks of comm whether an append can be executed
+   * in the background */
+  static bool append_queue_enabled(MPI_Comm comm, bool asynchronous)
+  {
+    int provided = MPI_THREAD_SINGLE;
+    throw_assert(MPI_Query_thread(&provided) == MPI_SUCCESS,
+                 "append_queue_enabled: unable to query MPI thread support");
+    int local_async = (asynchronous && (provided == MPI_THREAD_MULTIPLE)) ? 1 : 0;
+    int all_async = 0;
+    throw_assert(MPI_Allreduce(&local_async, &all_async, 1, MPI_INT, MPI_MIN, comm) == MPI_SUCCESS,
+                 "append_queue_enabled: MPI_Allreduce error");
+    return all_async > 0;
+  }
+
+  /* Executes an append, in the background if enabled; waits with the
+   * GIL released while the queue is full. Returns -1 with a Python
+   * exception set if this or an earlier append has failed; the error of
+   * a background append is raised until flush_appends clears it. */
+  static int append_queue_submit(bool enabled, CollectiveAppend task)
+  {
+    std::exception_ptr e;
+    Py_BEGIN_ALLOW_THREADS
+    background_queue.wait(enabled ? (append_queue_capacity - 1) : 0);
+    Py_END_ALLOW_THREADS
+    e = enabled ? background_queue.pending_error() : background_queue.take_error();
+    if (e)
+      {
+        task.release();
+      }
+    else if (enabled)
+      {
+        auto append = std::make_shared<CollectiveAppend>(std::move(task));
+        background_queue.submit([append] (bool discard) -> std::exception_ptr
+                                {
+                                  if (discard)
+                                    {
+                                      append->release();
+                                      return nullptr;
+                                    }
+                                  return append->run();
+                                });
+      }
+    else
+      {
+        Py_BEGIN_ALLOW_THREADS
+        e = task.run();
+        Py_END_ALLOW_THREADS
+      }
+    if (e)
+      {
+        append_queue_set_error(e);
+        return -1;
+      }
+    return 0;
+  }
+
+
+  PyDoc_STRVAR(
+    flush_appends_doc,
+    "flush_appends()\n"
+    "--\n"
+    "\n"
+    "Waits until all appends submitted with asynchronous=True on this rank have\n"
+    "been written and their files closed, and until the blocks being prefetched\n"
+    "by generators on this rank have been read. If an append has failed on any\n"
+    "rank, RuntimeError is raised on all ranks and the appends queued after it\n"
+    "are discarded. Appends are only executed in the background when MPI\n"
+    "provides MPI_THREAD_MULTIPLE on all ranks, and synchronously otherwise.\n"
+    "The other NeuroH5 functions wait for background appends by themselves;\n"
+    "call flush_appends() before accessing the appended files through other\n"
+    "modules, such as h5py.\n");
+
+  static PyObject *py_flush_appends (PyObject *self, PyObject *args)
+  {
+    background_io_drain();
+    std::exception_ptr e = background_queue.take_error();
+    if (e)
+      {
+        append_queue_set_error(e);
+        return NULL;
+      }
+    
+    Py_INCREF(Py_None);
+    return Py_None;
+  }
   
   
   static PyObject *py_append_cell_attributes (PyObject *self, PyObject *args, PyObject *kwds)
@@ -6542,6 +8065,9 @@ extern "C"
     unsigned long chunk_size = default_chunk_size;
     unsigned long value_chunk_size = default_value_chunk_size;
     unsigned long cache_size = default_cache_size;
+    PyObject *py_filters = NULL;
+    int subfile = 0;
+    int asynchronous = 0;
     char *file_name_arg, *pop_name_arg, *namespace_arg = (char *)default_namespace.c_str();
     herr_t status;
     
@@ -6555,14 +8081,21 @@ extern "C"
                                    "chunk_size",
                                    "value_chunk_size",
                                    "cache_size",
+                                   "filters",
+                                   "subfile",
+                                   "asynchronous",
                                    NULL};
 
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "ssO|sOkkkk", (char **)kwlist,
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "ssO|sOkkkkOii", (char **)kwlist,
                                      &file_name_arg, &pop_name_arg, &idx_values,
                                      &namespace_arg, &py_comm, 
-                                     &io_size, &chunk_size, &value_chunk_size, &cache_size))
+                                     &io_size, &chunk_size, &value_chunk_size, &cache_size,
+                                     &py_filters, &subfile, &asynchronous))
       return NULL;
+
+    const FilterConfig filters = py_get_filter_config(py_filters);
+    const WriteMode write_mode = (subfile > 0) ? WriteSubfile : WriteShared;
     MPI_Comm comm;
 
     if ((py_comm != NULL) && (py_comm != Py_None))
@@ -6598,84 +8131,40 @@ extern "C"
     else
       {
         MPI_Comm_split(comm,0,0,&data_comm);
-      }
-    MPI_Comm_set_errhandler(data_comm, MPI_ERRORS_RETURN);
-
-    if (dict_size > 0)
-      {
-        int srank, ssize; size_t size;
-        throw_assert(MPI_Comm_size(data_comm, &ssize) == MPI_SUCCESS,
-                     "py_append_cell_attributes: unable to obtain data communicator size");
-        throw_assert(MPI_Comm_rank(data_comm, &srank) == MPI_SUCCESS,
-                     "py_append_cell_attributes: unable to obtain data communicator rank");
-        throw_assert(ssize > 0, "py_append_cell_attributes: zero data communicator size");
-        throw_assert(srank >= 0, "py_append_cell_attributes: invalid data communicator rank");
-        size = ssize;
-    
-        if ((io_size == 0) || (io_size > size))
-          {
-            io_size = size;
-          }
-        throw_assert(io_size <= size,
-                     "py_append_cell_attributes: invalid I/O size");
-
-        string file_name      = string(file_name_arg);
-        string pop_name       = string(pop_name_arg);
-        string attr_namespace = string(namespace_arg);
-
-        pop_label_map_t pop_labels;
-        status = cell::read_population_labels(data_comm, string(file_name), pop_labels);
-        throw_assert (status >= 0,
-                      "py_append_cell_attributes: unable to read population labels");
-    
-        // Determine index of population to be read
-        pop_t pop_idx=0; bool pop_idx_set=false;
-        for (auto& x: pop_labels) 
-          {
-            if (get<1>(x) == pop_name)
-              {
-                pop_idx = get<0>(x);
-                pop_idx_set = true;
-              }
-          }
-        if (!pop_idx_set)
-          {
-            throw_err(std::string("py_append_cell_attributes: ") + "Population " + pop_name + " not found");
-          }
-        
-        pop_range_map_t pop_ranges;
-        size_t n_nodes;
-        
-        // Read population info
-        throw_assert(cell::read_population_ranges(data_comm, string(file_name), pop_ranges, n_nodes) >= 0,
-                     "py_append_cell_attributes: unable to read population ranges");                     
-
-        CELL_IDX_T pop_start = 0;
-        size_t pop_count = 0;
-        {
-          auto it = pop_ranges.find(pop_idx);
-          throw_assert(it != pop_ranges.end(),
-                       "py_append_cell_attributes: invalid population index");
-          pop_start = it->second.start;
-          pop_count = it->second.count;
-        }
+      }
+    MPI_Comm_set_errhandler(data_comm, MPI_ERRORS_RETURN);
 
-    
-    
-        int npy_type=0;
-    
-        vector<string> attr_names;
-        vector<int> attr_types;
-        
-        map<string, map<CELL_IDX_T, deque<uint32_t> >> all_attr_values_uint32;
-        map<string, map<CELL_IDX_T, deque<int32_t> >> all_attr_values_int32;
-        map<string, map<CELL_IDX_T, deque<uint16_t> >> all_attr_values_uint16;
-        map<string, map<CELL_IDX_T, deque<int16_t> >> all_attr_values_int16;
-        map<string, map<CELL_IDX_T, deque<uint8_t> >>  all_attr_values_uint8;
-        map<string, map<CELL_IDX_T, deque<int8_t> >>  all_attr_values_int8;
-        map<string, map<CELL_IDX_T, deque<float> >>  all_attr_values_float;
+    const bool async_append = append_queue_enabled(comm, asynchronous > 0);
 
-        const data::optional_hid dflt_data_type;
+    string file_name      = string(file_name_arg);
+    string pop_name       = string(pop_name_arg);
+    string attr_namespace = string(namespace_arg);
+
+    map<string, map<CELL_IDX_T, deque<uint32_t> >> all_attr_values_uint32;
+    map<string, map<CELL_IDX_T, deque<int32_t> >> all_attr_values_int32;
+    map<string, map<CELL_IDX_T, deque<uint16_t> >> all_attr_values_uint16;
+    map<string, map<CELL_IDX_T, deque<int16_t> >> all_attr_values_int16;
+    map<string, map<CELL_IDX_T, deque<uint8_t> >>  all_attr_values_uint8;
+    map<string, map<CELL_IDX_T, deque<int8_t> >>  all_attr_values_int8;
+    map<string, map<CELL_IDX_T, deque<float> >>  all_attr_values_float;
+
+    if (dict_size > 0)
+      {
+        int srank, ssize; size_t size;
+        throw_assert(MPI_Comm_size(data_comm, &ssize) == MPI_SUCCESS,
+                     "py_append_cell_attributes: unable to obtain data communicator size");
+        throw_assert(MPI_Comm_rank(data_comm, &srank) == MPI_SUCCESS,
+                     "py_append_cell_attributes: unable to obtain data communicator rank");
+        throw_assert(ssize > 0, "py_append_cell_attributes: zero data communicator size");
+        throw_assert(srank >= 0, "py_append_cell_attributes: invalid data communicator rank");
+        size = ssize;
+    
+        if ((io_size == 0) || (io_size > size))
+          {
+            io_size = size;
+          }
+        throw_assert(io_size <= size,
+                     "py_append_cell_attributes: invalid I/O size");
 
         build_cell_attr_value_maps(idx_values,
                                    all_attr_values_uint32,
@@ -6685,30 +8174,78 @@ extern "C"
                                    all_attr_values_int16,
                                    all_attr_values_int8,
                                    all_attr_values_float);
-
-        cell::append_cell_attribute_maps (data_comm, file_name,
-                                          attr_namespace, pop_name, pop_start,
-                                          all_attr_values_uint32,
-                                          all_attr_values_int32,
-                                          all_attr_values_uint16,
-                                          all_attr_values_int16,
-                                          all_attr_values_uint8,
-                                          all_attr_values_int8,
-                                          all_attr_values_float,
-                                          io_size, dflt_data_type,
-                                          IndexOwner, CellPtr(PtrOwner),
-                                          chunk_size, value_chunk_size, cache_size);
       }
+
+    // The Python values have been copied, the remainder does not
+    // require the interpreter and may run in the background
+    auto append = [=, all_attr_values_uint32 = std::move(all_attr_values_uint32),
+                   all_attr_values_int32 = std::move(all_attr_values_int32),
+                   all_attr_values_uint16 = std::move(all_attr_values_uint16),
+                   all_attr_values_int16 = std::move(all_attr_values_int16),
+                   all_attr_values_uint8 = std::move(all_attr_values_uint8),
+                   all_attr_values_int8 = std::move(all_attr_values_int8),
+                   all_attr_values_float = std::move(all_attr_values_float)] () mutable
+      {
+        if (dict_size > 0)
+          {
+            pop_label_map_t pop_labels;
+            herr_t status = cell::read_population_labels(data_comm, string(file_name), pop_labels);
+            throw_assert (status >= 0,
+                          "py_append_cell_attributes: unable to read population labels");
     
-    throw_assert(MPI_Barrier(data_comm) == MPI_SUCCESS,
-                 "py_append_cell_attributes: error in MPI barrier on data communicator");
-    throw_assert(MPI_Barrier(comm) == MPI_SUCCESS,
-                 "py_append_cell_attributes: error in MPI barrier");
+            // Determine index of population to be read
+            pop_t pop_idx=0; bool pop_idx_set=false;
+            for (auto& x: pop_labels) 
+              {
+                if (get<1>(x) == pop_name)
+                  {
+                    pop_idx = get<0>(x);
+                    pop_idx_set = true;
+                  }
+              }
+            if (!pop_idx_set)
+              {
+                throw_err(std::string("py_append_cell_attributes: ") + "Population " + pop_name + " not found");
+              }
+        
+            pop_range_map_t pop_ranges;
+            size_t n_nodes;
+        
+            // Read population info
+            throw_assert(cell::read_population_ranges(data_comm, string(file_name), pop_ranges, n_nodes) >= 0,
+                         "py_append_cell_attributes: unable to read population ranges");                     
 
-    throw_assert(MPI_Comm_free(&data_comm) == MPI_SUCCESS,
-                 "py_append_cell_attributes: unable to free data MPI communicator");
-    throw_assert(MPI_Comm_free(&comm) == MPI_SUCCESS,
-                 "py_append_cell_attributes: unable to free MPI communicator");
+            CELL_IDX_T pop_start = 0;
+            {
+              auto it = pop_ranges.find(pop_idx);
+              throw_assert(it != pop_ranges.end(),
+                           "py_append_cell_attributes: invalid population index");
+              pop_start = it->second.start;
+            }
+
+            const data::optional_hid dflt_data_type;
+
+            cell::append_cell_attribute_maps (data_comm, file_name,
+                                              attr_namespace, pop_name, pop_start,
+                                              all_attr_values_uint32,
+                                              all_attr_values_int32,
+                                              all_attr_values_uint16,
+                                              all_attr_values_int16,
+                                              all_attr_values_uint8,
+                                              all_attr_values_int8,
+                                              all_attr_values_float,
+                                              io_size, dflt_data_type,
+                                              IndexOwner, CellPtr(PtrOwner),
+                                              chunk_size, value_chunk_size, cache_size, filters,
+                                              write_mode);
+          }
+      };
+
+    // The communicators are freed once the append has completed on all ranks
+    if (append_queue_submit(async_append, CollectiveAppend { comm, data_comm, std::move(append) }) < 0)
+      {
+        return NULL;
+      }
     
     Py_INCREF(Py_None);
     return Py_None;
@@ -6728,6 +8265,8 @@ extern "C"
     unsigned long chunk_size = default_chunk_size;
     unsigned long value_chunk_size = default_value_chunk_size;
     unsigned long cache_size = default_cache_size;
+    int asynchronous = 0;
+    double quantize = 0.0;
     char *file_name_arg, *pop_name_arg;
     herr_t status;
     
@@ -6740,14 +8279,21 @@ extern "C"
                                    "chunk_size",
                                    "value_chunk_size",
                                    "cache_size",
+                                   "asynchronous",
+                                   "quantize",
                                    NULL};
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "ssO|Okkkk", (char **)kwlist,
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "ssO|Okkkkid", (char **)kwlist,
                                      &file_name_arg, &pop_name_arg, &idx_values,
                                      &py_comm, &io_size,
-                                     &chunk_size, &value_chunk_size, &cache_size))
+                                     &chunk_size, &value_chunk_size, &cache_size,
+                                     &asynchronous, &quantize))
       return NULL;
 
+    // quantize > 0 stores the points with TreeQuantized encoding and
+    // the given precision bound
+    const TreeEncoding encoding = (quantize > 0.0) ? TreeEncoding(TreeQuantized, quantize) : TreeEncoding();
+
     MPI_Comm comm;
 
     if ((py_comm != NULL) && (py_comm != Py_None))
@@ -6797,6 +8343,12 @@ extern "C"
 
     size = ssize;
 
+    const bool async_append = append_queue_enabled(comm, asynchronous > 0);
+
+    string file_name      = string(file_name_arg);
+    string pop_name       = string(pop_name_arg);
+    forward_list<neurotree_t> tree_list;
+
     if (dict_size > 0)
       {
     
@@ -6807,47 +8359,6 @@ extern "C"
         throw_assert(io_size <= size,
                      "py_append_cell_trees: invalid I/O size");
         
-        string file_name      = string(file_name_arg);
-        string pop_name       = string(pop_name_arg);
-        
-        pop_label_map_t pop_labels;
-        status = cell::read_population_labels(data_comm, string(file_name), pop_labels);
-        throw_assert (status >= 0,
-                      "py_append_cell_trees: unable to read population labels");
-        
-        // Determine index of population to be read
-        pop_t pop_idx=0; bool pop_idx_set=false;
-        for (auto& x: pop_labels) 
-          {
-            if (get<1>(x) == pop_name)
-              {
-                pop_idx = get<0>(x);
-                pop_idx_set = true;
-              }
-          }
-        if (!pop_idx_set)
-          {
-            throw_err(std::string("py_append_cell_trees: ") + "Population " + pop_name + " not found");
-          }
-        
-        
-        pop_range_map_t pop_ranges;
-        size_t n_nodes;
-        
-        // Read population info
-        throw_assert(cell::read_population_ranges(data_comm, string(file_name), pop_ranges, n_nodes) >= 0,
-                     "py_append_cell_trees: unable to read population ranges");
-        
-        CELL_IDX_T pop_start = 0;
-        size_t pop_count = 0;
-        {
-          auto it = pop_ranges.find(pop_idx);
-          throw_assert(it != pop_ranges.end(),
-                       "py_append_cell_trees: invalid population index");
-          pop_start = it->second.start;
-          pop_count = it->second.count;
-        }
-        
 
         map<string, map<CELL_IDX_T, deque<uint32_t> >> all_attr_values_uint32;
         map<string, map<CELL_IDX_T, deque<int32_t> >> all_attr_values_int32;
@@ -6899,7 +8410,6 @@ extern "C"
         throw_assert(dst_map_it != all_attr_values_uint16.end(),
                      "py_append_cell_trees: input data has no dst array");
     
-        forward_list<neurotree_t> tree_list;
         
         map<CELL_IDX_T, deque<float> >& xcoord_values = xcoord_map_it->second;
         map<CELL_IDX_T, deque<float> >& ycoord_values = ycoord_map_it->second;
@@ -6947,19 +8457,60 @@ extern "C"
               ++layer_it, ++swc_type_it;
           }
     
-        throw_assert(cell::append_trees (data_comm, file_name, pop_name, pop_start, tree_list,
-                                         io_size, chunk_size, value_chunk_size) >= 0,
-                     "py_append_cell_trees: unable to append trees");
       }
-    throw_assert(MPI_Barrier(data_comm) == MPI_SUCCESS,
-                 "py_append_cell_trees: MPI barrier error");
-    throw_assert(MPI_Barrier(comm) == MPI_SUCCESS,
-                 "py_append_cell_trees: MPI barrier error");
-    
-    throw_assert(MPI_Comm_free(&data_comm) == MPI_SUCCESS,
-                 "py_append_cell_trees: unable to free data MPI communicator");
-    throw_assert(MPI_Comm_free(&comm) == MPI_SUCCESS,
-                 "py_append_cell_trees: unable to free MPI communicator");
+
+    // The Python values have been copied, the remainder does not
+    // require the interpreter and may run in the background
+    auto append = [=, tree_list = std::move(tree_list)] () mutable
+      {
+        if (dict_size > 0)
+          {
+            pop_label_map_t pop_labels;
+            herr_t status = cell::read_population_labels(data_comm, string(file_name), pop_labels);
+            throw_assert (status >= 0,
+                          "py_append_cell_trees: unable to read population labels");
+        
+            // Determine index of population to be read
+            pop_t pop_idx=0; bool pop_idx_set=false;
+            for (auto& x: pop_labels) 
+              {
+                if (get<1>(x) == pop_name)
+                  {
+                    pop_idx = get<0>(x);
+                    pop_idx_set = true;
+                  }
+              }
+            if (!pop_idx_set)
+              {
+                throw_err(std::string("py_append_cell_trees: ") + "Population " + pop_name + " not found");
+              }
+        
+            pop_range_map_t pop_ranges;
+            size_t n_nodes;
+        
+            // Read population info
+            throw_assert(cell::read_population_ranges(data_comm, string(file_name), pop_ranges, n_nodes) >= 0,
+                         "py_append_cell_trees: unable to read population ranges");
+        
+            CELL_IDX_T pop_start = 0;
+            {
+              auto it = pop_ranges.find(pop_idx);
+              throw_assert(it != pop_ranges.end(),
+                           "py_append_cell_trees: invalid population index");
+              pop_start = it->second.start;
+            }
+
+            throw_assert(cell::append_trees (data_comm, file_name, pop_name, pop_start, tree_list,
+                                             io_size, chunk_size, value_chunk_size, encoding) >= 0,
+                         "py_append_cell_trees: unable to append trees");
+          }
+      };
+
+    // The communicators are freed once the append has completed on all ranks
+    if (append_queue_submit(async_append, CollectiveAppend { comm, data_comm, std::move(append) }) < 0)
+      {
+        return NULL;
+      }
     
     Py_INCREF(Py_None);
     return Py_None;
@@ -6976,8 +8527,17 @@ extern "C"
    * seq_index: index of the next edge in the sequence to yield
    * start_index: starting index of the next batch of edges to read from file
    * cache_size: how many edge blocks to read from file at at time
+   * prefetch_comm: if not null, the next block is read in the
+   *   background on this communicator while the current one is consumed
    *
    */
+  typedef struct {
+    vector <edge_map_t> prj_vector;
+    vector < map <string, vector < vector<string> > > > edge_attr_name_vector;
+    size_t local_num_nodes, local_num_edges, total_num_edges;
+    hsize_t total_read_blocks;
+  } NeuroH5ProjectionBlock;
+  
   typedef struct {
     Py_ssize_t node_index, node_count, block_index, block_count, cache_index, cache_size, io_size, comm_size;
 
@@ -6990,7 +8550,7 @@ extern "C"
     set< pair<pop_t, pop_t> > pop_pairs;
     pop_label_map_t pop_labels;
     vector<pair<string,string> > prj_names;
-    node_rank_map_t node_rank_map;
+    data::NodeRankMap node_rank_map;
     edge_map_t edge_map;
     edge_map_iter_t edge_map_iter;
     map <string, vector< vector<string> > > edge_attr_names;
@@ -6999,6 +8559,9 @@ extern "C"
     size_t total_num_nodes, local_num_nodes, total_num_edges, local_num_edges;
     hsize_t total_read_blocks;
     NODE_IDX_T dst_start, src_start;
+    MPI_Comm prefetch_comm;
+    future<int> prefetch_result;
+    NeuroH5ProjectionBlock prefetch_block;
 
   } NeuroH5ProjectionGenState;
 
@@ -7016,6 +8579,11 @@ extern "C"
    * seq_index: index of the next tree in the sequence to yield
    * start_index: starting index of the next batch of trees to read from file
    * cache_size: how many trees to read from file at at time
+   * prefetch_comm: if not null, the next block is read in the
+   *   background on this communicator while the current one is consumed
+   * tree_arena: trees of the current block; the arrays of the yielded
+   *   trees keep it alive
+   * tree_order: positions of the trees of tree_arena in ascending id order
    *
    */
   typedef struct {
@@ -7029,14 +8597,19 @@ extern "C"
     string file_name;
     MPI_Comm comm;
     pop_range_map_t pop_ranges;
-    map<CELL_IDX_T, neurotree_t> tree_map;
+    shared_ptr<data::TreeArena> tree_arena;
+    vector<size_t> tree_order;
     vector<string> attr_name_spaces;
     map <string, NamedAttrMap> attr_maps;
     map <string, vector< vector <string> > > attr_names;
-    map<CELL_IDX_T, neurotree_t>::const_iterator it_tree;
-    node_rank_map_t node_rank_map;
+    vector<size_t>::const_iterator it_tree;
+    data::NodeRankMap node_rank_map;
     bool topology_flag;
     bool validate_flag;
+    MPI_Comm prefetch_comm;
+    future<int> prefetch_result;
+    data::TreeArena prefetch_tree_arena;
+    map <string, NamedAttrMap> prefetch_attr_maps;
     
   } NeuroH5TreeGenState;
 
@@ -7056,6 +8629,10 @@ extern "C"
    * seq_index: index of the next id in the sequence to yield
    * start_index: starting index of the next batch of trees to read from file
    * cache_size: how many trees to read from file at at time
+   * prefetch_comm: if not null, the next block is read in the
+   *   background on this communicator while the current one is consumed
+   * attr_map: values of the current block, one column per attribute;
+   *   it_idx is the position in its sorted cell index
    *
    */
   typedef struct {
@@ -7072,14 +8649,17 @@ extern "C"
     pop_range_map_t pop_ranges;
     string attr_namespace;
     set <string> attr_mask;
-    NamedAttrMap attr_map;
+    NamedColumnarAttrMap attr_map;
     vector< vector <string> > attr_names;
-    set<CELL_IDX_T>::const_iterator it_idx;
-    node_rank_map_t node_rank_map;
+    vector<CELL_IDX_T>::const_iterator it_idx;
+    data::NodeRankMap node_rank_map;
     PyTypeObject* struct_type;
     vector<PyStructSequence_Field> struct_descr_fields;
     PyObject *tuple_index_info;
     return_type return_tp;
+    MPI_Comm prefetch_comm;
+    future<int> prefetch_result;
+    NamedColumnarAttrMap prefetch_attr_map;
     
   } NeuroH5CellAttrGenState;
   
@@ -7088,6 +8668,160 @@ extern "C"
     NeuroH5CellAttrGenState *state;
   } PyNeuroH5CellAttrGenState;
 
+
+  /* Background reads of generator blocks run collectives on a separate
+   * communicator concurrently with MPI calls made by the consumer, which
+   * requires MPI_THREAD_MULTIPLE; HDF5 access is serialized by the
+   * background queue. Prefetch is disabled on all ranks unless
+   * MPI_THREAD_MULTIPLE is provided on all ranks. */
+  static MPI_Comm gen_prefetch_comm(MPI_Comm comm, bool prefetch)
+  {
+    MPI_Comm prefetch_comm = MPI_COMM_NULL;
+    int provided = MPI_THREAD_SINGLE;
+    throw_assert(MPI_Query_thread(&provided) == MPI_SUCCESS,
+                 "gen_prefetch_comm: unable to query MPI thread support");
+    int local_prefetch = (prefetch && (provided == MPI_THREAD_MULTIPLE)) ? 1 : 0;
+    int all_prefetch = 0;
+    throw_assert(MPI_Allreduce(&local_prefetch, &all_prefetch, 1, MPI_INT, MPI_MIN, comm) == MPI_SUCCESS,
+                 "gen_prefetch_comm: MPI_Allreduce error");
+    if (all_prefetch > 0)
+      {
+        throw_assert(MPI_Comm_dup(comm, &prefetch_comm) == MPI_SUCCESS,
+                     "gen_prefetch_comm: unable to duplicate MPI communicator");
+      }
+    return prefetch_comm;
+  }
+
+  /* Queues the background read of the next block; errors raised by the
+   * read are returned through the future and do not affect other
+   * background work. */
+  static future<int> gen_prefetch_submit(std::function<int()> read)
+  {
+    auto task = std::make_shared< std::packaged_task<int()> >(std::move(read));
+    future<int> result = task->get_future();
+    background_queue.submit([task] (bool) -> std::exception_ptr
+                            {
+                              (*task)();
+                              return nullptr;
+                            });
+    return result;
+  }
+
+  /* Waits with the GIL released for the background read of the next
+   * block; errors raised by the read are rethrown here. */
+  static int gen_prefetch_wait(future<int>& prefetch_result)
+  {
+    Py_BEGIN_ALLOW_THREADS
+    prefetch_result.wait();
+    Py_END_ALLOW_THREADS
+    return prefetch_result.get();
+  }
+
+  static void gen_prefetch_free(future<int>& prefetch_result, MPI_Comm& prefetch_comm)
+  {
+    if (prefetch_result.valid())
+      {
+        try
+          {
+            gen_prefetch_wait(prefetch_result);
+          }
+        catch (...)
+          {
+          }
+      }
+    if (prefetch_comm != MPI_COMM_NULL)
+      {
+        throw_assert(MPI_Comm_free(&prefetch_comm) == MPI_SUCCESS,
+                     "gen_prefetch_free: unable to free MPI communicator");
+      }
+  }
+  
+  static void neuroh5_prj_gen_prefetch(NeuroH5ProjectionGenState *state)
+  {
+    NeuroH5ProjectionBlock& block = state->prefetch_block;
+    block.prj_vector.clear();
+    block.edge_attr_name_vector.clear();
+    const size_t offset = state->block_index;
+    state->prefetch_result =
+      gen_prefetch_submit([state, offset, &block] ()
+                          {
+                            return graph::scatter_read_projection(state->prefetch_comm,
+                                                                  state->io_size,
+                                                                  state->edge_map_type,
+                                                                  state->file_name,
+                                                                  state->src_pop_name,
+                                                                  state->dst_pop_name,
+                                                                  state->src_start,
+                                                                  state->dst_start,
+                                                                  state->edge_attr_name_spaces,
+                                                                  state->node_rank_map,
+                                                                  state->pop_search_ranges,
+                                                                  state->pop_pairs,
+                                                                  block.prj_vector,
+                                                                  block.edge_attr_name_vector,
+                                                                  block.local_num_nodes,
+                                                                  block.local_num_edges,
+                                                                  block.total_num_edges,
+                                                                  block.total_read_blocks,
+                                                                  offset,
+                                                                  state->cache_size);
+                          });
+  }
+
+  static void neuroh5_tree_gen_set_arena(NeuroH5TreeGenState *state,
+                                         data::TreeArena&& tree_arena)
+  {
+    state->tree_arena = make_shared<data::TreeArena>(std::move(tree_arena));
+    const vector<CELL_IDX_T>& index = state->tree_arena->index;
+    state->tree_order.resize(index.size());
+    std::iota(state->tree_order.begin(), state->tree_order.end(), 0);
+    std::sort(state->tree_order.begin(), state->tree_order.end(),
+              [&index] (size_t a, size_t b) { return index[a] < index[b]; });
+    state->it_tree = state->tree_order.cbegin();
+  }
+
+  static void neuroh5_tree_gen_prefetch(NeuroH5TreeGenState *state)
+  {
+    state->prefetch_tree_arena.clear();
+    state->prefetch_attr_maps.clear();
+    const size_t offset = state->cache_index;
+    state->prefetch_result =
+      gen_prefetch_submit([state, offset] ()
+                          {
+                            return cell::scatter_read_trees (state->prefetch_comm,
+                                                             state->file_name,
+                                                             state->io_size,
+                                                             state->attr_name_spaces,
+                                                             state->node_rank_map,
+                                                             state->pop_name,
+                                                             state->pop_start,
+                                                             state->prefetch_tree_arena,
+                                                             state->prefetch_attr_maps,
+                                                             offset,
+                                                             state->cache_size);
+                          });
+  }
+
+  static void neuroh5_cell_attr_gen_prefetch(NeuroH5CellAttrGenState *state)
+  {
+    state->prefetch_attr_map.clear();
+    const size_t offset = state->cache_index;
+    state->prefetch_result =
+      gen_prefetch_submit([state, offset] ()
+                          {
+                            return cell::scatter_read_cell_attributes (state->prefetch_comm,
+                                                                       state->file_name,
+                                                                       state->io_size,
+                                                                       state->attr_namespace,
+                                                                       state->attr_mask,
+                                                                       state->node_rank_map,
+                                                                       state->pop_name,
+                                                                       state->pop_start,
+                                                                       state->prefetch_attr_map,
+                                                                       offset,
+                                                                       state->cache_size);
+                          });
+  }
   
   static PyObject *
   neuroh5_prj_gen_new(PyTypeObject *type, PyObject *args, PyObject *kwargs)
@@ -7098,6 +8832,7 @@ extern "C"
     PyObject *py_comm = NULL;
     MPI_Comm *comm_ptr  = NULL;
     unsigned int io_size=0, cache_size=1;
+    int prefetch_flag=0;
     char *file_name, *src_pop_name, *dst_pop_name;
     PyObject* py_attr_name_spaces = NULL;
     pop_range_map_t pop_ranges;
@@ -7115,14 +8850,17 @@ extern "C"
                                    "comm",
                                    "io_size",
                                    "cache_size",
+                                   "prefetch",
                                    NULL};
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "sss|OiOii", (char **)kwlist,
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "sss|OiOiii", (char **)kwlist,
                                      &file_name, &src_pop_name, &dst_pop_name, 
                                      &py_attr_name_spaces, &opt_edge_map_type,
-                                     &py_comm, &io_size, &cache_size))
+                                     &py_comm, &io_size, &cache_size, &prefetch_flag))
       return NULL;
 
+    background_io_drain();
+
     MPI_Comm comm;
 
     if ((py_comm != NULL) && (py_comm != Py_None))
@@ -7203,6 +8941,7 @@ extern "C"
 
     throw_assert(MPI_Comm_dup(comm, &(py_ngg->state->comm)) == MPI_SUCCESS, 
                  "NeuroH5ProjectionGen: unable to duplicate MPI communicator");
+    py_ngg->state->prefetch_comm = gen_prefetch_comm(comm, prefetch_flag > 0);
     throw_assert(MPI_Comm_free(&comm) == MPI_SUCCESS,
                  "NeuroH5ProjectionGen: unable to free MPI communicator");
 
@@ -7279,6 +9018,7 @@ extern "C"
     PyObject *py_comm = NULL;
     MPI_Comm *comm_ptr  = NULL;
     unsigned int io_size=0, cache_size=1;
+    int prefetch_flag=0;
     char *file_name, *pop_name;
     PyObject* py_attr_name_spaces = NULL;
     vector<string> attr_name_spaces;
@@ -7293,14 +9033,18 @@ extern "C"
                                    "node_allocation",
                                    "io_size",
                                    "cache_size",
+                                   "prefetch",
                                    NULL};
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "ss|OiiOOii", (char **)kwlist,
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "ss|OiiOOiii", (char **)kwlist,
                                      &file_name, &pop_name, 
                                      &py_attr_name_spaces, &topology_flag, &validate_flag,
-                                     &py_comm, &py_node_allocation, &io_size, &cache_size))
+                                     &py_comm, &py_node_allocation, &io_size, &cache_size,
+                                     &prefetch_flag))
       return NULL;
 
+    background_io_drain();
+
     MPI_Comm comm;
 
     if ((py_comm != NULL) && (py_comm != Py_None))
@@ -7402,6 +9146,7 @@ extern "C"
     
     throw_assert(MPI_Comm_dup(comm, &(py_ntrg->state->comm)) == MPI_SUCCESS,
                  "NeuroH5TreeGen: unable to duplicate MPI communicator");
+    py_ntrg->state->prefetch_comm = gen_prefetch_comm(comm, prefetch_flag > 0);
 
     throw_assert(MPI_Comm_free(&comm) == MPI_SUCCESS,
                  "NeuroH5TreeGen: unable to free MPI communicator");
@@ -7424,9 +9169,7 @@ extern "C"
     py_ntrg->state->topology_flag  = topology_flag;
     py_ntrg->state->validate_flag  = validate_flag;
 
-    map<CELL_IDX_T, neurotree_t> tree_map;
-    py_ntrg->state->tree_map = tree_map;
-    py_ntrg->state->it_tree  = py_ntrg->state->tree_map.cbegin();
+    neuroh5_tree_gen_set_arena(py_ntrg->state, data::TreeArena());
 
     return (PyObject *)py_ntrg;
   }
@@ -7442,6 +9185,7 @@ extern "C"
     PyObject *py_node_allocation = NULL;
     MPI_Comm *comm_ptr  = NULL;
     unsigned long io_size=1, cache_size=1;
+    int prefetch_flag=0;
     const string default_namespace = "Attributes";
     char *file_name, *pop_name, *attr_namespace = (char *)default_namespace.c_str();
     return_type return_tp = return_dict;
@@ -7458,15 +9202,19 @@ extern "C"
                                    "cache_size",
                                    "return_type",
                                    "tuple_index_dict",
+                                   "prefetch",
                                    NULL};
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "sss|OOOkisO", (char **)kwlist,
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "sss|OOOkisOi", (char **)kwlist,
                                      &file_name, &pop_name, &attr_namespace, 
                                      &py_comm, &py_node_allocation, &py_mask, 
                                      &io_size, &cache_size,
-                                     &return_type_arg, &py_tuple_index_dict))
+                                     &return_type_arg, &py_tuple_index_dict,
+                                     &prefetch_flag))
       return NULL;
 
+    background_io_drain();
+
     if (return_type_arg != NULL)
       {
         string return_type_str = string(return_type_arg);
@@ -7580,6 +9328,7 @@ extern "C"
     
     throw_assert(MPI_Comm_dup(comm, &(py_ntrg->state->comm)) == MPI_SUCCESS,
                  "NeuroH5CellAttrGen: unable to duplicate MPI communicator");
+    py_ntrg->state->prefetch_comm = gen_prefetch_comm(comm, prefetch_flag > 0);
     
     py_ntrg->state->pos            = seq_next;
     py_ntrg->state->count          = count;
@@ -7601,9 +9350,9 @@ extern "C"
     py_ntrg->state->return_tp      = return_tp;
     py_ntrg->state->tuple_index_info = NULL;
     
-    NamedAttrMap attr_map;
+    NamedColumnarAttrMap attr_map;
     py_ntrg->state->attr_map  = attr_map;
-    py_ntrg->state->it_idx = py_ntrg->state->attr_map.index_set.cbegin();
+    py_ntrg->state->it_idx = py_ntrg->state->attr_map.index.cbegin();
 
     return (PyObject *)py_ntrg;
   }
@@ -7611,6 +9360,7 @@ extern "C"
   static void
   neuroh5_tree_gen_dealloc(PyNeuroH5TreeGenState *py_ntrg)
   {
+    gen_prefetch_free(py_ntrg->state->prefetch_result, py_ntrg->state->prefetch_comm);
     if (py_ntrg->state->comm != MPI_COMM_NULL)
       {
         int status = MPI_Comm_free(&(py_ntrg->state->comm));
@@ -7628,6 +9378,7 @@ extern "C"
     Py_XDECREF(py_ntrg->state->struct_type);
 #endif
     Py_XDECREF(py_ntrg->state->tuple_index_info);
+    gen_prefetch_free(py_ntrg->state->prefetch_result, py_ntrg->state->prefetch_comm);
     if (py_ntrg->state->comm != MPI_COMM_NULL)
       {
         int status = MPI_Comm_free(&(py_ntrg->state->comm));
@@ -7642,6 +9393,7 @@ extern "C"
   static void
   neuroh5_prj_gen_dealloc(PyNeuroH5ProjectionGenState *py_ngg)
   {
+    gen_prefetch_free(py_ngg->state->prefetch_result, py_ngg->state->prefetch_comm);
     if (py_ngg->state->comm != MPI_COMM_NULL)
       {
         int status = MPI_Comm_free(&(py_ngg->state->comm));
@@ -7675,45 +9427,70 @@ extern "C"
           // If the end of the current cache block has been reached,
           // and the iterator has not exceed its locally assigned elements,
           // read the next block
-          if ((py_ntrg->state->it_tree == py_ntrg->state->tree_map.cend()) &&
+          if ((py_ntrg->state->it_tree == py_ntrg->state->tree_order.cend()) &&
               (py_ntrg->state->cache_index < py_ntrg->state->count))
             {
               int status;
-              py_ntrg->state->tree_map.clear();
+              data::TreeArena tree_arena;
               py_ntrg->state->attr_maps.clear();
 
-              throw_assert(MPI_Barrier(py_ntrg->state->comm) == MPI_SUCCESS, "NeuroH5TreeGen: MPI_Barrier error");
-
-              status = cell::scatter_read_trees (py_ntrg->state->comm,
-                                                 py_ntrg->state->file_name,
-                                                 py_ntrg->state->io_size,
-                                                 py_ntrg->state->attr_name_spaces,
-                                                 py_ntrg->state->node_rank_map,
-                                                 py_ntrg->state->pop_name,
-                                                 py_ntrg->state->pop_start,
-                                                 py_ntrg->state->tree_map,
-                                                 py_ntrg->state->attr_maps,
-                                                 py_ntrg->state->cache_index,
-                                                 py_ntrg->state->cache_size);
-              throw_assert (status >= 0,
-                            "NeuroH5TreeGen: error in call to cell::scatter_read_trees");
-
-              throw_assert(MPI_Barrier(py_ntrg->state->comm) == MPI_SUCCESS, "NeuroH5TreeGen: MPI_Barrier error");
+              if (py_ntrg->state->prefetch_comm != MPI_COMM_NULL)
+                {
+                  if (!py_ntrg->state->prefetch_result.valid())
+                    {
+                      neuroh5_tree_gen_prefetch(py_ntrg->state);
+                    }
+                  status = gen_prefetch_wait(py_ntrg->state->prefetch_result);
+                  throw_assert (status >= 0,
+                                "NeuroH5TreeGen: error in call to cell::scatter_read_trees");
+                  tree_arena = std::move(py_ntrg->state->prefetch_tree_arena);
+                  py_ntrg->state->attr_maps = std::move(py_ntrg->state->prefetch_attr_maps);
+                }
+              else
+                {
+                  background_io_drain();
+                  throw_assert(MPI_Barrier(py_ntrg->state->comm) == MPI_SUCCESS, "NeuroH5TreeGen: MPI_Barrier error");
+
+                  status = cell::scatter_read_trees (py_ntrg->state->comm,
+                                                     py_ntrg->state->file_name,
+                                                     py_ntrg->state->io_size,
+                                                     py_ntrg->state->attr_name_spaces,
+                                                     py_ntrg->state->node_rank_map,
+                                                     py_ntrg->state->pop_name,
+                                                     py_ntrg->state->pop_start,
+                                                     tree_arena,
+                                                     py_ntrg->state->attr_maps,
+                                                     py_ntrg->state->cache_index,
+                                                     py_ntrg->state->cache_size);
+                  throw_assert (status >= 0,
+                                "NeuroH5TreeGen: error in call to cell::scatter_read_trees");
+
+                  throw_assert(MPI_Barrier(py_ntrg->state->comm) == MPI_SUCCESS, "NeuroH5TreeGen: MPI_Barrier error");
+                }
 
               if (py_ntrg->state->cache_index < py_ntrg->state->count)
                 {
                   py_ntrg->state->cache_index += py_ntrg->state->comm_size * py_ntrg->state->cache_size;
                 }
-              py_ntrg->state->it_tree = py_ntrg->state->tree_map.cbegin();
+              neuroh5_tree_gen_set_arena(py_ntrg->state, std::move(tree_arena));
+
+              // start reading the next block while this one is consumed
+              if ((py_ntrg->state->prefetch_comm != MPI_COMM_NULL) &&
+                  (py_ntrg->state->cache_index < py_ntrg->state->count))
+                {
+                  neuroh5_tree_gen_prefetch(py_ntrg->state);
+                }
             }
 
-          if (py_ntrg->state->it_tree == py_ntrg->state->tree_map.cend())
+          if (py_ntrg->state->it_tree == py_ntrg->state->tree_order.cend())
             {
               if (py_ntrg->state->seq_index == py_ntrg->state->max_local_count)
                 {
                   int status = MPI_Barrier(py_ntrg->state->comm);
                   throw_assert(status == MPI_SUCCESS, "NeuroH5TreeGen: MPI_Barrier error");
 
+                  gen_prefetch_free(py_ntrg->state->prefetch_result, py_ntrg->state->prefetch_comm);
+
                   status = MPI_Comm_free(&(py_ntrg->state->comm));
                   throw_assert(status == MPI_SUCCESS,
                                "NeuroH5TreeGen: unable to free MPI communicator");
@@ -7732,9 +9509,10 @@ extern "C"
             }
           else
             {
-              CELL_IDX_T key = py_ntrg->state->it_tree->first;
-              const neurotree_t &tree = py_ntrg->state->it_tree->second;
-              PyObject *elem = py_build_tree_value(key, tree, py_ntrg->state->attr_maps,
+              const size_t tree_pos = *(py_ntrg->state->it_tree);
+              CELL_IDX_T key = py_ntrg->state->tree_arena->index[tree_pos];
+              PyObject *elem = py_build_tree_value(key, py_ntrg->state->tree_arena, tree_pos,
+                                                   py_ntrg->state->attr_maps,
                                                    py_ntrg->state->topology_flag,
                                                    py_ntrg->state->validate_flag);
               throw_assert(elem != NULL,
@@ -7757,6 +9535,8 @@ extern "C"
               int status = MPI_Barrier(py_ntrg->state->comm);
               throw_assert(status == MPI_SUCCESS, "NeuroH5CellTreeGen: MPI_Barrier error");
 
+              gen_prefetch_free(py_ntrg->state->prefetch_result, py_ntrg->state->prefetch_comm);
+
               status = MPI_Comm_free(&(py_ntrg->state->comm));
               throw_assert(status == MPI_SUCCESS,
                            "NeuroH5TreeGen: unable to free MPI communicator");
@@ -7803,7 +9583,7 @@ extern "C"
         {
           
 
-          if ((py_ntrg->state->it_idx == py_ntrg->state->attr_map.index_set.cend()) &&
+          if ((py_ntrg->state->it_idx == py_ntrg->state->attr_map.index.cend()) &&
               (py_ntrg->state->cache_index < py_ntrg->state->count))
             {
               int size, rank;
@@ -7816,29 +9596,51 @@ extern "C"
               // read the next block
               py_ntrg->state->attr_map.clear();
 
-              throw_assert(MPI_Barrier(py_ntrg->state->comm) == MPI_SUCCESS, "NeuroH5CellAttrGen: MPI_Barrier error");
-              int status = cell::scatter_read_cell_attributes (py_ntrg->state->comm,
-                                                               py_ntrg->state->file_name,
-                                                               py_ntrg->state->io_size,
-                                                               py_ntrg->state->attr_namespace,
-                                                               py_ntrg->state->attr_mask,
-                                                               py_ntrg->state->node_rank_map,
-                                                               py_ntrg->state->pop_name,
-                                                               py_ntrg->state->pop_start,
-                                                               py_ntrg->state->attr_map,
-                                                               py_ntrg->state->cache_index,
-                                                               py_ntrg->state->cache_size);
+              if (py_ntrg->state->prefetch_comm != MPI_COMM_NULL)
+                {
+                  if (!py_ntrg->state->prefetch_result.valid())
+                    {
+                      neuroh5_cell_attr_gen_prefetch(py_ntrg->state);
+                    }
+                  int status = gen_prefetch_wait(py_ntrg->state->prefetch_result);
+                  throw_assert (status >= 0,
+                                "NeuroH5CellAttrGen: error in call to cell::scatter_read_cell_attributes");
+                  py_ntrg->state->attr_map = std::move(py_ntrg->state->prefetch_attr_map);
+                }
+              else
+                {
+                  background_io_drain();
+                  throw_assert(MPI_Barrier(py_ntrg->state->comm) == MPI_SUCCESS, "NeuroH5CellAttrGen: MPI_Barrier error");
+                  int status = cell::scatter_read_cell_attributes (py_ntrg->state->comm,
+                                                                   py_ntrg->state->file_name,
+                                                                   py_ntrg->state->io_size,
+                                                                   py_ntrg->state->attr_namespace,
+                                                                   py_ntrg->state->attr_mask,
+                                                                   py_ntrg->state->node_rank_map,
+                                                                   py_ntrg->state->pop_name,
+                                                                   py_ntrg->state->pop_start,
+                                                                   py_ntrg->state->attr_map,
+                                                                   py_ntrg->state->cache_index,
+                                                                   py_ntrg->state->cache_size);
              
-              throw_assert (status >= 0,
-                            "NeuroH5CellAttrGen: error in call to cell::scatter_read_cell_attributes");
-              throw_assert(MPI_Barrier(py_ntrg->state->comm) == MPI_SUCCESS, "NeuroH5CellAttrGen: MPI_Barrier error");
+                  throw_assert (status >= 0,
+                                "NeuroH5CellAttrGen: error in call to cell::scatter_read_cell_attributes");
+                  throw_assert(MPI_Barrier(py_ntrg->state->comm) == MPI_SUCCESS, "NeuroH5CellAttrGen: MPI_Barrier error");
+                }
 
               py_ntrg->state->attr_map.attr_names(py_ntrg->state->attr_names);
-              py_ntrg->state->it_idx = py_ntrg->state->attr_map.index_set.cbegin();
+              py_ntrg->state->it_idx = py_ntrg->state->attr_map.index.cbegin();
               py_ntrg->state->cache_index += size * py_ntrg->state->cache_size;
+
+              // start reading the next block while this one is consumed
+              if ((py_ntrg->state->prefetch_comm != MPI_COMM_NULL) &&
+                  (py_ntrg->state->cache_index < py_ntrg->state->count))
+                {
+                  neuroh5_cell_attr_gen_prefetch(py_ntrg->state);
+                }
               if ((py_ntrg->state->return_tp == return_tuple) && (py_ntrg->state->tuple_index_info == NULL))
                 {
-                  if (py_ntrg->state->attr_map.index_set.size() > 0)
+                  if (py_ntrg->state->attr_map.index.size() > 0)
                     {
                       py_ntrg->state->tuple_index_info = py_build_cell_attr_tuple_info(py_ntrg->state->attr_map,
                                                                                        py_ntrg->state->attr_names);
@@ -7857,13 +9659,15 @@ extern "C"
             }
 
 
-          if (py_ntrg->state->it_idx == py_ntrg->state->attr_map.index_set.cend())
+          if (py_ntrg->state->it_idx == py_ntrg->state->attr_map.index.cend())
             {
               if (py_ntrg->state->seq_index == py_ntrg->state->max_local_count)
                 {
                   int status = MPI_Barrier(py_ntrg->state->comm);
                   throw_assert(status == MPI_SUCCESS, "NeuroH5CellAttrGen: MPI_Barrier error");
 
+                  gen_prefetch_free(py_ntrg->state->prefetch_result, py_ntrg->state->prefetch_comm);
+
                   status = MPI_Comm_free(&(py_ntrg->state->comm));
                   throw_assert(status == MPI_SUCCESS,
                                "NeuroH5CellAttrGen: unable to free MPI communicator");
@@ -7934,6 +9738,8 @@ extern "C"
               int status = MPI_Barrier(py_ntrg->state->comm);
               throw_assert(status == MPI_SUCCESS, "NeuroH5CellAttrGen: MPI_Barrier error");
 
+              gen_prefetch_free(py_ntrg->state->prefetch_result, py_ntrg->state->prefetch_comm);
+
               status = MPI_Comm_free(&(py_ntrg->state->comm));
               throw_assert(status == MPI_SUCCESS,
                            "NeuroH5CellAttrGen: unable to free MPI communicator");
@@ -7990,28 +9796,47 @@ extern "C"
     vector < map <string, vector < vector<string> > > > edge_attr_name_vector;
     vector <edge_map_t> prj_vector;
 
-    status = MPI_Barrier(py_ngg->state->comm);
-    
-    status = graph::scatter_read_projection(py_ngg->state->comm,
-                                            py_ngg->state->io_size,
-                                            py_ngg->state->edge_map_type,
-                                            py_ngg->state->file_name,
-                                            py_ngg->state->src_pop_name,
-                                            py_ngg->state->dst_pop_name,
-                                            py_ngg->state->src_start,
-                                            py_ngg->state->dst_start,
-                                            py_ngg->state->edge_attr_name_spaces,
-                                            py_ngg->state->node_rank_map,
-                                            py_ngg->state->pop_search_ranges,
-                                            py_ngg->state->pop_pairs,
-                                            prj_vector,
-                                            edge_attr_name_vector,
-                                            py_ngg->state->local_num_nodes,
-                                            py_ngg->state->local_num_edges,
-                                            py_ngg->state->total_num_edges,
-                                            py_ngg->state->total_read_blocks,
-                                            py_ngg->state->block_index,
-                                            py_ngg->state->cache_size);
+    if (py_ngg->state->prefetch_comm != MPI_COMM_NULL)
+      {
+        if (!py_ngg->state->prefetch_result.valid())
+          {
+            neuroh5_prj_gen_prefetch(py_ngg->state);
+          }
+        status = gen_prefetch_wait(py_ngg->state->prefetch_result);
+        NeuroH5ProjectionBlock& block = py_ngg->state->prefetch_block;
+        prj_vector = std::move(block.prj_vector);
+        edge_attr_name_vector = std::move(block.edge_attr_name_vector);
+        py_ngg->state->local_num_nodes = block.local_num_nodes;
+        py_ngg->state->local_num_edges = block.local_num_edges;
+        py_ngg->state->total_num_edges = block.total_num_edges;
+        py_ngg->state->total_read_blocks = block.total_read_blocks;
+      }
+    else
+      {
+        background_io_drain();
+        status = MPI_Barrier(py_ngg->state->comm);
+
+        status = graph::scatter_read_projection(py_ngg->state->comm,
+                                                py_ngg->state->io_size,
+                                                py_ngg->state->edge_map_type,
+                                                py_ngg->state->file_name,
+                                                py_ngg->state->src_pop_name,
+                                                py_ngg->state->dst_pop_name,
+                                                py_ngg->state->src_start,
+                                                py_ngg->state->dst_start,
+                                                py_ngg->state->edge_attr_name_spaces,
+                                                py_ngg->state->node_rank_map,
+                                                py_ngg->state->pop_search_ranges,
+                                                py_ngg->state->pop_pairs,
+                                                prj_vector,
+                                                edge_attr_name_vector,
+                                                py_ngg->state->local_num_nodes,
+                                                py_ngg->state->local_num_edges,
+                                                py_ngg->state->total_num_edges,
+                                                py_ngg->state->total_read_blocks,
+                                                py_ngg->state->block_index,
+                                                py_ngg->state->cache_size);
+      }
 
     throw_assert (status >= 0, "NeuroH5ProjectionGen: read_projection error");
     throw_assert(prj_vector.size() > 0, "NeuroH5ProjectionGen: empty projection");
@@ -8035,6 +9860,13 @@ extern "C"
     throw_assert(status == MPI_SUCCESS, "NeuroH5ProjectionGen: MPI_Allreduce error");
     py_ngg->state->node_count += max_local_num_nodes;
 
+    // start reading the next block while this one is consumed
+    if ((py_ngg->state->prefetch_comm != MPI_COMM_NULL) &&
+        (py_ngg->state->block_index < py_ngg->state->block_count))
+      {
+        neuroh5_prj_gen_prefetch(py_ngg->state);
+      }
+
     status = MPI_Barrier(py_ngg->state->comm);
     throw_assert(status == MPI_SUCCESS, "NeuroH5ProjectionGen: MPI_Barrier error");
 
@@ -8076,6 +9908,8 @@ extern "C"
                       int status = MPI_Barrier(py_ngg->state->comm);
                       throw_assert(status == MPI_SUCCESS, "NeuroH5ProjectionGen: MPI_Barrier error");
 
+                      gen_prefetch_free(py_ngg->state->prefetch_result, py_ngg->state->prefetch_comm);
+
                       status = MPI_Comm_free(&(py_ngg->state->comm));
                       throw_assert(status == MPI_SUCCESS,
                                    "NeuroH5ProjectionGen: unable to free MPI communicator");
@@ -8121,6 +9955,8 @@ extern "C"
               int status = MPI_Barrier(py_ngg->state->comm);
               throw_assert(status == MPI_SUCCESS, "NeuroH5ProjectionGen: MPI_Barrier error");
 
+              gen_prefetch_free(py_ngg->state->prefetch_result, py_ngg->state->prefetch_comm);
+
               status = MPI_Comm_free(&(py_ngg->state->comm));
               throw_assert(status == MPI_SUCCESS,
                      "NeuroH5ProjectionGen: unable to free MPI communicator");
@@ -8140,6 +9976,8 @@ extern "C"
               int status = MPI_Barrier(py_ngg->state->comm);
               throw_assert(status == MPI_SUCCESS, "NeuroH5ProjectionGen: MPI_Barrier error");
 
+              gen_prefetch_free(py_ngg->state->prefetch_result, py_ngg->state->prefetch_comm);
+
               status = MPI_Comm_free(&(py_ngg->state->comm));
               throw_assert(status == MPI_SUCCESS, "NeuroH5ProjectionGen: unable to free MPI communicator");
               py_ngg->state->pos = seq_last;
@@ -8175,6 +10013,57 @@ extern "C"
   }
 
 
+
+  /* Conditions of prefetch common to the generators */
+#define GEN_PREFETCH_CONDITIONS_DOC                                        \
+    "    Prefetch is enabled only if MPI provides MPI_THREAD_MULTIPLE on\n"  \
+    "    all ranks. Other NeuroH5 calls wait until the block has been read;\n" \
+    "    HDF5 calls through other modules, such as h5py, are not serialized\n" \
+    "    with the read, so with an HDF5 library that is not thread-safe,\n"  \
+    "    call flush_appends() before them.\n"
+
+  PyDoc_STRVAR(
+    NeuroH5ProjectionGen_doc,
+    "NeuroH5ProjectionGen(file_name, src_pop_name, dst_pop_name, namespaces=None, edge_map_type=0, comm=None, io_size=0, cache_size=1, prefetch=False)\n"
+    "--\n"
+    "\n"
+    "Generator that reads and scatters a projection one block of destinations\n"
+    "at a time.\n"
+    "\n"
+    "prefetch : bool\n"
+    "    If True, the next block of cache_size destination blocks is read\n"
+    "    and scattered in the background while the edges of the current\n"
+    "    block are yielded.\n"
+    GEN_PREFETCH_CONDITIONS_DOC);
+
+  PyDoc_STRVAR(
+    NeuroH5TreeGen_doc,
+    "NeuroH5TreeGen(file_name, pop_name, namespaces=None, topology=True, validate=True, comm=None, node_allocation=None, io_size=0, cache_size=1, prefetch=False)\n"
+    "--\n"
+    "\n"
+    "Generator that reads and scatters the trees of a population one block of\n"
+    "cells at a time.\n"
+    "\n"
+    "prefetch : bool\n"
+    "    If True, the trees of the next cache_size cells of each rank are\n"
+    "    read and scattered in the background while the current trees are\n"
+    "    yielded.\n"
+    GEN_PREFETCH_CONDITIONS_DOC);
+
+  PyDoc_STRVAR(
+    NeuroH5CellAttrGen_doc,
+    "NeuroH5CellAttrGen(file_name, pop_name, namespace, comm=None, node_allocation=None, mask=None, io_size=1, cache_size=1, return_type=None, tuple_index_dict=None, prefetch=False)\n"
+    "--\n"
+    "\n"
+    "Generator that reads and scatters the attributes of a namespace one block\n"
+    "of cells at a time.\n"
+    "\n"
+    "prefetch : bool\n"
+    "    If True, the attribute values of the next cache_size cells of each\n"
+    "    rank are read and scattered in the background while the current\n"
+    "    values are yielded.\n"
+    GEN_PREFETCH_CONDITIONS_DOC);
+
   
   
   // NeuroH5 tree read generator
@@ -8199,7 +10088,7 @@ extern "C"
     0,                              /* tp_setattro */
     0,                              /* tp_as_buffer */
     Py_TPFLAGS_DEFAULT,             /* tp_flags */
-    0,                              /* tp_doc */
+    NeuroH5TreeGen_doc,             /* tp_doc */
     0,                              /* tp_traverse */
     0,                              /* tp_clear */
     0,                              /* tp_richcompare */
@@ -8242,7 +10131,7 @@ extern "C"
     0,                              /* tp_setattro */
     0,                              /* tp_as_buffer */
     Py_TPFLAGS_DEFAULT,             /* tp_flags */
-    0,                              /* tp_doc */
+    NeuroH5CellAttrGen_doc,         /* tp_doc */
     0,                              /* tp_traverse */
     0,                              /* tp_clear */
     0,                              /* tp_richcompare */
@@ -8284,7 +10173,7 @@ extern "C"
     0,                              /* tp_setattro */
     0,                              /* tp_as_buffer */
     Py_TPFLAGS_DEFAULT,             /* tp_flags */
-    0,                              /* tp_doc */
+    NeuroH5ProjectionGen_doc,       /* tp_doc */
     0,                              /* tp_traverse */
     0,                              /* tp_clear */
     0,                              /* tp_richcompare */
@@ -8306,53 +10195,63 @@ extern "C"
 
   
   static PyMethodDef module_methods[] = {
-    { "read_population_ranges", (PyCFunction)py_read_population_ranges, METH_VARARGS | METH_KEYWORDS,
+    { "read_population_ranges", (PyCFunction)(void (*)(void))py_after_background_io<py_read_population_ranges>, METH_VARARGS | METH_KEYWORDS,
        read_population_ranges_doc },
-    { "read_population_names", (PyCFunction)py_read_population_names, METH_VARARGS | METH_KEYWORDS,
+    { "read_population_names", (PyCFunction)(void (*)(void))py_after_background_io<py_read_population_names>, METH_VARARGS | METH_KEYWORDS,
       read_population_names_doc },
-    { "read_projection_names", (PyCFunction)py_read_projection_names, METH_VARARGS | METH_KEYWORDS,
+    { "file_access_config", (PyCFunction)(void (*)(void))py_after_background_io<py_file_access_config>, METH_VARARGS | METH_KEYWORDS,
+      file_access_config_doc },
+    { "stitch_subfiles", (PyCFunction)(void (*)(void))py_after_background_io<py_stitch_subfiles>, METH_VARARGS | METH_KEYWORDS,
+      stitch_subfiles_doc },
+    { "read_projection_names", (PyCFunction)(void (*)(void))py_after_background_io<py_read_projection_names>, METH_VARARGS | METH_KEYWORDS,
       read_projection_names_doc },
-    { "read_graph_info", (PyCFunction)py_read_graph_info, METH_VARARGS | METH_KEYWORDS,
+    { "read_graph_info", (PyCFunction)(void (*)(void))py_after_background_io<py_read_graph_info>, METH_VARARGS | METH_KEYWORDS,
       read_graph_info_doc },
-    { "read_trees", (PyCFunction)py_read_trees, METH_VARARGS | METH_KEYWORDS,
+    { "read_trees", (PyCFunction)(void (*)(void))py_after_background_io<py_read_trees>, METH_VARARGS | METH_KEYWORDS,
       read_trees_doc },
-    { "read_tree_selection", (PyCFunction)py_read_tree_selection, METH_VARARGS | METH_KEYWORDS,
+    { "read_tree_selection", (PyCFunction)(void (*)(void))py_after_background_io<py_read_tree_selection>, METH_VARARGS | METH_KEYWORDS,
       read_tree_selection_doc },
-    { "scatter_read_trees", (PyCFunction)py_scatter_read_trees, METH_VARARGS | METH_KEYWORDS,
+    { "scatter_read_trees", (PyCFunction)(void (*)(void))py_after_background_io<py_scatter_read_trees>, METH_VARARGS | METH_KEYWORDS,
       scatter_read_trees_doc },
-    { "scatter_read_tree_selection", (PyCFunction)py_scatter_read_tree_selection, METH_VARARGS | METH_KEYWORDS,
+    { "scatter_read_tree_selection", (PyCFunction)(void (*)(void))py_after_background_io<py_scatter_read_tree_selection>, METH_VARARGS | METH_KEYWORDS,
       scatter_read_trees_doc },
-    { "read_cell_attribute_info", (PyCFunction)py_read_cell_attribute_info, METH_VARARGS | METH_KEYWORDS,
+    { "read_cell_attribute_info", (PyCFunction)(void (*)(void))py_after_background_io<py_read_cell_attribute_info>, METH_VARARGS | METH_KEYWORDS,
       read_cell_attribute_info_doc },
-    { "read_cell_attribute_selection", (PyCFunction)py_read_cell_attribute_selection, METH_VARARGS | METH_KEYWORDS,
+    { "read_cell_attribute_selection", (PyCFunction)(void (*)(void))py_after_background_io<py_read_cell_attribute_selection>, METH_VARARGS | METH_KEYWORDS,
        read_cell_attribute_selection_doc },
-    { "scatter_read_cell_attribute_selection", (PyCFunction)py_scatter_read_cell_attribute_selection, METH_VARARGS | METH_KEYWORDS,
+    { "scatter_read_cell_attribute_selection", (PyCFunction)(void (*)(void))py_after_background_io<py_scatter_read_cell_attribute_selection>, METH_VARARGS | METH_KEYWORDS,
        scatter_read_cell_attribute_selection_doc },
-    { "read_cell_attributes", (PyCFunction)py_read_cell_attributes, METH_VARARGS | METH_KEYWORDS,
+    { "read_cell_attributes", (PyCFunction)(void (*)(void))py_after_background_io<py_read_cell_attributes>, METH_VARARGS | METH_KEYWORDS,
       read_cell_attributes_doc },
-    { "scatter_read_cell_attributes", (PyCFunction)py_scatter_read_cell_attributes, METH_VARARGS | METH_KEYWORDS,
+    { "scatter_read_cell_attributes", (PyCFunction)(void (*)(void))py_after_background_io<py_scatter_read_cell_attributes>, METH_VARARGS | METH_KEYWORDS,
       scatter_read_cell_attributes_doc },
-    { "bcast_cell_attributes", (PyCFunction)py_bcast_cell_attributes, METH_VARARGS | METH_KEYWORDS,
+    { "read_cell_attribute_columns", (PyCFunction)(void (*)(void))py_after_background_io<py_read_cell_attribute_columns>, METH_VARARGS | METH_KEYWORDS,
+      read_cell_attribute_columns_doc },
+    { "scatter_read_cell_attribute_columns", (PyCFunction)(void (*)(void))py_after_background_io<py_scatter_read_cell_attribute_columns>, METH_VARARGS | METH_KEYWORDS,
+      scatter_read_cell_attribute_columns_doc },
+    { "bcast_cell_attributes", (PyCFunction)(void (*)(void))py_after_background_io<py_bcast_cell_attributes>, METH_VARARGS | METH_KEYWORDS,
       "Reads attributes for the given range of cells and broadcasts to all ranks." },
-    { "write_cell_attributes", (PyCFunction)py_write_cell_attributes, METH_VARARGS | METH_KEYWORDS,
+    { "write_cell_attributes", (PyCFunction)(void (*)(void))py_after_background_io<py_write_cell_attributes>, METH_VARARGS | METH_KEYWORDS,
       "Writes attributes for the given range of cells." },
     { "append_cell_attributes", (PyCFunction)py_append_cell_attributes, METH_VARARGS | METH_KEYWORDS,
-      "Appends additional attributes for the given range of cells." },
+      "Appends additional attributes for the given range of cells; with asynchronous=True, the append is queued and written in the background. Background appends require MPI_THREAD_MULTIPLE on all ranks; otherwise the append is written synchronously. Other NeuroH5 calls wait for pending background appends; call flush_appends before accessing the file through other modules. Errors of background appends are raised on all ranks by the next append or by flush_appends." },
     { "append_cell_trees", (PyCFunction)py_append_cell_trees, METH_VARARGS | METH_KEYWORDS,
-      "Appends tree morphologies." },
-    { "read_graph", (PyCFunction)py_read_graph, METH_VARARGS | METH_KEYWORDS,
+      "Appends tree morphologies; with asynchronous=True, the append is queued and written in the background. Background appends require MPI_THREAD_MULTIPLE on all ranks; otherwise the append is written synchronously. Other NeuroH5 calls wait for pending background appends; call flush_appends before accessing the file through other modules. Errors of background appends are raised on all ranks by the next append or by flush_appends. With quantize=PRECISION, coordinates and radii are stored as fixed-point values with absolute error at most PRECISION." },
+    { "flush_appends", (PyCFunction)py_flush_appends, METH_NOARGS,
+      flush_appends_doc },
+    { "read_graph", (PyCFunction)(void (*)(void))py_after_background_io<py_read_graph>, METH_VARARGS | METH_KEYWORDS,
       "Reads graph connectivity in Destination Block Sparse format." },
-    { "scatter_read_graph", (PyCFunction)py_scatter_read_graph, METH_VARARGS | METH_KEYWORDS,
+    { "scatter_read_graph", (PyCFunction)(void (*)(void))py_after_background_io<py_scatter_read_graph>, METH_VARARGS | METH_KEYWORDS,
       "Reads and scatters graph connectivity in Destination Block Sparse format." },
-    { "bcast_graph", (PyCFunction)py_bcast_graph, METH_VARARGS | METH_KEYWORDS,
+    { "bcast_graph", (PyCFunction)(void (*)(void))py_after_background_io<py_bcast_graph>, METH_VARARGS | METH_KEYWORDS,
       "Reads and broadcasts graph connectivity in Destination Block Sparse format." },
-    { "read_graph_selection", (PyCFunction)py_read_graph_selection, METH_VARARGS | METH_KEYWORDS,
+    { "read_graph_selection", (PyCFunction)(void (*)(void))py_after_background_io<py_read_graph_selection>, METH_VARARGS | METH_KEYWORDS,
       "Reads subset of graph connectivity in Destination Block Sparse format." },
-    { "scatter_read_graph_selection", (PyCFunction)py_scatter_read_graph_selection, METH_VARARGS | METH_KEYWORDS,
+    { "scatter_read_graph_selection", (PyCFunction)(void (*)(void))py_after_background_io<py_scatter_read_graph_selection>, METH_VARARGS | METH_KEYWORDS,
       "Reads subset of graph connectivity in Destination Block Sparse format." },
-    { "write_graph", (PyCFunction)py_write_graph, METH_VARARGS | METH_KEYWORDS,
+    { "write_graph", (PyCFunction)(void (*)(void))py_after_background_io<py_write_graph>, METH_VARARGS | METH_KEYWORDS,
       "Writes graph connectivity in Destination Block Sparse format." },
-    { "append_graph", (PyCFunction)py_append_graph, METH_VARARGS | METH_KEYWORDS,
+    { "append_graph", (PyCFunction)(void (*)(void))py_after_background_io<py_append_graph>, METH_VARARGS | METH_KEYWORDS,
       "Appends graph connectivity in Destination Block Sparse format." },
     { NULL, NULL, 0, NULL }
   };
@@ -8472,6 +10371,35 @@ initio(void)
   Py_INCREF((PyObject *)&PyNeuroH5EdgeIter_Type);
   PyModule_AddObject(module, "NeuroH5EdgeIter", (PyObject *)&PyNeuroH5EdgeIter_Type);
 
+  if (PyType_Ready(&PyNeuroH5File_Type) < 0)
+    {
+      printf("File type cannot be added\n");
+#if PY_MAJOR_VERSION >= 3
+      return NULL;
+#else      
+      return;
+#endif
+    }
+
+  Py_INCREF((PyObject *)&PyNeuroH5File_Type);
+  PyModule_AddObject(module, "File", (PyObject *)&PyNeuroH5File_Type);
+
+  // Pending background appends are completed at interpreter exit,
+  // before mpi4py finalizes MPI
+  PyObject *atexit_module = PyImport_ImportModule("atexit");
+  if (atexit_module != NULL)
+    {
+      PyObject *flush_appends = PyObject_GetAttrString(module, "flush_appends");
+      if (flush_appends != NULL)
+        {
+          PyObject *result = PyObject_CallMethod(atexit_module, "register", "O", flush_appends);
+          Py_XDECREF(result);
+          Py_DECREF(flush_appends);
+        }
+      Py_DECREF(atexit_module);
+    }
+  PyErr_Clear();
+
 #if PY_MAJOR_VERSION >= 3
   return module;
 #else
@@ -29,6 +29,7 @@ template<> struct NumpyTypeMap<int8_t> { static constexpr int type_num = NPY_INT
 template<> struct NumpyTypeMap<uint32_t> { static constexpr int type_num = NPY_UINT32; };
 template<> struct NumpyTypeMap<uint16_t> { static constexpr int type_num = NPY_UINT16; };
 template<> struct NumpyTypeMap<uint8_t> { static constexpr int type_num = NPY_UINT8; };
+template<> struct NumpyTypeMap<uint64_t> { static constexpr int type_num = NPY_UINT64; };
 
 // Structure to hold type information
 struct TypeInfo {
@@ -42,6 +43,8 @@ class SharedArrayHolder {
 private:
     std::unique_ptr<T[]> data;
     size_t size;
+    std::shared_ptr<void> owner;
+    T* view = nullptr;
 
 public:
     SharedArrayHolder(size_t n) : size(n) {
@@ -72,6 +75,9 @@ public:
   // Approach 2: Construct array from pointer and size
   SharedArrayHolder(T* ptr, size_t n) : data(ptr), size(n) {}
 
+  // Approach 2b: View of memory that is kept alive by owner
+  SharedArrayHolder(std::shared_ptr<void> owner, T* ptr, size_t n) : size(n), owner(owner), view(ptr) {}
+
   // Approach 3: Constructor that copies vector's buffer
   explicit SharedArrayHolder(const std::vector<T>& vec) : size(vec.size())
   {
@@ -123,7 +129,7 @@ public:
     }
   }
   
-  T* get_data() { return data.get(); }
+  T* get_data() { return view ? view : data.get(); }
   size_t get_size() const { return size; }
 };
 
@@ -375,5 +381,95 @@ static PyObject* create_shared_array_from_vector(const std::vector<T>& vec)
     return array;
 }
 
+// Create numpy array that views memory kept alive by owner
+template<typename T>
+static PyObject* create_shared_array_view(std::shared_ptr<void> owner, T* first, size_t n)
+{
+    auto holder = new SharedArrayHolder<T>(owner, first, n);
+
+    npy_intp dims[1] = {static_cast<npy_intp>(holder->get_size())};
+
+    PyObject* capsule = PyCapsule_New(
+        holder,
+        "array_memory",
+        shared_array_dealloc<T>
+    );
+
+    if (!capsule) {
+        delete holder;
+        return nullptr;
+    }
+
+    PyObject* array = PyArray_NewFromDescr(
+        &PyArray_Type,
+        PyArray_DescrFromType(NumpyTypeMap<T>::type_num),
+        1,
+        dims,
+        nullptr,
+        holder->get_data(),
+        NPY_ARRAY_WRITEABLE,
+        nullptr
+    );
+
+    if (!array) {
+        Py_DECREF(capsule);
+        return nullptr;
+    }
+
+    if (PyArray_SetBaseObject((PyArrayObject*)array, capsule) < 0) {
+        Py_DECREF(capsule);
+        Py_DECREF(array);
+        return nullptr;
+    }
+
+    return array;
+}
+
+// Create shared numpy array by copying a range of values
+template<typename T>
+static PyObject* create_shared_array_from_range(const T* first, size_t n)
+{
+    T* buf = new T[n];
+    std::copy(first, first + n, buf);
+    auto holder = new SharedArrayHolder<T>(buf, n);
+
+    npy_intp dims[1] = {static_cast<npy_intp>(holder->get_size())};
+
+    PyObject* capsule = PyCapsule_New(
+        holder,
+        "array_memory",
+        shared_array_dealloc<T>
+    );
+
+    if (!capsule) {
+        delete holder;
+        return nullptr;
+    }
+
+    PyObject* array = PyArray_NewFromDescr(
+        &PyArray_Type,
+        PyArray_DescrFromType(NumpyTypeMap<T>::type_num),
+        1,
+        dims,
+        nullptr,
+        holder->get_data(),
+        NPY_ARRAY_WRITEABLE,
+        nullptr
+    );
+
+    if (!array) {
+        Py_DECREF(capsule);
+        return nullptr;
+    }
+
+    if (PyArray_SetBaseObject((PyArrayObject*)array, capsule) < 0) {
+        Py_DECREF(capsule);
+        Py_DECREF(array);
+        return nullptr;
+    }
+
+    return array;
+}
+
 #endif
 
@@ -27,6 +27,7 @@
 #include "serialize_tree.hh"
 #include "cell_index.hh"
 #include "cell_attributes.hh"
+#include "tree_encoding.hh"
 #include "create_file_toplevel.hh"
 #include "compact_optional.hh"
 #include "optional_value.hh"
@@ -289,7 +290,8 @@ namespace neuroh5
      const set<size_t>              &io_rank_set,
      CellPtr                        ptr_type,
      const size_t                   chunk_size,
-     const size_t                   value_chunk_size
+     const size_t                   value_chunk_size,
+     const TreeEncoding&            encoding
      )
     {
       herr_t status=0; 
@@ -300,6 +302,8 @@ namespace neuroh5
       throw_assert_nomsg(MPI_Comm_rank(comm, (int*)&rank) == MPI_SUCCESS);
       
       throw_assert(io_rank_set.size() > 0, "invalid I/O rank set");
+      throw_assert((encoding.type != TreeQuantized) || (ptr_type.type != PtrNone),
+                   "append_trees: quantized encoding requires cell pointers");
       bool is_io_rank = (io_rank_set.find(rank) != io_rank_set.end());
       io_size = io_rank_set.size();
 
@@ -412,55 +416,154 @@ namespace neuroh5
       string attr_ptr_owner_path = hdf5::cell_attribute_path(hdf5::TREES, pop_name, hdf5::X_COORD) + "/" + hdf5::ATTR_PTR;
       string sec_ptr_owner_path  = hdf5::cell_attribute_path(hdf5::TREES, pop_name, hdf5::SRCSEC) + "/" + hdf5::SEC_PTR;
 
-      
-      hid_t file;
+      const string plain_path = hdf5::cell_attribute_path(hdf5::TREES, pop_name, hdf5::X_COORD);
+      const string encoded_path = hdf5::cell_attribute_path(hdf5::TREES, pop_name, hdf5::X_OFFSET);
 
+      // Check the stored encoding and encode the trees before the I/O
+      // ranks enter the collective writes below; if any rank fails, all
+      // ranks throw together instead of leaving the others waiting in a
+      // collective call
+      hid_t file = -1;
+      EncodedTreePoints encoded;
+      string error_msg;
       if (is_io_rank)
         {
+          file = H5Iget_file_id(loc);
+          try
+            {
+              throw_assert(file >= 0,
+                           "append_trees: invalid file handle");
+              throw_assert(hdf5::exists_dataset(file, (encoding.type == TreeQuantized) ? plain_path : encoded_path) <= 0,
+                           "append_trees: trees of population " << pop_name << " are stored with a different encoding");
+              if (encoding.type == TreeQuantized)
+                {
+                  encode_tree_points(encoding.precision, all_index_vector, attr_ptr,
+                                     all_xcoords, all_ycoords, all_zcoords, all_radiuses,
+                                     all_layers, all_parents, all_swc_types, encoded);
+                }
+            }
+          catch (const std::exception& e)
+            {
+              error_msg = e.what();
+            }
+        }
+
+      int local_error = error_msg.empty() ? 0 : 1, global_error = 0;
+      throw_assert(MPI_Allreduce(&local_error, &global_error, 1, MPI_INT, MPI_MAX, comm) == MPI_SUCCESS,
+                   "append_trees: error in MPI_Allreduce");
+      if (global_error != 0)
+        {
+          if (file >= 0)
+            {
+              throw_assert(H5Fclose(file) >= 0, "append_trees: unable to close HDF5 file");
+            }
+          throw_assert(global_error == 0,
+                       "append_trees: " << (error_msg.empty() ? string("unable to append trees on another rank") : error_msg));
+        }
 
-          hid_t file = H5Iget_file_id(loc);
-          throw_assert(file >= 0,
-                       "append_trees: invalid file handle");
-          
+      if (is_io_rank)
+        {
           append_cell_index (io_comm, file, pop_name, pop_start,
                              hdf5::TREES, all_index_vector);
+
+          if (encoding.type == TreeQuantized)
+            {
+              string offset_ptr_owner_path = encoded_path + "/" + hdf5::ATTR_PTR;
+              string layer_ptr_owner_path = hdf5::cell_attribute_path(hdf5::TREES, pop_name, hdf5::LAYER_RUNS) +
+                "/" + hdf5::ATTR_PTR;
+              string swc_type_ptr_owner_path = hdf5::cell_attribute_path(hdf5::TREES, pop_name, hdf5::SWCTYPE_RUNS) +
+                "/" + hdf5::ATTR_PTR;
+
+              append_cell_attribute (file, hdf5::TREES, pop_name, pop_start, hdf5::QUANT_ORIGIN,
+                                     all_index_vector, encoded.origin_ptr, encoded.origins,
+                                     coord_data_type, IndexShared,
+                                     CellPtr (PtrOwner, hdf5::ATTR_PTR),
+                                     chunk_size, value_chunk_size);
+              append_cell_attribute (file, hdf5::TREES, pop_name, pop_start, hdf5::X_OFFSET,
+                                     all_index_vector, attr_ptr, encoded.x_offsets,
+                                     dflt_data_type, IndexShared,
+                                     CellPtr (PtrOwner, hdf5::ATTR_PTR),
+                                     chunk_size, value_chunk_size);
+              append_cell_attribute (file, hdf5::TREES, pop_name, pop_start, hdf5::Y_OFFSET,
+                                     all_index_vector, attr_ptr, encoded.y_offsets,
+                                     dflt_data_type, IndexShared,
+                                     CellPtr (PtrShared, offset_ptr_owner_path),
+                                     chunk_size, value_chunk_size);
+              append_cell_attribute (file, hdf5::TREES, pop_name, pop_start, hdf5::Z_OFFSET,
+                                     all_index_vector, attr_ptr, encoded.z_offsets,
+                                     dflt_data_type, IndexShared,
+                                     CellPtr (PtrShared, offset_ptr_owner_path),
+                                     chunk_size, value_chunk_size);
+              append_cell_attribute (file, hdf5::TREES, pop_name, pop_start, hdf5::RADIUS_QUANT,
+                                     all_index_vector, attr_ptr, encoded.radiuses,
+                                     dflt_data_type, IndexShared,
+                                     CellPtr (PtrShared, offset_ptr_owner_path),
+                                     chunk_size, value_chunk_size);
+              append_cell_attribute (file, hdf5::TREES, pop_name, pop_start, hdf5::PARENT_DELTA,
+                                     all_index_vector, attr_ptr, encoded.parent_deltas,
+                                     parent_node_data_type, IndexShared,
+                                     CellPtr (PtrShared, offset_ptr_owner_path),
+                                     chunk_size, value_chunk_size);
+              append_cell_attribute (file, hdf5::TREES, pop_name, pop_start, hdf5::LAYER_RUNS,
+                                     all_index_vector, encoded.layer_run_ptr, encoded.layer_runs,
+                                     layer_data_type, IndexShared,
+                                     CellPtr (PtrOwner, hdf5::ATTR_PTR),
+                                     chunk_size, value_chunk_size);
+              append_cell_attribute (file, hdf5::TREES, pop_name, pop_start, hdf5::LAYER_RUN_LEN,
+                                     all_index_vector, encoded.layer_run_ptr, encoded.layer_run_lengths,
+                                     dflt_data_type, IndexShared,
+                                     CellPtr (PtrShared, layer_ptr_owner_path),
+                                     chunk_size, value_chunk_size);
+              append_cell_attribute (file, hdf5::TREES, pop_name, pop_start, hdf5::SWCTYPE_RUNS,
+                                     all_index_vector, encoded.swc_type_run_ptr, encoded.swc_type_runs,
+                                     swc_data_type, IndexShared,
+                                     CellPtr (PtrOwner, hdf5::ATTR_PTR),
+                                     chunk_size, value_chunk_size);
+              append_cell_attribute (file, hdf5::TREES, pop_name, pop_start, hdf5::SWCTYPE_RUN_LEN,
+                                     all_index_vector, encoded.swc_type_run_ptr, encoded.swc_type_run_lengths,
+                                     dflt_data_type, IndexShared,
+                                     CellPtr (PtrShared, swc_type_ptr_owner_path),
+                                     chunk_size, value_chunk_size);
+            }
+          else
+            {
+              append_cell_attribute (file, hdf5::TREES, pop_name, pop_start, hdf5::X_COORD,
+                                     all_index_vector, attr_ptr, all_xcoords,
+                                     coord_data_type, IndexShared,
+                                     CellPtr (PtrOwner, hdf5::ATTR_PTR),
+                                     chunk_size, value_chunk_size);
+              append_cell_attribute (file, hdf5::TREES, pop_name, pop_start, hdf5::Y_COORD,
+                                     all_index_vector, attr_ptr, all_ycoords,
+                                     coord_data_type, IndexShared,
+                                     CellPtr (PtrShared, attr_ptr_owner_path),
+                                     chunk_size, value_chunk_size);
+              append_cell_attribute (file, hdf5::TREES, pop_name, pop_start, hdf5::Z_COORD,
+                                     all_index_vector, attr_ptr, all_zcoords,
+                                     coord_data_type, IndexShared,
+                                     CellPtr (PtrShared, attr_ptr_owner_path),
+                                     chunk_size, value_chunk_size);
+              append_cell_attribute (file, hdf5::TREES, pop_name, pop_start, hdf5::RADIUS,
+                                     all_index_vector, attr_ptr, all_radiuses,
+                                     dflt_data_type, IndexShared,
+                                     CellPtr (PtrShared, attr_ptr_owner_path),
+                                     chunk_size, value_chunk_size);
+              append_cell_attribute (file, hdf5::TREES, pop_name, pop_start, hdf5::LAYER,
+                                     all_index_vector, attr_ptr, all_layers,
+                                     layer_data_type, IndexShared,
+                                     CellPtr (PtrShared, attr_ptr_owner_path),
+                                     chunk_size, value_chunk_size);
+              append_cell_attribute (file, hdf5::TREES, pop_name, pop_start, hdf5::PARENT,
+                                     all_index_vector, attr_ptr, all_parents,
+                                     parent_node_data_type, IndexShared,
+                                     CellPtr (PtrShared, attr_ptr_owner_path),
+                                     chunk_size, value_chunk_size);
           
-          append_cell_attribute (file, hdf5::TREES, pop_name, pop_start, hdf5::X_COORD,
-                                 all_index_vector, attr_ptr, all_xcoords,
-                                 coord_data_type, IndexShared,
-                                 CellPtr (PtrOwner, hdf5::ATTR_PTR),
-                                 chunk_size, value_chunk_size);
-          append_cell_attribute (file, hdf5::TREES, pop_name, pop_start, hdf5::Y_COORD,
-                                 all_index_vector, attr_ptr, all_ycoords,
-                                 coord_data_type, IndexShared,
-                                 CellPtr (PtrShared, attr_ptr_owner_path),
-                                 chunk_size, value_chunk_size);
-          append_cell_attribute (file, hdf5::TREES, pop_name, pop_start, hdf5::Z_COORD,
-                                 all_index_vector, attr_ptr, all_zcoords,
-                                 coord_data_type, IndexShared,
-                                 CellPtr (PtrShared, attr_ptr_owner_path),
-                                 chunk_size, value_chunk_size);
-          append_cell_attribute (file, hdf5::TREES, pop_name, pop_start, hdf5::RADIUS,
-                                 all_index_vector, attr_ptr, all_radiuses,
-                                 dflt_data_type, IndexShared,
-                                 CellPtr (PtrShared, attr_ptr_owner_path),
-                                 chunk_size, value_chunk_size);
-          append_cell_attribute (file, hdf5::TREES, pop_name, pop_start, hdf5::LAYER,
-                                 all_index_vector, attr_ptr, all_layers,
-                                 layer_data_type, IndexShared,
-                                 CellPtr (PtrShared, attr_ptr_owner_path),
-                                 chunk_size, value_chunk_size);
-          append_cell_attribute (file, hdf5::TREES, pop_name, pop_start, hdf5::PARENT,
-                                 all_index_vector, attr_ptr, all_parents,
-                                 parent_node_data_type, IndexShared,
-                                 CellPtr (PtrShared, attr_ptr_owner_path),
-                                 chunk_size, value_chunk_size);
-          
-          append_cell_attribute (file, hdf5::TREES, pop_name, pop_start, hdf5::SWCTYPE,
-                                 all_index_vector, attr_ptr, all_swc_types,
-                                 swc_data_type, IndexShared,
-                                 CellPtr (PtrShared, attr_ptr_owner_path),
-                                 chunk_size, value_chunk_size);
+              append_cell_attribute (file, hdf5::TREES, pop_name, pop_start, hdf5::SWCTYPE,
+                                     all_index_vector, attr_ptr, all_swc_types,
+                                     swc_data_type, IndexShared,
+                                     CellPtr (PtrShared, attr_ptr_owner_path),
+                                     chunk_size, value_chunk_size);
+            }
           append_cell_attribute (file, hdf5::TREES, pop_name, pop_start, hdf5::SRCSEC,
                                  all_index_vector, topo_ptr, all_src_vector,
                                  section_data_type, IndexShared,
@@ -499,7 +602,8 @@ namespace neuroh5
      std::forward_list<neurotree_t> &tree_list,
      size_t                         io_size,
      const size_t                   chunk_size,
-     const size_t                   value_chunk_size
+     const size_t                   value_chunk_size,
+     const TreeEncoding&            encoding
      )
     {
       herr_t status;
@@ -554,7 +658,8 @@ namespace neuroh5
         }
       
       status = append_trees(comm, io_comm, file, pop_name, pop_start, tree_list,
-                            io_rank_set,  CellPtr(PtrOwner), chunk_size, value_chunk_size);
+                            io_rank_set,  CellPtr(PtrOwner), chunk_size, value_chunk_size,
+                            encoding);
       throw_assert_nomsg(status >= 0);
 
       if (is_io_rank)
@@ -11,17 +11,22 @@
 #include "path_names.hh"
 #include "read_template.hh"
 #include "write_template.hh"
+#include "dataset_filters.hh"
 #include "file_access.hh"
+#include "subfiles.hh"
 #include "cell_attributes.hh"
 #include "hdf5_cell_attributes.hh"
 #include "create_file_toplevel.hh"
 #include "exists_dataset.hh"
 #include "dataset_num_elements.hh"
+#include "read_multi.hh"
+#include "cell_index_partition.hh"
 #include "create_group.hh"
 #include "append_rank_attr_map.hh"
 #include "attr_map.hh"
 #include "infer_datatype.hh"
 #include "attr_kind_datatype.hh"
+#include "attr_kind_dispatch.hh"
 #include "alltoallv_template.hh"
 #include "serialize_data.hh"
 #include "serialize_cell_attributes.hh"
@@ -37,6 +42,7 @@
 #include <unistd.h>
 #include <string>
 #include <type_traits>
+#include <map>
 #include <vector>
 #include <set>
 
@@ -254,6 +260,39 @@ namespace neuroh5
     }
 
 
+    // Attributes collected by cell_attribute_index_ptr_cb. The index and
+    // pointer data sets of the attributes of a name space may be links
+    // to the same objects (IndexShared, PtrShared); they are read once
+    // and copied to the other attributes.
+    // When read_index_ptr is false, only the owner of the index and
+    // pointer of each attribute is recorded.
+    struct cell_attribute_index_ptr_data
+    {
+      vector< tuple<string,AttrKind,vector<CELL_IDX_T>,vector<ATTR_PTR_T> > > attributes;
+      map< pair<haddr_t, haddr_t>, size_t > index_ptr_owner;
+      vector<size_t> owners;
+      bool read_index_ptr = true;
+    };
+
+    
+    static haddr_t dataset_address
+    (
+     hid_t         loc,
+     const string& path
+     )
+    {
+      haddr_t addr = HADDR_UNDEF;
+      if (hdf5::exists_dataset (loc, path) > 0)
+        {
+          H5O_info_t info;
+          throw_assert(H5Oget_info_by_name(loc, path.c_str(), &info, H5P_DEFAULT) >= 0,
+                       "dataset_address: unable to obtain object info of " << path);
+          addr = info.addr;
+        }
+      return addr;
+    }
+
+    
     // Callback for H5Literate
     static herr_t cell_attribute_index_ptr_cb
     (
@@ -292,17 +331,36 @@ namespace neuroh5
           throw_assert(ftype >= 0,
                        "cell_attributes_cb: unable to get data set type");
           
-          vector< tuple<string,AttrKind,vector<CELL_IDX_T>,vector<ATTR_PTR_T> > >* ptr =
-            (vector< tuple<string,AttrKind,vector<CELL_IDX_T>,vector<ATTR_PTR_T> > >*) op_data;
-
+          cell_attribute_index_ptr_data* ptr = (cell_attribute_index_ptr_data*) op_data;
 
-          vector<CELL_IDX_T> attr_index; vector<ATTR_PTR_T> attr_ptr;
           string attr_path = string(name);
-          ierr = hdf5::read_cell_index_ptr(grp, attr_path, attr_index, attr_ptr);
-          throw_assert(ierr >= 0,
-                       "cell_attributes_index_ptr_cb: error in hdf5::read_cell_index_ptr");
-
-          ptr->push_back(make_tuple(name, hdf5::h5type_attr_kind(ftype), attr_index, attr_ptr));
+          auto key = make_pair(dataset_address(grp, attr_path + "/" + hdf5::CELL_INDEX),
+                               dataset_address(grp, attr_path + "/" + hdf5::ATTR_PTR));
+          auto it = ptr->index_ptr_owner.find(key);
+          if (it != ptr->index_ptr_owner.end())
+            {
+              const auto& owner = ptr->attributes[it->second];
+              ptr->owners.push_back(it->second);
+              ptr->attributes.push_back(make_tuple(name, hdf5::h5type_attr_kind(ftype),
+                                                   get<2>(owner), get<3>(owner)));
+            }
+          else
+            {
+              vector<CELL_IDX_T> attr_index; vector<ATTR_PTR_T> attr_ptr;
+              if (ptr->read_index_ptr)
+                {
+                  ierr = hdf5::read_cell_index_ptr(grp, attr_path, attr_index, attr_ptr);
+                  throw_assert(ierr >= 0,
+                               "cell_attributes_index_ptr_cb: error in hdf5::read_cell_index_ptr");
+                }
+              
+              if (key.first != HADDR_UNDEF)
+                {
+                  ptr->index_ptr_owner.insert(make_pair(key, ptr->attributes.size()));
+                }
+              ptr->owners.push_back(ptr->attributes.size());
+              ptr->attributes.push_back(make_tuple(name, hdf5::h5type_attr_kind(ftype), attr_index, attr_ptr));
+            }
           
           throw_assert(H5Dclose(dset) >= 0,
                        "cell_attributes_cb: unable to close data set");
@@ -313,19 +371,16 @@ namespace neuroh5
     }
 
   
-    herr_t get_cell_attributes
+    static herr_t get_cell_attributes_file
     (
-     const string&                 file_name,
+     hid_t                         in_file,
      const string&                 name_space,
      const string&                 pop_name,
      vector< pair<string,AttrKind> >& out_attributes
      )
     {
-      hid_t in_file;
-      herr_t ierr;
+      herr_t ierr = 0;
     
-      in_file = H5Fopen(file_name.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
-      throw_assert(in_file >= 0, "get_cell_attributes unable to open file " << file_name);
       out_attributes.clear();
     
       string path = hdf5::cell_attribute_prefix(name_space, pop_name);
@@ -345,11 +400,72 @@ namespace neuroh5
           throw_assert(ierr >= 0,
                        "get_cell_attributes: unable to close group " << path);
         }
+
+      return ierr;
+    }
+
+    herr_t get_cell_attributes
+    (
+     const string&                 file_name,
+     const string&                 name_space,
+     const string&                 pop_name,
+     vector< pair<string,AttrKind> >& out_attributes
+     )
+    {
+      hid_t in_file;
+      herr_t ierr;
+    
+      in_file = H5Fopen(file_name.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+      throw_assert(in_file >= 0, "get_cell_attributes unable to open file " << file_name);
+
+      ierr = get_cell_attributes_file(in_file, name_space, pop_name, out_attributes);
+      throw_assert(ierr >= 0, "get_cell_attributes: error reading attributes of " << pop_name);
+      
       ierr = H5Fclose(in_file);
 
       return ierr;
     }
 
+    herr_t get_cell_attributes
+    (
+     File&                         file,
+     const string&                 name_space,
+     const string&                 pop_name,
+     vector< pair<string,AttrKind> >& out_attributes
+     )
+    {
+      auto key = make_pair(name_space, pop_name);
+      auto it = file.metadata.cell_attributes.find(key);
+      if (it == file.metadata.cell_attributes.end())
+        {
+          int rank;
+          throw_assert_nomsg(MPI_Comm_rank(file.comm(), &rank) == MPI_SUCCESS);
+
+          // rank 0 reads the attribute information and broadcasts
+          vector< pair<string,AttrKind> > attributes;
+          vector<char> sendbuf; size_t sendbuf_size = 0;
+          if (rank == 0)
+            {
+              throw_assert(get_cell_attributes_file(file.id(), name_space, pop_name, attributes) >= 0,
+                           "get_cell_attributes: error reading attributes of " << pop_name);
+              data::serialize_data(attributes, sendbuf);
+              sendbuf_size = sendbuf.size();
+            }
+
+          throw_assert_nomsg(MPI_Bcast(&sendbuf_size, 1, MPI_SIZE_T, 0, file.comm()) == MPI_SUCCESS);
+          sendbuf.resize(sendbuf_size);
+          throw_assert_nomsg(MPI_Bcast(&sendbuf[0], sendbuf_size, MPI_CHAR, 0, file.comm()) == MPI_SUCCESS);
+          if (rank != 0)
+            {
+              data::deserialize_data(sendbuf, attributes);
+            }
+          
+          it = file.metadata.cell_attributes.insert(make_pair(key, attributes)).first;
+        }
+      out_attributes = it->second;
+      return 0;
+    }
+
 
     herr_t get_cell_attribute_index
     (
@@ -426,8 +542,10 @@ namespace neuroh5
 
           
           hsize_t idx = 0;
+          cell_attribute_index_ptr_data index_ptr_data;
           ierr = H5Literate(grp, H5_INDEX_NAME, H5_ITER_NATIVE, &idx,
-                            &cell_attribute_index_ptr_cb, (void*) &out_attributes);
+                            &cell_attribute_index_ptr_cb, (void*) &index_ptr_data);
+          out_attributes = std::move(index_ptr_data.attributes);
 
           for (size_t i=0; i<out_attributes.size(); i++)
             {
@@ -534,7 +652,8 @@ namespace neuroh5
      const CellIndex& index_type,
      const CellPtr&   ptr_type,
      const size_t     chunk_size,
-     const size_t     value_chunk_size
+     const size_t     value_chunk_size,
+     const FilterConfig& filters
      )
     {
       herr_t status;
@@ -551,11 +670,6 @@ namespace neuroh5
       status = H5Pset_alloc_time(plist, H5D_ALLOC_TIME_EARLY);
       throw_assert(status == 0,
                    "create_cell_attribute_datasets: unable to set allocation time");
-#ifdef H5_HAS_PARALLEL_DEFLATE
-      status = H5Pset_deflate(plist, 9);
-      throw_assert(status == 0,
-                   "create_cell_attribute_datasets: unable to add deflate filter");
-#endif
 
       
       hsize_t value_cdims[1]   = {value_chunk_size}; /* chunking dimensions for value dataset */		
@@ -569,11 +683,7 @@ namespace neuroh5
       status = H5Pset_alloc_time(value_plist, H5D_ALLOC_TIME_EARLY);
       throw_assert(status == 0,
                    "create_cell_attribute_datasets: unable to set allocation time");
-#ifdef H5_HAS_PARALLEL_DEFLATE
-      status = H5Pset_deflate(value_plist, 9);
-      throw_assert(status == 0,
-                   "create_cell_attribute_datasets: unable to add deflate filter");
-#endif
+      hdf5::set_dataset_filters(value_plist, filters.value, ftype);
       
       hid_t lcpl = H5Pcreate(H5P_LINK_CREATE);
       throw_assert(lcpl >= 0,
@@ -613,6 +723,7 @@ namespace neuroh5
             throw_assert(mspace >= 0,
                          "create_cell_attribute_datasets: unable to create memory space");
 
+            hdf5::set_dataset_filters(plist, filters.index, CELL_IDX_H5_FILE_T);
             dset = H5Dcreate2(file, (attr_path + "/" + hdf5::CELL_INDEX).c_str(),
                               CELL_IDX_H5_FILE_T,
                               mspace, lcpl, plist, H5P_DEFAULT);
@@ -657,6 +768,7 @@ namespace neuroh5
             throw_assert(mspace >= 0,
                          "create_cell_attribute_datasets: unable to create memory space");
 
+            hdf5::set_dataset_filters(plist, filters.pointer, ATTR_PTR_H5_FILE_T);
             dset = H5Dcreate2(file, (attr_path + "/" + ptr_name).c_str(), ATTR_PTR_H5_FILE_T,
                               mspace, lcpl, plist, H5P_DEFAULT);
             throw_assert(status >= 0,
@@ -714,8 +826,11 @@ namespace neuroh5
     
   }
 
-  
-    void read_cell_attributes
+
+    // The read and scatter of cell attributes are the same for both
+    // attribute map layouts; only the insertion of the values differs
+    template <class NamedAttrMapT>
+    static void read_cell_attributes_map
     (
      MPI_Comm      comm,
      const string& file_name,
@@ -723,7 +838,7 @@ namespace neuroh5
      const set<string>& attr_mask,
      const string& pop_name,
      const CELL_IDX_T& pop_start,
-     data::NamedAttrMap& attr_values,
+     NamedAttrMapT& attr_values,
      size_t offset,
      size_t numitems
      )
@@ -799,124 +914,115 @@ namespace neuroh5
 
       // get a file handle and retrieve the MPI info
       hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
-#ifdef HDF5_IS_PARALLEL
-      throw_assert_nomsg(H5Pset_fapl_mpio(fapl, comm, MPI_INFO_NULL) >= 0);
-#endif
+      throw_assert_nomsg(hdf5::set_parallel_file_access(fapl, comm) >= 0);
       // TODO: configurable elink cache
       // throw_assert_nomsg(H5Pset_elink_file_cache_size(fapl, 10) >= 0);
       hid_t file = H5Fopen(file_name.c_str(), H5F_ACC_RDONLY, fapl);
       throw_assert_nomsg(file >= 0);
 
+      // The values of all selected attributes are read in a single I/O
+      // phase. Attributes with the same index and pointer have the same
+      // block of cells on this rank.
+      vector<string> value_paths;
+      vector<hsize_t> value_starts, value_blocks;
+      vector<size_t> value_pos, batch_attrs;
+      vector< vector<CELL_IDX_T> > value_indices;
+      vector< vector<ATTR_PTR_T> > value_ptrs;
+      data::AttrVal batch_values;
       for (size_t i=0; i<attr_info.size(); i++)
         {
-          vector<CELL_IDX_T>  value_index;
-          vector<ATTR_PTR_T>  value_ptr;
-
-          string attr_name  = get<0>(attr_info[i]);
-          AttrKind attr_kind = get<1>(attr_info[i]);
-          size_t attr_size  = attr_kind.size;
+          const string& attr_name  = get<0>(attr_info[i]);
+          const AttrKind& attr_kind = get<1>(attr_info[i]);
           const vector<CELL_IDX_T>& index  = get<2>(attr_info[i]);
           const vector<ATTR_PTR_T>& ptr  = get<3>(attr_info[i]);
           
-          string attr_path  = hdf5::cell_attribute_path (name_space, pop_name, attr_name);
-
           if ((attr_mask.size() > 0) && (attr_mask.count(attr_name) == 0))
             continue;
+
+          string attr_path  = hdf5::cell_attribute_path (name_space, pop_name, attr_name);
           
-          switch (attr_kind.type)
+          vector<CELL_IDX_T>  value_index;
+          vector<ATTR_PTR_T>  value_ptr;
+          hsize_t value_start = 0, value_block = 0;
+          bool has_block = false;
+          if ((batch_attrs.size() > 0) && (ptr.size() > 0) &&
+              (ptr == get<3>(attr_info[batch_attrs.back()])) &&
+              (index == get<2>(attr_info[batch_attrs.back()])))
             {
-            case UIntVal:
-              if (attr_size == 4)
-                {
-                  vector<uint32_t> attr_values_uint32;
-                  status = hdf5::read_cell_attribute(comm, file, attr_path, pop_start,
-                                                     index, ptr, value_index, value_ptr,
-                                                     attr_values_uint32,
-                                                     offset, numitems);
-                  attr_values.insert(attr_name, value_index, value_ptr, attr_values_uint32);
-                }
-              else if (attr_size == 2)
+              value_index = value_indices.back();
+              value_ptr = value_ptrs.back();
+              value_start = value_starts.back();
+              value_block = value_blocks.back();
+              has_block = value_paths.back().size() > 0;
+            }
+          else
+            {
+              if (rank == 0)
                 {
-                  vector<uint16_t> attr_values_uint16;
-                  status = hdf5::read_cell_attribute(comm, file, attr_path, pop_start,
-                                                     index, ptr, value_index, value_ptr, attr_values_uint16,
-                                                     offset, numitems);
-                  attr_values.insert(attr_name, value_index, value_ptr, attr_values_uint16);
+                  throw_assert(hdf5::exists_group (file, attr_path.c_str()) > 0,
+                               "read_cell_attributes: group " << attr_path << " does not exist");
                 }
-              else if (attr_size == 1)
-                {
-                  vector<uint8_t> attr_values_uint8;
-                  status = hdf5::read_cell_attribute(comm, file, attr_path, pop_start,
-                                                     index, ptr, value_index, value_ptr, attr_values_uint8,
+              has_block = hdf5::cell_attribute_block(comm, file, attr_path, index, ptr,
+                                                     value_index, value_ptr,
+                                                     value_start, value_block,
                                                      offset, numitems);
-                  attr_values.insert(attr_name, value_index, value_ptr, attr_values_uint8);
-                }
-              else
-                {
-                  throw runtime_error("Unsupported integer attribute size");
-                };
-              break;
-            case SIntVal:
-              {
-                if (attr_size == 4)
-                  {
-                    vector<int32_t> attr_values_int32;
-                    status = hdf5::read_cell_attribute(comm, file, attr_path, pop_start,
-                                                       index, ptr, value_index, value_ptr, attr_values_int32,
-                                                       offset, numitems);
-                    attr_values.insert(attr_name, value_index, value_ptr, attr_values_int32);
-                  }
-                else if (attr_size == 2)
-                  {
-                    vector<int16_t> attr_values_int16;
-                    status = hdf5::read_cell_attribute(comm, file, attr_path, pop_start,
-                                                       index, ptr, value_index, value_ptr, attr_values_int16,
-                                                       offset, numitems);
-                    attr_values.insert(attr_name, value_index, value_ptr, attr_values_int16);
-                  }
-                else if (attr_size == 1)
-                  {
-                    vector<int8_t> attr_values_int8;
-                    status = hdf5::read_cell_attribute(comm, file, attr_path, pop_start,
-                                                       index, ptr, value_index, value_ptr, attr_values_int8,
-                                                       offset, numitems);
-                    attr_values.insert(attr_name, value_index, value_ptr, attr_values_int8);
-                  }
-                else
-                  {
-                    throw runtime_error("Unsupported integer attribute size");
-                  };
-              }
-              break;
-            case FloatVal:
-              {
-                vector<float> attr_values_float;
-                status = hdf5::read_cell_attribute(comm, file, attr_path, pop_start,
-                                                   index, ptr, value_index, value_ptr, attr_values_float,
-                                                   offset, numitems);
-                attr_values.insert(attr_name, value_index, value_ptr, attr_values_float);
-              }
-              break;
-            case EnumVal:
-              {
-                if (attr_size == 1)
-                  {
-                    vector<uint8_t> attr_values_uint8;
-                    status = hdf5::read_cell_attribute(comm, file, attr_path, pop_start,
-                                                       index, ptr, value_index, value_ptr, attr_values_uint8,
-                                                       offset, numitems);
-                    attr_values.insert(attr_name, value_index, value_ptr, attr_values_uint8);
-                  }
-                else
-                  {
-                    throw runtime_error("Unsupported enumerated attribute size");
-                  };
-              }
-              break;
-            default:
-              throw runtime_error("Unsupported attribute type");
-              break;
             }
+
+          // values are not read when no rank has cells of this attribute
+          value_paths.push_back(has_block ? (attr_path + "/" + hdf5::ATTR_VAL) : string());
+          value_starts.push_back(value_start);
+          value_blocks.push_back(value_block);
+          value_indices.push_back(value_index);
+          value_ptrs.push_back(value_ptr);
+          batch_attrs.push_back(i);
+          data::attr_kind_dispatch(attr_kind, [&] (auto type_ptr)
+                                   {
+                                     typedef typename std::remove_pointer<decltype(type_ptr)>::type T;
+                                     size_t pos = batch_values.size_attr_vec<T>();
+                                     batch_values.resize<T>(pos+1);
+                                     batch_values.attr_vec<T>(pos).resize(value_block, 0);
+                                     value_pos.push_back(pos);
+                                   });
+        }
+
+      vector<string> read_paths;
+      vector<hsize_t> read_starts, read_blocks;
+      vector<void*> read_bufs;
+      for (size_t k=0; k<batch_attrs.size(); k++)
+        {
+          if (value_paths[k].size() == 0)
+            continue;
+          read_paths.push_back(value_paths[k]);
+          read_starts.push_back(value_starts[k]);
+          read_blocks.push_back(value_blocks[k]);
+          data::attr_kind_dispatch(get<1>(attr_info[batch_attrs[k]]), [&] (auto type_ptr)
+                                   {
+                                     typedef typename std::remove_pointer<decltype(type_ptr)>::type T;
+                                     read_bufs.push_back(batch_values.attr_vec<T>(value_pos[k]).data());
+                                   });
+        }
+      
+      /* Create property list for collective dataset operations. */
+      hid_t rapl = H5Pcreate (H5P_DATASET_XFER);
+      status = H5Pset_dxpl_mpio (rapl, H5FD_MPIO_COLLECTIVE);
+      throw_assert(status >= 0,
+                   "read_cell_attributes: error in H5Pset_dxpl_mpio");
+      status = hdf5::read_multi(file, read_paths, read_starts, read_blocks, read_bufs, rapl);
+      throw_assert(status >= 0,
+                   "read_cell_attributes: error in hdf5::read_multi");
+      throw_assert(H5Pclose(rapl) >= 0,
+                   "read_cell_attributes: error in H5Pclose");
+
+      for (size_t k=0; k<batch_attrs.size(); k++)
+        {
+          const string& attr_name  = get<0>(attr_info[batch_attrs[k]]);
+          const AttrKind& attr_kind = get<1>(attr_info[batch_attrs[k]]);
+          data::attr_kind_dispatch(attr_kind, [&] (auto type_ptr)
+                                   {
+                                     typedef typename std::remove_pointer<decltype(type_ptr)>::type T;
+                                     attr_values.insert(attr_name, value_indices[k], value_ptrs[k],
+                                                        batch_values.attr_vec<T>(value_pos[k]));
+                                   });
         }
 
       status = H5Fclose(file);
@@ -927,7 +1033,44 @@ namespace neuroh5
     }
 
 
-    int scatter_read_cell_attributes
+    void read_cell_attributes
+    (
+     MPI_Comm      comm,
+     const string& file_name,
+     const string& name_space,
+     const set<string>& attr_mask,
+     const string& pop_name,
+     const CELL_IDX_T& pop_start,
+     data::NamedAttrMap& attr_values,
+     size_t offset,
+     size_t numitems
+     )
+    {
+      read_cell_attributes_map(comm, file_name, name_space, attr_mask, pop_name, pop_start,
+                               attr_values, offset, numitems);
+    }
+
+
+    void read_cell_attributes
+    (
+     MPI_Comm      comm,
+     const string& file_name,
+     const string& name_space,
+     const set<string>& attr_mask,
+     const string& pop_name,
+     const CELL_IDX_T& pop_start,
+     data::NamedColumnarAttrMap& attr_values,
+     size_t offset,
+     size_t numitems
+     )
+    {
+      read_cell_attributes_map(comm, file_name, name_space, attr_mask, pop_name, pop_start,
+                               attr_values, offset, numitems);
+    }
+
+
+    template <class NamedAttrMapT, class AttrMapT>
+    static int scatter_read_cell_attributes_map
     (
      MPI_Comm                      all_comm,
      const string                 &file_name,
@@ -935,10 +1078,10 @@ namespace neuroh5
      const string                 &attr_name_space,
      const set<string>            &attr_mask,
      // A vector that maps nodes to compute ranks
-     const node_rank_map_t        &node_rank_map,
+     const data::NodeRankMap    &node_rank_map,
      const string                 &pop_name,
      const CELL_IDX_T             &pop_start,
-     data::NamedAttrMap           &attr_map,
+     NamedAttrMapT                &attr_map,
      // if positive, these arguments specify offset and number of entries to read
      // from the entries available to the current rank
      size_t offset,
@@ -978,9 +1121,9 @@ namespace neuroh5
 
 
 
-          map <rank_t, data::AttrMap > rank_attr_map;
+          map <rank_t, AttrMapT > rank_attr_map;
           {
-            data::NamedAttrMap  attr_values;
+            NamedAttrMapT  attr_values;
             read_cell_attributes(io_comm, file_name, attr_name_space, attr_mask, pop_name, pop_start,
                                  attr_values, offset, numitems * size);
             data::append_rank_attr_map(attr_values, node_rank_map, rank_attr_map);
@@ -1032,40 +1175,42 @@ namespace neuroh5
       
       for (size_t i=0; i<num_attrs[data::AttrMap::attr_index_float]; i++)
         {
-          attr_map.insert_name<float>(attr_names[data::AttrMap::attr_index_float][i]);
+          attr_map.template insert_name<float>(attr_names[data::AttrMap::attr_index_float][i]);
         }
       for (size_t i=0; i<num_attrs[data::AttrMap::attr_index_uint8]; i++)
         {
-          attr_map.insert_name<uint8_t>(attr_names[data::AttrMap::attr_index_uint8][i]);
+          attr_map.template insert_name<uint8_t>(attr_names[data::AttrMap::attr_index_uint8][i]);
         }
       for (size_t i=0; i<num_attrs[data::AttrMap::attr_index_int8]; i++)
         {
-          attr_map.insert_name<int8_t>(attr_names[data::AttrMap::attr_index_int8][i]);
+          attr_map.template insert_name<int8_t>(attr_names[data::AttrMap::attr_index_int8][i]);
         }
       for (size_t i=0; i<num_attrs[data::AttrMap::attr_index_uint16]; i++)
         {
-          attr_map.insert_name<uint16_t>(attr_names[data::AttrMap::attr_index_uint16][i]);
+          attr_map.template insert_name<uint16_t>(attr_names[data::AttrMap::attr_index_uint16][i]);
         }
       for (size_t i=0; i<num_attrs[data::AttrMap::attr_index_int16]; i++)
         {
-          attr_map.insert_name<int16_t>(attr_names[data::AttrMap::attr_index_int16][i]);
+          attr_map.template insert_name<int16_t>(attr_names[data::AttrMap::attr_index_int16][i]);
         }
       for (size_t i=0; i<num_attrs[data::AttrMap::attr_index_uint32]; i++)
         {
-          attr_map.insert_name<uint32_t>(attr_names[data::AttrMap::attr_index_uint32][i]);
+          attr_map.template insert_name<uint32_t>(attr_names[data::AttrMap::attr_index_uint32][i]);
         }
       for (size_t i=0; i<num_attrs[data::AttrMap::attr_index_int32]; i++)
         {
-          attr_map.insert_name<int32_t>(attr_names[data::AttrMap::attr_index_int32][i]);
+          attr_map.template insert_name<int32_t>(attr_names[data::AttrMap::attr_index_int32][i]);
         }
     
       // 7. Each ALL_COMM rank accumulates the vector sizes and allocates
       //    a receive buffer, recvcounts, and rdispls
       vector<char> recvbuf;
 
-      // 8. Each ALL_COMM rank participates in the MPI_Alltoallv
+      // 8. Each ALL_COMM rank participates in the MPI_Alltoallv; only
+      //    the I/O ranks have data to send
       throw_assert_nomsg(mpi::alltoallv_vector<char>(all_comm, MPI_CHAR, sendcounts, sdispls, sendbuf,
-                                                     recvcounts, rdispls, recvbuf) >= 0);
+                                                     recvcounts, rdispls, recvbuf,
+                                                     mpi::use_sparse_exchange(size, io_size)) >= 0);
       sendbuf.clear();
       sendbuf.shrink_to_fit();
 
@@ -1080,6 +1225,48 @@ namespace neuroh5
       return 0;
     }
 
+
+    int scatter_read_cell_attributes
+    (
+     MPI_Comm                      all_comm,
+     const string                 &file_name,
+     const int                     io_size,
+     const string                 &attr_name_space,
+     const set<string>            &attr_mask,
+     const data::NodeRankMap    &node_rank_map,
+     const string                 &pop_name,
+     const CELL_IDX_T             &pop_start,
+     data::NamedAttrMap           &attr_map,
+     size_t offset,
+     size_t numitems
+     )
+    {
+      return scatter_read_cell_attributes_map<data::NamedAttrMap, data::AttrMap>
+        (all_comm, file_name, io_size, attr_name_space, attr_mask, node_rank_map,
+         pop_name, pop_start, attr_map, offset, numitems);
+    }
+
+
+    int scatter_read_cell_attributes
+    (
+     MPI_Comm                      all_comm,
+     const string                 &file_name,
+     const int                     io_size,
+     const string                 &attr_name_space,
+     const set<string>            &attr_mask,
+     const data::NodeRankMap    &node_rank_map,
+     const string                 &pop_name,
+     const CELL_IDX_T             &pop_start,
+     data::NamedColumnarAttrMap   &attr_map,
+     size_t offset,
+     size_t numitems
+     )
+    {
+      return scatter_read_cell_attributes_map<data::NamedColumnarAttrMap, data::ColumnarAttrMap>
+        (all_comm, file_name, io_size, attr_name_space, attr_mask, node_rank_map,
+         pop_name, pop_start, attr_map, offset, numitems);
+    }
+
   
     void bcast_cell_attributes
     (
@@ -1131,9 +1318,7 @@ namespace neuroh5
 
       // get a file handle and retrieve the MPI info
       hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
-#ifdef HDF5_IS_PARALLEL
-      throw_assert_nomsg(H5Pset_fapl_mpio(fapl, io_comm, MPI_INFO_NULL) >= 0);
-#endif
+      throw_assert_nomsg(hdf5::set_parallel_file_access(fapl, io_comm) >= 0);
     
       hid_t file;
       if (rank == (unsigned int)root)
@@ -1354,58 +1539,89 @@ namespace neuroh5
     }
 
       
-    void read_cell_attribute_selection
+    // Rank 0 reads the attributes of a name space and the attributes
+    // whose index and pointer they share, and broadcasts them
+    static void get_cell_index_service
     (
-     MPI_Comm      comm,
-     const string& file_name,
-     const string& name_space,
-     const set<string>& attr_mask,
-     const string& pop_name,
-     const CELL_IDX_T& pop_start,
-     const std::vector<CELL_IDX_T>&  selection,
-     data::NamedAttrMap& attr_values
+     MPI_Comm          comm,
+     const string&     file_name,
+     const string&     name_space,
+     const string&     pop_name,
+     CellIndexService& service
      )
     {
-      herr_t status; 
-      unsigned int rank, size;
-      throw_assert_nomsg(MPI_Comm_size(comm, (int*)&size) >= 0);
-      throw_assert_nomsg(MPI_Comm_rank(comm, (int*)&rank) >= 0);
-
-      vector< tuple<string,AttrKind,vector<CELL_IDX_T>,vector<ATTR_PTR_T> > > attr_info;
+      int rank;
+      throw_assert_nomsg(MPI_Comm_rank(comm, &rank) == MPI_SUCCESS);
 
+      vector<char> sendbuf; size_t sendbuf_size=0;
       if (rank == 0)
         {
-          status = get_cell_attribute_index_ptr (file_name, name_space, pop_name, pop_start, attr_info);
-          throw_assert(status == 0,
-                       "read_cell_attributes: error in get_cell_attribute_index_ptr");
+          hid_t in_file = H5Fopen(file_name.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+          throw_assert(in_file >= 0, "get_cell_index_service: unable to open file " << file_name);
+
+          string path = hdf5::cell_attribute_prefix(name_space, pop_name);
+          if (hdf5::exists_dataset (in_file, path) > 0)
+            {
+              hid_t grp = H5Gopen2(in_file, path.c_str(), H5P_DEFAULT);
+              throw_assert(grp >= 0,
+                           "get_cell_index_service: unable to open group " << path);
+              
+              hsize_t idx = 0;
+              cell_attribute_index_ptr_data index_ptr_data;
+              index_ptr_data.read_index_ptr = false;
+              throw_assert(H5Literate(grp, H5_INDEX_NAME, H5_ITER_NATIVE, &idx,
+                                      &cell_attribute_index_ptr_cb, (void*) &index_ptr_data) >= 0,
+                           "get_cell_index_service: error iterating over group " << path);
+              for (const auto& attr : index_ptr_data.attributes)
+                {
+                  service.attributes.push_back(make_pair(get<0>(attr), get<1>(attr)));
+                }
+              service.owners = std::move(index_ptr_data.owners);
+              
+              throw_assert(H5Gclose(grp) >= 0,
+                           "get_cell_index_service: unable to close group " << path);
+            }
+          throw_assert(H5Fclose(in_file) >= 0,
+                       "get_cell_index_service: unable to close file " << file_name);
+
+          data::serialize_data(make_pair(service.attributes, service.owners), sendbuf);
+          sendbuf_size = sendbuf.size();
         }
-      // Broadcast the attribute names, types, indices, and pointers
-      {
-        vector<char> sendbuf; size_t sendbuf_size=0;
-        if (rank == 0)
-          {
-            data::serialize_data(attr_info, sendbuf);
-            sendbuf_size = sendbuf.size();
-          }
 
-        throw_assert(MPI_Bcast(&sendbuf_size, 1, MPI_SIZE_T, 0, comm) == MPI_SUCCESS,
-                     "read_cell_attributes: error in MPI_Bcast");
-        sendbuf.resize(sendbuf_size);
-        throw_assert(MPI_Bcast(&sendbuf[0], sendbuf_size, MPI_CHAR, 0, comm) == MPI_SUCCESS,
-                     "read_cell_attributes: error in MPI_Bcast");
-        
-        if (rank != 0)
-          {
-            data::deserialize_data(sendbuf, attr_info);
-          }
-      }
+      throw_assert(MPI_Bcast(&sendbuf_size, 1, MPI_SIZE_T, 0, comm) == MPI_SUCCESS,
+                   "get_cell_index_service: error in MPI_Bcast");
+      sendbuf.resize(sendbuf_size);
+      throw_assert(MPI_Bcast(&sendbuf[0], sendbuf_size, MPI_CHAR, 0, comm) == MPI_SUCCESS,
+                   "get_cell_index_service: error in MPI_Bcast");
+      if (rank != 0)
+        {
+          pair< vector< pair<string,AttrKind> >, vector<size_t> > attr_owners;
+          data::deserialize_data(sendbuf, attr_owners);
+          service.attributes = std::move(attr_owners.first);
+          service.owners = std::move(attr_owners.second);
+        }
+    }
+
+
+    static void read_cell_attribute_selection_service
+    (
+     MPI_Comm          comm,
+     const string&     file_name,
+     const string&     name_space,
+     const set<string>& attr_mask,
+     const string&     pop_name,
+     const CELL_IDX_T& pop_start,
+     const std::vector<CELL_IDX_T>&  selection,
+     CellIndexService& service,
+     data::NamedAttrMap& attr_values
+     )
+    {
+      herr_t status; 
 
       // get a file handle and retrieve the MPI info
       hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
-#ifdef HDF5_IS_PARALLEL
-      throw_assert(H5Pset_fapl_mpio(fapl, comm, MPI_INFO_NULL) >= 0,
+      throw_assert(hdf5::set_parallel_file_access(fapl, comm) >= 0,
                    "read_cell_attribute_selection: error setting MPI driver for file access");
-#endif
       
       hid_t file = H5Fopen(file_name.c_str(), H5F_ACC_RDONLY, fapl);
       throw_assert(file >= 0,
@@ -1414,117 +1630,50 @@ namespace neuroh5
       status = H5Pclose(fapl);
       throw_assert(status == 0,
                    "read_cell_attribute_selection: unable to close file access property list");
+
+      // the selection is looked up once per partition
+      map< size_t, pair< vector<CELL_IDX_T>, vector< pair<hsize_t,hsize_t> > > > lookups;
       
-      for (size_t i=0; i<attr_info.size(); i++)
+      for (size_t i=0; i<service.attributes.size(); i++)
         {
-          vector<ATTR_PTR_T> value_ptr;
-          vector<CELL_IDX_T> value_index;
-          
-          string attr_name  = get<0>(attr_info[i]);
-          AttrKind attr_kind = get<1>(attr_info[i]);
-          size_t attr_size  = attr_kind.size;
-          const vector<CELL_IDX_T>& index  = get<2>(attr_info[i]);
-          const vector<ATTR_PTR_T>& ptr  = get<3>(attr_info[i]);
-          string attr_path  = hdf5::cell_attribute_path (name_space, pop_name, attr_name);
+          const string& attr_name  = service.attributes[i].first;
+          const AttrKind& attr_kind = service.attributes[i].second;
           if ((attr_mask.size() > 0) && (attr_mask.count(attr_name) == 0))
             continue;
-          
-          switch (attr_kind.type)
+
+          const size_t owner = service.owners[i];
+          auto partition_it = service.partitions.find(owner);
+          if (partition_it == service.partitions.end())
             {
-            case UIntVal:
-              {
-                if (attr_size == 4)
-                  {
-                    vector<uint32_t> attr_values_uint32;
-                    status = hdf5::read_cell_attribute_selection(comm, file, attr_path, pop_start,
-                                                                 selection, index, ptr, value_index, value_ptr,
-                                                                 attr_values_uint32);
-                    attr_values.insert(attr_name, value_index, value_ptr, attr_values_uint32);
-                  }
-                else if (attr_size == 2)
-                  {
-                    vector<uint16_t> attr_values_uint16;
-                    status = hdf5::read_cell_attribute_selection(comm, file, attr_path, pop_start,
-                                                                 selection, index, ptr, value_index, value_ptr,
-                                                                 attr_values_uint16);
-                    attr_values.insert(attr_name, value_index, value_ptr, attr_values_uint16);
-                  }
-                else if (attr_size == 1)
-                  {
-                    vector<uint8_t> attr_values_uint8;
-                    status = hdf5::read_cell_attribute_selection(comm, file, attr_path, pop_start,
-                                                                 selection, index, ptr, value_index, value_ptr,
-                                                                 attr_values_uint8);
-                    attr_values.insert(attr_name, value_index, value_ptr, attr_values_uint8);
-                  }
-                else
-                  {
-                    throw runtime_error("Unsupported integer attribute size");
-                  };
-              }
-              break;
-            case SIntVal:
-              {
-                if (attr_size == 4)
-                  {
-                    vector<int32_t> attr_values_int32;
-                    status = hdf5::read_cell_attribute_selection(comm, file, attr_path, pop_start,
-                                                                 selection, index, ptr, value_index, value_ptr,
-                                                                 attr_values_int32);
-                    attr_values.insert(attr_name, value_index, value_ptr, attr_values_int32);
-                  }
-                else if (attr_size == 2)
-                  {
-                    vector<int16_t> attr_values_int16;
-                    status = hdf5::read_cell_attribute_selection(comm, file, attr_path, pop_start,
-                                                                 selection, index, ptr, value_index, value_ptr,
-                                                                 attr_values_int16);
-                    attr_values.insert(attr_name, value_index, value_ptr, attr_values_int16);
-                  }
-                else if (attr_size == 1)
-                  {
-                    vector<int8_t> attr_values_int8;
-                    status = hdf5::read_cell_attribute_selection(comm, file, attr_path, pop_start,
-                                                                 selection, index, ptr, value_index, value_ptr,
-                                                                 attr_values_int8);
-                    attr_values.insert(attr_name, value_index, value_ptr, attr_values_int8);
-                  }
-                else
-                  {
-                    throw runtime_error("Unsupported integer attribute size");
-                  };
-              }
-              break;
-            case FloatVal:
-              {
-                vector<float> attr_values_float;
-                status = hdf5::read_cell_attribute_selection(comm, file, attr_path, pop_start,
-                                                             selection, index, ptr, value_index, value_ptr,
-                                                             attr_values_float);
-                attr_values.insert(attr_name, value_index, value_ptr, attr_values_float);
-              }
-              break;
-            case EnumVal:
-              {
-                if (attr_size == 1)
-                  {
-                    vector<uint8_t> attr_values_uint8;
-                    status = hdf5::read_cell_attribute_selection(comm, file, attr_path, pop_start,
-                                                                 selection, index, ptr, value_index, value_ptr,
-                                                                 attr_values_uint8);
-                    attr_values.insert(attr_name, value_index, value_ptr, attr_values_uint8);
-                  }
-                else
-                  {
-                    throw runtime_error("Unsupported enumerated attribute size");
-                  };
-              }
-              break;
-            default:
-              throw runtime_error("Unsupported attribute type");
-              break;
+              string owner_path = hdf5::cell_attribute_path (name_space, pop_name,
+                                                             service.attributes[owner].first);
+              partition_it = service.partitions.insert(make_pair(owner, CellIndexPartition())).first;
+              status = hdf5::read_cell_index_partition(comm, file, owner_path, pop_start,
+                                                       partition_it->second);
+              throw_assert(status >= 0,
+                           "read_cell_attribute_selection: unable to read index of " << owner_path);
             }
-          
+          auto lookup_it = lookups.find(owner);
+          if (lookup_it == lookups.end())
+            {
+              lookup_it = lookups.insert(make_pair(owner, make_pair(vector<CELL_IDX_T>(),
+                                                                    vector< pair<hsize_t,hsize_t> >()))).first;
+              hdf5::query_cell_index_partition(comm, partition_it->second, pop_start, selection,
+                                               lookup_it->second.first, lookup_it->second.second);
+            }
+          const vector<CELL_IDX_T>& value_index = lookup_it->second.first;
+          const vector< pair<hsize_t,hsize_t> >& ranges = lookup_it->second.second;
+
+          string attr_path  = hdf5::cell_attribute_path (name_space, pop_name, attr_name);
+          data::attr_kind_dispatch(attr_kind, [&] (auto type_ptr)
+                                   {
+                                     typedef typename std::remove_pointer<decltype(type_ptr)>::type T;
+                                     vector<ATTR_PTR_T> value_ptr;
+                                     vector<T> values;
+                                     status = hdf5::read_cell_attribute_selection(comm, file, attr_path, ranges,
+                                                                                  value_ptr, values);
+                                     attr_values.insert(attr_name, value_index, value_ptr, values);
+                                   });
         }
       
       status = H5Fclose(file);
@@ -1532,6 +1681,49 @@ namespace neuroh5
                    "read_cell_attribute_selection: unable to close file " << file_name);
     }
 
+      
+    void read_cell_attribute_selection
+    (
+     MPI_Comm      comm,
+     const string& file_name,
+     const string& name_space,
+     const set<string>& attr_mask,
+     const string& pop_name,
+     const CELL_IDX_T& pop_start,
+     const std::vector<CELL_IDX_T>&  selection,
+     data::NamedAttrMap& attr_values
+     )
+    {
+      CellIndexService service;
+      get_cell_index_service(comm, file_name, name_space, pop_name, service);
+      read_cell_attribute_selection_service(comm, file_name, name_space, attr_mask, pop_name, pop_start,
+                                            selection, service, attr_values);
+    }
+
+      
+    void read_cell_attribute_selection
+    (
+     File&         file,
+     const string& name_space,
+     const set<string>& attr_mask,
+     const string& pop_name,
+     const CELL_IDX_T& pop_start,
+     const std::vector<CELL_IDX_T>&  selection,
+     data::NamedAttrMap& attr_values
+     )
+    {
+      auto key = make_pair(name_space, pop_name);
+      auto it = file.metadata.cell_index_services.find(key);
+      if (it == file.metadata.cell_index_services.end())
+        {
+          CellIndexService service;
+          get_cell_index_service(file.comm(), file.file_name(), name_space, pop_name, service);
+          it = file.metadata.cell_index_services.insert(make_pair(key, std::move(service))).first;
+        }
+      read_cell_attribute_selection_service(file.comm(), file.file_name(), name_space, attr_mask,
+                                            pop_name, pop_start, selection, it->second, attr_values);
+    }
+
     
     void scatter_read_cell_attribute_selection
     (
@@ -1771,7 +1963,9 @@ namespace neuroh5
                                      const CellPtr                   ptr_type,
                                      const size_t chunk_size,
                                      const size_t value_chunk_size,
-                                     const size_t cache_size
+                                     const size_t cache_size,
+                                     const FilterConfig& filters,
+                                     const WriteMode write_mode
                                      )
     {
       herr_t status;
@@ -1816,7 +2010,7 @@ namespace neuroh5
       MPI_Comm_set_errhandler(io_comm, MPI_ERRORS_RETURN);
 
 
-      if (is_io_rank) {
+      if (is_io_rank && (write_mode == WriteShared)) {
 
           if (access( file_name.c_str(), F_OK ) != 0)
             {
@@ -1837,7 +2031,17 @@ namespace neuroh5
       hid_t file;
 
       if (is_io_rank) {
-        file = hdf5::open_file(io_comm, file_name, true, true, cache_size);
+        if (write_mode == WriteSubfile)
+          {
+            int io_rank;
+            throw_assert(MPI_Comm_rank(io_comm, &io_rank) == MPI_SUCCESS,
+                         "append_cell_attribute_maps: error in MPI_Comm_rank");
+            file = hdf5::open_subfile(file_name, io_rank, cache_size);
+          }
+        else
+          {
+            file = hdf5::open_file(io_comm, file_name, true, true, cache_size);
+          }
       }
       
       for(auto it = attr_values_float.cbegin(); it != attr_values_float.cend(); ++it)
@@ -1846,7 +2050,7 @@ namespace neuroh5
           cell::append_cell_attribute_map<float> (comm, file, attr_namespace, pop_name, pop_start,
                                                   attr_name, it->second, data_type, io_rank_set,
                                                   index_type, ptr_type,
-                                                  chunk_size, value_chunk_size, cache_size);
+                                                  chunk_size, value_chunk_size, cache_size, filters);
         }
       for(auto it = attr_values_uint32.cbegin(); it != attr_values_uint32.cend(); ++it)
         {
@@ -1854,7 +2058,7 @@ namespace neuroh5
           cell::append_cell_attribute_map<uint32_t> (comm, file, attr_namespace, pop_name, pop_start,
                                                      attr_name, it->second, data_type, io_rank_set,
                                                      index_type, ptr_type,
-                                                     chunk_size, value_chunk_size, cache_size);
+                                                     chunk_size, value_chunk_size, cache_size, filters);
         }
       for(auto it = attr_values_uint16.cbegin(); it != attr_values_uint16.cend(); ++it)
         {
@@ -1862,7 +2066,7 @@ namespace neuroh5
           cell::append_cell_attribute_map<uint16_t> (comm, file, attr_namespace, pop_name, pop_start,
                                                      attr_name, it->second, data_type, io_rank_set,
                                                      index_type, ptr_type,
-                                                     chunk_size, value_chunk_size, cache_size);
+                                                     chunk_size, value_chunk_size, cache_size, filters);
         }
       for(auto it = attr_values_uint8.cbegin(); it != attr_values_uint8.cend(); ++it)
         {
@@ -1870,7 +2074,7 @@ namespace neuroh5
           cell::append_cell_attribute_map<uint8_t> (comm, file, attr_namespace, pop_name, pop_start,
                                                     attr_name, it->second, data_type, io_rank_set,
                                                     index_type, ptr_type,
-                                                    chunk_size, value_chunk_size, cache_size);
+                                                    chunk_size, value_chunk_size, cache_size, filters);
           }
         for(auto it = attr_values_int32.cbegin(); it != attr_values_int32.cend(); ++it)
           {
@@ -1878,7 +2082,7 @@ namespace neuroh5
             cell::append_cell_attribute_map<int32_t> (comm, file, attr_namespace, pop_name, pop_start,
                                                       attr_name, it->second, data_type, io_rank_set,
                                                       index_type, ptr_type,
-                                                      chunk_size, value_chunk_size, cache_size);
+                                                      chunk_size, value_chunk_size, cache_size, filters);
           }
         for(auto it = attr_values_int16.cbegin(); it != attr_values_int16.cend(); ++it)
           {
@@ -1886,7 +2090,7 @@ namespace neuroh5
             cell::append_cell_attribute_map<int16_t> (comm, file, attr_namespace, pop_name, pop_start,
                                                       attr_name, it->second, data_type, io_rank_set,
                                                       index_type, ptr_type,
-                                                      chunk_size, value_chunk_size, cache_size);
+                                                      chunk_size, value_chunk_size, cache_size, filters);
           }
         for(auto it = attr_values_int8.cbegin(); it != attr_values_int8.cend(); ++it)
           {
@@ -1894,7 +2098,7 @@ namespace neuroh5
             cell::append_cell_attribute_map<int8_t> (comm, file, attr_namespace, pop_name, pop_start,
                                                      attr_name, it->second, data_type, io_rank_set,
                                                      index_type, ptr_type,
-                                                     chunk_size, value_chunk_size, cache_size);
+                                                     chunk_size, value_chunk_size, cache_size, filters);
           }
 
         if (is_io_rank)
@@ -20,6 +20,7 @@
 #include "path_names.hh"
 #include "throw_assert.hh"
 #include "exists_group.hh"
+#include "neuroh5_file.hh"
 
 #define MAX_POP_NAME_LEN 1024
 
@@ -47,10 +48,11 @@ namespace neuroh5
     }
     
     //////////////////////////////////////////////////////////////////////////
-    herr_t read_population_names
+    // file must be open on rank 0
+    static herr_t read_population_names_file
     (
      MPI_Comm             comm,
-     const std::string&   file_name,
+     hid_t                file,
      vector<string>&      pop_names
      )
     {
@@ -67,8 +69,6 @@ namespace neuroh5
       // Rank 0 reads the names of populations and broadcasts
       if (rank == 0)
         {
-          
-          hid_t file = H5Fopen(file_name.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
           throw_assert_nomsg(file >= 0);
           
           hsize_t num_populations;
@@ -92,8 +92,6 @@ namespace neuroh5
         
               throw_assert_nomsg(H5Gclose(grp) >= 0);
             }
-          
-          throw_assert_nomsg(H5Fclose(file) >= 0);
         }
 
       {
@@ -124,10 +122,10 @@ namespace neuroh5
      * Read the valid population combinations
      *************************************************************************/
 
-    herr_t read_population_combos
+    static herr_t read_population_combos_file
     (
      MPI_Comm                   comm,
-     const std::string&         file_name,
+     hid_t                      file,
      set< pair<pop_t, pop_t> >&  pop_pairs
      )
     {
@@ -146,9 +144,8 @@ namespace neuroh5
       // process 0 reads the population pairs and broadcasts
       if (rank == 0)
         {
-          hid_t file = -1, dset = -1;
+          hid_t dset = -1;
 
-          file = H5Fopen(file_name.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
           throw_assert_nomsg(file >= 0);
 
           dset = H5Dopen2(file, hdf5::h5types_path_join(hdf5::POP_COMBS).c_str(),
@@ -181,7 +178,6 @@ namespace neuroh5
           throw_assert_nomsg(H5Tclose(ftype) >= 0);
 
           throw_assert_nomsg(H5Dclose(dset) >= 0);
-          throw_assert_nomsg(H5Fclose(file) >= 0);
         }
 
       throw_assert_nomsg(MPI_Bcast(&num_pairs, 1, MPI_SIZE_T, 0, comm) == MPI_SUCCESS);
@@ -204,10 +200,10 @@ namespace neuroh5
      * Read the population ranges
      *************************************************************************/
 
-    herr_t read_population_ranges
+    static herr_t read_population_ranges_file
     (
      MPI_Comm                    comm,
-     const std::string&          file_name,
+     hid_t                       file,
      pop_range_map_t&            pop_ranges,              
      size_t &                    n_nodes
      )
@@ -223,12 +219,11 @@ namespace neuroh5
 
       size_t num_ranges;
 
-      hid_t file = -1, dset = -1;
+      hid_t dset = -1;
 
       // process 0 reads the number of ranges and broadcasts
       if (rank == 0)
         {
-          file = H5Fopen(file_name.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
           throw_assert_nomsg(file >= 0);
           dset = H5Dopen2(file, hdf5::h5types_path_join(hdf5::POPULATIONS).c_str(), H5P_DEFAULT);
           throw_assert_nomsg(dset >= 0);
@@ -251,7 +246,6 @@ namespace neuroh5
           throw_assert_nomsg(H5Tclose(ftype) >= 0);
 
           throw_assert_nomsg(H5Dclose(dset) >= 0);
-          throw_assert_nomsg(H5Fclose(file) >= 0);
         }
 
       throw_assert_nomsg(MPI_Bcast(&num_ranges, 1, MPI_SIZE_T, 0, comm) == MPI_SUCCESS);
@@ -280,10 +274,10 @@ namespace neuroh5
      * Read the population labels
      *************************************************************************/
 
-    herr_t read_population_labels
+    static herr_t read_population_labels_file
     (
      MPI_Comm comm,
-     const string& file_name,
+     hid_t file,
      pop_label_map_t& pop_labels
      )
     {
@@ -298,9 +292,8 @@ namespace neuroh5
       // process 0 reads the number of populations and broadcasts
       if (rank == 0)
         {
-          hid_t file = -1, pop_labels_type = -1, grp_h5types = -1;
+          hid_t pop_labels_type = -1, grp_h5types = -1;
             
-          file = H5Fopen(file_name.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
           throw_assert_nomsg(file >= 0);
 
           if (hdf5::exists_group(file, hdf5::H5_TYPES.c_str()))
@@ -328,8 +321,6 @@ namespace neuroh5
               throw_assert_nomsg(H5Tclose(pop_labels_type) >= 0);
               throw_assert_nomsg(H5Gclose(grp_h5types) >= 0);
             }
-
-          throw_assert_nomsg(H5Fclose(file) >= 0);
         }
 
       {
@@ -355,7 +346,151 @@ namespace neuroh5
     }
 
 
+    /*************************************************************************
+     * Wrappers that open the file on rank 0, and overloads that read from
+     * a File session and cache the result
+     *************************************************************************/
+
+    static hid_t open_root_file (MPI_Comm comm, const string& file_name)
+    {
+      int rank;
+      throw_assert_nomsg(MPI_Comm_rank(comm, &rank) == MPI_SUCCESS);
+      hid_t file = -1;
+      if (rank == 0)
+        {
+          file = H5Fopen(file_name.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+          throw_assert(file >= 0, "unable to open file " << file_name);
+        }
+      return file;
+    }
+
+    static void close_root_file (hid_t file)
+    {
+      if (file >= 0)
+        {
+          throw_assert_nomsg(H5Fclose(file) >= 0);
+        }
+    }
+    
+    herr_t read_population_names
+    (
+     MPI_Comm             comm,
+     const std::string&   file_name,
+     vector<string>&      pop_names
+     )
+    {
+      hid_t file = open_root_file(comm, file_name);
+      herr_t ierr = read_population_names_file(comm, file, pop_names);
+      close_root_file(file);
+      return ierr;
+    }
+
+    herr_t read_population_names
+    (
+     File&                file,
+     vector<string>&      pop_names
+     )
+    {
+      File::Metadata& metadata = file.metadata;
+      if (!metadata.has_pop_names)
+        {
+          throw_assert_nomsg(read_population_names_file(file.comm(), file.id(), metadata.pop_names) >= 0);
+          metadata.has_pop_names = true;
+        }
+      pop_names = metadata.pop_names;
+      return 0;
+    }
 
+    herr_t read_population_combos
+    (
+     MPI_Comm                   comm,
+     const std::string&         file_name,
+     set< pair<pop_t, pop_t> >&  pop_pairs
+     )
+    {
+      hid_t file = open_root_file(comm, file_name);
+      herr_t ierr = read_population_combos_file(comm, file, pop_pairs);
+      close_root_file(file);
+      return ierr;
+    }
+
+    herr_t read_population_combos
+    (
+     File&                      file,
+     set< pair<pop_t, pop_t> >&  pop_pairs
+     )
+    {
+      File::Metadata& metadata = file.metadata;
+      if (!metadata.has_pop_pairs)
+        {
+          throw_assert_nomsg(read_population_combos_file(file.comm(), file.id(), metadata.pop_pairs) >= 0);
+          metadata.has_pop_pairs = true;
+        }
+      pop_pairs = metadata.pop_pairs;
+      return 0;
+    }
+
+    herr_t read_population_ranges
+    (
+     MPI_Comm                    comm,
+     const std::string&          file_name,
+     pop_range_map_t&            pop_ranges,              
+     size_t &                    n_nodes
+     )
+    {
+      hid_t file = open_root_file(comm, file_name);
+      herr_t ierr = read_population_ranges_file(comm, file, pop_ranges, n_nodes);
+      close_root_file(file);
+      return ierr;
+    }
+
+    herr_t read_population_ranges
+    (
+     File&                       file,
+     pop_range_map_t&            pop_ranges,              
+     size_t &                    n_nodes
+     )
+    {
+      File::Metadata& metadata = file.metadata;
+      if (!metadata.has_pop_ranges)
+        {
+          throw_assert_nomsg(read_population_ranges_file(file.comm(), file.id(), metadata.pop_ranges,
+                                                         metadata.total_num_nodes) >= 0);
+          metadata.has_pop_ranges = true;
+        }
+      pop_ranges.insert(metadata.pop_ranges.begin(), metadata.pop_ranges.end());
+      n_nodes = metadata.total_num_nodes;
+      return 0;
+    }
+
+    herr_t read_population_labels
+    (
+     MPI_Comm comm,
+     const string& file_name,
+     pop_label_map_t& pop_labels
+     )
+    {
+      hid_t file = open_root_file(comm, file_name);
+      herr_t ierr = read_population_labels_file(comm, file, pop_labels);
+      close_root_file(file);
+      return ierr;
+    }
+
+    herr_t read_population_labels
+    (
+     File& file,
+     pop_label_map_t& pop_labels
+     )
+    {
+      File::Metadata& metadata = file.metadata;
+      if (!metadata.has_pop_labels)
+        {
+          throw_assert_nomsg(read_population_labels_file(file.comm(), file.id(), metadata.pop_labels) >= 0);
+          metadata.has_pop_labels = true;
+        }
+      pop_labels.insert(metadata.pop_labels.begin(), metadata.pop_labels.end());
+      return 0;
+    }
 
   }
 }
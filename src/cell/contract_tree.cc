@@ -4,337 +4,144 @@
 ///
 ///  Tree contraction routine.
 ///
-///  Copyright (C) 2016-2019 Project NeuroH5.
+///  Copyright (C) 2016-2025 Project NeuroH5.
 //==============================================================================
 
 #include "debug.hh"
 
-#include <cstdio>
-#include <set>
-#include <map>
-#include <vector>
+#include <algorithm>
 #include <deque>
-#include "ngraph.hh"
+#include <utility>
+#include <vector>
 
 #include "neuroh5_types.hh"
+#include "contract_tree.hh"
+#include "throw_assert.hh"
 
 using namespace std;
-using namespace NGraph;
 
 namespace neuroh5
 {
   namespace cell
   {
-  
-    void contract_tree_bfs (const Graph &A,
-                            const deque<SWC_TYPE_T>& types, 
-                            Graph::vertex_set& roots,
-                            Graph &S, contraction_map_t& contraction_map,
-                            Graph::vertex sp, Graph::vertex spp)
+
+    void contract_tree_sections (const TreeTopology& topology, size_t t,
+                                 const deque<LAYER_IDX_T>& regions,
+                                 const deque<SWC_TYPE_T>& types,
+                                 const bool split_regions,
+                                 deque<SECTION_IDX_T>& src_vector,
+                                 deque<SECTION_IDX_T>& dst_vector,
+                                 deque<SECTION_IDX_T>& sec_vector)
     {
-    
-      for ( Graph::vertex_set::const_iterator p = roots.begin(); p != roots.end(); ++p)
+      const size_t num_points = topology.num_points(t);
+      throw_assert(types.size() == num_points,
+                   "contract_tree_sections: mismatch between types and points");
+      throw_assert((!split_regions) || (regions.size() == num_points),
+                   "contract_tree_sections: mismatch between regions and points");
+
+      // each frame is a point that starts a section, the section of its
+      // parent point, and the point that ended the parent section
+      struct Frame
+      {
+        NODE_IDX_T    v;
+        SECTION_IDX_T sp;
+        NODE_IDX_T    spp;
+      };
+
+      vector< vector<NODE_IDX_T> > section_members;
+      vector< pair<SECTION_IDX_T, SECTION_IDX_T> > section_edges;
+      vector<Frame> stack;
+
+      data::AttrSpan<NODE_IDX_T> roots = topology.tree_roots(t);
+      if (roots.size() > 0)
         {
-          deque <Graph::vertex> section_members; 
-          Graph::vertex s, v = Graph::node (p); 
-          LAYER_IDX_T p_type = types[v];
-                                     
-          if (contraction_map[sp].size() > 1)
-            {
-              // creates an entry in the section map for this node
-              section_members.push_back(v);
-              // creates a new section node in the contraction map
-              s = contraction_map.size();
-              // insert new entry into contraction map
-              // (key is section node, values is the set of nodes that are section members)
-              contraction_map.insert(make_pair(s,section_members));
-            
-              // creates an entry in the section graph
-              S.insert_vertex(s);
-            
-              // adds an edge from parent section to new section
-              S.insert_edge(sp,s);
-            }
-          else
-            {
-              s = sp;
-              contraction_map[s].push_back(v);
-            }
-        
-          // identifies the node neighbors
-          Graph::vertex_set outs = A.out_neighbors(v);
-          bool type_change = false;
-        
-          while ((outs.size() == 1) && (!(type_change)))
-            {
-              v = Graph::node(outs.cbegin());
-              if (types[v] != p_type)
-                {
-                  type_change = true;
-                }
-              else
-                {
-                  // adds the output node to the section map for the current section
-                  contraction_map[s].push_back(v);
-                  // obtains the neighbors of the next node
-                  outs = A.out_neighbors(v);
-                }
-            }
-          // if node is terminal, insert parent to ensure section has more than one node
-          if ((outs.size() == 0) && (contraction_map[s].size() == 1))
-            {
-              if (spp != v)
-                contraction_map[s].insert (contraction_map[s].begin(), spp);
-            }
-        
-          // if the node is a branching point or region change point, recurse to create new section entry
-          if ((outs.size() > 1) || type_change)
-            {
-              contract_tree_bfs(A, types, outs, S, contraction_map, s, v);
-            }
+          section_members.resize(1);
+        }
+      for (size_t i = roots.size(); i > 0; i--)
+        {
+          stack.push_back(Frame { roots[i-1], 0, 0 });
         }
 
-    }
-
-    void contract_tree_dfs (const Graph &A, 
-                            const deque<SWC_TYPE_T>& types, 
-                            Graph::vertex_set& roots,
-                            Graph &S, contraction_map_t& contraction_map,
-                            Graph::vertex sp, Graph::vertex spp)
-    {
-      for ( Graph::vertex_set::const_iterator p = roots.begin(); p != roots.end(); ++p)
+      // depth-first, so that sections are numbered in the order of
+      // the traversal
+      while (!stack.empty())
         {
-          deque <Graph::vertex> section_members; 
-          Graph::vertex s, v = Graph::node (p); 
-          SWC_TYPE_T p_type = types[v];
+          const Frame frame = stack.back();
+          stack.pop_back();
 
-          
-          if (contraction_map[sp].size() > 1)
+          NODE_IDX_T v = frame.v;
+          const LAYER_IDX_T p_region = split_regions ? regions[v] : 0;
+          const SWC_TYPE_T p_type = types[v];
+
+          SECTION_IDX_T s;
+          if (section_members[frame.sp].size() > 1)
             {
-              // creates an entry in the section map for this node
-              section_members.push_back(v);
-              // creates a new section node in the contraction map
-              s = contraction_map.size();
-              // insert new entry into contraction map
-              // (key is section node, values is the set of nodes that are section members)
-              contraction_map.insert(make_pair(s,section_members));
-            
-              // creates an entry in the section graph
-              S.insert_vertex(s);
-            
-              // adds an edge from parent section to new section
-              S.insert_edge(sp,s);
+              // starts a new section as child of the parent section
+              s = section_members.size();
+              section_members.push_back(vector<NODE_IDX_T>(1, v));
+              section_edges.push_back(make_pair(frame.sp, s));
             }
           else
             {
-              s = sp;
-              contraction_map[s].push_back(v);
+              s = frame.sp;
+              section_members[s].push_back(v);
             }
 
-          // identifies the node neighbors
-          Graph::vertex_set outs = A.out_neighbors(v);
-          bool type_change = false;
-
-          while ((outs.size() == 1) && (!(type_change)))
+          // follows the unbranched points that have the type and region
+          // of the first point
+          data::AttrSpan<NODE_IDX_T> outs = topology.point_children(t, v);
+          bool change = false;
+          while ((outs.size() == 1) && (!change))
             {
-              v = Graph::node(outs.cbegin());
-              if (types[v] != p_type)
+              v = outs[0];
+              if ((split_regions && (regions[v] != p_region)) || (types[v] != p_type))
                 {
-                  type_change = true;
+                  change = true;
                 }
               else
                 {
-                  // adds the output node to the section map for the current section
-                  contraction_map[s].push_back(v);
-                  // obtains the neighbors of the next node
-                  outs = A.out_neighbors(v);
+                  section_members[s].push_back(v);
+                  outs = topology.point_children(t, v);
                 }
             }
 
-          // if node is terminal, insert parent to ensure section has more than one node
-          if ((outs.size() == 0) && (contraction_map[s].size() == 1))
+          // if the point is terminal, inserts the parent point to ensure
+          // the section has more than one point
+          if ((outs.size() == 0) && (section_members[s].size() == 1) && (frame.spp != v))
             {
-              if (spp != v)
-                contraction_map[s].insert (contraction_map[s].begin(), spp);
+              section_members[s].insert(section_members[s].begin(), frame.spp);
             }
-          
-          // if the node is a branching point, recurse to create new section entry
-          if ((outs.size() > 1) || type_change)
+
+          // a branching point or a type or region change starts a
+          // section for each child
+          if ((outs.size() > 1) || change)
             {
-              for ( Graph::vertex_set::const_iterator out = outs.cbegin(); out != outs.cend(); ++out)
+              for (size_t i = outs.size(); i > 0; i--)
                 {
-                  Graph::vertex_set new_root;
-                  new_root.insert(Graph::node(out));
-                  contract_tree_dfs(A, types, new_root, S, contraction_map, s, v);
+                  stack.push_back(Frame { outs[i-1], s, v });
                 }
             }
         }
 
-    }
-
-    void contract_tree_regions_bfs (const Graph &A,
-                                    const deque<LAYER_IDX_T>& regions,
-                                    const deque<SWC_TYPE_T>& types, 
-                                    Graph::vertex_set& roots,
-                                    Graph &S, contraction_map_t& contraction_map,
-                                    Graph::vertex sp, Graph::vertex spp)
-    {
-    
-      for ( Graph::vertex_set::const_iterator p = roots.begin(); p != roots.end(); ++p)
+      const NODE_IDX_T id_base = topology.id_base[t];
+      sec_vector.push_back(section_members.size());
+      for (const vector<NODE_IDX_T>& members : section_members)
         {
-        
-          deque <Graph::vertex> section_members; 
-          Graph::vertex s, v = Graph::node (p); 
-          LAYER_IDX_T p_region = regions[v];
-          SWC_TYPE_T p_type = types[v];
-                                     
-          if (contraction_map[sp].size() > 1)
-            {
-              // creates an entry in the section map for this node
-              section_members.push_back(v);
-              // creates a new section node in the contraction map
-              s = contraction_map.size();
-              // insert new entry into contraction map
-              // (key is section node, values is the set of nodes that are section members)
-              contraction_map.insert(make_pair(s,section_members));
-            
-              // creates an entry in the section graph
-              S.insert_vertex(s);
-            
-              // adds an edge from parent section to new section
-              S.insert_edge(sp,s);
-            }
-          else
-            {
-              s = sp;
-              contraction_map[s].push_back(v);
-            }
-        
-          // identifies the node neighbors
-          Graph::vertex_set outs = A.out_neighbors(v);
-          bool region_change = false;
-          bool type_change = false;
-        
-          while ((outs.size() == 1) && (!(region_change || type_change)))
-            {
-              // adds the output node to the section map for the current section
-              v = Graph::node(outs.cbegin());
-              if (regions[v] != p_region)
-                {
-                  region_change = true;
-                }
-              else if (types[v] != p_type)
-                {
-                  type_change = true;
-                }
-              else
-                {
-                  contraction_map[s].push_back(v);
-                  // obtains the neighbors of the next node
-                  outs = A.out_neighbors(v);
-                }
-            }
-
-          // if node is terminal, insert parent to ensure section has more than one node
-          if ((outs.size() == 0) && (contraction_map[s].size() == 1))
+          sec_vector.push_back(members.size());
+          for (const NODE_IDX_T p : members)
             {
-              if (spp != v)
-                contraction_map[s].insert (contraction_map[s].begin(), spp);
-            }
-        
-          // if the node is a branching point or region change point, recurse to create new section entry
-          if ((outs.size() > 1) || region_change || type_change)
-            {
-              contract_tree_regions_bfs(A, regions, types, outs, S, contraction_map, s, v);
+              sec_vector.push_back(id_base + p);
             }
         }
 
-    }
-
-    void contract_tree_regions_dfs (const Graph &A,
-                                    const deque<LAYER_IDX_T>& regions,
-                                    const deque<SWC_TYPE_T>& types, 
-                                    Graph::vertex_set& roots,
-                                    Graph &S, contraction_map_t& contraction_map,
-                                    Graph::vertex sp, Graph::vertex spp)
-    {
-    
-      for ( Graph::vertex_set::const_iterator p = roots.begin(); p != roots.end(); ++p)
+      sort(section_edges.begin(), section_edges.end());
+      for (const pair<SECTION_IDX_T, SECTION_IDX_T>& edge : section_edges)
         {
-          deque <Graph::vertex> section_members; 
-          Graph::vertex s, v = Graph::node (p); 
-          LAYER_IDX_T p_region = regions[v];
-          SWC_TYPE_T p_type = types[v];
-
-          if (contraction_map[sp].size() > 1)
-            {
-              //if (spp != v) section_members.push_back(spp);
-              // creates an entry in the section map for this node
-              section_members.push_back(v);
-              // creates a new section node in the contraction map
-              s = contraction_map.size();
-              // insert new entry into contraction map
-              // (key is section node, values is the set of nodes that are section members)
-              contraction_map.insert(make_pair(s,section_members));
-            
-              // creates an entry in the section graph
-              S.insert_vertex(s);
-            
-              // adds an edge from parent section to new section
-              S.insert_edge(sp,s);
-            }
-          else
-            {
-              s = sp;
-              contraction_map[s].push_back(v);
-            }
-
-          // identifies the node neighbors
-          Graph::vertex_set outs = A.out_neighbors(v);
-          bool region_change = false;
-          bool type_change = false;
-        
-          while ((outs.size() == 1) && (!(region_change || type_change)))
-            {
-              // adds the output node to the section map for the current section
-              v = Graph::node(outs.cbegin());
-              if (regions[v] != p_region)
-                {
-                  region_change = true;
-                }
-              else if (types[v] != p_type)
-                {
-                  type_change = true;
-                }
-              else
-                {
-                  contraction_map[s].push_back(v);
-                  // obtains the neighbors of the next node
-                  outs = A.out_neighbors(v);
-                }
-            }
-
-          // if node is terminal, insert parent to ensure section has more than one node
-          if ((outs.size() == 0) && (contraction_map[s].size() == 1))
-            {
-              if (spp != v)
-                contraction_map[s].insert (contraction_map[s].begin(), spp);
-            }
-
-          // if the node is a branching point, recurse to create new section entry
-          if ((outs.size() > 1) || region_change || type_change)
-            {
-              for ( Graph::vertex_set::const_iterator out = outs.begin(); out != outs.end(); ++out)
-                {
-                  Graph::vertex_set new_root;
-                  new_root.insert(*out);
-                  contract_tree_regions_dfs(A, regions, types, new_root, S, contraction_map, s, v);
-                }
-            }
+          src_vector.push_back(edge.first);
+          dst_vector.push_back(edge.second);
         }
-
     }
 
   }
-  
+
 }
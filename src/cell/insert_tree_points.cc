@@ -4,17 +4,17 @@
 ///
 ///  Insert points into tree structure.
 ///
-///  Copyright (C) 2016-2019 Project NeuroH5.
+///  Copyright (C) 2016-2025 Project NeuroH5.
 //==============================================================================
 
 
 #include "debug.hh"
 
 #include <algorithm>
-#include <set>
 
 #include "neuroh5_types.hh"
 #include "throw_assert.hh"
+#include "tree_topology.hh"
 
 
 using namespace std;
@@ -60,33 +60,11 @@ namespace neuroh5
       COORD_T dst_origin_y = ycoords[0];
       COORD_T dst_origin_z = zcoords[0];
       
-      size_t num_nodes = num_xpoints, sections_ptr=1;
+      size_t num_nodes = num_xpoints;
       size_t num_sections = sections[0];
       size_t include_num_sections = include_sections[0];
 
-      set<NODE_IDX_T> all_section_nodes;
-      while (sections_ptr < sections.size())
-        {
-          std::vector<NODE_IDX_T> section_nodes;
-          size_t num_section_nodes = sections[sections_ptr];
-          sections_ptr++;
-          for (size_t p = 0; p < num_section_nodes; p++)
-            {
-              NODE_IDX_T node_idx = sections[sections_ptr];
-              if (!(node_idx <= num_nodes))
-                {
-                  printf("tree id = %u\n",tree_id);
-                  printf("node_idx = %u\n",node_idx);
-                  printf("num_nodes = %lu\n", num_nodes);
-                }
-              throw_assert_nomsg(node_idx <= num_nodes);
-              all_section_nodes.insert(node_idx);
-              sections_ptr++;
-            }
-      
-        }
-  
-      throw_assert_nomsg(all_section_nodes.size() == num_nodes);
+      throw_assert_nomsg(count_section_points(tree_id, sections, num_nodes) == num_nodes);
 
       for (auto it = include_src_vector.begin();
            it != include_src_vector.end();
@@ -114,30 +92,20 @@ namespace neuroh5
             }
         }
       
-      sections_ptr = 1;
       size_t include_num_nodes = include_xcoords.size();
-      set<NODE_IDX_T> include_all_section_nodes;
+      throw_assert_nomsg(count_section_points(tree_id, include_sections, include_num_nodes) == include_num_nodes);
+
+      size_t sections_ptr = 1;
       while (sections_ptr < include_sections.size())
         {
-          std::vector<NODE_IDX_T> section_nodes;
           size_t num_section_nodes = include_sections[sections_ptr];
           sections_ptr++;
           for (size_t p = 0; p < num_section_nodes; p++)
             {
-              NODE_IDX_T node_idx = include_sections[sections_ptr];
-              if (!(node_idx <= include_num_nodes))
-                {
-                  printf("node_idx = %u\n",node_idx);
-                  printf("include_num_nodes = %lu\n", include_num_nodes);
-                }
-              throw_assert_nomsg(node_idx <= include_num_nodes);
-              include_all_section_nodes.insert(node_idx);
-              include_sections[sections_ptr] += num_nodes;              
+              include_sections[sections_ptr] += num_nodes;
               sections_ptr++;
             }
-      
         }
-      throw_assert_nomsg(include_all_section_nodes.size() == include_num_nodes);
       
       for (auto it = include_parents.begin();
            it != include_parents.end();
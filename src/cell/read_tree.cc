@@ -17,6 +17,9 @@
 #include "neuroh5_types.hh"
 #include "cell_attributes.hh"
 #include "attr_map.hh"
+#include "columnar_attr_map.hh"
+#include "tree_arena.hh"
+#include "tree_encoding.hh"
 #include "throw_assert.hh"
 
 namespace neuroh5
@@ -83,6 +86,7 @@ namespace neuroh5
       read_cell_attributes (comm, file_name, hdf5::TREES, attr_mask,
                             pop_name, pop_start, attr_values,
                             offset, numitems);
+      decode_tree_points(attr_values);
 
       append_tree_list (pop_start, attr_values, tree_list);
     
@@ -90,6 +94,31 @@ namespace neuroh5
     }
 
 
+    int read_trees
+    (
+     MPI_Comm comm,
+     const std::string& file_name,
+     const std::string& pop_name,
+     const CELL_IDX_T& pop_start,
+     data::TreeArena &trees,
+     size_t offset,
+     size_t numitems
+     )
+    {
+      data::NamedColumnarAttrMap attr_values;
+      set<string> attr_mask;
+
+      read_cell_attributes (comm, file_name, hdf5::TREES, attr_mask,
+                            pop_name, pop_start, attr_values,
+                            offset, numitems);
+      decode_tree_points(attr_values);
+
+      trees.assign(attr_values, attr_values.index);
+
+      return 0;
+    }
+
+
     /*****************************************************************************
      * Load tree data structures from HDF5
      *****************************************************************************/
@@ -109,6 +138,7 @@ namespace neuroh5
       read_cell_attribute_selection (comm, file_name, hdf5::TREES, attr_mask,
                                      pop_name, pop_start, 
                                      selection, attr_values);
+      decode_tree_points(attr_values);
       append_tree_list (pop_start, attr_values, tree_list);
     
       return 0;
@@ -16,6 +16,9 @@
 
 #include "neuroh5_types.hh"
 #include "attr_map.hh"
+#include "columnar_attr_map.hh"
+#include "tree_arena.hh"
+#include "tree_encoding.hh"
 #include "cell_attributes.hh"
 #include "rank_range.hh"
 #include "range_sample.hh"
@@ -49,7 +52,7 @@ namespace neuroh5
      const int                       io_size,
      const vector<string>           &attr_name_spaces,
      // A vector that maps nodes to compute ranks
-     const node_rank_map_t           &node_rank_map,
+     const data::NodeRankMap       &node_rank_map,
      const string                    &pop_name,
      const CELL_IDX_T                 pop_start,
      map<CELL_IDX_T, neurotree_t>    &tree_map,
@@ -116,6 +119,7 @@ namespace neuroh5
             read_cell_attributes (io_comm, file_name, hdf5::TREES, attr_mask,
                                   pop_name, pop_start, attr_values,
                                   offset, numitems * size);
+            decode_tree_points(attr_values);
 
             data::append_rank_tree_map(attr_values, node_rank_map, rank_tree_map);
           }
@@ -134,8 +138,10 @@ namespace neuroh5
         vector<size_t> recvcounts, rdispls;
         vector<char> recvbuf;
 
+        // only the I/O ranks have data to send
         throw_assert_nomsg(mpi::alltoallv_vector<char>(all_comm, MPI_CHAR, sendcounts, sdispls, sendbuf,
-                                                       recvcounts, rdispls, recvbuf) >= 0);
+                                                       recvcounts, rdispls, recvbuf,
+                                                       mpi::use_sparse_exchange(size, io_size)) >= 0);
         sendbuf.clear();
         sendbuf.shrink_to_fit();
 
@@ -165,6 +171,130 @@ namespace neuroh5
     }
 
 
+    int scatter_read_trees
+    (
+     MPI_Comm                        comm,
+     const string                   &file_name,
+     const int                       io_size,
+     const vector<string>           &attr_name_spaces,
+     const data::NodeRankMap       &node_rank_map,
+     const string                    &pop_name,
+     const CELL_IDX_T                 pop_start,
+     data::TreeArena                 &trees,
+     map<string, data::NamedAttrMap> &attr_maps,
+     size_t offset,
+     size_t numitems
+     )
+    {
+      std::vector<char> sendbuf;
+      std::vector<size_t> sendcounts, sdispls;
+
+      MPI_Comm all_comm;
+      // MPI Communicator for I/O ranks
+      MPI_Comm io_comm;
+      // MPI group color value used for I/O ranks
+      int io_color = 1;
+
+      throw_assert_nomsg(io_size > 0);
+
+      throw_assert(MPI_Comm_dup(comm, &(all_comm)) == MPI_SUCCESS,
+                   "scatter_read_trees: unable to duplicate MPI communicator");
+
+      int srank, ssize; size_t rank=0, size=0;
+      throw_assert_nomsg(MPI_Comm_size(all_comm, &ssize) == MPI_SUCCESS);
+      throw_assert_nomsg(MPI_Comm_rank(all_comm, &srank) == MPI_SUCCESS);
+      throw_assert_nomsg(srank >= 0);
+      throw_assert_nomsg(ssize > 0);
+      rank = srank;
+      size = ssize;
+
+      set<size_t> io_rank_set;
+      data::range_sample(size, io_size, io_rank_set);
+      bool is_io_rank = (io_rank_set.find(rank) != io_rank_set.end());
+
+      if (is_io_rank)
+        {
+          throw_assert(MPI_Comm_split(all_comm,io_color,rank,&io_comm) == MPI_SUCCESS,
+                       "scatter_read_trees: error in MPI_Comm_split");
+          MPI_Comm_set_errhandler(io_comm, MPI_ERRORS_RETURN);
+        }
+      else
+        {
+          MPI_Comm_split(all_comm,0,rank,&io_comm);
+        }
+
+      sendcounts.resize(size,0);
+      sdispls.resize(size,0);
+
+      if (is_io_rank)
+        {
+          map <rank_t, data::TreeArena> rank_tree_arena;
+          {
+            data::NamedColumnarAttrMap attr_values;
+            set <string> attr_mask;
+
+            read_cell_attributes (io_comm, file_name, hdf5::TREES, attr_mask,
+                                  pop_name, pop_start, attr_values,
+                                  offset, numitems * size);
+            decode_tree_points(attr_values);
+
+            map <rank_t, vector<CELL_IDX_T> > rank_cells;
+            for (const CELL_IDX_T gid : attr_values.index)
+              {
+                data::NodeRankMap::Ranks dst_ranks = node_rank_map.find(gid);
+                throw_assert(!dst_ranks.empty(),
+                             "scatter_read_trees: index not found in node rank map");
+                for (const rank_t& dst_rank : dst_ranks)
+                  {
+                    rank_cells[dst_rank].push_back(gid);
+                  }
+              }
+            for (const auto& element : rank_cells)
+              {
+                rank_tree_arena[element.first].assign(attr_values, element.second);
+              }
+          }
+          data::serialize_rank_tree_arena (size, rank, rank_tree_arena, sendcounts, sendbuf, sdispls);
+        }
+
+      throw_assert_nomsg(MPI_Barrier(io_comm) == MPI_SUCCESS);
+      throw_assert_nomsg(MPI_Comm_free(&io_comm) == MPI_SUCCESS);
+
+      {
+        vector<size_t> recvcounts, rdispls;
+        vector<char> recvbuf;
+
+        // only the I/O ranks have data to send
+        throw_assert_nomsg(mpi::alltoallv_vector<char>(all_comm, MPI_CHAR, sendcounts, sdispls, sendbuf,
+                                                       recvcounts, rdispls, recvbuf,
+                                                       mpi::use_sparse_exchange(size, io_size)) >= 0);
+        sendbuf.clear();
+        sendbuf.shrink_to_fit();
+
+        if (recvbuf.size() > 0)
+          {
+            data::deserialize_rank_tree_arena (size, recvbuf, recvcounts, rdispls, trees);
+          }
+      }
+
+      for (string attr_name_space : attr_name_spaces)
+        {
+          data::NamedAttrMap attr_map;
+          set <string> attr_mask;
+
+          scatter_read_cell_attributes(all_comm, file_name, io_size,
+                                       attr_name_space, attr_mask, node_rank_map,
+                                       pop_name, pop_start, attr_map,
+                                       offset, numitems);
+          attr_maps.insert(make_pair(attr_name_space, attr_map));
+        }
+
+      throw_assert_nomsg(MPI_Comm_free(&all_comm) == MPI_SUCCESS);
+
+      return 0;
+    }
+
+
     int scatter_read_tree_selection
     (
      MPI_Comm                        all_comm,
@@ -185,6 +315,7 @@ namespace neuroh5
 
       scatter_read_cell_attribute_selection (all_comm, file_name, io_size, hdf5::TREES, attr_mask,
                                              pop_name, pop_start, selection, attr_values);
+      decode_tree_points(attr_values);
       append_tree_map(attr_values, tree_map);
 
       for (string attr_name_space : attr_name_spaces)
@@ -0,0 +1,277 @@
+// -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+//==============================================================================
+///  @file stitch_cell_attributes.cc
+///
+///  Merges cell attributes written in subfile mode into the output file.
+///
+///  Copyright (C) 2016-2025 Project NeuroH5.
+//==============================================================================
+
+#include "neuroh5_types.hh"
+#include "stitch_cell_attributes.hh"
+#include "cell_attributes.hh"
+#include "cell_populations.hh"
+#include "group_contents.hh"
+#include "exists_group.hh"
+#include "path_names.hh"
+#include "subfiles.hh"
+#include "attr_map.hh"
+#include "attr_kind_dispatch.hh"
+#include "serialize_data.hh"
+#include "mpi_debug.hh"
+#include "throw_assert.hh"
+
+#include <hdf5.h>
+#include <mpi.h>
+
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <set>
+#include <string>
+#include <typeindex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace neuroh5
+{
+  namespace cell
+  {
+
+    // population -> attribute namespace -> cell attributes
+    typedef map< string, map< string, vector< pair<string, AttrKind> > > > subfile_cell_attribute_map_t;
+
+
+    // Creates an empty value map for each attribute of type T, so that
+    // all ranks append the same attributes, and moves in the values
+    // read from a subfile
+    template <class T>
+    static void take_attr_maps
+    (
+     const vector<string>&                      attr_names,
+     data::NamedAttrMap&                        attr_values,
+     map<string, map<CELL_IDX_T, deque<T> > >&  output
+     )
+    {
+      for (const string& attr_name : attr_names)
+        {
+          output[attr_name];
+        }
+
+      vector<string> value_attr_names;
+      attr_values.attr_names_type<T>(value_attr_names);
+      vector< map<CELL_IDX_T, deque<T> > >& value_maps = attr_values.attr_maps<T>();
+      for (size_t i = 0; i < value_attr_names.size(); i++)
+        {
+          auto it = output.find(value_attr_names[i]);
+          throw_assert(it != output.end(),
+                       "stitch_cell_attribute_subfiles: attribute " << value_attr_names[i] <<
+                       " has different types in different subfiles");
+          it->second = std::move(value_maps[i]);
+        }
+    }
+
+
+    void stitch_cell_attribute_subfiles
+    (
+     MPI_Comm            comm,
+     const string&       file_name,
+     const size_t        chunk_size,
+     const size_t        value_chunk_size,
+     const size_t        cache_size,
+     const FilterConfig& filters
+     )
+    {
+      int rank, size;
+      throw_assert(MPI_Comm_size(comm, &size) == MPI_SUCCESS,
+                   "stitch_cell_attribute_subfiles: unable to obtain MPI communicator size");
+      throw_assert(MPI_Comm_rank(comm, &rank) == MPI_SUCCESS,
+                   "stitch_cell_attribute_subfiles: unable to obtain MPI communicator rank");
+
+      size_t num_subfiles = 0;
+      throw_assert(hdf5::num_subfiles(comm, file_name, num_subfiles) >= 0,
+                   "stitch_cell_attribute_subfiles: unable to determine number of subfiles");
+
+      // MPI rank 0 enumerates the populations, namespaces and attributes
+      // in the subfiles and broadcasts them
+      subfile_cell_attribute_map_t subfile_attributes;
+      vector< set< pair<string, string> > > subfile_name_spaces(num_subfiles);
+      {
+        vector<char> sendbuf; uint32_t sendbuf_size=0;
+        if (rank == 0)
+          {
+            for (size_t i = 0; i < num_subfiles; i++)
+              {
+                const string subfile_name = hdf5::subfile_name(file_name, i);
+
+                vector<string> pop_names;
+                hid_t file = H5Fopen(subfile_name.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+                throw_assert(file >= 0,
+                             "stitch_cell_attribute_subfiles: unable to open subfile " << subfile_name);
+                if (hdf5::exists_group(file, hdf5::POPULATIONS) > 0)
+                  {
+                    throw_assert(hdf5::group_contents(MPI_COMM_SELF, file, hdf5::POPULATIONS, pop_names) >= 0,
+                                 "stitch_cell_attribute_subfiles: unable to read populations from " << subfile_name);
+                  }
+                throw_assert(H5Fclose(file) >= 0,
+                             "stitch_cell_attribute_subfiles: unable to close subfile " << subfile_name);
+
+                for (const string& pop_name : pop_names)
+                  {
+                    vector<string> name_spaces;
+                    throw_assert(get_cell_attribute_name_spaces(subfile_name, pop_name, name_spaces) >= 0,
+                                 "stitch_cell_attribute_subfiles: unable to read namespaces from " << subfile_name);
+                    for (const string& name_space : name_spaces)
+                      {
+                        vector< pair<string, AttrKind> > attributes;
+                        throw_assert(get_cell_attributes(subfile_name, name_space, pop_name, attributes) >= 0,
+                                     "stitch_cell_attribute_subfiles: unable to read attributes from " << subfile_name);
+                        vector< pair<string, AttrKind> >& ns_attributes = subfile_attributes[pop_name][name_space];
+                        for (const auto& attribute : attributes)
+                          {
+                            bool found = false;
+                            for (const auto& ns_attribute : ns_attributes)
+                              {
+                                if (ns_attribute.first == attribute.first)
+                                  {
+                                    throw_assert((ns_attribute.second.type == attribute.second.type) &&
+                                                 (ns_attribute.second.size == attribute.second.size),
+                                                 "stitch_cell_attribute_subfiles: attribute " << attribute.first <<
+                                                 " has different types in different subfiles");
+                                    found = true;
+                                  }
+                              }
+                            if (!found)
+                              {
+                                ns_attributes.push_back(attribute);
+                              }
+                          }
+                        subfile_name_spaces[i].insert(make_pair(pop_name, name_space));
+                      }
+                  }
+              }
+            data::serialize_data(make_pair(subfile_attributes, subfile_name_spaces), sendbuf);
+            sendbuf_size = sendbuf.size();
+          }
+
+        throw_assert(MPI_Bcast(&sendbuf_size, 1, MPI_UINT32_T, 0, comm) == MPI_SUCCESS,
+                     "stitch_cell_attribute_subfiles: error in MPI_Bcast");
+        sendbuf.resize(sendbuf_size);
+        throw_assert(MPI_Bcast(&sendbuf[0], sendbuf_size, MPI_CHAR, 0, comm) == MPI_SUCCESS,
+                     "stitch_cell_attribute_subfiles: error in MPI_Bcast");
+        if (rank != 0)
+          {
+            pair< subfile_cell_attribute_map_t, vector< set< pair<string, string> > > > metadata;
+            data::deserialize_data(sendbuf, metadata);
+            subfile_attributes = std::move(metadata.first);
+            subfile_name_spaces = std::move(metadata.second);
+          }
+      }
+
+      if (subfile_attributes.size() == 0)
+        {
+          return;
+        }
+
+      pop_range_map_t pop_ranges;
+      pop_label_map_t pop_labels;
+      size_t total_num_nodes = 0;
+      throw_assert(read_population_ranges(comm, file_name, pop_ranges, total_num_nodes) >= 0,
+                   "stitch_cell_attribute_subfiles: unable to read population ranges");
+      throw_assert(read_population_labels(comm, file_name, pop_labels) >= 0,
+                   "stitch_cell_attribute_subfiles: unable to read population labels");
+
+      for (const auto& pop_item : subfile_attributes)
+        {
+          const string& pop_name = pop_item.first;
+
+          CELL_IDX_T pop_start = 0; bool pop_set = false;
+          for (const auto& label_item : pop_labels)
+            {
+              if (label_item.second == pop_name)
+                {
+                  auto range_it = pop_ranges.find(label_item.first);
+                  throw_assert(range_it != pop_ranges.end(),
+                               "stitch_cell_attribute_subfiles: invalid population " << pop_name);
+                  pop_start = range_it->second.start;
+                  pop_set = true;
+                }
+            }
+          throw_assert(pop_set, "stitch_cell_attribute_subfiles: unknown population " << pop_name);
+
+          for (const auto& ns_item : pop_item.second)
+            {
+              const string& name_space = ns_item.first;
+
+              map< type_index, vector<string> > attr_names_by_type;
+              for (const auto& attribute : ns_item.second)
+                {
+                  const string& attr_name = attribute.first;
+                  const AttrKind& attr_kind = attribute.second;
+                  data::attr_kind_dispatch(attr_kind, [&] (auto type_ptr)
+                                           {
+                                             typedef typename std::remove_pointer<decltype(type_ptr)>::type T;
+                                             attr_names_by_type[type_index(typeid(T))].push_back(attr_name);
+                                           });
+                }
+
+              for (size_t round_start = 0; round_start < num_subfiles; round_start += size)
+                {
+                  const size_t subfile_index = round_start + rank;
+                  data::NamedAttrMap attr_values;
+
+                  if ((subfile_index < num_subfiles) &&
+                      (subfile_name_spaces[subfile_index].count(make_pair(pop_name, name_space)) > 0))
+                    {
+                      const string subfile_name = hdf5::subfile_name(file_name, subfile_index);
+                      read_cell_attributes(MPI_COMM_SELF, subfile_name, name_space, set<string>(),
+                                           pop_name, pop_start, attr_values);
+                    }
+
+                  map<string, map<CELL_IDX_T, deque<uint32_t> >> attr_values_uint32;
+                  map<string, map<CELL_IDX_T, deque<int32_t> >> attr_values_int32;
+                  map<string, map<CELL_IDX_T, deque<uint16_t> >> attr_values_uint16;
+                  map<string, map<CELL_IDX_T, deque<int16_t> >> attr_values_int16;
+                  map<string, map<CELL_IDX_T, deque<uint8_t> >> attr_values_uint8;
+                  map<string, map<CELL_IDX_T, deque<int8_t> >> attr_values_int8;
+                  map<string, map<CELL_IDX_T, deque<float> >> attr_values_float;
+
+                  take_attr_maps<uint32_t>(attr_names_by_type[type_index(typeid(uint32_t))],
+                                           attr_values, attr_values_uint32);
+                  take_attr_maps<int32_t>(attr_names_by_type[type_index(typeid(int32_t))],
+                                          attr_values, attr_values_int32);
+                  take_attr_maps<uint16_t>(attr_names_by_type[type_index(typeid(uint16_t))],
+                                           attr_values, attr_values_uint16);
+                  take_attr_maps<int16_t>(attr_names_by_type[type_index(typeid(int16_t))],
+                                          attr_values, attr_values_int16);
+                  take_attr_maps<uint8_t>(attr_names_by_type[type_index(typeid(uint8_t))],
+                                          attr_values, attr_values_uint8);
+                  take_attr_maps<int8_t>(attr_names_by_type[type_index(typeid(int8_t))],
+                                         attr_values, attr_values_int8);
+                  take_attr_maps<float>(attr_names_by_type[type_index(typeid(float))],
+                                        attr_values, attr_values_float);
+
+                  mpi::MPI_DEBUG(comm, "stitch_cell_attribute_subfiles: ", pop_name, " ", name_space,
+                                 ": appending subfiles ", round_start, " to ",
+                                 std::min(round_start + size, num_subfiles) - 1);
+
+                  append_cell_attribute_maps(comm, file_name, name_space, pop_name, pop_start,
+                                             attr_values_uint32, attr_values_int32,
+                                             attr_values_uint16, attr_values_int16,
+                                             attr_values_uint8, attr_values_int8,
+                                             attr_values_float, size, data::optional_hid(),
+                                             IndexOwner, CellPtr(PtrOwner),
+                                             chunk_size, value_chunk_size, cache_size, filters);
+                }
+            }
+        }
+
+      throw_assert(MPI_Barrier(comm) == MPI_SUCCESS,
+                   "stitch_cell_attribute_subfiles: error in MPI_Barrier");
+    }
+
+  }
+}
@@ -0,0 +1,267 @@
+// -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+//==============================================================================
+///  @file tree_encoding.cc
+///
+///  Quantized encoding of the point attributes of trees.
+///
+///  Copyright (C) 2016-2025 Project NeuroH5.
+//==============================================================================
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <typeindex>
+#include <deque>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "tree_encoding.hh"
+#include "path_names.hh"
+#include "throw_assert.hh"
+
+using namespace std;
+
+namespace neuroh5
+{
+
+  namespace cell
+  {
+
+    template <class T>
+    static void encode_runs (const vector<T>& values, size_t first, size_t last,
+                             vector<ATTR_PTR_T>& run_ptr,
+                             vector<T>& runs, vector<uint32_t>& run_lengths)
+    {
+      for (size_t i = first; i < last; i++)
+        {
+          if ((i == first) || (values[i] != runs.back()))
+            {
+              runs.push_back(values[i]);
+              run_lengths.push_back(0);
+            }
+          run_lengths.back()++;
+        }
+      run_ptr.push_back(runs.size());
+    }
+
+
+    void encode_tree_points
+    (
+     const double                          precision,
+     const std::vector<CELL_IDX_T>&        index,
+     const std::vector<ATTR_PTR_T>&        point_ptr,
+     const std::vector<COORD_T>&           xcoords,
+     const std::vector<COORD_T>&           ycoords,
+     const std::vector<COORD_T>&           zcoords,
+     const std::vector<REALVAL_T>&         radiuses,
+     const std::vector<LAYER_IDX_T>&       layers,
+     const std::vector<PARENT_NODE_IDX_T>& parents,
+     const std::vector<SWC_TYPE_T>&        swc_types,
+     EncodedTreePoints&                    encoded
+     )
+    {
+      throw_assert(precision > 0.0,
+                   "encode_tree_points: precision must be positive");
+      throw_assert(point_ptr.size() == index.size()+1,
+                   "encode_tree_points: mismatch between index and point pointer");
+
+      // rounding to a multiple of step has error at most step/2
+      const COORD_T step = 2.0 * precision;
+
+      encoded.origin_ptr.assign(1, 0);
+      encoded.layer_run_ptr.assign(1, 0);
+      encoded.swc_type_run_ptr.assign(1, 0);
+
+      const vector<COORD_T>* coords[3] = { &xcoords, &ycoords, &zcoords };
+      vector<int16_t>* offsets[3] = { &encoded.x_offsets, &encoded.y_offsets, &encoded.z_offsets };
+
+      for (size_t t = 0; t < index.size(); t++)
+        {
+          const size_t first = point_ptr[t], last = point_ptr[t+1];
+          const size_t num_points = last - first;
+
+          for (size_t d = 0; d < 3; d++)
+            {
+              encoded.origins.push_back((num_points > 0) ? (*coords[d])[first] : 0.0);
+            }
+          encoded.origins.push_back(step);
+          encoded.origin_ptr.push_back(encoded.origins.size());
+
+          for (size_t d = 0; d < 3; d++)
+            {
+              const double origin = encoded.origins[encoded.origins.size()-4+d];
+              vector<int64_t> q(num_points);
+              for (size_t k = 0; k < num_points; k++)
+                {
+                  q[k] = llround(((*coords[d])[first+k] - origin) / step);
+                  const PARENT_NODE_IDX_T p = parents[first+k];
+                  const int64_t ref = ((p >= 0) && ((size_t)p < k)) ? q[p] : 0;
+                  const int64_t offset = q[k] - ref;
+                  throw_assert((offset >= numeric_limits<int16_t>::min()) &&
+                               (offset <= numeric_limits<int16_t>::max()),
+                               "encode_tree_points: offset of point " << k << " of tree " << index[t] <<
+                               " exceeds the range of the quantized encoding at precision " << precision);
+                  offsets[d]->push_back(offset);
+                }
+            }
+
+          for (size_t k = 0; k < num_points; k++)
+            {
+              const int64_t r = llround(radiuses[first+k] / step);
+              throw_assert((r >= 0) && (r <= numeric_limits<uint16_t>::max()),
+                           "encode_tree_points: radius of point " << k << " of tree " << index[t] <<
+                           " exceeds the range of the quantized encoding at precision " << precision);
+              encoded.radiuses.push_back(r);
+
+              // a root (parent -1) has delta k+1
+              encoded.parent_deltas.push_back((PARENT_NODE_IDX_T)k - parents[first+k]);
+            }
+
+          encode_runs(layers, first, last, encoded.layer_run_ptr,
+                      encoded.layer_runs, encoded.layer_run_lengths);
+          encode_runs(swc_types, first, last, encoded.swc_type_run_ptr,
+                      encoded.swc_type_runs, encoded.swc_type_run_lengths);
+        }
+    }
+
+
+    template <class Values, class T>
+    static void decode_runs (const Values& runs, const data::AttrSpan<uint32_t>& run_lengths,
+                             size_t num_points, vector<T>& output)
+    {
+      throw_assert(runs.size() == run_lengths.size(),
+                   "decode_tree_points: mismatch between runs and run lengths");
+      size_t n = 0;
+      for (size_t i = 0; i < runs.size(); i++)
+        {
+          output.insert(output.end(), run_lengths[i], runs[i]);
+          n += run_lengths[i];
+        }
+      throw_assert(n == num_points,
+                   "decode_tree_points: run lengths do not match the number of points");
+    }
+
+    template <class T>
+    static data::AttrSpan<T> values_span (const deque<T>& values, vector<T>& buffer)
+    {
+      buffer.assign(values.begin(), values.end());
+      return data::AttrSpan<T> { buffer.data(), buffer.size() };
+    }
+
+    template <class T>
+    static data::AttrSpan<T> values_span (const data::AttrSpan<T>& values, vector<T>&)
+    {
+      return values;
+    }
+
+    static const set<CELL_IDX_T>& tree_cells (const data::NamedAttrMap& attr_values)
+    {
+      return attr_values.index_set;
+    }
+
+    static const vector<CELL_IDX_T>& tree_cells (const data::NamedColumnarAttrMap& attr_values)
+    {
+      return attr_values.index;
+    }
+
+    template <class NamedAttrMapT>
+    static void decode_tree_points_map (NamedAttrMapT& attr_values)
+    {
+      auto type_it = attr_values.attr_name_map.find(std::type_index(typeid(int16_t)));
+      if ((type_it == attr_values.attr_name_map.end()) ||
+          (type_it->second.count(hdf5::X_OFFSET) == 0))
+        return;
+
+      vector<CELL_IDX_T> index;
+      vector<ATTR_PTR_T> point_ptr(1, 0);
+      vector<COORD_T> coords[3];
+      vector<REALVAL_T> radiuses;
+      vector<LAYER_IDX_T> layers;
+      vector<PARENT_NODE_IDX_T> parents;
+      vector<SWC_TYPE_T> swc_types;
+
+      // buffers for the map layout, whose values are not contiguous
+      vector<COORD_T> origin_buf;
+      vector<int16_t> offset_buf[3];
+      vector<uint16_t> radius_buf;
+      vector<PARENT_NODE_IDX_T> parent_buf;
+      vector<uint32_t> layer_len_buf, swc_type_len_buf;
+
+      const string offset_names[3] = { hdf5::X_OFFSET, hdf5::Y_OFFSET, hdf5::Z_OFFSET };
+
+      for (CELL_IDX_T cell : tree_cells(attr_values))
+        {
+          data::AttrSpan<COORD_T> origin =
+            values_span(attr_values.template find_name<COORD_T>(hdf5::QUANT_ORIGIN, cell), origin_buf);
+          throw_assert(origin.size() == 4,
+                       "decode_tree_points: invalid quantization origin of tree " << cell);
+          const double step = origin[3];
+
+          data::AttrSpan<PARENT_NODE_IDX_T> parent_deltas =
+            values_span(attr_values.template find_name<PARENT_NODE_IDX_T>(hdf5::PARENT_DELTA, cell), parent_buf);
+          const size_t num_points = parent_deltas.size();
+          const size_t first = parents.size();
+          for (size_t k = 0; k < num_points; k++)
+            {
+              parents.push_back((PARENT_NODE_IDX_T)k - parent_deltas[k]);
+            }
+
+          for (size_t d = 0; d < 3; d++)
+            {
+              data::AttrSpan<int16_t> offsets =
+                values_span(attr_values.template find_name<int16_t>(offset_names[d], cell), offset_buf[d]);
+              throw_assert(offsets.size() == num_points,
+                           "decode_tree_points: mismatch between offsets and parents of tree " << cell);
+              vector<int64_t> q(num_points);
+              for (size_t k = 0; k < num_points; k++)
+                {
+                  const PARENT_NODE_IDX_T p = parents[first+k];
+                  const int64_t ref = ((p >= 0) && ((size_t)p < k)) ? q[p] : 0;
+                  q[k] = ref + offsets[k];
+                  coords[d].push_back(origin[d] + step * q[k]);
+                }
+            }
+
+          data::AttrSpan<uint16_t> radius_values =
+            values_span(attr_values.template find_name<uint16_t>(hdf5::RADIUS_QUANT, cell), radius_buf);
+          throw_assert(radius_values.size() == num_points,
+                       "decode_tree_points: mismatch between radiuses and parents of tree " << cell);
+          for (size_t k = 0; k < num_points; k++)
+            {
+              radiuses.push_back(step * radius_values[k]);
+            }
+
+          decode_runs(attr_values.template find_name<LAYER_IDX_T>(hdf5::LAYER_RUNS, cell),
+                      values_span(attr_values.template find_name<uint32_t>(hdf5::LAYER_RUN_LEN, cell), layer_len_buf),
+                      num_points, layers);
+          decode_runs(attr_values.template find_name<SWC_TYPE_T>(hdf5::SWCTYPE_RUNS, cell),
+                      values_span(attr_values.template find_name<uint32_t>(hdf5::SWCTYPE_RUN_LEN, cell), swc_type_len_buf),
+                      num_points, swc_types);
+
+          index.push_back(cell);
+          point_ptr.push_back(parents.size());
+        }
+
+      attr_values.insert(hdf5::X_COORD, index, point_ptr, coords[0]);
+      attr_values.insert(hdf5::Y_COORD, index, point_ptr, coords[1]);
+      attr_values.insert(hdf5::Z_COORD, index, point_ptr, coords[2]);
+      attr_values.insert(hdf5::RADIUS, index, point_ptr, radiuses);
+      attr_values.insert(hdf5::LAYER, index, point_ptr, layers);
+      attr_values.insert(hdf5::PARENT, index, point_ptr, parents);
+      attr_values.insert(hdf5::SWCTYPE, index, point_ptr, swc_types);
+    }
+
+
+    void decode_tree_points (data::NamedAttrMap& attr_values)
+    {
+      decode_tree_points_map(attr_values);
+    }
+
+    void decode_tree_points (data::NamedColumnarAttrMap& attr_values)
+    {
+      decode_tree_points_map(attr_values);
+    }
+
+  }
+}
@@ -0,0 +1,86 @@
+// -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+//==============================================================================
+///  @file tree_topology.cc
+///
+///  Point and section topology of trees in flat arrays.
+///
+///  Copyright (C) 2016-2025 Project NeuroH5.
+//==============================================================================
+
+#include <deque>
+#include <vector>
+
+#include "tree_topology.hh"
+#include "throw_assert.hh"
+
+using namespace std;
+
+namespace neuroh5
+{
+
+  namespace cell
+  {
+
+    size_t count_section_points (const CELL_IDX_T tree_id,
+                                 const deque<SECTION_IDX_T>& sections,
+                                 const size_t num_points)
+    {
+      // section points may range over 0 .. num_points
+      vector<char> seen(num_points+1, 0);
+      size_t count = 0;
+
+      size_t sections_ptr = 1;
+      while (sections_ptr < sections.size())
+        {
+          size_t num_section_points = sections[sections_ptr];
+          sections_ptr++;
+          throw_assert(sections_ptr + num_section_points <= sections.size(),
+                       "tree " << tree_id << ": section extends past the end of the sections column");
+          for (size_t p = 0; p < num_section_points; p++)
+            {
+              const NODE_IDX_T point = sections[sections_ptr];
+              throw_assert(point <= num_points,
+                           "tree " << tree_id << ": section point " << point <<
+                           " exceeds the number of points " << num_points);
+              if (!seen[point])
+                {
+                  seen[point] = 1;
+                  count++;
+                }
+              sections_ptr++;
+            }
+        }
+
+      return count;
+    }
+
+
+    size_t count_section_roots (const size_t num_sections,
+                                const deque<SECTION_IDX_T>& src_vector,
+                                const deque<SECTION_IDX_T>& dst_vector)
+    {
+      throw_assert(src_vector.size() == dst_vector.size(),
+                   "count_section_roots: mismatch between source and destination sections");
+
+      vector<char> has_parent(num_sections, 0);
+      for (size_t e = 0; e < dst_vector.size(); e++)
+        {
+          throw_assert((src_vector[e] < num_sections) && (dst_vector[e] < num_sections),
+                       "count_section_roots: section edge " << src_vector[e] << " -> " << dst_vector[e] <<
+                       " exceeds the number of sections " << num_sections);
+          has_parent[dst_vector[e]] = 1;
+        }
+
+      size_t root_count = 0;
+      for (size_t s = 0; s < num_sections; s++)
+        {
+          if (!has_parent[s])
+            {
+              root_count++;
+            }
+        }
+      return root_count;
+    }
+
+  }
+}
@@ -4,18 +4,17 @@
 ///
 ///  Validate tree structure.
 ///
-///  Copyright (C) 2016-2021 Project NeuroH5.
+///  Copyright (C) 2016-2025 Project NeuroH5.
 //==============================================================================
 
 
 #include "debug.hh"
 
-#include <set>
 #include <deque>
 
 #include "neuroh5_types.hh"
 #include "throw_assert.hh"
-#include "ngraph.hh"
+#include "tree_topology.hh"
 
 
 using namespace std;
@@ -55,57 +54,11 @@ namespace neuroh5
       throw_assert_nomsg(num_xpoints == swc_types.size());
 
       size_t num_sections = sections[0];
+      size_t num_nodes = num_xpoints;
 
-      size_t num_nodes = num_xpoints, sections_ptr=1;
+      throw_assert_nomsg(count_section_points(tree_id, sections, num_nodes) == num_nodes);
 
-      set<NODE_IDX_T> all_section_nodes;
-      
-      while (sections_ptr < sections.size())
-        {
-          std::vector<NODE_IDX_T> section_nodes;
-          size_t num_section_nodes = sections[sections_ptr];
-          sections_ptr++;
-          for (size_t p = 0; p < num_section_nodes; p++)
-            {
-                        
-              NODE_IDX_T node_idx = sections[sections_ptr];
-              if (!(node_idx <= num_nodes))
-                {
-                  printf("tree id = %u\n",tree_id);
-                  printf("node_idx = %u\n",node_idx);
-                  printf("num_nodes = %lu\n", num_nodes);
-                }
-              throw_assert_nomsg(node_idx <= num_nodes);
-              all_section_nodes.insert(node_idx);
-              sections_ptr++;
-            }
-      
-        }
-  
-      throw_assert_nomsg(all_section_nodes.size() == num_nodes);
-
-      Graph S;
-
-      for (size_t s = 0; s < num_sections; s++)
-        {
-          S.insert_vertex(s);
-        }
-      for (size_t e = 0; e < src_vector.size(); e++)
-        {
-          S.insert_edge(src_vector[e], dst_vector[e]);
-        }
-
-      size_t root_count = 0;
-      for (Graph::const_iterator p=S.begin(); p != S.end(); p++)
-          {
-            Graph::vertex v = Graph::node (p); 
-            Graph::vertex_set in = S.in_neighbors(v);
-            if (in.size() == 0)
-              {
-                root_count++;
-              }
-            
-          }
+      size_t root_count = count_section_roots(num_sections, src_vector, dst_vector);
 
       throw_assert(root_count == 1, "tree must have only one root");
     }
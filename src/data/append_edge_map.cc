@@ -8,11 +8,14 @@
 ///  Copyright (C) 2016-2025 Project NeuroH5.
 //==============================================================================
 
+#include <algorithm>
+#include <numeric>
 #include <vector>
 #include <map>
 
 #include "neuroh5_types.hh"
 #include "attr_map.hh"
+#include "edge_csr.hh"
 #include "rank_range.hh"
 
 using namespace std;
@@ -129,5 +132,110 @@ namespace neuroh5
 
       return ierr;
     }
+
+
+    /**************************************************************************
+     * Append src/dst node pairs to a CSR edge container
+     **************************************************************************/
+    int append_edge_map
+    (
+     const NODE_IDX_T&                 dst_start,
+     const NODE_IDX_T&                 src_start,
+     const vector<DST_BLK_PTR_T>&      dst_blk_ptr,
+     const vector<NODE_IDX_T>&         dst_idx,
+     const vector<DST_PTR_T>&          dst_ptr,
+     const vector<NODE_IDX_T>&         src_idx,
+     const vector<string>&             attr_namespaces,
+     const map<string, NamedAttrVal>&  edge_attr_map,
+     size_t&                           num_edges,
+     edge_csr_t &                      edge_csr,
+     EdgeMapType                       edge_map_type
+     )
+    {
+      int ierr = 0;
+
+      if (dst_blk_ptr.empty() || dst_idx.empty() || dst_ptr.empty() || src_idx.empty())
+        {
+          return ierr;
+        };
+
+      // key node, adjacent node and attribute index of each edge
+      vector<NODE_IDX_T> edge_keys, edge_adj;
+      vector<size_t> edge_pos;
+      edge_keys.reserve(src_idx.size());
+      edge_adj.reserve(src_idx.size());
+      edge_pos.reserve(src_idx.size());
+
+      size_t dst_ptr_size = dst_ptr.size();
+      for (size_t b = 0; b < dst_idx.size(); ++b)
+        {
+          size_t low_dst_ptr = dst_blk_ptr[b],
+            high_dst_ptr = dst_blk_ptr[b+1];
+
+          NODE_IDX_T dst_base = dst_idx[b];
+          for (size_t i = low_dst_ptr, ii = 0; i < high_dst_ptr; ++i, ++ii)
+            {
+              if (i < dst_ptr_size-1)
+                {
+                  NODE_IDX_T dst = dst_base + ii + dst_start;
+                  size_t low = dst_ptr[i], high = dst_ptr[i+1];
+                  for (size_t j = low; j < high; ++j)
+                    {
+                      NODE_IDX_T src = src_idx[j] + src_start;
+                      edge_keys.push_back((edge_map_type == EdgeMapDst) ? dst : src);
+                      edge_adj.push_back((edge_map_type == EdgeMapDst) ? src : dst);
+                      edge_pos.push_back(j);
+                    }
+                }
+            }
+        }
+
+      // edges with equal keys keep their order in the projection
+      vector<size_t> p(edge_keys.size());
+      iota(p.begin(), p.end(), 0);
+      if (!is_sorted(edge_keys.begin(), edge_keys.end()))
+        {
+          stable_sort(p.begin(), p.end(),
+                      [&] (size_t a, size_t b) { return edge_keys[a] < edge_keys[b]; });
+        }
+
+      edge_csr_t prj_edge_csr;
+      vector<size_t> attr_pos;
+      attr_pos.reserve(p.size());
+      prj_edge_csr.adj_index.reserve(p.size());
+      for (const size_t e : p)
+        {
+          if (prj_edge_csr.node_index.empty() || (prj_edge_csr.node_index.back() != edge_keys[e]))
+            {
+              prj_edge_csr.adj_offsets.push_back(prj_edge_csr.adj_index.size());
+              prj_edge_csr.node_index.push_back(edge_keys[e]);
+            }
+          prj_edge_csr.adj_index.push_back(edge_adj[e]);
+          attr_pos.push_back(edge_pos[e]);
+        }
+      prj_edge_csr.adj_offsets.push_back(prj_edge_csr.adj_index.size());
+
+      prj_edge_csr.edge_attrs.resize(attr_namespaces.size());
+      gather_attr_vec<float>(edge_attr_map, attr_namespaces, prj_edge_csr.edge_attrs, attr_pos);
+      gather_attr_vec<uint8_t>(edge_attr_map, attr_namespaces, prj_edge_csr.edge_attrs, attr_pos);
+      gather_attr_vec<uint16_t>(edge_attr_map, attr_namespaces, prj_edge_csr.edge_attrs, attr_pos);
+      gather_attr_vec<uint32_t>(edge_attr_map, attr_namespaces, prj_edge_csr.edge_attrs, attr_pos);
+      gather_attr_vec<int8_t>(edge_attr_map, attr_namespaces, prj_edge_csr.edge_attrs, attr_pos);
+      gather_attr_vec<int16_t>(edge_attr_map, attr_namespaces, prj_edge_csr.edge_attrs, attr_pos);
+      gather_attr_vec<int32_t>(edge_attr_map, attr_namespaces, prj_edge_csr.edge_attrs, attr_pos);
+
+      num_edges += prj_edge_csr.num_edges();
+
+      if (edge_csr.empty())
+        {
+          edge_csr = std::move(prj_edge_csr);
+        }
+      else
+        {
+          data::append_edge_csr(prj_edge_csr, edge_csr);
+        }
+
+      return ierr;
+    }
   }
 }
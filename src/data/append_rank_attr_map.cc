@@ -16,6 +16,8 @@
 #include "neuroh5_types.hh"
 #include "attr_val.hh"
 #include "attr_map.hh"
+#include "columnar_attr_map.hh"
+#include "rank_map.hh"
 #include "rank_range.hh"
 #include "throw_assert.hh"
 
@@ -30,7 +32,7 @@ namespace neuroh5
     void append_rank_attr_map
     (
      const data::NamedAttrMap   &attr_values,
-     const node_rank_map_t &node_rank_map,
+     const data::NodeRankMap &node_rank_map,
      map <rank_t, data::AttrMap> &rank_attr_map)
     {
       const vector<map< CELL_IDX_T, deque<float> > > &all_float_values     = attr_values.attr_maps<float>();
@@ -48,14 +50,14 @@ namespace neuroh5
             {
               const CELL_IDX_T index = element.first;
               const deque<float> &v = element.second;
-              auto it = node_rank_map.find(index);
-              throw_assert(it != node_rank_map.end(),
+              NodeRankMap::Ranks dst_ranks = node_rank_map.find(index);
+              throw_assert(!dst_ranks.empty(),
                            "append_rank_attr_map: index not found in node rank map");
-	      for (const rank_t& dst_rank : it->second)
-		{
-		  data::AttrMap &attr_map = rank_attr_map[dst_rank];
-		  attr_map.insert(i, index, v);
-		}
+              for (const rank_t& dst_rank : dst_ranks)
+                {
+                  data::AttrMap &attr_map = rank_attr_map[dst_rank];
+                  attr_map.insert(i, index, v);
+                }
             }
         }
 
@@ -66,14 +68,14 @@ namespace neuroh5
             {
               const CELL_IDX_T index = element.first;
               const deque<uint8_t> &v = element.second;
-              auto it = node_rank_map.find(index);
-              throw_assert(it != node_rank_map.end(),
+              NodeRankMap::Ranks dst_ranks = node_rank_map.find(index);
+              throw_assert(!dst_ranks.empty(),
                            "append_rank_attr_map: index not found in node rank map");
-	      for (const rank_t& dst_rank : it->second)
-		{
-		  data::AttrMap &attr_map = rank_attr_map[dst_rank];
-		  attr_map.insert(i, index, v);
-		}
+              for (const rank_t& dst_rank : dst_ranks)
+                {
+                  data::AttrMap &attr_map = rank_attr_map[dst_rank];
+                  attr_map.insert(i, index, v);
+                }
             }
         }
 
@@ -84,14 +86,14 @@ namespace neuroh5
             {
               const CELL_IDX_T index = element.first;
               const deque<int8_t> &v = element.second;
-              auto it = node_rank_map.find(index);
-              throw_assert(it != node_rank_map.end(),
+              NodeRankMap::Ranks dst_ranks = node_rank_map.find(index);
+              throw_assert(!dst_ranks.empty(),
                            "append_rank_attr_map: index not found in node rank map");
-	      for (const rank_t& dst_rank : it->second)
-		{
-		  data::AttrMap &attr_map = rank_attr_map[dst_rank];
-		  attr_map.insert(i, index, v);
-		}
+              for (const rank_t& dst_rank : dst_ranks)
+                {
+                  data::AttrMap &attr_map = rank_attr_map[dst_rank];
+                  attr_map.insert(i, index, v);
+                }
             }
         }
 
@@ -102,14 +104,14 @@ namespace neuroh5
             {
               const CELL_IDX_T index = element.first;
               const deque<uint16_t> &v = element.second;
-              auto it = node_rank_map.find(index);
-              throw_assert(it != node_rank_map.end(),
+              NodeRankMap::Ranks dst_ranks = node_rank_map.find(index);
+              throw_assert(!dst_ranks.empty(),
                            "append_rank_attr_map: index not found in node rank map");
-	      for (const rank_t& dst_rank : it->second)
-		{
-		  data::AttrMap &attr_map = rank_attr_map[dst_rank];
-		  attr_map.insert(i, index, v);
-		}
+              for (const rank_t& dst_rank : dst_ranks)
+                {
+                  data::AttrMap &attr_map = rank_attr_map[dst_rank];
+                  attr_map.insert(i, index, v);
+                }
             }
         }
 
@@ -120,14 +122,14 @@ namespace neuroh5
             {
               const CELL_IDX_T index = element.first;
               const deque<int16_t> &v = element.second;
-              auto it = node_rank_map.find(index);
-              throw_assert(it != node_rank_map.end(),
+              NodeRankMap::Ranks dst_ranks = node_rank_map.find(index);
+              throw_assert(!dst_ranks.empty(),
                            "append_rank_attr_map: index not found in node rank map");
-	      for (const rank_t& dst_rank : it->second)
-		{
-		  data::AttrMap &attr_map = rank_attr_map[dst_rank];
-		  attr_map.insert(i, index, v);
-		}
+              for (const rank_t& dst_rank : dst_ranks)
+                {
+                  data::AttrMap &attr_map = rank_attr_map[dst_rank];
+                  attr_map.insert(i, index, v);
+                }
             }
         }
 
@@ -138,14 +140,14 @@ namespace neuroh5
             {
               const CELL_IDX_T index = element.first;
               const deque<uint32_t> &v = element.second;
-              auto it = node_rank_map.find(index);
-              throw_assert(it != node_rank_map.end(),
+              NodeRankMap::Ranks dst_ranks = node_rank_map.find(index);
+              throw_assert(!dst_ranks.empty(),
                            "append_rank_attr_map: index not found in node rank map");
-	      for (const rank_t& dst_rank : it->second)
-		{
-		  data::AttrMap &attr_map = rank_attr_map[dst_rank];
-		  attr_map.insert(i, index, v);
-		}
+              for (const rank_t& dst_rank : dst_ranks)
+                {
+                  data::AttrMap &attr_map = rank_attr_map[dst_rank];
+                  attr_map.insert(i, index, v);
+                }
             }
         }
 
@@ -156,19 +158,75 @@ namespace neuroh5
             {
               const CELL_IDX_T index = element.first;
               const deque<int32_t> &v = element.second;
-              auto it = node_rank_map.find(index);
-              throw_assert(it != node_rank_map.end(),
+              NodeRankMap::Ranks dst_ranks = node_rank_map.find(index);
+              throw_assert(!dst_ranks.empty(),
                            "append_rank_attr_map: index not found in node rank map");
-	      for (const rank_t& dst_rank : it->second)
-		{
-		  data::AttrMap &attr_map = rank_attr_map[dst_rank];
-		  attr_map.insert(i, index, v);
-		}
+              for (const rank_t& dst_rank : dst_ranks)
+                {
+                  data::AttrMap &attr_map = rank_attr_map[dst_rank];
+                  attr_map.insert(i, index, v);
+                }
             }
         }
 
     }
 
 
+
+    template<class T>
+    static void append_rank_attr_columns
+    (
+     const vector< AttrColumn<T> > &all_columns,
+     const data::NodeRankMap &node_rank_map,
+     map <rank_t, data::ColumnarAttrMap> &rank_attr_map)
+    {
+      for (size_t i=0; i<all_columns.size(); i++)
+        {
+          const AttrColumn<T> &column = all_columns[i];
+          for (size_t pos=0; pos<column.size(); pos++)
+            {
+              const CELL_IDX_T index = column.index[pos];
+              const AttrSpan<T> v = column.values_at(pos);
+              NodeRankMap::Ranks dst_ranks = node_rank_map.find(index);
+              throw_assert(!dst_ranks.empty(),
+                           "append_rank_attr_map: index not found in node rank map");
+              for (const rank_t& dst_rank : dst_ranks)
+                {
+                  data::ColumnarAttrMap &attr_map = rank_attr_map[dst_rank];
+                  vector< AttrColumn<T> > &columns = attr_map.attr_columns<T>();
+                  columns.resize(max(columns.size(), i+1));
+                  columns[i].push_back(index, v.begin(), v.end());
+                }
+            }
+        }
+    }
+
+    void append_rank_attr_map
+    (
+     const data::NamedColumnarAttrMap &attr_values,
+     const data::NodeRankMap &node_rank_map,
+     map <rank_t, data::ColumnarAttrMap> &rank_attr_map)
+    {
+      append_rank_attr_columns(attr_values.attr_columns<float>(), node_rank_map, rank_attr_map);
+      append_rank_attr_columns(attr_values.attr_columns<uint8_t>(), node_rank_map, rank_attr_map);
+      append_rank_attr_columns(attr_values.attr_columns<int8_t>(), node_rank_map, rank_attr_map);
+      append_rank_attr_columns(attr_values.attr_columns<uint16_t>(), node_rank_map, rank_attr_map);
+      append_rank_attr_columns(attr_values.attr_columns<int16_t>(), node_rank_map, rank_attr_map);
+      append_rank_attr_columns(attr_values.attr_columns<uint32_t>(), node_rank_map, rank_attr_map);
+      append_rank_attr_columns(attr_values.attr_columns<int32_t>(), node_rank_map, rank_attr_map);
+
+      for (auto& element : rank_attr_map)
+        {
+          data::ColumnarAttrMap &attr_map = element.second;
+          for (const auto& column : attr_map.attr_columns<float>()) attr_map.merge_index(column.index);
+          for (const auto& column : attr_map.attr_columns<uint8_t>()) attr_map.merge_index(column.index);
+          for (const auto& column : attr_map.attr_columns<int8_t>()) attr_map.merge_index(column.index);
+          for (const auto& column : attr_map.attr_columns<uint16_t>()) attr_map.merge_index(column.index);
+          for (const auto& column : attr_map.attr_columns<int16_t>()) attr_map.merge_index(column.index);
+          for (const auto& column : attr_map.attr_columns<uint32_t>()) attr_map.merge_index(column.index);
+          for (const auto& column : attr_map.attr_columns<int32_t>()) attr_map.merge_index(column.index);
+        }
+    }
+
   }
 }
@@ -14,6 +14,7 @@
 #include "debug.hh"
 #include "neuroh5_types.hh"
 #include "attr_val.hh"
+#include "rank_map.hh"
 #include "rank_range.hh"
 
 using namespace std;
@@ -39,7 +40,7 @@ namespace neuroh5
      const vector<NODE_IDX_T>&        src_idx,
      const vector<string>&            attr_namespaces,
      const map<string, NamedAttrVal>& edge_attr_map,
-     const node_rank_map_t&           node_rank_map,
+     const data::NodeRankMap&         node_rank_map,
      size_t&                          num_edges,
      rank_edge_map_t &                rank_edge_map,
      EdgeMapType                      edge_map_type
@@ -78,14 +79,11 @@ namespace neuroh5
                             {
                             case EdgeMapDst:
                               {
-                                set<rank_t> dst_rank_set;
-                                auto it = node_rank_map.find(dst);
-                                if (it == node_rank_map.end())
-                                  { dst_rank_set.insert((initial_rank + num_dst) % num_ranks); }
-                                else
-                                  { dst_rank_set = it->second; }
+                                NodeRankMap::Ranks dst_ranks = node_rank_map.find(dst);
+                                if (dst_ranks.empty())
+                                  { dst_ranks = NodeRankMap::Ranks((initial_rank + num_dst) % num_ranks); }
 
-                                for (auto dst_rank : dst_rank_set)
+                                for (auto dst_rank : dst_ranks)
                                   {
                                     edge_tuple_t& et = rank_edge_map[dst_rank][dst];
                                     vector<NODE_IDX_T> &my_srcs = get<0>(et);
@@ -114,14 +112,11 @@ namespace neuroh5
                                 for (size_t j = low, jj=0; j < high; ++j, ++jj)
                                   {
                                     NODE_IDX_T src = src_idx[j] + src_start;
-                                    set <rank_t> dst_rank_set;
-                                    auto it = node_rank_map.find(src);
-                                    if (it == node_rank_map.end())
-                                      { dst_rank_set.insert(j % num_ranks); }
-                                    else
-                                      { dst_rank_set = it->second; }
+                                    NodeRankMap::Ranks dst_ranks = node_rank_map.find(src);
+                                    if (dst_ranks.empty())
+                                      { dst_ranks = NodeRankMap::Ranks(j % num_ranks); }
 
-                                    for (auto dst_rank : dst_rank_set)
+                                    for (auto dst_rank : dst_ranks)
                                       {
                                         edge_tuple_t& et = rank_edge_map[dst_rank][src];
                                         
@@ -13,6 +13,7 @@
 
 #include "neuroh5_types.hh"
 #include "attr_map.hh"
+#include "rank_map.hh"
 #include "rank_range.hh"
 
 using namespace std;
@@ -35,7 +36,7 @@ namespace neuroh5
      const vector<NODE_IDX_T>&         src_idx,
      const vector<string>&             attr_namespaces,
      const map<string, NamedAttrVal>&  edge_attr_map,
-     const node_rank_map_t&            node_rank_map,
+     const data::NodeRankMap&          node_rank_map,
      size_t&                           num_edges,
      rank_edge_map_t &                 rank_edge_map,
      EdgeMapType                       edge_map_type
@@ -60,14 +61,11 @@ namespace neuroh5
                 {
                 case EdgeMapDst:
                   {
-                    auto it = node_rank_map.find(dst);
-                    set <rank_t> dst_rank_set;
-                    if (it == node_rank_map.end())
-                      { dst_rank_set.insert(num_dst % num_ranks); }
-                    else
-                      { dst_rank_set = it->second; }
+                    NodeRankMap::Ranks dst_ranks = node_rank_map.find(dst);
+                    if (dst_ranks.empty())
+                      { dst_ranks = NodeRankMap::Ranks(num_dst % num_ranks); }
 
-                    for (auto dst_rank : dst_rank_set)
+                    for (auto dst_rank : dst_ranks)
                       {
                         edge_tuple_t& et = rank_edge_map[dst_rank][dst];
                         vector<NODE_IDX_T> &my_srcs = get<0>(et);
@@ -97,14 +95,11 @@ namespace neuroh5
                     for (size_t j = low; j < high; ++j)
                       {
                         NODE_IDX_T src = src_idx[j] + src_start;
-                        set <rank_t> dst_rank_set;
-                        auto it = node_rank_map.find(src);
-                        if (it == node_rank_map.end())
-                          { dst_rank_set.insert(src % num_ranks); }
-                        else
-                          { dst_rank_set = it->second; }
+                        NodeRankMap::Ranks dst_ranks = node_rank_map.find(src);
+                        if (dst_ranks.empty())
+                          { dst_ranks = NodeRankMap::Ranks(src % num_ranks); }
 
-                        for (auto dst_rank : dst_rank_set)
+                        for (auto dst_rank : dst_ranks)
                           {
                             edge_tuple_t& et = rank_edge_map[dst_rank][src];
                             
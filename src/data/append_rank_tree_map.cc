@@ -16,6 +16,7 @@
 #include "neuroh5_types.hh"
 #include "attr_map.hh"
 #include "cell_attributes.hh"
+#include "rank_map.hh"
 #include "rank_range.hh"
 #include "throw_assert.hh"
 
@@ -28,7 +29,7 @@ namespace neuroh5
   {
 
     void append_rank_tree_map (NamedAttrMap& attr_values,
-                               const node_rank_map_t& node_rank_map,
+                               const data::NodeRankMap& node_rank_map,
                                map <rank_t, map<CELL_IDX_T, neurotree_t> > &rank_tree_map)
     {
       for (CELL_IDX_T gid : attr_values.index_set)
@@ -47,23 +48,20 @@ namespace neuroh5
           const deque<PARENT_NODE_IDX_T>& parents = attr_values.find_name<PARENT_NODE_IDX_T>(hdf5::PARENT, gid);
           const deque<SWC_TYPE_T> swc_types   = attr_values.find_name<SWC_TYPE_T>(hdf5::SWCTYPE, gid);
 
-          set <rank_t> dst_rank_set;
-          auto it = node_rank_map.find(gid);
-          if (it == node_rank_map.end())
+          NodeRankMap::Ranks dst_ranks = node_rank_map.find(gid);
+          if (dst_ranks.empty())
             {
               printf("gid %d not found in node rank map\n", gid);
             }
-          throw_assert(it != node_rank_map.end(),
+          throw_assert(!dst_ranks.empty(),
                        "append_rank_tree_map: index not found in node rank map");
-
-          dst_rank_set = it->second;
           
           neurotree_t tree = make_tuple(gid, src_vector, dst_vector, sections,
                                         xcoords, ycoords, zcoords,
                                         radiuses, layers, parents,
                                         swc_types);
 
-          for (auto dst_rank : dst_rank_set)
+          for (auto dst_rank : dst_ranks)
             {
               map<CELL_IDX_T, neurotree_t> &tree_map = rank_tree_map[dst_rank];
               tree_map.insert(make_pair(gid, tree));
@@ -0,0 +1,121 @@
+// -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+//==============================================================================
+///  @file columnar_attr_map.cc
+///
+///  Template specialization for ColumnarAttrMap.
+///
+///  Copyright (C) 2016-2025 Project NeuroH5.
+//==============================================================================
+
+#include <string>
+#include <vector>
+
+#include "columnar_attr_map.hh"
+#include "throw_assert.hh"
+
+using namespace std;
+
+namespace neuroh5
+{
+
+  namespace data
+  {
+
+  template<>
+  const vector< AttrColumn<float> >& ColumnarAttrMap::attr_columns<float> () const
+  {
+    return float_values;
+  }
+  template<>
+  const vector< AttrColumn<uint8_t> >& ColumnarAttrMap::attr_columns<uint8_t> () const
+  {
+    return uint8_values;
+  }
+  template<>
+  const vector< AttrColumn<int8_t> >& ColumnarAttrMap::attr_columns<int8_t> () const
+  {
+    return int8_values;
+  }
+  template<>
+  const vector< AttrColumn<uint16_t> >& ColumnarAttrMap::attr_columns<uint16_t> () const
+  {
+    return uint16_values;
+  }
+  template<>
+  const vector< AttrColumn<int16_t> >& ColumnarAttrMap::attr_columns<int16_t> () const
+  {
+    return int16_values;
+  }
+  template<>
+  const vector< AttrColumn<uint32_t> >& ColumnarAttrMap::attr_columns<uint32_t> () const
+  {
+    return uint32_values;
+  }
+  template<>
+  const vector< AttrColumn<int32_t> >& ColumnarAttrMap::attr_columns<int32_t> () const
+  {
+    return int32_values;
+  }
+
+  template<>
+  vector< AttrColumn<float> >& ColumnarAttrMap::attr_columns<float> ()
+  {
+    return float_values;
+  }
+  template<>
+  vector< AttrColumn<uint8_t> >& ColumnarAttrMap::attr_columns<uint8_t> ()
+  {
+    return uint8_values;
+  }
+  template<>
+  vector< AttrColumn<int8_t> >& ColumnarAttrMap::attr_columns<int8_t> ()
+  {
+    return int8_values;
+  }
+  template<>
+  vector< AttrColumn<uint16_t> >& ColumnarAttrMap::attr_columns<uint16_t> ()
+  {
+    return uint16_values;
+  }
+  template<>
+  vector< AttrColumn<int16_t> >& ColumnarAttrMap::attr_columns<int16_t> ()
+  {
+    return int16_values;
+  }
+  template<>
+  vector< AttrColumn<uint32_t> >& ColumnarAttrMap::attr_columns<uint32_t> ()
+  {
+    return uint32_values;
+  }
+  template<>
+  vector< AttrColumn<int32_t> >& ColumnarAttrMap::attr_columns<int32_t> ()
+  {
+    return int32_values;
+  }
+
+  void ColumnarAttrMap::num_attrs (vector<size_t> &v) const
+  {
+    v.resize(AttrMap::num_attr_types);
+    v[AttrMap::attr_index_float]=num_attr<float>();
+    v[AttrMap::attr_index_uint8]=num_attr<uint8_t>();
+    v[AttrMap::attr_index_int8]=num_attr<int8_t>();
+    v[AttrMap::attr_index_uint16]=num_attr<uint16_t>();
+    v[AttrMap::attr_index_int16]=num_attr<int16_t>();
+    v[AttrMap::attr_index_uint32]=num_attr<uint32_t>();
+    v[AttrMap::attr_index_int32]=num_attr<int32_t>();
+  }
+
+  void NamedColumnarAttrMap::attr_names (vector<vector<string>> &attr_names) const
+  {
+    attr_names.resize(AttrMap::num_attr_types);
+    attr_names_type<float>(attr_names[AttrMap::attr_index_float]);
+    attr_names_type<int8_t>(attr_names[AttrMap::attr_index_int8]);
+    attr_names_type<int16_t>(attr_names[AttrMap::attr_index_int16]);
+    attr_names_type<int32_t>(attr_names[AttrMap::attr_index_int32]);
+    attr_names_type<uint8_t>(attr_names[AttrMap::attr_index_uint8]);
+    attr_names_type<uint16_t>(attr_names[AttrMap::attr_index_uint16]);
+    attr_names_type<uint32_t>(attr_names[AttrMap::attr_index_uint32]);
+  }
+
+  }
+}
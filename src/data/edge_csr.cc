@@ -0,0 +1,309 @@
+// -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+//==============================================================================
+///  @file edge_csr.cc
+///
+///  Functions for building and converting compressed sparse row
+///  projection containers.
+///
+///  Copyright (C) 2016-2025 Project NeuroH5.
+//==============================================================================
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+#include <map>
+
+#include "neuroh5_types.hh"
+#include "edge_csr.hh"
+#include "throw_assert.hh"
+
+using namespace std;
+
+namespace neuroh5
+{
+
+  namespace data
+  {
+
+    template <class T>
+    static void append_attr_slice (const AttrVal& from, size_t start, size_t end,
+                                   AttrVal& to)
+    {
+      if (to.size_attr_vec<T>() < from.size_attr_vec<T>())
+        {
+          to.resize<T>(from.size_attr_vec<T>());
+        }
+      for (size_t k = 0; k < from.size_attr_vec<T>(); k++)
+        {
+          const vector<T>& src_values = from.const_attr_vec<T>(k);
+          vector<T>& dst_values = to.attr_vec<T>(k);
+          dst_values.insert(dst_values.end(), src_values.begin()+start, src_values.begin()+end);
+        }
+    }
+
+    /**************************************************************************
+     * Append the attribute values of edges [start, end) of each attribute
+     * namespace in from to the corresponding namespace in to
+     **************************************************************************/
+    static void append_attr_slices (const vector<AttrVal>& from, size_t start, size_t end,
+                                    vector<AttrVal>& to)
+    {
+      if (to.size() < from.size())
+        {
+          to.resize(from.size());
+        }
+      for (size_t i = 0; i < from.size(); i++)
+        {
+          append_attr_slice<float>(from[i], start, end, to[i]);
+          append_attr_slice<uint8_t>(from[i], start, end, to[i]);
+          append_attr_slice<uint16_t>(from[i], start, end, to[i]);
+          append_attr_slice<uint32_t>(from[i], start, end, to[i]);
+          append_attr_slice<int8_t>(from[i], start, end, to[i]);
+          append_attr_slice<int16_t>(from[i], start, end, to[i]);
+          append_attr_slice<int32_t>(from[i], start, end, to[i]);
+        }
+    }
+
+
+    template <class T>
+    static bool same_attr_vec_count (const AttrVal& a, const AttrVal& b)
+    {
+      return a.size_attr_vec<T>() == b.size_attr_vec<T>();
+    }
+
+    /**************************************************************************
+     * Check that two sets of edge attributes have the same namespaces and
+     * the same number of attributes of each type, so that their attribute
+     * columns can be appended edge by edge. Edge sets without edges carry
+     * no attribute values and match any layout.
+     **************************************************************************/
+    static void check_attr_layout (const vector<AttrVal>& a, size_t a_num_edges,
+                                   const vector<AttrVal>& b, size_t b_num_edges,
+                                   const char* caller)
+    {
+      if ((a_num_edges == 0) || (b_num_edges == 0))
+        {
+          return;
+        }
+      throw_assert(a.size() == b.size(),
+                   caller << ": edge attribute namespace count mismatch: " <<
+                   a.size() << " != " << b.size());
+      for (size_t i = 0; i < a.size(); i++)
+        {
+          bool same = same_attr_vec_count<float>(a[i], b[i]) &&
+            same_attr_vec_count<uint8_t>(a[i], b[i]) &&
+            same_attr_vec_count<uint16_t>(a[i], b[i]) &&
+            same_attr_vec_count<uint32_t>(a[i], b[i]) &&
+            same_attr_vec_count<int8_t>(a[i], b[i]) &&
+            same_attr_vec_count<int16_t>(a[i], b[i]) &&
+            same_attr_vec_count<int32_t>(a[i], b[i]);
+          throw_assert(same,
+                       caller << ": edge attribute type layout mismatch in namespace " << i);
+        }
+    }
+
+
+    /**************************************************************************
+     * Merge two CSR containers
+     **************************************************************************/
+    void append_edge_csr
+    (
+     const edge_csr_t&               other,
+     edge_csr_t&                     edge_csr
+     )
+    {
+      if (other.empty())
+        {
+          return;
+        }
+      check_attr_layout(edge_csr.edge_attrs, edge_csr.num_edges(),
+                        other.edge_attrs, other.num_edges(),
+                        "append_edge_csr");
+      if (edge_csr.empty())
+        {
+          edge_csr = other;
+          return;
+        }
+
+      edge_csr_t merged;
+      merged.node_index.reserve(edge_csr.size() + other.size());
+      merged.adj_offsets.reserve(edge_csr.size() + other.size() + 1);
+      merged.adj_index.reserve(edge_csr.num_edges() + other.num_edges());
+
+      size_t i = 0, j = 0;
+      merged.adj_offsets.push_back(0);
+      while ((i < edge_csr.size()) || (j < other.size()))
+        {
+          NODE_IDX_T node;
+          if (j >= other.size())
+            node = edge_csr.node_index[i];
+          else if (i >= edge_csr.size())
+            node = other.node_index[j];
+          else
+            node = min(edge_csr.node_index[i], other.node_index[j]);
+
+          merged.node_index.push_back(node);
+          if ((i < edge_csr.size()) && (edge_csr.node_index[i] == node))
+            {
+              size_t start = edge_csr.adj_offsets[i], end = edge_csr.adj_offsets[i+1];
+              merged.adj_index.insert(merged.adj_index.end(),
+                                      edge_csr.adj_index.begin()+start,
+                                      edge_csr.adj_index.begin()+end);
+              append_attr_slices(edge_csr.edge_attrs, start, end, merged.edge_attrs);
+              i++;
+            }
+          if ((j < other.size()) && (other.node_index[j] == node))
+            {
+              size_t start = other.adj_offsets[j], end = other.adj_offsets[j+1];
+              merged.adj_index.insert(merged.adj_index.end(),
+                                      other.adj_index.begin()+start,
+                                      other.adj_index.begin()+end);
+              append_attr_slices(other.edge_attrs, start, end, merged.edge_attrs);
+              j++;
+            }
+          merged.adj_offsets.push_back(merged.adj_index.size());
+        }
+
+      edge_csr = std::move(merged);
+    }
+
+
+    /**************************************************************************
+     * Build a CSR container from one or more edge maps
+     **************************************************************************/
+    static void edge_maps_to_csr
+    (
+     const vector<const edge_map_t*>&  edge_maps,
+     edge_csr_t&                       edge_csr
+     )
+    {
+      // (node, map index) pairs of all entries, ordered by node and then
+      // by map index
+      vector< pair<NODE_IDX_T, size_t> > entries;
+      vector< edge_map_const_iter_t > entry_iters;
+      size_t num_entries = 0, num_edges = 0;
+      for (const edge_map_t* edge_map : edge_maps)
+        {
+          num_entries += edge_map->size();
+        }
+      entries.reserve(num_entries);
+      entry_iters.reserve(num_entries);
+      for (size_t m = 0; m < edge_maps.size(); m++)
+        {
+          for (auto it = edge_maps[m]->cbegin(); it != edge_maps[m]->cend(); ++it)
+            {
+              entries.push_back(make_pair(it->first, entry_iters.size()));
+              entry_iters.push_back(it);
+              num_edges += get<0>(it->second).size();
+            }
+        }
+      // entries were inserted in map order, so the stable sort
+      // preserves the order of maps for equal nodes
+      if (edge_maps.size() > 1)
+        {
+          stable_sort(entries.begin(), entries.end(),
+                      [] (const pair<NODE_IDX_T, size_t>& a, const pair<NODE_IDX_T, size_t>& b)
+                      { return a.first < b.first; });
+        }
+
+      edge_csr_t result;
+      result.node_index.reserve(num_entries);
+      result.adj_offsets.reserve(num_entries+1);
+      result.adj_index.reserve(num_edges);
+      result.adj_offsets.push_back(0);
+      for (size_t e = 0; e < entries.size(); e++)
+        {
+          const NODE_IDX_T node = entries[e].first;
+          const edge_tuple_t& et = entry_iters[entries[e].second]->second;
+          const vector<NODE_IDX_T>& adj_vector = get<0>(et);
+          const vector<AttrVal>& edge_attr_values = get<1>(et);
+
+          check_attr_layout(result.edge_attrs, result.num_edges(),
+                            edge_attr_values, adj_vector.size(),
+                            "edge_map_to_csr");
+
+          if (result.node_index.empty() || (result.node_index.back() != node))
+            {
+              if (!result.node_index.empty())
+                {
+                  result.adj_offsets.push_back(result.adj_index.size());
+                }
+              result.node_index.push_back(node);
+            }
+          result.adj_index.insert(result.adj_index.end(), adj_vector.begin(), adj_vector.end());
+          append_attr_slices(edge_attr_values, 0, adj_vector.size(), result.edge_attrs);
+        }
+      if (!result.node_index.empty())
+        {
+          result.adj_offsets.push_back(result.adj_index.size());
+        }
+
+      if (edge_csr.empty())
+        {
+          edge_csr = std::move(result);
+        }
+      else
+        {
+          append_edge_csr(result, edge_csr);
+        }
+    }
+
+
+    void edge_map_to_csr
+    (
+     const vector<edge_map_t>&  edge_maps,
+     edge_csr_t&                edge_csr
+     )
+    {
+      vector<const edge_map_t*> edge_map_ptrs;
+      for (const edge_map_t& edge_map : edge_maps)
+        {
+          edge_map_ptrs.push_back(&edge_map);
+        }
+      edge_maps_to_csr(edge_map_ptrs, edge_csr);
+    }
+
+
+    void edge_map_to_csr
+    (
+     const edge_map_t&          edge_map,
+     edge_csr_t&                edge_csr
+     )
+    {
+      edge_maps_to_csr(vector<const edge_map_t*>(1, &edge_map), edge_csr);
+    }
+
+
+    /**************************************************************************
+     * Append the contents of a CSR container to an edge map
+     **************************************************************************/
+    void csr_to_edge_map
+    (
+     const edge_csr_t&               edge_csr,
+     edge_map_t&                     edge_map
+     )
+    {
+      throw_assert(edge_csr.adj_offsets.size() == edge_csr.node_index.size() + 1 ||
+                   edge_csr.empty(),
+                   "csr_to_edge_map: inconsistent offsets array");
+
+      for (size_t i = 0; i < edge_csr.size(); i++)
+        {
+          size_t start = edge_csr.adj_offsets[i], end = edge_csr.adj_offsets[i+1];
+
+          edge_tuple_t& et = edge_map[edge_csr.node_index[i]];
+          vector<NODE_IDX_T>& adj_vector = get<0>(et);
+          vector<AttrVal>& edge_attr_values = get<1>(et);
+
+          check_attr_layout(edge_attr_values, adj_vector.size(),
+                            edge_csr.edge_attrs, end - start,
+                            "csr_to_edge_map");
+          adj_vector.insert(adj_vector.end(),
+                            edge_csr.adj_index.begin()+start,
+                            edge_csr.adj_index.begin()+end);
+          append_attr_slices(edge_csr.edge_attrs, start, end, edge_attr_values);
+        }
+    }
+
+  }
+}
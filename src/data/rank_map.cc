@@ -0,0 +1,247 @@
+// -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+//==============================================================================
+///  @file rank_map.cc
+///
+///  Compact mapping of graph nodes and cells to the MPI ranks that own
+///  them.
+///
+///  Copyright (C) 2016-2025 Project NeuroH5.
+//==============================================================================
+
+#include <algorithm>
+#include <vector>
+
+#include "neuroh5_types.hh"
+#include "rank_map.hh"
+#include "throw_assert.hh"
+
+using namespace std;
+
+namespace neuroh5
+{
+
+  namespace data
+  {
+
+    NodeRankMap::NodeRankMap (const node_rank_map_t& node_rank_map)
+    {
+      if (node_rank_map.empty())
+        {
+          return;
+        }
+
+      bool single_owner = true;
+      size_t num_owners = 0;
+      for (const auto& it : node_rank_map)
+        {
+          single_owner = single_owner && (it.second.size() == 1);
+          num_owners += it.second.size();
+        }
+
+      const NODE_IDX_T min_node = node_rank_map.cbegin()->first;
+      const NODE_IDX_T max_node = node_rank_map.crbegin()->first;
+      const size_t range = (size_t)(max_node - min_node) + 1;
+
+      // a flat array is used when it is not much larger than the
+      // index of a CSR map
+      if (single_owner && (range <= 2*node_rank_map.size()))
+        {
+          map_type = RankMapFlat;
+          start = min_node;
+          num_nodes = range;
+          owners.assign(range, no_rank);
+          for (const auto& it : node_rank_map)
+            {
+              owners[it.first - min_node] = *(it.second.begin());
+            }
+        }
+      else
+        {
+          map_type = RankMapCSR;
+          node_index.reserve(node_rank_map.size());
+          offsets.reserve(node_rank_map.size()+1);
+          owners.reserve(num_owners);
+          offsets.push_back(0);
+          for (const auto& it : node_rank_map)
+            {
+              node_index.push_back(it.first);
+              owners.insert(owners.end(), it.second.begin(), it.second.end());
+              offsets.push_back(owners.size());
+            }
+          num_nodes = node_index.size();
+        }
+    }
+
+
+    NodeRankMap NodeRankMap::round_robin (size_t num_ranks, NODE_IDX_T start, size_t num_nodes)
+    {
+      throw_assert(num_ranks > 0,
+                   "NodeRankMap::round_robin: number of ranks must be positive");
+      NodeRankMap result;
+      result.map_type = RankMapRoundRobin;
+      result.num_ranks = num_ranks;
+      result.start = start;
+      result.num_nodes = num_nodes;
+      return result;
+    }
+
+
+    NodeRankMap NodeRankMap::block (size_t num_ranks, NODE_IDX_T start, size_t num_nodes)
+    {
+      throw_assert(num_ranks > 0,
+                   "NodeRankMap::block: number of ranks must be positive");
+      NodeRankMap result;
+      result.map_type = RankMapBlock;
+      result.num_ranks = num_ranks;
+      result.start = start;
+      result.num_nodes = num_nodes;
+      return result;
+    }
+
+
+    NodeRankMap NodeRankMap::flat (NODE_IDX_T start, vector<rank_t>&& owners)
+    {
+      NodeRankMap result;
+      result.map_type = RankMapFlat;
+      result.start = start;
+      result.num_nodes = owners.size();
+      result.owners = std::move(owners);
+      return result;
+    }
+
+
+    NodeRankMap NodeRankMap::csr (vector<NODE_IDX_T>&& node_index,
+                                  vector<size_t>&& offsets,
+                                  vector<rank_t>&& owners)
+    {
+      throw_assert(offsets.size() == node_index.size() + 1,
+                   "NodeRankMap::csr: inconsistent offsets array");
+      throw_assert(offsets.back() == owners.size(),
+                   "NodeRankMap::csr: inconsistent owners array");
+      throw_assert(is_sorted(node_index.begin(), node_index.end()),
+                   "NodeRankMap::csr: node index is not sorted");
+      NodeRankMap result;
+      result.map_type = RankMapCSR;
+      result.num_nodes = node_index.size();
+      result.node_index = std::move(node_index);
+      result.offsets = std::move(offsets);
+      result.owners = std::move(owners);
+      return result;
+    }
+
+
+    NodeRankMap::Ranks NodeRankMap::find (NODE_IDX_T node) const
+    {
+      switch (map_type)
+        {
+        case RankMapNone:
+          break;
+        case RankMapRoundRobin:
+          if ((node >= start) && ((size_t)(node - start) < num_nodes))
+            {
+              return Ranks((rank_t)((node - start) % num_ranks));
+            }
+          break;
+        case RankMapBlock:
+          if ((node >= start) && ((size_t)(node - start) < num_nodes))
+            {
+              // the first num_ranks - remainder blocks have block_size
+              // nodes, the remaining blocks one more
+              const size_t i = node - start;
+              const size_t block_size = num_nodes / num_ranks;
+              const size_t remainder = num_nodes % num_ranks;
+              const size_t boundary = (num_ranks - remainder) * block_size;
+              if (i < boundary)
+                {
+                  return Ranks((rank_t)(i / block_size));
+                }
+              return Ranks((rank_t)((num_ranks - remainder) + (i - boundary) / (block_size + 1)));
+            }
+          break;
+        case RankMapFlat:
+          if ((node >= start) && ((size_t)(node - start) < num_nodes))
+            {
+              const rank_t r = owners[node - start];
+              if (r != no_rank)
+                {
+                  return Ranks(r);
+                }
+            }
+          break;
+        case RankMapCSR:
+          {
+            auto it = lower_bound(node_index.cbegin(), node_index.cend(), node);
+            if ((it != node_index.cend()) && (*it == node))
+              {
+                const size_t i = it - node_index.cbegin();
+                return Ranks(owners.data() + offsets[i], offsets[i+1] - offsets[i]);
+              }
+          }
+          break;
+        }
+      return Ranks();
+    }
+
+
+    void NodeRankMap::local_nodes (rank_t rank, vector<NODE_IDX_T>& nodes) const
+    {
+      nodes.clear();
+      switch (map_type)
+        {
+        case RankMapNone:
+          break;
+        case RankMapRoundRobin:
+          for (size_t i = rank; i < num_nodes; i += num_ranks)
+            {
+              nodes.push_back(start + i);
+            }
+          break;
+        case RankMapBlock:
+          {
+            const size_t block_size = num_nodes / num_ranks;
+            const size_t remainder = num_nodes % num_ranks;
+            const size_t num_small = num_ranks - remainder;
+            if (rank < num_ranks)
+              {
+                size_t first, count;
+                if (rank < num_small)
+                  {
+                    first = rank * block_size;
+                    count = block_size;
+                  }
+                else
+                  {
+                    first = num_small * block_size + (rank - num_small) * (block_size + 1);
+                    count = block_size + 1;
+                  }
+                for (size_t i = first; i < first + count; i++)
+                  {
+                    nodes.push_back(start + i);
+                  }
+              }
+          }
+          break;
+        case RankMapFlat:
+          for (size_t i = 0; i < num_nodes; i++)
+            {
+              if (owners[i] == rank)
+                {
+                  nodes.push_back(start + i);
+                }
+            }
+          break;
+        case RankMapCSR:
+          for (size_t i = 0; i < node_index.size(); i++)
+            {
+              if (std::find(owners.begin() + offsets[i], owners.begin() + offsets[i+1], rank) !=
+                  owners.begin() + offsets[i+1])
+                {
+                  nodes.push_back(node_index[i]);
+                }
+            }
+          break;
+        }
+    }
+
+  }
+}
@@ -35,12 +35,15 @@ namespace neuroh5
   namespace data
   {
       
-    void serialize_rank_attr_map (const size_t num_ranks,
-                                  const size_t start_rank,
-                                  const map <rank_t, AttrMap>& rank_attr_map,
-                                  vector<size_t>& sendcounts,
-                                  vector<char> &sendbuf,
-                                  vector<size_t> &sdispls)
+    // Both attribute map layouts are serialized per destination rank
+    // with the same archive framing
+    template <class AttrMapT>
+    static void serialize_rank_map (const size_t num_ranks,
+                                    const size_t start_rank,
+                                    const map <rank_t, AttrMapT>& rank_attr_map,
+                                    vector<size_t>& sendcounts,
+                                    vector<char> &sendbuf,
+                                    vector<size_t> &sdispls)
     {
       vector<rank_t> rank_sequence;
 
@@ -70,7 +73,7 @@ namespace neuroh5
           auto it1 = rank_attr_map.find(key_rank);
           if (it1 != rank_attr_map.end())
             {
-              const AttrMap& attr_map = it1->second;
+              const AttrMapT& attr_map = it1->second;
               {
                 
                 cereal::BinaryOutputArchive oarchive(ss); // Create an output archive
@@ -92,11 +95,12 @@ namespace neuroh5
     
 
 
-    void deserialize_rank_attr_map (const size_t num_ranks,
-                                    const vector<char> &recvbuf,
-                                    const vector<size_t>& recvcounts,
-                                    const vector<size_t>& rdispls,
-                                    AttrMap& all_attr_map)
+    template <class AttrMapT>
+    static void deserialize_rank_map (const size_t num_ranks,
+                                      const vector<char> &recvbuf,
+                                      const vector<size_t>& recvcounts,
+                                      const vector<size_t>& rdispls,
+                                      AttrMapT& all_attr_map)
     {
       const size_t recvbuf_size = recvbuf.size();
 
@@ -107,7 +111,7 @@ namespace neuroh5
               size_t recvsize  = recvcounts[ridx];
               size_t recvpos   = rdispls[ridx];
               size_t startpos  = recvpos;
-              AttrMap attr_map;
+              AttrMapT attr_map;
 
               throw_assert(recvpos < recvbuf_size,
                            "deserialize_rank_attr_map: invalid buffer displacement");
@@ -130,5 +134,44 @@ namespace neuroh5
         }
     }
 
+
+    void serialize_rank_attr_map (const size_t num_ranks,
+                                  const size_t start_rank,
+                                  const map <rank_t, AttrMap>& rank_attr_map,
+                                  vector<size_t>& sendcounts,
+                                  vector<char> &sendbuf,
+                                  vector<size_t> &sdispls)
+    {
+      serialize_rank_map(num_ranks, start_rank, rank_attr_map, sendcounts, sendbuf, sdispls);
+    }
+
+    void serialize_rank_attr_map (const size_t num_ranks,
+                                  const size_t start_rank,
+                                  const map <rank_t, ColumnarAttrMap>& rank_attr_map,
+                                  vector<size_t>& sendcounts,
+                                  vector<char> &sendbuf,
+                                  vector<size_t> &sdispls)
+    {
+      serialize_rank_map(num_ranks, start_rank, rank_attr_map, sendcounts, sendbuf, sdispls);
+    }
+
+    void deserialize_rank_attr_map (const size_t num_ranks,
+                                    const vector<char> &recvbuf,
+                                    const vector<size_t>& recvcounts,
+                                    const vector<size_t>& rdispls,
+                                    AttrMap& all_attr_map)
+    {
+      deserialize_rank_map(num_ranks, recvbuf, recvcounts, rdispls, all_attr_map);
+    }
+
+    void deserialize_rank_attr_map (const size_t num_ranks,
+                                    const vector<char> &recvbuf,
+                                    const vector<size_t>& recvcounts,
+                                    const vector<size_t>& rdispls,
+                                    ColumnarAttrMap& all_attr_map)
+    {
+      deserialize_rank_map(num_ranks, recvbuf, recvcounts, rdispls, all_attr_map);
+    }
+
   }
 }
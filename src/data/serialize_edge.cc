@@ -10,6 +10,7 @@
 #include "debug.hh"
 
 #include "serialize_edge.hh"
+#include "edge_csr.hh"
 
 #include <cstdio>
 #include <iostream>
@@ -22,6 +23,7 @@
 #include <climits>
 #include <map>
 #include <vector>
+#include <queue>
 
 #include "cereal/archives/binary.hpp"
 
@@ -35,6 +37,633 @@ namespace neuroh5
   namespace data
   {
 
+    /*************************************************************************
+     * Wire format of the edges sent to one rank by serialize_rank_edge_map,
+     * and of a CSR container packed by serialize_edge_map. All fields are
+     * in native byte order and are accessed with memcpy, so no alignment
+     * is assumed:
+     *
+     *   uint64_t   number of nodes N
+     *   uint64_t   number of edges E
+     *   uint32_t   number of attribute namespaces S
+     *   uint32_t   S x 7 attribute counts, in AttrVal type index order
+     *   NODE_IDX_T N node ids, in edge map or CSR order
+     *   uint64_t   N adjacency counts
+     *   NODE_IDX_T E adjacent node ids
+     *   for each namespace, type and attribute: E values
+     *
+     * All entries of an edge map must have the same attribute layout.
+     *************************************************************************/
+
+    static const size_t edge_wire_attr_type_size[AttrVal::num_attr_types] =
+      {
+        sizeof(float), sizeof(uint8_t), sizeof(int8_t),
+        sizeof(uint16_t), sizeof(int16_t), sizeof(uint32_t), sizeof(int32_t)
+      };
+
+    struct EdgeWireBlock
+    {
+      uint64_t num_nodes, num_edges;
+      uint32_t num_namespaces;
+      vector<uint32_t> attr_counts;
+      const char* nodes;
+      const char* adj_counts;
+      const char* adj;
+      // start of the columns of each namespace and type
+      vector<const char*> attr_columns;
+    };
+
+    template <class T>
+    static void edge_wire_check_attr (const AttrVal& a, uint32_t num_attrs, size_t num_adj)
+    {
+      throw_assert(a.size_attr_vec<T>() == num_attrs,
+                   "serialize_rank_edge_map: edge map entries have different attribute layouts");
+      for (size_t k = 0; k < num_attrs; k++)
+        {
+          throw_assert(a.size_attr<T>(k) == num_adj,
+                       "serialize_rank_edge_map: attribute and adjacency vectors have different sizes");
+        }
+    }
+
+    /*************************************************************************
+     * Determine the attribute layout and packed size of an edge map
+     *************************************************************************/
+    static size_t edge_wire_size (const edge_map_t& edge_map,
+                                  vector<uint32_t>& attr_counts,
+                                  size_t& num_edges)
+    {
+      const size_t num_types = AttrVal::num_attr_types;
+      attr_counts.clear();
+      num_edges = 0;
+
+      size_t num_namespaces = 0;
+      if (edge_map.size() > 0)
+        {
+          const vector<AttrVal>& edge_attr_values = get<1>(edge_map.cbegin()->second);
+          num_namespaces = edge_attr_values.size();
+          attr_counts.resize(num_namespaces * num_types);
+          for (size_t i = 0; i < num_namespaces; i++)
+            {
+              const AttrVal& a = edge_attr_values[i];
+              attr_counts[i*num_types + AttrVal::attr_index_float]  = a.size_attr_vec<float>();
+              attr_counts[i*num_types + AttrVal::attr_index_uint8]  = a.size_attr_vec<uint8_t>();
+              attr_counts[i*num_types + AttrVal::attr_index_int8]   = a.size_attr_vec<int8_t>();
+              attr_counts[i*num_types + AttrVal::attr_index_uint16] = a.size_attr_vec<uint16_t>();
+              attr_counts[i*num_types + AttrVal::attr_index_int16]  = a.size_attr_vec<int16_t>();
+              attr_counts[i*num_types + AttrVal::attr_index_uint32] = a.size_attr_vec<uint32_t>();
+              attr_counts[i*num_types + AttrVal::attr_index_int32]  = a.size_attr_vec<int32_t>();
+            }
+        }
+
+      for (auto it = edge_map.cbegin(); it != edge_map.cend(); ++it)
+        {
+          const vector<NODE_IDX_T>& adj_vector = get<0>(it->second);
+          const vector<AttrVal>& edge_attr_values = get<1>(it->second);
+          throw_assert(edge_attr_values.size() == num_namespaces,
+                       "serialize_rank_edge_map: edge map entries have different numbers of attribute namespaces");
+          for (size_t i = 0; i < num_namespaces; i++)
+            {
+              const AttrVal& a = edge_attr_values[i];
+              const uint32_t* c = &attr_counts[i*num_types];
+              edge_wire_check_attr<float>(a, c[AttrVal::attr_index_float], adj_vector.size());
+              edge_wire_check_attr<uint8_t>(a, c[AttrVal::attr_index_uint8], adj_vector.size());
+              edge_wire_check_attr<int8_t>(a, c[AttrVal::attr_index_int8], adj_vector.size());
+              edge_wire_check_attr<uint16_t>(a, c[AttrVal::attr_index_uint16], adj_vector.size());
+              edge_wire_check_attr<int16_t>(a, c[AttrVal::attr_index_int16], adj_vector.size());
+              edge_wire_check_attr<uint32_t>(a, c[AttrVal::attr_index_uint32], adj_vector.size());
+              edge_wire_check_attr<int32_t>(a, c[AttrVal::attr_index_int32], adj_vector.size());
+            }
+          num_edges += adj_vector.size();
+        }
+
+      size_t edge_bytes = sizeof(NODE_IDX_T);
+      for (size_t j = 0; j < attr_counts.size(); j++)
+        {
+          edge_bytes += attr_counts[j] * edge_wire_attr_type_size[j % num_types];
+        }
+      
+      return 2*sizeof(uint64_t) + sizeof(uint32_t) + attr_counts.size()*sizeof(uint32_t) +
+        edge_map.size()*(sizeof(NODE_IDX_T) + sizeof(uint64_t)) +
+        num_edges*edge_bytes;
+    }
+
+    template <class T>
+    static void edge_wire_pack_attr (const edge_map_t& edge_map, size_t ns,
+                                     uint32_t num_attrs, char*& pos)
+    {
+      for (size_t k = 0; k < num_attrs; k++)
+        {
+          for (auto it = edge_map.cbegin(); it != edge_map.cend(); ++it)
+            {
+              const vector<T>& values = get<1>(it->second)[ns].const_attr_vec<T>(k);
+              size_t nbytes = values.size()*sizeof(T);
+              if (nbytes > 0)
+                {
+                  memcpy(pos, values.data(), nbytes);
+                }
+              pos += nbytes;
+            }
+        }
+    }
+
+    /*************************************************************************
+     * Pack an edge map into the given buffer position
+     *************************************************************************/
+    static void edge_wire_pack (const edge_map_t& edge_map,
+                                const vector<uint32_t>& attr_counts,
+                                const size_t num_edges,
+                                char* pos)
+    {
+      const size_t num_types = AttrVal::num_attr_types;
+      uint64_t num_nodes64 = edge_map.size(), num_edges64 = num_edges;
+      uint32_t num_namespaces = attr_counts.size() / num_types;
+
+      memcpy(pos, &num_nodes64, sizeof(uint64_t)); pos += sizeof(uint64_t);
+      memcpy(pos, &num_edges64, sizeof(uint64_t)); pos += sizeof(uint64_t);
+      memcpy(pos, &num_namespaces, sizeof(uint32_t)); pos += sizeof(uint32_t);
+      if (attr_counts.size() > 0)
+        {
+          memcpy(pos, attr_counts.data(), attr_counts.size()*sizeof(uint32_t));
+          pos += attr_counts.size()*sizeof(uint32_t);
+        }
+
+      for (auto it = edge_map.cbegin(); it != edge_map.cend(); ++it)
+        {
+          memcpy(pos, &(it->first), sizeof(NODE_IDX_T));
+          pos += sizeof(NODE_IDX_T);
+        }
+      for (auto it = edge_map.cbegin(); it != edge_map.cend(); ++it)
+        {
+          uint64_t adj_count = get<0>(it->second).size();
+          memcpy(pos, &adj_count, sizeof(uint64_t));
+          pos += sizeof(uint64_t);
+        }
+      for (auto it = edge_map.cbegin(); it != edge_map.cend(); ++it)
+        {
+          const vector<NODE_IDX_T>& adj_vector = get<0>(it->second);
+          size_t nbytes = adj_vector.size()*sizeof(NODE_IDX_T);
+          if (nbytes > 0)
+            {
+              memcpy(pos, adj_vector.data(), nbytes);
+            }
+          pos += nbytes;
+        }
+      for (size_t i = 0; i < num_namespaces; i++)
+        {
+          const uint32_t* c = &attr_counts[i*num_types];
+          edge_wire_pack_attr<float>(edge_map, i, c[AttrVal::attr_index_float], pos);
+          edge_wire_pack_attr<uint8_t>(edge_map, i, c[AttrVal::attr_index_uint8], pos);
+          edge_wire_pack_attr<int8_t>(edge_map, i, c[AttrVal::attr_index_int8], pos);
+          edge_wire_pack_attr<uint16_t>(edge_map, i, c[AttrVal::attr_index_uint16], pos);
+          edge_wire_pack_attr<int16_t>(edge_map, i, c[AttrVal::attr_index_int16], pos);
+          edge_wire_pack_attr<uint32_t>(edge_map, i, c[AttrVal::attr_index_uint32], pos);
+          edge_wire_pack_attr<int32_t>(edge_map, i, c[AttrVal::attr_index_int32], pos);
+        }
+    }
+
+    /*************************************************************************
+     * Locate the fields of a packed edge map without copying them
+     *************************************************************************/
+    static void edge_wire_unpack_header (const char* pos, const size_t size,
+                                         EdgeWireBlock& block)
+    {
+      const size_t num_types = AttrVal::num_attr_types;
+      const char* end = pos + size;
+      
+      throw_assert(size >= 2*sizeof(uint64_t) + sizeof(uint32_t),
+                   "deserialize_rank_edge_map: truncated edge block");
+      memcpy(&block.num_nodes, pos, sizeof(uint64_t)); pos += sizeof(uint64_t);
+      memcpy(&block.num_edges, pos, sizeof(uint64_t)); pos += sizeof(uint64_t);
+      memcpy(&block.num_namespaces, pos, sizeof(uint32_t)); pos += sizeof(uint32_t);
+      block.attr_counts.resize(block.num_namespaces * num_types);
+      throw_assert(pos + block.attr_counts.size()*sizeof(uint32_t) <= end,
+                   "deserialize_rank_edge_map: truncated edge block");
+      if (block.attr_counts.size() > 0)
+        {
+          memcpy(block.attr_counts.data(), pos, block.attr_counts.size()*sizeof(uint32_t));
+          pos += block.attr_counts.size()*sizeof(uint32_t);
+        }
+
+      block.nodes = pos;
+      pos += block.num_nodes*sizeof(NODE_IDX_T);
+      block.adj_counts = pos;
+      pos += block.num_nodes*sizeof(uint64_t);
+      block.adj = pos;
+      pos += block.num_edges*sizeof(NODE_IDX_T);
+
+      block.attr_columns.resize(block.attr_counts.size());
+      for (size_t j = 0; j < block.attr_counts.size(); j++)
+        {
+          block.attr_columns[j] = pos;
+          pos += block.attr_counts[j] * block.num_edges * edge_wire_attr_type_size[j % num_types];
+        }
+      throw_assert(pos == end,
+                   "deserialize_rank_edge_map: edge block size mismatch");
+    }
+
+    template <class T>
+    static void edge_wire_unpack_attr (const EdgeWireBlock& block, size_t ns,
+                                       size_t start, size_t count, AttrVal& a)
+    {
+      const size_t j = ns*AttrVal::num_attr_types + AttrVal::attr_type_index<T>();
+      const uint32_t num_attrs = block.attr_counts[j];
+      if (a.size_attr_vec<T>() < num_attrs)
+        {
+          a.resize<T>(num_attrs);
+        }
+      for (size_t k = 0; k < num_attrs; k++)
+        {
+          const char* column = block.attr_columns[j] + k*block.num_edges*sizeof(T);
+          vector<T>& values = a.attr_vec<T>(k);
+          size_t values_size = values.size();
+          values.resize(values_size + count);
+          if (count > 0)
+            {
+              memcpy(&values[values_size], column + start*sizeof(T), count*sizeof(T));
+            }
+        }
+    }
+
+    static void edge_wire_unpack_attrs (const EdgeWireBlock& block,
+                                        size_t start, size_t count,
+                                        vector<AttrVal>& edge_attr_values)
+    {
+      if (edge_attr_values.size() < block.num_namespaces)
+        {
+          edge_attr_values.resize(block.num_namespaces);
+        }
+      for (size_t i = 0; i < block.num_namespaces; i++)
+        {
+          AttrVal& a = edge_attr_values[i];
+          edge_wire_unpack_attr<float>(block, i, start, count, a);
+          edge_wire_unpack_attr<uint8_t>(block, i, start, count, a);
+          edge_wire_unpack_attr<int8_t>(block, i, start, count, a);
+          edge_wire_unpack_attr<uint16_t>(block, i, start, count, a);
+          edge_wire_unpack_attr<int16_t>(block, i, start, count, a);
+          edge_wire_unpack_attr<uint32_t>(block, i, start, count, a);
+          edge_wire_unpack_attr<int32_t>(block, i, start, count, a);
+        }
+    }
+
+
+    /*************************************************************************
+     * Determine the attribute layout and packed size of a CSR container
+     *************************************************************************/
+    static void edge_wire_csr_attr_counts (const vector<AttrVal>& edge_attrs,
+                                           size_t num_edges,
+                                           vector<uint32_t>& attr_counts)
+    {
+      const size_t num_types = AttrVal::num_attr_types;
+      attr_counts.assign(edge_attrs.size() * num_types, 0);
+      for (size_t i = 0; i < edge_attrs.size(); i++)
+        {
+          const AttrVal& a = edge_attrs[i];
+          uint32_t* c = &attr_counts[i*num_types];
+          c[AttrVal::attr_index_float]  = a.size_attr_vec<float>();
+          c[AttrVal::attr_index_uint8]  = a.size_attr_vec<uint8_t>();
+          c[AttrVal::attr_index_int8]   = a.size_attr_vec<int8_t>();
+          c[AttrVal::attr_index_uint16] = a.size_attr_vec<uint16_t>();
+          c[AttrVal::attr_index_int16]  = a.size_attr_vec<int16_t>();
+          c[AttrVal::attr_index_uint32] = a.size_attr_vec<uint32_t>();
+          c[AttrVal::attr_index_int32]  = a.size_attr_vec<int32_t>();
+          edge_wire_check_attr<float>(a, c[AttrVal::attr_index_float], num_edges);
+          edge_wire_check_attr<uint8_t>(a, c[AttrVal::attr_index_uint8], num_edges);
+          edge_wire_check_attr<int8_t>(a, c[AttrVal::attr_index_int8], num_edges);
+          edge_wire_check_attr<uint16_t>(a, c[AttrVal::attr_index_uint16], num_edges);
+          edge_wire_check_attr<int16_t>(a, c[AttrVal::attr_index_int16], num_edges);
+          edge_wire_check_attr<uint32_t>(a, c[AttrVal::attr_index_uint32], num_edges);
+          edge_wire_check_attr<int32_t>(a, c[AttrVal::attr_index_int32], num_edges);
+        }
+    }
+
+    static size_t edge_wire_csr_size (const edge_csr_t& edge_csr,
+                                      vector<uint32_t>& attr_counts)
+    {
+      const size_t num_types = AttrVal::num_attr_types;
+      throw_assert(edge_csr.adj_offsets.size() == edge_csr.size() + 1 || edge_csr.empty(),
+                   "serialize_edge_map: inconsistent offsets array");
+      edge_wire_csr_attr_counts(edge_csr.edge_attrs, edge_csr.num_edges(), attr_counts);
+
+      size_t edge_bytes = sizeof(NODE_IDX_T);
+      for (size_t j = 0; j < attr_counts.size(); j++)
+        {
+          edge_bytes += attr_counts[j] * edge_wire_attr_type_size[j % num_types];
+        }
+      
+      return 2*sizeof(uint64_t) + sizeof(uint32_t) + attr_counts.size()*sizeof(uint32_t) +
+        edge_csr.size()*(sizeof(NODE_IDX_T) + sizeof(uint64_t)) +
+        edge_csr.num_edges()*edge_bytes;
+    }
+
+    template <class T>
+    static const char* edge_wire_column_data (const AttrVal& a, size_t k)
+    {
+      return (const char*)a.const_attr_vec<T>(k).data();
+    }
+
+    template <class T>
+    static char* edge_wire_column_data (AttrVal& a, size_t k)
+    {
+      return (char*)a.attr_vec<T>(k).data();
+    }
+
+    template <class T, class AttrValT, class Ptr>
+    static void edge_wire_attr_columns (AttrValT& a, uint32_t num_attrs, vector<Ptr>& columns)
+    {
+      for (size_t k = 0; k < num_attrs; k++)
+        {
+          columns.push_back(edge_wire_column_data<T>(a, k));
+        }
+    }
+
+    /*************************************************************************
+     * Attribute columns of a set of edge attributes, in wire order:
+     * namespace, type and attribute
+     *************************************************************************/
+    template <class AttrVecT, class Ptr>
+    static void edge_wire_attr_columns (AttrVecT& edge_attrs,
+                                        const vector<uint32_t>& attr_counts,
+                                        vector<Ptr>& columns)
+    {
+      const size_t num_types = AttrVal::num_attr_types;
+      for (size_t i = 0; i < edge_attrs.size(); i++)
+        {
+          auto& a = edge_attrs[i];
+          const uint32_t* c = &attr_counts[i*num_types];
+          edge_wire_attr_columns<float>(a, c[AttrVal::attr_index_float], columns);
+          edge_wire_attr_columns<uint8_t>(a, c[AttrVal::attr_index_uint8], columns);
+          edge_wire_attr_columns<int8_t>(a, c[AttrVal::attr_index_int8], columns);
+          edge_wire_attr_columns<uint16_t>(a, c[AttrVal::attr_index_uint16], columns);
+          edge_wire_attr_columns<int16_t>(a, c[AttrVal::attr_index_int16], columns);
+          edge_wire_attr_columns<uint32_t>(a, c[AttrVal::attr_index_uint32], columns);
+          edge_wire_attr_columns<int32_t>(a, c[AttrVal::attr_index_int32], columns);
+        }
+    }
+
+    // Sizes of the attribute columns, in the order of edge_wire_attr_columns
+    static void edge_wire_column_sizes (const vector<uint32_t>& attr_counts,
+                                        vector<size_t>& column_sizes)
+    {
+      const size_t num_types = AttrVal::num_attr_types;
+      for (size_t j = 0; j < attr_counts.size(); j++)
+        {
+          column_sizes.insert(column_sizes.end(), attr_counts[j],
+                              edge_wire_attr_type_size[j % num_types]);
+        }
+    }
+
+    /*************************************************************************
+     * Pack a CSR container into the given buffer position; the arrays of
+     * the container are copied as they are
+     *************************************************************************/
+    static void edge_wire_pack_csr (const edge_csr_t& edge_csr,
+                                    const vector<uint32_t>& attr_counts,
+                                    char* pos)
+    {
+      const size_t num_types = AttrVal::num_attr_types;
+      uint64_t num_nodes64 = edge_csr.size(), num_edges64 = edge_csr.num_edges();
+      uint32_t num_namespaces = attr_counts.size() / num_types;
+
+      memcpy(pos, &num_nodes64, sizeof(uint64_t)); pos += sizeof(uint64_t);
+      memcpy(pos, &num_edges64, sizeof(uint64_t)); pos += sizeof(uint64_t);
+      memcpy(pos, &num_namespaces, sizeof(uint32_t)); pos += sizeof(uint32_t);
+      if (attr_counts.size() > 0)
+        {
+          memcpy(pos, attr_counts.data(), attr_counts.size()*sizeof(uint32_t));
+          pos += attr_counts.size()*sizeof(uint32_t);
+        }
+
+      if (num_nodes64 > 0)
+        {
+          memcpy(pos, edge_csr.node_index.data(), num_nodes64*sizeof(NODE_IDX_T));
+          pos += num_nodes64*sizeof(NODE_IDX_T);
+        }
+      for (size_t n = 0; n < num_nodes64; n++)
+        {
+          uint64_t adj_count = edge_csr.adj_offsets[n+1] - edge_csr.adj_offsets[n];
+          memcpy(pos, &adj_count, sizeof(uint64_t));
+          pos += sizeof(uint64_t);
+        }
+      if (num_edges64 > 0)
+        {
+          memcpy(pos, edge_csr.adj_index.data(), num_edges64*sizeof(NODE_IDX_T));
+          pos += num_edges64*sizeof(NODE_IDX_T);
+
+          vector<const char*> columns;
+          vector<size_t> column_sizes;
+          edge_wire_attr_columns(edge_csr.edge_attrs, attr_counts, columns);
+          edge_wire_column_sizes(attr_counts, column_sizes);
+          for (size_t c = 0; c < columns.size(); c++)
+            {
+              memcpy(pos, columns[c], num_edges64*column_sizes[c]);
+              pos += num_edges64*column_sizes[c];
+            }
+        }
+    }
+
+    /*************************************************************************
+     * One sorted input of a k-way merge into a CSR container: either a
+     * received edge block or the previous contents of the container
+     *************************************************************************/
+    struct EdgeMergeSource
+    {
+      size_t num_nodes;
+      const char* nodes;
+      const size_t* adj_offsets;
+      const char* adj;
+      vector<const char*> attr_columns;
+      // adjacency offsets of a received block
+      vector<size_t> block_offsets;
+    };
+
+    /*************************************************************************
+     * Merge received edge blocks, each sorted by node, into a CSR
+     * container with one k-way merge. The output arrays are allocated
+     * once; adjacency lists of a node present in several inputs are
+     * concatenated with the previous contents of the container first,
+     * followed by the blocks in order.
+     *************************************************************************/
+    static void edge_wire_merge_csr (const vector<EdgeWireBlock>& blocks,
+                                     edge_csr_t& edge_csr)
+    {
+      if (blocks.empty())
+        {
+          return;
+        }
+
+      edge_csr_t previous;
+      std::swap(previous, edge_csr);
+
+      // attribute layout of the inputs that have edges
+      vector<uint32_t> attr_counts, previous_attr_counts;
+      bool has_layout = false;
+      size_t num_nodes = previous.size(), num_edges = previous.num_edges();
+      if (previous.num_edges() > 0)
+        {
+          edge_wire_csr_attr_counts(previous.edge_attrs, previous.num_edges(), previous_attr_counts);
+          attr_counts = previous_attr_counts;
+          has_layout = true;
+        }
+      for (const EdgeWireBlock& block : blocks)
+        {
+          if (block.num_edges > 0)
+            {
+              if (has_layout)
+                {
+                  throw_assert(block.attr_counts == attr_counts,
+                               "deserialize_rank_edge_map: edge attribute layout mismatch");
+                }
+              else
+                {
+                  attr_counts = block.attr_counts;
+                  has_layout = true;
+                }
+            }
+          num_nodes += block.num_nodes;
+          num_edges += block.num_edges;
+        }
+
+      vector<size_t> column_sizes;
+      edge_wire_column_sizes(attr_counts, column_sizes);
+
+      vector<EdgeMergeSource> sources;
+      sources.reserve(blocks.size() + 1);
+      if (!previous.empty())
+        {
+          sources.emplace_back();
+          EdgeMergeSource& source = sources.back();
+          source.num_nodes = previous.size();
+          source.nodes = (const char*)previous.node_index.data();
+          source.adj_offsets = previous.adj_offsets.data();
+          source.adj = (const char*)previous.adj_index.data();
+          if (previous.num_edges() > 0)
+            {
+              edge_wire_attr_columns(previous.edge_attrs, previous_attr_counts, source.attr_columns);
+            }
+        }
+      for (const EdgeWireBlock& block : blocks)
+        {
+          sources.emplace_back();
+          EdgeMergeSource& source = sources.back();
+          source.num_nodes = block.num_nodes;
+          source.nodes = block.nodes;
+          source.block_offsets.resize(block.num_nodes+1);
+          source.block_offsets[0] = 0;
+          for (size_t n = 0; n < block.num_nodes; n++)
+            {
+              uint64_t adj_count;
+              memcpy(&adj_count, block.adj_counts + n*sizeof(uint64_t), sizeof(uint64_t));
+              source.block_offsets[n+1] = source.block_offsets[n] + adj_count;
+            }
+          throw_assert(source.block_offsets[block.num_nodes] == block.num_edges,
+                       "deserialize_rank_edge_map: invalid adjacency count");
+          source.adj_offsets = source.block_offsets.data();
+          source.adj = block.adj;
+          if (block.num_edges > 0)
+            {
+              for (size_t j = 0; j < block.attr_counts.size(); j++)
+                {
+                  const size_t type_size = edge_wire_attr_type_size[j % AttrVal::num_attr_types];
+                  for (size_t k = 0; k < block.attr_counts[j]; k++)
+                    {
+                      source.attr_columns.push_back(block.attr_columns[j] + k*block.num_edges*type_size);
+                    }
+                }
+            }
+        }
+
+      // allocate the output arrays once
+      edge_csr.node_index.reserve(num_nodes);
+      edge_csr.adj_offsets.reserve(num_nodes+1);
+      edge_csr.adj_index.resize(num_edges);
+      edge_csr.edge_attrs.resize(attr_counts.size() / AttrVal::num_attr_types);
+      for (size_t i = 0; i < edge_csr.edge_attrs.size(); i++)
+        {
+          const uint32_t* c = &attr_counts[i*AttrVal::num_attr_types];
+          AttrVal& a = edge_csr.edge_attrs[i];
+          a.resize<float>(c[AttrVal::attr_index_float]);
+          a.resize<uint8_t>(c[AttrVal::attr_index_uint8]);
+          a.resize<int8_t>(c[AttrVal::attr_index_int8]);
+          a.resize<uint16_t>(c[AttrVal::attr_index_uint16]);
+          a.resize<int16_t>(c[AttrVal::attr_index_int16]);
+          a.resize<uint32_t>(c[AttrVal::attr_index_uint32]);
+          a.resize<int32_t>(c[AttrVal::attr_index_int32]);
+        }
+      for (size_t i = 0; i < edge_csr.edge_attrs.size(); i++)
+        {
+          AttrVal& a = edge_csr.edge_attrs[i];
+          for (auto& v : a.float_values)  v.resize(num_edges);
+          for (auto& v : a.uint8_values)  v.resize(num_edges);
+          for (auto& v : a.int8_values)   v.resize(num_edges);
+          for (auto& v : a.uint16_values) v.resize(num_edges);
+          for (auto& v : a.int16_values)  v.resize(num_edges);
+          for (auto& v : a.uint32_values) v.resize(num_edges);
+          for (auto& v : a.int32_values)  v.resize(num_edges);
+        }
+      vector<char*> out_columns;
+      edge_wire_attr_columns(edge_csr.edge_attrs, attr_counts, out_columns);
+
+      // k-way merge by node, then by input order
+      typedef pair<NODE_IDX_T, size_t> merge_key_t;
+      priority_queue<merge_key_t, vector<merge_key_t>, greater<merge_key_t> > heap;
+      vector<size_t> cursors(sources.size(), 0);
+      auto source_node = [&] (size_t s)
+        {
+          NODE_IDX_T node;
+          memcpy(&node, sources[s].nodes + cursors[s]*sizeof(NODE_IDX_T), sizeof(NODE_IDX_T));
+          return node;
+        };
+      for (size_t s = 0; s < sources.size(); s++)
+        {
+          if (sources[s].num_nodes > 0)
+            {
+              heap.push(make_pair(source_node(s), s));
+            }
+        }
+
+      size_t edge_pos = 0;
+      char* adj_out = (char*)edge_csr.adj_index.data();
+      while (!heap.empty())
+        {
+          const NODE_IDX_T node = heap.top().first;
+          const size_t s = heap.top().second;
+          heap.pop();
+
+          if (edge_csr.node_index.empty() || (edge_csr.node_index.back() != node))
+            {
+              edge_csr.adj_offsets.push_back(edge_pos);
+              edge_csr.node_index.push_back(node);
+            }
+
+          EdgeMergeSource& source = sources[s];
+          const size_t start = source.adj_offsets[cursors[s]];
+          const size_t count = source.adj_offsets[cursors[s]+1] - start;
+          if (count > 0)
+            {
+              memcpy(adj_out + edge_pos*sizeof(NODE_IDX_T), source.adj + start*sizeof(NODE_IDX_T),
+                     count*sizeof(NODE_IDX_T));
+              for (size_t c = 0; c < out_columns.size(); c++)
+                {
+                  memcpy(out_columns[c] + edge_pos*column_sizes[c],
+                         source.attr_columns[c] + start*column_sizes[c],
+                         count*column_sizes[c]);
+                }
+            }
+          edge_pos += count;
+
+          cursors[s]++;
+          if (cursors[s] < source.num_nodes)
+            {
+              heap.push(make_pair(source_node(s), s));
+            }
+        }
+      if (!edge_csr.node_index.empty())
+        {
+          edge_csr.adj_offsets.push_back(edge_pos);
+        }
+    }
+
+
     void serialize_rank_edge_map (const size_t num_ranks,
                                   const size_t start_rank,
                                   const rank_edge_map_t& prj_rank_edge_map, 
@@ -50,6 +679,7 @@ namespace neuroh5
 
       size_t end_rank = num_ranks;
       throw_assert(start_rank < end_rank, "serialize_rank_edge_map: invalid start rank");
+      throw_assert(sendbuf.empty(), "serialize_rank_edge_map: send buffer is not empty");
       
       // Recommended all-to-all communication pattern: start at the current rank, then wrap around;
       // (as opposed to starting at rank 0)
@@ -62,41 +692,36 @@ namespace neuroh5
           rank_sequence.push_back(key_rank);
         }
 
+      // First pass: attribute layout and exact packed size for each rank
+      vector< vector<uint32_t> > rank_attr_counts(num_ranks);
+      vector<size_t> rank_num_edges(num_ranks, 0);
       size_t sendpos = 0;
-      std::stringstream ss(ios::in | ios::out | ios::binary); 
       for (const rank_t& key_rank : rank_sequence)
         {
           sdispls[key_rank] = sendpos;
+          sendcounts[key_rank] = 0;
           
           auto it1 = prj_rank_edge_map.find(key_rank);
-          if (it1 != prj_rank_edge_map.end())
-            {
-              const edge_map_t edge_map = it1->second;
-              
-              {
-                
-                cereal::BinaryOutputArchive oarchive(ss); // Create an output archive
-                oarchive(edge_map); // Write the data to the archive
-                
-              } // archive goes out of scope, ensuring all contents are flushed
-              ss.seekg(0, ios::end);
-              sendpos = ss.tellg();
-              
-              for (auto it = edge_map.cbegin(); it != edge_map.cend(); ++it)
-                {
-                  const vector<NODE_IDX_T>&  adj_vector = get<0>(it->second);
-                  
-                  num_packed_edges += adj_vector.size();
-                }
+          if ((it1 != prj_rank_edge_map.end()) && (it1->second.size() > 0))
+            {
+              sendcounts[key_rank] = edge_wire_size(it1->second, rank_attr_counts[key_rank],
+                                                    rank_num_edges[key_rank]);
+              num_packed_edges += rank_num_edges[key_rank];
             }
-          sendcounts[key_rank] = sendpos - sdispls[key_rank];
-
+          sendpos += sendcounts[key_rank];
         }
 
-      ss.seekg(0, ios::beg);
-      const string& sstr = ss.str();
-      copy(sstr.begin(), sstr.end(), back_inserter(sendbuf));
-      
+      // Second pass: pack each edge map directly into the send buffer
+      sendbuf.resize(sendpos);
+      for (const rank_t& key_rank : rank_sequence)
+        {
+          if (sendcounts[key_rank] > 0)
+            {
+              auto it1 = prj_rank_edge_map.find(key_rank);
+              edge_wire_pack(it1->second, rank_attr_counts[key_rank],
+                             rank_num_edges[key_rank], &sendbuf[sdispls[key_rank]]);
+            }
+        }
     }
 
     void serialize_edge_map (const edge_map_t& edge_map, 
@@ -123,6 +748,20 @@ namespace neuroh5
     }
 
 
+    void serialize_edge_map (const edge_csr_t& edge_csr, 
+                             size_t &num_packed_edges,
+                             vector<char> &sendbuf)
+    {
+      vector<uint32_t> attr_counts;
+      size_t packed_size = edge_wire_csr_size(edge_csr, attr_counts);
+
+      size_t sendpos = sendbuf.size();
+      sendbuf.resize(sendpos + packed_size);
+      edge_wire_pack_csr(edge_csr, attr_counts, &sendbuf[sendpos]);
+      num_packed_edges += edge_csr.num_edges();
+    }
+
+
     void deserialize_rank_edge_map (const size_t num_ranks,
                                     const vector<char> &recvbuf,
                                     const vector<size_t>& recvcounts,
@@ -140,49 +779,41 @@ namespace neuroh5
             {
               size_t recvsize  = recvcounts[ridx];
               size_t recvpos   = rdispls[ridx];
-              size_t startpos  = recvpos;
-              edge_map_t edge_map;
 
-              throw_assert(recvpos < recvbuf_size,
+              throw_assert(recvpos + recvsize <= recvbuf_size,
                            "deserialize_rank_edge_map: invalid buffer displacement");
 
+              EdgeWireBlock block;
+              edge_wire_unpack_header(&recvbuf[recvpos], recvsize, block);
 
-              {
-                const string& s = string(recvbuf.begin()+startpos, recvbuf.begin()+startpos+recvsize);
-                stringstream ss(s, ios::in | ios::out | ios::binary);
-
-                cereal::BinaryInputArchive iarchive(ss); // Create an input archive
-                
-                iarchive(edge_map); // Read the data from the archive
-              }
-              
-              for (auto it = edge_map.cbegin(); it != edge_map.cend(); ++it)
+              size_t edge_pos = 0;
+              for (size_t n = 0; n < block.num_nodes; n++)
                 {
-                  NODE_IDX_T key_node = it->first;
-                  const vector<NODE_IDX_T>&  adj_vector = get<0>(it->second);
-                  const vector<data::AttrVal>&    edge_attr_values = get<1>(it->second);
-                  num_unpacked_edges += adj_vector.size();
-                  
-                  if (prj_edge_map.find(key_node) == prj_edge_map.end())
+                  NODE_IDX_T key_node; uint64_t adj_count;
+                  memcpy(&key_node, block.nodes + n*sizeof(NODE_IDX_T), sizeof(NODE_IDX_T));
+                  memcpy(&adj_count, block.adj_counts + n*sizeof(uint64_t), sizeof(uint64_t));
+                  throw_assert(edge_pos + adj_count <= block.num_edges,
+                               "deserialize_rank_edge_map: invalid adjacency count");
+
+                  auto it = prj_edge_map.find(key_node);
+                  if (it == prj_edge_map.end())
                     {
                       num_unpacked_nodes ++;
-                      prj_edge_map.insert(make_pair(key_node,make_tuple(adj_vector, edge_attr_values)));
+                      it = prj_edge_map.insert(make_pair(key_node, edge_tuple_t())).first;
                     }
-                  else
+                  vector<NODE_IDX_T> &v = get<0>(it->second);
+                  size_t v_size = v.size();
+                  v.resize(v_size + adj_count);
+                  if (adj_count > 0)
                     {
-                      edge_tuple_t et = prj_edge_map[key_node];
-                      vector<NODE_IDX_T> &v = get<0>(et);
-                      vector <data::AttrVal> &va = get<1>(et);
-                      v.insert(v.end(),adj_vector.begin(),adj_vector.end());
-                      size_t ni=0;
-                      for (auto & a : va)
-                        {
-                          a.append(edge_attr_values[ni]);
-                          ni++;
-                        }
-                      prj_edge_map[key_node] = make_tuple(v,va);
+                      memcpy(&v[v_size], block.adj + edge_pos*sizeof(NODE_IDX_T),
+                             adj_count*sizeof(NODE_IDX_T));
                     }
+                  edge_wire_unpack_attrs(block, edge_pos, adj_count, get<1>(it->second));
+                  
+                  edge_pos += adj_count;
                 }
+              num_unpacked_edges += block.num_edges;
             }
         }
     }
@@ -236,5 +867,55 @@ namespace neuroh5
         }
     }
 
+
+    void deserialize_rank_edge_map (const size_t num_ranks,
+                                    const vector<char> &recvbuf,
+                                    const vector<size_t>& recvcounts,
+                                    const vector<size_t>& rdispls,
+                                    edge_csr_t& prj_edge_csr,
+                                    size_t& num_unpacked_nodes,
+                                    size_t& num_unpacked_edges
+                                    )
+    {
+      const size_t recvbuf_size = recvbuf.size();
+      vector<EdgeWireBlock> blocks;
+
+      for (size_t ridx = 0; ridx < num_ranks; ridx++)
+        {
+          if (recvcounts[ridx] > 0)
+            {
+              size_t recvsize  = recvcounts[ridx];
+              size_t recvpos   = rdispls[ridx];
+
+              throw_assert(recvpos + recvsize <= recvbuf_size,
+                           "deserialize_rank_edge_map: invalid buffer displacement");
+
+              blocks.emplace_back();
+              edge_wire_unpack_header(&recvbuf[recvpos], recvsize, blocks.back());
+            }
+        }
+
+      size_t num_nodes_before = prj_edge_csr.size();
+      size_t num_edges_before = prj_edge_csr.num_edges();
+      edge_wire_merge_csr(blocks, prj_edge_csr);
+      num_unpacked_nodes += prj_edge_csr.size() - num_nodes_before;
+      num_unpacked_edges += prj_edge_csr.num_edges() - num_edges_before;
+    }
+
+    
+    void deserialize_edge_map (const vector<char> &recvbuf,
+                               edge_csr_t& prj_edge_csr,
+                               size_t& num_unpacked_nodes,
+                               size_t& num_unpacked_edges
+                               )
+    {
+      vector<EdgeWireBlock> blocks(1);
+      edge_wire_unpack_header(recvbuf.data(), recvbuf.size(), blocks[0]);
+
+      num_unpacked_nodes = blocks[0].num_nodes;
+      num_unpacked_edges = blocks[0].num_edges;
+      edge_wire_merge_csr(blocks, prj_edge_csr);
+    }
+
   }
 }
@@ -168,5 +168,87 @@ namespace neuroh5
         }
     }
 
+
+    void serialize_rank_tree_arena (const size_t num_ranks,
+                                    const size_t start_rank,
+                                    const map <rank_t, TreeArena>& rank_tree_arena,
+                                    vector<size_t>& sendcounts,
+                                    vector<char> &sendbuf,
+                                    vector<size_t> &sdispls)
+    {
+      sdispls.resize(num_ranks);
+      sendcounts.resize(num_ranks);
+
+      rank_t end_rank = num_ranks;
+      throw_assert(start_rank < end_rank, "serialize_rank_tree_arena: invalid start rank");
+
+      vector<rank_t> rank_sequence;
+      for (rank_t key_rank = start_rank; key_rank < end_rank; key_rank++)
+        {
+          rank_sequence.push_back(key_rank);
+        }
+      for (rank_t key_rank = 0; key_rank < start_rank; key_rank++)
+        {
+          rank_sequence.push_back(key_rank);
+        }
+
+      size_t sendpos = 0;
+      std::stringstream ss(ios::in | ios::out | ios::binary);
+      for (const rank_t& key_rank : rank_sequence)
+        {
+          sdispls[key_rank] = sendpos;
+
+          auto it1 = rank_tree_arena.find(key_rank);
+          if (it1 != rank_tree_arena.end())
+            {
+              {
+                cereal::BinaryOutputArchive oarchive(ss);
+                oarchive(it1->second);
+              }
+              ss.seekg(0, ios::end);
+              sendpos = ss.tellg();
+            }
+
+          sendcounts[key_rank] = sendpos - sdispls[key_rank];
+        }
+      ss.seekg(0, ios::beg);
+      const string& sstr = ss.str();
+      sendbuf.reserve(sendbuf.size() + sstr.size());
+      copy(sstr.begin(), sstr.end(), back_inserter(sendbuf));
+    }
+
+
+    void deserialize_rank_tree_arena (const size_t num_ranks,
+                                      const vector<char> &recvbuf,
+                                      const vector<size_t>& recvcounts,
+                                      const vector<size_t>& rdispls,
+                                      TreeArena &all_trees)
+    {
+      const size_t recvbuf_size = recvbuf.size();
+
+      for (size_t ridx = 0; ridx < num_ranks; ridx++)
+        {
+          if (recvcounts[ridx] > 0)
+            {
+              size_t recvsize  = recvcounts[ridx];
+              size_t startpos  = rdispls[ridx];
+              TreeArena trees;
+
+              throw_assert(startpos < recvbuf_size,
+                           "deserialize_rank_tree_arena: invalid buffer displacement");
+
+              {
+                const string& s = string(recvbuf.begin()+startpos, recvbuf.begin()+startpos+recvsize);
+                stringstream ss(s, ios::in | ios::out | ios::binary);
+
+                cereal::BinaryInputArchive iarchive(ss);
+                iarchive(trees);
+              }
+
+              all_trees.append(trees);
+            }
+        }
+    }
+
   }
 }
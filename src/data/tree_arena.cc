@@ -0,0 +1,170 @@
+// -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+//==============================================================================
+///  @file tree_arena.cc
+///
+///  Tree morphologies stored in one contiguous buffer.
+///
+///  Copyright (C) 2016-2025 Project NeuroH5.
+//==============================================================================
+
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "tree_arena.hh"
+#include "path_names.hh"
+#include "throw_assert.hh"
+
+using namespace std;
+
+namespace neuroh5
+{
+
+  namespace data
+  {
+
+    // Column blocks start at multiples of the largest value size
+    static const size_t column_alignment = 8;
+
+    static const string column_names[TreeArena::num_columns] =
+      {
+        hdf5::SRCSEC, hdf5::DSTSEC, hdf5::SECTION,
+        hdf5::X_COORD, hdf5::Y_COORD, hdf5::Z_COORD,
+        hdf5::RADIUS, hdf5::LAYER, hdf5::PARENT, hdf5::SWCTYPE
+      };
+
+    static size_t aligned_size (size_t n)
+    {
+      return ((n + column_alignment - 1) / column_alignment) * column_alignment;
+    }
+
+
+    void TreeArena::assign (const NamedColumnarAttrMap& attr_values,
+                            const vector<CELL_IDX_T>& cells)
+    {
+      clear();
+      index = cells;
+
+      // 1. Locate the values of each tree and compute the block sizes
+      array<vector<const char*>, num_columns> sources;
+      size_t storage_size = 0;
+      for_each_column([&] (size_t c, auto type_ptr)
+                      {
+                        typedef typename std::remove_pointer<decltype(type_ptr)>::type T;
+                        ptr[c].resize(cells.size()+1);
+                        ptr[c][0] = 0;
+                        sources[c].resize(cells.size());
+                        for (size_t i = 0; i < cells.size(); i++)
+                          {
+                            AttrSpan<T> v = attr_values.find_name<T>(column_names[c], cells[i]);
+                            sources[c][i] = reinterpret_cast<const char*>(v.begin());
+                            ptr[c][i+1] = ptr[c][i] + v.size();
+                          }
+                        offsets[c] = storage_size;
+                        storage_size = aligned_size(storage_size + ptr[c].back() * sizeof(T));
+                      });
+
+      // 2. Copy the values into the buffer
+      storage.resize(storage_size);
+      for_each_column([&] (size_t c, auto type_ptr)
+                      {
+                        typedef typename std::remove_pointer<decltype(type_ptr)>::type T;
+                        char* dst = storage.data() + offsets[c];
+                        for (size_t i = 0; i < cells.size(); i++)
+                          {
+                            const size_t count = (ptr[c][i+1] - ptr[c][i]) * sizeof(T);
+                            if (count > 0)
+                              {
+                                memcpy(dst + ptr[c][i] * sizeof(T), sources[c][i], count);
+                              }
+                          }
+                      });
+    }
+
+
+    void TreeArena::append (const TreeArena& other)
+    {
+      if (other.size() == 0)
+        return;
+      if (size() == 0)
+        {
+          *this = other;
+          return;
+        }
+
+      array<size_t, num_columns> new_offsets;
+      size_t storage_size = 0;
+      for_each_column([&] (size_t c, auto type_ptr)
+                      {
+                        typedef typename std::remove_pointer<decltype(type_ptr)>::type T;
+                        new_offsets[c] = storage_size;
+                        storage_size = aligned_size(storage_size + (ptr[c].back() + other.ptr[c].back()) * sizeof(T));
+                      });
+
+      vector<char> new_storage(storage_size);
+      for_each_column([&] (size_t c, auto type_ptr)
+                      {
+                        typedef typename std::remove_pointer<decltype(type_ptr)>::type T;
+                        const size_t count = ptr[c].back() * sizeof(T);
+                        const size_t other_count = other.ptr[c].back() * sizeof(T);
+                        char* dst = new_storage.data() + new_offsets[c];
+                        if (count > 0)
+                          memcpy(dst, storage.data() + offsets[c], count);
+                        if (other_count > 0)
+                          memcpy(dst + count, other.storage.data() + other.offsets[c], other_count);
+
+                        const ATTR_PTR_T base = ptr[c].back();
+                        ptr[c].reserve(ptr[c].size() + other.size());
+                        for (size_t i = 1; i < other.ptr[c].size(); i++)
+                          {
+                            ptr[c].push_back(base + other.ptr[c][i]);
+                          }
+                      });
+
+      index.insert(index.end(), other.index.cbegin(), other.index.cend());
+      offsets = new_offsets;
+      storage.swap(new_storage);
+    }
+
+
+    neurotree_t TreeArena::tree (size_t i) const
+    {
+      neurotree_t result;
+      get<0>(result) = index[i];
+      AttrSpan<SECTION_IDX_T> src_vector = values<SECTION_IDX_T>(col_src_sec, i);
+      AttrSpan<SECTION_IDX_T> dst_vector = values<SECTION_IDX_T>(col_dst_sec, i);
+      AttrSpan<SECTION_IDX_T> sections = values<SECTION_IDX_T>(col_sections, i);
+      AttrSpan<COORD_T> xcoords = values<COORD_T>(col_x, i);
+      AttrSpan<COORD_T> ycoords = values<COORD_T>(col_y, i);
+      AttrSpan<COORD_T> zcoords = values<COORD_T>(col_z, i);
+      AttrSpan<REALVAL_T> radiuses = values<REALVAL_T>(col_radius, i);
+      AttrSpan<LAYER_IDX_T> layers = values<LAYER_IDX_T>(col_layer, i);
+      AttrSpan<PARENT_NODE_IDX_T> parents = values<PARENT_NODE_IDX_T>(col_parent, i);
+      AttrSpan<SWC_TYPE_T> swc_types = values<SWC_TYPE_T>(col_swc_type, i);
+      get<1>(result).assign(src_vector.begin(), src_vector.end());
+      get<2>(result).assign(dst_vector.begin(), dst_vector.end());
+      get<3>(result).assign(sections.begin(), sections.end());
+      get<4>(result).assign(xcoords.begin(), xcoords.end());
+      get<5>(result).assign(ycoords.begin(), ycoords.end());
+      get<6>(result).assign(zcoords.begin(), zcoords.end());
+      get<7>(result).assign(radiuses.begin(), radiuses.end());
+      get<8>(result).assign(layers.begin(), layers.end());
+      get<9>(result).assign(parents.begin(), parents.end());
+      get<10>(result).assign(swc_types.begin(), swc_types.end());
+      return result;
+    }
+
+
+    void TreeArena::clear ()
+    {
+      index.clear();
+      for (size_t c = 0; c < num_columns; c++)
+        {
+          ptr[c].assign(1, 0);
+          offsets[c] = 0;
+        }
+      storage.clear();
+    }
+  }
+}
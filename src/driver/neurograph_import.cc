@@ -17,6 +17,7 @@
 #include "read_txt_projection.hh"
 #include "rank_range.hh"
 #include "write_graph.hh"
+#include "dataset_filters.hh"
 #include "attr_map.hh"
 #include "attr_val.hh"
 #include "tokenize.hh"
@@ -70,6 +71,10 @@ void print_usage_full(char** argv)
   printf("\t\tImport from given file\n");
   printf("\t-f <FORMAT>:\n");
   printf("\t\tInput format\n");
+  printf("\t--filter=<ROLE>=<FILTER>[,<FILTER>...]:\n");
+  printf("\t\tFilters for the index, pointer, value or all datasets;\n");
+  printf("\t\tFILTER is one of none, shuffle, delta, deflate:<LEVEL>;\n");
+  printf("\t\tshuffle and delta cannot be combined\n");
 
 }
   
@@ -310,6 +315,8 @@ int main(int argc, char** argv)
   int optflag_input_format = 0;
   int optflag_dst_offset   = 0;
   int optflag_src_offset   = 0;
+  int optflag_filter       = 0;
+  FilterConfig filters = hdf5::default_filter_config();
   bool opt_attr_names = false;
   bool opt_io_size    = false;
   bool opt_txt        = false;
@@ -324,6 +331,7 @@ int main(int argc, char** argv)
     {"format",        required_argument, &optflag_input_format,  1 },
     {"io-size",       required_argument, &optflag_io_size,  1 },
     {"attributes",    required_argument, &optflag_attr_names,  1 },
+    {"filter",        required_argument, &optflag_filter,  1 },
     {0,         0,                 0,  0 }
   };
   char c;
@@ -410,6 +418,10 @@ int main(int argc, char** argv)
             ss >> src_offset;
             optflag_src_offset=0;
           }
+          if (optflag_filter == 1) {
+            hdf5::parse_filter_spec(string(optarg), filters);
+            optflag_filter=0;
+          }
           if (optflag_input_format == 1) {
             string input_format = string(optarg);
             if (input_format == "hdf5:syn")
@@ -622,19 +634,32 @@ int main(int argc, char** argv)
   map <string, data::AttrVal> edge_attrs;
   if (opt_txt)
     {
-      // determine which connection files are read by which rank
-      vector< pair<hsize_t,hsize_t> > ranges;
-      mpi::rank_ranges(txt_input_file_names.size(), size, ranges);
+      if (txt_input_file_names.size() >= (size_t)size)
+        {
+          // determine which connection files are read by which rank
+          vector< pair<hsize_t,hsize_t> > ranges;
+          mpi::rank_ranges(txt_input_file_names.size(), size, ranges);
       
-      hsize_t start=ranges[rank].first, end=ranges[rank].first+ranges[rank].second;
+          hsize_t start=ranges[rank].first, end=ranges[rank].first+ranges[rank].second;
 
-      for (size_t i=start; i<end; i++)
-        {
-          string txt_input_file_name = txt_input_file_names[i];
+          for (size_t i=start; i<end; i++)
+            {
+              string txt_input_file_name = txt_input_file_names[i];
           
-          status = io::read_txt_projection (txt_input_file_name, num_edge_attrs,
-                                            dst_idx, src_idx_ptr, src_idx,
-                                            edge_attrs);
+              status = io::read_txt_projection (txt_input_file_name, num_edge_attrs,
+                                                dst_idx, src_idx_ptr, src_idx,
+                                                edge_attrs);
+            }
+        }
+      else
+        {
+          // fewer files than ranks: each rank reads a byte range of every file
+          for (const string& txt_input_file_name : txt_input_file_names)
+            {
+              status = io::read_txt_projection (all_comm, txt_input_file_name, num_edge_attrs,
+                                                dst_idx, src_idx_ptr, src_idx,
+                                                edge_attrs);
+            }
         }
     }
 
@@ -681,7 +706,8 @@ int main(int argc, char** argv)
 
   status = graph::write_graph (all_comm, io_size, output_file_name,
                                src_pop_name, dst_pop_name,
-                               edge_attr_index, edge_map);
+                               edge_attr_index, edge_map,
+                               4096, false, filters);
 
   MPI_Comm_free(&all_comm);
   
@@ -0,0 +1,133 @@
+// -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+//==============================================================================
+///  @file neurograph_index.cc
+///
+///  Driver program for building the destination lookup index of
+///  projections, used by selection reads.
+///
+///  Copyright (C) 2016-2024 Project NeuroH5.
+//==============================================================================
+
+
+#include "debug.hh"
+
+#include "neuroh5_types.hh"
+#include "projection_names.hh"
+#include "projection_index.hh"
+#include "throw_assert.hh"
+
+#include <mpi.h>
+
+#include <getopt.h>
+
+#include <iostream>
+
+using namespace std;
+using namespace neuroh5;
+
+void throw_err(char const* err_message)
+{
+  fprintf(stderr, "Error: %s\n", err_message);
+  MPI_Abort(MPI_COMM_WORLD, 1);
+}
+
+
+void print_usage_full(char** argv)
+{
+  printf("Usage: %s [graphfile] [options]\n\n", argv[0]);
+  printf("Options:\n");
+  printf("\t-s <source population>:\n");
+  printf("\t\tIndex only projections from this population\n");
+  printf("\t-d <destination population>:\n");
+  printf("\t\tIndex only projections to this population\n");
+  printf("\t--verbose:\n");
+  printf("\t\tPrint verbose diagnostic information\n");
+}
+
+
+/*****************************************************************************
+ * Main driver
+ *****************************************************************************/
+
+int main(int argc, char** argv)
+{
+  string input_file_name, opt_src_pop_name, opt_dst_pop_name;
+
+  throw_assert(MPI_Init(&argc, &argv) >= 0,
+               "neurograph_index: error in MPI initialization");
+
+  int rank;
+  throw_assert(MPI_Comm_rank(MPI_COMM_WORLD, &rank) == MPI_SUCCESS,
+               "neurograph_index: error in MPI_Comm_rank");
+
+  debug_enabled = false;
+
+  // parse arguments
+  int optflag_verbose = 0;
+  static struct option long_options[] = {
+    {"verbose",  no_argument, &optflag_verbose,  1 },
+    {0,         0,                 0,  0 }
+  };
+  char c;
+  int option_index = 0;
+  while ((c = getopt_long (argc, argv, "d:hs:",
+                           long_options, &option_index)) != -1)
+    {
+      switch (c)
+        {
+        case 0:
+          if (optflag_verbose == 1) {
+            debug_enabled = true;
+            optflag_verbose = 0;
+          }
+          break;
+        case 'd':
+          opt_dst_pop_name = string(optarg);
+          break;
+        case 's':
+          opt_src_pop_name = string(optarg);
+          break;
+        case 'h':
+          print_usage_full(argv);
+          exit(0);
+          break;
+        default:
+          throw_err("Input argument format error");
+        }
+    }
+
+  if (optind < argc)
+    {
+      input_file_name = string(argv[optind]);
+    }
+  else
+    {
+      print_usage_full(argv);
+      exit(1);
+    }
+
+  vector< pair<string, string> > prj_names;
+  throw_assert(graph::read_projection_names(MPI_COMM_WORLD, input_file_name,
+                                            prj_names) >= 0,
+               "neurograph_index: error in reading projection names");
+
+  for (const auto& prj_name : prj_names)
+    {
+      if ((!opt_src_pop_name.empty()) && (prj_name.first != opt_src_pop_name))
+        continue;
+      if ((!opt_dst_pop_name.empty()) && (prj_name.second != opt_dst_pop_name))
+        continue;
+
+      throw_assert(hdf5::write_projection_index(MPI_COMM_WORLD, input_file_name,
+                                                prj_name.first, prj_name.second) >= 0,
+                   "neurograph_index: error in indexing projection " <<
+                   prj_name.first << " -> " << prj_name.second);
+      if (rank == 0)
+        {
+          printf("Indexed projection %s -> %s\n", prj_name.first.c_str(), prj_name.second.c_str());
+        }
+    }
+
+  MPI_Finalize();
+  return 0;
+}
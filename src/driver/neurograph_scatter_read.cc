@@ -15,6 +15,7 @@
 #include "read_graph.hh"
 #include "scatter_read_graph.hh"
 #include "projection_names.hh"
+#include "rank_map.hh"
 #include "throw_assert.hh"
 
 #include <mpi.h>
@@ -64,7 +65,7 @@ int main(int argc, char** argv)
   // MPI Communicator for I/O ranks
   MPI_Comm all_comm;
   // A vector that maps nodes to compute ranks
-  node_rank_map_t node_rank_map;
+  data::NodeRankMap node_rank_map;
   pop_range_map_t pop_ranges;
   vector<pair<string,string>> prj_names;
   vector < edge_map_t > prj_vector;
@@ -76,7 +77,10 @@ int main(int argc, char** argv)
                "neurograph_scatter_read: error in MPI initialization");
 
   EdgeMapType edge_map_type = EdgeMapDst;
+  ProjectionPtrReadMode ptr_read_mode = PtrReadRoot;
+  ProjectionBlockAssignment block_assignment = BlockAssignEven;
   int rank, size, io_size; size_t n_nodes, local_num_nodes;
+  size_t pipeline_depth = 0;
   size_t local_num_edges, total_num_edges;
   throw_assert(MPI_Comm_size(MPI_COMM_WORLD, &size) == MPI_SUCCESS,
                "neurograph_scatter_read: error in MPI_Comm_size");
@@ -92,6 +96,9 @@ int main(int argc, char** argv)
   int optflag_rankfile = 0;
   int optflag_iosize = 0;
   int optflag_edgemap = 0;
+  int optflag_ptrread = 0;
+  int optflag_blockassign = 0;
+  int optflag_pipeline = 0;
   bool opt_binary = false,
     opt_rankfile = false,
     opt_iosize = false,
@@ -106,6 +113,9 @@ int main(int argc, char** argv)
     {"rankfile",  required_argument, &optflag_rankfile,  1 },
     {"iosize",    required_argument, &optflag_iosize,  1 },
     {"edgemap",   required_argument, &optflag_edgemap,  1 },
+    {"ptrread",   required_argument, &optflag_ptrread,  1 },
+    {"blockassign", required_argument, &optflag_blockassign,  1 },
+    {"pipeline",  required_argument, &optflag_pipeline,  1 },
     {0,         0,                 0,  0 }
   };
   char c;
@@ -152,6 +162,34 @@ int main(int argc, char** argv)
               }
             optflag_edgemap = 0;
           }
+          if (optflag_ptrread == 1) {
+            if (string(optarg) == "root")
+              {
+                ptr_read_mode = PtrReadRoot;
+              }
+            if (string(optarg) == "distributed")
+              {
+                ptr_read_mode = PtrReadDistributed;
+              }
+            optflag_ptrread = 0;
+          }
+          if (optflag_blockassign == 1) {
+            if (string(optarg) == "even")
+              {
+                block_assignment = BlockAssignEven;
+              }
+            if (string(optarg) == "edges")
+              {
+                block_assignment = BlockAssignEdgeWeighted;
+              }
+            optflag_blockassign = 0;
+          }
+          if (optflag_pipeline == 1) {
+            ss.clear();
+            ss << string(optarg);
+            ss >> pipeline_depth;
+            optflag_pipeline = 0;
+          }
           break;
         case 'a':
           {
@@ -219,17 +257,14 @@ int main(int argc, char** argv)
   // Determine which nodes are assigned to which compute ranks
   if (!opt_rankfile)
     {
-      // round-robin node to rank assignment from file
-      for (size_t i = 0; i < n_nodes; i++)
-        {
-          node_rank_map[i].insert(i%size);
-        }
+      // round-robin node to rank assignment
+      node_rank_map = data::NodeRankMap::round_robin(size, 0, n_nodes);
     }
   else
     {
       ifstream infile(rank_file_name.c_str());
       string line;
-      size_t i = 0;
+      vector<rank_t> node_ranks;
       // reads node to rank assignment from file
       while (getline(infile, line))
         {
@@ -239,11 +274,11 @@ int main(int argc, char** argv)
           throw_assert (iss >> n,
                         "neurograph_scatter_read: invalid entry in node to rank assignment file");
 
-          node_rank_map[i].insert(n);
-          i++;
+          node_ranks.push_back(n);
         }
 
       infile.close();
+      node_rank_map = data::NodeRankMap::flat(0, std::move(node_ranks));
     }
 
   DEBUG("scatter: reading projection names");
@@ -268,7 +303,10 @@ int main(int argc, char** argv)
                              local_num_nodes,
                              n_nodes,
                              local_num_edges,
-                             total_num_edges);
+                             total_num_edges,
+                             ptr_read_mode,
+                             block_assignment,
+                             pipeline_depth);
 
 
   if (opt_output)
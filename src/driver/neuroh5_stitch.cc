@@ -0,0 +1,140 @@
+// -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+//==============================================================================
+///  @file neuroh5_stitch.cc
+///
+///  Driver program for merging the subfiles written in subfile mode into
+///  the output file.
+///
+///  Copyright (C) 2016-2025 Project NeuroH5.
+//==============================================================================
+
+
+#include "debug.hh"
+
+#include "neuroh5_types.hh"
+#include "dataset_filters.hh"
+#include "subfiles.hh"
+#include "stitch_graph.hh"
+#include "stitch_cell_attributes.hh"
+#include "throw_assert.hh"
+
+#include <mpi.h>
+
+#include <getopt.h>
+
+#include <iostream>
+
+using namespace std;
+using namespace neuroh5;
+
+void throw_err(char const* err_message)
+{
+  fprintf(stderr, "Error: %s\n", err_message);
+  MPI_Abort(MPI_COMM_WORLD, 1);
+}
+
+
+void print_usage_full(char** argv)
+{
+  printf("Usage: %s [outputfile] [options]\n\n", argv[0]);
+  printf("Options:\n");
+  printf("\t-r:\n");
+  printf("\t\tRemove the subfiles after they have been merged\n");
+  printf("\t--filter=<ROLE>=<FILTER>[,<FILTER>...]:\n");
+  printf("\t\tFilters for the index, pointer, value or all merged datasets;\n");
+  printf("\t\tFILTER is one of none, shuffle, delta, deflate:<LEVEL>;\n");
+  printf("\t\tshuffle and delta cannot be combined\n");
+  printf("\t--verbose:\n");
+  printf("\t\tPrint verbose diagnostic information\n");
+}
+
+
+/*****************************************************************************
+ * Main driver
+ *****************************************************************************/
+
+int main(int argc, char** argv)
+{
+  string output_file_name;
+  FilterConfig filters = hdf5::default_filter_config();
+
+  throw_assert(MPI_Init(&argc, &argv) >= 0,
+               "neuroh5_stitch: error in MPI initialization");
+
+  int rank;
+  throw_assert(MPI_Comm_rank(MPI_COMM_WORLD, &rank) == MPI_SUCCESS,
+               "neuroh5_stitch: error in MPI_Comm_rank");
+
+  debug_enabled = false;
+
+  // parse arguments
+  int optflag_verbose = 0;
+  int optflag_filter = 0;
+  bool opt_remove = false;
+  static struct option long_options[] = {
+    {"verbose",  no_argument, &optflag_verbose,  1 },
+    {"filter",   required_argument, &optflag_filter,  1 },
+    {0,         0,                 0,  0 }
+  };
+  char c;
+  int option_index = 0;
+  while ((c = getopt_long (argc, argv, "hr",
+                           long_options, &option_index)) != -1)
+    {
+      switch (c)
+        {
+        case 0:
+          if (optflag_verbose == 1) {
+            debug_enabled = true;
+            optflag_verbose = 0;
+          }
+          if (optflag_filter == 1) {
+            hdf5::parse_filter_spec(string(optarg), filters);
+            optflag_filter = 0;
+          }
+          break;
+        case 'r':
+          opt_remove = true;
+          break;
+        case 'h':
+          print_usage_full(argv);
+          exit(0);
+          break;
+        default:
+          throw_err("Input argument format error");
+        }
+    }
+
+  if (optind < argc)
+    {
+      output_file_name = string(argv[optind]);
+    }
+  else
+    {
+      print_usage_full(argv);
+      exit(1);
+    }
+
+  size_t num_subfiles = 0;
+  throw_assert(hdf5::num_subfiles(MPI_COMM_WORLD, output_file_name, num_subfiles) >= 0,
+               "neuroh5_stitch: error in determining the number of subfiles");
+  if (rank == 0)
+    {
+      printf("Merging %lu subfiles into %s\n", num_subfiles, output_file_name.c_str());
+    }
+
+  throw_assert(graph::stitch_graph_subfiles(MPI_COMM_WORLD, output_file_name,
+                                            4096, filters) >= 0,
+               "neuroh5_stitch: error in merging projections");
+  cell::stitch_cell_attribute_subfiles(MPI_COMM_WORLD, output_file_name,
+                                       4000, 4000, 1*1024*1024, filters);
+
+  if (opt_remove)
+    {
+      throw_assert(hdf5::remove_subfiles(MPI_COMM_WORLD, output_file_name) >= 0,
+                   "neuroh5_stitch: error in removing subfiles");
+    }
+
+  MPI_Finalize();
+  return 0;
+}
@@ -74,6 +74,10 @@ void print_usage_full(char** argv)
     "-t SWCTYPE Specify default SWC type (indicates that input SWC has layer info instead of type) " << endl <<
     "-y OFFSET  Specify layer offset " << endl <<
     "-i FILE    Read given SWC file and prepend its points into every read file " << endl <<
+    "-q PRECISION  Store coordinates and radii quantized with the given absolute precision " << endl <<
+    endl <<
+    "The point ids of each SWC file must be consecutive, starting from the id" << endl <<
+    "of the first point (e.g. 0 or 1); files with gaps in the ids are rejected." << endl <<
     endl;
 }
 
@@ -116,13 +120,14 @@ int main(int argc, char** argv)
   bool opt_idfilelist     = false;
   bool opt_singleton      = false;
   bool opt_include        = false;
+  TreeEncoding encoding;
   // parse arguments
   static struct option long_options[] = {
     {0,         0,                 0,  0 }
   };
   char c;
   int option_index = 0;
-  while ((c = getopt_long (argc, argv, "hd:e:i:o:r:t:l:n:sy:", long_options, &option_index)) != -1)
+  while ((c = getopt_long (argc, argv, "hd:e:i:o:q:r:t:l:n:sy:", long_options, &option_index)) != -1)
     {
       stringstream ss;
       switch (c)
@@ -145,6 +150,11 @@ int main(int argc, char** argv)
           ss << string(optarg);
           ss >> include_layer;
           break;
+        case 'q':
+          encoding.type = TreeQuantized;
+          ss << string(optarg);
+          ss >> encoding.precision;
+          break;
         case 'r':
           opt_singleton = true;
           singleton_filename = string(optarg);
@@ -343,7 +353,8 @@ int main(int argc, char** argv)
 
   MPI_Barrier(all_comm);
 
-  status = cell::append_trees(all_comm, output_file_name, pop_name, 0, tree_list, size);
+  status = cell::append_trees(all_comm, output_file_name, pop_name, 0, tree_list, size,
+                              4000, 4000, encoding);
   throw_assert(status == 0,
                "neurotrees_import: error in appending trees to HDF5 file");
              
@@ -29,6 +29,7 @@
 #include "validate_tree.hh"
 #include "attr_map.hh"
 #include "tokenize.hh"
+#include "rank_map.hh"
 #include "throw_assert.hh"
 
 using namespace std;
@@ -238,7 +239,7 @@ int main(int argc, char** argv)
   std::string input_file_name, rank_file_name;
   vector<string> attr_name_spaces;
   size_t n_nodes;
-  map<CELL_IDX_T, set<rank_t>> node_rank_map;
+  data::NodeRankMap node_rank_map;
   stringstream ss;
 
   throw_assert(MPI_Init(&argc, &argv) >= 0,
@@ -366,17 +367,14 @@ int main(int argc, char** argv)
   // Determine which nodes are assigned to which compute ranks
   if (!opt_rankfile)
     {
-      // round-robin node to rank assignment from file
-      for (size_t i = 0; i < n_nodes; i++)
-        {
-          node_rank_map[i].insert(i%size);
-        }
+      // round-robin node to rank assignment
+      node_rank_map = data::NodeRankMap::round_robin(size, 0, n_nodes);
     }
   else
     {
       ifstream infile(rank_file_name.c_str());
       string line;
-      size_t i = 0;
+      vector<rank_t> node_ranks;
       // reads node to rank assignment from file
       while (getline(infile, line))
         {
@@ -386,11 +384,11 @@ int main(int argc, char** argv)
           throw_assert (iss >> n,
                         "neurotrees_scatter_read: invalid entry on node to rank assignment file"); 
 
-          node_rank_map[i].insert(n);
-          i++;
+          node_ranks.push_back(n);
         }
 
       infile.close();
+      node_rank_map = data::NodeRankMap::flat(0, std::move(node_ranks));
     }
 
   map<CELL_IDX_T, neurotree_t>  tree_map;
@@ -40,6 +40,7 @@
 #include "create_file_toplevel.hh"
 #include "exists_tree_h5types.hh"
 #include "copy_tree_h5types.hh"
+#include "file_access.hh"
 #include "throw_assert.hh"
 
 using namespace std;
@@ -576,9 +577,7 @@ int main(int argc, char** argv)
       // TODO; create separate functions for opening HDF5 file for reading and writing
       hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
       throw_assert_nomsg(fapl >= 0);
-#ifdef HDF5_IS_PARALLEL
-      throw_assert_nomsg(H5Pset_fapl_mpio(fapl, all_comm, MPI_INFO_NULL) >= 0);
-#endif
+      throw_assert_nomsg(hdf5::set_parallel_file_access(fapl, all_comm) >= 0);
       hid_t output_file = H5Fopen(output_file_name.c_str(), H5F_ACC_RDWR, fapl);
       throw_assert(output_file >= 0,
                    "neurotrees_select: error in opening output HDF5 file"); 
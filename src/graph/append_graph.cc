@@ -23,6 +23,8 @@
 #include "node_rank_map.hh"
 #include "debug.hh"
 #include "mpi_debug.hh"
+#include "file_access.hh"
+#include "subfiles.hh"
 #include "throw_assert.hh"
 
 #include <vector>
@@ -50,7 +52,9 @@ namespace neuroh5
      const string&    dst_pop_name,
      const std::map <std::string, std::pair <size_t, data::AttrIndex > >& edge_attr_index,
      const edge_map_t&  input_edge_map,
-     const hsize_t    chunk_size
+     const hsize_t    chunk_size,
+     const FilterConfig& filters,
+     const WriteMode  write_mode
      )
     {
       size_t io_size;
@@ -266,13 +270,30 @@ namespace neuroh5
           MPI_Comm_split(all_comm,0,rank,&io_comm);
         }
 
-      if (is_io_rank)
+      if (is_io_rank && (write_mode == WriteSubfile))
+        {
+          // each I/O rank appends its share of the edges to its own
+          // subfile, without coordination with the other I/O ranks
+          int io_rank;
+          throw_assert_nomsg(MPI_Comm_rank(io_comm, &io_rank) == MPI_SUCCESS);
+
+          hid_t file = hdf5::open_subfile(file_name, io_rank);
+
+          hdf5::create_projection_groups(file, src_pop_name, dst_pop_name);
+
+          append_projection (MPI_COMM_SELF, file, src_pop_name, dst_pop_name,
+                             src_start, src_end, dst_start, dst_end,
+                             num_unpacked_edges, prj_edge_map,
+                             edge_attr_index, chunk_size, 1000000, false,
+                             filters);
+
+          throw_assert_nomsg(H5Fclose(file) >= 0);
+        }
+      else if (is_io_rank)
         {
           hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
           throw_assert_nomsg(fapl >= 0);
-#ifdef HDF5_IS_PARALLEL
-          throw_assert_nomsg(H5Pset_fapl_mpio(fapl, io_comm, MPI_INFO_NULL) >= 0);
-#endif
+          throw_assert_nomsg(hdf5::set_parallel_file_access(fapl, io_comm) >= 0);
           
           hid_t file = H5Fopen(file_name.c_str(), H5F_ACC_RDWR, fapl);
           throw_assert_nomsg(file >= 0);
@@ -287,7 +308,8 @@ namespace neuroh5
           append_projection (io_comm, file, src_pop_name, dst_pop_name,
                              src_start, src_end, dst_start, dst_end,
                              num_unpacked_edges, prj_edge_map,
-                             edge_attr_index, chunk_size);
+                             edge_attr_index, chunk_size, 1000000, true,
+                             filters);
 
           throw_assert_nomsg(MPI_Barrier(io_comm) == MPI_SUCCESS);
           throw_assert_nomsg(H5Fclose(file) >= 0);
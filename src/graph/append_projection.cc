@@ -6,6 +6,7 @@
 #include "exists_dataset.hh"
 #include "append_projection.hh"
 #include "write_template.hh"
+#include "dataset_filters.hh"
 #include "edge_attributes.hh"
 #include "mpe_seq.hh"
 #include "mpi_debug.hh"
@@ -40,6 +41,7 @@ namespace neuroh5
      const hsize_t             chunk_size,
      const hsize_t             block_size,
      const bool                collective,
+     const DatasetFilter&      filter,
      vector<size_t>&           recvbuf_num_blocks,
      vector<NODE_IDX_T>&       dst_blk_idx
      )
@@ -78,9 +80,7 @@ namespace neuroh5
           fspace = H5Screate_simple(1, zerodims, maxdims);
           throw_assert_nomsg(fspace >= 0);
 	  throw_assert_nomsg(H5Pset_chunk(dcpl, 1, &chunk ) >= 0);
-#ifdef H5_HAS_PARALLEL_DEFLATE
-          throw_assert_nomsg(H5Pset_deflate(dcpl, 9) >= 0);
-#endif
+          hdf5::set_dataset_filters(dcpl, filter, NODE_IDX_H5_FILE_T);
 
           dset = H5Dcreate2(file, path.c_str(), NODE_IDX_H5_FILE_T, fspace,
                             lcpl, dcpl, H5P_DEFAULT);
@@ -157,6 +157,7 @@ namespace neuroh5
      const hsize_t             chunk_size,
      const hsize_t             block_size,
      const bool                collective,
+     const DatasetFilter&      filter,
      vector<size_t>&           recvbuf_num_blocks,
      vector<DST_BLK_PTR_T>&    dst_blk_ptr
      )
@@ -198,9 +199,7 @@ namespace neuroh5
           throw_assert_nomsg(fspace >= 0);
 
 	  throw_assert_nomsg(H5Pset_chunk(dcpl, 1, &chunk ) >= 0);
-#ifdef H5_HAS_PARALLEL_DEFLATE
-          throw_assert_nomsg(H5Pset_deflate(dcpl, 9) >= 0);
-#endif
+          hdf5::set_dataset_filters(dcpl, filter, DST_BLK_PTR_H5_FILE_T);
           dset = H5Dcreate2 (file, path.c_str(), DST_BLK_PTR_H5_FILE_T,
                              fspace, lcpl, dcpl, H5P_DEFAULT);
           throw_assert_nomsg(H5Sclose(fspace) >= 0);
@@ -269,6 +268,7 @@ namespace neuroh5
      const hsize_t             chunk_size,
      const hsize_t             block_size,
      const bool                collective,
+     const DatasetFilter&      filter,
      vector<size_t>&           recvbuf_num_dest,
      vector<DST_PTR_T>&    dst_ptr
      )
@@ -304,9 +304,7 @@ namespace neuroh5
           throw_assert_nomsg(fspace >= 0);
 
 	  throw_assert_nomsg(H5Pset_chunk(dcpl, 1, &chunk ) >= 0);
-#ifdef H5_HAS_PARALLEL_DEFLATE
-          throw_assert_nomsg(H5Pset_deflate(dcpl, 9) >= 0);
-#endif
+          hdf5::set_dataset_filters(dcpl, filter, DST_PTR_H5_FILE_T);
           dset = H5Dcreate2 (file, path.c_str(), DST_PTR_H5_FILE_T,
                              fspace, lcpl, dcpl, H5P_DEFAULT);
           throw_assert_nomsg(dset >= 0);
@@ -390,6 +388,7 @@ namespace neuroh5
      const hsize_t             chunk_size,
      const hsize_t             block_size,
      const bool                collective,
+     const DatasetFilter&      filter,
      vector<size_t>&           recvbuf_num_edge,
      vector<NODE_IDX_T>        src_idx
      )
@@ -426,9 +425,7 @@ namespace neuroh5
           throw_assert_nomsg(fspace >= 0);
 
 	  throw_assert_nomsg(H5Pset_chunk(dcpl, 1, &chunk ) >= 0);
-#ifdef H5_HAS_PARALLEL_DEFLATE
-          throw_assert_nomsg(H5Pset_deflate(dcpl, 9) >= 0);
-#endif
+          hdf5::set_dataset_filters(dcpl, filter, NODE_IDX_H5_FILE_T);
           
           dset = H5Dcreate2 (file, path.c_str(), NODE_IDX_H5_FILE_T,
                              fspace, lcpl, dcpl, H5P_DEFAULT);
@@ -503,7 +500,8 @@ namespace neuroh5
      const std::map <std::string, std::pair <size_t, data::AttrIndex > >& edge_attr_index,
      const hsize_t             chunk_size,
      const hsize_t             block_size,
-     const bool collective
+     const bool collective,
+     const FilterConfig&       filters
      )
     {
       MPI_Request request;
@@ -713,6 +711,7 @@ namespace neuroh5
          src_start, src_end, dst_start, dst_end,
          num_blocks, total_num_blocks, dst_blk_idx_size,
          chunk_size, block_size, collective,
+         filters.index,
          recvbuf_num_blocks,
          dst_blk_idx
          );
@@ -729,6 +728,7 @@ namespace neuroh5
          src_start, src_end, dst_start, dst_end,
          num_blocks, total_num_blocks, dst_blk_ptr_size,
          chunk_size, block_size, collective,
+         filters.pointer,
          recvbuf_num_blocks,
          dst_blk_ptr
          );
@@ -745,6 +745,7 @@ namespace neuroh5
          total_num_dests, dst_ptr_size,
          chunk_size, block_size, 
          collective,
+         filters.pointer,
          recvbuf_num_dest,
          dst_ptr
          );
@@ -761,6 +762,7 @@ namespace neuroh5
          total_num_edges, src_idx_size,
          chunk_size, block_size, 
          collective,
+         filters.index,
          recvbuf_num_edge,
          src_idx
          );
@@ -803,19 +805,26 @@ namespace neuroh5
       throw_assert_nomsg(MPI_Barrier(comm) == MPI_SUCCESS);
 
       append_edge_attribute_map<float>(comm, file, src_pop_name, dst_pop_name,
-                                       edge_attr_map, edge_attr_index, chunk_size);
+                                       edge_attr_map, edge_attr_index, chunk_size,
+                                       filters.value);
       append_edge_attribute_map<uint8_t>(comm, file, src_pop_name, dst_pop_name,
-                                         edge_attr_map, edge_attr_index, chunk_size);
+                                         edge_attr_map, edge_attr_index, chunk_size,
+                                         filters.value);
       append_edge_attribute_map<uint16_t>(comm, file, src_pop_name, dst_pop_name,
-                                          edge_attr_map, edge_attr_index, chunk_size);
+                                          edge_attr_map, edge_attr_index, chunk_size,
+                                          filters.value);
       append_edge_attribute_map<uint32_t>(comm, file, src_pop_name, dst_pop_name,
-                                          edge_attr_map, edge_attr_index, chunk_size);
+                                          edge_attr_map, edge_attr_index, chunk_size,
+                                          filters.value);
       append_edge_attribute_map<int8_t>(comm, file, src_pop_name, dst_pop_name,
-                                        edge_attr_map, edge_attr_index, chunk_size);
+                                        edge_attr_map, edge_attr_index, chunk_size,
+                                        filters.value);
       append_edge_attribute_map<int16_t>(comm, file, src_pop_name, dst_pop_name,
-                                         edge_attr_map, edge_attr_index, chunk_size);
+                                         edge_attr_map, edge_attr_index, chunk_size,
+                                         filters.value);
       append_edge_attribute_map<int32_t>(comm, file, src_pop_name, dst_pop_name,
-                                         edge_attr_map, edge_attr_index, chunk_size);
+                                         edge_attr_map, edge_attr_index, chunk_size,
+                                         filters.value);
         
       // clean-up
       throw_assert_nomsg(MPI_Barrier(comm) == MPI_SUCCESS);
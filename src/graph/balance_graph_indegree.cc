@@ -17,6 +17,7 @@
 #include "merge_edge_map.hh"
 #include "vertex_degree.hh"
 #include "validate_edge_list.hh"
+#include "rank_map.hh"
 #include "throw_assert.hh"
 
 #include <getopt.h>
@@ -58,28 +59,6 @@ namespace neuroh5
       MPI_Abort(MPI_COMM_WORLD, 1);
     }
 
-    // Assign each node to a rank 
-    static void compute_node_rank_map
-    (
-     size_t num_ranks,
-     size_t num_nodes,
-     node_rank_map_t &node_rank_map
-     )
-    {
-      hsize_t remainder=0, offset=0, buckets=0;
-    
-      for (size_t i=0; i<num_ranks; i++)
-        {
-          remainder  = num_nodes - offset;
-          buckets    = num_ranks - i;
-          for (size_t j = 0; j < remainder / buckets; j++)
-            {
-              node_rank_map[offset+j].insert(i);
-            }
-          offset    += remainder / buckets;
-        }
-    }
-
     void compute_part_nums
     (
      const size_t&     num_blocks,
@@ -129,9 +108,8 @@ namespace neuroh5
       pop_range_map_t pop_ranges;
       throw_assert_nomsg(cell::read_population_ranges(comm, input_file_name, pop_ranges, total_num_nodes) >= 0);
 
-      // A vector that maps nodes to compute ranks
-      node_rank_map_t node_rank_map;
-      compute_node_rank_map(size, total_num_nodes, node_rank_map);
+      // Contiguous block assignment of nodes to compute ranks
+      data::NodeRankMap node_rank_map = data::NodeRankMap::block(size, 0, total_num_nodes);
     
       // read the edges
       vector < edge_map_t > prj_vector;
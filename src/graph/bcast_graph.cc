@@ -41,7 +41,8 @@ namespace neuroh5
      * Load and broadcast edge data structures 
      *****************************************************************************/
 
-    int bcast_projection (MPI_Comm all_comm, MPI_Comm io_comm,
+    template <class EdgeContainer>
+    static int bcast_projection (MPI_Comm all_comm, MPI_Comm io_comm,
                           const EdgeMapType edge_map_type,
                           const string& file_name,
                           const string& src_pop_name, 
@@ -51,7 +52,7 @@ namespace neuroh5
                           const vector< string >& attr_namespaces,
                           const pop_search_range_map_t& pop_search_ranges,
                           const set< pair<pop_t, pop_t> >& pop_pairs,
-                          vector < edge_map_t >& prj_vector,
+                          vector < EdgeContainer >& prj_vector,
                           vector < map <string, vector < vector<string> > > > & edge_attr_names_vector)
                           
     {
@@ -62,7 +63,7 @@ namespace neuroh5
 
       vector<char> sendbuf; 
       vector<NODE_IDX_T> send_edges, recv_edges, total_recv_edges;
-      edge_map_t prj_edge_map;
+      EdgeContainer prj_edge_map;
       map <string, vector < vector <string> > > edge_attr_names;
       size_t num_edges = 0, total_prj_num_edges = 0;
       hsize_t local_read_blocks;
@@ -153,7 +154,7 @@ namespace neuroh5
       
         }
       
-      prj_vector.push_back(prj_edge_map);
+      prj_vector.push_back(std::move(prj_edge_map));
       edge_attr_names_vector.push_back(edge_attr_names);
 #ifdef NEUROH5_DEBUG
       throw_assert_nomsg(MPI_Barrier(all_comm) == MPI_SUCCESS);
@@ -163,14 +164,15 @@ namespace neuroh5
     }
 
 
-    int bcast_graph
+    template <class EdgeContainer>
+    static int bcast_graph_edges
     (
      MPI_Comm                      all_comm,
      const EdgeMapType             edge_map_type,
      const std::string&            file_name,
      const vector< string >&       attr_namespaces,
      const vector< pair<string,string> >& prj_names,
-     vector < edge_map_t >& prj_vector,
+     vector < EdgeContainer >& prj_vector,
      vector < map <string, vector < vector <string> > > >& edge_attr_names_vector,
      size_t                       &total_num_nodes,
      size_t                       &local_num_edges,
@@ -272,6 +274,46 @@ namespace neuroh5
 
       return ierr;
     }
+
+
+    int bcast_graph
+    (
+     MPI_Comm                      all_comm,
+     const EdgeMapType             edge_map_type,
+     const std::string&            file_name,
+     const vector< string >&       attr_namespaces,
+     const vector< pair<string,string> >& prj_names,
+     vector < edge_map_t >& prj_vector,
+     vector < map <string, vector < vector <string> > > >& edge_attr_names_vector,
+     size_t                       &total_num_nodes,
+     size_t                       &local_num_edges,
+     size_t                       &total_num_edges
+     )
+    {
+      return bcast_graph_edges(all_comm, edge_map_type, file_name, attr_namespaces, prj_names,
+                               prj_vector, edge_attr_names_vector,
+                               total_num_nodes, local_num_edges, total_num_edges);
+    }
+
+
+    int bcast_graph
+    (
+     MPI_Comm                      all_comm,
+     const EdgeMapType             edge_map_type,
+     const std::string&            file_name,
+     const vector< string >&       attr_namespaces,
+     const vector< pair<string,string> >& prj_names,
+     vector < edge_csr_t >& prj_vector,
+     vector < map <string, vector < vector <string> > > >& edge_attr_names_vector,
+     size_t                       &total_num_nodes,
+     size_t                       &local_num_edges,
+     size_t                       &total_num_edges
+     )
+    {
+      return bcast_graph_edges(all_comm, edge_map_type, file_name, attr_namespaces, prj_names,
+                               prj_vector, edge_attr_names_vector,
+                               total_num_nodes, local_num_edges, total_num_edges);
+    }
     
   }
 }
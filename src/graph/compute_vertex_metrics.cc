@@ -17,6 +17,7 @@
 #include "vertex_degree.hh"
 #include "validate_edge_list.hh"
 #include "node_attributes.hh"
+#include "rank_map.hh"
 #include "throw_assert.hh"
 
 #include <getopt.h>
@@ -40,23 +41,7 @@ namespace neuroh5
 {
   namespace graph
   {
-    // Assign each node to a rank 
-    static void compute_node_rank_map
-    (
-     size_t num_ranks,
-     size_t num_nodes,
-     node_rank_map_t &node_rank_map
-     )
-    {
-      // round-robin node to rank assignment from file
-      for (size_t i = 0; i < num_nodes; i++)
-        {
-            node_rank_map[i].insert(i%num_ranks);
-        }
-    }
-
-
-    void append_vertex_degree_map (MPI_Comm comm, const node_rank_map_t& node_rank_map,
+    void append_vertex_degree_map (MPI_Comm comm, const data::NodeRankMap& node_rank_map,
                                    const std::vector< std::pair<std::string, std::string> >& prj_names,
                                    size_t total_num_nodes,
                                    const std::vector < map< NODE_IDX_T, size_t> > & vertex_degree_maps,
@@ -97,18 +82,17 @@ namespace neuroh5
           vector <float> vertex_norm_degree_value;
           
           attr_ptr.push_back(0);
-          for (auto it=node_rank_map.begin(); it != node_rank_map.end(); it++)
+          vector <NODE_IDX_T> local_nodes;
+          node_rank_map.local_nodes(rank, local_nodes);
+          for (const NODE_IDX_T& node : local_nodes)
             {
-              if (it->second.count(rank) > 0)
+              const auto it_degree_value = vertex_degree_map.find(node);
+              if (it_degree_value != vertex_degree_map.cend())
                 {
-                  const auto it_degree_value = vertex_degree_map.find(it->first);
-                  if (it_degree_value != vertex_degree_map.cend())
-                    {
-                      node_id.push_back(it->first);
-                      attr_ptr.push_back(attr_ptr.back() + 1);
-                      vertex_degree_value.push_back(it_degree_value->second);
-                      vertex_norm_degree_value.push_back(vertex_norm_degrees[it->first]);
-                    }
+                  node_id.push_back(node);
+                  attr_ptr.push_back(attr_ptr.back() + 1);
+                  vertex_degree_value.push_back(it_degree_value->second);
+                  vertex_norm_degree_value.push_back(vertex_norm_degrees[node]);
                 }
             }
 
@@ -152,9 +136,8 @@ namespace neuroh5
       pop_range_map_t pop_ranges;
       throw_assert_nomsg(cell::read_population_ranges(comm, file_name, pop_ranges, total_num_nodes) >= 0);
 
-      // A vector that maps nodes to compute ranks
-      node_rank_map_t node_rank_map;
-      compute_node_rank_map(size, total_num_nodes, node_rank_map);
+      // Round-robin assignment of nodes to compute ranks
+      data::NodeRankMap node_rank_map = data::NodeRankMap::round_robin(size, 0, total_num_nodes);
     
       // read the edges
       vector < map <string, vector <vector<string> > > > edge_attr_name_vector;
@@ -222,9 +205,8 @@ namespace neuroh5
       pop_range_map_t pop_ranges;
       throw_assert_nomsg(cell::read_population_ranges(comm, file_name, pop_ranges, total_num_nodes) >= 0);
 
-      // A vector that maps nodes to compute ranks
-      node_rank_map_t node_rank_map;
-      compute_node_rank_map(size, total_num_nodes, node_rank_map);
+      // Round-robin assignment of nodes to compute ranks
+      data::NodeRankMap node_rank_map = data::NodeRankMap::round_robin(size, 0, total_num_nodes);
     
       // read the edges
       vector < map <string, vector <vector<string> > > > edge_attr_name_vector;
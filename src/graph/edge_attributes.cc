@@ -10,12 +10,14 @@
 #include "attr_val.hh"
 #include "attr_kind_datatype.hh"
 #include "edge_attributes.hh"
+#include "dataset_filters.hh"
 #include "exists_dataset.hh"
 #include "exists_group.hh"
 #include "path_names.hh"
 #include "serialize_data.hh"
 #include "read_template.hh"
 #include "mpi_debug.hh"
+#include "file_access.hh"
 #include "throw_assert.hh"
 
 #include <iostream>
@@ -80,7 +82,8 @@ namespace neuroh5
      const string&  attr_namespace,
      const string&  attr_name,
      const hid_t&   ftype,
-     const size_t   chunk_size
+     const size_t   chunk_size,
+     const DatasetFilter& filter
      )
     {
       herr_t status;
@@ -91,10 +94,7 @@ namespace neuroh5
       hid_t plist  = H5Pcreate (H5P_DATASET_CREATE);
       status = H5Pset_chunk(plist, 1, cdims);
       throw_assert_nomsg(status == 0);
-#ifdef H5_HAS_PARALLEL_DEFLATE
-      status = H5Pset_deflate(plist, 9);
-      throw_assert_nomsg(status == 0);
-#endif
+      set_dataset_filters(plist, filter, ftype);
       
       hid_t lcpl = H5Pcreate(H5P_LINK_CREATE);
       throw_assert_nomsg(lcpl >= 0);
@@ -205,10 +205,11 @@ namespace neuroh5
 
     
     /////////////////////////////////////////////////////////////////////////
-    herr_t get_edge_attributes
+    // in_file must be open on the root rank
+    static herr_t get_edge_attributes_file
     (
      MPI_Comm                      comm,
-     const string&                 file_name,
+     hid_t                         in_file,
      const string&                 src_pop_name,
      const string&                 dst_pop_name,
      const string&                 name_space,
@@ -223,7 +224,6 @@ namespace neuroh5
 
       if (rank == root)
         {
-          hid_t in_file = H5Fopen(file_name.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
           throw_assert_nomsg(in_file >= 0);
           out_attributes.clear();
           
@@ -242,7 +242,6 @@ namespace neuroh5
                   throw_assert_nomsg(H5Gclose(grp) >= 0);
                 }
             }
-          ierr = H5Fclose(in_file);
         }
 
       vector<char> edge_attributes_sendbuf;  size_t edge_attributes_sendbuf_size=0;
@@ -265,6 +264,57 @@ namespace neuroh5
 
       return ierr;
     }
+
+    herr_t get_edge_attributes
+    (
+     MPI_Comm                      comm,
+     const string&                 file_name,
+     const string&                 src_pop_name,
+     const string&                 dst_pop_name,
+     const string&                 name_space,
+     vector< pair<string,AttrKind> >& out_attributes
+     )
+    {
+      int rank;
+      throw_assert_nomsg(MPI_Comm_rank(comm, &rank) == MPI_SUCCESS);
+
+      hid_t in_file = -1;
+      if (rank == 0)
+        {
+          in_file = H5Fopen(file_name.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+        }
+      
+      herr_t ierr = get_edge_attributes_file(comm, in_file, src_pop_name, dst_pop_name,
+                                             name_space, out_attributes);
+
+      if (rank == 0)
+        {
+          throw_assert_nomsg(H5Fclose(in_file) >= 0);
+        }
+      return ierr;
+    }
+
+    herr_t get_edge_attributes
+    (
+     File&                         file,
+     const string&                 src_pop_name,
+     const string&                 dst_pop_name,
+     const string&                 name_space,
+     vector< pair<string,AttrKind> >& out_attributes
+     )
+    {
+      auto key = make_tuple(src_pop_name, dst_pop_name, name_space);
+      auto it = file.metadata.edge_attributes.find(key);
+      if (it == file.metadata.edge_attributes.end())
+        {
+          vector< pair<string,AttrKind> > attributes;
+          throw_assert_nomsg(get_edge_attributes_file(file.comm(), file.id(), src_pop_name, dst_pop_name,
+                                                      name_space, attributes) >= 0);
+          it = file.metadata.edge_attributes.insert(make_pair(key, attributes)).first;
+        }
+      out_attributes = it->second;
+      return 0;
+    }
     
     /////////////////////////////////////////////////////////////////////////
     herr_t num_edge_attributes
@@ -363,10 +413,11 @@ namespace neuroh5
 
       hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
       throw_assert_nomsg(fapl >= 0);
-      throw_assert_nomsg(H5Pset_fapl_mpio(fapl, comm, MPI_INFO_NULL) >= 0);
+      throw_assert_nomsg(hdf5::set_parallel_file_access(fapl, comm) >= 0);
       
       throw_assert_nomsg(MPI_Barrier(comm) == MPI_SUCCESS);
 
+      hdf5::register_filters();
       file = H5Fopen(file_name.c_str(), H5F_ACC_RDONLY, fapl);
       throw_assert_nomsg(file >= 0);
 
@@ -576,8 +627,9 @@ namespace neuroh5
       hsize_t block = 0;
       hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
       throw_assert_nomsg(fapl >= 0);
-      throw_assert_nomsg(H5Pset_fapl_mpio(fapl, comm, MPI_INFO_NULL) >= 0);
+      throw_assert_nomsg(hdf5::set_parallel_file_access(fapl, comm) >= 0);
 
+      hdf5::register_filters();
       file = H5Fopen(file_name.c_str(), H5F_ACC_RDONLY, fapl);
       throw_assert_nomsg(file >= 0);
 
@@ -21,6 +21,7 @@
 #include "alltoallv_template.hh"
 #include "serialize_data.hh"
 #include "serialize_cell_attributes.hh"
+#include "file_access.hh"
 #include "throw_assert.hh"
 #include "debug.hh"
 
@@ -304,7 +305,7 @@ namespace neuroh5
 
       // get a file handle and retrieve the MPI info
       hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
-      throw_assert_nomsg(H5Pset_fapl_mpio(fapl, comm, MPI_INFO_NULL) >= 0);
+      throw_assert_nomsg(hdf5::set_parallel_file_access(fapl, comm) >= 0);
       hid_t file = H5Fopen(file_name.c_str(), H5F_ACC_RDONLY, fapl);
       throw_assert_nomsg(file >= 0);
 
@@ -439,7 +440,7 @@ namespace neuroh5
      const int                     io_size,
      const string                 &attr_name_space,
      // A vector that maps nodes to compute ranks
-     const node_rank_map_t &node_rank_map,
+     const data::NodeRankMap &node_rank_map,
      const NODE_IDX_T              pop_start,
      data::NamedAttrMap           &attr_map,
      // if positive, these arguments specify offset and number of entries to read
@@ -17,6 +17,7 @@
 #include "group_contents.hh"
 #include "serialize_data.hh"
 #include "throw_assert.hh"
+#include "neuroh5_file.hh"
 
 #define MAX_PRJ_NAME 1024
 
@@ -41,10 +42,11 @@ namespace neuroh5
       }
 
       //////////////////////////////////////////////////////////////////////////
-      herr_t read_projection_names
+      // file is the file opened on rank 0, or a negative error code
+      static herr_t read_projection_names_file
       (
        MPI_Comm             comm,
-       const std::string&   file_name,
+       hid_t                file,
        vector<pair<string,string>>&      prj_names
        )
       {
@@ -57,14 +59,10 @@ namespace neuroh5
         
         vector<string> prj_src_pop_names, prj_dst_pop_names;
         
-        // MPI rank 0 reads and broadcasts the number of ranges
-        hid_t file = -1;
-
         // MPI rank 0 reads and broadcasts the projection names
         if (rank == 0)
           {
             vector <string> dst_pop_names;
-            file = H5Fopen(file_name.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
             if (file >= 0)
               {
 
@@ -83,8 +81,6 @@ namespace neuroh5
                         prj_dst_pop_names.push_back(dst_pop_name);
                       }
                   }
-                
-                throw_assert_nomsg(H5Fclose(file) >= 0);
               }
             else
               {
@@ -138,6 +134,49 @@ namespace neuroh5
 
         return ierr;
       }
+
+      //////////////////////////////////////////////////////////////////////////
+      herr_t read_projection_names
+      (
+       MPI_Comm             comm,
+       const std::string&   file_name,
+       vector<pair<string,string>>&      prj_names
+       )
+      {
+        int rank;
+        throw_assert_nomsg(MPI_Comm_rank(comm, &rank) == MPI_SUCCESS);
+
+        hid_t file = -1;
+        if (rank == 0)
+          {
+            file = H5Fopen(file_name.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+          }
+
+        herr_t ierr = read_projection_names_file(comm, file, prj_names);
+
+        if (file >= 0)
+          {
+            throw_assert_nomsg(H5Fclose(file) >= 0);
+          }
+        return ierr;
+      }
+
+      //////////////////////////////////////////////////////////////////////////
+      herr_t read_projection_names
+      (
+       File&                file,
+       vector<pair<string,string>>&      prj_names
+       )
+      {
+        File::Metadata& metadata = file.metadata;
+        if (!metadata.has_prj_names)
+          {
+            throw_assert_nomsg(read_projection_names_file(file.comm(), file.id(), metadata.prj_names) >= 0);
+            metadata.has_prj_names = true;
+          }
+        prj_names.insert(prj_names.end(), metadata.prj_names.begin(), metadata.prj_names.end());
+        return 0;
+      }
     
     }
 }
@@ -35,7 +35,9 @@ namespace neuroh5
      vector < map <string, vector < vector<string> > > > & edge_attr_names_vector,
      size_t&              total_num_nodes,
      size_t&              local_num_edges,
-     size_t&              total_num_edges
+     size_t&              total_num_edges,
+     ProjectionPtrReadMode ptr_read_mode,
+     ProjectionBlockAssignment block_assignment
      )
     {
       int status = 0;
@@ -47,10 +49,13 @@ namespace neuroh5
       pop_label_map_t pop_labels;
       pop_range_map_t pop_ranges;
       set< pair<pop_t, pop_t> > pop_pairs;
-      throw_assert_nomsg(cell::read_population_combos(comm, file_name, pop_pairs) >= 0);
-      throw_assert_nomsg(cell::read_population_ranges
-             (comm, file_name, pop_ranges, total_num_nodes) >= 0);
-      throw_assert_nomsg(cell::read_population_labels(comm, file_name, pop_labels) >= 0);
+      {
+        File file(comm, file_name);
+        throw_assert_nomsg(cell::read_population_combos(file, pop_pairs) >= 0);
+        throw_assert_nomsg(cell::read_population_ranges
+                           (file, pop_ranges, total_num_nodes) >= 0);
+        throw_assert_nomsg(cell::read_population_labels(file, pop_labels) >= 0);
+      }
 
       pop_search_range_map_t pop_search_ranges;
       for (auto &x : pop_ranges)
@@ -103,7 +108,8 @@ namespace neuroh5
                   prj_vector, edge_attr_names_vector,
                   local_prj_num_nodes,
                   local_prj_num_edges, total_prj_num_edges,
-                  local_read_blocks, total_read_blocks) >= 0);
+                  local_read_blocks, total_read_blocks,
+                  0, 0, true, ptr_read_mode, block_assignment) >= 0);
 
           mpi::MPI_DEBUG(comm, "read_graph: projection ", i, " has a total of ", total_prj_num_edges, " edges");
           
@@ -113,7 +119,7 @@ namespace neuroh5
 
       size_t sum_local_num_edges = 0;
       status = MPI_Reduce(&local_num_edges, &sum_local_num_edges, 1,
-                          MPI_SIZE_T, MPI_SUM, 0, MPI_COMM_WORLD);
+                          MPI_SIZE_T, MPI_SUM, 0, comm);
       throw_assert_nomsg(status == MPI_SUCCESS);
       
       if (rank == 0)
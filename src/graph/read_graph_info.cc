@@ -45,10 +45,13 @@ namespace neuroh5
       pop_label_map_t pop_labels;
       pop_range_map_t pop_ranges;
       set< pair<pop_t, pop_t> > pop_pairs;
-      throw_assert_nomsg(cell::read_population_combos(comm, file_name, pop_pairs) >= 0);
-      throw_assert_nomsg(cell::read_population_ranges
-             (comm, file_name, pop_ranges, total_num_nodes) >= 0);
-      throw_assert_nomsg(cell::read_population_labels(comm, file_name, pop_labels) >= 0);
+      {
+        File file(comm, file_name);
+        throw_assert_nomsg(cell::read_population_combos(file, pop_pairs) >= 0);
+        throw_assert_nomsg(cell::read_population_ranges
+                           (file, pop_ranges, total_num_nodes) >= 0);
+        throw_assert_nomsg(cell::read_population_labels(file, pop_labels) >= 0);
+      }
 
       // read the edges
       for (auto const& it : pop_pairs)
@@ -35,7 +35,8 @@ namespace neuroh5
      * Read the basic DBS graph structure
      *************************************************************************/
 
-    herr_t read_projection
+    template <class EdgeContainer>
+    static herr_t read_projection_edges
     (
      MPI_Comm                   comm,
      const std::string&         file_name,
@@ -46,7 +47,7 @@ namespace neuroh5
      const NODE_IDX_T&          src_start,
      const NODE_IDX_T&          dst_start,
      const vector<string>&      attr_namespaces,
-     vector<edge_map_t>&       prj_vector,
+     vector<EdgeContainer>&     prj_vector,
      vector < map <string, vector < vector<string> > > > & edge_attr_names_vector,
      size_t&                    local_num_nodes,
      size_t&                    local_num_edges,
@@ -55,7 +56,9 @@ namespace neuroh5
      hsize_t&                   total_read_blocks,
      size_t                     offset,
      size_t                     numitems,
-     bool collective
+     bool collective,
+     ProjectionPtrReadMode      ptr_read_mode,
+     ProjectionBlockAssignment  block_assignment
      )
     {
       herr_t ierr = 0;
@@ -75,12 +78,27 @@ namespace neuroh5
       vector<NODE_IDX_T> src_idx;
       map<string, data::NamedAttrVal> edge_attr_map;
 
+      map<string, vector< pair<string,AttrKind> > > edge_attr_info;
+      size_t edge_attr_bytes = 0;
+      for (const string& attr_namespace : attr_namespaces) 
+        {
+          throw_assert(graph::get_edge_attributes(comm, file_name, src_pop_name, dst_pop_name,
+                                                  attr_namespace, edge_attr_info[attr_namespace]) >= 0,
+                       "read_projection: get_edge_attributes error");
+          for (const auto& attr_info : edge_attr_info[attr_namespace])
+            {
+              edge_attr_bytes += attr_info.second.size;
+            }
+        }
+
       mpi::MPI_DEBUG(comm, "read_projection: ", src_pop_name, " -> ", dst_pop_name);
       throw_assert(hdf5::read_projection_datasets(comm, file_name, src_pop_name, dst_pop_name,
                                                   block_base, edge_base,
                                                   dst_blk_ptr, dst_idx, dst_ptr, src_idx,
                                                   total_num_edges, total_read_blocks, local_read_blocks,
-                                                  offset, numitems) >= 0,
+                                                  offset, numitems, collective,
+                                                  ptr_read_mode, block_assignment,
+                                                  edge_attr_bytes) >= 0,
                    "read_projection: read_projection_datasets error");
       
       mpi::MPI_DEBUG(comm, "read_projection: validating projection ", src_pop_name, " -> ", dst_pop_name);
@@ -96,15 +114,9 @@ namespace neuroh5
       map <string, vector < vector<string> > > edge_attr_names;
       for (string attr_namespace : attr_namespaces) 
         {
-          vector< pair<string,AttrKind> > edge_attr_info;
-          
-          throw_assert(graph::get_edge_attributes(comm, file_name, src_pop_name, dst_pop_name,
-                                                  attr_namespace, edge_attr_info) >= 0,
-                       "read_projection: get_edge_attributes error");
-          
           throw_assert(graph::read_all_edge_attributes
                        (comm, file_name, src_pop_name, dst_pop_name, attr_namespace,
-                        edge_base, edge_count, edge_attr_info,
+                        edge_base, edge_count, edge_attr_info[attr_namespace],
                         edge_attr_map[attr_namespace]) >= 0,
                        "read_projection: read_all_edge_attributes error");
           
@@ -113,7 +125,7 @@ namespace neuroh5
       
       size_t local_prj_num_edges=0;
 
-      edge_map_t prj_edge_map;
+      EdgeContainer prj_edge_map;
       // append to the vectors representing a projection (sources,
       // destinations, edge attributes)
       throw_assert(data::append_edge_map(dst_start, src_start, dst_blk_ptr, dst_idx,
@@ -133,7 +145,7 @@ namespace neuroh5
       throw_assert(local_prj_num_edges == edge_count,
                    "read_projection: edge count mismatch");
 
-      prj_vector.push_back(prj_edge_map);
+      prj_vector.push_back(std::move(prj_edge_map));
       edge_attr_names_vector.push_back (edge_attr_names);
 #ifdef NEUROH5_DEBUG
       throw_assert(MPI_Barrier(comm) == MPI_SUCCESS,
@@ -143,6 +155,76 @@ namespace neuroh5
       return ierr;
     }
 
+
+    herr_t read_projection
+    (
+     MPI_Comm                   comm,
+     const std::string&         file_name,
+     const pop_search_range_map_t&     pop_search_ranges,
+     const set < pair<pop_t, pop_t> >& pop_pairs,
+     const std::string&         src_pop_name,
+     const std::string&         dst_pop_name,
+     const NODE_IDX_T&          src_start,
+     const NODE_IDX_T&          dst_start,
+     const vector<string>&      attr_namespaces,
+     vector<edge_map_t>&       prj_vector,
+     vector < map <string, vector < vector<string> > > > & edge_attr_names_vector,
+     size_t&                    local_num_nodes,
+     size_t&                    local_num_edges,
+     size_t&                    total_num_edges,
+     hsize_t&                   local_read_blocks,
+     hsize_t&                   total_read_blocks,
+     size_t                     offset,
+     size_t                     numitems,
+     bool collective,
+     ProjectionPtrReadMode      ptr_read_mode,
+     ProjectionBlockAssignment  block_assignment
+     )
+    {
+      return read_projection_edges(comm, file_name, pop_search_ranges, pop_pairs,
+                                   src_pop_name, dst_pop_name, src_start, dst_start,
+                                   attr_namespaces, prj_vector, edge_attr_names_vector,
+                                   local_num_nodes, local_num_edges, total_num_edges,
+                                   local_read_blocks, total_read_blocks,
+                                   offset, numitems, collective,
+                                   ptr_read_mode, block_assignment);
+    }
+
+
+    herr_t read_projection
+    (
+     MPI_Comm                   comm,
+     const std::string&         file_name,
+     const pop_search_range_map_t&     pop_search_ranges,
+     const set < pair<pop_t, pop_t> >& pop_pairs,
+     const std::string&         src_pop_name,
+     const std::string&         dst_pop_name,
+     const NODE_IDX_T&          src_start,
+     const NODE_IDX_T&          dst_start,
+     const vector<string>&      attr_namespaces,
+     vector<edge_csr_t>&       prj_vector,
+     vector < map <string, vector < vector<string> > > > & edge_attr_names_vector,
+     size_t&                    local_num_nodes,
+     size_t&                    local_num_edges,
+     size_t&                    total_num_edges,
+     hsize_t&                   local_read_blocks,
+     hsize_t&                   total_read_blocks,
+     size_t                     offset,
+     size_t                     numitems,
+     bool collective,
+     ProjectionPtrReadMode      ptr_read_mode,
+     ProjectionBlockAssignment  block_assignment
+     )
+    {
+      return read_projection_edges(comm, file_name, pop_search_ranges, pop_pairs,
+                                   src_pop_name, dst_pop_name, src_start, dst_start,
+                                   attr_namespaces, prj_vector, edge_attr_names_vector,
+                                   local_num_nodes, local_num_edges, total_num_edges,
+                                   local_read_blocks, total_read_blocks,
+                                   offset, numitems, collective,
+                                   ptr_read_mode, block_assignment);
+    }
+
     
   }
 }
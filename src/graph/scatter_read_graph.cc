@@ -43,13 +43,16 @@ namespace neuroh5
      const vector<string> &        attr_namespaces,
      const vector< pair<string, string> >&         prj_names,
      // A vector that maps nodes to compute ranks
-     const node_rank_map_t&  node_rank_map,
+     const data::NodeRankMap& node_rank_map,
      vector < edge_map_t >& prj_vector,
      vector < map <string, vector < vector<string> > > > & edge_attr_names_vector,
      size_t                       &local_num_nodes,
      size_t                       &total_num_nodes,
      size_t                       &local_num_edges,
-     size_t                       &total_num_edges
+     size_t                       &total_num_edges,
+     ProjectionPtrReadMode        ptr_read_mode,
+     ProjectionBlockAssignment    block_assignment,
+     size_t                       pipeline_depth
      )
     {
       int ierr = 0;
@@ -62,11 +65,15 @@ namespace neuroh5
       throw_assert_nomsg(MPI_Comm_size(all_comm, &size) == MPI_SUCCESS);
       throw_assert_nomsg(MPI_Comm_rank(all_comm, &rank) == MPI_SUCCESS);
           
-       throw_assert_nomsg(cell::read_population_ranges
-                          (all_comm, file_name, pop_ranges, total_num_nodes)
-                          >= 0);
-       throw_assert_nomsg(cell::read_population_labels(all_comm, file_name, pop_labels) >= 0);
-       throw_assert_nomsg(cell::read_population_combos(all_comm, file_name, pop_pairs)  >= 0);
+      {
+        // the file is opened once for all metadata reads
+        File file(all_comm, file_name);
+        throw_assert_nomsg(cell::read_population_ranges
+                           (file, pop_ranges, total_num_nodes)
+                           >= 0);
+        throw_assert_nomsg(cell::read_population_labels(file, pop_labels) >= 0);
+        throw_assert_nomsg(cell::read_population_combos(file, pop_pairs)  >= 0);
+      }
 
        pop_search_range_map_t pop_search_ranges;
        for (auto &x : pop_ranges)
@@ -74,11 +81,9 @@ namespace neuroh5
            pop_search_ranges.insert(make_pair(x.second.start, make_pair(x.second.count, x.first)));
          }
           
-      // For each projection, I/O ranks read the edges and scatter
+      vector< pair<NODE_IDX_T, NODE_IDX_T> > prj_starts;
       for (size_t i = 0; i < prj_names.size(); i++)
         {
-          hsize_t total_read_blocks;
-
           string src_pop_name = prj_names[i].first;
           string dst_pop_name = prj_names[i].second;
 
@@ -100,17 +105,38 @@ namespace neuroh5
             }
           throw_assert_nomsg(dst_pop_set && src_pop_set);
 
-          NODE_IDX_T dst_start = pop_ranges[dst_pop_idx].start;
-          NODE_IDX_T src_start = pop_ranges[src_pop_idx].start;
+          prj_starts.push_back(make_pair(pop_ranges[src_pop_idx].start,
+                                         pop_ranges[dst_pop_idx].start));
+        }
+
+      if (pipeline_depth > 0)
+        {
+          // I/O ranks read each projection while the exchanges of the
+          // preceding projections are in flight
+          scatter_read_projections(all_comm, io_size, edge_map_type,
+                                   file_name, prj_names, prj_starts,
+                                   attr_namespaces,
+                                   node_rank_map, pop_search_ranges, pop_pairs,
+                                   prj_vector, edge_attr_names_vector, 
+                                   local_num_nodes, local_num_edges, total_num_edges,
+                                   pipeline_depth, ptr_read_mode, block_assignment);
+          return ierr;
+        }
+      
+      // For each projection, I/O ranks read the edges and scatter
+      for (size_t i = 0; i < prj_names.size(); i++)
+        {
+          hsize_t total_read_blocks;
 
           scatter_read_projection(all_comm, io_size, edge_map_type,
-                                  file_name, src_pop_name, dst_pop_name, 
-                                  src_start, dst_start,
+                                  file_name, prj_names[i].first, prj_names[i].second, 
+                                  prj_starts[i].first, prj_starts[i].second,
                                   attr_namespaces,
                                   node_rank_map, pop_search_ranges, pop_pairs,
                                   prj_vector, edge_attr_names_vector, 
                                   local_num_nodes, local_num_edges, total_num_edges,
-                                  total_read_blocks);
+                                  total_read_blocks, 0, 0, ptr_read_mode,
+                                  block_assignment);
 #ifdef NEUROH5_DEBUG
           MPI_Barrier(all_comm); 
 #endif
@@ -29,6 +29,7 @@
 #include <sstream>
 #include <string>
 #include <cstring>
+#include <deque>
 #include <set>
 #include <map>
 #include <vector>
@@ -41,22 +42,27 @@ namespace neuroh5
   {
     
     /*****************************************************************************
-     * Load and scatter edge data structures 
+     * Read the edges of a projection on the I/O ranks and pack them into
+     * a send buffer for the exchange with the ranks that own them
      *****************************************************************************/
 
-    int scatter_read_projection (MPI_Comm all_comm, const int io_size, EdgeMapType edge_map_type, 
-                                 const string& file_name, const string& src_pop_name, const string& dst_pop_name, 
-                                 const NODE_IDX_T& src_start,
-                                 const NODE_IDX_T& dst_start,
-                                 const vector<string> &attr_namespaces,
-                                 const node_rank_map_t&  node_rank_map,
-                                 const pop_search_range_map_t& pop_search_ranges,
-                                 const set< pair<pop_t, pop_t> >& pop_pairs,
-                                 vector < edge_map_t >& prj_vector,
-                                 vector < map <string, vector < vector<string> > > > & edge_attr_names_vector,
-                                 size_t &local_num_nodes, size_t &local_num_edges, size_t &total_num_edges,
-                                 hsize_t& total_read_blocks,
-                                 size_t offset, size_t numitems)
+    static int read_pack_projection (MPI_Comm all_comm, const int io_size, EdgeMapType edge_map_type, 
+                                     const string& file_name, const string& src_pop_name, const string& dst_pop_name, 
+                                     const NODE_IDX_T& src_start,
+                                     const NODE_IDX_T& dst_start,
+                                     const vector<string> &attr_namespaces,
+                                     const data::NodeRankMap& node_rank_map,
+                                     const pop_search_range_map_t& pop_search_ranges,
+                                     const set< pair<pop_t, pop_t> >& pop_pairs,
+                                     size_t &total_num_edges,
+                                     hsize_t& total_read_blocks,
+                                     size_t offset, size_t numitems,
+                                     ProjectionPtrReadMode ptr_read_mode,
+                                     ProjectionBlockAssignment block_assignment,
+                                     vector<size_t>& sendcounts,
+                                     vector<size_t>& sdispls,
+                                     vector<char>& sendbuf,
+                                     map<string, vector< vector<string> > >& edge_attr_names)
     {
       // MPI Communicator for I/O ranks
       MPI_Comm io_comm;
@@ -90,165 +96,382 @@ namespace neuroh5
           MPI_Comm_split(all_comm,0,rank,&io_comm);
         }
 
-      vector<NODE_IDX_T> send_edges, recv_edges, total_recv_edges;
       rank_edge_map_t prj_rank_edge_map;
-      edge_map_t prj_edge_map;
       size_t num_edges = 0;
-      map<string, vector< vector<string> > > edge_attr_names;
-      
-      local_num_nodes=0; local_num_edges=0;
-      
-      {
-        vector<char> recvbuf;
-        vector<size_t> recvcounts, rdispls;
 
-        {
-          vector<char> sendbuf; 
-          vector<size_t> sendcounts(size,0), sdispls(size,0);
+      sendcounts.assign(size,0);
+      sdispls.assign(size,0);
 
-          mpi::MPI_DEBUG(all_comm, "scatter_read_projection: ", src_pop_name, " -> ", dst_pop_name, "\n");
+      mpi::MPI_DEBUG(all_comm, "scatter_read_projection: ", src_pop_name, " -> ", dst_pop_name, "\n");
           
-          if (is_io_rank)
+      if (is_io_rank)
+        {
+          int io_rank;
+          throw_assert_nomsg(MPI_Comm_rank(io_comm, &io_rank) == MPI_SUCCESS);
+
+
+          DST_BLK_PTR_T block_base;
+          DST_PTR_T edge_base, edge_count;
+          vector<DST_BLK_PTR_T> dst_blk_ptr;
+          vector<NODE_IDX_T> dst_idx;
+          vector<DST_PTR_T> dst_ptr;
+          vector<NODE_IDX_T> src_idx;
+          map<string, data::NamedAttrVal> edge_attr_map;
+          hsize_t local_read_blocks;
+
+          map<string, vector< pair<string,AttrKind> > > edge_attr_info;
+          size_t edge_attr_bytes = 0;
+          for (const string& attr_namespace : attr_namespaces) 
             {
-              int io_rank;
-              throw_assert_nomsg(MPI_Comm_rank(io_comm, &io_rank) == MPI_SUCCESS);
-
-
-              DST_BLK_PTR_T block_base;
-              DST_PTR_T edge_base, edge_count;
-              vector<DST_BLK_PTR_T> dst_blk_ptr;
-              vector<NODE_IDX_T> dst_idx;
-              vector<DST_PTR_T> dst_ptr;
-              vector<NODE_IDX_T> src_idx;
-              map<string, data::NamedAttrVal> edge_attr_map;
-              hsize_t local_read_blocks;
-
-              mpi::MPI_DEBUG(io_comm, "scatter_read_projection: reading projection ", src_pop_name, " -> ", dst_pop_name);
-              throw_assert(hdf5::read_projection_datasets(io_comm, file_name, src_pop_name, dst_pop_name,
-                                                          block_base, edge_base,
-                                                          dst_blk_ptr, dst_idx, dst_ptr, src_idx,
-                                                          total_num_edges, total_read_blocks, local_read_blocks,
-                                                          offset, numitems * size) >= 0,
-                           "error in read_projection_datasets");
+              throw_assert_nomsg(graph::get_edge_attributes(io_comm, file_name, src_pop_name, dst_pop_name,
+                                                            attr_namespace, edge_attr_info[attr_namespace]) >= 0);
+              for (const auto& attr_info : edge_attr_info[attr_namespace])
+                {
+                  edge_attr_bytes += attr_info.second.size;
+                }
+            }
+
+          mpi::MPI_DEBUG(io_comm, "scatter_read_projection: reading projection ", src_pop_name, " -> ", dst_pop_name);
+          throw_assert(hdf5::read_projection_datasets(io_comm, file_name, src_pop_name, dst_pop_name,
+                                                      block_base, edge_base,
+                                                      dst_blk_ptr, dst_idx, dst_ptr, src_idx,
+                                                      total_num_edges, total_read_blocks, local_read_blocks,
+                                                      offset, numitems * size, true,
+                                                      ptr_read_mode, block_assignment,
+                                                      edge_attr_bytes) >= 0,
+                       "error in read_projection_datasets");
           
-              mpi::MPI_DEBUG(io_comm, "scatter_read_projection: validating projection ", src_pop_name, " -> ", dst_pop_name);
-              // validate the edges
-              throw_assert_nomsg(validate_edge_list(dst_start, src_start, dst_blk_ptr, dst_idx, dst_ptr, src_idx,
-                                                    pop_search_ranges, pop_pairs) == true);
+          mpi::MPI_DEBUG(io_comm, "scatter_read_projection: validating projection ", src_pop_name, " -> ", dst_pop_name);
+          // validate the edges
+          throw_assert_nomsg(validate_edge_list(dst_start, src_start, dst_blk_ptr, dst_idx, dst_ptr, src_idx,
+                                                pop_search_ranges, pop_pairs) == true);
           
-              edge_count = src_idx.size();
-              mpi::MPI_DEBUG(io_comm, "scatter_read_projection: reading attributes for ", src_pop_name, " -> ", dst_pop_name);
-              for (const string& attr_namespace : attr_namespaces) 
-                {
-                  vector< pair<string,AttrKind> > edge_attr_info;
-                  throw_assert_nomsg(graph::get_edge_attributes(io_comm, file_name, src_pop_name, dst_pop_name,
-                                                                attr_namespace, edge_attr_info) >= 0);
-
-                  throw_assert_nomsg(graph::read_all_edge_attributes(io_comm, file_name,
-                                                                     src_pop_name, dst_pop_name, attr_namespace,
-                                                                     edge_base, edge_count, edge_attr_info,
-                                                                     edge_attr_map[attr_namespace]) >= 0);
+          edge_count = src_idx.size();
+          mpi::MPI_DEBUG(io_comm, "scatter_read_projection: reading attributes for ", src_pop_name, " -> ", dst_pop_name);
+          for (const string& attr_namespace : attr_namespaces) 
+            {
+              throw_assert_nomsg(graph::read_all_edge_attributes(io_comm, file_name,
+                                                                 src_pop_name, dst_pop_name, attr_namespace,
+                                                                 edge_base, edge_count, edge_attr_info[attr_namespace],
+                                                                 edge_attr_map[attr_namespace]) >= 0);
                   
-                  edge_attr_map[attr_namespace].attr_names(edge_attr_names[attr_namespace]);
-                }
+              edge_attr_map[attr_namespace].attr_names(edge_attr_names[attr_namespace]);
+            }
 
               
-              // append to the edge map
-              throw_assert(data::append_rank_edge_map(rank, size, dst_start, src_start, dst_blk_ptr, dst_idx, dst_ptr, src_idx,
-                                                      attr_namespaces, edge_attr_map, node_rank_map, num_edges, prj_rank_edge_map,
-                                                      edge_map_type) >= 0,
-                           "error in append_rank_edge_map");
+          // append to the edge map
+          throw_assert(data::append_rank_edge_map(rank, size, dst_start, src_start, dst_blk_ptr, dst_idx, dst_ptr, src_idx,
+                                                  attr_namespaces, edge_attr_map, node_rank_map, num_edges, prj_rank_edge_map,
+                                                  edge_map_type) >= 0,
+                       "error in append_rank_edge_map");
               
-              mpi::MPI_DEBUG(io_comm, "scatter_read_projection: read ", num_edges,
-                             " edges from projection ", src_pop_name, " -> ", dst_pop_name);
+          mpi::MPI_DEBUG(io_comm, "scatter_read_projection: read ", num_edges,
+                         " edges from projection ", src_pop_name, " -> ", dst_pop_name);
           
-              // ensure that all edges in the projection have been read and appended to edge_list
-              throw_assert(num_edges == src_idx.size(),
-                           "edge count mismatch: num_edges = " << num_edges <<
-                           " src_idx.size = " << src_idx.size());
+          // ensure that all edges in the projection have been read and appended to edge_list
+          throw_assert(num_edges == src_idx.size(),
+                       "edge count mismatch: num_edges = " << num_edges <<
+                       " src_idx.size = " << src_idx.size());
                            
           
-              size_t num_packed_edges = 0;
+          size_t num_packed_edges = 0;
           
-              data::serialize_rank_edge_map (size, rank, prj_rank_edge_map, 
-                                             num_packed_edges, sendcounts, sendbuf, sdispls);
+          data::serialize_rank_edge_map (size, rank, prj_rank_edge_map, 
+                                         num_packed_edges, sendcounts, sendbuf, sdispls);
 
-              // ensure the correct number of edges is being packed
-              throw_assert_nomsg(num_packed_edges == num_edges);
-              mpi::MPI_DEBUG(io_comm, "scatter_read_projection: packed ", num_packed_edges,
-                        " edges from projection ", src_pop_name, " -> ", dst_pop_name);
+          // ensure the correct number of edges is being packed
+          throw_assert_nomsg(num_packed_edges == num_edges);
+          mpi::MPI_DEBUG(io_comm, "scatter_read_projection: packed ", num_packed_edges,
+                         " edges from projection ", src_pop_name, " -> ", dst_pop_name);
 
-            } // is_io_rank
+        } // is_io_rank
 
           
-          MPI_Comm_free(&io_comm);
+      MPI_Comm_free(&io_comm);
+      MPI_Request bcast_req;
+      throw_assert(MPI_Ibcast(&total_read_blocks, 1, MPI_SIZE_T, io_rank_root, all_comm,
+                              &bcast_req) == MPI_SUCCESS,
+                   "error in MPI_Ibcast");
+      throw_assert(MPI_Wait(&bcast_req, MPI_STATUS_IGNORE) == MPI_SUCCESS,
+                   "error in MPI_Wait");
+
+      return 0;
+    }
+
+
+    /*****************************************************************************
+     * Unpack the edges of a projection received from the I/O ranks and
+     * distribute the edge attribute names read by rank 0
+     *****************************************************************************/
+
+    template <class EdgeContainer>
+    static int unpack_projection (MPI_Comm all_comm,
+                                  const string& src_pop_name, const string& dst_pop_name, 
+                                  const vector<string> &attr_namespaces,
+                                  const vector<char>& recvbuf,
+                                  const vector<size_t>& recvcounts,
+                                  const vector<size_t>& rdispls,
+                                  map<string, vector< vector<string> > >& edge_attr_names,
+                                  vector < EdgeContainer >& prj_vector,
+                                  vector < map <string, vector < vector<string> > > > & edge_attr_names_vector,
+                                  size_t &local_num_nodes, size_t &local_num_edges)
+    {
+      int rank, size;
+      throw_assert_nomsg(MPI_Comm_size(all_comm, &size) == MPI_SUCCESS);
+      throw_assert_nomsg(MPI_Comm_rank(all_comm, &rank) == MPI_SUCCESS);
+
+      EdgeContainer prj_edge_map;
+      local_num_nodes=0; local_num_edges=0;
+
+      mpi::MPI_DEBUG(all_comm, "scatter_read_projection: recvbuf size is ", recvbuf.size());
+
+      if (recvbuf.size() > 0)
+        {
+          data::deserialize_rank_edge_map (size, recvbuf, recvcounts, rdispls, 
+                                           prj_edge_map, local_num_nodes, local_num_edges);
+        }
+
+      mpi::MPI_DEBUG(all_comm, "scatter_read_projection: prj_edge_map size is ", prj_edge_map.size());
+        
+      if (!attr_namespaces.empty())
+        {
+          vector<char> sendbuf; uint32_t sendbuf_size=0;
+          if (rank == 0)
+            {
+              data::serialize_data(edge_attr_names, sendbuf);
+              sendbuf_size = sendbuf.size();
+            }
+            
           MPI_Request bcast_req;
-          throw_assert(MPI_Ibcast(&total_read_blocks, 1, MPI_SIZE_T, io_rank_root, all_comm,
+
+          throw_assert_nomsg(MPI_Barrier(all_comm) == MPI_SUCCESS);
+          throw_assert(MPI_Ibcast(&sendbuf_size, 1, MPI_UINT32_T, 0, all_comm,
+                                  &bcast_req) == MPI_SUCCESS,
+                       "error in MPI_Ibcast");
+          throw_assert(MPI_Wait(&bcast_req, MPI_STATUS_IGNORE) == MPI_SUCCESS,
+                       "error in MPI_Wait");
+          sendbuf.resize(sendbuf_size);
+          throw_assert(MPI_Ibcast(&sendbuf[0], sendbuf_size, MPI_CHAR, 0, all_comm,
                                   &bcast_req) == MPI_SUCCESS,
                        "error in MPI_Ibcast");
           throw_assert(MPI_Wait(&bcast_req, MPI_STATUS_IGNORE) == MPI_SUCCESS,
                        "error in MPI_Wait");
 
-          throw_assert_nomsg(mpi::alltoallv_vector<char>(all_comm, MPI_CHAR, sendcounts, sdispls, sendbuf,
-                                                         recvcounts, rdispls, recvbuf) >= 0);
+          mpi::MPI_DEBUG(all_comm, "scatter_read_projection: sendbuf size is ", sendbuf_size);
+            
+          if (rank != 0)
+            {
+              data::deserialize_data(sendbuf, edge_attr_names);
+            }
+          edge_attr_names_vector.push_back(edge_attr_names);
+            
+          mpi::MPI_DEBUG(all_comm, "scatter_read_projection: deserialized edge attr names");
         }
 
-        mpi::MPI_DEBUG(all_comm, "scatter_read_projection: recvbuf size is ", recvbuf.size());
+      mpi::MPI_DEBUG(all_comm, "scatter_read_projection: unpacked ", local_num_edges,
+                     " edges for projection ", src_pop_name, " -> ", dst_pop_name);
+      
+      prj_vector.push_back(std::move(prj_edge_map));
 
-        if (recvbuf.size() > 0)
-          {
-            data::deserialize_rank_edge_map (size, recvbuf, recvcounts, rdispls, 
-                                             prj_edge_map, local_num_nodes, local_num_edges);
-          }
+      return 0;
+    }
 
-        mpi::MPI_DEBUG(all_comm, "scatter_read_projection: prj_edge_map size is ", prj_edge_map.size());
-        
-        if (!attr_namespaces.empty())
-          {
-            vector<char> sendbuf; uint32_t sendbuf_size=0;
-            if (rank == 0)
-              {
-                data::serialize_data(edge_attr_names, sendbuf);
-                sendbuf_size = sendbuf.size();
-              }
-            
-            MPI_Request bcast_req;
-
-            throw_assert_nomsg(MPI_Barrier(all_comm) == MPI_SUCCESS);
-            throw_assert(MPI_Ibcast(&sendbuf_size, 1, MPI_UINT32_T, 0, all_comm,
-                                    &bcast_req) == MPI_SUCCESS,
-                         "error in MPI_Ibcast");
-            throw_assert(MPI_Wait(&bcast_req, MPI_STATUS_IGNORE) == MPI_SUCCESS,
-                         "error in MPI_Wait");
-            sendbuf.resize(sendbuf_size);
-            throw_assert(MPI_Ibcast(&sendbuf[0], sendbuf_size, MPI_CHAR, 0, all_comm,
-                                    &bcast_req) == MPI_SUCCESS,
-                         "error in MPI_Ibcast");
-            throw_assert(MPI_Wait(&bcast_req, MPI_STATUS_IGNORE) == MPI_SUCCESS,
-                         "error in MPI_Wait");
-
-            mpi::MPI_DEBUG(all_comm, "scatter_read_projection: sendbuf size is ", sendbuf_size);
-            
-            if (rank != 0)
-              {
-                data::deserialize_data(sendbuf, edge_attr_names);
-              }
-            edge_attr_names_vector.push_back(edge_attr_names);
-            
-            mpi::MPI_DEBUG(all_comm, "scatter_read_projection: deserialized edge attr names");
-          }
+    
+    /*****************************************************************************
+     * Load and scatter edge data structures 
+     *****************************************************************************/
+
+    template <class EdgeContainer>
+    static int scatter_read_projection_edges (MPI_Comm all_comm, const int io_size, EdgeMapType edge_map_type, 
+                                              const string& file_name, const string& src_pop_name, const string& dst_pop_name, 
+                                              const NODE_IDX_T& src_start,
+                                              const NODE_IDX_T& dst_start,
+                                              const vector<string> &attr_namespaces,
+                                              const data::NodeRankMap& node_rank_map,
+                                              const pop_search_range_map_t& pop_search_ranges,
+                                              const set< pair<pop_t, pop_t> >& pop_pairs,
+                                              vector < EdgeContainer >& prj_vector,
+                                              vector < map <string, vector < vector<string> > > > & edge_attr_names_vector,
+                                              size_t &local_num_nodes, size_t &local_num_edges, size_t &total_num_edges,
+                                              hsize_t& total_read_blocks,
+                                              size_t offset, size_t numitems,
+                                              ProjectionPtrReadMode ptr_read_mode,
+                                              ProjectionBlockAssignment block_assignment)
+    {
+      map<string, vector< vector<string> > > edge_attr_names;
+      vector<char> recvbuf;
+      vector<size_t> recvcounts, rdispls;
+
+      int size;
+      throw_assert_nomsg(MPI_Comm_size(all_comm, &size) == MPI_SUCCESS);
+
+      {
+        vector<char> sendbuf; 
+        vector<size_t> sendcounts, sdispls;
+
+        read_pack_projection(all_comm, io_size, edge_map_type, file_name,
+                             src_pop_name, dst_pop_name, src_start, dst_start,
+                             attr_namespaces, node_rank_map, pop_search_ranges, pop_pairs,
+                             total_num_edges, total_read_blocks, offset, numitems,
+                             ptr_read_mode, block_assignment,
+                             sendcounts, sdispls, sendbuf, edge_attr_names);
+
+        // only the I/O ranks have data to send
+        throw_assert_nomsg(mpi::alltoallv_vector<char>(all_comm, MPI_CHAR, sendcounts, sdispls, sendbuf,
+                                                       recvcounts, rdispls, recvbuf,
+                                                       mpi::use_sparse_exchange(size, io_size)) >= 0);
       }
 
+      return unpack_projection(all_comm, src_pop_name, dst_pop_name, attr_namespaces,
+                               recvbuf, recvcounts, rdispls, edge_attr_names,
+                               prj_vector, edge_attr_names_vector,
+                               local_num_nodes, local_num_edges);
+    }
+
+
+    // State of a projection whose exchange is in flight
+    struct ProjectionExchange
+    {
+      string src_pop_name, dst_pop_name;
+      vector<char> sendbuf, recvbuf;
+      vector<size_t> sendcounts, sdispls, recvcounts, rdispls;
+      map<string, vector< vector<string> > > edge_attr_names;
+      vector<MPI_Request> requests;
+    };
+
+    
+    /*****************************************************************************
+     * Load and scatter several projections, reading each projection while
+     * the exchanges of up to max_in_flight preceding projections proceed
+     *****************************************************************************/
+
+    int scatter_read_projections (MPI_Comm all_comm, const int io_size, EdgeMapType edge_map_type, 
+                                  const string& file_name,
+                                  const vector< pair<string, string> >& prj_names,
+                                  const vector< pair<NODE_IDX_T, NODE_IDX_T> >& prj_starts,
+                                  const vector<string> &attr_namespaces,
+                                  const data::NodeRankMap& node_rank_map,
+                                  const pop_search_range_map_t& pop_search_ranges,
+                                  const set< pair<pop_t, pop_t> >& pop_pairs,
+                                  vector < edge_map_t >& prj_vector,
+                                  vector < map <string, vector < vector<string> > > > & edge_attr_names_vector,
+                                  size_t &local_num_nodes, size_t &local_num_edges, size_t &total_num_edges,
+                                  const size_t max_in_flight,
+                                  ProjectionPtrReadMode ptr_read_mode,
+                                  ProjectionBlockAssignment block_assignment)
+    {
+      throw_assert(prj_names.size() == prj_starts.size(),
+                   "scatter_read_projections: mismatch between projection names and start indices");
       
-      mpi::MPI_DEBUG(all_comm, "scatter_read_projection: unpacked ", local_num_edges,
-                     " edges for projection ", src_pop_name, " -> ", dst_pop_name);
+      deque<ProjectionExchange> in_flight;
+
+      auto complete_front = [&] ()
+        {
+          ProjectionExchange& exchange = in_flight.front();
+          mpi::ialltoallv_vector_wait(exchange.requests);
+          exchange.sendbuf.clear();
+          unpack_projection(all_comm, exchange.src_pop_name, exchange.dst_pop_name, attr_namespaces,
+                            exchange.recvbuf, exchange.recvcounts, exchange.rdispls,
+                            exchange.edge_attr_names,
+                            prj_vector, edge_attr_names_vector,
+                            local_num_nodes, local_num_edges);
+          in_flight.pop_front();
+        };
       
-      prj_vector.push_back(prj_edge_map);
+      for (size_t i = 0; i < prj_names.size(); i++)
+        {
+          hsize_t total_read_blocks = 0;
+          
+          in_flight.emplace_back();
+          ProjectionExchange& exchange = in_flight.back();
+          exchange.src_pop_name = prj_names[i].first;
+          exchange.dst_pop_name = prj_names[i].second;
+
+          read_pack_projection(all_comm, io_size, edge_map_type, file_name,
+                               exchange.src_pop_name, exchange.dst_pop_name,
+                               prj_starts[i].first, prj_starts[i].second,
+                               attr_namespaces, node_rank_map, pop_search_ranges, pop_pairs,
+                               total_num_edges, total_read_blocks, 0, 0,
+                               ptr_read_mode, block_assignment,
+                               exchange.sendcounts, exchange.sdispls, exchange.sendbuf,
+                               exchange.edge_attr_names);
+
+          throw_assert_nomsg(mpi::ialltoallv_vector_start<char>(all_comm, MPI_CHAR,
+                                                                exchange.sendcounts, exchange.sdispls,
+                                                                exchange.sendbuf,
+                                                                exchange.recvcounts, exchange.rdispls,
+                                                                exchange.recvbuf,
+                                                                exchange.requests) >= 0);
+
+          while (in_flight.size() > std::max(max_in_flight, (size_t)1))
+            {
+              complete_front();
+            }
+        }
+
+      while (!in_flight.empty())
+        {
+          complete_front();
+        }
 
       return 0;
     }
 
 
+    int scatter_read_projection (MPI_Comm all_comm, const int io_size, EdgeMapType edge_map_type, 
+                                 const string& file_name, const string& src_pop_name, const string& dst_pop_name, 
+                                 const NODE_IDX_T& src_start,
+                                 const NODE_IDX_T& dst_start,
+                                 const vector<string> &attr_namespaces,
+                                 const data::NodeRankMap& node_rank_map,
+                                 const pop_search_range_map_t& pop_search_ranges,
+                                 const set< pair<pop_t, pop_t> >& pop_pairs,
+                                 vector < edge_map_t >& prj_vector,
+                                 vector < map <string, vector < vector<string> > > > & edge_attr_names_vector,
+                                 size_t &local_num_nodes, size_t &local_num_edges, size_t &total_num_edges,
+                                 hsize_t& total_read_blocks,
+                                 size_t offset, size_t numitems,
+                                 ProjectionPtrReadMode ptr_read_mode,
+                                 ProjectionBlockAssignment block_assignment)
+    {
+      return scatter_read_projection_edges(all_comm, io_size, edge_map_type, file_name,
+                                           src_pop_name, dst_pop_name, src_start, dst_start,
+                                           attr_namespaces, node_rank_map,
+                                           pop_search_ranges, pop_pairs,
+                                           prj_vector, edge_attr_names_vector,
+                                           local_num_nodes, local_num_edges, total_num_edges,
+                                           total_read_blocks, offset, numitems,
+                                           ptr_read_mode, block_assignment);
+    }
+
+
+    int scatter_read_projection (MPI_Comm all_comm, const int io_size, EdgeMapType edge_map_type, 
+                                 const string& file_name, const string& src_pop_name, const string& dst_pop_name, 
+                                 const NODE_IDX_T& src_start,
+                                 const NODE_IDX_T& dst_start,
+                                 const vector<string> &attr_namespaces,
+                                 const data::NodeRankMap& node_rank_map,
+                                 const pop_search_range_map_t& pop_search_ranges,
+                                 const set< pair<pop_t, pop_t> >& pop_pairs,
+                                 vector < edge_csr_t >& prj_vector,
+                                 vector < map <string, vector < vector<string> > > > & edge_attr_names_vector,
+                                 size_t &local_num_nodes, size_t &local_num_edges, size_t &total_num_edges,
+                                 hsize_t& total_read_blocks,
+                                 size_t offset, size_t numitems,
+                                 ProjectionPtrReadMode ptr_read_mode,
+                                 ProjectionBlockAssignment block_assignment)
+    {
+      return scatter_read_projection_edges(all_comm, io_size, edge_map_type, file_name,
+                                           src_pop_name, dst_pop_name, src_start, dst_start,
+                                           attr_namespaces, node_rank_map,
+                                           pop_search_ranges, pop_pairs,
+                                           prj_vector, edge_attr_names_vector,
+                                           local_num_nodes, local_num_edges, total_num_edges,
+                                           total_read_blocks, offset, numitems,
+                                           ptr_read_mode, block_assignment);
+    }
+
+
   }
   
 }
@@ -51,7 +51,7 @@ namespace neuroh5
      const NODE_IDX_T&          dst_start,
      const vector<string>&      attr_namespaces,
      const std::vector<NODE_IDX_T>&  selection,
-     const node_rank_map_t&    node_rank_map,
+     const data::NodeRankMap&  node_rank_map,
      vector<edge_map_t>&       prj_vector,
      vector < map <string, vector < vector<string> > > > & edge_attr_names_vector,
      size_t&                    local_num_nodes,
@@ -197,8 +197,10 @@ namespace neuroh5
 #ifdef NEUROH5_DEBUG
           MPI_Barrier(comm);
 #endif
+          // only the I/O ranks have data to send
           throw_assert_nomsg(mpi::alltoallv_vector<char>(comm, MPI_CHAR, sendcounts, sdispls, sendbuf,
-                                                         recvcounts, rdispls, recvbuf) >= 0);
+                                                         recvcounts, rdispls, recvbuf,
+                                                         mpi::use_sparse_exchange(size, io_size)) >= 0);
 
         }
 
@@ -0,0 +1,280 @@
+// -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+//==============================================================================
+///  @file stitch_graph.cc
+///
+///  Merges projections written in subfile mode into the output file.
+///
+///  Copyright (C) 2016-2025 Project NeuroH5.
+//==============================================================================
+
+#include "neuroh5_types.hh"
+#include "stitch_graph.hh"
+#include "append_graph.hh"
+#include "read_graph.hh"
+#include "projection_names.hh"
+#include "edge_attributes.hh"
+#include "group_contents.hh"
+#include "exists_group.hh"
+#include "path_names.hh"
+#include "subfiles.hh"
+#include "attr_index.hh"
+#include "attr_val.hh"
+#include "attr_kind_dispatch.hh"
+#include "serialize_data.hh"
+#include "mpi_debug.hh"
+#include "throw_assert.hh"
+
+#include <hdf5.h>
+#include <mpi.h>
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace neuroh5
+{
+  namespace graph
+  {
+
+    // projection -> edge attribute namespace -> edge attributes
+    typedef map< pair<string, string>,
+                 map< string, vector< pair<string, AttrKind> > > > subfile_projection_map_t;
+
+
+    static void add_edge_attribute
+    (
+     const pair<string, AttrKind>& attr,
+     data::AttrSet&                attr_set
+     )
+    {
+      const string& attr_name = attr.first;
+      const AttrKind& attr_kind = attr.second;
+      data::attr_kind_dispatch(attr_kind, [&] (auto type_ptr)
+                               {
+                                 typedef typename std::remove_pointer<decltype(type_ptr)>::type T;
+                                 attr_set.add<T>(attr_name);
+                               });
+    }
+
+
+    static bool same_edge_attributes
+    (
+     const map< string, vector< pair<string, AttrKind> > >& a,
+     const map< string, vector< pair<string, AttrKind> > >& b
+     )
+    {
+      auto same_attr = [](const pair<string, AttrKind>& x, const pair<string, AttrKind>& y)
+        {
+          return (x.first == y.first) && (x.second.type == y.second.type) &&
+          (x.second.size == y.second.size);
+        };
+      auto same_ns = [&same_attr](const pair< const string, vector< pair<string, AttrKind> > >& x,
+                                  const pair< const string, vector< pair<string, AttrKind> > >& y)
+        {
+          return (x.first == y.first) &&
+          std::equal(x.second.begin(), x.second.end(), y.second.begin(), y.second.end(), same_attr);
+        };
+      return std::equal(a.begin(), a.end(), b.begin(), b.end(), same_ns);
+    }
+
+
+    // The edge attribute values read from a subfile are ordered by
+    // attribute name, which must agree with the index used for writing
+    static void check_edge_attribute_names
+    (
+     const vector< vector<string> >& attr_names,
+     const data::AttrIndex&          attr_index
+     )
+    {
+      throw_assert(attr_names.size() == data::AttrVal::num_attr_types,
+                   "stitch_graph_subfiles: invalid edge attribute names");
+      throw_assert((attr_names[data::AttrVal::attr_index_float]  == attr_index.attr_names<float>()) &&
+                   (attr_names[data::AttrVal::attr_index_uint8]  == attr_index.attr_names<uint8_t>()) &&
+                   (attr_names[data::AttrVal::attr_index_int8]   == attr_index.attr_names<int8_t>()) &&
+                   (attr_names[data::AttrVal::attr_index_uint16] == attr_index.attr_names<uint16_t>()) &&
+                   (attr_names[data::AttrVal::attr_index_int16]  == attr_index.attr_names<int16_t>()) &&
+                   (attr_names[data::AttrVal::attr_index_uint32] == attr_index.attr_names<uint32_t>()) &&
+                   (attr_names[data::AttrVal::attr_index_int32]  == attr_index.attr_names<int32_t>()),
+                   "stitch_graph_subfiles: edge attribute mismatch between subfiles");
+    }
+
+
+    int stitch_graph_subfiles
+    (
+     MPI_Comm            comm,
+     const string&       file_name,
+     const hsize_t       chunk_size,
+     const FilterConfig& filters
+     )
+    {
+      int rank, size;
+      throw_assert(MPI_Comm_size(comm, &size) == MPI_SUCCESS,
+                   "stitch_graph_subfiles: unable to obtain MPI communicator size");
+      throw_assert(MPI_Comm_rank(comm, &rank) == MPI_SUCCESS,
+                   "stitch_graph_subfiles: unable to obtain MPI communicator rank");
+
+      size_t num_subfiles = 0;
+      throw_assert(hdf5::num_subfiles(comm, file_name, num_subfiles) >= 0,
+                   "stitch_graph_subfiles: unable to determine number of subfiles");
+
+      // MPI rank 0 enumerates the projections and edge attributes in
+      // the subfiles and broadcasts them
+      subfile_projection_map_t subfile_projections;
+      vector< vector< pair<string, string> > > subfile_prj_names(num_subfiles);
+      {
+        vector<char> sendbuf; uint32_t sendbuf_size=0;
+        if (rank == 0)
+          {
+            for (size_t i = 0; i < num_subfiles; i++)
+              {
+                const string subfile_name = hdf5::subfile_name(file_name, i);
+                vector< pair<string, string> >& prj_names = subfile_prj_names[i];
+
+                // subfiles that only contain cell attributes have no
+                // projections group
+                hid_t file = H5Fopen(subfile_name.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+                throw_assert(file >= 0,
+                             "stitch_graph_subfiles: unable to open subfile " << subfile_name);
+                bool has_projections = (hdf5::exists_group(file, hdf5::PROJECTIONS) > 0);
+                throw_assert(H5Fclose(file) >= 0,
+                             "stitch_graph_subfiles: unable to close subfile " << subfile_name);
+                if (!has_projections)
+                  continue;
+
+                throw_assert(read_projection_names(MPI_COMM_SELF, subfile_name, prj_names) >= 0,
+                             "stitch_graph_subfiles: unable to read projection names from " << subfile_name);
+
+                for (const auto& prj_name : prj_names)
+                  {
+                    const string& src_pop_name = prj_name.first;
+                    const string& dst_pop_name = prj_name.second;
+
+                    vector<string> group_names;
+                    hid_t file = H5Fopen(subfile_name.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+                    throw_assert(file >= 0,
+                                 "stitch_graph_subfiles: unable to open subfile " << subfile_name);
+                    throw_assert(hdf5::group_contents(MPI_COMM_SELF, file, hdf5::projection_prefix(src_pop_name, dst_pop_name),
+                                                             group_names) >= 0,
+                                 "stitch_graph_subfiles: unable to read projection group " <<
+                                 src_pop_name << " -> " << dst_pop_name);
+                    throw_assert(H5Fclose(file) >= 0,
+                                 "stitch_graph_subfiles: unable to close subfile " << subfile_name);
+
+                    map< string, vector< pair<string, AttrKind> > > prj_attributes;
+                    for (const string& name_space : group_names)
+                      {
+                        if (name_space == hdf5::EDGES)
+                          continue;
+                        vector< pair<string, AttrKind> > attributes;
+                        throw_assert(get_edge_attributes(MPI_COMM_SELF, subfile_name,
+                                                         src_pop_name, dst_pop_name,
+                                                         name_space, attributes) >= 0,
+                                     "stitch_graph_subfiles: unable to read edge attributes from " << subfile_name);
+                        prj_attributes[name_space] = attributes;
+                      }
+
+                    auto it = subfile_projections.find(prj_name);
+                    if (it == subfile_projections.end())
+                      {
+                        subfile_projections.insert(make_pair(prj_name, prj_attributes));
+                      }
+                    else
+                      {
+                        throw_assert(same_edge_attributes(it->second, prj_attributes),
+                                     "stitch_graph_subfiles: projection " << src_pop_name << " -> " <<
+                                     dst_pop_name << " has different edge attributes in " << subfile_name);
+                      }
+                  }
+              }
+            data::serialize_data(make_pair(subfile_projections, subfile_prj_names), sendbuf);
+            sendbuf_size = sendbuf.size();
+          }
+
+        throw_assert(MPI_Bcast(&sendbuf_size, 1, MPI_UINT32_T, 0, comm) == MPI_SUCCESS,
+                     "stitch_graph_subfiles: error in MPI_Bcast");
+        sendbuf.resize(sendbuf_size);
+        throw_assert(MPI_Bcast(&sendbuf[0], sendbuf_size, MPI_CHAR, 0, comm) == MPI_SUCCESS,
+                     "stitch_graph_subfiles: error in MPI_Bcast");
+        if (rank != 0)
+          {
+            pair< subfile_projection_map_t, vector< vector< pair<string, string> > > > metadata;
+            data::deserialize_data(sendbuf, metadata);
+            subfile_projections = std::move(metadata.first);
+            subfile_prj_names = std::move(metadata.second);
+          }
+      }
+
+      for (const auto& prj_item : subfile_projections)
+        {
+          const string& src_pop_name = prj_item.first.first;
+          const string& dst_pop_name = prj_item.first.second;
+
+          // namespaces are written in map order by append_projection
+          map <string, pair <size_t, data::AttrIndex > > edge_attr_index;
+          vector<string> edge_attr_name_spaces;
+          for (const auto& ns_item : prj_item.second)
+            {
+              data::AttrSet attr_set;
+              for (const auto& attr : ns_item.second)
+                {
+                  add_edge_attribute(attr, attr_set);
+                }
+              edge_attr_index[ns_item.first] = make_pair(edge_attr_name_spaces.size(),
+                                                         data::AttrIndex(attr_set));
+              edge_attr_name_spaces.push_back(ns_item.first);
+            }
+
+          for (size_t round_start = 0; round_start < num_subfiles; round_start += size)
+            {
+              const size_t subfile_index = round_start + rank;
+              edge_map_t edge_map;
+
+              if (subfile_index < num_subfiles)
+                {
+                  const vector< pair<string, string> >& prj_names = subfile_prj_names[subfile_index];
+                  if (find(prj_names.begin(), prj_names.end(), prj_item.first) != prj_names.end())
+                    {
+                      const string subfile_name = hdf5::subfile_name(file_name, subfile_index);
+                      vector<edge_map_t> prj_vector;
+                      vector < map <string, vector < vector<string> > > > edge_attr_names_vector;
+                      size_t total_num_nodes = 0, local_num_edges = 0, total_num_edges = 0;
+
+                      throw_assert(read_graph(MPI_COMM_SELF, subfile_name, edge_attr_name_spaces,
+                                              { prj_item.first }, prj_vector, edge_attr_names_vector,
+                                              total_num_nodes, local_num_edges, total_num_edges) >= 0,
+                                   "stitch_graph_subfiles: unable to read projection " <<
+                                   src_pop_name << " -> " << dst_pop_name << " from " << subfile_name);
+
+                      for (const auto& ns_item : edge_attr_index)
+                        {
+                          check_edge_attribute_names(edge_attr_names_vector[0][ns_item.first],
+                                                     ns_item.second.second);
+                        }
+                      edge_map = std::move(prj_vector[0]);
+                    }
+                }
+
+              mpi::MPI_DEBUG(comm, "stitch_graph_subfiles: ", src_pop_name, " -> ", dst_pop_name,
+                             ": appending subfiles ", round_start, " to ",
+                             std::min(round_start + size, num_subfiles) - 1);
+
+              throw_assert(append_graph(comm, size, file_name, src_pop_name, dst_pop_name,
+                                        edge_attr_index, edge_map, chunk_size, filters) >= 0,
+                           "stitch_graph_subfiles: unable to append projection " <<
+                           src_pop_name << " -> " << dst_pop_name);
+            }
+        }
+
+      throw_assert(MPI_Barrier(comm) == MPI_SUCCESS,
+                   "stitch_graph_subfiles: error in MPI_Barrier");
+
+      return 0;
+    }
+
+  }
+}
@@ -16,11 +16,13 @@
 #include "cell_populations.hh"
 #include "write_graph.hh"
 #include "write_projection.hh"
+#include "projection_index.hh"
 #include "path_names.hh"
 #include "sort_permutation.hh"
 #include "serialize_edge.hh"
 #include "range_sample.hh"
 #include "node_rank_map.hh"
+#include "file_access.hh"
 #include "throw_assert.hh"
 #include "debug.hh"
 
@@ -44,7 +46,9 @@ namespace neuroh5
      const string&    dst_pop_name,
      const std::map <std::string, std::pair <size_t, data::AttrIndex > >& edge_attr_index,
      const edge_map_t&  input_edge_map,
-     const hsize_t    chunk_size
+     const hsize_t    chunk_size,
+     const bool       build_index,
+     const FilterConfig& filters
      )
     {
       size_t io_size;
@@ -264,9 +268,7 @@ namespace neuroh5
         {
           hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
           throw_assert_nomsg(fapl >= 0);
-#ifdef HDF5_IS_PARALLEL
-          throw_assert_nomsg(H5Pset_fapl_mpio(fapl, io_comm, MPI_INFO_NULL) >= 0);
-#endif
+          throw_assert_nomsg(hdf5::set_parallel_file_access(fapl, io_comm) >= 0);
           
           hid_t file = H5Fopen(file_name.c_str(), H5F_ACC_RDWR, fapl);
           throw_assert_nomsg(file >= 0);
@@ -274,7 +276,7 @@ namespace neuroh5
           write_projection (io_comm, file, src_pop_name, dst_pop_name,
                             src_start, src_end, dst_start, dst_end,
                             num_unpacked_edges, prj_edge_map, edge_attr_index,
-                            chunk_size);
+                            chunk_size, 1000000, true, filters);
           
           throw_assert_nomsg(H5Fclose(file) >= 0);
           throw_assert_nomsg(H5Pclose(fapl) >= 0);
@@ -284,6 +286,11 @@ namespace neuroh5
       throw_assert_nomsg(MPI_Comm_free(&io_comm) == MPI_SUCCESS);
       MPI_Barrier(all_comm);
 
+      if (build_index)
+        {
+          throw_assert_nomsg(hdf5::write_projection_index(all_comm, file_name, src_pop_name, dst_pop_name) >= 0);
+        }
+
       return 0;
     }
   }
@@ -5,6 +5,7 @@
 #include "path_names.hh"
 #include "write_projection.hh"
 #include "write_template.hh"
+#include "dataset_filters.hh"
 #include "edge_attributes.hh"
 #include "throw_assert.hh"
 
@@ -35,7 +36,8 @@ namespace neuroh5
      const std::map <std::string, std::pair <size_t, data::AttrIndex > >& edge_attr_index,
      hsize_t                   chunk_size,
      hsize_t                   block_size,
-     const bool collective
+     const bool collective,
+     const FilterConfig&       filters
      )
     {
       // do a sanity check on the input
@@ -176,9 +178,7 @@ namespace neuroh5
         {
           throw_assert_nomsg(H5Pset_chunk(dcpl, 1, &dst_blk_idx_dims ) >= 0);
         }
-#ifdef H5_HAS_PARALLEL_DEFLATE
-      throw_assert_nomsg(H5Pset_deflate(dcpl, 9) >= 0);
-#endif
+      hdf5::set_dataset_filters(dcpl, filters.index, NODE_IDX_H5_FILE_T);
       hid_t dset = H5Dcreate2(file, path.c_str(), NODE_IDX_H5_FILE_T, fspace,
                               lcpl, dcpl, H5P_DEFAULT);
       throw_assert_nomsg(dset >= 0);
@@ -235,9 +235,7 @@ namespace neuroh5
         {
           throw_assert_nomsg(H5Pset_chunk(dcpl, 1, &dst_blk_ptr_dims ) >= 0);
         }
-#ifdef H5_HAS_PARALLEL_DEFLATE
-      throw_assert_nomsg(H5Pset_deflate(dcpl, 9) >= 0);
-#endif
+      hdf5::set_dataset_filters(dcpl, filters.pointer, DST_BLK_PTR_H5_FILE_T);
       dset = H5Dcreate2(file, path.c_str(), DST_BLK_PTR_H5_FILE_T,
                         fspace, lcpl, dcpl, H5P_DEFAULT);
       throw_assert_nomsg(dset >= 0);
@@ -312,9 +310,7 @@ namespace neuroh5
         {
           throw_assert_nomsg(H5Pset_chunk(dcpl, 1, &dst_ptr_dims ) >= 0);
         }
-#ifdef H5_HAS_PARALLEL_DEFLATE
-      throw_assert_nomsg(H5Pset_deflate(dcpl, 9) >= 0);
-#endif
+      hdf5::set_dataset_filters(dcpl, filters.pointer, DST_PTR_H5_FILE_T);
       dset = H5Dcreate2(file, path.c_str(), DST_PTR_H5_FILE_T,
                         fspace, lcpl, dcpl, H5P_DEFAULT);
       throw_assert_nomsg(dset >= 0);
@@ -360,9 +356,7 @@ namespace neuroh5
         {
           throw_assert_nomsg(H5Pset_chunk(dcpl, 1, &src_idx_dims ) >= 0);
         }
-#ifdef H5_HAS_PARALLEL_DEFLATE
-      throw_assert_nomsg(H5Pset_deflate(dcpl, 9) >= 0);
-#endif
+      hdf5::set_dataset_filters(dcpl, filters.index, NODE_IDX_H5_FILE_T);
       dset = H5Dcreate2(file, path.c_str(), NODE_IDX_H5_FILE_T,
                         fspace, lcpl, dcpl, H5P_DEFAULT);
       throw_assert_nomsg(dset >= 0);
@@ -435,19 +429,26 @@ namespace neuroh5
       throw_assert_nomsg(MPI_Barrier(comm) == MPI_SUCCESS);
 
       write_edge_attribute_map<float>(comm, file, src_pop_name, dst_pop_name,
-                                      edge_attr_map, edge_attr_index);
+                                      edge_attr_map, edge_attr_index,
+                                      chunk_size, filters.value);
       write_edge_attribute_map<uint8_t>(comm, file, src_pop_name, dst_pop_name,
-                                        edge_attr_map, edge_attr_index);
+                                        edge_attr_map, edge_attr_index,
+                                        chunk_size, filters.value);
       write_edge_attribute_map<uint16_t>(comm, file, src_pop_name, dst_pop_name,
-                                         edge_attr_map, edge_attr_index);
+                                         edge_attr_map, edge_attr_index,
+                                         chunk_size, filters.value);
       write_edge_attribute_map<uint32_t>(comm, file, src_pop_name, dst_pop_name,
-                                         edge_attr_map, edge_attr_index);
+                                         edge_attr_map, edge_attr_index,
+                                         chunk_size, filters.value);
       write_edge_attribute_map<int8_t>(comm, file, src_pop_name, dst_pop_name,
-                                       edge_attr_map, edge_attr_index);
+                                       edge_attr_map, edge_attr_index,
+                                       chunk_size, filters.value);
       write_edge_attribute_map<int16_t>(comm, file, src_pop_name, dst_pop_name,
-                                        edge_attr_map, edge_attr_index);
+                                        edge_attr_map, edge_attr_index,
+                                        chunk_size, filters.value);
       write_edge_attribute_map<int32_t>(comm, file, src_pop_name, dst_pop_name,
-                                        edge_attr_map, edge_attr_index);
+                                        edge_attr_map, edge_attr_index,
+                                        chunk_size, filters.value);
       
       // clean-up
       throw_assert_nomsg(H5Pclose(dcpl) >= 0);
@@ -0,0 +1,247 @@
+// -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+//==============================================================================
+///  @file cell_index_partition.cc
+///
+///  Distributed lookup of the cell index and attribute pointer of a
+///  cell attribute.
+///
+///  Copyright (C) 2016-2025 Project NeuroH5.
+//==============================================================================
+
+#include "cell_index_partition.hh"
+#include "dataset_num_elements.hh"
+#include "exists_dataset.hh"
+#include "path_names.hh"
+#include "read_template.hh"
+#include "rank_range.hh"
+#include "alltoallv_template.hh"
+#include "sort_permutation.hh"
+#include "throw_assert.hh"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace neuroh5
+{
+  namespace hdf5
+  {
+
+    herr_t read_cell_index_partition
+    (
+     MPI_Comm                        comm,
+     const hid_t&                    loc,
+     const std::string&              path,
+     const CELL_IDX_T                pop_start,
+     CellIndexPartition&             partition
+     )
+    {
+      herr_t status = 0;
+
+      int ssize, srank;
+      throw_assert(MPI_Comm_size(comm, &ssize) == MPI_SUCCESS,
+                   "read_cell_index_partition: unable to obtain MPI communicator size");
+      throw_assert(MPI_Comm_rank(comm, &srank) == MPI_SUCCESS,
+                   "read_cell_index_partition: unable to obtain MPI communicator rank");
+      const size_t size = ssize, rank = srank;
+
+      partition.index.clear();
+      partition.ranges.clear();
+
+      string index_path = path + "/" + CELL_INDEX;
+      string ptr_path = path + "/" + ATTR_PTR;
+
+      // attributes without a pointer have no values to select
+      if (exists_dataset (loc, ptr_path) <= 0)
+        return status;
+
+      hsize_t dset_size = dataset_num_elements (loc, index_path);
+      if (dset_size == 0)
+        return status;
+
+      vector< pair<hsize_t,hsize_t> > rank_ranges;
+      mpi::rank_ranges(dset_size, size, rank_ranges);
+      const hsize_t start = rank_ranges[rank].first;
+      const hsize_t block = rank_ranges[rank].second;
+
+      hid_t rapl = H5Pcreate (H5P_DATASET_XFER);
+#ifdef HDF5_IS_PARALLEL
+      status = H5Pset_dxpl_mpio (rapl, H5FD_MPIO_COLLECTIVE);
+      throw_assert(status >= 0,
+                   "read_cell_index_partition: error in H5Pset_dxpl_mpio");
+#endif
+
+      vector<CELL_IDX_T> local_index(block);
+      status = read<NODE_IDX_T> (loc, index_path, start, block,
+                                 NODE_IDX_H5_NATIVE_T, local_index, rapl);
+      throw_assert(status >= 0,
+                   "read_cell_index_partition: error reading " << index_path);
+
+      vector<ATTR_PTR_T> local_ptr(block > 0 ? block+1 : 0);
+      status = read<ATTR_PTR_T> (loc, ptr_path, start, local_ptr.size(),
+                                 ATTR_PTR_H5_NATIVE_T, local_ptr, rapl);
+      throw_assert(status >= 0,
+                   "read_cell_index_partition: error reading " << ptr_path);
+
+      throw_assert(H5Pclose(rapl) >= 0,
+                   "read_cell_index_partition: unable to close property list");
+
+      // send each entry to the rank that owns its cell id
+      vector<size_t> sendcounts(size, 0), sdispls(size, 0);
+      for (size_t i = 0; i < block; i++)
+        {
+          sendcounts[(local_index[i] + pop_start) % size]++;
+        }
+      for (size_t p = 1; p < size; p++)
+        {
+          sdispls[p] = sdispls[p-1] + sendcounts[p-1];
+        }
+
+      vector<CELL_IDX_T> send_index(block);
+      vector<ATTR_PTR_T> send_start(block), send_count(block);
+      {
+        vector<size_t> pos(sdispls);
+        for (size_t i = 0; i < block; i++)
+          {
+            const CELL_IDX_T id = local_index[i] + pop_start;
+            const size_t j = pos[id % size]++;
+            send_index[j] = id;
+            send_start[j] = local_ptr[i];
+            send_count[j] = local_ptr[i+1] - local_ptr[i];
+          }
+      }
+      local_index.clear();
+      local_ptr.clear();
+
+      vector<size_t> recvcounts, rdispls;
+      vector<CELL_IDX_T> recv_index;
+      vector<ATTR_PTR_T> recv_start, recv_count;
+      throw_assert(mpi::alltoallv_vector<CELL_IDX_T>(comm, MPI_CELL_IDX_T, sendcounts, sdispls, send_index,
+                                                     recvcounts, rdispls, recv_index) >= 0,
+                   "read_cell_index_partition: error in alltoallv");
+      throw_assert(mpi::alltoallv_vector<ATTR_PTR_T>(comm, MPI_ATTR_PTR_T, sendcounts, sdispls, send_start,
+                                                     recvcounts, rdispls, recv_start) >= 0,
+                   "read_cell_index_partition: error in alltoallv");
+      throw_assert(mpi::alltoallv_vector<ATTR_PTR_T>(comm, MPI_ATTR_PTR_T, sendcounts, sdispls, send_count,
+                                                     recvcounts, rdispls, recv_count) >= 0,
+                   "read_cell_index_partition: error in alltoallv");
+
+      auto compare_idx = [](const CELL_IDX_T& a, const CELL_IDX_T& b) { return (a < b); };
+      vector<size_t> p = data::sort_permutation(recv_index, compare_idx);
+      partition.index = data::apply_permutation(recv_index, p);
+      partition.ranges.resize(p.size());
+      for (size_t i = 0; i < p.size(); i++)
+        {
+          partition.ranges[i] = make_pair(recv_start[p[i]], recv_count[p[i]]);
+        }
+
+      return status;
+    }
+
+
+    void query_cell_index_partition
+    (
+     MPI_Comm                                   comm,
+     const CellIndexPartition&                  partition,
+     const CELL_IDX_T                           pop_start,
+     const std::vector<CELL_IDX_T>&             selection,
+     std::vector<CELL_IDX_T>&                   selection_index,
+     std::vector< std::pair<hsize_t,hsize_t> >& ranges
+     )
+    {
+      int ssize;
+      throw_assert(MPI_Comm_size(comm, &ssize) == MPI_SUCCESS,
+                   "query_cell_index_partition: unable to obtain MPI communicator size");
+      const size_t size = ssize;
+
+      selection_index.clear();
+      ranges.clear();
+
+      // 1. Send the selected ids to their owner ranks
+      vector<size_t> sendcounts(size, 0), sdispls(size, 0);
+      for (const CELL_IDX_T& s : selection)
+        {
+          if (s < pop_start) continue;
+          sendcounts[s % size]++;
+        }
+      for (size_t p = 1; p < size; p++)
+        {
+          sdispls[p] = sdispls[p-1] + sendcounts[p-1];
+        }
+      vector<CELL_IDX_T> request(sdispls[size-1] + sendcounts[size-1]);
+      {
+        vector<size_t> pos(sdispls);
+        for (const CELL_IDX_T& s : selection)
+          {
+            if (s < pop_start) continue;
+            request[pos[s % size]++] = s;
+          }
+      }
+
+      vector<size_t> recvcounts, rdispls;
+      vector<CELL_IDX_T> received;
+      throw_assert(mpi::alltoallv_vector<CELL_IDX_T>(comm, MPI_CELL_IDX_T, sendcounts, sdispls, request,
+                                                     recvcounts, rdispls, received) >= 0,
+                   "query_cell_index_partition: error in alltoallv");
+
+      // 2. Owners reply with the number of matching entries of each
+      //    requested id, followed by the ranges of the matches
+      vector<ATTR_PTR_T> num_matches(received.size());
+      vector<ATTR_PTR_T> match_start, match_count;
+      vector<size_t> range_sendcounts(size, 0), range_sdispls(size, 0);
+      for (size_t p = 0; p < size; p++)
+        {
+          range_sdispls[p] = match_start.size();
+          for (size_t i = rdispls[p]; i < rdispls[p] + recvcounts[p]; i++)
+            {
+              auto rp = std::equal_range(partition.index.begin(), partition.index.end(), received[i]);
+              num_matches[i] = rp.second - rp.first;
+              for (auto it = rp.first; it != rp.second; ++it)
+                {
+                  const auto& range = partition.ranges[it - partition.index.begin()];
+                  match_start.push_back(range.first);
+                  match_count.push_back(range.second);
+                }
+            }
+          range_sendcounts[p] = match_start.size() - range_sdispls[p];
+        }
+
+      vector<size_t> reply_recvcounts, reply_rdispls;
+      vector<ATTR_PTR_T> reply_num_matches;
+      throw_assert(mpi::alltoallv_vector<ATTR_PTR_T>(comm, MPI_ATTR_PTR_T, recvcounts, rdispls, num_matches,
+                                                     reply_recvcounts, reply_rdispls, reply_num_matches) >= 0,
+                   "query_cell_index_partition: error in alltoallv");
+
+      vector<size_t> range_recvcounts, range_rdispls;
+      vector<ATTR_PTR_T> reply_start, reply_count;
+      throw_assert(mpi::alltoallv_vector<ATTR_PTR_T>(comm, MPI_ATTR_PTR_T, range_sendcounts, range_sdispls, match_start,
+                                                     range_recvcounts, range_rdispls, reply_start) >= 0,
+                   "query_cell_index_partition: error in alltoallv");
+      throw_assert(mpi::alltoallv_vector<ATTR_PTR_T>(comm, MPI_ATTR_PTR_T, range_sendcounts, range_sdispls, match_count,
+                                                     range_recvcounts, range_rdispls, reply_count) >= 0,
+                   "query_cell_index_partition: error in alltoallv");
+
+      // 3. The replies of each owner are in the order of the requests
+      //    sent to it
+      for (size_t p = 0; p < size; p++)
+        {
+          size_t k = range_rdispls[p];
+          for (size_t i = 0; i < sendcounts[p]; i++)
+            {
+              const CELL_IDX_T s = request[sdispls[p] + i];
+              for (size_t m = 0; m < reply_num_matches[reply_rdispls[p] + i]; m++, k++)
+                {
+                  selection_index.push_back(s);
+                  ranges.push_back(make_pair(reply_start[k], reply_count[k]));
+                }
+            }
+        }
+
+      auto compare_range_idx = [](const std::pair<hsize_t, hsize_t>& a, const std::pair<hsize_t, hsize_t>& b)
+        { return (a.first < b.first); };
+      vector<size_t> range_sort_p = data::sort_permutation(ranges, compare_range_idx);
+      data::apply_permutation_in_place(selection_index, range_sort_p);
+      data::apply_permutation_in_place(ranges, range_sort_p);
+    }
+  }
+}
@@ -0,0 +1,77 @@
+// -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+//==============================================================================
+///  @file coalesce_ranges.cc
+///
+///  Merging of the ranges of a dataset selection into contiguous spans.
+///
+///  Copyright (C) 2016-2025 Project NeuroH5.
+//==============================================================================
+
+#include "coalesce_ranges.hh"
+
+#include <algorithm>
+#include <numeric>
+
+using namespace std;
+
+namespace neuroh5
+{
+  namespace hdf5
+  {
+    hsize_t coalesce_ranges
+    (
+     const vector< pair<hsize_t,hsize_t> >& ranges,
+     const hsize_t                          max_gap,
+     vector< pair<hsize_t,hsize_t> >&       spans,
+     vector<hsize_t>&                       offsets
+     )
+    {
+      vector<size_t> order(ranges.size());
+      std::iota(order.begin(), order.end(), 0);
+      std::stable_sort(order.begin(), order.end(),
+                       [&ranges] (const size_t a, const size_t b)
+                       { return ranges[a].first < ranges[b].first; });
+
+      // span index and offset within the span of each range
+      vector< pair<size_t, hsize_t> > range_spans(ranges.size(), make_pair(0, 0));
+
+      spans.clear();
+      for (const size_t i : order)
+        {
+          const hsize_t start = ranges[i].first;
+          const hsize_t end   = start + ranges[i].second;
+          if (start == end)
+            continue;
+
+          if (spans.empty() ||
+              (start > spans.back().first + spans.back().second + max_gap))
+            {
+              spans.push_back(make_pair(start, end - start));
+            }
+          else
+            {
+              pair<hsize_t,hsize_t>& span = spans.back();
+              span.second = std::max(span.first + span.second, end) - span.first;
+            }
+          range_spans[i] = make_pair(spans.size() - 1, start - spans.back().first);
+        }
+
+      vector<hsize_t> span_offsets(spans.size(), 0);
+      hsize_t total = 0;
+      for (size_t s = 0; s < spans.size(); s++)
+        {
+          span_offsets[s] = total;
+          total += spans[s].second;
+        }
+
+      offsets.resize(ranges.size());
+      for (size_t i = 0; i < ranges.size(); i++)
+        {
+          offsets[i] = (ranges[i].second > 0) ?
+            (span_offsets[range_spans[i].first] + range_spans[i].second) : 0;
+        }
+
+      return total;
+    }
+  }
+}
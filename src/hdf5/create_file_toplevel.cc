@@ -5,6 +5,7 @@
 #include <string>
 #include <vector>
 
+#include "file_access.hh"
 #include "throw_assert.hh"
 namespace neuroh5
 {
@@ -48,8 +49,12 @@ namespace neuroh5
       if (rank == 0) { 
       
 	  /* Create a new file. If file exists its contents will be overwritten. */
-	  file = H5Fcreate (file_name.c_str(), H5F_ACC_EXCL, H5P_DEFAULT, H5P_DEFAULT);
+	  hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
+	  throw_assert(set_file_access_properties(fapl) >= 0,
+		       "create_file_toplevel: unable to set file access properties");
+	  file = H5Fcreate (file_name.c_str(), H5F_ACC_EXCL, H5P_DEFAULT, fapl);
 	  throw_assert(file >= 0, "create_file_toplevel: unable to create file " << file_name);
+	  throw_assert(H5Pclose(fapl) >= 0, "create_file_toplevel: unable to close property list");
       
 	  /* Create dataset creation properties, i.e. to enable chunking  */
 	  prop = H5Pcreate (H5P_DATASET_CREATE);
@@ -0,0 +1,556 @@
+// -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+//==============================================================================
+///  @file dataset_filters.cc
+///
+///  Filter pipelines for chunked NeuroH5 datasets, and the NeuroH5
+///  delta filter.
+///
+///  Copyright (C) 2016-2025 Project NeuroH5.
+//==============================================================================
+
+#include <hdf5.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "neuroh5_types.hh"
+#include "dataset_filters.hh"
+#include "throw_assert.hh"
+
+namespace neuroh5
+{
+  namespace hdf5
+  {
+
+    /*************************************************************************
+     * Delta filter
+     *
+     * The elements of a chunk are replaced by the differences of
+     * successive elements, zigzag-encoded so that small negative
+     * differences map to small codes, and the codes are bit-packed in
+     * blocks of delta_block_size elements with one bit width per block.
+     * Sorted index and pointer arrays have small differences and pack
+     * into a few bits per element.
+     *
+     * Encoded chunk: the number of elements as a little-endian 64-bit
+     * integer, followed by each block as one byte with the bit width and
+     * the packed codes, least significant bit first.
+     *
+     * Filter parameters: element size in bytes, whether the elements are
+     * signed, and whether they are big-endian.
+     *************************************************************************/
+
+    static const size_t delta_block_size = 128;
+    static const size_t delta_header_size = 8;
+
+    static inline uint64_t delta_load (const uint8_t* p, size_t size, bool is_signed, bool big_endian)
+    {
+      uint64_t v = 0;
+      for (size_t i = 0; i < size; i++)
+        {
+          const size_t k = big_endian ? i : (size - 1 - i);
+          v = (v << 8) | p[k];
+        }
+      if (is_signed && (size < 8) && (v & (1ULL << (8*size - 1))))
+        {
+          v |= ~0ULL << (8*size);
+        }
+      return v;
+    }
+
+    static inline void delta_store (uint8_t* p, size_t size, bool big_endian, uint64_t v)
+    {
+      for (size_t i = 0; i < size; i++)
+        {
+          const size_t k = big_endian ? (size - 1 - i) : i;
+          p[k] = (uint8_t)(v & 0xFF);
+          v >>= 8;
+        }
+    }
+
+    static inline uint64_t zigzag_encode (uint64_t d)
+    {
+      return (d << 1) ^ (uint64_t)((int64_t)d >> 63);
+    }
+
+    static inline uint64_t zigzag_decode (uint64_t z)
+    {
+      return (z >> 1) ^ (~(z & 1) + 1);
+    }
+
+    struct BitWriter
+    {
+      uint8_t *out;
+      uint64_t acc = 0;
+      unsigned nbits = 0;
+
+      BitWriter (uint8_t *p_out) : out(p_out) {}
+
+      void put (uint64_t v, unsigned w)
+      {
+        if (w > 32)
+          {
+            put(v & 0xFFFFFFFFULL, 32);
+            put(v >> 32, w - 32);
+            return;
+          }
+        acc |= v << nbits;
+        nbits += w;
+        while (nbits >= 8)
+          {
+            *out++ = (uint8_t)(acc & 0xFF);
+            acc >>= 8;
+            nbits -= 8;
+          }
+      }
+
+      void flush ()
+      {
+        if (nbits > 0)
+          {
+            *out++ = (uint8_t)(acc & 0xFF);
+          }
+        acc = 0;
+        nbits = 0;
+      }
+    };
+
+    struct BitReader
+    {
+      const uint8_t *in, *end;
+      uint64_t acc = 0;
+      unsigned nbits = 0;
+      bool overrun = false;
+
+      BitReader (const uint8_t *p_in, const uint8_t *p_end) : in(p_in), end(p_end) {}
+
+      uint64_t get (unsigned w)
+      {
+        if (w > 32)
+          {
+            uint64_t lo = get(32);
+            uint64_t hi = get(w - 32);
+            return lo | (hi << 32);
+          }
+        while (nbits < w)
+          {
+            if (in == end)
+              {
+                overrun = true;
+                return 0;
+              }
+            acc |= ((uint64_t)(*in++)) << nbits;
+            nbits += 8;
+          }
+        uint64_t v = acc & ((1ULL << w) - 1);
+        acc >>= w;
+        nbits -= w;
+        return v;
+      }
+
+      void align ()
+      {
+        acc = 0;
+        nbits = 0;
+      }
+    };
+
+    size_t delta_max_encoded_size (size_t n)
+    {
+      const size_t num_blocks = (n + delta_block_size - 1) / delta_block_size;
+      return delta_header_size + num_blocks + (n * 65 + 7) / 8 + num_blocks;
+    }
+
+    size_t delta_encode (size_t size, bool is_signed, bool big_endian,
+                         const uint8_t *in, size_t n, uint8_t *out)
+    {
+      const size_t num_blocks = (n + delta_block_size - 1) / delta_block_size;
+      uint64_t header = n;
+      for (size_t i = 0; i < delta_header_size; i++)
+        {
+          out[i] = (uint8_t)(header & 0xFF);
+          header >>= 8;
+        }
+
+      uint8_t *p = out + delta_header_size;
+      uint64_t codes[delta_block_size];
+      uint64_t prev = 0;
+      for (size_t b = 0; b < num_blocks; b++)
+        {
+          const size_t first = b * delta_block_size;
+          const size_t count = std::min(delta_block_size, n - first);
+          uint64_t mask = 0;
+          for (size_t i = 0; i < count; i++)
+            {
+              const uint64_t v = delta_load(in + (first + i) * size, size, is_signed, big_endian);
+              codes[i] = zigzag_encode(v - prev);
+              mask |= codes[i];
+              prev = v;
+            }
+          unsigned w = 0;
+          while ((w < 64) && ((mask >> w) != 0))
+            {
+              w++;
+            }
+          *p++ = (uint8_t)w;
+          if (w > 0)
+            {
+              BitWriter writer(p);
+              for (size_t i = 0; i < count; i++)
+                {
+                  writer.put(codes[i], w);
+                }
+              writer.flush();
+              p = writer.out;
+            }
+        }
+
+      return p - out;
+    }
+
+    bool delta_decoded_count (const uint8_t *in, size_t nbytes, uint64_t& n)
+    {
+      if (nbytes < delta_header_size)
+        {
+          return false;
+        }
+      n = 0;
+      for (size_t i = 0; i < delta_header_size; i++)
+        {
+          n |= ((uint64_t)in[i]) << (8*i);
+        }
+      return true;
+    }
+
+    bool delta_decode (size_t size, bool big_endian,
+                       const uint8_t *in, size_t nbytes, uint8_t *out)
+    {
+      uint64_t n = 0;
+      if (!delta_decoded_count(in, nbytes, n))
+        {
+          return false;
+        }
+      const uint8_t *end = in + nbytes;
+      BitReader reader(in + delta_header_size, end);
+      uint64_t prev = 0;
+      for (size_t first = 0; first < n; first += delta_block_size)
+        {
+          const size_t count = std::min((uint64_t)delta_block_size, n - first);
+          if (reader.in == end)
+            {
+              return false;
+            }
+          const unsigned w = *reader.in++;
+          if (w > 64)
+            {
+              return false;
+            }
+          for (size_t i = 0; i < count; i++)
+            {
+              const uint64_t z = (w > 0) ? reader.get(w) : 0;
+              prev += zigzag_decode(z);
+              delta_store(out + (first + i) * size, size, big_endian, prev);
+            }
+          reader.align();
+          if (reader.overrun)
+            {
+              return false;
+            }
+        }
+      return true;
+    }
+
+    static size_t delta_filter_encode (size_t size, bool is_signed, bool big_endian,
+                                       size_t nbytes, size_t *buf_size, void **buf)
+    {
+      const size_t n = nbytes / size;
+      const size_t max_size = delta_max_encoded_size(n);
+
+      uint8_t *out = (uint8_t *)H5allocate_memory(max_size, false);
+      if (out == NULL)
+        {
+          return 0;
+        }
+
+      const size_t out_size = delta_encode(size, is_signed, big_endian,
+                                           (const uint8_t *)(*buf), n, out);
+      if (out_size >= nbytes)
+        {
+          // not worth it; the filter is optional, so the chunk is stored
+          // unfiltered
+          H5free_memory(out);
+          return 0;
+        }
+
+      H5free_memory(*buf);
+      *buf = out;
+      *buf_size = max_size;
+      return out_size;
+    }
+
+    static size_t delta_filter_decode (size_t size, bool big_endian,
+                                       size_t nbytes, size_t *buf_size, void **buf)
+    {
+      const uint8_t *in = (const uint8_t *)(*buf);
+      uint64_t n = 0;
+      if (!delta_decoded_count(in, nbytes, n))
+        {
+          return 0;
+        }
+      const size_t out_size = n * size;
+
+      uint8_t *out = (uint8_t *)H5allocate_memory(out_size > 0 ? out_size : 1, false);
+      if (out == NULL)
+        {
+          return 0;
+        }
+      if (!delta_decode(size, big_endian, in, nbytes, out))
+        {
+          H5free_memory(out);
+          return 0;
+        }
+
+      H5free_memory(*buf);
+      *buf = out;
+      *buf_size = out_size;
+      return out_size;
+    }
+
+    static size_t delta_filter (unsigned int flags, size_t cd_nelmts,
+                                const unsigned int cd_values[], size_t nbytes,
+                                size_t *buf_size, void **buf)
+    {
+      if (cd_nelmts < 3)
+        {
+          return 0;
+        }
+      const size_t size = cd_values[0];
+      const bool is_signed = cd_values[1] != 0;
+      const bool big_endian = cd_values[2] != 0;
+      if ((size == 0) || (size > 8))
+        {
+          return 0;
+        }
+
+      if (flags & H5Z_FLAG_REVERSE)
+        {
+          return delta_filter_decode(size, big_endian, nbytes, buf_size, buf);
+        }
+      else
+        {
+          if ((nbytes % size) != 0)
+            {
+              return 0;
+            }
+          return delta_filter_encode(size, is_signed, big_endian, nbytes, buf_size, buf);
+        }
+    }
+
+    static htri_t delta_can_apply (hid_t dcpl, hid_t type, hid_t space)
+    {
+      return (H5Tget_class(type) == H5T_INTEGER) ? 1 : 0;
+    }
+
+    static herr_t delta_set_local (hid_t dcpl, hid_t type, hid_t space)
+    {
+      unsigned int flags;
+      size_t cd_nelmts = 0;
+      if (H5Pget_filter_by_id2(dcpl, H5Z_FILTER_NEUROH5_DELTA, &flags, &cd_nelmts,
+                               NULL, 0, NULL, NULL) < 0)
+        {
+          return -1;
+        }
+      const size_t size = H5Tget_size(type);
+      const H5T_sign_t sign = H5Tget_sign(type);
+      const H5T_order_t order = H5Tget_order(type);
+      if ((size == 0) || (sign == H5T_SGN_ERROR) || (order == H5T_ORDER_ERROR))
+        {
+          return -1;
+        }
+      const unsigned int cd_values[3] = { (unsigned int)size,
+                                          (sign == H5T_SGN_2) ? 1U : 0U,
+                                          (order == H5T_ORDER_BE) ? 1U : 0U };
+      return H5Pmodify_filter(dcpl, H5Z_FILTER_NEUROH5_DELTA, flags, 3, cd_values);
+    }
+
+    static const H5Z_class2_t H5Z_NEUROH5_DELTA[1] = {{
+        H5Z_CLASS_T_VERS,
+        H5Z_FILTER_NEUROH5_DELTA,
+        1, 1,
+        "neuroh5 delta",
+        delta_can_apply,
+        delta_set_local,
+        delta_filter
+      }};
+
+
+    /*************************************************************************
+     * Returns the name of the filter that is registered with the given
+     * identifier, as reported for a pipeline that contains it
+     *************************************************************************/
+    static std::string registered_filter_name (H5Z_filter_t filter_id)
+    {
+      hid_t dcpl = H5Pcreate(H5P_DATASET_CREATE);
+      throw_assert(dcpl >= 0, "register_filters: unable to create property list");
+      const hsize_t chunk_dims = 1;
+      throw_assert(H5Pset_chunk(dcpl, 1, &chunk_dims) >= 0,
+                   "register_filters: unable to set chunk size");
+      throw_assert(H5Pset_filter(dcpl, filter_id, H5Z_FLAG_OPTIONAL, 0, NULL) >= 0,
+                   "register_filters: unable to add filter " << filter_id);
+      unsigned int flags = 0, filter_config = 0;
+      size_t cd_nelmts = 0;
+      char name[256] = "";
+      throw_assert(H5Pget_filter_by_id2(dcpl, filter_id, &flags, &cd_nelmts, NULL,
+                                        sizeof(name), name, &filter_config) >= 0,
+                   "register_filters: unable to query filter " << filter_id);
+      throw_assert(H5Pclose(dcpl) >= 0, "register_filters: unable to close property list");
+      return std::string(name);
+    }
+
+    herr_t register_filters ()
+    {
+      static bool registered = false;
+      if (registered)
+        {
+          return 0;
+        }
+      htri_t avail = H5Zfilter_avail(H5Z_FILTER_NEUROH5_DELTA);
+      throw_assert(avail >= 0, "register_filters: error in H5Zfilter_avail");
+      if (avail == 0)
+        {
+          throw_assert(H5Zregister(H5Z_NEUROH5_DELTA) >= 0,
+                       "register_filters: unable to register delta filter");
+        }
+      else
+        {
+          // registered earlier, e.g. by another module that links
+          // NeuroH5; any other filter with this identifier would decode
+          // the delta-encoded chunks incorrectly
+          const std::string name = registered_filter_name(H5Z_FILTER_NEUROH5_DELTA);
+          throw_assert(name == H5Z_NEUROH5_DELTA[0].name,
+                       "register_filters: filter identifier " << H5Z_FILTER_NEUROH5_DELTA <<
+                       " of the NeuroH5 delta filter is taken by filter '" << name << "'");
+        }
+      registered = true;
+      return 0;
+    }
+
+
+    FilterConfig default_filter_config ()
+    {
+      FilterConfig config;
+#ifdef H5_HAS_PARALLEL_DEFLATE
+      config.index = DatasetFilter(true, 4);
+      config.pointer = DatasetFilter(true, 4);
+      config.value = DatasetFilter(true, 4);
+#endif
+      return config;
+    }
+
+
+    void parse_filter_spec
+    (
+     const std::string& spec,
+     FilterConfig&      config
+     )
+    {
+      const size_t eq = spec.find('=');
+      throw_assert(eq != std::string::npos,
+                   "parse_filter_spec: invalid filter specification " << spec);
+      const std::string role = spec.substr(0, eq);
+
+      DatasetFilter filter;
+      size_t pos = eq + 1;
+      while (pos <= spec.size())
+        {
+          size_t next = spec.find(',', pos);
+          if (next == std::string::npos)
+            {
+              next = spec.size();
+            }
+          const std::string name = spec.substr(pos, next - pos);
+          if (name == "shuffle")
+            {
+              filter.shuffle = true;
+            }
+          else if (name == "delta")
+            {
+              filter.delta = true;
+            }
+          else if (name.compare(0, 8, "deflate:") == 0)
+            {
+              const int level = atoi(name.c_str() + 8);
+              throw_assert((level >= 0) && (level <= 9),
+                           "parse_filter_spec: invalid deflate level in " << spec);
+              filter.deflate_level = level;
+            }
+          else
+            {
+              throw_assert(name == "none",
+                           "parse_filter_spec: unknown filter " << name);
+            }
+          pos = next + 1;
+        }
+      throw_assert(!(filter.shuffle && filter.delta),
+                   "parse_filter_spec: shuffle and delta cannot be combined in " << spec);
+
+      if (role == "index")
+        {
+          config.index = filter;
+        }
+      else if (role == "pointer")
+        {
+          config.pointer = filter;
+        }
+      else if (role == "value")
+        {
+          config.value = filter;
+        }
+      else
+        {
+          throw_assert(role == "all",
+                       "parse_filter_spec: unknown dataset role " << role);
+          config.index = config.pointer = config.value = filter;
+        }
+    }
+
+
+    herr_t set_dataset_filters
+    (
+     hid_t                dcpl,
+     const DatasetFilter& filter,
+     hid_t                ftype
+     )
+    {
+      throw_assert(H5Premove_filter(dcpl, H5Z_FILTER_ALL) >= 0,
+                   "set_dataset_filters: error in H5Premove_filter");
+      throw_assert(!(filter.shuffle && filter.delta),
+                   "set_dataset_filters: shuffle and delta cannot be combined");
+
+      const bool delta = filter.delta && (H5Tget_class(ftype) == H5T_INTEGER);
+      if (delta)
+        {
+          register_filters();
+          throw_assert(H5Pset_filter(dcpl, H5Z_FILTER_NEUROH5_DELTA, H5Z_FLAG_OPTIONAL, 0, NULL) >= 0,
+                       "set_dataset_filters: unable to add delta filter");
+        }
+      if (filter.shuffle)
+        {
+          throw_assert(H5Pset_shuffle(dcpl) >= 0,
+                       "set_dataset_filters: unable to add shuffle filter");
+        }
+      if (filter.deflate_level > 0)
+        {
+          throw_assert(filter.deflate_level <= 9,
+                       "set_dataset_filters: invalid deflate level");
+          throw_assert(H5Pset_deflate(dcpl, filter.deflate_level) >= 0,
+                       "set_dataset_filters: unable to add deflate filter");
+        }
+      return 0;
+    }
+
+  }
+}
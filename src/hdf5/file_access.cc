@@ -1,7 +1,11 @@
 #include <mpi.h>
 #include <hdf5.h>
+#include <cstdlib>
 #include <string>
 #include <vector>
+#include "neuroh5_types.hh"
+#include "dataset_filters.hh"
+#include "file_access.hh"
 #include "throw_assert.hh"
 
 namespace neuroh5
@@ -9,6 +13,144 @@ namespace neuroh5
   namespace hdf5
   {
 
+    /*****************************************************************************
+     * File access configuration
+     *****************************************************************************/
+
+    static FileAccessConfig file_access_env_config ()
+    {
+      FileAccessConfig config;
+
+      const char *hints = getenv("NEUROH5_MPI_HINTS");
+      if (hints != NULL)
+        {
+          const std::string spec(hints);
+          size_t pos = 0;
+          while (pos < spec.size())
+            {
+              size_t next = spec.find(';', pos);
+              if (next == std::string::npos)
+                {
+                  next = spec.size();
+                }
+              const std::string hint = spec.substr(pos, next - pos);
+              if (!hint.empty())
+                {
+                  const size_t eq = hint.find('=');
+                  throw_assert((eq != std::string::npos) && (eq > 0),
+                               "NEUROH5_MPI_HINTS: invalid hint " << hint);
+                  config.mpi_hints[hint.substr(0, eq)] = hint.substr(eq + 1);
+                }
+              pos = next + 1;
+            }
+        }
+
+      const char *coll_metadata = getenv("NEUROH5_COLL_METADATA");
+      if (coll_metadata != NULL)
+        {
+          config.coll_metadata_ops = config.coll_metadata_write = (atoi(coll_metadata) != 0);
+        }
+
+      const char *alignment = getenv("NEUROH5_ALIGNMENT");
+      if (alignment != NULL)
+        {
+          char *end = NULL;
+          config.alignment = strtoull(alignment, &end, 10);
+          if (*end == ':')
+            {
+              config.alignment_threshold = strtoull(end+1, NULL, 10);
+            }
+        }
+
+      const char *meta_block_size = getenv("NEUROH5_META_BLOCK_SIZE");
+      if (meta_block_size != NULL)
+        {
+          config.meta_block_size = strtoull(meta_block_size, NULL, 10);
+        }
+
+      const char *selection_gap = getenv("NEUROH5_SELECTION_GAP");
+      if (selection_gap != NULL)
+        {
+          config.selection_gap = strtoull(selection_gap, NULL, 10);
+        }
+
+      return config;
+    }
+
+    static FileAccessConfig& file_access_config_ref ()
+    {
+      static FileAccessConfig config = file_access_env_config();
+      return config;
+    }
+    
+    const FileAccessConfig& file_access_config ()
+    {
+      return file_access_config_ref();
+    }
+
+    void set_file_access_config (const FileAccessConfig& config)
+    {
+      file_access_config_ref() = config;
+    }
+
+    herr_t set_file_access_properties (hid_t fapl)
+    {
+      const FileAccessConfig& config = file_access_config();
+      if (config.alignment > 0)
+        {
+          throw_assert(H5Pset_alignment(fapl, config.alignment_threshold, config.alignment) >= 0,
+                       "set_file_access_properties: error in H5Pset_alignment");
+        }
+      if (config.meta_block_size > 0)
+        {
+          throw_assert(H5Pset_meta_block_size(fapl, config.meta_block_size) >= 0,
+                       "set_file_access_properties: error in H5Pset_meta_block_size");
+        }
+      return 0;
+    }
+    
+    herr_t set_parallel_file_access
+    (
+     hid_t    fapl,
+     MPI_Comm comm,
+     const bool coll_metadata
+     )
+    {
+#ifdef HDF5_IS_PARALLEL
+      const FileAccessConfig& config = file_access_config();
+      MPI_Info info = MPI_INFO_NULL;
+      if (!config.mpi_hints.empty())
+        {
+          throw_assert(MPI_Info_create(&info) == MPI_SUCCESS,
+                       "set_parallel_file_access: error in MPI_Info_create");
+          for (auto const& hint : config.mpi_hints)
+            {
+              throw_assert(MPI_Info_set(info, hint.first.c_str(), hint.second.c_str()) == MPI_SUCCESS,
+                           "set_parallel_file_access: error in MPI_Info_set");
+            }
+        }
+      // the MPI-IO driver keeps a copy of the info object
+      throw_assert(H5Pset_fapl_mpio(fapl, comm, info) >= 0,
+                   "set_parallel_file_access: error in H5Pset_fapl_mpio");
+      if (info != MPI_INFO_NULL)
+        {
+          throw_assert(MPI_Info_free(&info) == MPI_SUCCESS,
+                       "set_parallel_file_access: error in MPI_Info_free");
+        }
+      if (coll_metadata && config.coll_metadata_ops)
+        {
+          throw_assert(H5Pset_all_coll_metadata_ops(fapl, true) >= 0,
+                       "set_parallel_file_access: error in H5Pset_all_coll_metadata_ops");
+        }
+      if (coll_metadata && config.coll_metadata_write)
+        {
+          throw_assert(H5Pset_coll_metadata_write(fapl, true) >= 0,
+                       "set_parallel_file_access: error in H5Pset_coll_metadata_write");
+        }
+#endif
+      return set_file_access_properties(fapl);
+    }
+
     /*****************************************************************************
      * Routines for opening and closing NeuroH5 for reading and writing.
      *****************************************************************************/
@@ -16,11 +158,13 @@ namespace neuroh5
     (
      MPI_Comm comm,
      const std::string& file_name,
-     const bool collective = false,
-     const bool rdwr = false,
-     const size_t cache_size = 1*1024*1024
+     const bool collective,
+     const bool rdwr,
+     const size_t cache_size
      )
     {
+      register_filters();
+
       hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
       throw_assert_nomsg(fapl >= 0);
 
@@ -39,12 +183,14 @@ namespace neuroh5
                    "error in H5Pset_cache");
 
       
-#ifdef HDF5_IS_PARALLEL
       if (collective)
         {
-          throw_assert_nomsg(H5Pset_fapl_mpio(fapl, comm, MPI_INFO_NULL) >= 0);
+          throw_assert_nomsg(set_parallel_file_access(fapl, comm) >= 0);
+        }
+      else
+        {
+          throw_assert_nomsg(set_file_access_properties(fapl) >= 0);
         }
-#endif
       
       hid_t file;
 
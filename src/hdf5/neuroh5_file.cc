@@ -0,0 +1,77 @@
+// -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+//==============================================================================
+///  @file neuroh5_file.cc
+///
+///  Session handle that keeps a NeuroH5 file open and caches its
+///  metadata.
+///
+///  Copyright (C) 2016-2025 Project NeuroH5.
+//==============================================================================
+#include <mpi.h>
+#include <hdf5.h>
+
+#include <string>
+
+#include "neuroh5_file.hh"
+#include "file_access.hh"
+#include "throw_assert.hh"
+
+using namespace std;
+
+namespace neuroh5
+{
+
+  File::File (MPI_Comm comm, const string& file_name, bool collective)
+    : m_file_name(file_name), m_collective(collective)
+  {
+    throw_assert(MPI_Comm_dup(comm, &m_comm) == MPI_SUCCESS,
+                 "File: unable to duplicate MPI communicator");
+
+    int rank;
+    throw_assert(MPI_Comm_rank(m_comm, &rank) == MPI_SUCCESS,
+                 "File: unable to obtain MPI communicator rank");
+
+    if (collective || (rank == 0))
+      {
+        m_file = hdf5::open_file(m_comm, m_file_name, collective);
+        throw_assert(m_file >= 0,
+                     "File: unable to open file " << m_file_name);
+      }
+    m_open = true;
+  }
+
+
+  File::~File ()
+  {
+    // errors are not reported from the destructor; the communicator
+    // can no longer be freed once MPI has been finalized
+    if (m_file >= 0)
+      {
+        hdf5::close_file(m_file);
+      }
+    int finalized = 0;
+    MPI_Finalized(&finalized);
+    if ((m_comm != MPI_COMM_NULL) && (!finalized))
+      {
+        MPI_Comm_free(&m_comm);
+      }
+  }
+
+
+  void File::close ()
+  {
+    if (m_file >= 0)
+      {
+        throw_assert(hdf5::close_file(m_file) >= 0,
+                     "File: unable to close file " << m_file_name);
+        m_file = -1;
+      }
+    if (m_comm != MPI_COMM_NULL)
+      {
+        throw_assert(MPI_Comm_free(&m_comm) == MPI_SUCCESS,
+                     "File: unable to free MPI communicator");
+      }
+    m_open = false;
+  }
+
+}
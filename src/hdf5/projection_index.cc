@@ -0,0 +1,345 @@
+// -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+//==============================================================================
+///  @file projection_index.cc
+///
+///  Functions for building and querying the destination lookup index of
+///  projections in DBS (Destination Block Sparse) format.
+///
+///  Copyright (C) 2016-2021 Project NeuroH5.
+//==============================================================================
+
+#include "debug.hh"
+
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "neuroh5_types.hh"
+#include "projection_index.hh"
+#include "dataset_num_elements.hh"
+#include "exists_dataset.hh"
+#include "read_template.hh"
+#include "path_names.hh"
+#include "sort_permutation.hh"
+#include "throw_assert.hh"
+
+using namespace std;
+
+namespace neuroh5
+{
+  namespace hdf5
+  {
+
+    template<class T>
+    void write_projection_index_dataset
+    (
+     hid_t              file,
+     const std::string& path,
+     hid_t              ftype,
+     hid_t              ntype,
+     const vector<T>&   v
+     )
+    {
+      if (hdf5::exists_dataset (file, path.c_str()) > 0)
+        {
+          throw_assert(H5Ldelete(file, path.c_str(), H5P_DEFAULT) >= 0,
+                       "write_projection_index: unable to delete dataset " << path);
+        }
+
+      hsize_t dims = (hsize_t)v.size();
+      hid_t fspace = H5Screate_simple(1, &dims, &dims);
+      throw_assert_nomsg(fspace >= 0);
+      hid_t dset = H5Dcreate2(file, path.c_str(), ftype, fspace,
+                              H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+      throw_assert(dset >= 0,
+                   "write_projection_index: unable to create dataset " << path);
+      if (dims > 0)
+        {
+          throw_assert(H5Dwrite(dset, ntype, H5S_ALL, H5S_ALL, H5P_DEFAULT, v.data()) >= 0,
+                       "write_projection_index: unable to write dataset " << path);
+        }
+      throw_assert_nomsg(H5Dclose(dset) >= 0);
+      throw_assert_nomsg(H5Sclose(fspace) >= 0);
+    }
+
+
+    herr_t write_projection_index
+    (
+     MPI_Comm                   comm,
+     const std::string&         file_name,
+     const std::string&         src_pop_name,
+     const std::string&         dst_pop_name
+     )
+    {
+      herr_t ierr = 0;
+      int rank;
+      throw_assert_nomsg(MPI_Comm_rank(comm, &rank) == MPI_SUCCESS);
+
+      if (rank == 0)
+        {
+          hid_t file = H5Fopen(file_name.c_str(), H5F_ACC_RDWR, H5P_DEFAULT);
+          throw_assert_nomsg(file >= 0);
+
+          hsize_t num_blocks = hdf5::dataset_num_elements
+            (file, hdf5::edge_attribute_path(src_pop_name, dst_pop_name, hdf5::EDGES, hdf5::DST_BLK_PTR));
+          if (num_blocks > 0)
+            num_blocks--;
+          hsize_t num_dst_ptr = hdf5::dataset_num_elements
+            (file, hdf5::edge_attribute_path(src_pop_name, dst_pop_name, hdf5::EDGES, hdf5::DST_PTR));
+          hsize_t num_edges = hdf5::dataset_num_elements
+            (file, hdf5::edge_attribute_path(src_pop_name, dst_pop_name, hdf5::EDGES, hdf5::SRC_IDX));
+
+          vector<DST_BLK_PTR_T> dst_blk_ptr(num_blocks > 0 ? num_blocks+1 : 0);
+          vector<NODE_IDX_T> dst_blk_idx(num_blocks);
+          if (num_blocks > 0)
+            {
+              ierr = hdf5::read<DST_BLK_PTR_T>
+                (file, hdf5::edge_attribute_path(src_pop_name, dst_pop_name, hdf5::EDGES, hdf5::DST_BLK_PTR),
+                 0, num_blocks+1, DST_BLK_PTR_H5_NATIVE_T, dst_blk_ptr, H5P_DEFAULT);
+              throw_assert_nomsg(ierr >= 0);
+              ierr = hdf5::read<NODE_IDX_T>
+                (file, hdf5::edge_attribute_path(src_pop_name, dst_pop_name, hdf5::EDGES, hdf5::DST_BLK_IDX),
+                 0, num_blocks, NODE_IDX_H5_NATIVE_T, dst_blk_idx, H5P_DEFAULT);
+              throw_assert_nomsg(ierr >= 0);
+            }
+
+          vector<NODE_IDX_T> lookup_idx, lookup_cnt;
+          vector<DST_BLK_PTR_T> lookup_blk;
+          vector<DST_PTR_T> lookup_ptr;
+          for (hsize_t b = 0; b < num_blocks; b++)
+            {
+              // the last block pointer may extend one past the final
+              // destination pointer
+              DST_BLK_PTR_T ptr_end = std::min(dst_blk_ptr[b+1], (DST_BLK_PTR_T)(num_dst_ptr-1));
+              DST_BLK_PTR_T count = (ptr_end > dst_blk_ptr[b]) ? ptr_end - dst_blk_ptr[b] : 0;
+              lookup_idx.push_back(dst_blk_idx[b]);
+              lookup_cnt.push_back(count);
+              lookup_blk.push_back(b);
+              lookup_ptr.push_back(dst_blk_ptr[b]);
+            }
+
+          auto compare_idx = [](const NODE_IDX_T& a, const NODE_IDX_T& b) { return (a < b); };
+          vector<size_t> p = data::sort_permutation(lookup_idx, compare_idx);
+          data::apply_permutation_in_place(lookup_idx, p);
+          data::apply_permutation_in_place(lookup_cnt, p);
+          data::apply_permutation_in_place(lookup_blk, p);
+          data::apply_permutation_in_place(lookup_ptr, p);
+
+          write_projection_index_dataset<NODE_IDX_T>
+            (file, hdf5::edge_attribute_path(src_pop_name, dst_pop_name, hdf5::EDGES, hdf5::DST_LOOKUP_IDX),
+             NODE_IDX_H5_FILE_T, NODE_IDX_H5_NATIVE_T, lookup_idx);
+          write_projection_index_dataset<NODE_IDX_T>
+            (file, hdf5::edge_attribute_path(src_pop_name, dst_pop_name, hdf5::EDGES, hdf5::DST_LOOKUP_CNT),
+             NODE_IDX_H5_FILE_T, NODE_IDX_H5_NATIVE_T, lookup_cnt);
+          write_projection_index_dataset<DST_BLK_PTR_T>
+            (file, hdf5::edge_attribute_path(src_pop_name, dst_pop_name, hdf5::EDGES, hdf5::DST_LOOKUP_BLK),
+             DST_BLK_PTR_H5_FILE_T, DST_BLK_PTR_H5_NATIVE_T, lookup_blk);
+          write_projection_index_dataset<DST_PTR_T>
+            (file, hdf5::edge_attribute_path(src_pop_name, dst_pop_name, hdf5::EDGES, hdf5::DST_LOOKUP_PTR),
+             DST_PTR_H5_FILE_T, DST_PTR_H5_NATIVE_T, lookup_ptr);
+          vector<hsize_t> lookup_ext = { num_edges, num_dst_ptr };
+          write_projection_index_dataset<hsize_t>
+            (file, hdf5::edge_attribute_path(src_pop_name, dst_pop_name, hdf5::EDGES, hdf5::DST_LOOKUP_EXT),
+             H5T_STD_U64LE, H5T_NATIVE_HSIZE, lookup_ext);
+
+          throw_assert_nomsg(H5Fclose(file) >= 0);
+        }
+
+      throw_assert_nomsg(MPI_Barrier(comm) == MPI_SUCCESS);
+
+      return ierr;
+    }
+
+
+    bool has_projection_index
+    (
+     hid_t                      file,
+     const std::string&         src_pop_name,
+     const std::string&         dst_pop_name
+     )
+    {
+      const vector<string> lookup_names = { DST_LOOKUP_IDX, DST_LOOKUP_CNT, DST_LOOKUP_BLK, DST_LOOKUP_PTR };
+
+      hsize_t num_blocks = hdf5::dataset_num_elements
+        (file, hdf5::edge_attribute_path(src_pop_name, dst_pop_name, hdf5::EDGES, hdf5::DST_BLK_PTR));
+      if (num_blocks > 0)
+        num_blocks--;
+
+      for (const string& name : lookup_names)
+        {
+          string path = hdf5::edge_attribute_path(src_pop_name, dst_pop_name, hdf5::EDGES, name);
+          if (hdf5::exists_dataset (file, path.c_str()) <= 0)
+            return false;
+          if (hdf5::dataset_num_elements(file, path) != num_blocks)
+            return false;
+        }
+
+      // A projection that was rewritten with the same number of blocks
+      // is detected by its number of edges and destination pointers
+      string ext_path = hdf5::edge_attribute_path(src_pop_name, dst_pop_name, hdf5::EDGES, DST_LOOKUP_EXT);
+      if (hdf5::exists_dataset (file, ext_path.c_str()) <= 0)
+        return false;
+      if (hdf5::dataset_num_elements(file, ext_path) != 2)
+        return false;
+      vector<hsize_t> lookup_ext(2);
+      throw_assert_nomsg(hdf5::read<hsize_t>(file, ext_path, 0, 2, H5T_NATIVE_HSIZE,
+                                             lookup_ext, H5P_DEFAULT) >= 0);
+      hsize_t num_edges = hdf5::dataset_num_elements
+        (file, hdf5::edge_attribute_path(src_pop_name, dst_pop_name, hdf5::EDGES, hdf5::SRC_IDX));
+      hsize_t num_dst_ptr = hdf5::dataset_num_elements
+        (file, hdf5::edge_attribute_path(src_pop_name, dst_pop_name, hdf5::EDGES, hdf5::DST_PTR));
+
+      return (lookup_ext[0] == num_edges) && (lookup_ext[1] == num_dst_ptr);
+    }
+
+
+    // Reads the index rows at the given sorted, unique positions with a
+    // point selection; ranks without rows select none so that the read
+    // can be collective
+    template<class T>
+    void read_projection_index_points
+    (
+     hid_t                  file,
+     const std::string&     path,
+     hid_t                  ntype,
+     const vector<hsize_t>& rows,
+     vector<T>&             v,
+     hid_t                  rapl
+     )
+    {
+      hsize_t num_points = rows.size();
+      v.resize(num_points);
+
+      hid_t dset = H5Dopen2(file, path.c_str(), H5P_DEFAULT);
+      throw_assert(dset >= 0,
+                   "lookup_projection_index: unable to open dataset " << path);
+      hid_t fspace = H5Dget_space(dset);
+      throw_assert_nomsg(fspace >= 0);
+      hid_t mspace = H5Screate_simple(1, &num_points, NULL);
+      throw_assert_nomsg(mspace >= 0);
+      herr_t ierr;
+      if (num_points > 0)
+        {
+          ierr = H5Sselect_elements(fspace, H5S_SELECT_SET, num_points, rows.data());
+        }
+      else
+        {
+          ierr = H5Sselect_none(fspace);
+          throw_assert_nomsg(ierr >= 0);
+          ierr = H5Sselect_none(mspace);
+        }
+      throw_assert(ierr >= 0,
+                   "lookup_projection_index: error in point selection");
+      throw_assert(H5Dread(dset, ntype, mspace, fspace, rapl, v.data()) >= 0,
+                   "lookup_projection_index: error in H5Dread");
+      throw_assert_nomsg(H5Sclose(mspace) >= 0);
+      throw_assert_nomsg(H5Sclose(fspace) >= 0);
+      throw_assert_nomsg(H5Dclose(dset) >= 0);
+    }
+
+
+    herr_t lookup_projection_index
+    (
+     hid_t                      file,
+     hid_t                      rapl,
+     const std::string&         src_pop_name,
+     const std::string&         dst_pop_name,
+     const std::vector<NODE_IDX_T>& dst_indices,
+     std::vector< std::pair<NODE_IDX_T, hsize_t> >& dst_ptr_pos
+     )
+    {
+      herr_t ierr = 0;
+
+      string idx_path = hdf5::edge_attribute_path(src_pop_name, dst_pop_name, hdf5::EDGES, hdf5::DST_LOOKUP_IDX);
+      hsize_t num_rows = hdf5::dataset_num_elements(file, idx_path);
+
+      dst_ptr_pos.clear();
+
+      vector<NODE_IDX_T> queries(dst_indices);
+      std::sort(queries.begin(), queries.end());
+      queries.erase(std::unique(queries.begin(), queries.end()), queries.end());
+
+      // Binary search for the last index row that starts at or before
+      // each query. All queries advance together, so that each step
+      // reads the middle rows of all searches with one point selection.
+      // The search interval at least halves with each step, so the
+      // number of steps depends only on the number of rows and is the
+      // same on all ranks.
+      size_t num_steps = 0;
+      for (hsize_t n = num_rows; n > 0; n /= 2)
+        num_steps++;
+
+      vector<hsize_t> first(queries.size(), 0), count(queries.size(), num_rows);
+      vector<hsize_t> mid_rows;
+      vector<NODE_IDX_T> mid_idx;
+      for (size_t step = 0; step < num_steps; step++)
+        {
+          mid_rows.clear();
+          for (size_t i = 0; i < queries.size(); i++)
+            {
+              if (count[i] > 0)
+                mid_rows.push_back(first[i] + count[i] / 2);
+            }
+          std::sort(mid_rows.begin(), mid_rows.end());
+          mid_rows.erase(std::unique(mid_rows.begin(), mid_rows.end()), mid_rows.end());
+
+          read_projection_index_points<NODE_IDX_T>
+            (file, idx_path, NODE_IDX_H5_NATIVE_T, mid_rows, mid_idx, rapl);
+
+          for (size_t i = 0; i < queries.size(); i++)
+            {
+              if (count[i] == 0)
+                continue;
+              hsize_t half = count[i] / 2;
+              hsize_t mid = first[i] + half;
+              auto it = std::lower_bound(mid_rows.begin(), mid_rows.end(), mid);
+              if (mid_idx[it - mid_rows.begin()] <= queries[i])
+                {
+                  first[i] = mid + 1;
+                  count[i] -= half + 1;
+                }
+              else
+                {
+                  count[i] = half;
+                }
+            }
+        }
+
+      // first[i] is now the number of rows that start at or before
+      // query i, so the candidate row is the one before it
+      vector<hsize_t> rows;
+      for (size_t i = 0; i < queries.size(); i++)
+        {
+          if (first[i] > 0)
+            rows.push_back(first[i] - 1);
+        }
+      rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+
+      vector<NODE_IDX_T> rows_idx, rows_cnt;
+      vector<DST_PTR_T> rows_ptr;
+      read_projection_index_points<NODE_IDX_T>
+        (file, idx_path, NODE_IDX_H5_NATIVE_T, rows, rows_idx, rapl);
+      read_projection_index_points<NODE_IDX_T>
+        (file, hdf5::edge_attribute_path(src_pop_name, dst_pop_name, hdf5::EDGES, hdf5::DST_LOOKUP_CNT),
+         NODE_IDX_H5_NATIVE_T, rows, rows_cnt, rapl);
+      read_projection_index_points<DST_PTR_T>
+        (file, hdf5::edge_attribute_path(src_pop_name, dst_pop_name, hdf5::EDGES, hdf5::DST_LOOKUP_PTR),
+         DST_PTR_H5_NATIVE_T, rows, rows_ptr, rapl);
+
+      for (size_t i = 0; i < queries.size(); i++)
+        {
+          if (first[i] == 0)
+            continue;
+          const NODE_IDX_T q = queries[i];
+          auto it = std::lower_bound(rows.begin(), rows.end(), first[i] - 1);
+          size_t r = it - rows.begin();
+          if (q < rows_idx[r] + rows_cnt[r])
+            {
+              dst_ptr_pos.push_back(make_pair(q, (hsize_t)(rows_ptr[r] + (q - rows_idx[r]))));
+            }
+        }
+
+      return ierr;
+    }
+  }
+}
@@ -16,6 +16,7 @@
 #include "neuroh5_types.hh"
 #include "dataset_num_elements.hh"
 #include "read_template.hh"
+#include "rank_range.hh"
 #include "exists_group.hh"
 #include "path_names.hh"
 #include "throw_assert.hh"
@@ -131,5 +132,80 @@ namespace neuroh5
       
       return status;
     }
+
+
+    bool cell_attribute_block
+    (
+     MPI_Comm                        comm,
+     const hid_t&                    loc,
+     const std::string&              path,
+     const std::vector<CELL_IDX_T>&  index,
+     const std::vector<ATTR_PTR_T>&  ptr,
+     std::vector<CELL_IDX_T>&        value_index,
+     std::vector<ATTR_PTR_T>&        value_ptr,
+     hsize_t&                        value_start,
+     hsize_t&                        value_block,
+     size_t offset,
+     size_t numitems
+     )
+    {
+      int size, rank;
+      throw_assert(MPI_Comm_size(comm, &size) == MPI_SUCCESS, "error in MPI_Comm_size");
+      throw_assert(MPI_Comm_rank(comm, &rank) == MPI_SUCCESS, "error in MPI_Comm_rank");
+
+      hsize_t dset_size = index.size();
+      size_t read_size = 0;
+      if (numitems > 0) 
+        {
+          if (offset < dset_size)
+            {
+              read_size = min((hsize_t)numitems, dset_size-offset);
+            }
+        }
+      else
+        {
+          read_size = dset_size;
+        }
+
+      value_start = 0;
+      value_block = 0;
+      if (read_size == 0)
+        {
+          return false;
+        }
+      
+      // determine which blocks of block_ptr are read by which rank
+      vector< pair<hsize_t,hsize_t> > ranges;
+      mpi::rank_ranges(read_size, size, ranges);
+        
+      hsize_t start = ranges[rank].first + offset;
+      hsize_t end   = start + ranges[rank].second;
+      hsize_t block = end - start;
+    
+      string value_path = path + "/" + ATTR_VAL;
+
+      if (ptr.size() > 0)
+        {
+          value_start = ptr[start];
+          value_block = ptr[end]-value_start;
+          value_ptr.resize(block+1, 0);
+          for (size_t i=start, j=0; i<end+1; i++, j++)
+            {
+              value_ptr[j] = ptr[i] - value_start;
+            }
+        }
+      else
+        {
+          value_start = 0;
+          value_block = block > 0 ? dataset_num_elements (loc, value_path) : 0;
+        }
+      value_index.resize(block, 0);
+      for (size_t i=start, j=0; i<end; i++, j++)
+        {
+          value_index[j] = index[i];
+        }
+
+      return true;
+    }
   }
 }
@@ -0,0 +1,97 @@
+#include "read_multi.hh"
+#include "dataset_filters.hh"
+#include "throw_assert.hh"
+
+using namespace std;
+
+namespace neuroh5
+{
+  namespace hdf5
+  {
+    herr_t read_multi
+    (
+     hid_t                      loc,
+     const vector<string>&      names,
+     const vector<hsize_t>&     starts,
+     const vector<hsize_t>&     blocks,
+     const vector<void*>&       bufs,
+     hid_t                      rapl
+     )
+    {
+      herr_t ierr = 0;
+      const size_t count = names.size();
+      throw_assert((starts.size() == count) && (blocks.size() == count) && (bufs.size() == count),
+                   "hdf5::read_multi: mismatch of sizes of dataset names and selections");
+      if (count == 0)
+        return ierr;
+
+      register_filters();
+
+      vector<hid_t> dsets(count), ntypes(count), mspaces(count), fspaces(count);
+      for (size_t i = 0; i < count; i++)
+        {
+          dsets[i] = H5Dopen(loc, names[i].c_str(), H5P_DEFAULT);
+          throw_assert(dsets[i] >= 0,
+                       "hdf5::read_multi: error in H5Dopen: " << names[i]);
+          hid_t ftype = H5Dget_type(dsets[i]);
+          throw_assert(ftype >= 0,
+                       "hdf5::read_multi: error in H5Dget_type");
+          ntypes[i] = H5Tget_native_type(ftype, H5T_DIR_ASCEND);
+          throw_assert(ntypes[i] >= 0,
+                       "hdf5::read_multi: error in H5Tget_native_type");
+          throw_assert(H5Tclose(ftype) >= 0,
+                       "hdf5::read_multi: error in H5Tclose");
+
+          mspaces[i] = H5Screate_simple(1, &blocks[i], NULL);
+          throw_assert(mspaces[i] >= 0,
+                       "hdf5::read_multi: error in H5Screate_simple");
+          fspaces[i] = H5Dget_space(dsets[i]);
+          throw_assert(fspaces[i] >= 0,
+                       "hdf5::read_multi: error in H5Dget_space");
+          hsize_t one = 1;
+          if (blocks[i] > 0)
+            {
+              ierr = H5Sselect_hyperslab(fspaces[i], H5S_SELECT_SET, &starts[i], NULL, &one, &blocks[i]);
+            }
+          else
+            {
+              ierr = H5Sselect_none(fspaces[i]);
+              throw_assert(ierr >= 0,
+                           "hdf5::read_multi: error in H5Sselect_none");
+              ierr = H5Sselect_none(mspaces[i]);
+            }
+          throw_assert(ierr >= 0,
+                       "hdf5::read_multi: error in H5Sselect_hyperslab");
+        }
+
+#if H5_VERSION_GE(1,14,0)
+      vector<void*> mbufs(bufs);
+      ierr = H5Dread_multi(count, dsets.data(), ntypes.data(), mspaces.data(), fspaces.data(),
+                           rapl, mbufs.data());
+      throw_assert(ierr >= 0,
+                   "hdf5::read_multi: error in H5Dread_multi");
+#else
+      for (size_t i = 0; i < count; i++)
+        {
+          ierr = H5Dread(dsets[i], ntypes[i], mspaces[i], fspaces[i], rapl, bufs[i]);
+          throw_assert(ierr >= 0,
+                       "hdf5::read_multi: error in H5Dread: " << names[i]);
+        }
+#endif
+
+      for (size_t i = 0; i < count; i++)
+        {
+          throw_assert(H5Sclose(fspaces[i]) >= 0,
+                       "hdf5::read_multi: error in H5Sclose");
+          throw_assert(H5Sclose(mspaces[i]) >= 0,
+                       "hdf5::read_multi: error in H5Sclose");
+          throw_assert(H5Tclose(ntypes[i]) >= 0,
+                       "hdf5::read_multi: error in H5Tclose");
+          throw_assert(H5Dclose(dsets[i]) >= 0,
+                       "hdf5::read_multi: error in H5Dclose");
+        }
+
+      return ierr;
+    }
+  }
+}
@@ -21,8 +21,10 @@
 #include "path_names.hh"
 #include "rank_range.hh"
 #include "read_projection_datasets.hh"
+#include "projection_index.hh"
 #include "sort_permutation.hh"
 #include "mpi_debug.hh"
+#include "file_access.hh"
 #include "throw_assert.hh"
 #include "debug.hh"
 
@@ -33,6 +35,214 @@ namespace neuroh5
   namespace hdf5
   {
     
+    // Sorts the source index ranges of the selected destinations by
+    // their position in the Source Index dataset, and builds the
+    // destination pointer of the selection
+    void sort_selection_ranges
+    (
+     vector<NODE_IDX_T>&        selection_dst_idx,
+     vector< pair<hsize_t,hsize_t> >& src_idx_ranges,
+     vector<DST_PTR_T>&         selection_dst_ptr
+     )
+    {
+      auto compare_range_idx = [](const std::pair<hsize_t, hsize_t>& a, const std::pair<hsize_t, hsize_t>& b) 
+        { return (a.first < b.first); };
+	  
+      vector<size_t> range_sort_p = data::sort_permutation(src_idx_ranges, compare_range_idx);
+              
+      data::apply_permutation_in_place(selection_dst_idx, range_sort_p);
+      data::apply_permutation_in_place(src_idx_ranges, range_sort_p);
+
+      ATTR_PTR_T selection_dst_ptr_pos = 0;
+      for (const auto& range : src_idx_ranges)
+        {
+          hsize_t src_idx_block=range.second;
+
+          selection_dst_ptr.push_back(selection_dst_ptr_pos);
+          selection_dst_ptr_pos += src_idx_block;
+        }
+      selection_dst_ptr.push_back(selection_dst_ptr_pos);
+    }
+
+    // Reads the source indices in the given ranges
+    herr_t read_selection_src_idx
+    (
+     MPI_Comm                   comm,
+     const std::string&         file_name,
+     const std::string&         src_pop_name,
+     const std::string&         dst_pop_name,
+     const vector< pair<hsize_t,hsize_t> >& src_idx_ranges,
+     vector<NODE_IDX_T>&        src_idx,
+     bool collective
+     )
+    {
+      herr_t ierr = 0;
+
+      /* Create property list for parallel file access. */
+      hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
+      throw_assert_nomsg(fapl >= 0);
+      throw_assert_nomsg(hdf5::set_parallel_file_access(fapl, comm) >= 0);
+            
+      /* Create property list for collective dataset operations. */
+      hid_t rapl = H5Pcreate (H5P_DATASET_XFER);
+#ifdef HDF5_IS_PARALLEL
+      if (collective)
+        {
+          ierr = H5Pset_dxpl_mpio (rapl, H5FD_MPIO_COLLECTIVE);
+          throw_assert(ierr >= 0,
+                       "read_projection_dataset_selection: error in H5Pset_dxpl_mpio");
+        }
+#endif
+            
+      hid_t file = H5Fopen(file_name.c_str(), H5F_ACC_RDONLY, fapl);
+      throw_assert_nomsg(file >= 0);
+            
+      ierr = hdf5::read_selection<NODE_IDX_T>
+        (
+         file,
+         hdf5::edge_attribute_path(src_pop_name, dst_pop_name, hdf5::EDGES, hdf5::SRC_IDX),
+         NODE_IDX_H5_NATIVE_T,
+         src_idx_ranges,
+         src_idx,
+         rapl
+         );
+      throw_assert_nomsg(ierr >= 0);
+            
+      throw_assert_nomsg(H5Fclose(file) >= 0);
+      throw_assert_nomsg(H5Pclose(fapl) >= 0);
+      throw_assert_nomsg(H5Pclose(rapl) >= 0);
+
+      return ierr;
+    }
+
+    // Determines the source index ranges of the selected destinations
+    // with the destination lookup index of the projection, reading
+    // only the parts of the index and Destination Pointer that are
+    // needed. As in the full scan, edge_base is the Destination Pointer
+    // value at the position given by the first Destination Block Pointer
+    // entry (ptr_base).
+    herr_t read_projection_index_selection
+    (
+     MPI_Comm                   comm,
+     const std::string&         file_name,
+     const std::string&         src_pop_name,
+     const std::string&         dst_pop_name,
+     const NODE_IDX_T&          dst_start,
+     const std::vector<NODE_IDX_T>&  selection,
+     const DST_BLK_PTR_T&       ptr_base,
+     DST_PTR_T&                 edge_base,
+     vector<NODE_IDX_T>&        selection_dst_idx,
+     vector< pair<hsize_t,hsize_t> >& src_idx_ranges,
+     bool collective
+     )
+    {
+      herr_t ierr = 0;
+
+      hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
+      throw_assert_nomsg(fapl >= 0);
+      throw_assert_nomsg(hdf5::set_parallel_file_access(fapl, comm) >= 0);
+      hid_t rapl = H5Pcreate (H5P_DATASET_XFER);
+#ifdef HDF5_IS_PARALLEL
+      if (collective)
+        {
+          ierr = H5Pset_dxpl_mpio (rapl, H5FD_MPIO_COLLECTIVE);
+          throw_assert(ierr >= 0,
+                       "read_projection_dataset_selection: error in H5Pset_dxpl_mpio");
+        }
+#endif
+      hid_t file = H5Fopen(file_name.c_str(), H5F_ACC_RDONLY, fapl);
+      throw_assert_nomsg(file >= 0);
+
+      vector<NODE_IDX_T> dst_indices;
+      for (const NODE_IDX_T& s : selection) 
+        {
+          if (s >= dst_start)
+            {
+              dst_indices.push_back(s-dst_start);
+            }
+        }
+
+      vector< pair<NODE_IDX_T, hsize_t> > dst_ptr_pos;
+      ierr = hdf5::lookup_projection_index(file, rapl, src_pop_name, dst_pop_name,
+                                           dst_indices, dst_ptr_pos);
+      throw_assert_nomsg(ierr >= 0);
+
+      // Read the destination pointer of each found destination and of
+      // its successor, and the one that gives the edge base
+      vector<hsize_t> ptr_pos(1, (hsize_t)ptr_base);
+      for (const auto& p : dst_ptr_pos)
+        {
+          ptr_pos.push_back(p.second);
+          ptr_pos.push_back(p.second+1);
+        }
+      std::sort(ptr_pos.begin(), ptr_pos.end());
+      ptr_pos.erase(std::unique(ptr_pos.begin(), ptr_pos.end()), ptr_pos.end());
+
+      vector< pair<hsize_t,hsize_t> > ptr_ranges;
+      for (const hsize_t& pos : ptr_pos)
+        {
+          if ((!ptr_ranges.empty()) && (ptr_ranges.back().first + ptr_ranges.back().second == pos))
+            {
+              ptr_ranges.back().second++;
+            }
+          else
+            {
+              ptr_ranges.push_back(make_pair(pos, 1));
+            }
+        }
+
+      vector<DST_PTR_T> ptr_values;
+      ierr = hdf5::read_selection<DST_PTR_T>
+        (
+         file,
+         hdf5::edge_attribute_path(src_pop_name, dst_pop_name, hdf5::EDGES, hdf5::DST_PTR),
+         DST_PTR_H5_NATIVE_T,
+         ptr_ranges,
+         ptr_values,
+         rapl
+         );
+      throw_assert_nomsg(ierr >= 0);
+
+      throw_assert_nomsg(H5Fclose(file) >= 0);
+      throw_assert_nomsg(H5Pclose(fapl) >= 0);
+      throw_assert_nomsg(H5Pclose(rapl) >= 0);
+
+      auto ptr_value = [&](hsize_t pos)
+        {
+          auto it = std::lower_bound(ptr_pos.begin(), ptr_pos.end(), pos);
+          return ptr_values[it - ptr_pos.begin()];
+        };
+
+      edge_base = ptr_value(ptr_base);
+      for (const NODE_IDX_T& s : selection) 
+        {
+          if (s >= dst_start)
+            {
+              NODE_IDX_T n = s-dst_start;
+              auto it = std::lower_bound(dst_ptr_pos.begin(), dst_ptr_pos.end(), make_pair(n, (hsize_t)0));
+              if ((it != dst_ptr_pos.end()) && (it->first == n))
+                {
+                  selection_dst_idx.push_back(s);
+
+                  hsize_t src_idx_start=ptr_value(it->second);
+                  hsize_t src_idx_block=ptr_value(it->second+1)-src_idx_start;
+
+                  src_idx_ranges.push_back(make_pair(src_idx_start, src_idx_block));
+                }
+              else
+                {
+                  throw runtime_error(string("read_projection_dataset_selection: destination index ")+
+                                      std::to_string(s)+
+                                      string(" not found in destination index dataset ")+
+                                      hdf5::edge_attribute_path(src_pop_name, dst_pop_name, 
+                                                                hdf5::EDGES, hdf5::DST_LOOKUP_IDX));
+                }
+            }
+        }
+
+      return ierr;
+    }
+
     /**************************************************************************
      * Read a subset of the basic DBS graph structure
      *************************************************************************/
@@ -61,6 +271,8 @@ namespace neuroh5
       throw_assert_nomsg(MPI_Comm_rank(comm, (int*)&rank) == MPI_SUCCESS);
 
       size_t num_blocks=0;
+      uint8_t has_index = 0;
+      DST_BLK_PTR_T ptr_base = 0;
       
       if (rank == 0)
         {
@@ -77,15 +289,55 @@ namespace neuroh5
           total_num_edges = hdf5::dataset_num_elements
             (file, hdf5::edge_attribute_path(src_pop_name, dst_pop_name, hdf5::EDGES, hdf5::SRC_IDX));
 
+          has_index = hdf5::has_projection_index(file, src_pop_name, dst_pop_name) ? 1 : 0;
+
+          if ((num_blocks > 0) && (has_index > 0))
+            {
+              vector<DST_BLK_PTR_T> blk_ptr_front(1, 0);
+              ierr = hdf5::read<DST_BLK_PTR_T>
+                (
+                 file,
+                 hdf5::edge_attribute_path(src_pop_name, dst_pop_name, hdf5::EDGES, hdf5::DST_BLK_PTR),
+                 0,
+                 1,
+                 DST_BLK_PTR_H5_NATIVE_T,
+                 blk_ptr_front,
+                 H5P_DEFAULT
+                 );
+              throw_assert_nomsg(ierr >= 0);
+              ptr_base = blk_ptr_front[0];
+            }
+
           throw_assert_nomsg(H5Fclose(file) >= 0);
         }
       
       throw_assert_nomsg(MPI_Bcast(&num_blocks, 1, MPI_SIZE_T, 0, comm) == MPI_SUCCESS);
       throw_assert_nomsg(MPI_Bcast(&total_num_edges, 1, MPI_SIZE_T, 0, comm) == MPI_SUCCESS);
+      throw_assert_nomsg(MPI_Bcast(&has_index, 1, MPI_UINT8_T, 0, comm) == MPI_SUCCESS);
+      throw_assert_nomsg(MPI_Bcast(&ptr_base, 1, MPI_ATTR_PTR_T, 0, comm) == MPI_SUCCESS);
 
       hsize_t read_blocks = num_blocks;
-      
-      if (read_blocks > 0)
+
+      if ((read_blocks > 0) && (has_index > 0))
+        {
+          mpi::MPI_DEBUG(comm, "read_projection_dataset_selection: using destination lookup index for: ", 
+                         src_pop_name, " -> ", dst_pop_name);
+
+          ierr = read_projection_index_selection(comm, file_name, src_pop_name, dst_pop_name,
+                                                 dst_start, selection, ptr_base, edge_base,
+                                                 selection_dst_idx, src_idx_ranges, collective);
+          throw_assert_nomsg(ierr >= 0);
+
+          sort_selection_ranges(selection_dst_idx, src_idx_ranges, selection_dst_ptr);
+          if (src_idx_ranges.size() > 0)
+            {
+              src_idx.resize(selection_dst_ptr.back(), 0);
+            }
+
+          ierr = read_selection_src_idx(comm, file_name, src_pop_name, dst_pop_name,
+                                        src_idx_ranges, src_idx, collective);
+        }
+      else if (read_blocks > 0)
         {
           DST_BLK_PTR_T block_rebase = 0;
           vector<DST_BLK_PTR_T> dst_blk_ptr(read_blocks+1, 0);
@@ -266,23 +518,8 @@ namespace neuroh5
                     }
                 }
 
-              auto compare_range_idx = [](const std::pair<hsize_t, hsize_t>& a, const std::pair<hsize_t, hsize_t>& b) 
-                { return (a.first < b.first); };
-	  
-              vector<size_t> range_sort_p = data::sort_permutation(src_idx_ranges, compare_range_idx);
-              
-              data::apply_permutation_in_place(selection_dst_idx, range_sort_p);
-              data::apply_permutation_in_place(src_idx_ranges, range_sort_p);
-
-              for (const auto& range : src_idx_ranges)
-                {
-                  hsize_t src_idx_start=range.first;
-                  hsize_t src_idx_block=range.second;
-
-                  selection_dst_ptr.push_back(selection_dst_ptr_pos);
-                  selection_dst_ptr_pos += src_idx_block;
-                }
-              selection_dst_ptr.push_back(selection_dst_ptr_pos);
+              sort_selection_ranges(selection_dst_idx, src_idx_ranges, selection_dst_ptr);
+              selection_dst_ptr_pos = selection_dst_ptr.back();
             }
 
 
@@ -297,45 +534,8 @@ namespace neuroh5
           mpi::MPI_DEBUG(comm, "read_projection_dataset_selection: reading source indices for: ", 
                          src_pop_name, " -> ", dst_pop_name, ": ", src_idx.size(), " elements");
           
-          {
-            
-            /* Create property list for parallel file access. */
-            hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
-            throw_assert_nomsg(fapl >= 0);
-#ifdef HDF5_IS_PARALLEL
-            throw_assert_nomsg(H5Pset_fapl_mpio(fapl, comm, MPI_INFO_NULL) >= 0);
-#endif
-            
-            /* Create property list for collective dataset operations. */
-            hid_t rapl = H5Pcreate (H5P_DATASET_XFER);
-#ifdef HDF5_IS_PARALLEL
-            if (collective)
-              {
-                ierr = H5Pset_dxpl_mpio (rapl, H5FD_MPIO_COLLECTIVE);
-                throw_assert(ierr >= 0,
-                             "read_projection_dataset_selection: error in H5Pset_dxpl_mpio");
-              }
-#endif
-            
-            hid_t file = H5Fopen(file_name.c_str(), H5F_ACC_RDONLY, fapl);
-            throw_assert_nomsg(file >= 0);
-            
-            ierr = hdf5::read_selection<NODE_IDX_T>
-              (
-               file,
-               hdf5::edge_attribute_path(src_pop_name, dst_pop_name, hdf5::EDGES, hdf5::SRC_IDX),
-               NODE_IDX_H5_NATIVE_T,
-               src_idx_ranges,
-               src_idx,
-               rapl
-               );
-            throw_assert_nomsg(ierr >= 0);
-            
-            throw_assert_nomsg(H5Fclose(file) >= 0);
-            throw_assert_nomsg(H5Pclose(fapl) >= 0);
-            throw_assert_nomsg(H5Pclose(rapl) >= 0);
-
-          }
+          ierr = read_selection_src_idx(comm, file_name, src_pop_name, dst_pop_name,
+                                        src_idx_ranges, src_idx, collective);
           
         }
 
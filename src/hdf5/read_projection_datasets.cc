@@ -12,6 +12,8 @@
 #include <sstream>
 #include <string>
 #include <iomanip>  // For setw
+#include <algorithm>
+#include <limits>
 
 #include "debug.hh"
 
@@ -22,6 +24,7 @@
 #include "rank_range.hh"
 #include "read_projection_datasets.hh"
 #include "mpi_debug.hh"
+#include "file_access.hh"
 #include "throw_assert.hh"
 
 
@@ -323,12 +326,117 @@ namespace neuroh5
 
     }
 
+    // Function to compute the destination block range of each rank
+    // when blocks are distributed evenly; rank r is assigned blocks
+    // [block_bounds[r], block_bounds[r+1])
+    void even_block_bounds
+    (
+     const hsize_t                total_blocks,
+     const unsigned int           size,
+     vector<hsize_t>&             block_bounds
+     )
+    {
+      hsize_t blocks_per_rank = total_blocks / size;
+      hsize_t remainder = total_blocks % size;
+
+      block_bounds.assign(size+1, 0);
+      for (unsigned int i = 0; i < size; i++)
+        {
+          block_bounds[i+1] = block_bounds[i] + blocks_per_rank + (i < remainder ? 1 : 0);
+        }
+    }
+
+    // Function to compute the cumulative weight of the blocks preceding
+    // each of the given block pointers: every destination contributes
+    // the size of its pointer, and every edge the size of its source
+    // index plus edge_attr_bytes of attribute data; blk_ptr_dst_ptr
+    // holds the destination pointer at each block pointer
+    void block_prefix_weights
+    (
+     const vector<DST_BLK_PTR_T>& blk_ptr,
+     const vector<DST_PTR_T>&     blk_ptr_dst_ptr,
+     const size_t                 edge_attr_bytes,
+     vector<uint64_t>&            prefix_weights
+     )
+    {
+      const uint64_t edge_bytes = sizeof(NODE_IDX_T) + edge_attr_bytes;
+      prefix_weights.resize(blk_ptr.size());
+      for (size_t i = 0; i < blk_ptr.size(); i++)
+        {
+          prefix_weights[i] = blk_ptr[i] * sizeof(DST_PTR_T) + blk_ptr_dst_ptr[i] * edge_bytes;
+        }
+    }
+
+    // Function to find the weighted block boundaries that fall within
+    // a contiguous range of block pointers starting at first_block:
+    // block_bounds[k] is lowered to the first block whose prefix weight
+    // reaches k/size of the total weight
+    void weighted_block_bounds
+    (
+     const vector<uint64_t>&      prefix_weights,
+     const hsize_t                first_block,
+     const uint64_t               base_weight,
+     const uint64_t               total_weight,
+     const unsigned int           size,
+     vector<hsize_t>&             block_bounds
+     )
+    {
+      for (unsigned int k = 0; k <= size; k++)
+        {
+          // ceil(k * total_weight / size), without overflowing
+          uint64_t threshold = base_weight + (total_weight / size) * k +
+            ((total_weight % size) * k + size - 1) / size;
+          auto it = std::lower_bound(prefix_weights.begin(), prefix_weights.end(), threshold);
+          if (it != prefix_weights.end())
+            {
+              hsize_t b = first_block + (it - prefix_weights.begin());
+              block_bounds[k] = std::min(block_bounds[k], b);
+            }
+        }
+    }
+
+    // Function to compute the destination block range of each rank
+    // from the full pointer arrays read by rank 0
+    void compute_block_bounds
+    (
+     const vector<DST_BLK_PTR_T>& dst_blk_ptr,
+     const vector<DST_PTR_T>&     dst_ptr,
+     const unsigned int           size,
+     const ProjectionBlockAssignment block_assignment,
+     const size_t                 edge_attr_bytes,
+     vector<hsize_t>&             block_bounds
+     )
+    {
+      hsize_t total_blocks = dst_blk_ptr.size() > 0 ? dst_blk_ptr.size() - 1 : 0;
+      even_block_bounds(total_blocks, size, block_bounds);
+
+      if ((block_assignment != BlockAssignEdgeWeighted) || (total_blocks == 0))
+        return;
+
+      vector<DST_PTR_T> blk_ptr_dst_ptr(dst_blk_ptr.size());
+      for (size_t i = 0; i < dst_blk_ptr.size(); i++)
+        {
+          blk_ptr_dst_ptr[i] = dst_ptr[std::min((size_t)dst_blk_ptr[i], dst_ptr.size()-1)];
+        }
+
+      vector<uint64_t> prefix_weights;
+      block_prefix_weights(dst_blk_ptr, blk_ptr_dst_ptr, edge_attr_bytes, prefix_weights);
+      uint64_t base_weight = prefix_weights.front();
+      uint64_t total_weight = prefix_weights.back() - base_weight;
+      if (total_weight == 0)
+        return;
+
+      block_bounds.assign(size+1, total_blocks);
+      weighted_block_bounds(prefix_weights, 0, base_weight, total_weight, size, block_bounds);
+    }
+
     // Function to assign destination blocks to ranks
     void assign_blocks_to_ranks
     (
      const vector<DST_BLK_PTR_T>& dst_blk_ptr,
      const vector<NODE_IDX_T>&    dst_idx,
      const vector<DST_PTR_T>&     dst_ptr,
+     const vector<hsize_t>&       block_bounds,
      RankAssignments              &rank_assignments,
      unsigned int                 size,
      size_t                       offset = 0,
@@ -374,10 +482,6 @@ namespace neuroh5
         return;
     }
 
-      // Simple approach: distribute blocks evenly
-      hsize_t blocks_per_rank = total_blocks / size;
-      hsize_t remainder = total_blocks % size;
-
       // Calculate the end of the destination block pointer range
       hsize_t last_block = offset + read_blocks - 1;
       hsize_t block_ptr_end = (last_block < total_blocks) ? 
@@ -393,7 +497,7 @@ namespace neuroh5
       for (unsigned int i = 0; i < size; i++)
         {
           // Calculate how many blocks this rank gets
-          hsize_t rank_block_count = blocks_per_rank + (i < remainder ? 1 : 0);
+          hsize_t rank_block_count = block_bounds[i+1] - block_bounds[i];
         
           // Assign blocks to ranks
           rank_assignments.dst_block_start[i] = current_block;
@@ -436,6 +540,288 @@ namespace neuroh5
         }
     }
 
+    // Function to compute the weighted destination block range of each
+    // rank without reading the full pointer arrays: each rank reads the
+    // block pointers of its even share of blocks and the destination
+    // pointers they refer to, and the boundaries found by each rank are
+    // combined with a reduction
+    void compute_block_bounds_distributed
+    (
+     MPI_Comm                     comm,
+     hid_t                        file,
+     hid_t                        rapl,
+     const std::string&           src_pop_name,
+     const std::string&           dst_pop_name,
+     const hsize_t                total_blocks,
+     const hsize_t                total_dst_ptr,
+     const ProjectionBlockAssignment block_assignment,
+     const size_t                 edge_attr_bytes,
+     vector<hsize_t>&             block_bounds
+     )
+    {
+      unsigned int rank, size;
+      throw_assert_nomsg(MPI_Comm_size(comm, (int*)&size) == MPI_SUCCESS);
+      throw_assert_nomsg(MPI_Comm_rank(comm, (int*)&rank) == MPI_SUCCESS);
+
+      even_block_bounds(total_blocks, size, block_bounds);
+
+      if ((block_assignment != BlockAssignEdgeWeighted) || (total_blocks == 0) || (total_dst_ptr == 0))
+        return;
+
+      hsize_t block_start = block_bounds[rank];
+      hsize_t block_count = block_bounds[rank+1] - block_bounds[rank];
+      hsize_t blk_ptr_count = block_count > 0 ? block_count + 1 : 0;
+
+      vector<DST_BLK_PTR_T> blk_ptr(blk_ptr_count, 0);
+      throw_assert_nomsg(hdf5::read<DST_BLK_PTR_T>
+                         (
+                          file,
+                          hdf5::edge_attribute_path(src_pop_name, dst_pop_name, hdf5::EDGES, hdf5::DST_BLK_PTR),
+                          block_start,
+                          blk_ptr_count,
+                          DST_BLK_PTR_H5_NATIVE_T,
+                          blk_ptr,
+                          rapl
+                          ) >= 0);
+
+      // Destination pointers at the block pointers; block pointers are
+      // strictly increasing, so each one is a separate point
+      vector< pair<hsize_t,hsize_t> > ranges;
+      for (size_t i = 0; i < blk_ptr.size(); i++)
+        {
+          hsize_t pos = std::min((hsize_t)blk_ptr[i], total_dst_ptr-1);
+          throw_assert_nomsg(ranges.empty() || (pos > ranges.back().first));
+          ranges.push_back(make_pair(pos, 1));
+        }
+      vector<DST_PTR_T> blk_ptr_dst_ptr;
+      throw_assert_nomsg(hdf5::read_selection<DST_PTR_T>
+                         (
+                          file,
+                          hdf5::edge_attribute_path(src_pop_name, dst_pop_name, hdf5::EDGES, hdf5::DST_PTR),
+                          DST_PTR_H5_NATIVE_T,
+                          ranges,
+                          blk_ptr_dst_ptr,
+                          rapl
+                          ) >= 0);
+
+      vector<uint64_t> prefix_weights;
+      block_prefix_weights(blk_ptr, blk_ptr_dst_ptr, edge_attr_bytes, prefix_weights);
+
+      // Prefix weights are monotonic, so the base weight is the global
+      // minimum and the total weight follows from the global maximum
+      uint64_t local_minmax[2] = { std::numeric_limits<uint64_t>::max(), 0 };
+      if (prefix_weights.size() > 0)
+        {
+          local_minmax[0] = prefix_weights.front();
+          local_minmax[1] = prefix_weights.back();
+        }
+      uint64_t base_weight = 0, max_weight = 0;
+      throw_assert(MPI_Allreduce(&local_minmax[0], &base_weight, 1, MPI_UINT64_T, MPI_MIN, comm) == MPI_SUCCESS,
+                   "error in MPI_Allreduce");
+      throw_assert(MPI_Allreduce(&local_minmax[1], &max_weight, 1, MPI_UINT64_T, MPI_MAX, comm) == MPI_SUCCESS,
+                   "error in MPI_Allreduce");
+      uint64_t total_weight = max_weight - base_weight;
+      if (total_weight == 0)
+        return;
+
+      vector<hsize_t> local_bounds(size+1, total_blocks);
+      weighted_block_bounds(prefix_weights, block_start, base_weight, total_weight, size, local_bounds);
+      throw_assert(MPI_Allreduce(local_bounds.data(), block_bounds.data(), size+1, MPI_UNSIGNED_LONG_LONG,
+                                 MPI_MIN, comm) == MPI_SUCCESS,
+                   "error in MPI_Allreduce");
+    }
+
+    // Function for each rank to collectively read its own slice of the
+    // pointer datasets and fill in its entries of the rank assignments,
+    // without involving rank 0
+    herr_t read_projection_ptr_distributed
+    (
+     MPI_Comm                   comm,
+     const std::string&         file_name,
+     const std::string&         src_pop_name,
+     const std::string&         dst_pop_name,
+     RankAssignments&           rank_assignments,
+     vector<DST_BLK_PTR_T>&     dst_blk_ptr,
+     vector<NODE_IDX_T>&        dst_idx,
+     vector<DST_PTR_T>&         dst_ptr,
+     size_t&                    total_num_edges,
+     hsize_t&                   total_read_blocks,
+     bool                       collective,
+     ProjectionBlockAssignment  block_assignment,
+     size_t                     edge_attr_bytes
+     )
+    {
+      herr_t ierr = 0;
+      unsigned int rank, size;
+      throw_assert_nomsg(MPI_Comm_size(comm, (int*)&size) == MPI_SUCCESS);
+      throw_assert_nomsg(MPI_Comm_rank(comm, (int*)&rank) == MPI_SUCCESS);
+
+      hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
+      throw_assert_nomsg(fapl >= 0);
+      // all ranks open the same datasets in the same order
+      throw_assert_nomsg(hdf5::set_parallel_file_access(fapl, comm, true) >= 0);
+      hid_t file = H5Fopen(file_name.c_str(), H5F_ACC_RDONLY, fapl);
+      throw_assert_nomsg(file >= 0);
+
+      hid_t rapl = H5Pcreate(H5P_DATASET_XFER);
+      throw_assert_nomsg(rapl >= 0);
+#ifdef HDF5_IS_PARALLEL
+      if (collective)
+        {
+          throw_assert_nomsg(H5Pset_dxpl_mpio(rapl, H5FD_MPIO_COLLECTIVE) >= 0);
+        }
+#endif
+
+      // Get dataset sizes; every rank obtains them, so there is
+      // nothing to broadcast afterwards
+      total_read_blocks = hdf5::dataset_num_elements
+        (file, hdf5::edge_attribute_path(src_pop_name, dst_pop_name, hdf5::EDGES, hdf5::DST_BLK_PTR));
+      total_num_edges = hdf5::dataset_num_elements
+        (file, hdf5::edge_attribute_path(src_pop_name, dst_pop_name, hdf5::EDGES, hdf5::SRC_IDX));
+
+      hsize_t total_dst_ptr = hdf5::dataset_num_elements
+        (file, hdf5::edge_attribute_path(src_pop_name, dst_pop_name, hdf5::EDGES, hdf5::DST_PTR));
+
+      hsize_t total_blocks = total_read_blocks > 0 ? total_read_blocks - 1 : 0;
+
+      vector<hsize_t> block_bounds;
+      compute_block_bounds_distributed(comm, file, rapl, src_pop_name, dst_pop_name,
+                                       total_blocks, total_dst_ptr, block_assignment,
+                                       edge_attr_bytes, block_bounds);
+
+      // The last rank with a non-empty block range reads the final
+      // destination pointer instead of a sentinel shared with its successor
+      rank_t last_rank = 0;
+      for (unsigned int r = 0; r < size; r++)
+        {
+          if (block_bounds[r+1] > block_bounds[r])
+            {
+              last_rank = r;
+            }
+        }
+      rank_assignments.last_rank = last_rank;
+
+      hsize_t block_start = block_bounds[rank];
+      hsize_t block_count = block_bounds[rank+1] - block_bounds[rank];
+
+      // Read the slice of dst_blk_ptr, including the pointer that
+      // bounds the last block of this rank
+      hsize_t blk_ptr_count = block_count > 0 ? block_count + 1 : 0;
+      dst_blk_ptr.resize(blk_ptr_count, 0);
+      ierr = hdf5::read<DST_BLK_PTR_T>
+        (
+         file,
+         hdf5::edge_attribute_path(src_pop_name, dst_pop_name, hdf5::EDGES, hdf5::DST_BLK_PTR),
+         block_start,
+         blk_ptr_count,
+         DST_BLK_PTR_H5_NATIVE_T,
+         dst_blk_ptr,
+         rapl
+         );
+      throw_assert_nomsg(ierr >= 0);
+
+      // Read the slice of dst_idx
+      dst_idx.resize(block_count, 0);
+      ierr = hdf5::read<NODE_IDX_T>
+        (
+         file,
+         hdf5::edge_attribute_path(src_pop_name, dst_pop_name, hdf5::EDGES, hdf5::DST_BLK_IDX),
+         block_start,
+         block_count,
+         NODE_IDX_H5_NATIVE_T,
+         dst_idx,
+         rapl
+         );
+      throw_assert_nomsg(ierr >= 0);
+
+      // Read the slice of dst_ptr; all ranks but the last one also
+      // read the first pointer of the next rank as a sentinel
+      hsize_t dst_ptr_start = 0, dst_ptr_count = 0, dst_ptr_read = 0;
+      if (block_count > 0)
+        {
+          dst_ptr_start = dst_blk_ptr.front();
+          dst_ptr_count = dst_blk_ptr.back() - dst_blk_ptr.front();
+          dst_ptr_read  = (rank < last_rank) ? dst_ptr_count + 1 : dst_ptr_count;
+        }
+      dst_ptr.resize(dst_ptr_read, 0);
+      ierr = hdf5::read<DST_PTR_T>
+        (
+         file,
+         hdf5::edge_attribute_path(src_pop_name, dst_pop_name, hdf5::EDGES, hdf5::DST_PTR),
+         dst_ptr_start,
+         dst_ptr_read,
+         DST_PTR_H5_NATIVE_T,
+         dst_ptr,
+         rapl
+         );
+      throw_assert_nomsg(ierr >= 0);
+
+      throw_assert_nomsg(H5Pclose(rapl) >= 0);
+      throw_assert_nomsg(H5Fclose(file) >= 0);
+      throw_assert_nomsg(H5Pclose(fapl) >= 0);
+
+      // Fill in the assignment of this rank
+      rank_assignments.dst_block_start[rank] = block_start;
+      rank_assignments.dst_block_count[rank] = block_count;
+      rank_assignments.dst_ptr_start[rank]   = dst_ptr_start;
+      rank_assignments.dst_ptr_count[rank]   = dst_ptr_count;
+      if (dst_ptr.size() > 0)
+        {
+          rank_assignments.src_idx_start[rank] = dst_ptr.front();
+          rank_assignments.src_idx_count[rank] = dst_ptr.back() - dst_ptr.front();
+        }
+      rank_assignments.local_dst_indices[rank] = dst_idx;
+
+      // Rebase the pointer arrays to local offsets
+      if (dst_blk_ptr.size() > 0)
+        {
+          DST_BLK_PTR_T block_rebase = dst_blk_ptr.front();
+          for (size_t i = 0; i < dst_blk_ptr.size(); ++i)
+            {
+              dst_blk_ptr[i] -= block_rebase;
+            }
+        }
+      if (dst_ptr.size() > 0)
+        {
+          DST_PTR_T ptr_rebase = dst_ptr.front();
+          for (size_t i = 0; i < dst_ptr.size(); ++i)
+            {
+              dst_ptr[i] -= ptr_rebase;
+            }
+        }
+
+      // The assignment table of the other ranks is only needed for
+      // the debug printout
+      if (debug_enabled)
+        {
+          vector<hsize_t> local_assignment =
+            {
+              rank_assignments.dst_block_start[rank],
+              rank_assignments.dst_block_count[rank],
+              rank_assignments.src_idx_start[rank],
+              rank_assignments.src_idx_count[rank],
+              rank_assignments.dst_ptr_start[rank],
+              rank_assignments.dst_ptr_count[rank]
+            };
+          vector<hsize_t> all_assignments(6*size, 0);
+          throw_assert(MPI_Allgather(local_assignment.data(), 6, MPI_UNSIGNED_LONG_LONG,
+                                     all_assignments.data(), 6, MPI_UNSIGNED_LONG_LONG,
+                                     comm) == MPI_SUCCESS,
+                       "error in MPI_Allgather");
+          for (unsigned int r = 0; r < size; r++)
+            {
+              rank_assignments.dst_block_start[r] = all_assignments[6*r];
+              rank_assignments.dst_block_count[r] = all_assignments[6*r+1];
+              rank_assignments.src_idx_start[r]   = all_assignments[6*r+2];
+              rank_assignments.src_idx_count[r]   = all_assignments[6*r+3];
+              rank_assignments.dst_ptr_start[r]   = all_assignments[6*r+4];
+              rank_assignments.dst_ptr_count[r]   = all_assignments[6*r+5];
+            }
+        }
+
+      return ierr;
+    }
+
     // Function for each rank to read its portion of src_idx
     herr_t read_projection_src_idx
     (
@@ -454,11 +840,10 @@ namespace neuroh5
     
       //      if (rank_assignments.src_idx_count[rank] > 0)
         {
-          // Open the file with parallel access
+          // Open the file with parallel access and collective metadata
+          // reads, as all ranks open the same datasets in the same order
           hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
-#ifdef HDF5_IS_PARALLEL
-          H5Pset_fapl_mpio(fapl, comm, MPI_INFO_NULL);
-#endif
+          hdf5::set_parallel_file_access(fapl, comm, true);
           hid_t file = H5Fopen(file_name.c_str(), H5F_ACC_RDONLY, fapl);
         
           // Create property list for collective dataset operations
@@ -706,7 +1091,10 @@ namespace neuroh5
      hsize_t&                   local_read_blocks,
      size_t                     offset,
      size_t                     numitems,
-     bool collective
+     bool collective,
+     ProjectionPtrReadMode      ptr_read_mode,
+     ProjectionBlockAssignment  block_assignment,
+     size_t                     edge_attr_bytes
      )
     {
       herr_t ierr = 0;
@@ -719,6 +1107,29 @@ namespace neuroh5
 
       // Structure to hold per-rank assignments
       RankAssignments rank_assignments(size);
+
+      if (ptr_read_mode == PtrReadDistributed)
+        {
+          // Each rank reads its own slice of the pointer datasets
+          ierr = read_projection_ptr_distributed(comm, file_name, src_pop_name, dst_pop_name,
+                                                 rank_assignments, dst_blk_ptr, dst_idx, dst_ptr,
+                                                 total_num_edges, total_read_blocks, collective,
+                                                 block_assignment, edge_attr_bytes);
+          throw_assert_nomsg(ierr >= 0);
+
+          if (debug_enabled)
+            {
+              print_rank_assignments(comm, rank_assignments);
+            }
+
+          block_base = rank_assignments.dst_block_start[rank];
+          edge_base = rank_assignments.src_idx_start[rank];
+          local_read_blocks = rank_assignments.dst_block_count[rank];
+
+          ierr = read_projection_src_idx(comm, file_name, src_pop_name, dst_pop_name, 
+                                         rank_assignments, src_idx);
+          return ierr;
+        }
     
       // Only rank 0 reads the pointer data and partitions the data
       if (rank == 0)
@@ -734,7 +1145,11 @@ namespace neuroh5
 
 
           // Step 2: Assign destination blocks to ranks
-          assign_blocks_to_ranks(full_dst_blk_ptr, full_dst_idx, full_dst_ptr, rank_assignments, size);
+          vector<hsize_t> block_bounds;
+          compute_block_bounds(full_dst_blk_ptr, full_dst_ptr, size, block_assignment,
+                               edge_attr_bytes, block_bounds);
+          assign_blocks_to_ranks(full_dst_blk_ptr, full_dst_idx, full_dst_ptr, block_bounds,
+                                 rank_assignments, size);
 
           // Step 3: Distribute appropriate parts of pointer arrays to all ranks
           distribute_ptr_arrays(comm, rank, rank_assignments, dst_blk_ptr, dst_idx, dst_ptr, 
@@ -770,7 +1185,7 @@ namespace neuroh5
       distribute_assignments(comm, rank_assignments);
       block_base = rank_assignments.dst_block_start[rank];
       edge_base = rank_assignments.src_idx_start[rank];
-
+      local_read_blocks = rank_assignments.dst_block_count[rank];
       
       // Step 6: Each rank reads its portion of src_idx based on its assignment
       ierr = read_projection_src_idx(comm, file_name, src_pop_name, dst_pop_name, 
@@ -802,9 +1217,7 @@ namespace neuroh5
 
       hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
       throw_assert_nomsg(fapl >= 0);
-#ifdef HDF5_IS_PARALLEL
-      throw_assert_nomsg(H5Pset_fapl_mpio(fapl, comm, MPI_INFO_NULL) >= 0);
-#endif
+      throw_assert_nomsg(hdf5::set_parallel_file_access(fapl, comm) >= 0);
 
       hid_t file = H5Fopen(file_name.c_str(), H5F_ACC_RDONLY, fapl);
       throw_assert_nomsg(file >= 0);
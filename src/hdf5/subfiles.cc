@@ -0,0 +1,160 @@
+// -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+//==============================================================================
+///  @file subfiles.cc
+///
+///  Per-I/O-rank subfiles used by the subfile write mode.
+///
+///  Copyright (C) 2016-2025 Project NeuroH5.
+//==============================================================================
+
+#include <mpi.h>
+#include <hdf5.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <string>
+
+#include "neuroh5_types.hh"
+#include "subfiles.hh"
+#include "exists_group.hh"
+#include "path_names.hh"
+#include "file_access.hh"
+#include "dataset_filters.hh"
+#include "throw_assert.hh"
+
+using namespace std;
+
+namespace neuroh5
+{
+  namespace hdf5
+  {
+
+    string subfile_name
+    (
+     const string& file_name,
+     const size_t  index
+     )
+    {
+      return file_name + ".subfile." + std::to_string(index);
+    }
+
+
+    hid_t open_subfile
+    (
+     const string& file_name,
+     const size_t  index,
+     const size_t  cache_size
+     )
+    {
+      register_filters();
+
+      const string name = subfile_name(file_name, index);
+
+      if (access(name.c_str(), F_OK) != 0)
+        {
+          hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
+          throw_assert(fapl >= 0, "open_subfile: unable to create file access property list");
+          throw_assert(set_file_access_properties(fapl) >= 0,
+                       "open_subfile: unable to set file access properties");
+          hid_t file = H5Fcreate(name.c_str(), H5F_ACC_EXCL, H5P_DEFAULT, fapl);
+          throw_assert(file >= 0, "open_subfile: unable to create subfile " << name);
+
+          if (access(file_name.c_str(), F_OK) == 0)
+            {
+              hid_t src_file = H5Fopen(file_name.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+              throw_assert(src_file >= 0, "open_subfile: unable to open file " << file_name);
+              if (exists_group(src_file, H5_TYPES) > 0)
+                {
+                  throw_assert(H5Ocopy(src_file, H5_TYPES.c_str(), file, H5_TYPES.c_str(),
+                                       H5P_DEFAULT, H5P_DEFAULT) >= 0,
+                               "open_subfile: unable to copy " << H5_TYPES << " to subfile " << name);
+                }
+              throw_assert(H5Fclose(src_file) >= 0, "open_subfile: unable to close file " << file_name);
+            }
+
+          throw_assert(H5Fclose(file) >= 0, "open_subfile: unable to close subfile " << name);
+          throw_assert(H5Pclose(fapl) >= 0, "open_subfile: unable to close property list");
+        }
+
+      hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
+      throw_assert(fapl >= 0, "open_subfile: unable to create file access property list");
+
+      int nelemts; size_t nslots, nbytes; double w0;
+      throw_assert(H5Pget_cache(fapl, &nelemts, &nslots, &nbytes, &w0) >= 0,
+                   "open_subfile: error in H5Pget_cache");
+      nbytes = cache_size; w0 = 1.;
+      throw_assert(H5Pset_cache(fapl, nelemts, nslots, nbytes, w0) >= 0,
+                   "open_subfile: error in H5Pset_cache");
+
+      // the subfile is accessed by this rank only, so that the writers
+      // that obtain their communicator from the file access properties
+      // operate on MPI_COMM_SELF
+      throw_assert(set_parallel_file_access(fapl, MPI_COMM_SELF, false) >= 0,
+                   "open_subfile: unable to set file access properties");
+
+      hid_t file = H5Fopen(name.c_str(), H5F_ACC_RDWR, fapl);
+      throw_assert(file >= 0, "open_subfile: unable to open subfile " << name);
+      throw_assert(H5Pclose(fapl) >= 0, "open_subfile: unable to close property list");
+
+      return file;
+    }
+
+
+    herr_t num_subfiles
+    (
+     MPI_Comm      comm,
+     const string& file_name,
+     size_t&       count
+     )
+    {
+      int rank;
+      throw_assert(MPI_Comm_rank(comm, &rank) == MPI_SUCCESS,
+                   "num_subfiles: unable to obtain MPI communicator rank");
+
+      count = 0;
+      if (rank == 0)
+        {
+          while (access(subfile_name(file_name, count).c_str(), F_OK) == 0)
+            {
+              count++;
+            }
+        }
+      throw_assert(MPI_Bcast(&count, 1, MPI_SIZE_T, 0, comm) == MPI_SUCCESS,
+                   "num_subfiles: error in MPI_Bcast");
+
+      return 0;
+    }
+
+
+    herr_t remove_subfiles
+    (
+     MPI_Comm      comm,
+     const string& file_name
+     )
+    {
+      size_t count = 0;
+      throw_assert(num_subfiles(comm, file_name, count) >= 0,
+                   "remove_subfiles: unable to determine number of subfiles");
+      throw_assert(MPI_Barrier(comm) == MPI_SUCCESS,
+                   "remove_subfiles: error in MPI_Barrier");
+
+      int rank;
+      throw_assert(MPI_Comm_rank(comm, &rank) == MPI_SUCCESS,
+                   "remove_subfiles: unable to obtain MPI communicator rank");
+      if (rank == 0)
+        {
+          for (size_t i = 0; i < count; i++)
+            {
+              const string name = subfile_name(file_name, i);
+              throw_assert(remove(name.c_str()) == 0,
+                           "remove_subfiles: unable to remove subfile " << name);
+            }
+        }
+      throw_assert(MPI_Barrier(comm) == MPI_SUCCESS,
+                   "remove_subfiles: error in MPI_Barrier");
+
+      return 0;
+    }
+
+  }
+}
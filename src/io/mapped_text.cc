@@ -0,0 +1,77 @@
+// -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+//==============================================================================
+///  @file mapped_text.cc
+///
+///  Memory-mapped text input split into line ranges.
+///
+///  Copyright (C) 2016-2025 Project NeuroH5.
+//==============================================================================
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <string>
+
+#include "mapped_text.hh"
+#include "throw_assert.hh"
+
+using namespace std;
+
+namespace neuroh5
+{
+  namespace io
+  {
+
+    MappedTextFile::MappedTextFile (const string& file_name)
+      : m_data(nullptr), m_size(0)
+    {
+      int fd = open(file_name.c_str(), O_RDONLY);
+      throw_assert(fd >= 0, "MappedTextFile: unable to open file " << file_name);
+
+      struct stat st;
+      throw_assert(fstat(fd, &st) == 0, "MappedTextFile: unable to stat file " << file_name);
+      m_size = st.st_size;
+
+      if (m_size > 0)
+        {
+          void* map = mmap(NULL, m_size, PROT_READ, MAP_SHARED, fd, 0);
+          throw_assert(map != MAP_FAILED, "MappedTextFile: unable to map file " << file_name);
+          madvise(map, m_size, MADV_SEQUENTIAL);
+          m_data = static_cast<const char*>(map);
+        }
+      throw_assert(close(fd) == 0, "MappedTextFile: unable to close file " << file_name);
+    }
+
+
+    MappedTextFile::~MappedTextFile ()
+    {
+      if (m_data != nullptr)
+        {
+          munmap(const_cast<char*>(m_data), m_size);
+        }
+    }
+
+
+    pair<const char*, const char*> MappedTextFile::line_range (size_t i, size_t n) const
+    {
+      // first line that starts at or after byte offset
+      auto line_start = [this] (size_t offset) -> const char*
+        {
+          if (offset == 0)
+            return begin();
+          if (offset >= m_size)
+            return end();
+          const char* nl = static_cast<const char*>(memchr(m_data + offset - 1, '\n', m_size - offset + 1));
+          return (nl == nullptr) ? end() : nl + 1;
+        };
+
+      const size_t first = (m_size / n) * i + min(i, m_size % n);
+      const size_t last  = first + (m_size / n) + ((i < m_size % n) ? 1 : 0);
+      return make_pair(line_start(first), line_start(last));
+    }
+
+  }
+}
@@ -11,21 +11,19 @@
 
 #include <cstdio>
 #include <iostream>
-#include <sstream>
-#include <fstream>
 #include <string>
 #include <set>
 #include <map>
 #include <vector>
 #include <forward_list>
 
-#include "ngraph.hh"
 #include "neuroh5_types.hh"
+#include "tree_topology.hh"
 #include "contract_tree.hh"
+#include "mapped_text.hh"
 #include "throw_assert.hh"
 
 using namespace std;
-using namespace NGraph;
 
 namespace neuroh5
 {
@@ -49,36 +47,34 @@ namespace neuroh5
      )
     {
       int status = 0;
-      Graph A, S;
       std::deque<COORD_T> xcoords, ycoords, zcoords;  // coordinates of nodes
       std::deque<REALVAL_T> radiuses;   // Radius
       std::deque<LAYER_IDX_T> layers;   // Layer
       std::deque<PARENT_NODE_IDX_T> parents;   // Parent point ids
       std::deque<SWC_TYPE_T> swc_types;   // SWC types
-      Graph::vertex_set roots;
 
-      ifstream infile(file_name);
-      string line;
+      MappedTextFile infile(file_name);
+      TextLines lines { infile.begin(), infile.end() };
+      TextFields fields;
       size_t i = 0;
+      NODE_IDX_T id_base = 0;
     
-      while (getline(infile, line))
+      while (lines.next(fields))
         {
-          istringstream iss(line);
-          NODE_IDX_T id, idpar; int opt_idpar;
+          NODE_IDX_T id; int opt_idpar;
           int layer_value; LAYER_IDX_T layer;
           REALVAL_T radius;
           COORD_T x, y, z;
 
-          iss >> id;
+          if (!fields.next(id)) continue;
           id = id+id_offset;
-          if (iss.fail()) continue;
         
-          throw_assert_nomsg (iss >> layer_value);
-          throw_assert_nomsg (iss >> x);
-          throw_assert_nomsg (iss >> y);
-          throw_assert_nomsg (iss >> z);
-          throw_assert_nomsg (iss >> radius);
-          throw_assert_nomsg (iss >> opt_idpar);
+          throw_assert_nomsg (fields.next(layer_value));
+          throw_assert_nomsg (fields.next(x));
+          throw_assert_nomsg (fields.next(y));
+          throw_assert_nomsg (fields.next(z));
+          throw_assert_nomsg (fields.next(radius));
+          throw_assert_nomsg (fields.next(opt_idpar));
 
           if (layer_value < 0)
             {
@@ -89,16 +85,12 @@ namespace neuroh5
               layer = layer_value + layer_offset;
             }
         
-          A.insert_vertex(id);
-          if (opt_idpar > -1)
+          if (i == 0)
             {
-              idpar = opt_idpar+id_offset;
-              A.insert_edge(idpar,id);
-            }
-          else
-            {
-              roots.insert(id);
+              id_base = id;
             }
+          throw_assert(id == id_base + i, "read_layer_swc: point ids in file " << file_name <<
+                       " are not consecutive");
         
           if (opt_idpar > -1)
             {
@@ -118,56 +110,16 @@ namespace neuroh5
         
           i++;
         }
-    
-      infile.close();
 
-      //cout << A;
+      cell::TreeTopology topology;
+      topology.append(parents.cbegin(), parents.cend(), id_base);
 
-      contraction_map_t contraction_map;
       deque<SECTION_IDX_T> src_vector, dst_vector;
       deque<SECTION_IDX_T> sec_vector;
-      S.insert_vertex(0);
-
-      if (split_layers)
-        cell::contract_tree_regions_dfs (A, layers, swc_types, roots, S, contraction_map, 0, 0);
-      else
-        cell::contract_tree_dfs (A, swc_types, roots, S, contraction_map, 0, 0);
-    
-      //cout << S;
-      size_t num_sections = contraction_map.size();
-      throw_assert_nomsg(num_sections > 0);
-    
-      sec_vector.push_back(contraction_map.size());
-      size_t sec_idx = 0;
-      for(auto it = contraction_map.cbegin(); it != contraction_map.end(); it++)
-        {
-          // iterator->first = key
-          // iterator->second = value
-          size_t size = it->second.size();
-          sec_vector.push_back(size);
-          sec_vector.insert(std::end(sec_vector),std::begin(it->second),std::end(it->second));
-          sec_idx++;
-        }
-      throw_assert_nomsg(sec_idx == num_sections);
-
-      
-      for ( Graph::const_iterator p = S.begin(); p != S.end(); p++)
-        {
-          Graph::vertex u = Graph::node (p); 
-          Graph::vertex_set outs = S.out_neighbors(u);
-          throw_assert_nomsg(u < num_sections);
+      cell::contract_tree_sections (topology, 0, layers, swc_types, split_layers,
+                                    src_vector, dst_vector, sec_vector);
+      throw_assert_nomsg(sec_vector[0] > 0);
 
-          for ( Graph::vertex_set::const_iterator s = outs.begin(); s != outs.end(); s++)
-            {
-              Graph::vertex v = Graph::node (s);
-              throw_assert_nomsg(v < num_sections);
-              throw_assert_nomsg(u != v);
-              src_vector.push_back(u);
-              dst_vector.push_back(v);
-            }
-        }
-
-    
       neurotree_t tree = make_tuple(gid,src_vector,dst_vector,sec_vector,xcoords,ycoords,zcoords,radiuses,layers,parents,swc_types);
       tree_list.push_front(tree);
 
@@ -185,7 +137,7 @@ namespace neuroh5
           cout << "src_vector: " << endl;
           for_each(src_vector.cbegin(),
                    src_vector.cend(),
-                   [] (const Graph::vertex i)
+                   [] (const SECTION_IDX_T i)
                    { cout << " " << i; } 
                    );
           cout << endl;
@@ -193,7 +145,7 @@ namespace neuroh5
           cout << "dst_vector: " << endl;
           for_each(dst_vector.cbegin(),
                    dst_vector.cend(),
-                   [] (const Graph::vertex i)
+                   [] (const SECTION_IDX_T i)
                    { cout << " " << i; } 
                    );
           cout << endl;
@@ -201,7 +153,7 @@ namespace neuroh5
           cout << "sec_vector: " << endl;
           for_each(sec_vector.cbegin(),
                    sec_vector.cend(),
-                   [] (const Graph::vertex i)
+                   [] (const SECTION_IDX_T i)
                    { cout << " " << i; } 
                    );
           cout << endl;
@@ -219,55 +171,48 @@ namespace neuroh5
      )
     {
       int status = 0;
-      Graph A, S;
       std::deque<COORD_T> xcoords, ycoords, zcoords;  // coordinates of nodes
       std::deque<REALVAL_T> radiuses;   // Radius
       std::deque<LAYER_IDX_T> layers;   // Layer
       std::deque<PARENT_NODE_IDX_T> parents;   // Parent point ids
       std::deque<SWC_TYPE_T> swc_types;   // SWC types
-      Graph::vertex_set roots;
 
-      ifstream infile(file_name);
-      string line;
+      MappedTextFile infile(file_name);
+      TextLines lines { infile.begin(), infile.end() };
+      TextFields fields;
       size_t i = 0;
+      NODE_IDX_T id_base = 0;
     
-      while (getline(infile, line))
+      while (lines.next(fields))
         {
-          istringstream iss(line);
-          NODE_IDX_T id, idpar; int opt_idpar;
+          NODE_IDX_T id; int opt_idpar;
           int swc_value; int opt_layer; LAYER_IDX_T layer=-1;
           SWC_TYPE_T swc_type;
           REALVAL_T radius;
           COORD_T x, y, z;
 
-          iss >> id;
+          if (!fields.next(id)) continue;
           id = id+id_offset;
-          if (iss.fail()) continue;
         
-          throw_assert_nomsg (iss >> swc_value);
+          throw_assert_nomsg (fields.next(swc_value));
           swc_type = swc_value;
-          throw_assert_nomsg (iss >> x);
-          throw_assert_nomsg (iss >> y);
-          throw_assert_nomsg (iss >> z);
-          throw_assert_nomsg (iss >> radius);
-          throw_assert_nomsg (iss >> opt_idpar);
-          iss >> opt_layer;
-          if (!iss.fail())
+          throw_assert_nomsg (fields.next(x));
+          throw_assert_nomsg (fields.next(y));
+          throw_assert_nomsg (fields.next(z));
+          throw_assert_nomsg (fields.next(radius));
+          throw_assert_nomsg (fields.next(opt_idpar));
+          if (fields.next(opt_layer))
             {
               layer = opt_layer;
             }
           
           
-          A.insert_vertex(id);
-          if (opt_idpar > -1)
+          if (i == 0)
             {
-              idpar = opt_idpar+id_offset;
-              A.insert_edge(idpar,id);
-            }
-          else
-            {
-              roots.insert(id);
+              id_base = id;
             }
+          throw_assert(id == id_base + i, "read_swc: point ids in file " << file_name <<
+                       " are not consecutive");
         
           if (opt_idpar > -1)
             {
@@ -287,52 +232,16 @@ namespace neuroh5
         
           i++;
         }
-    
-      infile.close();
 
-      //cout << A;
-    
-      contraction_map_t contraction_map;
+      cell::TreeTopology topology;
+      topology.append(parents.cbegin(), parents.cend(), id_base);
+
       deque<SECTION_IDX_T> src_vector, dst_vector;
       deque<SECTION_IDX_T> sec_vector;
-      S.insert_vertex(0);
-
-      cell::contract_tree_dfs (A, swc_types, roots, S, contraction_map, 0, 0);
-    
-      //cout << S;
-      size_t num_sections = contraction_map.size();
-      throw_assert_nomsg(num_sections > 0);
-    
-      sec_vector.push_back(contraction_map.size());
-      size_t sec_idx = 0;
-      for(auto it = contraction_map.cbegin(); it != contraction_map.end(); it++)
-        {
-          // iterator->first = key
-          // iterator->second = value
-          size_t size = it->second.size();
-          sec_vector.push_back(size);
-          sec_vector.insert(std::end(sec_vector),std::begin(it->second),std::end(it->second));
-          sec_idx++;
-        }
-      throw_assert_nomsg(sec_idx == num_sections);
-    
-      for ( Graph::const_iterator p = S.begin(); p != S.end(); p++)
-        {
-          Graph::vertex u = Graph::node (p); 
-          Graph::vertex_set outs = S.out_neighbors(u);
-          throw_assert_nomsg(u < num_sections);
+      cell::contract_tree_sections (topology, 0, layers, swc_types, false,
+                                    src_vector, dst_vector, sec_vector);
+      throw_assert_nomsg(sec_vector[0] > 0);
 
-          for ( Graph::vertex_set::const_iterator s = outs.begin(); s != outs.end(); s++)
-            {
-              Graph::vertex v = Graph::node (s);
-              throw_assert_nomsg(v < num_sections);
-              throw_assert_nomsg(u != v);
-              src_vector.push_back(u);
-              dst_vector.push_back(v);
-            }
-        }
-
-    
       neurotree_t tree = make_tuple(gid,src_vector,dst_vector,sec_vector,xcoords,ycoords,zcoords,radiuses,layers,parents,swc_types);
       tree_list.push_front(tree);
 
@@ -357,7 +266,7 @@ namespace neuroh5
           cout << "src_vector: " << endl;
           for_each(src_vector.cbegin(),
                    src_vector.cend(),
-                   [] (const Graph::vertex i)
+                   [] (const SECTION_IDX_T i)
                    { cout << " " << i; } 
                    );
           cout << endl;
@@ -365,7 +274,7 @@ namespace neuroh5
           cout << "dst_vector: " << endl;
           for_each(dst_vector.cbegin(),
                    dst_vector.cend(),
-                   [] (const Graph::vertex i)
+                   [] (const SECTION_IDX_T i)
                    { cout << " " << i; } 
                    );
           cout << endl;
@@ -373,7 +282,7 @@ namespace neuroh5
           cout << "sec_vector: " << endl;
           for_each(sec_vector.cbegin(),
                    sec_vector.cend(),
-                   [] (const Graph::vertex i)
+                   [] (const SECTION_IDX_T i)
                    { cout << " " << i; } 
                    );
           cout << endl;
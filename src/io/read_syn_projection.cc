@@ -15,6 +15,7 @@
 #include "read_template.hh"
 #include "path_names.hh"
 #include "read_syn_projection.hh"
+#include "file_access.hh"
 #include "throw_assert.hh"
 
 using namespace std;
@@ -76,7 +77,7 @@ namespace neuroh5
 
       hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
       throw_assert_nomsg(fapl >= 0);
-      throw_assert_nomsg(H5Pset_fapl_mpio(fapl, comm, MPI_INFO_NULL) >= 0);
+      throw_assert_nomsg(hdf5::set_parallel_file_access(fapl, comm) >= 0);
 
       hid_t file = H5Fopen(file_name.c_str(), H5F_ACC_RDONLY, fapl);
       throw_assert_nomsg(file >= 0);
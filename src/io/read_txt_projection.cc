@@ -4,19 +4,20 @@
 ///
 ///  Read a projection in text format.
 ///
-///  Copyright (C) 2016-2020 Project NeuroH5.
+///  Copyright (C) 2016-2025 Project NeuroH5.
 //==============================================================================
 
 
+#include <algorithm>
+#include <cctype>
+#include <numeric>
 #include <string>
 #include <vector>
 #include <map>
-#include <fstream>
-#include <iomanip>
-#include <sstream>
 
 
 #include "read_txt_projection.hh"
+#include "mapped_text.hh"
 #include "neuroh5_types.hh"
 #include "attr_val.hh"
 #include "throw_assert.hh"
@@ -28,170 +29,185 @@ namespace neuroh5
   namespace io
   {
 
-    int read_txt_projection (const string&           file_name,
-                             const map <string, vector <size_t> >&  num_attrs,
-                             vector <NODE_IDX_T>&    dst_idx,
-                             vector <DST_PTR_T>&     src_idx_ptr,
-                             vector <NODE_IDX_T>&    src_idx,
-                             map <string, neuroh5::data::AttrVal>& attrs_map)
+    template<class T>
+    static void parse_txt_attrs (TextFields& fields, const size_t num_attrs, data::AttrVal& attrs)
     {
-      ifstream infile(file_name.c_str());
-      string line;
-      size_t i = 0;
-      map<NODE_IDX_T, vector<NODE_IDX_T> > dst_src_map;
-      
-      map <string, vector <vector <float> > >    float_attr_map;
-      map <string, vector <vector <uint8_t> > >  uint8_attr_map;
-      map <string, vector <vector <uint16_t> > > uint16_attr_map;
-      map <string, vector <vector <uint32_t> > > uint32_attr_map;
-      map <string, vector <vector <int8_t> > >   int8_attr_map;
-      map <string, vector <vector <int16_t> > >  int16_attr_map;
-      map <string, vector <vector <int32_t> > >  int32_attr_map;
-
-      while (getline(infile, line))
+      for (size_t a=0; a<num_attrs; a++)
         {
-          istringstream iss(line);
-          NODE_IDX_T src, dst;
-          
-          throw_assert_nomsg (iss >> dst);
-          throw_assert_nomsg (iss >> src);
-
-          dst_src_map[dst].push_back(src);
-
-          for (auto iter : num_attrs)
-            {
-              auto & float_attrs  = float_attr_map[iter.first];
-              auto & uint8_attrs  = uint8_attr_map[iter.first];
-              auto & uint16_attrs = uint16_attr_map[iter.first];
-              auto & uint32_attrs = uint32_attr_map[iter.first];
-              auto & int8_attrs   = int8_attr_map[iter.first];
-              auto & int16_attrs  = int16_attr_map[iter.first];
-              auto & int32_attrs  = int32_attr_map[iter.first];
-
-              float_attrs.resize(iter.second[data::AttrVal::attr_index_float]);
-              uint8_attrs.resize(iter.second[data::AttrVal::attr_index_uint8]);
-              uint16_attrs.resize(iter.second[data::AttrVal::attr_index_uint16]);
-              uint32_attrs.resize(iter.second[data::AttrVal::attr_index_uint32]);
-              int8_attrs.resize(iter.second[data::AttrVal::attr_index_int8]);
-              int16_attrs.resize(iter.second[data::AttrVal::attr_index_int16]);
-              int32_attrs.resize(iter.second[data::AttrVal::attr_index_int32]);
-
-              // floating point attrs
-              if (iter.second[data::AttrVal::attr_index_float] > 0)
-                for (size_t a=0; a<iter.second[data::AttrVal::attr_index_float]; a++)
-                  {
-                    float v;
-                    iss >> v;
-                    float_attrs[a].push_back(v);
-                  }
-              // uint8 point attrs
-              if (iter.second[data::AttrVal::attr_index_uint8] > 0)
-                for (size_t a=0; a<iter.second[data::AttrVal::attr_index_uint8]; a++)
-                  {
-                    uint8_t v;
-                    iss >> v;
-                    uint8_attrs[a].push_back(v);
-                  }
-              // uint16 point attrs
-              if (iter.second[data::AttrVal::attr_index_uint16] > 0)
-                for (size_t a=0; a<iter.second[data::AttrVal::attr_index_uint16]; a++)
-                  {
-                    uint16_t v;
-                    iss >> v;
-                    uint16_attrs[a].push_back(v);
-                  }
-              // uint32 point attrs
-              if (iter.second[data::AttrVal::attr_index_uint32] > 0)
-                for (size_t a=0; a<iter.second[data::AttrVal::attr_index_uint32]; a++)
-                  {
-                    uint32_t v;
-                    iss >> v;
-                    uint32_attrs[a].push_back(v);
-                  }
-              // int8 point attrs
-              if (iter.second[data::AttrVal::attr_index_int8] > 0)
-                for (size_t a=0; a<iter.second[data::AttrVal::attr_index_int8]; a++)
-                  {
-                    int8_t v;
-                    iss >> v;
-                    int8_attrs[a].push_back(v);
-                  }
-              // int16 point attrs
-              if (iter.second[data::AttrVal::attr_index_int16] > 0)
-                for (size_t a=0; a<iter.second[data::AttrVal::attr_index_int16]; a++)
-                  {
-                    int16_t v;
-                    iss >> v;
-                    int16_attrs[a].push_back(v);
-                  }
-              // int32 point attrs
-              if (iter.second[data::AttrVal::attr_index_int32] > 0)
-                for (size_t a=0; a<iter.second[data::AttrVal::attr_index_int32]; a++)
-                  {
-                    int32_t v;
-                    iss >> v;
-                    int32_attrs[a].push_back(v);
-                  }
-            }
+          T v = 0;
+          throw_assert(fields.next(v),
+                       "read_txt_projection: missing edge attribute value");
+          attrs.attr_vec<T>(a).push_back(v);
         }
-      infile.close();
-      i = 0;
-      src_idx_ptr.push_back(0);
-      for (auto & element : dst_src_map)
+    }
+
+    // Parses the edges in the lines [first, last), in file order
+    static void parse_txt_edges (const char* first, const char* last,
+                                 const map <string, vector <size_t> >&  num_attrs,
+                                 vector <NODE_IDX_T>& dsts,
+                                 vector <NODE_IDX_T>& srcs,
+                                 map <string, data::AttrVal>& edge_attrs)
+    {
+      // attribute values of each namespace, with the number of values of each type
+      vector< pair<data::AttrVal*, const vector<size_t>*> > ns_attrs;
+      for (const auto& iter : num_attrs)
         {
-          dst_idx.push_back(element.first);
-          vector<NODE_IDX_T>& src = element.second;
-          src_idx.insert(src_idx.end(), src.begin(), src.end());
-          src_idx_ptr.push_back(src_idx_ptr[i] + src.size());
-          i++;
+          data::AttrVal& attrs = edge_attrs[iter.first];
+          attrs.resize<float>(iter.second[data::AttrVal::attr_index_float]);
+          attrs.resize<uint8_t>(iter.second[data::AttrVal::attr_index_uint8]);
+          attrs.resize<uint16_t>(iter.second[data::AttrVal::attr_index_uint16]);
+          attrs.resize<uint32_t>(iter.second[data::AttrVal::attr_index_uint32]);
+          attrs.resize<int8_t>(iter.second[data::AttrVal::attr_index_int8]);
+          attrs.resize<int16_t>(iter.second[data::AttrVal::attr_index_int16]);
+          attrs.resize<int32_t>(iter.second[data::AttrVal::attr_index_int32]);
+          ns_attrs.push_back(make_pair(&attrs, &iter.second));
         }
-      
-      for (auto iter : num_attrs)
+
+      TextLines lines { first, last };
+      TextFields fields;
+      while (lines.next(fields))
         {
-          auto & float_attrs  = float_attr_map[iter.first];
-          auto & uint8_attrs  = uint8_attr_map[iter.first];
-          auto &  uint16_attrs = uint16_attr_map[iter.first];
-          auto &  uint32_attrs = uint32_attr_map[iter.first];
-          auto &  int8_attrs   = int8_attr_map[iter.first];
-          auto &  int16_attrs  = int16_attr_map[iter.first];
-          auto &  int32_attrs  = int32_attr_map[iter.first];
-
-          auto attrs = attrs_map[iter.first];
-          
-          for (size_t a=0; a<iter.second[data::AttrVal::attr_index_float]; a++)
-            {
-              attrs.insert(float_attrs[a]);
-            }
-          for (size_t a=0; a<iter.second[data::AttrVal::attr_index_uint8]; a++)
-            {
-              attrs.insert(uint8_attrs[a]);
-            }
-          for (size_t a=0; a<iter.second[data::AttrVal::attr_index_uint16]; a++)
-            {
-              attrs.insert(uint16_attrs[a]);
-            }
-          for (size_t a=0; a<iter.second[data::AttrVal::attr_index_uint32]; a++)
+          NODE_IDX_T src, dst;
+
+          if (!fields.next(dst))
             {
-              attrs.insert(uint32_attrs[a]);
+              // skips blank lines
+              while ((fields.p < fields.end) && isspace(*fields.p))
+                fields.p++;
+              throw_assert(fields.p == fields.end,
+                           "read_txt_projection: invalid destination index");
+              continue;
             }
-          for (size_t a=0; a<iter.second[data::AttrVal::attr_index_int8]; a++)
+          throw_assert(fields.next(src),
+                       "read_txt_projection: invalid source index");
+
+          dsts.push_back(dst);
+          srcs.push_back(src);
+
+          for (const auto& ns : ns_attrs)
             {
-              attrs.insert(int8_attrs[a]);
+              data::AttrVal& attrs = *(ns.first);
+              const vector<size_t>& counts = *(ns.second);
+              parse_txt_attrs<float>(fields, counts[data::AttrVal::attr_index_float], attrs);
+              parse_txt_attrs<uint8_t>(fields, counts[data::AttrVal::attr_index_uint8], attrs);
+              parse_txt_attrs<uint16_t>(fields, counts[data::AttrVal::attr_index_uint16], attrs);
+              parse_txt_attrs<uint32_t>(fields, counts[data::AttrVal::attr_index_uint32], attrs);
+              parse_txt_attrs<int8_t>(fields, counts[data::AttrVal::attr_index_int8], attrs);
+              parse_txt_attrs<int16_t>(fields, counts[data::AttrVal::attr_index_int16], attrs);
+              parse_txt_attrs<int32_t>(fields, counts[data::AttrVal::attr_index_int32], attrs);
             }
-          for (size_t a=0; a<iter.second[data::AttrVal::attr_index_int16]; a++)
+        }
+    }
+
+
+    template<class T>
+    static void append_txt_attrs (const data::AttrVal& attrs, const vector<size_t>& order,
+                                  data::AttrVal& output)
+    {
+      output.resize<T>(max(output.size_attr_vec<T>(), attrs.size_attr_vec<T>()));
+      for (size_t a=0; a<attrs.size_attr_vec<T>(); a++)
+        {
+          const vector<T>& values = attrs.const_attr_vec<T>(a);
+          vector<T>& output_values = output.attr_vec<T>(a);
+          output_values.reserve(output_values.size() + order.size());
+          for (size_t k : order)
             {
-              attrs.insert(int16_attrs[a]);
+              output_values.push_back(values[k]);
             }
-          for (size_t a=0; a<iter.second[data::AttrVal::attr_index_int32]; a++)
+        }
+    }
+
+    // Appends the edges in destination order to the output columns; the
+    // sources of a destination stay in file order, and the edge
+    // attributes follow the order of src_idx
+    static void append_txt_edges (const vector <NODE_IDX_T>& dsts,
+                                  const vector <NODE_IDX_T>& srcs,
+                                  const map <string, data::AttrVal>& edge_attrs,
+                                  vector <NODE_IDX_T>&    dst_idx,
+                                  vector <DST_PTR_T>&     src_idx_ptr,
+                                  vector <NODE_IDX_T>&    src_idx,
+                                  map <string, data::AttrVal>& attrs_map)
+    {
+      vector<size_t> order(dsts.size());
+      iota(order.begin(), order.end(), 0);
+      stable_sort(order.begin(), order.end(),
+                  [&dsts] (size_t a, size_t b) { return dsts[a] < dsts[b]; });
+
+      if (src_idx_ptr.size() == 0)
+        {
+          src_idx_ptr.push_back(src_idx.size());
+        }
+      src_idx.reserve(src_idx.size() + order.size());
+      for (size_t i = 0; i < order.size(); i++)
+        {
+          const size_t k = order[i];
+          if ((i == 0) || (dsts[k] != dsts[order[i-1]]))
             {
-              attrs.insert(int32_attrs[a]);
+              dst_idx.push_back(dsts[k]);
+              src_idx_ptr.push_back(src_idx_ptr.back());
             }
+          src_idx.push_back(srcs[k]);
+          src_idx_ptr.back()++;
         }
 
+      for (const auto& iter : edge_attrs)
+        {
+          const data::AttrVal& attrs = iter.second;
+          data::AttrVal& output = attrs_map[iter.first];
+          append_txt_attrs<float>(attrs, order, output);
+          append_txt_attrs<uint8_t>(attrs, order, output);
+          append_txt_attrs<uint16_t>(attrs, order, output);
+          append_txt_attrs<uint32_t>(attrs, order, output);
+          append_txt_attrs<int8_t>(attrs, order, output);
+          append_txt_attrs<int16_t>(attrs, order, output);
+          append_txt_attrs<int32_t>(attrs, order, output);
+        }
+    }
+
+
+    int read_txt_projection (const string&           file_name,
+                             const map <string, vector <size_t> >&  num_attrs,
+                             vector <NODE_IDX_T>&    dst_idx,
+                             vector <DST_PTR_T>&     src_idx_ptr,
+                             vector <NODE_IDX_T>&    src_idx,
+                             map <string, neuroh5::data::AttrVal>& attrs_map)
+    {
+      MappedTextFile infile(file_name);
+
+      vector <NODE_IDX_T> dsts, srcs;
+      map <string, data::AttrVal> edge_attrs;
+      parse_txt_edges(infile.begin(), infile.end(), num_attrs, dsts, srcs, edge_attrs);
+      append_txt_edges(dsts, srcs, edge_attrs, dst_idx, src_idx_ptr, src_idx, attrs_map);
+
       return 0;
     }
-    
+
+
+    int read_txt_projection (MPI_Comm                comm,
+                             const string&           file_name,
+                             const map <string, vector <size_t> >&  num_attrs,
+                             vector <NODE_IDX_T>&    dst_idx,
+                             vector <DST_PTR_T>&     src_idx_ptr,
+                             vector <NODE_IDX_T>&    src_idx,
+                             map <string, neuroh5::data::AttrVal>& attrs_map)
+    {
+      int rank, size;
+      throw_assert(MPI_Comm_size(comm, &size) == MPI_SUCCESS,
+                   "read_txt_projection: error in MPI_Comm_size");
+      throw_assert(MPI_Comm_rank(comm, &rank) == MPI_SUCCESS,
+                   "read_txt_projection: error in MPI_Comm_rank");
+
+      MappedTextFile infile(file_name);
+      pair<const char*, const char*> range = infile.line_range(rank, size);
+
+      vector <NODE_IDX_T> dsts, srcs;
+      map <string, data::AttrVal> edge_attrs;
+      parse_txt_edges(range.first, range.second, num_attrs, dsts, srcs, edge_attrs);
+      append_txt_edges(dsts, srcs, edge_attrs, dst_idx, src_idx_ptr, src_idx, attrs_map);
+
+      return 0;
+    }
+
   }
 
 }
-
@@ -0,0 +1,140 @@
+// -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+//==============================================================================
+///  @file edge_test_fixture.hh
+///
+///  Edge maps with attribute values derived from the node and source
+///  index, and comparisons of edge maps and CSR containers, shared by the
+///  projection container and edge serialization tests.
+///
+///  Copyright (C) 2016-2025 Project NeuroH5.
+//==============================================================================
+
+#ifndef EDGE_TEST_FIXTURE_HH
+#define EDGE_TEST_FIXTURE_HH
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "neuroh5_types.hh"
+
+namespace neuroh5
+{
+  namespace test
+  {
+    // Two attribute namespaces: the first with a float and an int16
+    // attribute, the second with two uint32 attributes and a uint8
+    // attribute. Values are derived from the node and source index so
+    // that misaligned columns are detected.
+    inline std::vector<data::AttrVal> make_edge_attrs (NODE_IDX_T node,
+                                                       const std::vector<NODE_IDX_T>& adj)
+    {
+      std::vector<data::AttrVal> edge_attr_values(2);
+      std::vector<float> weights;
+      std::vector<int16_t> delays;
+      std::vector<uint32_t> syn_ids, sec_ids;
+      std::vector<uint8_t> layers;
+      for (const NODE_IDX_T& src : adj)
+        {
+          weights.push_back(node + src * 0.5f);
+          delays.push_back((int16_t)(src - node));
+          syn_ids.push_back(node * 100000u + src);
+          sec_ids.push_back(src * 7u);
+          layers.push_back((uint8_t)(src % 256));
+        }
+      edge_attr_values[0].insert(weights);
+      edge_attr_values[0].insert(delays);
+      edge_attr_values[1].insert(syn_ids);
+      edge_attr_values[1].insert(sec_ids);
+      edge_attr_values[1].insert(layers);
+      return edge_attr_values;
+    }
+
+    // Appends edges from the given sources to a node of an edge map,
+    // with or without attributes
+    inline void insert_edges (edge_map_t& edge_map, NODE_IDX_T node,
+                              const std::vector<NODE_IDX_T>& adj, bool with_attrs = true)
+    {
+      edge_tuple_t& et = edge_map[node];
+      std::vector<NODE_IDX_T>& adj_vector = std::get<0>(et);
+      std::vector<data::AttrVal>& edge_attr_values = std::get<1>(et);
+      adj_vector.insert(adj_vector.end(), adj.begin(), adj.end());
+      if (with_attrs)
+        {
+          std::vector<data::AttrVal> attrs = make_edge_attrs(node, adj);
+          if (edge_attr_values.empty())
+            {
+              edge_attr_values = attrs;
+            }
+          else
+            {
+              for (size_t i = 0; i < attrs.size(); i++)
+                {
+                  edge_attr_values[i].append(attrs[i]);
+                }
+            }
+        }
+    }
+
+    // Checks that each edge of a CSR container carries the attribute
+    // values of make_edge_attrs
+    inline void expect_aligned_attrs (const edge_csr_t& edge_csr)
+    {
+      ASSERT_EQ(edge_csr.edge_attrs.size(), 2u);
+      const data::AttrVal& a = edge_csr.edge_attrs[0];
+      const data::AttrVal& b = edge_csr.edge_attrs[1];
+      ASSERT_EQ(a.float_values.size(), 1u);
+      ASSERT_EQ(a.int16_values.size(), 1u);
+      ASSERT_EQ(b.uint32_values.size(), 2u);
+      ASSERT_EQ(b.uint8_values.size(), 1u);
+      ASSERT_EQ(a.float_values[0].size(), edge_csr.num_edges());
+      ASSERT_EQ(a.int16_values[0].size(), edge_csr.num_edges());
+      ASSERT_EQ(b.uint32_values[0].size(), edge_csr.num_edges());
+      ASSERT_EQ(b.uint32_values[1].size(), edge_csr.num_edges());
+      ASSERT_EQ(b.uint8_values[0].size(), edge_csr.num_edges());
+      for (size_t i = 0; i < edge_csr.size(); i++)
+        {
+          for (size_t e = edge_csr.adj_offsets[i]; e < edge_csr.adj_offsets[i+1]; e++)
+            {
+              NODE_IDX_T node = edge_csr.node_index[i], src = edge_csr.adj_index[e];
+              EXPECT_EQ(a.float_values[0][e], node + src * 0.5f);
+              EXPECT_EQ(a.int16_values[0][e], (int16_t)(src - node));
+              EXPECT_EQ(b.uint32_values[0][e], node * 100000u + src);
+              EXPECT_EQ(b.uint32_values[1][e], src * 7u);
+              EXPECT_EQ(b.uint8_values[0][e], (uint8_t)(src % 256));
+            }
+        }
+    }
+
+    inline void expect_same_attrs (const data::AttrVal& a, const data::AttrVal& b)
+    {
+      EXPECT_EQ(a.float_values, b.float_values);
+      EXPECT_EQ(a.uint8_values, b.uint8_values);
+      EXPECT_EQ(a.int8_values, b.int8_values);
+      EXPECT_EQ(a.uint16_values, b.uint16_values);
+      EXPECT_EQ(a.int16_values, b.int16_values);
+      EXPECT_EQ(a.uint32_values, b.uint32_values);
+      EXPECT_EQ(a.int32_values, b.int32_values);
+    }
+
+    inline void expect_same_edge_map (const edge_map_t& a, const edge_map_t& b)
+    {
+      ASSERT_EQ(a.size(), b.size());
+      for (auto it = a.cbegin(); it != a.cend(); ++it)
+        {
+          auto jt = b.find(it->first);
+          ASSERT_TRUE(jt != b.end());
+          EXPECT_EQ(std::get<0>(it->second), std::get<0>(jt->second));
+          const std::vector<data::AttrVal>& a_attrs = std::get<1>(it->second);
+          const std::vector<data::AttrVal>& b_attrs = std::get<1>(jt->second);
+          ASSERT_EQ(a_attrs.size(), b_attrs.size());
+          for (size_t i = 0; i < a_attrs.size(); i++)
+            {
+              expect_same_attrs(a_attrs[i], b_attrs[i]);
+            }
+        }
+    }
+  }
+}
+
+#endif
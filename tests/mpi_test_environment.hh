@@ -0,0 +1,53 @@
+// -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+//==============================================================================
+///  @file mpi_test_environment.hh
+///
+///  Global gtest environment that initializes and finalizes MPI, for
+///  tests that call collective NeuroH5 routines. Include it in one source
+///  file of a test executable; the executable then runs as a singleton
+///  MPI process, or under mpiexec.
+///
+///  Copyright (C) 2016-2025 Project NeuroH5.
+//==============================================================================
+
+#ifndef MPI_TEST_ENVIRONMENT_HH
+#define MPI_TEST_ENVIRONMENT_HH
+
+#include <mpi.h>
+
+#include <gtest/gtest.h>
+
+#include "throw_assert.hh"
+
+namespace neuroh5
+{
+  namespace test
+  {
+    class MPIEnvironment : public ::testing::Environment
+    {
+    public:
+      void SetUp() override
+      {
+        int initialized = 0;
+        throw_assert(MPI_Initialized(&initialized) == MPI_SUCCESS,
+                     "MPIEnvironment: error in MPI_Initialized");
+        if (!initialized)
+          {
+            throw_assert(MPI_Init(NULL, NULL) == MPI_SUCCESS,
+                         "MPIEnvironment: error in MPI_Init");
+          }
+      }
+
+      void TearDown() override
+      {
+        throw_assert(MPI_Finalize() == MPI_SUCCESS,
+                     "MPIEnvironment: error in MPI_Finalize");
+      }
+    };
+
+    static ::testing::Environment* const mpi_environment =
+      ::testing::AddGlobalTestEnvironment(new MPIEnvironment);
+  }
+}
+
+#endif
@@ -0,0 +1,99 @@
+// -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+//==============================================================================
+///  @file test_coalesce_ranges.cc
+///
+///  Tests for merging dataset selection ranges into read spans.
+///
+///  Copyright (C) 2016-2025 Project NeuroH5.
+//==============================================================================
+
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "coalesce_ranges.hh"
+
+using namespace std;
+using namespace neuroh5;
+
+typedef vector< pair<hsize_t,hsize_t> > ranges_t;
+
+
+TEST(CoalesceRangesTest, EmptyInput)
+{
+  ranges_t spans(1, make_pair(1, 1));
+  vector<hsize_t> offsets(1, 1);
+  EXPECT_EQ(hdf5::coalesce_ranges(ranges_t(), 8, spans, offsets), 0u);
+  EXPECT_TRUE(spans.empty());
+  EXPECT_TRUE(offsets.empty());
+}
+
+
+TEST(CoalesceRangesTest, EmptyRangesAreIgnored)
+{
+  ranges_t ranges = { {5, 0}, {10, 2}, {100, 0} };
+  ranges_t spans;
+  vector<hsize_t> offsets;
+  EXPECT_EQ(hdf5::coalesce_ranges(ranges, 1000, spans, offsets), 2u);
+  EXPECT_EQ(spans, ranges_t({ {10, 2} }));
+  EXPECT_EQ(offsets, vector<hsize_t>({0, 0, 0}));
+}
+
+
+TEST(CoalesceRangesTest, GapEqualToThresholdIsJoined)
+{
+  // [10, 14) and [17, 20) are separated by 3 elements
+  ranges_t ranges = { {10, 4}, {17, 3} };
+  ranges_t spans;
+  vector<hsize_t> offsets;
+  EXPECT_EQ(hdf5::coalesce_ranges(ranges, 3, spans, offsets), 10u);
+  EXPECT_EQ(spans, ranges_t({ {10, 10} }));
+  EXPECT_EQ(offsets, vector<hsize_t>({0, 7}));
+}
+
+
+TEST(CoalesceRangesTest, GapAboveThresholdIsSplit)
+{
+  ranges_t ranges = { {10, 4}, {17, 3} };
+  ranges_t spans;
+  vector<hsize_t> offsets;
+  EXPECT_EQ(hdf5::coalesce_ranges(ranges, 2, spans, offsets), 7u);
+  EXPECT_EQ(spans, ranges_t({ {10, 4}, {17, 3} }));
+  EXPECT_EQ(offsets, vector<hsize_t>({0, 4}));
+}
+
+
+TEST(CoalesceRangesTest, AdjacentRangesWithZeroThreshold)
+{
+  ranges_t ranges = { {0, 3}, {3, 2}, {6, 1} };
+  ranges_t spans;
+  vector<hsize_t> offsets;
+  EXPECT_EQ(hdf5::coalesce_ranges(ranges, 0, spans, offsets), 6u);
+  EXPECT_EQ(spans, ranges_t({ {0, 5}, {6, 1} }));
+  EXPECT_EQ(offsets, vector<hsize_t>({0, 3, 5}));
+}
+
+
+TEST(CoalesceRangesTest, OverlappingAndContainedRanges)
+{
+  // the second range overlaps the first, the third is contained in
+  // the first; values shared by ranges are read once
+  ranges_t ranges = { {20, 10}, {25, 10}, {22, 3} };
+  ranges_t spans;
+  vector<hsize_t> offsets;
+  EXPECT_EQ(hdf5::coalesce_ranges(ranges, 0, spans, offsets), 15u);
+  EXPECT_EQ(spans, ranges_t({ {20, 15} }));
+  EXPECT_EQ(offsets, vector<hsize_t>({0, 5, 2}));
+}
+
+
+TEST(CoalesceRangesTest, UnsortedRangesKeepTheirOffsets)
+{
+  ranges_t ranges = { {50, 2}, {0, 1}, {49, 1}, {10, 1} };
+  ranges_t spans;
+  vector<hsize_t> offsets;
+  EXPECT_EQ(hdf5::coalesce_ranges(ranges, 0, spans, offsets), 5u);
+  EXPECT_EQ(spans, ranges_t({ {0, 1}, {10, 1}, {49, 3} }));
+  EXPECT_EQ(offsets, vector<hsize_t>({3, 0, 2, 1}));
+}
@@ -0,0 +1,218 @@
+// -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+//==============================================================================
+///  @file test_columnar_attr_map.cc
+///
+///  Tests for the columnar cell attribute map, compared against AttrMap.
+///
+///  Copyright (C) 2016-2025 Project NeuroH5.
+//==============================================================================
+
+#include <deque>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "neuroh5_types.hh"
+#include "attr_map.hh"
+#include "columnar_attr_map.hh"
+
+using namespace std;
+using namespace neuroh5;
+
+namespace
+{
+  // A block of cells in the layout of the cell attribute datasets; cell
+  // c has (c % 3) + 1 values derived from the cell id and the block
+  struct AttrBlock
+  {
+    vector<CELL_IDX_T> index;
+    vector<ATTR_PTR_T> ptr;
+    vector<float>      float_values;
+    vector<uint16_t>   uint16_values;
+  };
+
+  AttrBlock make_block (const vector<CELL_IDX_T>& cells, int block)
+  {
+    AttrBlock b;
+    b.index = cells;
+    b.ptr.push_back(0);
+    for (const CELL_IDX_T& c : cells)
+      {
+        for (size_t k = 0; k < (c % 3) + 1; k++)
+          {
+            b.float_values.push_back(c + k * 0.25f + block * 1000.0f);
+            b.uint16_values.push_back((uint16_t)(c * 3 + k + block));
+          }
+        b.ptr.push_back(b.float_values.size());
+      }
+    return b;
+  }
+
+  void insert_block (data::AttrMap& attr_map, data::ColumnarAttrMap& columnar_map,
+                     const AttrBlock& b)
+  {
+    attr_map.insert(0, b.index, b.ptr, b.float_values);
+    attr_map.insert(0, b.index, b.ptr, b.uint16_values);
+    columnar_map.insert(0, b.index, b.ptr, b.float_values);
+    columnar_map.insert(0, b.index, b.ptr, b.uint16_values);
+  }
+
+  template<class T>
+  void expect_same_values (const data::AttrMap& attr_map,
+                           const data::ColumnarAttrMap& columnar_map,
+                           CELL_IDX_T cell)
+  {
+    const vector< deque<T> > expected = attr_map.find<T>(cell);
+    const vector< data::AttrSpan<T> > actual = columnar_map.find<T>(cell);
+    ASSERT_EQ(actual.size(), expected.size()) << "cell " << cell;
+    for (size_t i = 0; i < expected.size(); i++)
+      {
+        EXPECT_EQ(vector<T>(actual[i].begin(), actual[i].end()),
+                  vector<T>(expected[i].begin(), expected[i].end())) << "cell " << cell;
+      }
+  }
+
+  void expect_same_maps (const data::AttrMap& attr_map,
+                         const data::ColumnarAttrMap& columnar_map)
+  {
+    EXPECT_EQ(columnar_map.index,
+              vector<CELL_IDX_T>(attr_map.index_set.cbegin(), attr_map.index_set.cend()));
+    const CELL_IDX_T max_cell = columnar_map.index.empty() ? 0 : columnar_map.index.back();
+    for (CELL_IDX_T cell = 0; cell <= max_cell + 1; cell++)
+      {
+        expect_same_values<float>(attr_map, columnar_map, cell);
+        expect_same_values<uint16_t>(attr_map, columnar_map, cell);
+      }
+  }
+
+  void expect_valid_column (const data::AttrColumn<float>& column)
+  {
+    ASSERT_EQ(column.ptr.size(), column.index.size() + 1);
+    EXPECT_EQ(column.ptr.front(), 0u);
+    EXPECT_EQ(column.ptr.back(), column.values.size());
+    EXPECT_TRUE(std::adjacent_find(column.index.cbegin(), column.index.cend(),
+                                   [] (CELL_IDX_T a, CELL_IDX_T b) { return a >= b; }) == column.index.cend());
+  }
+}
+
+
+TEST(ColumnarAttrMapTest, AscendingBlocksMatchAttrMap)
+{
+  data::AttrMap attr_map;
+  data::ColumnarAttrMap columnar_map;
+  insert_block(attr_map, columnar_map, make_block({0, 1, 2}, 0));
+  insert_block(attr_map, columnar_map, make_block({5, 7}, 1));
+  insert_block(attr_map, columnar_map, make_block({8, 12, 13}, 2));
+
+  expect_valid_column(columnar_map.float_values[0]);
+  expect_same_maps(attr_map, columnar_map);
+}
+
+
+TEST(ColumnarAttrMapTest, InterleavedAndUnsortedBlocksMatchAttrMap)
+{
+  data::AttrMap attr_map;
+  data::ColumnarAttrMap columnar_map;
+  insert_block(attr_map, columnar_map, make_block({10, 4, 20}, 0));
+  // cells before, between and after the cells already in the map
+  insert_block(attr_map, columnar_map, make_block({15, 1, 25, 11}, 1));
+  insert_block(attr_map, columnar_map, make_block({0}, 2));
+  insert_block(attr_map, columnar_map, make_block({30, 21}, 3));
+
+  expect_valid_column(columnar_map.float_values[0]);
+  EXPECT_EQ(columnar_map.index, vector<CELL_IDX_T>({0, 1, 4, 10, 11, 15, 20, 21, 25, 30}));
+  expect_same_maps(attr_map, columnar_map);
+}
+
+
+TEST(ColumnarAttrMapTest, RepeatedInsertConcatenatesLikeAttrMap)
+{
+  // AttrMap::insert appends the values of a cell that is already in the
+  // map; the columnar map does the same, existing values first
+  data::AttrMap attr_map;
+  data::ColumnarAttrMap columnar_map;
+  insert_block(attr_map, columnar_map, make_block({3, 6, 9}, 0));
+  insert_block(attr_map, columnar_map, make_block({6, 2, 9}, 1));
+  insert_block(attr_map, columnar_map, make_block({9, 9}, 2));
+
+  expect_valid_column(columnar_map.float_values[0]);
+  expect_same_maps(attr_map, columnar_map);
+}
+
+
+TEST(ColumnarAttrMapTest, SharedValuesWithoutPointer)
+{
+  // without a pointer, all values belong to each cell
+  data::AttrMap attr_map;
+  data::ColumnarAttrMap columnar_map;
+  const vector<float> value({1.5f, 2.5f});
+  attr_map.insert(0, vector<CELL_IDX_T>({7, 3}), vector<ATTR_PTR_T>(), value);
+  columnar_map.insert(0, vector<CELL_IDX_T>({7, 3}), vector<ATTR_PTR_T>(), value);
+
+  expect_valid_column(columnar_map.float_values[0]);
+  expect_same_values<float>(attr_map, columnar_map, 3);
+  expect_same_values<float>(attr_map, columnar_map, 7);
+}
+
+
+TEST(ColumnarAttrMapTest, InsertMapMatchesAttrMapForDisjointCells)
+{
+  data::AttrMap attr_map_a, attr_map_b;
+  data::ColumnarAttrMap columnar_map_a, columnar_map_b;
+  insert_block(attr_map_a, columnar_map_a, make_block({1, 5, 9}, 0));
+  insert_block(attr_map_b, columnar_map_b, make_block({0, 6, 12}, 1));
+
+  attr_map_a.insert_map(attr_map_b);
+  columnar_map_a.insert_map(columnar_map_b);
+
+  expect_valid_column(columnar_map_a.float_values[0]);
+  expect_same_maps(attr_map_a, columnar_map_a);
+}
+
+
+TEST(ColumnarAttrMapTest, InsertMapConcatenatesDuplicateCells)
+{
+  // documented difference: AttrMap::insert_map keeps the values of a
+  // cell present in both maps, the columnar map concatenates them
+  data::AttrMap attr_map_a, attr_map_b;
+  data::ColumnarAttrMap columnar_map_a, columnar_map_b;
+  const AttrBlock a = make_block({2, 4}, 0), b = make_block({4, 8}, 1);
+  insert_block(attr_map_a, columnar_map_a, a);
+  insert_block(attr_map_b, columnar_map_b, b);
+
+  attr_map_a.insert_map(attr_map_b);
+  columnar_map_a.insert_map(columnar_map_b);
+
+  EXPECT_EQ(columnar_map_a.index, vector<CELL_IDX_T>({2, 4, 8}));
+  expect_same_values<float>(attr_map_a, columnar_map_a, 2);
+  expect_same_values<float>(attr_map_a, columnar_map_a, 8);
+
+  const vector< deque<float> > kept = attr_map_a.find<float>(4);
+  ASSERT_EQ(kept.size(), 1u);
+  EXPECT_EQ(vector<float>(kept[0].begin(), kept[0].end()),
+            vector<float>(a.float_values.begin() + a.ptr[1], a.float_values.begin() + a.ptr[2]));
+
+  const vector< data::AttrSpan<float> > merged = columnar_map_a.find<float>(4);
+  ASSERT_EQ(merged.size(), 1u);
+  vector<float> expected(a.float_values.begin() + a.ptr[1], a.float_values.begin() + a.ptr[2]);
+  expected.insert(expected.end(), b.float_values.begin() + b.ptr[0], b.float_values.begin() + b.ptr[1]);
+  EXPECT_EQ(vector<float>(merged[0].begin(), merged[0].end()), expected);
+}
+
+
+TEST(ColumnarAttrMapTest, NamedFindMatchesNamedAttrMap)
+{
+  data::NamedAttrMap attr_map;
+  data::NamedColumnarAttrMap columnar_map;
+  const AttrBlock b = make_block({4, 1, 6}, 0);
+  attr_map.insert(string("weight"), b.index, b.ptr, b.float_values);
+  columnar_map.insert(string("weight"), b.index, b.ptr, b.float_values);
+
+  for (CELL_IDX_T cell = 0; cell < 8; cell++)
+    {
+      const deque<float> expected = attr_map.find_name<float>("weight", cell);
+      const data::AttrSpan<float> actual = columnar_map.find_name<float>("weight", cell);
+      EXPECT_EQ(vector<float>(actual.begin(), actual.end()),
+                vector<float>(expected.begin(), expected.end())) << "cell " << cell;
+    }
+}
@@ -0,0 +1,208 @@
+// -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+//==============================================================================
+///  @file test_delta_filter.cc
+///
+///  Tests for the codec and the registration of the NeuroH5 delta filter.
+///
+///  Copyright (C) 2016-2025 Project NeuroH5.
+//==============================================================================
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "dataset_filters.hh"
+#include "throw_assert.hh"
+
+using namespace std;
+using namespace neuroh5;
+
+namespace
+{
+  // Encodes values with the delta codec, checks the element count of
+  // the encoded chunk and returns the decoded values
+  template<class T>
+  vector<T> round_trip (const vector<T>& values, size_t& encoded_size)
+  {
+    const bool is_signed = numeric_limits<T>::is_signed;
+    vector<uint8_t> encoded(hdf5::delta_max_encoded_size(values.size()));
+    encoded_size = hdf5::delta_encode(sizeof(T), is_signed, false,
+                                      reinterpret_cast<const uint8_t*>(values.data()),
+                                      values.size(), encoded.data());
+    EXPECT_LE(encoded_size, encoded.size());
+
+    uint64_t n = 0;
+    EXPECT_TRUE(hdf5::delta_decoded_count(encoded.data(), encoded_size, n));
+    EXPECT_EQ(n, values.size());
+
+    vector<T> decoded(values.size());
+    EXPECT_TRUE(hdf5::delta_decode(sizeof(T), false, encoded.data(), encoded_size,
+                                   reinterpret_cast<uint8_t*>(decoded.data())));
+    return decoded;
+  }
+
+  template<class T>
+  void expect_round_trip (const vector<T>& values)
+  {
+    size_t encoded_size = 0;
+    EXPECT_EQ(round_trip(values, encoded_size), values);
+  }
+}
+
+
+TEST(DeltaFilterTest, EmptyInput)
+{
+  size_t encoded_size = 0;
+  EXPECT_TRUE(round_trip(vector<uint32_t>(), encoded_size).empty());
+  EXPECT_EQ(encoded_size, 8u);
+}
+
+TEST(DeltaFilterTest, SingleElement)
+{
+  expect_round_trip(vector<uint32_t>({ 12345u }));
+  expect_round_trip(vector<int16_t>({ -7 }));
+  expect_round_trip(vector<uint64_t>({ 0u }));
+}
+
+TEST(DeltaFilterTest, SortedIndexPacksIntoFewBits)
+{
+  vector<uint32_t> values(1000);
+  for (size_t i = 0; i < values.size(); i++)
+    {
+      values[i] = 100000 + 3*i;
+    }
+  size_t encoded_size = 0;
+  EXPECT_EQ(round_trip(values, encoded_size), values);
+  EXPECT_LT(encoded_size, values.size());
+}
+
+TEST(DeltaFilterTest, NegativeDeltas)
+{
+  expect_round_trip(vector<int32_t>({ 50, 40, -10, -11, 3, -1000000, 0 }));
+  expect_round_trip(vector<uint16_t>({ 9, 8, 1, 0, 65535, 2 }));
+  expect_round_trip(vector<int8_t>({ 0, -1, -2, 5, -128, 127, -128 }));
+}
+
+TEST(DeltaFilterTest, MaximumWidthDeltas)
+{
+  const int64_t lo = numeric_limits<int64_t>::min(), hi = numeric_limits<int64_t>::max();
+  const vector<int64_t> values({ 0, hi, -1, lo, hi, lo, 0 });
+  size_t encoded_size = 0;
+  EXPECT_EQ(round_trip(values, encoded_size), values);
+  // one block of 64-bit codes
+  EXPECT_EQ(encoded_size, 8u + 1u + values.size() * 8u);
+  const uint64_t max_u64 = numeric_limits<uint64_t>::max();
+  expect_round_trip(vector<uint64_t>({ 0, max_u64 / 2, max_u64, 1, max_u64 / 2 + 1 }));
+  expect_round_trip(vector<int8_t>({ -128, 127, -128, 127 }));
+  expect_round_trip(vector<uint32_t>({ 0, 0xFFFFFFFFu, 0, 0xFFFFFFFFu }));
+}
+
+TEST(DeltaFilterTest, SeveralBlocksWithDifferentWidths)
+{
+  vector<int64_t> values;
+  for (size_t i = 0; i < 300; i++)
+    {
+      values.push_back((i < 128) ? (int64_t)i : (int64_t)(i * i * 1000003) * ((i % 2) ? -1 : 1));
+    }
+  expect_round_trip(values);
+}
+
+TEST(DeltaFilterTest, BigEndianElements)
+{
+  const vector<uint8_t> values({ 0x00, 0x10, 0x00, 0x20, 0xFF, 0xF0, 0x00, 0x01 });
+  vector<uint8_t> encoded(hdf5::delta_max_encoded_size(4));
+  const size_t encoded_size = hdf5::delta_encode(2, false, true, values.data(), 4, encoded.data());
+  vector<uint8_t> decoded(values.size());
+  ASSERT_TRUE(hdf5::delta_decode(2, true, encoded.data(), encoded_size, decoded.data()));
+  EXPECT_EQ(decoded, values);
+}
+
+TEST(DeltaFilterTest, TruncatedChunkIsRejected)
+{
+  const vector<uint32_t> values({ 1, 1000, 7, 1u << 31 });
+  vector<uint8_t> encoded(hdf5::delta_max_encoded_size(values.size()));
+  const size_t encoded_size = hdf5::delta_encode(4, false, false,
+                                                 reinterpret_cast<const uint8_t*>(values.data()),
+                                                 values.size(), encoded.data());
+  vector<uint32_t> decoded(values.size());
+  uint64_t n = 0;
+  EXPECT_FALSE(hdf5::delta_decoded_count(encoded.data(), 4, n));
+  EXPECT_FALSE(hdf5::delta_decode(4, false, encoded.data(), 8, reinterpret_cast<uint8_t*>(decoded.data())));
+  EXPECT_FALSE(hdf5::delta_decode(4, false, encoded.data(), encoded_size - 1,
+                                  reinterpret_cast<uint8_t*>(decoded.data())));
+}
+
+TEST(DeltaFilterTest, DatasetRoundTrip)
+{
+  const string file_name = ::testing::TempDir() + "test_delta_filter.h5";
+  vector<int32_t> values(4096);
+  for (size_t i = 0; i < values.size(); i++)
+    {
+      values[i] = (int32_t)(i / 3) - 100;
+    }
+
+  hid_t file = H5Fcreate(file_name.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+  ASSERT_GE(file, 0);
+  hsize_t dims = values.size(), chunk_dims = 1024;
+  hid_t fspace = H5Screate_simple(1, &dims, &dims);
+  hid_t dcpl = H5Pcreate(H5P_DATASET_CREATE);
+  ASSERT_GE(H5Pset_chunk(dcpl, 1, &chunk_dims), 0);
+  DatasetFilter filter;
+  filter.delta = true;
+  ASSERT_GE(hdf5::set_dataset_filters(dcpl, filter, H5T_STD_I32LE), 0);
+  hid_t dset = H5Dcreate2(file, "values", H5T_STD_I32LE, fspace, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+  ASSERT_GE(dset, 0);
+  ASSERT_GE(H5Dwrite(dset, H5T_NATIVE_INT32, H5S_ALL, H5S_ALL, H5P_DEFAULT, values.data()), 0);
+  hsize_t storage_size = H5Dget_storage_size(dset);
+  EXPECT_LT(storage_size, values.size() * sizeof(int32_t) / 4);
+  ASSERT_GE(H5Dclose(dset), 0);
+  ASSERT_GE(H5Pclose(dcpl), 0);
+  ASSERT_GE(H5Sclose(fspace), 0);
+  ASSERT_GE(H5Fclose(file), 0);
+
+  file = H5Fopen(file_name.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+  ASSERT_GE(file, 0);
+  dset = H5Dopen2(file, "values", H5P_DEFAULT);
+  ASSERT_GE(dset, 0);
+  vector<int32_t> read_values(values.size());
+  ASSERT_GE(H5Dread(dset, H5T_NATIVE_INT32, H5S_ALL, H5S_ALL, H5P_DEFAULT, read_values.data()), 0);
+  EXPECT_EQ(read_values, values);
+  ASSERT_GE(H5Dclose(dset), 0);
+  ASSERT_GE(H5Fclose(file), 0);
+  std::remove(file_name.c_str());
+}
+
+namespace
+{
+  size_t other_filter (unsigned int flags, size_t cd_nelmts, const unsigned int cd_values[],
+                       size_t nbytes, size_t *buf_size, void **buf)
+  {
+    return nbytes;
+  }
+
+  const H5Z_class2_t other_filter_class[1] = {{
+      H5Z_CLASS_T_VERS, hdf5::H5Z_FILTER_NEUROH5_DELTA, 1, 1,
+      "other filter", NULL, NULL, other_filter
+    }};
+}
+
+TEST(DeltaFilterDeathTest, RegistrationFailsIfIdentifierIsTaken)
+{
+  EXPECT_EXIT({
+      throw_assert_nomsg(H5Zregister(other_filter_class) >= 0);
+      try
+        {
+          hdf5::register_filters();
+        }
+      catch (const std::exception& e)
+        {
+          std::exit(string(e.what()).find("other filter") != string::npos ? 3 : 4);
+        }
+      std::exit(0);
+    }, ::testing::ExitedWithCode(3), "");
+}
@@ -0,0 +1,151 @@
+// -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+//==============================================================================
+///  @file test_edge_csr.cc
+///
+///  Tests for merging and converting compressed sparse row projection
+///  containers.
+///
+///  Copyright (C) 2016-2025 Project NeuroH5.
+//==============================================================================
+
+#include <map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "neuroh5_types.hh"
+#include "edge_csr.hh"
+#include "throw_assert.hh"
+#include "edge_test_fixture.hh"
+
+using namespace std;
+using namespace neuroh5;
+using namespace neuroh5::test;
+
+
+TEST(EdgeCSRTest, EdgeMapRoundTrip)
+{
+  edge_map_t edge_map;
+  insert_edges(edge_map, 7, {1, 2, 3}, true);
+  insert_edges(edge_map, 2, {9}, true);
+  insert_edges(edge_map, 11, {}, true);
+  insert_edges(edge_map, 5, {4, 4, 0}, true);
+
+  edge_csr_t edge_csr;
+  data::edge_map_to_csr(edge_map, edge_csr);
+
+  EXPECT_EQ(edge_csr.node_index, vector<NODE_IDX_T>({2, 5, 7, 11}));
+  EXPECT_EQ(edge_csr.adj_offsets, vector<size_t>({0, 1, 4, 7, 7}));
+  EXPECT_EQ(edge_csr.adj_index, vector<NODE_IDX_T>({9, 4, 4, 0, 1, 2, 3}));
+  expect_aligned_attrs(edge_csr);
+
+  edge_map_t edge_map_out;
+  data::csr_to_edge_map(edge_csr, edge_map_out);
+  expect_same_edge_map(edge_map_out, edge_map);
+}
+
+
+TEST(EdgeCSRTest, MultipleEdgeMapsConcatenateInOrder)
+{
+  vector<edge_map_t> edge_maps(3);
+  insert_edges(edge_maps[0], 4, {1}, true);
+  insert_edges(edge_maps[1], 4, {2, 3}, true);
+  insert_edges(edge_maps[1], 1, {8}, true);
+  insert_edges(edge_maps[2], 4, {5}, true);
+
+  edge_csr_t edge_csr;
+  data::edge_map_to_csr(edge_maps, edge_csr);
+
+  EXPECT_EQ(edge_csr.node_index, vector<NODE_IDX_T>({1, 4}));
+  EXPECT_EQ(edge_csr.adj_offsets, vector<size_t>({0, 1, 5}));
+  EXPECT_EQ(edge_csr.adj_index, vector<NODE_IDX_T>({8, 1, 2, 3, 5}));
+  expect_aligned_attrs(edge_csr);
+}
+
+
+TEST(EdgeCSRTest, MergeInterleavedNodes)
+{
+  edge_map_t edge_map_a, edge_map_b;
+  insert_edges(edge_map_a, 1, {10, 11}, true);
+  insert_edges(edge_map_a, 3, {12}, true);
+  insert_edges(edge_map_a, 6, {}, true);
+  insert_edges(edge_map_b, 0, {20}, true);
+  insert_edges(edge_map_b, 3, {21, 22}, true);
+  insert_edges(edge_map_b, 8, {23}, true);
+
+  edge_csr_t edge_csr, other;
+  data::edge_map_to_csr(edge_map_a, edge_csr);
+  data::edge_map_to_csr(edge_map_b, other);
+  data::append_edge_csr(other, edge_csr);
+
+  EXPECT_EQ(edge_csr.node_index, vector<NODE_IDX_T>({0, 1, 3, 6, 8}));
+  EXPECT_EQ(edge_csr.adj_offsets, vector<size_t>({0, 1, 3, 6, 6, 7}));
+  EXPECT_EQ(edge_csr.adj_index, vector<NODE_IDX_T>({20, 10, 11, 12, 21, 22, 23}));
+  expect_aligned_attrs(edge_csr);
+
+  // merging agrees with concatenating the edge maps
+  edge_csr_t expected;
+  data::edge_map_to_csr(vector<edge_map_t>({edge_map_a, edge_map_b}), expected);
+  EXPECT_EQ(edge_csr.node_index, expected.node_index);
+  EXPECT_EQ(edge_csr.adj_offsets, expected.adj_offsets);
+  EXPECT_EQ(edge_csr.adj_index, expected.adj_index);
+}
+
+
+TEST(EdgeCSRTest, MergeEmptyOperands)
+{
+  edge_map_t edge_map;
+  insert_edges(edge_map, 2, {1, 3}, true);
+
+  edge_csr_t edge_csr, empty_csr;
+  data::edge_map_to_csr(edge_map, edge_csr);
+
+  data::append_edge_csr(empty_csr, edge_csr);
+  EXPECT_EQ(edge_csr.adj_index, vector<NODE_IDX_T>({1, 3}));
+  expect_aligned_attrs(edge_csr);
+
+  data::append_edge_csr(edge_csr, empty_csr);
+  EXPECT_EQ(empty_csr.node_index, edge_csr.node_index);
+  EXPECT_EQ(empty_csr.adj_index, edge_csr.adj_index);
+  expect_aligned_attrs(empty_csr);
+}
+
+
+TEST(EdgeCSRTest, MergeWithoutAttributes)
+{
+  edge_map_t edge_map_a, edge_map_b;
+  insert_edges(edge_map_a, 1, {10}, false);
+  insert_edges(edge_map_b, 1, {11}, false);
+
+  edge_csr_t edge_csr, other;
+  data::edge_map_to_csr(edge_map_a, edge_csr);
+  data::edge_map_to_csr(edge_map_b, other);
+  data::append_edge_csr(other, edge_csr);
+
+  EXPECT_EQ(edge_csr.adj_index, vector<NODE_IDX_T>({10, 11}));
+  EXPECT_TRUE(edge_csr.edge_attrs.empty());
+}
+
+
+TEST(EdgeCSRTest, MergeMismatchedAttributeLayoutThrows)
+{
+  edge_map_t edge_map_a, edge_map_b;
+  insert_edges(edge_map_a, 1, {10}, true);
+  insert_edges(edge_map_b, 2, {11}, false);
+
+  edge_csr_t edge_csr, other;
+  data::edge_map_to_csr(edge_map_a, edge_csr);
+  data::edge_map_to_csr(edge_map_b, other);
+  EXPECT_THROW(data::append_edge_csr(other, edge_csr), AssertionFailureException);
+  EXPECT_THROW(data::append_edge_csr(edge_csr, other), AssertionFailureException);
+  EXPECT_THROW(data::edge_map_to_csr(vector<edge_map_t>({edge_map_a, edge_map_b}), edge_csr),
+               AssertionFailureException);
+
+  // a different number of attributes of one type is also rejected
+  edge_map_t edge_map_c;
+  insert_edges(edge_map_c, 3, {12}, true);
+  get<1>(edge_map_c[3])[0].float_values.push_back(vector<float>(1, 0.0f));
+  edge_csr_t mismatched;
+  data::edge_map_to_csr(edge_map_c, mismatched);
+  EXPECT_THROW(data::append_edge_csr(mismatched, edge_csr), AssertionFailureException);
+}
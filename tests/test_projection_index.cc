@@ -0,0 +1,146 @@
+// -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+//==============================================================================
+///  @file test_projection_index.cc
+///
+///  Compares selection reads of a projection through its destination
+///  lookup index with selection reads that scan the destination block
+///  datasets.
+///
+///  Copyright (C) 2016-2025 Project NeuroH5.
+//==============================================================================
+
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "neuroh5_types.hh"
+#include "path_names.hh"
+#include "projection_index.hh"
+#include "read_projection_dataset_selection.hh"
+#include "throw_assert.hh"
+#include "mpi_test_environment.hh"
+
+using namespace std;
+using namespace neuroh5;
+
+namespace
+{
+  const string src_pop_name = "SRC", dst_pop_name = "DST";
+  const NODE_IDX_T src_start = 0, dst_start = 100;
+
+  template<class T>
+  void write_dataset (hid_t file, const string& name, hid_t ftype, hid_t ntype, const vector<T>& v)
+  {
+    const string path = hdf5::edge_attribute_path(src_pop_name, dst_pop_name, hdf5::EDGES, name);
+    hid_t lcpl = H5Pcreate(H5P_LINK_CREATE);
+    throw_assert_nomsg(H5Pset_create_intermediate_group(lcpl, 1) >= 0);
+    hsize_t dims = v.size();
+    hid_t fspace = H5Screate_simple(1, &dims, &dims);
+    hid_t dset = H5Dcreate2(file, path.c_str(), ftype, fspace, lcpl, H5P_DEFAULT, H5P_DEFAULT);
+    throw_assert(dset >= 0, "test_projection_index: unable to create dataset " << path);
+    throw_assert_nomsg(H5Dwrite(dset, ntype, H5S_ALL, H5S_ALL, H5P_DEFAULT, v.data()) >= 0);
+    throw_assert_nomsg(H5Dclose(dset) >= 0);
+    throw_assert_nomsg(H5Sclose(fspace) >= 0);
+    throw_assert_nomsg(H5Pclose(lcpl) >= 0);
+  }
+
+  // A projection in DBS format with two blocks of destinations, 0-2 and
+  // 10-12 relative to the destination population start; destination 1
+  // has no edges. The blocks are stored in reverse order of their first
+  // destination so that the lookup index is sorted differently from the
+  // block datasets.
+  string write_projection (const string& name)
+  {
+    const string file_name = ::testing::TempDir() + name;
+    hid_t file = H5Fcreate(file_name.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+    throw_assert_nomsg(file >= 0);
+
+    const vector<DST_BLK_PTR_T> dst_blk_ptr({0, 3, 7});
+    const vector<NODE_IDX_T> dst_blk_idx({10, 0});
+    const vector<DST_PTR_T> dst_ptr({0, 1, 3, 6, 8, 8, 11});
+    const vector<NODE_IDX_T> src_idx({5, 1, 2, 7, 8, 9, 3, 4, 6, 0, 2});
+    write_dataset(file, hdf5::DST_BLK_PTR, DST_BLK_PTR_H5_FILE_T, DST_BLK_PTR_H5_NATIVE_T, dst_blk_ptr);
+    write_dataset(file, hdf5::DST_BLK_IDX, NODE_IDX_H5_FILE_T, NODE_IDX_H5_NATIVE_T, dst_blk_idx);
+    write_dataset(file, hdf5::DST_PTR, DST_PTR_H5_FILE_T, DST_PTR_H5_NATIVE_T, dst_ptr);
+    write_dataset(file, hdf5::SRC_IDX, NODE_IDX_H5_FILE_T, NODE_IDX_H5_NATIVE_T, src_idx);
+
+    throw_assert_nomsg(H5Fclose(file) >= 0);
+    return file_name;
+  }
+
+  struct SelectionRead
+  {
+    DST_PTR_T edge_base = 0;
+    vector<NODE_IDX_T> selection_dst_idx;
+    vector<DST_PTR_T> selection_dst_ptr;
+    vector< pair<hsize_t,hsize_t> > src_idx_ranges;
+    vector<NODE_IDX_T> src_idx;
+    size_t total_num_edges = 0;
+  };
+
+  SelectionRead read_selection (const string& file_name, const vector<NODE_IDX_T>& selection)
+  {
+    SelectionRead r;
+    EXPECT_GE(hdf5::read_projection_dataset_selection(MPI_COMM_WORLD, file_name, src_pop_name, dst_pop_name,
+                                                      src_start, dst_start, selection, r.edge_base,
+                                                      r.selection_dst_idx, r.selection_dst_ptr,
+                                                      r.src_idx_ranges, r.src_idx, r.total_num_edges), 0);
+    return r;
+  }
+
+  bool has_index (const string& file_name)
+  {
+    hid_t file = H5Fopen(file_name.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    throw_assert_nomsg(file >= 0);
+    bool result = hdf5::has_projection_index(file, src_pop_name, dst_pop_name);
+    throw_assert_nomsg(H5Fclose(file) >= 0);
+    return result;
+  }
+}
+
+
+TEST(ProjectionIndexTest, IndexSelectionMatchesScan)
+{
+  const string file_name = write_projection("test_projection_index.h5");
+
+  // selections without destination 10, whose edges come first in the
+  // Source Index, one with destination 1, which has no edges, and all
+  // destinations
+  const vector< vector<NODE_IDX_T> > selections({ {112, 102},
+                                                  {111},
+                                                  {101, 110},
+                                                  {100, 101, 102, 110, 111, 112} });
+
+  vector<SelectionRead> scan_reads;
+  ASSERT_FALSE(has_index(file_name));
+  for (const vector<NODE_IDX_T>& selection : selections)
+    {
+      scan_reads.push_back(read_selection(file_name, selection));
+    }
+
+  ASSERT_GE(hdf5::write_projection_index(MPI_COMM_WORLD, file_name, src_pop_name, dst_pop_name), 0);
+  ASSERT_TRUE(has_index(file_name));
+  for (size_t i = 0; i < selections.size(); i++)
+    {
+      const SelectionRead index_read = read_selection(file_name, selections[i]);
+      const SelectionRead& scan_read = scan_reads[i];
+      EXPECT_EQ(index_read.edge_base, scan_read.edge_base) << "selection " << i;
+      EXPECT_EQ(index_read.selection_dst_idx, scan_read.selection_dst_idx) << "selection " << i;
+      EXPECT_EQ(index_read.selection_dst_ptr, scan_read.selection_dst_ptr) << "selection " << i;
+      EXPECT_EQ(index_read.src_idx_ranges, scan_read.src_idx_ranges) << "selection " << i;
+      EXPECT_EQ(index_read.src_idx, scan_read.src_idx) << "selection " << i;
+      EXPECT_EQ(index_read.total_num_edges, scan_read.total_num_edges) << "selection " << i;
+    }
+
+  // destination 11 is the second destination of the first block, with
+  // the edges at positions 1 and 2
+  const SelectionRead& r = scan_reads[1];
+  EXPECT_EQ(r.edge_base, 0u);
+  EXPECT_EQ(r.selection_dst_idx, vector<NODE_IDX_T>({111}));
+  EXPECT_EQ(r.src_idx, vector<NODE_IDX_T>({1, 2}));
+
+  std::remove(file_name.c_str());
+}
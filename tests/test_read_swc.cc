@@ -0,0 +1,202 @@
+// -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+//==============================================================================
+///  @file test_read_swc.cc
+///
+///  Regression tests for the section contraction of SWC imports. The
+///  expected sections and section edges of the fixtures in tests/swc
+///  are those produced by the NGraph contraction routines that
+///  contract_tree_sections replaced.
+///
+///  Copyright (C) 2016-2025 Project NeuroH5.
+//==============================================================================
+
+#include <cstdio>
+#include <deque>
+#include <forward_list>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "neuroh5_types.hh"
+#include "read_layer_swc.hh"
+#include "tree_topology.hh"
+#include "contract_tree.hh"
+#include "throw_assert.hh"
+
+using namespace std;
+using namespace neuroh5;
+
+namespace
+{
+  // Tests are run from the source directory
+  const string fixture_dir = "tests/swc/";
+
+  struct TreeSections
+  {
+    vector<SECTION_IDX_T> src, dst, sections;
+  };
+
+  TreeSections tree_sections (const neurotree_t& tree)
+  {
+    TreeSections result;
+    result.src.assign(get<1>(tree).begin(), get<1>(tree).end());
+    result.dst.assign(get<2>(tree).begin(), get<2>(tree).end());
+    result.sections.assign(get<3>(tree).begin(), get<3>(tree).end());
+    return result;
+  }
+
+  neurotree_t import_swc (const string& name, int id_offset)
+  {
+    forward_list<neurotree_t> tree_list;
+    EXPECT_EQ(io::read_swc(fixture_dir + name, 0, id_offset, tree_list), 0);
+    EXPECT_FALSE(tree_list.empty());
+    return tree_list.front();
+  }
+
+  neurotree_t import_layer_swc (const string& name, bool split_layers)
+  {
+    forward_list<neurotree_t> tree_list;
+    EXPECT_EQ(io::read_layer_swc(fixture_dir + name, 0, 0, 0, 4, split_layers, tree_list), 0);
+    EXPECT_FALSE(tree_list.empty());
+    return tree_list.front();
+  }
+
+  void expect_sections (const neurotree_t& tree,
+                        const vector<SECTION_IDX_T>& src,
+                        const vector<SECTION_IDX_T>& dst,
+                        const vector<SECTION_IDX_T>& sections)
+  {
+    TreeSections result = tree_sections(tree);
+    EXPECT_EQ(result.src, src);
+    EXPECT_EQ(result.dst, dst);
+    EXPECT_EQ(result.sections, sections);
+  }
+
+  // Sections of tree_0based.swc: soma, the two dendrites that branch at
+  // point 3 and the axon that branches at point 10
+  const vector<SECTION_IDX_T> branching_src({0, 0, 1, 1, 4, 4});
+  const vector<SECTION_IDX_T> branching_dst({1, 4, 2, 3, 5, 6});
+  const vector<SECTION_IDX_T> branching_sections({7,
+                                                  2, 0, 1,
+                                                  2, 2, 3,
+                                                  2, 4, 5,
+                                                  3, 6, 7, 8,
+                                                  2, 9, 10,
+                                                  2, 10, 11,
+                                                  2, 10, 12});
+}
+
+
+TEST(ReadSWCTest, ZeroBasedIds)
+{
+  neurotree_t tree = import_swc("tree_0based.swc", 0);
+  expect_sections(tree, branching_src, branching_dst, branching_sections);
+
+  EXPECT_EQ(get<4>(tree).size(), 13u);
+  EXPECT_EQ(get<9>(tree)[0], -1);
+  EXPECT_EQ(get<9>(tree)[12], 10);
+  EXPECT_EQ(get<10>(tree)[1], 1);
+  EXPECT_EQ(get<10>(tree)[2], 3);
+  EXPECT_EQ(get<10>(tree)[9], 2);
+}
+
+
+TEST(ReadSWCTest, OneBasedIds)
+{
+  // with an id offset of -1, a 1-based file imports to the same tree as
+  // its 0-based counterpart
+  neurotree_t tree = import_swc("tree_1based.swc", -1);
+  expect_sections(tree, branching_src, branching_dst, branching_sections);
+  EXPECT_EQ(get<9>(tree), get<9>(import_swc("tree_0based.swc", 0)));
+  EXPECT_EQ(get<10>(tree), get<10>(import_swc("tree_0based.swc", 0)));
+
+  // without an offset, the sections list the 1-based point ids; the
+  // types are still those of the points at each position
+  neurotree_t tree_1 = import_swc("tree_1based.swc", 0);
+  vector<SECTION_IDX_T> sections_1(branching_sections);
+  for (size_t i = 1; i < sections_1.size(); )
+    {
+      const size_t n = sections_1[i];
+      for (size_t k = i+1; k <= i+n; k++)
+        {
+          sections_1[k]++;
+        }
+      i += n + 1;
+    }
+  expect_sections(tree_1, branching_src, branching_dst, sections_1);
+  EXPECT_EQ(get<10>(tree_1), get<10>(tree));
+}
+
+
+TEST(ReadSWCTest, MultipleRootsAndUnorderedParents)
+{
+  // the sections of the second root are attached to the first section;
+  // points 8 and 9 precede their parents in the file
+  neurotree_t tree = import_swc("tree_multiroot.swc", 0);
+  expect_sections(tree,
+                  {0, 0, 0, 3},
+                  {1, 2, 3, 4},
+                  {5,
+                   2, 0, 1,
+                   2, 1, 2,
+                   2, 1, 3,
+                   5, 4, 5, 6, 9, 8,
+                   2, 4, 7});
+}
+
+
+TEST(ReadSWCTest, LayerSWC)
+{
+  // with split_layers, the unbranched dendrite is also split where the
+  // layer changes
+  expect_sections(import_layer_swc("tree_layers.swc", true),
+                  {0, 1, 1},
+                  {1, 2, 3},
+                  {4,
+                   3, 0, 1, 2,
+                   2, 3, 4,
+                   2, 4, 5,
+                   2, 6, 7});
+  expect_sections(import_layer_swc("tree_layers.swc", false),
+                  {0, 0},
+                  {1, 2},
+                  {3,
+                   5, 0, 1, 2, 3, 4,
+                   2, 4, 5,
+                   2, 6, 7});
+}
+
+
+TEST(ReadSWCTest, NonConsecutiveIdsThrow)
+{
+  const string file_name = ::testing::TempDir() + "test_read_swc_gap.swc";
+  {
+    ofstream out(file_name);
+    out << "0 1 0.0 0.0 0.0 1.0 -1\n"
+        << "1 3 0.0 1.0 0.0 1.0 0\n"
+        << "3 3 0.0 2.0 0.0 1.0 1\n";
+  }
+  forward_list<neurotree_t> tree_list;
+  EXPECT_THROW(io::read_swc(file_name, 0, 0, tree_list), AssertionFailureException);
+  EXPECT_THROW(io::read_layer_swc(file_name, 0, 0, 0, 4, false, tree_list), AssertionFailureException);
+  std::remove(file_name.c_str());
+}
+
+
+TEST(ReadSWCTest, TopologyRejectsOutOfRangeParents)
+{
+  cell::TreeTopology topology;
+  const vector<PARENT_NODE_IDX_T> parents({-1, 0, 5});
+  EXPECT_THROW(topology.append(parents.cbegin(), parents.cend(), 0), AssertionFailureException);
+
+  const vector<PARENT_NODE_IDX_T> based_parents({-1, 1, 2});
+  cell::TreeTopology based_topology;
+  based_topology.append(based_parents.cbegin(), based_parents.cend(), 1);
+  EXPECT_EQ(based_topology.num_points(0), 3u);
+  data::AttrSpan<NODE_IDX_T> roots = based_topology.tree_roots(0);
+  EXPECT_EQ(vector<NODE_IDX_T>(roots.begin(), roots.end()), vector<NODE_IDX_T>({0}));
+  data::AttrSpan<NODE_IDX_T> children = based_topology.point_children(0, 0);
+  EXPECT_EQ(vector<NODE_IDX_T>(children.begin(), children.end()), vector<NODE_IDX_T>({1}));
+}
@@ -0,0 +1,247 @@
+// -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+//==============================================================================
+///  @file test_read_txt_projection.cc
+///
+///  Reads small text edge lists with one byte range per rank, for each
+///  number of ranks up to the size of MPI_COMM_WORLD, and compares the
+///  edges gathered from all ranks with the serial import of the file.
+///  Each line has a float and a uint32 edge attribute. Run as a singleton
+///  MPI process, or under mpiexec to cover several byte ranges.
+///
+///  Copyright (C) 2016-2025 Project NeuroH5.
+//==============================================================================
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "neuroh5_types.hh"
+#include "attr_val.hh"
+#include "read_txt_projection.hh"
+#include "throw_assert.hh"
+#include "mpi_test_environment.hh"
+
+using namespace std;
+using namespace neuroh5;
+
+namespace
+{
+  typedef tuple<NODE_IDX_T, NODE_IDX_T, float, uint32_t> txt_edge_t;
+
+  map <string, vector <size_t> > txt_num_attrs ()
+  {
+    map <string, vector <size_t> > num_attrs;
+    num_attrs["Attributes"].resize(data::AttrVal::num_attr_types, 0);
+    num_attrs["Attributes"][data::AttrVal::attr_index_float] = 1;
+    num_attrs["Attributes"][data::AttrVal::attr_index_uint32] = 1;
+    return num_attrs;
+  }
+
+  // Flattens the output columns of read_txt_projection into edges, in
+  // the order of the columns
+  vector<txt_edge_t> txt_edges (const vector<NODE_IDX_T>& dst_idx,
+                                const vector<DST_PTR_T>& src_idx_ptr,
+                                const vector<NODE_IDX_T>& src_idx,
+                                map <string, data::AttrVal>& edge_attrs)
+  {
+    vector<txt_edge_t> edges;
+    EXPECT_TRUE((dst_idx.size() == 0) || (src_idx_ptr.size() == dst_idx.size()+1));
+    const data::AttrVal& attrs = edge_attrs["Attributes"];
+    for (size_t d = 0; d < dst_idx.size(); d++)
+      {
+        for (size_t k = src_idx_ptr[d]; k < src_idx_ptr[d+1]; k++)
+          {
+            edges.push_back(make_tuple(dst_idx[d], src_idx[k],
+                                       attrs.const_attr_vec<float>(0).at(k),
+                                       attrs.const_attr_vec<uint32_t>(0).at(k)));
+          }
+      }
+    return edges;
+  }
+
+  // Reads the file with one byte range per rank of comm and gathers the
+  // edges of all ranks, in rank order, on rank 0 of comm
+  vector<txt_edge_t> read_gather_edges (MPI_Comm comm, const string& file_name)
+  {
+    int rank, size;
+    throw_assert(MPI_Comm_size(comm, &size) == MPI_SUCCESS,
+                 "read_gather_edges: error in MPI_Comm_size");
+    throw_assert(MPI_Comm_rank(comm, &rank) == MPI_SUCCESS,
+                 "read_gather_edges: error in MPI_Comm_rank");
+
+    vector<NODE_IDX_T> dst_idx, src_idx;
+    vector<DST_PTR_T> src_idx_ptr;
+    map <string, data::AttrVal> edge_attrs;
+    EXPECT_GE(io::read_txt_projection(comm, file_name, txt_num_attrs(),
+                                      dst_idx, src_idx_ptr, src_idx, edge_attrs), 0);
+    vector<txt_edge_t> edges = txt_edges(dst_idx, src_idx_ptr, src_idx, edge_attrs);
+
+    vector<NODE_IDX_T> nodes;
+    vector<float> weights;
+    vector<uint32_t> ids;
+    for (const txt_edge_t& e : edges)
+      {
+        nodes.push_back(get<0>(e));
+        nodes.push_back(get<1>(e));
+        weights.push_back(get<2>(e));
+        ids.push_back(get<3>(e));
+      }
+    int num_edges = edges.size();
+    vector<int> counts(size, 0), node_counts(size, 0), displs(size, 0), node_displs(size, 0);
+    throw_assert(MPI_Gather(&num_edges, 1, MPI_INT, counts.data(), 1, MPI_INT, 0, comm) == MPI_SUCCESS,
+                 "read_gather_edges: error in MPI_Gather");
+    for (int p = 0; p < size; p++)
+      {
+        node_counts[p] = 2 * counts[p];
+        if (p > 0)
+          {
+            displs[p] = displs[p-1] + counts[p-1];
+            node_displs[p] = node_displs[p-1] + node_counts[p-1];
+          }
+      }
+    const size_t total = (rank == 0) ? (displs[size-1] + counts[size-1]) : 0;
+    vector<NODE_IDX_T> all_nodes(2 * total);
+    vector<float> all_weights(total);
+    vector<uint32_t> all_ids(total);
+    throw_assert(MPI_Gatherv(nodes.data(), nodes.size(), MPI_NODE_IDX_T,
+                             all_nodes.data(), node_counts.data(), node_displs.data(), MPI_NODE_IDX_T,
+                             0, comm) == MPI_SUCCESS,
+                 "read_gather_edges: error in MPI_Gatherv");
+    throw_assert(MPI_Gatherv(weights.data(), weights.size(), MPI_FLOAT,
+                             all_weights.data(), counts.data(), displs.data(), MPI_FLOAT,
+                             0, comm) == MPI_SUCCESS,
+                 "read_gather_edges: error in MPI_Gatherv");
+    throw_assert(MPI_Gatherv(ids.data(), ids.size(), MPI_UINT32_T,
+                             all_ids.data(), counts.data(), displs.data(), MPI_UINT32_T,
+                             0, comm) == MPI_SUCCESS,
+                 "read_gather_edges: error in MPI_Gatherv");
+
+    vector<txt_edge_t> all_edges;
+    for (size_t k = 0; k < total; k++)
+      {
+        all_edges.push_back(make_tuple(all_nodes[2*k], all_nodes[2*k+1], all_weights[k], all_ids[k]));
+      }
+    // the ranks read consecutive lines, so sorting the concatenated
+    // edges by destination restores the order of the serial import
+    stable_sort(all_edges.begin(), all_edges.end(),
+                [] (const txt_edge_t& a, const txt_edge_t& b) { return get<0>(a) < get<0>(b); });
+    return all_edges;
+  }
+
+  // Writes the edge list on rank 0 of MPI_COMM_WORLD and returns its
+  // path on all ranks
+  string write_edge_file (const string& name, const string& contents)
+  {
+    int rank;
+    throw_assert(MPI_Comm_rank(MPI_COMM_WORLD, &rank) == MPI_SUCCESS,
+                 "write_edge_file: error in MPI_Comm_rank");
+    const string file_name = ::testing::TempDir() + "test_read_txt_projection_" + name + ".txt";
+    if (rank == 0)
+      {
+        ofstream out(file_name, ios::binary | ios::trunc);
+        out << contents;
+      }
+    throw_assert(MPI_Barrier(MPI_COMM_WORLD) == MPI_SUCCESS,
+                 "write_edge_file: error in MPI_Barrier");
+    return file_name;
+  }
+
+  // Checks that the serial import has the given number of edges, and
+  // compares the edges read by the first n ranks of MPI_COMM_WORLD, for
+  // n = 1 .. size of MPI_COMM_WORLD, with the serial import
+  void expect_same_as_serial (const string& name, const string& contents, const size_t num_edges)
+  {
+    int rank, size;
+    throw_assert(MPI_Comm_size(MPI_COMM_WORLD, &size) == MPI_SUCCESS,
+                 "expect_same_as_serial: error in MPI_Comm_size");
+    throw_assert(MPI_Comm_rank(MPI_COMM_WORLD, &rank) == MPI_SUCCESS,
+                 "expect_same_as_serial: error in MPI_Comm_rank");
+    const string file_name = write_edge_file(name, contents);
+
+    vector<txt_edge_t> serial_edges;
+    if (rank == 0)
+      {
+        vector<NODE_IDX_T> dst_idx, src_idx;
+        vector<DST_PTR_T> src_idx_ptr;
+        map <string, data::AttrVal> edge_attrs;
+        EXPECT_GE(io::read_txt_projection(file_name, txt_num_attrs(),
+                                          dst_idx, src_idx_ptr, src_idx, edge_attrs), 0);
+        serial_edges = txt_edges(dst_idx, src_idx_ptr, src_idx, edge_attrs);
+        EXPECT_EQ(serial_edges.size(), num_edges) << name;
+      }
+
+    for (int n = 1; n <= size; n++)
+      {
+        MPI_Comm comm;
+        throw_assert(MPI_Comm_split(MPI_COMM_WORLD, (rank < n) ? 0 : MPI_UNDEFINED, rank, &comm) == MPI_SUCCESS,
+                     "expect_same_as_serial: error in MPI_Comm_split");
+        if (comm != MPI_COMM_NULL)
+          {
+            vector<txt_edge_t> edges = read_gather_edges(comm, file_name);
+            if (rank == 0)
+              {
+                EXPECT_EQ(edges, serial_edges) << name << ": " << n << " ranks";
+              }
+            throw_assert(MPI_Comm_free(&comm) == MPI_SUCCESS,
+                         "expect_same_as_serial: error in MPI_Comm_free");
+          }
+      }
+
+    throw_assert(MPI_Barrier(MPI_COMM_WORLD) == MPI_SUCCESS,
+                 "expect_same_as_serial: error in MPI_Barrier");
+    if (rank == 0)
+      {
+        std::remove(file_name.c_str());
+      }
+  }
+}
+
+
+TEST(ReadTxtProjectionTest, EmptyFile)
+{
+  expect_same_as_serial("empty", "", 0);
+}
+
+TEST(ReadTxtProjectionTest, BlankLinesOnly)
+{
+  expect_same_as_serial("blank", "\n\n", 0);
+}
+
+TEST(ReadTxtProjectionTest, OneLine)
+{
+  expect_same_as_serial("one_line", "7 1 0.5 10\n", 1);
+}
+
+TEST(ReadTxtProjectionTest, NoFinalNewline)
+{
+  expect_same_as_serial("no_newline", "4 2 1.5 1\n3 9 2.5 2\n4 0 0.25 3", 3);
+}
+
+TEST(ReadTxtProjectionTest, BlankLinesBetweenEdges)
+{
+  expect_same_as_serial("blank_lines", "2 5 1.0 1\n\n1 7 2.0 2\n2 6 3.0 3\n\n1 8 4.0 4\n", 4);
+}
+
+TEST(ReadTxtProjectionTest, ManyEdges)
+{
+  std::mt19937 gen(11);
+  std::uniform_int_distribution<int> dst_dist(0, 96), src_dist(0, 499);
+  std::uniform_real_distribution<double> weight_dist(0.0, 10.0);
+  string contents;
+  char line[64];
+  for (int i = 0; i < 2000; i++)
+    {
+      snprintf(line, sizeof(line), "%d %d %.3f %d\n", dst_dist(gen), src_dist(gen), weight_dist(gen), i);
+      contents += line;
+    }
+  expect_same_as_serial("edges", contents, 2000);
+}
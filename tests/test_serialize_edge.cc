@@ -0,0 +1,275 @@
+// -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+//==============================================================================
+///  @file test_serialize_edge.cc
+///
+///  Tests for the binary wire format of the per-rank edge maps exchanged
+///  by the scatter readers.
+///
+///  Copyright (C) 2016-2025 Project NeuroH5.
+//==============================================================================
+
+#include <map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "neuroh5_types.hh"
+#include "serialize_edge.hh"
+#include "edge_csr.hh"
+#include "throw_assert.hh"
+#include "edge_test_fixture.hh"
+
+using namespace std;
+using namespace neuroh5;
+using namespace neuroh5::test;
+
+namespace
+{
+  // Edge maps for three of four ranks; rank 2 receives nothing
+  rank_edge_map_t make_rank_edge_map ()
+  {
+    rank_edge_map_t rank_edge_map;
+    insert_edges(rank_edge_map[0], 3, {1, 2, 70000});
+    insert_edges(rank_edge_map[0], 9, {});
+    insert_edges(rank_edge_map[0], 12, {5});
+    insert_edges(rank_edge_map[1], 4, {8, 8});
+    insert_edges(rank_edge_map[3], 1, {0});
+    insert_edges(rank_edge_map[3], 100, {99, 98, 97, 96});
+    return rank_edge_map;
+  }
+}
+
+
+TEST(SerializeEdgeTest, RankEdgeMapRoundTrip)
+{
+  const size_t num_ranks = 4;
+  rank_edge_map_t rank_edge_map = make_rank_edge_map();
+
+  size_t num_packed_edges = 0;
+  vector<size_t> sendcounts, sdispls;
+  vector<char> sendbuf;
+  data::serialize_rank_edge_map(num_ranks, 1, rank_edge_map, num_packed_edges,
+                                sendcounts, sendbuf, sdispls);
+
+  EXPECT_EQ(num_packed_edges, 11u);
+  EXPECT_EQ(sendcounts[2], 0u);
+  // blocks are laid out starting at the start rank and wrapping around
+  EXPECT_EQ(sdispls[1], 0u);
+  EXPECT_EQ(sdispls[3], sendcounts[1]);
+  EXPECT_EQ(sdispls[0], sendcounts[1] + sendcounts[3]);
+  EXPECT_EQ(sendbuf.size(), sendcounts[0] + sendcounts[1] + sendcounts[3]);
+
+  // unpack the block of each rank as if it had been received alone
+  for (size_t rank = 0; rank < num_ranks; rank++)
+    {
+      vector<size_t> recvcounts(num_ranks, 0);
+      recvcounts[rank] = sendcounts[rank];
+
+      edge_map_t edge_map;
+      size_t num_unpacked_nodes = 0, num_unpacked_edges = 0;
+      data::deserialize_rank_edge_map(num_ranks, sendbuf, recvcounts, sdispls,
+                                      edge_map, num_unpacked_nodes, num_unpacked_edges);
+      expect_same_edge_map(edge_map, rank_edge_map[rank]);
+      EXPECT_EQ(num_unpacked_nodes, rank_edge_map[rank].size());
+    }
+}
+
+
+TEST(SerializeEdgeTest, RankEdgeMapMergesBlocks)
+{
+  const size_t num_ranks = 2;
+  rank_edge_map_t rank_edge_map;
+  insert_edges(rank_edge_map[0], 5, {1, 2});
+  insert_edges(rank_edge_map[0], 7, {3});
+  insert_edges(rank_edge_map[1], 5, {4});
+  insert_edges(rank_edge_map[1], 6, {6, 7});
+
+  size_t num_packed_edges = 0;
+  vector<size_t> sendcounts, sdispls;
+  vector<char> sendbuf;
+  data::serialize_rank_edge_map(num_ranks, 0, rank_edge_map, num_packed_edges,
+                                sendcounts, sendbuf, sdispls);
+
+  edge_map_t expected;
+  insert_edges(expected, 5, {1, 2, 4});
+  insert_edges(expected, 6, {6, 7});
+  insert_edges(expected, 7, {3});
+
+  edge_map_t edge_map;
+  size_t num_unpacked_nodes = 0, num_unpacked_edges = 0;
+  data::deserialize_rank_edge_map(num_ranks, sendbuf, sendcounts, sdispls,
+                                  edge_map, num_unpacked_nodes, num_unpacked_edges);
+  expect_same_edge_map(edge_map, expected);
+  EXPECT_EQ(num_unpacked_nodes, 3u);
+  EXPECT_EQ(num_unpacked_edges, 6u);
+
+  edge_csr_t edge_csr;
+  num_unpacked_nodes = 0; num_unpacked_edges = 0;
+  data::deserialize_rank_edge_map(num_ranks, sendbuf, sendcounts, sdispls,
+                                  edge_csr, num_unpacked_nodes, num_unpacked_edges);
+  EXPECT_EQ(num_unpacked_nodes, 3u);
+  EXPECT_EQ(num_unpacked_edges, 6u);
+  EXPECT_EQ(edge_csr.node_index, vector<NODE_IDX_T>({5, 6, 7}));
+  EXPECT_EQ(edge_csr.adj_offsets, vector<size_t>({0, 3, 5, 6}));
+  EXPECT_EQ(edge_csr.adj_index, vector<NODE_IDX_T>({1, 2, 4, 6, 7, 3}));
+  expect_aligned_attrs(edge_csr);
+}
+
+
+TEST(SerializeEdgeTest, NoAttributes)
+{
+  const size_t num_ranks = 1;
+  rank_edge_map_t rank_edge_map;
+  get<0>(rank_edge_map[0][2]) = vector<NODE_IDX_T>({4, 5});
+  get<0>(rank_edge_map[0][8]) = vector<NODE_IDX_T>({6});
+
+  size_t num_packed_edges = 0;
+  vector<size_t> sendcounts, sdispls;
+  vector<char> sendbuf;
+  data::serialize_rank_edge_map(num_ranks, 0, rank_edge_map, num_packed_edges,
+                                sendcounts, sendbuf, sdispls);
+
+  edge_map_t edge_map;
+  size_t num_unpacked_nodes = 0, num_unpacked_edges = 0;
+  data::deserialize_rank_edge_map(num_ranks, sendbuf, sendcounts, sdispls,
+                                  edge_map, num_unpacked_nodes, num_unpacked_edges);
+  expect_same_edge_map(edge_map, rank_edge_map[0]);
+}
+
+
+TEST(SerializeEdgeTest, MismatchedAttributeLayoutThrows)
+{
+  const size_t num_ranks = 1;
+  rank_edge_map_t rank_edge_map;
+  insert_edges(rank_edge_map[0], 1, {2});
+  get<0>(rank_edge_map[0][3]) = vector<NODE_IDX_T>({4});
+
+  size_t num_packed_edges = 0;
+  vector<size_t> sendcounts, sdispls;
+  vector<char> sendbuf;
+  EXPECT_THROW(data::serialize_rank_edge_map(num_ranks, 0, rank_edge_map, num_packed_edges,
+                                             sendcounts, sendbuf, sdispls),
+               AssertionFailureException);
+}
+
+
+TEST(SerializeEdgeTest, TruncatedBlockThrows)
+{
+  const size_t num_ranks = 1;
+  rank_edge_map_t rank_edge_map;
+  insert_edges(rank_edge_map[0], 1, {2, 3});
+
+  size_t num_packed_edges = 0;
+  vector<size_t> sendcounts, sdispls;
+  vector<char> sendbuf;
+  data::serialize_rank_edge_map(num_ranks, 0, rank_edge_map, num_packed_edges,
+                                sendcounts, sendbuf, sdispls);
+
+  sendbuf.pop_back();
+  sendcounts[0]--;
+  edge_map_t edge_map;
+  size_t num_unpacked_nodes = 0, num_unpacked_edges = 0;
+  EXPECT_THROW(data::deserialize_rank_edge_map(num_ranks, sendbuf, sendcounts, sdispls,
+                                               edge_map, num_unpacked_nodes, num_unpacked_edges),
+               AssertionFailureException);
+}
+
+
+TEST(SerializeEdgeTest, CSRRoundTrip)
+{
+  rank_edge_map_t rank_edge_map = make_rank_edge_map();
+  edge_csr_t edge_csr;
+  data::edge_map_to_csr(rank_edge_map[0], edge_csr);
+
+  size_t num_packed_edges = 0;
+  vector<char> sendbuf;
+  data::serialize_edge_map(edge_csr, num_packed_edges, sendbuf);
+  EXPECT_EQ(num_packed_edges, edge_csr.num_edges());
+
+  edge_csr_t unpacked_csr;
+  size_t num_unpacked_nodes = 0, num_unpacked_edges = 0;
+  data::deserialize_edge_map(sendbuf, unpacked_csr, num_unpacked_nodes, num_unpacked_edges);
+  EXPECT_EQ(num_unpacked_nodes, edge_csr.size());
+  EXPECT_EQ(num_unpacked_edges, edge_csr.num_edges());
+  EXPECT_EQ(unpacked_csr.node_index, edge_csr.node_index);
+  EXPECT_EQ(unpacked_csr.adj_offsets, edge_csr.adj_offsets);
+  EXPECT_EQ(unpacked_csr.adj_index, edge_csr.adj_index);
+  ASSERT_EQ(unpacked_csr.edge_attrs.size(), edge_csr.edge_attrs.size());
+  for (size_t i = 0; i < edge_csr.edge_attrs.size(); i++)
+    {
+      expect_same_attrs(unpacked_csr.edge_attrs[i], edge_csr.edge_attrs[i]);
+    }
+
+  // a packed CSR container has the layout of a packed edge map
+  edge_map_t edge_map;
+  num_unpacked_nodes = 0; num_unpacked_edges = 0;
+  data::deserialize_rank_edge_map(1, sendbuf, vector<size_t>(1, sendbuf.size()), vector<size_t>(1, 0),
+                                  edge_map, num_unpacked_nodes, num_unpacked_edges);
+  expect_same_edge_map(edge_map, rank_edge_map[0]);
+}
+
+
+TEST(SerializeEdgeTest, CSRMergesBlocksAfterExistingEdges)
+{
+  const size_t num_ranks = 3;
+  rank_edge_map_t rank_edge_map;
+  insert_edges(rank_edge_map[0], 5, {1, 2});
+  insert_edges(rank_edge_map[0], 9, {3});
+  insert_edges(rank_edge_map[1], 2, {8});
+  insert_edges(rank_edge_map[1], 5, {4});
+  insert_edges(rank_edge_map[2], 5, {6});
+  insert_edges(rank_edge_map[2], 7, {});
+
+  size_t num_packed_edges = 0;
+  vector<size_t> sendcounts, sdispls;
+  vector<char> sendbuf;
+  data::serialize_rank_edge_map(num_ranks, 1, rank_edge_map, num_packed_edges,
+                                sendcounts, sendbuf, sdispls);
+
+  edge_map_t existing;
+  insert_edges(existing, 5, {0});
+  insert_edges(existing, 11, {10});
+  edge_csr_t edge_csr;
+  data::edge_map_to_csr(existing, edge_csr);
+
+  size_t num_unpacked_nodes = 0, num_unpacked_edges = 0;
+  data::deserialize_rank_edge_map(num_ranks, sendbuf, sendcounts, sdispls,
+                                  edge_csr, num_unpacked_nodes, num_unpacked_edges);
+  EXPECT_EQ(num_unpacked_nodes, 3u);
+  EXPECT_EQ(num_unpacked_edges, 6u);
+
+  // the existing edges of node 5 come first, then those of each rank
+  edge_map_t expected;
+  insert_edges(expected, 2, {8});
+  insert_edges(expected, 5, {0, 1, 2, 4, 6});
+  insert_edges(expected, 7, {});
+  insert_edges(expected, 9, {3});
+  insert_edges(expected, 11, {10});
+  edge_map_t edge_map;
+  data::csr_to_edge_map(edge_csr, edge_map);
+  expect_same_edge_map(edge_map, expected);
+  EXPECT_EQ(edge_csr.adj_offsets, vector<size_t>({0, 1, 6, 6, 7, 8}));
+}
+
+
+TEST(SerializeEdgeTest, CSRMergeMismatchedAttributeLayoutThrows)
+{
+  rank_edge_map_t rank_edge_map;
+  get<0>(rank_edge_map[0][3]) = vector<NODE_IDX_T>({4});
+
+  size_t num_packed_edges = 0;
+  vector<size_t> sendcounts, sdispls;
+  vector<char> sendbuf;
+  data::serialize_rank_edge_map(1, 0, rank_edge_map, num_packed_edges,
+                                sendcounts, sendbuf, sdispls);
+
+  edge_map_t existing;
+  insert_edges(existing, 1, {2});
+  edge_csr_t edge_csr;
+  data::edge_map_to_csr(existing, edge_csr);
+
+  size_t num_unpacked_nodes = 0, num_unpacked_edges = 0;
+  EXPECT_THROW(data::deserialize_rank_edge_map(1, sendbuf, sendcounts, sdispls,
+                                               edge_csr, num_unpacked_nodes, num_unpacked_edges),
+               AssertionFailureException);
+}
@@ -0,0 +1,269 @@
+// -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+//==============================================================================
+///  @file test_tree_encoding.cc
+///
+///  Round-trip tests for the quantized encoding of tree points.
+///
+///  Copyright (C) 2016-2025 Project NeuroH5.
+//==============================================================================
+
+#include <cmath>
+#include <deque>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "neuroh5_types.hh"
+#include "attr_map.hh"
+#include "columnar_attr_map.hh"
+#include "path_names.hh"
+#include "tree_encoding.hh"
+#include "throw_assert.hh"
+
+using namespace std;
+using namespace neuroh5;
+
+namespace
+{
+  // Point attributes of a set of trees, delimited by point_ptr
+  struct TreePoints
+  {
+    vector<CELL_IDX_T>        index;
+    vector<ATTR_PTR_T>        point_ptr {0};
+    vector<COORD_T>           xcoords, ycoords, zcoords;
+    vector<REALVAL_T>         radiuses;
+    vector<LAYER_IDX_T>       layers;
+    vector<PARENT_NODE_IDX_T> parents;
+    vector<SWC_TYPE_T>        swc_types;
+
+    // Adds a tree with the given parents; each point is a small random
+    // step away from its parent, or from the soma position for roots
+    // and for points whose parent comes later in the tree
+    void add_tree (CELL_IDX_T cell, const vector<PARENT_NODE_IDX_T>& tree_parents,
+                   std::mt19937& rng)
+    {
+      std::uniform_real_distribution<float> step(-3.0f, 3.0f), radius(0.1f, 4.0f);
+      const size_t first = xcoords.size();
+      const float soma[3] = { 120.0f + cell, -45.5f, 310.25f };
+      for (size_t k = 0; k < tree_parents.size(); k++)
+        {
+          const PARENT_NODE_IDX_T p = tree_parents[k];
+          const bool from_parent = (p >= 0) && ((size_t)p < k);
+          xcoords.push_back((from_parent ? xcoords[first+p] : soma[0]) + step(rng));
+          ycoords.push_back((from_parent ? ycoords[first+p] : soma[1]) + step(rng));
+          zcoords.push_back((from_parent ? zcoords[first+p] : soma[2]) + step(rng));
+          radiuses.push_back(radius(rng));
+          layers.push_back((LAYER_IDX_T)(k / 3));
+          swc_types.push_back((SWC_TYPE_T)((k < 2) ? 1 : 3));
+          parents.push_back(p);
+        }
+      index.push_back(cell);
+      point_ptr.push_back(xcoords.size());
+    }
+
+    void encode (double precision, cell::EncodedTreePoints& encoded) const
+    {
+      cell::encode_tree_points(precision, index, point_ptr, xcoords, ycoords, zcoords,
+                               radiuses, layers, parents, swc_types, encoded);
+    }
+  };
+
+  // Inserts the encoded attributes as they are read from a TreeQuantized
+  // namespace
+  template <class NamedAttrMapT>
+  void insert_encoded (const TreePoints& trees, const cell::EncodedTreePoints& encoded,
+                       NamedAttrMapT& attr_values)
+  {
+    attr_values.insert(hdf5::QUANT_ORIGIN, trees.index, encoded.origin_ptr, encoded.origins);
+    attr_values.insert(hdf5::X_OFFSET, trees.index, trees.point_ptr, encoded.x_offsets);
+    attr_values.insert(hdf5::Y_OFFSET, trees.index, trees.point_ptr, encoded.y_offsets);
+    attr_values.insert(hdf5::Z_OFFSET, trees.index, trees.point_ptr, encoded.z_offsets);
+    attr_values.insert(hdf5::RADIUS_QUANT, trees.index, trees.point_ptr, encoded.radiuses);
+    attr_values.insert(hdf5::PARENT_DELTA, trees.index, trees.point_ptr, encoded.parent_deltas);
+    attr_values.insert(hdf5::LAYER_RUNS, trees.index, encoded.layer_run_ptr, encoded.layer_runs);
+    attr_values.insert(hdf5::LAYER_RUN_LEN, trees.index, encoded.layer_run_ptr, encoded.layer_run_lengths);
+    attr_values.insert(hdf5::SWCTYPE_RUNS, trees.index, encoded.swc_type_run_ptr, encoded.swc_type_runs);
+    attr_values.insert(hdf5::SWCTYPE_RUN_LEN, trees.index, encoded.swc_type_run_ptr, encoded.swc_type_run_lengths);
+  }
+
+  template <class T>
+  vector<T> decoded_values (data::NamedAttrMap& attr_values, const string& name, CELL_IDX_T cell)
+  {
+    const deque<T> values = attr_values.find_name<T>(name, cell);
+    return vector<T>(values.begin(), values.end());
+  }
+
+  template <class T>
+  vector<T> decoded_values (data::NamedColumnarAttrMap& attr_values, const string& name, CELL_IDX_T cell)
+  {
+    const data::AttrSpan<T> values = attr_values.find_name<T>(name, cell);
+    return vector<T>(values.begin(), values.end());
+  }
+
+  template <class T>
+  vector<T> tree_values (const vector<T>& values, const TreePoints& trees, size_t t)
+  {
+    return vector<T>(values.begin() + trees.point_ptr[t], values.begin() + trees.point_ptr[t+1]);
+  }
+
+  template <class T>
+  void expect_within (const vector<T>& decoded, const vector<T>& original,
+                      double precision, const string& name, CELL_IDX_T cell)
+  {
+    ASSERT_EQ(decoded.size(), original.size()) << name << " of tree " << cell;
+    for (size_t k = 0; k < original.size(); k++)
+      {
+        EXPECT_LE(fabs((double)decoded[k] - (double)original[k]), precision)
+          << name << " of point " << k << " of tree " << cell;
+      }
+  }
+
+  template <class NamedAttrMapT>
+  void expect_round_trip (const TreePoints& trees, double precision)
+  {
+    cell::EncodedTreePoints encoded;
+    trees.encode(precision, encoded);
+
+    NamedAttrMapT attr_values;
+    insert_encoded(trees, encoded, attr_values);
+    cell::decode_tree_points(attr_values);
+
+    for (size_t t = 0; t < trees.index.size(); t++)
+      {
+        const CELL_IDX_T cell = trees.index[t];
+        expect_within(decoded_values<COORD_T>(attr_values, hdf5::X_COORD, cell),
+                      tree_values(trees.xcoords, trees, t), precision, "x", cell);
+        expect_within(decoded_values<COORD_T>(attr_values, hdf5::Y_COORD, cell),
+                      tree_values(trees.ycoords, trees, t), precision, "y", cell);
+        expect_within(decoded_values<COORD_T>(attr_values, hdf5::Z_COORD, cell),
+                      tree_values(trees.zcoords, trees, t), precision, "z", cell);
+        expect_within(decoded_values<REALVAL_T>(attr_values, hdf5::RADIUS, cell),
+                      tree_values(trees.radiuses, trees, t), precision, "radius", cell);
+        EXPECT_EQ(decoded_values<PARENT_NODE_IDX_T>(attr_values, hdf5::PARENT, cell),
+                  tree_values(trees.parents, trees, t));
+        EXPECT_EQ(decoded_values<LAYER_IDX_T>(attr_values, hdf5::LAYER, cell),
+                  tree_values(trees.layers, trees, t));
+        EXPECT_EQ(decoded_values<SWC_TYPE_T>(attr_values, hdf5::SWCTYPE, cell),
+                  tree_values(trees.swc_types, trees, t));
+      }
+  }
+
+  TreePoints make_trees ()
+  {
+    std::mt19937 rng(17);
+    TreePoints trees;
+    // a chain and a branching tree with the parents first
+    trees.add_tree(3, {-1, 0, 1, 2, 3, 4}, rng);
+    trees.add_tree(5, {-1, 0, 0, 1, 2, 2, 5, 1}, rng);
+    // roots in the middle of the tree
+    trees.add_tree(8, {-1, 0, 1, -1, 3, 4, -1, 6}, rng);
+    // parents stored after their children
+    trees.add_tree(9, {1, 2, -1, 2, 5, 3, 4}, rng);
+    // a single point and an empty tree
+    trees.add_tree(11, {-1}, rng);
+    trees.add_tree(12, {}, rng);
+    return trees;
+  }
+}
+
+
+TEST(TreeEncodingTest, RoundTripWithinPrecision)
+{
+  const TreePoints trees = make_trees();
+  for (double precision : { 0.5, 0.01, 0.001 })
+    {
+      expect_round_trip<data::NamedAttrMap>(trees, precision);
+      expect_round_trip<data::NamedColumnarAttrMap>(trees, precision);
+    }
+}
+
+
+TEST(TreeEncodingTest, RunsAndParentDeltas)
+{
+  const TreePoints trees = make_trees();
+  cell::EncodedTreePoints encoded;
+  trees.encode(0.01, encoded);
+
+  ASSERT_EQ(encoded.origin_ptr.size(), trees.index.size() + 1);
+  EXPECT_EQ(encoded.origins.size(), 4 * trees.index.size());
+  EXPECT_EQ(encoded.x_offsets.size(), trees.xcoords.size());
+  EXPECT_EQ(encoded.parent_deltas.size(), trees.parents.size());
+
+  // tree 8: the root at point 3 has delta 4
+  const size_t first = trees.point_ptr[2];
+  EXPECT_EQ(encoded.parent_deltas[first + 3], 4);
+  EXPECT_EQ(encoded.parent_deltas[first + 4], 1);
+
+  // tree 3: layers 0,0,0,1,1,1 and types 1,1,3,3,3,3
+  EXPECT_EQ(vector<LAYER_IDX_T>(encoded.layer_runs.begin() + encoded.layer_run_ptr[0],
+                                encoded.layer_runs.begin() + encoded.layer_run_ptr[1]),
+            vector<LAYER_IDX_T>({0, 1}));
+  EXPECT_EQ(vector<uint32_t>(encoded.layer_run_lengths.begin() + encoded.layer_run_ptr[0],
+                             encoded.layer_run_lengths.begin() + encoded.layer_run_ptr[1]),
+            vector<uint32_t>({3, 3}));
+  EXPECT_EQ(vector<uint32_t>(encoded.swc_type_run_lengths.begin() + encoded.swc_type_run_ptr[0],
+                             encoded.swc_type_run_lengths.begin() + encoded.swc_type_run_ptr[1]),
+            vector<uint32_t>({2, 4}));
+
+  // the empty tree has no runs
+  EXPECT_EQ(encoded.layer_run_ptr[6], encoded.layer_run_ptr[5]);
+}
+
+
+TEST(TreeEncodingTest, OffsetOverflowThrows)
+{
+  std::mt19937 rng(3);
+  TreePoints trees;
+  trees.add_tree(1, {-1, 0}, rng);
+  // 40 units at step 0.002 are 20000 steps, within the int16 range
+  trees.xcoords[1] = trees.xcoords[0] + 40.0f;
+  cell::EncodedTreePoints encoded;
+  EXPECT_NO_THROW(trees.encode(0.001, encoded));
+
+  // 80 units are 40000 steps, beyond the int16 range
+  trees.xcoords[1] = trees.xcoords[0] + 80.0f;
+  EXPECT_THROW(trees.encode(0.001, encoded), AssertionFailureException);
+  trees.xcoords[1] = trees.xcoords[0] - 80.0f;
+  EXPECT_THROW(trees.encode(0.001, encoded), AssertionFailureException);
+
+  // a point whose parent comes later is encoded relative to the
+  // origin: a chain of 30 unit steps fits when the parents come first,
+  // but the last point overflows when it is stored before its parent
+  const float chain[5] = { 0.0f, 30.0f, 60.0f, 90.0f, 91.0f };
+  TreePoints ordered, reordered;
+  ordered.add_tree(2, {-1, 0, 1, 2, 3}, rng);
+  reordered.add_tree(2, {-1, 4, 0, 2, 3}, rng);
+  const size_t reordered_pos[5] = { 0, 2, 3, 4, 1 };
+  for (size_t k = 0; k < 5; k++)
+    {
+      ordered.xcoords[k] = 100.0f + chain[k];
+      reordered.xcoords[reordered_pos[k]] = 100.0f + chain[k];
+    }
+  EXPECT_NO_THROW(ordered.encode(0.001, encoded));
+  EXPECT_THROW(reordered.encode(0.001, encoded), AssertionFailureException);
+}
+
+
+TEST(TreeEncodingTest, RadiusOverflowThrows)
+{
+  std::mt19937 rng(5);
+  TreePoints trees;
+  trees.add_tree(1, {-1, 0}, rng);
+  cell::EncodedTreePoints encoded;
+  trees.radiuses[1] = 200.0f;
+  EXPECT_THROW(trees.encode(0.001, encoded), AssertionFailureException);
+  EXPECT_NO_THROW(trees.encode(0.01, encoded));
+}
+
+
+TEST(TreeEncodingTest, NonPositivePrecisionThrows)
+{
+  std::mt19937 rng(7);
+  TreePoints trees;
+  trees.add_tree(1, {-1}, rng);
+  cell::EncodedTreePoints encoded;
+  EXPECT_THROW(trees.encode(0.0, encoded), AssertionFailureException);
+  EXPECT_THROW(trees.encode(-0.1, encoded), AssertionFailureException);
+}